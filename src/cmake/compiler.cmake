@@ -203,6 +203,16 @@ if (${CMAKE_SYSTEM_NAME} STREQUAL "FreeBSD"
     add_compile_options (-march=i586)
 endif ()
 
+# "Verified fast" mode: elide the remaining safety checks and defensive
+# branches on span / ImageBuf::Iterator hot paths (API-boundary checks like
+# span::at() are kept). The contract this build demands of callers is
+# checked by OIIO_DASSERT, so a debug build with the same option still
+# catches misuse. Compare builds with `oiio-bench` to verify the uplift.
+option (UNCHECKED_HOT_PATHS "Elide safety checks on span/ImageBuf iterator hot paths" OFF)
+if (UNCHECKED_HOT_PATHS)
+    add_compile_definitions (OIIO_UNCHECKED_HOT_PATHS=1)
+endif ()
+
 # Fast-math mode may go faster, but it breaks IEEE and also makes inconsistent
 # results on different compilers/platforms, so we don't use it by default.
 option (ENABLE_FAST_MATH "Use fast math (may break IEEE fp rules)" OFF)
@@ -197,7 +197,17 @@ DecompressImage(uint8_t* rgba, int width, int height, const uint8_t* blocks,
 
     const int widthInBlocks  = (width + kBlockSize - 1) / kBlockSize;
     const int heightInBlocks = (height + kBlockSize - 1) / kBlockSize;
-    paropt opt               = paropt(nthreads, paropt::SplitDir::Y, 8);
+
+    // When the decoded texel layout already matches the destination (no
+    // RXGB channel swap, no normal map reconstruction), any block lying
+    // fully inside the image can be decoded by bcdec straight into its
+    // final resting place -- bcdec takes a destination pitch -- which
+    // skips the temp block buffer and a full extra touch of every pixel.
+    const bool allowDirect = !(pixelFormat.flags & DDS_PF_NORMAL)
+                             && !(cmp == Compression::DXT5
+                                  && pixelFormat.fourCC == DDS_4CC_RXGB);
+
+    paropt opt = paropt(nthreads, paropt::SplitDir::Y, 8);
     parallel_for_chunked(
         0, heightInBlocks, 0,
         [&](int64_t ybb, int64_t ybe) {
@@ -208,36 +218,53 @@ DecompressImage(uint8_t* rgba, int width, int height, const uint8_t* blocks,
             const uint8_t* srcBlocks = blocks + ybb * widthInBlocks * blockSize;
             for (int y = ybegin; y < yend; y += kBlockSize) {
                 for (int x = 0; x < width; x += kBlockSize) {
+                    // Decode straight to the image if the whole 4x4 block
+                    // is in bounds, otherwise to the temp block buffer.
+                    const bool direct = allowDirect
+                                        && x + kBlockSize <= width
+                                        && y + kBlockSize <= yend;
+                    const size_t dstoffset = channelCount
+                                             * (size_t(width) * y + x);
+                    uint8_t* decdst   = rgbai;
+                    uint16_t* decdsth = rgbh;
+                    int pitch = kBlockSize;  // destination pitch, in pixels
+                    if (direct) {
+                        decdst   = rgba + dstoffset;
+                        decdsth  = (uint16_t*)rgba + dstoffset;
+                        pitch    = width;
+                    }
                     // decompress the BCn block
                     switch (cmp) {
                     case Compression::DXT1:
-                        bcdec_bc1(srcBlocks, rgbai, kBlockSize * 4);
+                        bcdec_bc1(srcBlocks, decdst, pitch * 4);
                         break;
                     case Compression::DXT2:
                     case Compression::DXT3:
-                        bcdec_bc2(srcBlocks, rgbai, kBlockSize * 4);
+                        bcdec_bc2(srcBlocks, decdst, pitch * 4);
                         break;
                     case Compression::DXT4:
                     case Compression::DXT5:
-                        bcdec_bc3(srcBlocks, rgbai, kBlockSize * 4);
+                        bcdec_bc3(srcBlocks, decdst, pitch * 4);
                         break;
                     case Compression::BC4:
-                        bcdec_bc4(srcBlocks, rgbai, kBlockSize);
+                        bcdec_bc4(srcBlocks, decdst, pitch);
                         break;
                     case Compression::BC5:
-                        bcdec_bc5(srcBlocks, rgbai, kBlockSize * 2);
+                        bcdec_bc5(srcBlocks, decdst, pitch * 2);
                         break;
                     case Compression::BC6HU:
                     case Compression::BC6HS:
-                        bcdec_bc6h_half(srcBlocks, rgbh, kBlockSize * 3,
+                        bcdec_bc6h_half(srcBlocks, decdsth, pitch * 3,
                                         cmp == Compression::BC6HS);
                         break;
                     case Compression::BC7:
-                        bcdec_bc7(srcBlocks, rgbai, kBlockSize * 4);
+                        bcdec_bc7(srcBlocks, decdst, pitch * 4);
                         break;
                     default: return;
                     }
                     srcBlocks += blockSize;
+                    if (direct)
+                        continue;  // pixels are already in place
 
                     // Swap R & A for RXGB format case
                     if (cmp == Compression::DXT5
@@ -266,9 +293,7 @@ DecompressImage(uint8_t* rgba, int width, int height, const uint8_t* blocks,
                         || cmp == Compression::BC6HS) {
                         // HDR formats: half
                         const uint16_t* src = rgbh;
-                        uint16_t* dst       = (uint16_t*)rgba
-                                        + channelCount
-                                              * (size_t(width) * y + x);
+                        uint16_t* dst       = (uint16_t*)rgba + dstoffset;
                         for (int py = 0; py < kBlockSize && y + py < yend;
                              py++) {
                             int cols = std::min(kBlockSize, width - x);
@@ -279,8 +304,7 @@ DecompressImage(uint8_t* rgba, int width, int height, const uint8_t* blocks,
                     } else {
                         // LDR formats: uint8
                         const uint8_t* src = rgbai;
-                        uint8_t* dst       = rgba
-                                       + channelCount * (size_t(width) * y + x);
+                        uint8_t* dst       = rgba + dstoffset;
                         for (int py = 0; py < kBlockSize && y + py < yend;
                              py++) {
                             int cols = std::min(kBlockSize, width - x);
@@ -11,6 +11,7 @@ extern "C" {  // ffmpeg is a C api
 #    error "OIIO FFmpeg support requires FFmpeg >= 3.0"
 #endif
 #include <libavutil/imgutils.h>
+#include <libavutil/opt.h>
 }
 
 // It's hard to figure out FFMPEG versions from what they give us, so
@@ -28,6 +29,7 @@ extern "C" {  // ffmpeg is a C api
 #define USE_FFMPEG_4_2 (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(58, 54, 100))
 #define USE_FFMPEG_4_3 (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(58, 91, 100))
 #define USE_FFMPEG_4_4 (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(58, 134, 100))
+#define USE_FFMPEG_5_0 (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 18, 100))
 
 
 
@@ -78,13 +80,33 @@ receive_frame(AVCodecContext* avctx, AVFrame* picture, AVPacket* avpkt)
 
 
 
+#include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/imageio.h>
 #include <iostream>
+#include <map>
 #include <mutex>
 
 OIIO_PLUGIN_NAMESPACE_BEGIN
 
 
+namespace {
+
+// Movies that don't record their frame count in the container force
+// open() to scan every packet in the file just to count the frames.
+// Editorial review tends to open the same movie over and over (often
+// once per random frame access), so cache the scan result per file,
+// validated by size and mtime.
+struct scanned_frame_count {
+    int64_t frames;
+    uint64_t file_size;
+    std::time_t mtime;
+};
+static std::mutex frame_count_mutex;
+static std::map<std::string, scanned_frame_count> frame_count_cache;
+
+}  // namespace
+
+
 class FFmpegInput final : public ImageInput {
 public:
     FFmpegInput();
@@ -136,6 +158,9 @@ private:
     bool m_offset_time;
     bool m_codec_cap_delay;
     bool m_read_frame;
+    // Decoded frames are already in the delivery pixel format, so we can
+    // serve scanlines straight from the decoder's frame with no sws pass.
+    bool m_direct;
     int64_t m_start_time;
 
     // init to initialize state
@@ -157,6 +182,7 @@ private:
         m_last_decoded_pos = 0;
         m_offset_time      = true;
         m_read_frame       = false;
+        m_direct           = false;
         m_codec_cap_delay  = false;
         m_subimage         = 0;
         m_start_time       = 0;
@@ -297,6 +323,9 @@ FFmpegInput::open(const std::string& name, ImageSpec& spec)
     }
 #endif
 
+    // Let the codec decode with multiple threads (0 = autodetect).
+    m_codec_context->thread_count = threads();
+
     if (avcodec_open2(m_codec_context, m_codec, NULL) < 0) {
         errorfmt("\"{}\" could not open codec", file_name);
         return false;
@@ -316,24 +345,41 @@ FFmpegInput::open(const std::string& name, ImageSpec& spec)
     m_frames     = stream->nb_frames;
     m_start_time = stream->start_time;
     if (!m_frames) {
-        seek(0);
-        AVPacket pkt;
-        av_init_packet(&pkt);
-        av_read_frame(m_format_context, &pkt);
-        int64_t first_pts = pkt.pts;
-        int64_t max_pts   = 0;
-        av_packet_unref(&pkt);  //because seek(int) uses m_format_context
-        seek(1 << 29);
-        av_init_packet(&pkt);  //Is this needed?
-        while (stream && av_read_frame(m_format_context, &pkt) >= 0) {
-            int64_t current_pts = static_cast<int64_t>(
-                av_q2d(stream->time_base) * (pkt.pts - first_pts) * fps());
-            if (current_pts > max_pts) {
-                max_pts = current_pts + 1;
+        // No frame count in the container -- we have to scan the packets
+        // to count them. Check the cache first so that reopening the same
+        // file doesn't pay for the scan again.
+        uint64_t file_size = Filesystem::file_size(name);
+        std::time_t mtime  = Filesystem::last_write_time(name);
+        {
+            std::lock_guard<std::mutex> lk(frame_count_mutex);
+            auto found = frame_count_cache.find(name);
+            if (found != frame_count_cache.end()
+                && found->second.file_size == file_size
+                && found->second.mtime == mtime)
+                m_frames = found->second.frames;
+        }
+        if (!m_frames) {
+            seek(0);
+            AVPacket pkt;
+            av_init_packet(&pkt);
+            av_read_frame(m_format_context, &pkt);
+            int64_t first_pts = pkt.pts;
+            int64_t max_pts   = 0;
+            av_packet_unref(&pkt);  //because seek(int) uses m_format_context
+            seek(1 << 29);
+            av_init_packet(&pkt);  //Is this needed?
+            while (stream && av_read_frame(m_format_context, &pkt) >= 0) {
+                int64_t current_pts = static_cast<int64_t>(
+                    av_q2d(stream->time_base) * (pkt.pts - first_pts) * fps());
+                if (current_pts > max_pts) {
+                    max_pts = current_pts + 1;
+                }
+                av_packet_unref(&pkt);  //Always free before format_context usage
             }
-            av_packet_unref(&pkt);  //Always free before format_context usage
+            m_frames = max_pts;
+            std::lock_guard<std::mutex> lk(frame_count_mutex);
+            frame_count_cache[name] = { m_frames, file_size, mtime };
         }
-        m_frames = max_pts;
     }
     m_frame     = av_frame_alloc();
     m_rgb_frame = av_frame_alloc();
@@ -503,11 +549,37 @@ FFmpegInput::open(const std::string& name, ImageSpec& spec)
                                                  m_codec_context->height, 1),
                         0);
 
+#if USE_FFMPEG_3_1
+    // If the decoded frames arrive already in the exact pixel format we
+    // deliver, skip swscale and serve scanlines straight from the
+    // decoder's (refcounted) frame.
+    m_direct = (src_pix_format == m_dst_pix_format);
+#endif
+
+#if USE_FFMPEG_5_0
+    // Modern libswscale can thread the conversion, but must be set up
+    // through AVOptions rather than sws_getContext to enable it.
+    // threads=0 means autodetect, matching our threads() semantics.
+    m_sws_rgb_context = sws_alloc_context();
+    av_opt_set_int(m_sws_rgb_context, "srcw", m_codec_context->width, 0);
+    av_opt_set_int(m_sws_rgb_context, "srch", m_codec_context->height, 0);
+    av_opt_set_int(m_sws_rgb_context, "src_format", src_pix_format, 0);
+    av_opt_set_int(m_sws_rgb_context, "dstw", m_codec_context->width, 0);
+    av_opt_set_int(m_sws_rgb_context, "dsth", m_codec_context->height, 0);
+    av_opt_set_int(m_sws_rgb_context, "dst_format", m_dst_pix_format, 0);
+    av_opt_set_int(m_sws_rgb_context, "sws_flags", SWS_AREA, 0);
+    av_opt_set_int(m_sws_rgb_context, "threads", threads(), 0);
+    if (sws_init_context(m_sws_rgb_context, NULL, NULL) < 0) {
+        errorfmt("\"{}\" can't create swscale context", file_name);
+        return false;
+    }
+#else
     m_sws_rgb_context
         = sws_getContext(m_codec_context->width, m_codec_context->height,
                          src_pix_format, m_codec_context->width,
                          m_codec_context->height, m_dst_pix_format, SWS_AREA,
                          NULL, NULL, NULL);
+#endif
 
     AVDictionaryEntry* tag = NULL;
     while ((tag = av_dict_get(m_format_context->metadata, "", tag,
@@ -622,12 +694,21 @@ FFmpegInput::read_frame(int frame)
             m_last_search_pos = current_frame;
 
             if (current_frame == frame && finished) {
-                avpicture_fill(m_rgb_frame, &m_rgb_buffer[0], m_dst_pix_format,
-                               m_codec_context->width, m_codec_context->height);
-                sws_scale(m_sws_rgb_context,
-                          static_cast<uint8_t const* const*>(m_frame->data),
-                          m_frame->linesize, 0, m_codec_context->height,
-                          m_rgb_frame->data, m_rgb_frame->linesize);
+                av_frame_unref(m_rgb_frame);
+                if (m_direct) {
+                    // Already in the delivery format: just share the
+                    // decoder's buffer rather than copy-converting it.
+                    av_frame_ref(m_rgb_frame, m_frame);
+                } else {
+                    avpicture_fill(m_rgb_frame, &m_rgb_buffer[0],
+                                   m_dst_pix_format, m_codec_context->width,
+                                   m_codec_context->height);
+                    sws_scale(m_sws_rgb_context,
+                              static_cast<uint8_t const* const*>(
+                                  m_frame->data),
+                              m_frame->linesize, 0, m_codec_context->height,
+                              m_rgb_frame->data, m_rgb_frame->linesize);
+                }
                 m_last_decoded_pos = current_frame;
                 av_packet_unref(&pkt);
                 break;
@@ -3,6 +3,7 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 #include <fcntl.h>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -77,10 +78,29 @@ private:
                                           ///  which subimages are sequentially
                                           ///  drawn.
 
+    /// Because each frame is drawn as a delta on top of its predecessors,
+    /// seeking backwards ordinarily means re-decoding everything from
+    /// frame 0. To bound that, remember the composed canvas (and where in
+    /// the byte stream the next frame's records start) every
+    /// kKeyframeInterval frames, so a random seek re-decodes at most that
+    /// many deltas.
+    static constexpr int kKeyframeInterval = 32;
+    struct Keyframe {
+        std::vector<unsigned char> canvas;  ///< Canvas after this frame
+        ImageSpec spec;                     ///< Spec of this frame
+        int64_t iopos;            ///< Stream position of next record
+        int disposal_method;      ///< Disposal method of this frame
+    };
+    std::map<int, Keyframe> m_keyframes;  ///< Snapshots, keyed by subimage
+
     /// Reset everything to initial state
     ///
     void init(void);
 
+    /// Snapshot the current frame's composed state if it falls on a
+    /// keyframe interval and hasn't been recorded yet.
+    void maybe_cache_keyframe(void);
+
     /// Read current subimage metadata.
     ///
     bool read_subimage_metadata(ImageSpec& newspec);
@@ -159,6 +179,7 @@ GIFInput::open(const std::string& name, ImageSpec& newspec)
     m_filename = name;
     m_subimage = -1;
     m_canvas.clear();
+    m_keyframes.clear();
 
     if (seek_subimage(0, 0)) {
         newspec = spec();
@@ -398,9 +419,29 @@ GIFInput::seek_subimage(int subimage, int miplevel)
     }
 
     if (m_subimage > subimage) {
-        // requested subimage is located before the current one
-        // file needs to be reopened
-        if (m_gif_file && !close()) {
+        // Requested subimage is located before the current one. Restart
+        // from the nearest cached keyframe at or before it, if we have
+        // one; otherwise the file needs to be reopened.
+        auto kf = m_keyframes.upper_bound(subimage);
+        if (m_gif_file && kf != m_keyframes.begin()) {
+            --kf;  // nearest keyframe at or before the target
+            if (!ioseek(kf->second.iopos))
+                return false;
+            m_canvas          = kf->second.canvas;
+            m_disposal_method = kf->second.disposal_method;
+            m_subimage        = kf->first;
+            if (m_subimage == subimage) {
+                // Landed exactly on a keyframe: its state is complete.
+                m_spec             = kf->second.spec;
+                m_spec.width       = m_gif_file->SWidth;
+                m_spec.height      = m_gif_file->SHeight;
+                m_spec.depth       = 1;
+                m_spec.full_height = m_spec.height;
+                m_spec.full_width  = m_spec.width;
+                m_spec.full_depth  = m_spec.depth;
+                return true;
+            }
+        } else if (m_gif_file && !close()) {
             return false;
         }
     }
@@ -432,6 +473,7 @@ GIFInput::seek_subimage(int subimage, int miplevel)
             if (!read_subimage_metadata(m_spec) || !read_subimage_data()) {
                 return false;
             }
+            maybe_cache_keyframe();
         }
     }
 
@@ -453,12 +495,27 @@ GIFInput::seek_subimage(int subimage, int miplevel)
     if (!read_subimage_data()) {
         return false;
     }
+    maybe_cache_keyframe();
 
     return true;
 }
 
 
 
+void
+GIFInput::maybe_cache_keyframe(void)
+{
+    if (m_subimage % kKeyframeInterval != 0 || m_keyframes.count(m_subimage))
+        return;
+    Keyframe& kf       = m_keyframes[m_subimage];
+    kf.canvas          = m_canvas;
+    kf.spec            = m_spec;
+    kf.iopos           = iotell();
+    kf.disposal_method = m_disposal_method;
+}
+
+
+
 static spin_mutex gif_error_mutex;
 
 
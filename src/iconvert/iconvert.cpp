@@ -7,6 +7,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -15,6 +16,7 @@
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagecache.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
 
@@ -47,6 +49,7 @@ static bool rotcw = false, rotccw = false, rot180 = false;
 static bool sRGB     = false;
 static bool separate = false, contig = false;
 static bool noclobber  = false;
+static int filejobs    = 0;  // files to convert concurrently (0 = #cores)
 static int return_code = EXIT_SUCCESS;
 static ArgParse ap;
 
@@ -70,11 +73,13 @@ getargs(int argc, char* argv[])
     ap.options ("iconvert -- copy images with format conversions and other alterations\n"
                 OIIO_INTRO_STRING "\n"
                 "Usage:  iconvert [options] inputfile outputfile\n"
+                "   or:  iconvert [options] inputfile... outputdirectory\n"
                 "   or:  iconvert --inplace [options] file...\n",
                 "%*", parse_files, "",
                 "--help", &help, "Print help message",
                 "-v", &verbose, "Verbose status messages",
                 "--threads %d:NTHREADS", &nthreads, "Number of threads (default 0 = #cores)",
+                "--jobs %d:NJOBS", &filejobs, "Number of files to convert concurrently (default 0 = #cores)",
                 "-d %s:TYPE", &dataformatname, "Set the output data format to one of:"
                         "uint8, sint8, uint10, uint12, uint16, sint16, half, float, double",
                 "-g %f:GAMMA", &gammaval, "Set gamma correction (default = 1.0)",
@@ -116,7 +121,7 @@ getargs(int argc, char* argv[])
         return;
     }
 
-    if (filenames.size() != 2 && !inplace) {
+    if (filenames.size() < 2 && !inplace) {
         print(
             stderr,
             "iconvert: Must have both an input and output filename specified.\n");
@@ -125,6 +130,16 @@ getargs(int argc, char* argv[])
         return_code = EXIT_FAILURE;
         return;
     }
+    if (filenames.size() > 2 && !inplace
+        && !Filesystem::is_directory(filenames.back())) {
+        print(
+            stderr,
+            "iconvert: When converting more than one file, the last argument must be an existing directory.\n");
+        ap.usage();
+        ap.abort();
+        return_code = EXIT_FAILURE;
+        return;
+    }
     if (filenames.size() == 0 && inplace) {
         print(stderr, "iconvert: Must have at least one filename\n");
         ap.usage();
@@ -265,16 +280,18 @@ adjust_spec(ImageInput* in, ImageOutput* out, const ImageSpec& inspec,
     if (orientation >= 1)
         outspec.attribute("Orientation", orientation);
     else {
-        orientation = outspec.get_int_attribute("Orientation", 1);
-        if (orientation >= 1 && orientation <= 8) {
+        // N.B. Use a local copy so concurrent (and successive) files each
+        // derive their rotated orientation from their own metadata.
+        int orient = outspec.get_int_attribute("Orientation", 1);
+        if (orient >= 1 && orient <= 8) {
             static int cw[] = { 0, 6, 7, 8, 5, 2, 3, 4, 1 };
             if (rotcw || rotccw || rot180)
-                orientation = cw[orientation];
+                orient = cw[orient];
             if (rotccw || rot180)
-                orientation = cw[orientation];
+                orient = cw[orient];
             if (rotccw)
-                orientation = cw[orientation];
-            outspec.attribute("Orientation", orientation);
+                orient = cw[orient];
+            outspec.attribute("Orientation", orient);
         }
     }
 
@@ -311,18 +328,18 @@ adjust_spec(ImageInput* in, ImageOutput* out, const ImageSpec& inspec,
 
 
 static bool
-convert_file(const std::string& in_filename, const std::string& out_filename)
+convert_file(const std::string& in_filename, const std::string& out_filename,
+             std::ostream& out_stream, std::ostream& err_stream)
 {
     if (noclobber && Filesystem::exists(out_filename)) {
-        print(stderr, "iconvert ERROR: Output file already exists \"{}\"\n",
+        print(err_stream,
+              "iconvert ERROR: Output file already exists \"{}\"\n",
               out_filename);
         return false;
     }
 
-    if (verbose) {
-        print("Converting {} to {}\n", in_filename, out_filename);
-        fflush(stdout);
-    }
+    if (verbose)
+        print(out_stream, "Converting {} to {}\n", in_filename, out_filename);
 
     std::string tempname = out_filename;
     if (tempname == in_filename) {
@@ -333,7 +350,7 @@ convert_file(const std::string& in_filename, const std::string& out_filename)
     auto in = ImageInput::open(in_filename);
     if (!in) {
         std::string err = geterror();
-        print(stderr, "iconvert ERROR: {}\n",
+        print(err_stream, "iconvert ERROR: {}\n",
               (err.length() ? err
                             : Strutil::fmt::format("Could not open \"{}\"",
                                                    in_filename)));
@@ -346,7 +363,7 @@ convert_file(const std::string& in_filename, const std::string& out_filename)
     auto out = ImageOutput::create(tempname);
     if (!out) {
         print(
-            stderr,
+            err_stream,
             "iconvert ERROR: Could not find an ImageIO plugin to write \"{}\": {}\n",
             out_filename, geterror());
         return false;
@@ -378,7 +395,7 @@ convert_file(const std::string& in_filename, const std::string& out_filename)
     for (int subimage = 0; ok && in->seek_subimage(subimage, 0, inspec);
          ++subimage) {
         if (subimage > 0 && !out->supports("multiimage")) {
-            print(stderr,
+            print(err_stream,
                   "iconvert WARNING: {} does not support multiple subimages.\n"
                   "\tOnly the first subimage has been copied.\n",
                   out->format_name());
@@ -400,14 +417,14 @@ convert_file(const std::string& in_filename, const std::string& out_filename)
                     mode = ImageOutput::AppendSubimage;  // use if we must
                     if (!mip_to_subimage_warning
                         && strcmp(out->format_name(), "tiff")) {
-                        print(stderr,
+                        print(err_stream,
                               "iconvert WARNING: {} does not support MIPmaps.\n"
                               "\tStoring the MIPmap levels in subimages.\n",
                               out->format_name());
                     }
                     mip_to_subimage_warning = true;
                 } else {
-                    print(stderr,
+                    print(err_stream,
                           "iconvert WARNING: {} does not support MIPmaps.\n"
                           "\tOnly the first level has been copied.\n",
                           out->format_name());
@@ -429,7 +446,7 @@ convert_file(const std::string& in_filename, const std::string& out_filename)
             }
             if (!ok) {
                 std::string err = out->geterror();
-                print(stderr, "iconvert ERROR: {}\n",
+                print(err_stream, "iconvert ERROR: {}\n",
                       (err.length()
                            ? err
                            : Strutil::fmt::format("Could not open \"{}\"",
@@ -452,7 +469,7 @@ convert_file(const std::string& in_filename, const std::string& out_filename)
             if (!nocopy) {
                 ok = out->copy_image(in.get());
                 if (!ok)
-                    print(stderr,
+                    print(err_stream,
                           "iconvert ERROR copying \"{}\" to \"{}\" :\n\t{}\n",
                           in_filename, out_filename, out->geterror());
             } else {
@@ -462,12 +479,13 @@ convert_file(const std::string& in_filename, const std::string& out_filename)
                 ok = in->read_image(subimage, miplevel, 0, outspec.nchannels,
                                     outspec.format, &pixels[0]);
                 if (!ok) {
-                    print(stderr, "iconvert ERROR reading \"{}\": {}\n",
+                    print(err_stream, "iconvert ERROR reading \"{}\": {}\n",
                           in_filename, in->geterror());
                 } else {
                     ok = out->write_image(outspec.format, &pixels[0]);
                     if (!ok)
-                        print(stderr, "iconvert ERROR writing \"{}\": {}\n",
+                        print(err_stream,
+                              "iconvert ERROR writing \"{}\": {}\n",
                               out_filename, out->geterror());
                 }
             }
@@ -504,6 +522,16 @@ convert_file(const std::string& in_filename, const std::string& out_filename)
 
 
 
+// Everything one conversion printed, buffered so that concurrent
+// conversions don't interleave their messages.
+struct ConvertResult {
+    std::string out;
+    std::string err;
+    bool ok = true;
+};
+
+
+
 int
 main(int argc, char* argv[])
 {
@@ -518,13 +546,53 @@ main(int argc, char* argv[])
 
     OIIO::attribute("threads", nthreads);
 
-    bool ok = true;
-
+    // Build the list of conversions to perform.
+    std::vector<std::pair<std::string, std::string>> jobs;
     if (inplace) {
         for (auto&& s : filenames)
-            ok &= convert_file(s, s);
+            jobs.emplace_back(s, s);
+    } else if (filenames.size() > 2
+               || Filesystem::is_directory(filenames.back())) {
+        // Multiple inputs (or a directory destination): convert each input
+        // into the destination directory, keeping its filename.
+        std::string dir = filenames.back();
+        for (size_t i = 0; i < filenames.size() - 1; ++i)
+            jobs.emplace_back(filenames[i],
+                              dir + "/" + Filesystem::filename(filenames[i]));
     } else {
-        ok = convert_file(filenames[0], filenames[1]);
+        jobs.emplace_back(filenames[0], filenames[1]);
+    }
+
+    // Run the conversions concurrently on the thread pool (they all share
+    // it, and the ImageCache, so a file's read/decode overlaps another
+    // file's convert/encode/write). Each conversion buffers its status and
+    // error messages, which are printed in command-line order chunk by
+    // chunk, so the output matches a serial run.
+    bool ok                = true;
+    const size_t chunksize = 64;
+    for (size_t begin = 0; begin < jobs.size(); begin += chunksize) {
+        size_t n = std::min(chunksize, jobs.size() - begin);
+        std::vector<ConvertResult> results(n);
+        parallel_for(
+            int64_t(0), int64_t(n),
+            [&](int64_t i) {
+                std::ostringstream out_stream, err_stream;
+                results[i].ok  = convert_file(jobs[begin + i].first,
+                                              jobs[begin + i].second,
+                                              out_stream, err_stream);
+                results[i].out = out_stream.str();
+                results[i].err = err_stream.str();
+            },
+            // minitems=1: each file is its own task.
+            paropt(filejobs, paropt::SplitDir::Y, 1));
+        for (auto&& r : results) {
+            if (r.out.size())
+                print("{}", r.out);
+            if (r.err.size())
+                print(stderr, "{}", r.err);
+            ok &= r.ok;
+        }
+        fflush(stdout);
     }
     shutdown();
     return ok ? EXIT_SUCCESS : EXIT_FAILURE;
@@ -18,6 +18,7 @@
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagecache.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/sysutil.h>
 
 
@@ -97,6 +98,14 @@ getargs(int argc, char* argv[])
     ap.arg("-p")
       .help("Perform perceptual (rather than numeric) comparison");
 
+    ap.separator("Batch comparison options");
+    ap.arg("--manifest")
+      .help("Compare every image pair listed in FILE (one \"A B\" pair per line, \"-\" reads from stdin), concurrently, with a shared cache")
+      .metavar("FILE");
+    ap.arg("--report")
+      .help("In manifest mode, write the per-pair report to FILE instead of stdout")
+      .metavar("FILE");
+
     ap.separator("Difference image options");
     ap.arg("-o")
       .help("Output difference image")
@@ -188,6 +197,194 @@ add_filename_to_directory(const std::string& first, std::string& second)
 }
 
 
+// The comparison thresholds and modes, gathered up so that manifest mode
+// can hand them to its worker tasks.
+struct CompareOpts {
+    bool compareall;
+    bool perceptual;
+    float failthresh, failrelative, failpercent, hardfail;
+    float warnthresh, warnrelative, warnpercent, hardwarn;
+    int allowfailures;
+};
+
+
+
+// Compare one file pair without printing anything, returning the idiff
+// exit code for the pair and leaving the worst per-subimage comparison
+// stats in `worst` (and, for ErrFile, the read error text in `errmsg`).
+// This mirrors the decision logic of the verbose single-pair path in
+// main(), with one addition: when no failure percentage is allowed, a
+// single failing pixel beyond -allowfailures already decides FAILURE, so
+// the pixel scan is allowed to stop early via compare()'s "maxfailures".
+static int
+compare_files(const std::string& file0, const std::string& file1,
+              const CompareOpts& o, ImageCache* ic,
+              ImageBufAlgo::CompareResults& worst, std::string& errmsg)
+{
+    ImageBuf img0, img1;
+    auto reread = [&](ImageBuf& img, const std::string& fname, int s, int m) {
+        if (img.subimage() == s && img.miplevel() == m)
+            return true;
+        img.reset(fname, ic);
+        if (img.read(s, m, false, TypeFloat))
+            return true;
+        errmsg = img.geterror();
+        return false;
+    };
+    if (!reread(img0, file0, 0, 0) || !reread(img1, file1, 0, 0))
+        return ErrFile;
+
+    int ret = ErrOK;
+    for (int s = 0; s < img0.nsubimages(); ++s) {
+        if (s > 0 && !o.compareall)
+            break;
+        if (s >= img1.nsubimages())
+            break;
+        if (!reread(img0, file0, s, 0) || !reread(img1, file1, s, 0))
+            return ErrFile;
+        for (int m = 0; m < img0.nmiplevels(); ++m) {
+            if (m > 0 && !o.compareall)
+                break;
+            if (m > 0 && img0.nmiplevels() != img1.nmiplevels())
+                return ErrDifferentSize;
+            if (!reread(img0, file0, s, m) || !reread(img1, file1, s, m))
+                return ErrFile;
+            if (img0.deep() != img1.deep())
+                return ErrDifferentSize;
+
+            int npels = img0.spec().width * img0.spec().height
+                        * img0.spec().depth;
+            if (npels == 0)
+                npels = 1;
+
+            ImageBufAlgo::CompareResults cr;
+            int yee_failures = 0;
+            if (o.perceptual && !img0.deep()) {
+                yee_failures = ImageBufAlgo::compare_Yee(img0, img1, cr);
+            } else {
+                int maxfailures = o.failpercent == 0.0f ? o.allowfailures + 1
+                                                        : 0;
+                cr = ImageBufAlgo::compare(
+                    img0, img1,
+                    { { "failthresh", o.failthresh },
+                      { "warnthresh", o.warnthresh },
+                      { "failrelative", o.failrelative },
+                      { "warnrelative", o.warnrelative },
+                      { "maxfailures", maxfailures } });
+            }
+
+            if (cr.nfail <= imagesize_t(o.allowfailures)) {
+                // Pass if users set allowfailures and we are within that
+                // limit.
+            } else if (cr.nfail > (o.failpercent / 100.0 * npels)
+                       || cr.maxerror > o.hardfail
+                       || yee_failures > (o.failpercent / 100.0 * npels)) {
+                ret = ErrFail;
+            } else if (cr.nwarn > (o.warnpercent / 100.0 * npels)
+                       || cr.maxerror > o.hardwarn) {
+                if (ret != ErrFail)
+                    ret = ErrWarn;
+            }
+            if (cr.maxerror > worst.maxerror || (s == 0 && m == 0))
+                worst = cr;
+            if (ret == ErrFail)
+                return ret;  // no need to scan further subimages
+        }
+    }
+    if (o.compareall && img0.nsubimages() != img1.nsubimages())
+        ret = ErrFail;
+    return ret;
+}
+
+
+
+// Manifest mode: compare all the file pairs listed in manifestfile (one
+// pair per line, blank lines and '#' comments ignored, names quotable),
+// running the pairs concurrently on the thread pool with the one shared
+// ImageCache, and emit a one-line-per-pair report (to reportfile if
+// supplied, else stdout). The process exit code is the worst result of
+// any pair.
+static int
+run_manifest(const std::string& manifestfile, const CompareOpts& o,
+             ImageCache* ic, const std::string& reportfile, bool quiet)
+{
+    OIIO::ifstream file;
+    std::istream* in = &std::cin;
+    if (manifestfile != "-") {
+        Filesystem::open(file, manifestfile);
+        if (!file) {
+            print(stderr, "idiff ERROR: Could not open manifest \"{}\"\n",
+                  manifestfile);
+            return ErrFile;
+        }
+        in = &file;
+    }
+    std::vector<std::pair<std::string, std::string>> pairs;
+    std::string line;
+    for (int linenum = 1; std::getline(*in, line); ++linenum) {
+        string_view rest(line);
+        Strutil::skip_whitespace(rest);
+        if (rest.empty() || rest.front() == '#')
+            continue;
+        string_view a, b;
+        if (!Strutil::parse_string(rest, a)
+            || !Strutil::parse_string(rest, b)) {
+            print(stderr,
+                  "idiff ERROR: manifest line {} is not an image pair\n",
+                  linenum);
+            return ErrFile;
+        }
+        std::string second(b);
+        add_filename_to_directory(std::string(a), second);
+        pairs.emplace_back(a, second);
+    }
+
+    struct PairResult {
+        int ret = ErrOK;
+        ImageBufAlgo::CompareResults cr {};
+        std::string errmsg;
+    };
+    std::vector<PairResult> results(pairs.size());
+    parallel_for(int64_t(0), int64_t(pairs.size()), [&](int64_t i) {
+        results[i].ret = compare_files(pairs[i].first, pairs[i].second, o, ic,
+                                       results[i].cr, results[i].errmsg);
+    });
+
+    OIIO::ofstream rf;
+    std::ostream* out = &std::cout;
+    if (reportfile.size()) {
+        Filesystem::open(rf, reportfile);
+        if (!rf) {
+            print(stderr, "idiff ERROR: Could not open report \"{}\"\n",
+                  reportfile);
+            return ErrFile;
+        }
+        out = &rf;
+    }
+    static const char* statusname[ErrLast] = { "PASS", "WARNING", "FAILURE",
+                                               "DIFFERENTSIZE", "ERROR" };
+    int counts[ErrLast] = { 0, 0, 0, 0, 0 };
+    int ret             = ErrOK;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        const PairResult& r(results[i]);
+        print(*out,
+              "{}\t{}\t{}\tmaxerror={:g}\tmeanerror={:g}\trms={:g}\t"
+              "nwarn={}\tnfail={}{}{}\n",
+              statusname[r.ret], pairs[i].first, pairs[i].second,
+              r.cr.maxerror, r.cr.meanerror, r.cr.rms_error, r.cr.nwarn,
+              r.cr.nfail, r.errmsg.size() ? "\t" : "", r.errmsg);
+        ++counts[r.ret];
+        ret = std::max(ret, r.ret);
+    }
+    if (!quiet)
+        print("idiff: {} pairs: {} pass, {} warning, {} failure, {} error\n",
+              pairs.size(), counts[ErrOK], counts[ErrWarn],
+              counts[ErrFail] + counts[ErrDifferentSize], counts[ErrFile]);
+    return ret;
+}
+
+
+
 int
 main(int argc, char* argv[])
 {
@@ -199,7 +396,17 @@ main(int argc, char* argv[])
     ArgParse ap = getargs(argc, argv);
 
     std::vector<std::string> filenames = ap["filename"].as_vec<std::string>();
-    if (filenames.size() == 2) {
+    std::string manifestfile           = ap["manifest"].get();
+    std::string reportfile             = ap["report"].get();
+    if (manifestfile.size()) {
+        if (filenames.size()) {
+            print(stderr,
+                  "idiff: --manifest cannot be combined with input "
+                  "filenames.\n");
+            ap.usage();
+            return EXIT_FAILURE;
+        }
+    } else if (filenames.size() == 2) {
         add_filename_to_directory(filenames[0], filenames[1]);
     } else {
         print(stderr, "idiff: Must have two input filenames.\n");
@@ -225,7 +432,7 @@ main(int argc, char* argv[])
     float hardwarn        = ap["hardwarn"].get<float>();
     int allowfailures     = ap["allowfailures"].get<int>();
 
-    if (!quiet) {
+    if (!quiet && manifestfile.empty()) {
         print("Comparing \"{}\" and \"{}\"\n", filenames[0], filenames[1]);
         fflush(stdout);
     }
@@ -243,6 +450,19 @@ main(int argc, char* argv[])
     // fingerprint, just in case some mistake has been made.
     imagecache->attribute("deduplicate", 0);
 
+    if (manifestfile.size()) {
+        CompareOpts o { compareall,   perceptual,  failthresh,
+                        failrelative, failpercent, hardfail,
+                        warnthresh,   warnrelative, warnpercent,
+                        hardwarn,     allowfailures };
+        int ret = run_manifest(manifestfile, o, imagecache, reportfile,
+                               quiet);
+        imagecache->invalidate_all(true);
+        ImageCache::destroy(imagecache);
+        shutdown();
+        return ret;
+    }
+
     ImageBuf img0, img1;
     if (!read_input(filenames[0], img0, imagecache)
         || !read_input(filenames[1], img1, imagecache))
@@ -15,6 +15,7 @@
 #include <OpenImageIO/argparse.h>
 #include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
 
@@ -27,40 +28,77 @@ static bool recursive     = false;
 static bool file_match    = false;
 static bool print_dirs    = false;
 static bool all_subimages = false;
+static int nthreads       = 0;  // default: use all cores
+static std::string name_filter;
 static std::string pattern;
 static std::vector<std::string> filenames;
 
 
+// One unit of work for the scanner: a file to grep (or, for is_dir, just
+// a directory name to echo), plus whether it was discovered by recursion
+// (in which case non-image files are silently skipped) or named
+// explicitly on the command line.
+struct GrepTask {
+    std::string filename;
+    bool from_dir = false;
+    bool is_dir   = false;
+};
 
-static bool
-grep_file(const std::string& filename, std::regex& re,
-          bool ignore_nonimage_files = false)
+// Everything a worker produced for one task, buffered so the results can
+// be printed in discovery order no matter which thread finished first.
+struct GrepResult {
+    std::string out;
+    std::string err;
+};
+
+
+
+// Recursively walk the given file/directory, appending grep tasks in
+// deterministic (directory listing) order. Files discovered inside
+// directories are dropped early if their names don't match the optional
+// pre-filter, before we ever pay for an open.
+static void
+gather_files(const std::string& filename, const std::regex* namefilter,
+             std::vector<GrepTask>& tasks, bool from_dir = false)
 {
     if (!Filesystem::exists(filename)) {
         std::cerr << "igrep: " << filename << ": No such file or directory\n";
-        return false;
+        return;
     }
 
     if (Filesystem::is_directory(filename)) {
         if (!recursive)
-            return false;
-        if (print_dirs) {
-            std::cout << "(" << filename << "/)\n";
-            std::cout.flush();
-        }
-        bool r = false;
+            return;
+        if (print_dirs)
+            tasks.push_back({ filename, from_dir, true });
         std::vector<std::string> directory_entries;
         Filesystem::get_directory_entries(filename, directory_entries);
         for (const auto& d : directory_entries)
-            r |= grep_file(d, re, true);
-        return r;
+            gather_files(d, namefilter, tasks, true);
+        return;
+    }
+
+    if (from_dir && namefilter && !std::regex_search(filename, *namefilter))
+        return;
+    tasks.push_back({ filename, from_dir, false });
+}
+
+
+
+static void
+grep_one(const GrepTask& task, const std::regex& re, GrepResult& result)
+{
+    const std::string& filename(task.filename);
+    if (task.is_dir) {
+        result.out = Strutil::fmt::format("({}/)\n", filename);
+        return;
     }
 
     auto in = ImageInput::open(filename);
     if (!in.get()) {
-        if (!ignore_nonimage_files)
-            std::cerr << geterror() << "\n";
-        return false;
+        if (!task.from_dir)
+            result.err = geterror() + "\n";
+        return;
     }
     ImageSpec spec = in->spec();
 
@@ -69,12 +107,12 @@ grep_file(const std::string& filename, std::regex& re,
         try {
             match = std::regex_search(filename, re);
         } catch (const std::regex_error& e) {
-            std::cerr << "igrep: " << e.what() << "\n";
-            return false;
+            result.err = Strutil::fmt::format("igrep: {}\n", e.what());
+            return;
         }
         if (match && !invert_match) {
-            std::cout << filename << "\n";
-            return true;
+            result.out = filename + "\n";
+            return;
         }
     }
 
@@ -93,29 +131,27 @@ grep_file(const std::string& filename, std::regex& re,
                         match = std::regex_search(((const char**)p.data())[i],
                                                   re);
                     } catch (const std::regex_error& e) {
-                        std::cerr << "igrep: " << e.what() << "\n";
-                        return false;
+                        result.err = Strutil::fmt::format("igrep: {}\n",
+                                                          e.what());
+                        return;
                     }
                     found |= match;
                     if (match && !invert_match) {
                         if (list_files) {
-                            std::cout << filename << "\n";
-                            return found;
+                            result.out += filename + "\n";
+                            return;
                         }
-                        std::cout << filename << ": " << p.name() << " = "
-                                  << ((const char**)p.data())[i] << "\n";
+                        result.out += Strutil::fmt::format(
+                            "{}: {} = {}\n", filename, p.name(),
+                            ((const char**)p.data())[i]);
                     }
                 }
             }
         }
     } while (in->seek_subimage(++subimage, 0, spec));
 
-    if (invert_match) {
-        found = !found;
-        if (found)
-            std::cout << filename << "\n";
-    }
-    return found;
+    if (invert_match && !found)
+        result.out = filename + "\n";
 }
 
 
@@ -167,6 +203,10 @@ main(int argc, const char* argv[])
       .help("Print directories (when recursive)");
     ap.arg("-a", &all_subimages)
       .help("Search all subimages of each file");
+    ap.arg("--name %s:REGEX", &name_filter)
+      .help("Only consider files found by recursion whose names match this regular expression");
+    ap.arg("--threads %d:NTHREADS", &nthreads)
+      .help("Number of threads to scan with (default: 0 = all cores)");
 
     // clang-format on
     ap.parse(argc, argv);
@@ -186,8 +226,38 @@ main(int argc, const char* argv[])
 
     try {
         std::regex re(pattern, flag);
+        std::unique_ptr<std::regex> namefilter;
+        if (name_filter.size())
+            namefilter.reset(new std::regex(name_filter, flag));
+
+        // Walk the directories up front so results have a deterministic
+        // order, then grep the files with a pool of worker threads, chunk
+        // by chunk. Each worker only reads the header (ImageInput::open
+        // with no pixel reads) and buffers its output; the chunk's results
+        // are printed in discovery order as soon as the chunk completes,
+        // so output streams steadily even over huge archives.
+        std::vector<GrepTask> tasks;
         for (auto&& s : filenames)
-            grep_file(s, re);
+            gather_files(s, namefilter.get(), tasks);
+        const size_t chunksize = 1024;
+        for (size_t begin = 0; begin < tasks.size(); begin += chunksize) {
+            size_t n = std::min(chunksize, tasks.size() - begin);
+            std::vector<GrepResult> results(n);
+            parallel_for(
+                int64_t(0), int64_t(n),
+                [&](int64_t i) {
+                    grep_one(tasks[begin + i], re, results[i]);
+                },
+                // minitems=1: opening a file dwarfs task overhead.
+                paropt(nthreads, paropt::SplitDir::Y, 1));
+            for (auto&& r : results) {
+                if (r.out.size())
+                    std::cout << r.out;
+                if (r.err.size())
+                    std::cerr << r.err;
+            }
+            std::cout.flush();
+        }
     } catch (const std::regex_error& e) {
         std::cerr << "igrep: " << e.what() << "\n";
         ok = false;
@@ -9,8 +9,10 @@
 #include <ctime>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <regex>
+#include <sstream>
 
 #include <OpenImageIO/argparse.h>
 #include <OpenImageIO/deepdata.h>
@@ -18,7 +20,9 @@
 #include <OpenImageIO/hash.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/imagecache.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
 
@@ -38,17 +42,19 @@ static std::regex field_re;
 static bool subimages     = false;
 static bool compute_sha1  = false;
 static bool compute_stats = false;
+static bool quick_stats   = false;
+static int nthreads       = 0;  // default: use all cores
 
 using OIIO::print;
 
 
 
 static void
-print_sha1(ImageInput* input, int subimage, int miplevel)
+print_sha1(std::ostream& out, ImageInput* input, int subimage, int miplevel)
 {
     std::string err;
     std::string s1 = pvt::compute_sha1(input, subimage, miplevel, err);
-    print("    SHA-1: {}\n", err.size() ? err : s1);
+    print(out, "    SHA-1: {}\n", err.size() ? err : s1);
 }
 
 
@@ -57,8 +63,8 @@ print_sha1(ImageInput* input, int subimage, int miplevel)
 // Stats
 
 static bool
-read_input(const std::string& filename, ImageBuf& img, int subimage = 0,
-           int miplevel = 0)
+read_input(const std::string& filename, ImageBuf& img, std::ostream& err,
+           int subimage = 0, int miplevel = 0)
 {
     if (img.subimage() >= 0 && img.subimage() == subimage)
         return true;
@@ -66,67 +72,152 @@ read_input(const std::string& filename, ImageBuf& img, int subimage = 0,
     if (img.read(subimage, miplevel, false, TypeDesc::FLOAT))
         return true;
 
-    std::cerr << "iinfo ERROR: Could not read " << filename << ":\n\t"
-              << img.geterror() << "\n";
+    err << "iinfo ERROR: Could not read " << filename << ":\n\t"
+        << img.geterror() << "\n";
     return false;
 }
 
 
 
 static void
-print_stats(const std::string& filename, const ImageSpec& originalspec,
-            int subimage = 0, int miplevel = 0, bool indentmip = false)
+print_stats(std::ostream& out, std::ostream& err, const std::string& filename,
+            const ImageSpec& originalspec, int subimage = 0, int miplevel = 0,
+            bool indentmip = false)
 {
     const char* indent = indentmip ? "      " : "    ";
 
     ImageBuf input(filename);
-    if (!read_input(filename, input, subimage, miplevel)) {
+    if (!read_input(filename, input, err, subimage, miplevel)) {
         // Note: read_input prints an error message if one occurs
         return;
     }
 
-    std::string err;
-    if (!pvt::print_stats(std::cout, indent, input, originalspec, ROI(), err)) {
-        print("{}Stats: (unable to compute)\n", indent);
-        if (err.size())
-            std::cerr << "Error: " << err << "\n";
+    std::string errstr;
+    if (!pvt::print_stats(out, indent, input, originalspec, ROI(), errstr)) {
+        print(out, "{}Stats: (unable to compute)\n", indent);
+        if (errstr.size())
+            err << "Error: " << errstr << "\n";
+        return;
+    }
+}
+
+
+
+// Approximate statistics: rather than reading and reducing every pixel,
+// sample a bounded number of scanlines spread evenly over the data window,
+// pulling just those rows through the image cache. Min/max/NaN/Inf over the
+// sample is enough to red-flag a bad frame (NaNs, Infs, wildly out-of-range
+// values) in roughly constant time regardless of resolution, though of
+// course a defect confined to unsampled rows can be missed.
+static void
+print_quick_stats(std::ostream& out, std::ostream& err,
+                  const std::string& filename, int subimage = 0,
+                  int miplevel = 0, bool indentmip = false)
+{
+    const char* indent = indentmip ? "      " : "    ";
+
+    ImageBuf input(filename, subimage, miplevel, ImageCache::create());
+    if (!input.init_spec(filename, subimage, miplevel)) {
+        err << "iinfo ERROR: Could not read " << filename << ":\n\t"
+            << input.geterror() << "\n";
         return;
     }
+    const ImageSpec& spec(input.spec());
+    if (spec.deep) {
+        // Sampled stats make no sense for deep files; fall back.
+        print_stats(out, err, filename, spec, subimage, miplevel, indentmip);
+        return;
+    }
+
+    const int maxrows = 64;  // sample at most this many scanlines per plane
+    int ystride       = std::max(1, spec.height / maxrows);
+    int nchannels     = spec.nchannels;
+    std::vector<float> row(size_t(spec.width) * nchannels);
+    std::vector<float> cmin(nchannels, std::numeric_limits<float>::infinity());
+    std::vector<float> cmax(nchannels, -std::numeric_limits<float>::infinity());
+    std::vector<imagesize_t> nancount(nchannels, 0);
+    std::vector<imagesize_t> infcount(nchannels, 0);
+    int nsampled = 0;
+    for (int z = spec.z; z < spec.z + spec.depth; ++z) {
+        for (int y = spec.y; y < spec.y + spec.height; y += ystride) {
+            if (!input.get_pixels(ROI(spec.x, spec.x + spec.width, y, y + 1, z,
+                                      z + 1, 0, nchannels),
+                                  TypeFloat, row.data())) {
+                err << "iinfo ERROR: Could not read " << filename << ":\n\t"
+                    << input.geterror() << "\n";
+                return;
+            }
+            ++nsampled;
+            const float* val = row.data();
+            for (int x = 0; x < spec.width; ++x) {
+                for (int c = 0; c < nchannels; ++c, ++val) {
+                    if (std::isnan(*val))
+                        ++nancount[c];
+                    else if (std::isinf(*val))
+                        ++infcount[c];
+                    else {
+                        cmin[c] = std::min(cmin[c], *val);
+                        cmax[c] = std::max(cmax[c], *val);
+                    }
+                }
+            }
+        }
+    }
+
+    print(out, "{}Stats Min: ", indent);
+    for (int c = 0; c < nchannels; ++c)
+        print(out, "{:.5} ", cmin[c]);
+    print(out, "(float)\n");
+    print(out, "{}Stats Max: ", indent);
+    for (int c = 0; c < nchannels; ++c)
+        print(out, "{:.5} ", cmax[c]);
+    print(out, "(float)\n");
+    print(out, "{}Stats NanCount: ", indent);
+    for (int c = 0; c < nchannels; ++c)
+        print(out, "{} ", nancount[c]);
+    print(out, "\n");
+    print(out, "{}Stats InfCount: ", indent);
+    for (int c = 0; c < nchannels; ++c)
+        print(out, "{} ", infcount[c]);
+    print(out, "\n");
+    print(out, "{}Stats (approximate: sampled {} of {} scanlines)\n", indent,
+          nsampled, (imagesize_t)spec.height * spec.depth);
 }
 
 
 
 static void
-print_metadata(const ImageSpec& spec, const std::string& filename)
+print_metadata(std::ostream& out, const ImageSpec& spec,
+               const std::string& filename)
 {
     bool printed = false;
     if (metamatch.empty() || std::regex_search("channels", field_re)
         || std::regex_search("channel list", field_re)) {
         if (filenameprefix)
-            print("{} : ", filename);
-        print("    channel list: ");
+            print(out, "{} : ", filename);
+        print(out, "    channel list: ");
         for (int i = 0; i < spec.nchannels; ++i) {
             if (i < (int)spec.channelnames.size())
-                print("{}", spec.channelnames[i]);
+                print(out, "{}", spec.channelnames[i]);
             else
-                print("unknown");
+                print(out, "unknown");
             if (i < (int)spec.channelformats.size())
-                print(" ({})", spec.channelformats[i]);
+                print(out, " ({})", spec.channelformats[i]);
             if (i < spec.nchannels - 1)
-                print(", ");
+                print(out, ", ");
         }
-        print("\n");
+        print(out, "\n");
         printed = true;
     }
     if (spec.x || spec.y || spec.z) {
         if (metamatch.empty()
             || std::regex_search("pixel data origin", field_re)) {
             if (filenameprefix)
-                print("{} : ", filename);
-            print("    pixel data origin: x={}, y={}", spec.x, spec.y);
+                print(out, "{} : ", filename);
+            print(out, "    pixel data origin: x={}, y={}", spec.x, spec.y);
             if (spec.depth > 1)
-                print(", z={}", spec.z);
-            print("\n");
+                print(out, ", z={}", spec.z);
+            print(out, "\n");
             printed = true;
         }
     }
@@ -137,33 +228,35 @@ print_metadata(const ImageSpec& spec, const std::string& filename)
         if (metamatch.empty()
             || std::regex_search("full/display size", field_re)) {
             if (filenameprefix)
-                print("{} : ", filename);
-            print("    full/display size: {} x {}", spec.full_width,
+                print(out, "{} : ", filename);
+            print(out, "    full/display size: {} x {}", spec.full_width,
                   spec.full_height);
             if (spec.depth > 1)
-                print(" x {}", spec.full_depth);
-            print("\n");
+                print(out, " x {}", spec.full_depth);
+            print(out, "\n");
             printed = true;
         }
         if (metamatch.empty()
             || std::regex_search("full/display origin", field_re)) {
             if (filenameprefix)
-                print("{} : ", filename);
-            print("    full/display origin: {}, {}", spec.full_x, spec.full_y);
+                print(out, "{} : ", filename);
+            print(out, "    full/display origin: {}, {}", spec.full_x,
+                  spec.full_y);
             if (spec.depth > 1)
-                print(", {}", spec.full_z);
-            print("\n");
+                print(out, ", {}", spec.full_z);
+            print(out, "\n");
             printed = true;
         }
     }
     if (spec.tile_width) {
         if (metamatch.empty() || std::regex_search("tile", field_re)) {
             if (filenameprefix)
-                print("{} : ", filename);
-            print("    tile size: {} x {}", spec.tile_width, spec.tile_height);
+                print(out, "{} : ", filename);
+            print(out, "    tile size: {} x {}", spec.tile_width,
+                  spec.tile_height);
             if (spec.depth > 1)
-                print(" x {}", spec.tile_depth);
-            print("\n");
+                print(out, " x {}", spec.tile_depth);
+            print(out, "\n");
             printed = true;
         }
     }
@@ -179,20 +272,20 @@ print_metadata(const ImageSpec& spec, const std::string& filename)
             continue;
         std::string s = spec.metadata_val(p, true);
         if (filenameprefix)
-            print("{} : ", filename);
-        print("    {}: ", p.name());
+            print(out, "{} : ", filename);
+        print(out, "    {}: ", p.name());
         if (s == "1.#INF")
-            print("inf");
+            print(out, "inf");
         else
-            print("{}", s);
-        print("\n");
+            print(out, "{}", s);
+        print(out, "\n");
         printed = true;
     }
 
     if (!printed && !metamatch.empty()) {
         if (filenameprefix)
-            print("{} : ", filename);
-        print("    {}: <unknown>\n", metamatch);
+            print(out, "{} : ", filename);
+        print(out, "    {}: <unknown>\n", metamatch);
     }
 }
 
@@ -240,8 +333,9 @@ brief_format_name(TypeDesc type, int bits = 0)
 // prints basic info (resolution, width, height, depth, channels, data format,
 // and format name) about given subimage.
 static void
-print_info_subimage(int current_subimage, int max_subimages, ImageSpec& spec,
-                    ImageInput* input, const std::string& filename)
+print_info_subimage(std::ostream& out, std::ostream& err, int current_subimage,
+                    int max_subimages, ImageSpec& spec, ImageInput* input,
+                    const std::string& filename)
 {
     if (!input->seek_subimage(current_subimage, 0, spec))
         return;
@@ -262,42 +356,43 @@ print_info_subimage(int current_subimage, int max_subimages, ImageSpec& spec,
               || std::regex_search("resolution, width, height, depth, channels",
                                    field_re));
     if (printres && max_subimages > 1 && subimages) {
-        print(" subimage {:2}: ", current_subimage);
-        print("{:4} x {:4}", spec.width, spec.height);
+        print(out, " subimage {:2}: ", current_subimage);
+        print(out, "{:4} x {:4}", spec.width, spec.height);
         if (spec.depth > 1)
-            print(" x {:4}", spec.depth);
+            print(out, " x {:4}", spec.depth);
         int bits = spec.get_int_attribute("oiio:BitsPerSample", 0);
-        print(", {} channel, {}{}{}", spec.nchannels, spec.deep ? "deep " : "",
-              spec.depth > 1 ? "volume " : "",
+        print(out, ", {} channel, {}{}{}", spec.nchannels,
+              spec.deep ? "deep " : "", spec.depth > 1 ? "volume " : "",
               extended_format_name(spec.format, bits));
-        print(" {}", input->format_name());
-        print("\n");
+        print(out, " {}", input->format_name());
+        print(out, "\n");
     }
     // Count MIP levels
     ImageSpec mipspec;
     while (input->seek_subimage(current_subimage, nmip, mipspec)) {
         if (printres) {
             if (nmip == 1)
-                print("    MIP-map levels: {}x{}", spec.width, spec.height);
-            print(" {}x{}", mipspec.width, mipspec.height);
+                print(out, "    MIP-map levels: {}x{}", spec.width,
+                      spec.height);
+            print(out, " {}x{}", mipspec.width, mipspec.height);
         }
         ++nmip;
     }
     if (printres && nmip > 1)
-        print("\n");
+        print(out, "\n");
 
     if (compute_sha1
         && (metamatch.empty() || std::regex_search("sha-1", field_re))) {
         if (filenameprefix)
-            print("{} : ", filename);
+            print(out, "{} : ", filename);
         // Before sha-1, be sure to point back to the highest-res MIP level
         ImageSpec tmpspec;
         input->seek_subimage(current_subimage, 0, tmpspec);
-        print_sha1(input, current_subimage, 0);
+        print_sha1(out, input, current_subimage, 0);
     }
 
     if (verbose)
-        print_metadata(spec, filename);
+        print_metadata(out, spec, filename);
 
     if (compute_stats
         && (metamatch.empty() || std::regex_search("stats", field_re))) {
@@ -305,12 +400,17 @@ print_info_subimage(int current_subimage, int max_subimages, ImageSpec& spec,
             ImageSpec mipspec;
             input->seek_subimage(current_subimage, m, mipspec);
             if (filenameprefix)
-                print("{} : ", filename);
+                print(out, "{} : ", filename);
             if (nmip > 1 && (subimages || m == 0)) {
-                print("    MIP {} of {} ({} x {}):\n", m, nmip, mipspec.width,
-                      mipspec.height);
+                print(out, "    MIP {} of {} ({} x {}):\n", m, nmip,
+                      mipspec.width, mipspec.height);
             }
-            print_stats(filename, spec, current_subimage, m, nmip > 1);
+            if (quick_stats)
+                print_quick_stats(out, err, filename, current_subimage, m,
+                                  nmip > 1);
+            else
+                print_stats(out, err, filename, spec, current_subimage, m,
+                            nmip > 1);
         }
     }
 
@@ -321,9 +421,9 @@ print_info_subimage(int current_subimage, int max_subimages, ImageSpec& spec,
 
 
 static void
-print_info(const std::string& filename, size_t namefieldlength,
-           ImageInput* input, ImageSpec& spec, bool verbose, bool sum,
-           long long& totalsize)
+print_info(std::ostream& out, std::ostream& err, const std::string& filename,
+           size_t namefieldlength, ImageInput* input, ImageSpec& spec,
+           bool verbose, bool sum, long long& totalsize)
 {
     int padlen = std::max(0, (int)namefieldlength - (int)filename.length());
     std::string padding(padlen, ' ');
@@ -355,57 +455,58 @@ print_info(const std::string& filename, size_t namefieldlength,
     if (metamatch.empty()
         || std::regex_search("resolution, width, height, depth, channels",
                              field_re)) {
-        print("{}{} : {:4} x {:4}", filename, padding, spec.width, spec.height);
+        print(out, "{}{} : {:4} x {:4}", filename, padding, spec.width,
+              spec.height);
         if (spec.depth > 1)
-            print(" x {:4}", spec.depth);
-        print(", {} channel, {}{}", spec.nchannels, spec.deep ? "deep " : "",
-              spec.depth > 1 ? "volume " : "");
+            print(out, " x {:4}", spec.depth);
+        print(out, ", {} channel, {}{}", spec.nchannels,
+              spec.deep ? "deep " : "", spec.depth > 1 ? "volume " : "");
         if (spec.channelformats.size()) {
             for (size_t c = 0; c < spec.channelformats.size(); ++c)
-                print("{}{}", c ? "/" : "", spec.channelformat(c));
+                print(out, "{}{}", c ? "/" : "", spec.channelformat(c));
         } else {
             int bits = spec.get_int_attribute("oiio:BitsPerSample", 0);
-            print("{}", extended_format_name(spec.format, bits));
+            print(out, "{}", extended_format_name(spec.format, bits));
         }
-        print(" {}", input->format_name());
+        print(out, " {}", input->format_name());
         if (sum) {
             imagesize_t imagebytes = spec.image_bytes(true);
             totalsize += imagebytes;
-            print(" ({:.2f} MB)", (float)imagebytes / (1024.0 * 1024.0));
+            print(out, " ({:.2f} MB)", (float)imagebytes / (1024.0 * 1024.0));
         }
         // we print info about how many subimages are stored in file
         // only when we have more then one subimage
         if (!verbose && num_of_subimages != 1)
-            print(" ({} subimages{})", num_of_subimages,
+            print(out, " ({} subimages{})", num_of_subimages,
                   any_mipmapping ? " +mipmap)" : "");
         if (!verbose && num_of_subimages == 1 && any_mipmapping)
-            print(" (+mipmap)");
-        print("\n");
+            print(out, " (+mipmap)");
+        print(out, "\n");
     }
 
     int movie = spec.get_int_attribute("oiio:Movie");
     if (verbose && num_of_subimages != 1) {
         // info about num of subimages and their resolutions
-        print("    {} subimages: ", num_of_subimages);
+        print(out, "    {} subimages: ", num_of_subimages);
         for (int i = 0; i < num_of_subimages; ++i) {
             input->seek_subimage(i, 0, spec);
             int bits = spec.get_int_attribute("oiio:BitsPerSample",
                                               spec.format.size() * 8);
             if (i)
-                print(", ");
+                print(out, ", ");
             if (spec.depth > 1)
-                print("{}x{}x{} ", spec.width, spec.height, spec.depth);
+                print(out, "{}x{}x{} ", spec.width, spec.height, spec.depth);
             else
-                print("{}x{} ", spec.width, spec.height);
+                print(out, "{}x{} ", spec.width, spec.height);
             // print("[");
             for (int c = 0; c < spec.nchannels; ++c)
-                print("{:c}{}", c ? ',' : '[',
+                print(out, "{:c}{}", c ? ',' : '[',
                       brief_format_name(spec.channelformat(c), bits));
-            print("]");
+            print(out, "]");
             if (movie)
                 break;
         }
-        print("\n");
+        print(out, "\n");
     }
 
     // if the '-a' flag is not set we print info
@@ -413,8 +514,41 @@ print_info(const std::string& filename, size_t namefieldlength,
     if (!subimages)
         num_of_subimages = 1;
     for (int i = 0; i < num_of_subimages; ++i) {
-        print_info_subimage(i, num_of_subimages, spec, input, filename);
+        print_info_subimage(out, err, i, num_of_subimages, spec, input,
+                            filename);
+    }
+}
+
+
+
+// Everything printed for one file, buffered so the reports can be emitted
+// in command-line order no matter which thread finished first.
+struct InfoResult {
+    std::string out;
+    std::string err;
+    long long size = 0;  // this file's contribution to the -s total
+    bool ok        = true;
+};
+
+
+
+static void
+info_one(const std::string& filename, size_t namefieldlength, InfoResult& r)
+{
+    std::ostringstream out, err;
+    auto in = ImageInput::open(filename);
+    if (!in) {
+        std::string e = geterror();
+        print(err, "iinfo ERROR: \"{}\" : {}\n", filename,
+              e.size() ? e : std::string("Could not open file."));
+        r.ok = false;
+    } else {
+        ImageSpec spec = in->spec();
+        print_info(out, err, filename, namefieldlength, in.get(), spec,
+                   verbose, sum, r.size);
     }
+    r.out = out.str();
+    r.err = err.str();
 }
 
 
@@ -451,6 +585,10 @@ main(int argc, const char* argv[])
       .action(ArgParse::store_true());
     ap.arg("--stats", &compute_stats)
       .help("Print image pixel statistics (data window)");
+    ap.arg("--quickstats", &quick_stats)
+      .help("Print approximate pixel statistics from subsampled scanlines (implies --stats)");
+    ap.arg("--threads %d:NTHREADS", &nthreads)
+      .help("Number of threads to process files with (default: 0 = all cores)");
     // clang-format on
     if (ap.parse(argc, argv) < 0 || filenames.empty()) {
         std::cerr << ap.geterror() << std::endl;
@@ -458,6 +596,9 @@ main(int argc, const char* argv[])
         return help ? EXIT_SUCCESS : EXIT_FAILURE;
     }
 
+    if (quick_stats)
+        compute_stats = true;
+
     if (!metamatch.empty()) {
         field_re.assign(metamatch, std::regex_constants::extended
                                        | std::regex_constants::icase);
@@ -469,19 +610,33 @@ main(int argc, const char* argv[])
         longestname = std::max(longestname, s.length());
     longestname = std::min(longestname, (size_t)40);
 
-    int returncode      = EXIT_SUCCESS;
-    long long totalsize = 0;
-    for (auto&& s : filenames) {
-        auto in = ImageInput::open(s);
-        if (!in) {
-            std::string err = geterror();
-            print(std::cerr, "iinfo ERROR: \"{}\" : {}\n", s,
-                  err.size() ? err : std::string("Could not open file."));
-            returncode = EXIT_FAILURE;
-            continue;
+    // Process the files with a pool of worker threads, chunk by chunk. Each
+    // worker buffers everything it would print; the chunk's reports are
+    // printed in command-line order as soon as the chunk completes, so the
+    // output is identical to a serial run.
+    int returncode         = EXIT_SUCCESS;
+    long long totalsize    = 0;
+    const size_t chunksize = 256;
+    for (size_t begin = 0; begin < filenames.size(); begin += chunksize) {
+        size_t n = std::min(chunksize, filenames.size() - begin);
+        std::vector<InfoResult> results(n);
+        parallel_for(
+            int64_t(0), int64_t(n),
+            [&](int64_t i) {
+                info_one(filenames[begin + i], longestname, results[i]);
+            },
+            // minitems=1: each file is its own task.
+            paropt(nthreads, paropt::SplitDir::Y, 1));
+        for (auto&& r : results) {
+            if (r.out.size())
+                std::cout << r.out;
+            if (r.err.size())
+                std::cerr << r.err;
+            totalsize += r.size;
+            if (!r.ok)
+                returncode = EXIT_FAILURE;
         }
-        ImageSpec spec = in->spec();
-        print_info(s, longestname, in.get(), spec, verbose, sum, totalsize);
+        std::cout.flush();
     }
 
     if (sum)
@@ -8,7 +8,9 @@
 
 #include <OpenImageIO/export.h>
 #include <OpenImageIO/fmath.h>
+#include <OpenImageIO/half.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/span.h>
 #include <OpenImageIO/typedesc.h>
 #include <OpenImageIO/ustring.h>
 
@@ -38,12 +40,32 @@ public:
         apply((float*)data, 1, 1, 3, sizeof(float), 3 * sizeof(float),
               3 * sizeof(float));
     }
+
+    /// Return the source text of a GPU shader implementing this color
+    /// transformation in the requested shading language (`"glsl"`,
+    /// `"hlsl"`, and for sufficiently new OpenColorIO also `"msl"` or
+    /// `"osl"`), with its entry point named `function`. This lets an
+    /// application that renders on the GPU apply the same transformation
+    /// there, built from the very processor that OIIO has already created
+    /// and cached, rather than reconstructing the color pipeline itself.
+    /// Returns the empty string if this processor has no GPU
+    /// implementation or the language is not supported.
+    virtual std::string gpu_shader_text(string_view language = "glsl",
+                                        string_view function
+                                        = "OIIO_colorconvert") const
+    {
+        return std::string();
+    }
 };
 
 // Preprocessor symbol to allow conditional compilation depending on
 // whether the ColorProcessor class is exposed (it was not prior to OIIO 1.9).
 #define OIIO_HAS_COLORPROCESSOR 1
 
+// Preprocessor symbol to allow conditional compilation depending on
+// whether ColorProcessor::gpu_shader_text is available.
+#define OIIO_COLORPROCESSOR_HAS_GPU_SHADER 1
+
 
 
 typedef std::shared_ptr<ColorProcessor> ColorProcessorHandle;
@@ -421,4 +443,36 @@ linear_to_Rec709(float x)
 }
 
 
+/// Bulk sRGB-to-linear conversion of a span of values. For uint8 and
+/// uint16 sources (interpreted as the usual [0,max] encoding of [0,1])
+/// and for half sources, these are backed by lookup tables covering every
+/// possible input value, so they are exact and never touch pow(); the
+/// float flavor uses a branch-free SIMD evaluation. `dst` must have at
+/// least as many elements as `src`; source and destination may not
+/// overlap except for the in-place float case where they coincide
+/// exactly. These are transfer-function conversions only -- no change of
+/// color primaries, no special treatment of alpha (don't pass alpha
+/// channels through them).
+///
+/// This was added in version 2.6.
+OIIO_API void
+sRGB_to_linear(cspan<unsigned char> src, span<float> dst);
+OIIO_API void
+sRGB_to_linear(cspan<unsigned short> src, span<float> dst);
+OIIO_API void
+sRGB_to_linear(cspan<half> src, span<float> dst);
+OIIO_API void
+sRGB_to_linear(cspan<float> src, span<float> dst);
+
+/// Bulk linear-to-sRGB conversion of a span of values, the counterpart of
+/// the bulk sRGB_to_linear above: the half flavor is an exact lookup over
+/// all possible half bit patterns, the float flavor is branch-free SIMD.
+///
+/// This was added in version 2.6.
+OIIO_API void
+linear_to_sRGB(cspan<half> src, span<float> dst);
+OIIO_API void
+linear_to_sRGB(cspan<float> src, span<float> dst);
+
+
 OIIO_NAMESPACE_END
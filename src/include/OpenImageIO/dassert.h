@@ -60,6 +60,22 @@
 #endif
 
 
+/// OIIO_HOTPATH_DASSERT is for checks sitting on per-pixel or per-sample
+/// hot paths (span indexing, ImageBuf iterator stepping). It is the same
+/// as OIIO_DASSERT ordinarily, but compiles out entirely -- even in debug
+/// builds -- when OIIO_UNCHECKED_HOT_PATHS is defined (the
+/// UNCHECKED_HOT_PATHS CMake option), so a "verified fast" build can
+/// elide them while API-boundary checks remain. Use OIIO_DASSERT for
+/// anything not demonstrably on a hot path.
+#if defined(OIIO_UNCHECKED_HOT_PATHS) && OIIO_UNCHECKED_HOT_PATHS
+#    define OIIO_HOTPATH_DASSERT(x) ((void)sizeof(x))          /*NOLINT*/
+#    define OIIO_HOTPATH_DASSERT_MSG(x, ...) ((void)sizeof(x)) /*NOLINT*/
+#else
+#    define OIIO_HOTPATH_DASSERT OIIO_DASSERT
+#    define OIIO_HOTPATH_DASSERT_MSG OIIO_DASSERT_MSG
+#endif
+
+
 /// ASSERT and ASSERT_MSG (and, ugh, ASSERTMSG) are deprecated assertion
 /// macros. They are deprecated for two reasons: (1) terrible names pollute
 /// the global namespace and might conflict with other packages; and (2)
@@ -130,6 +130,15 @@ public:
     /// position index.
     void erase_samples(int64_t pixel, int samplepos, int n = 1);
 
+    /// Compact the deep data so that every pixel's capacity exactly
+    /// matches its number of samples, with all sample data contiguous in
+    /// memory in pixel order. Growing a pixel past its capacity moves its
+    /// samples to pooled overflow storage, and erasing samples leaves
+    /// holes; compact() squeezes both out, giving the layout wanted for
+    /// final file output. This invalidates any pointers previously
+    /// returned by data_ptr().
+    void compact();
+
     /// Retrieve the value of the given pixel, channel, and sample index,
     /// cast to a `float`.
     float deep_value(int64_t pixel, int channel, int sample) const;
@@ -160,6 +169,13 @@ public:
     /// channel for each pixel.
     void get_pointers(std::vector<void*>& pointers) const;
 
+    /// Fill in the span with pointers to the start of each channel for
+    /// each pixel in the range `[pixbegin,pixend)` (NULL for pixels with
+    /// no samples). The span must hold at least
+    /// `(pixend-pixbegin) * channels()` entries.
+    void get_pointers(int64_t pixbegin, int64_t pixend,
+                      span<void*> pointers) const;
+
     /// Copy a deep sample from `src` to this `DeepData`. They must have the
     /// same channel layout. Return `true` if ok, `false` if the operation
     /// could not be performed.
@@ -184,6 +200,10 @@ public:
     /// Sort the samples of the pixel by their `Z` depth.
     void sort(int64_t pixel);
 
+    /// Sort the samples of every pixel by their `Z` depth, using multiple
+    /// threads for large images.
+    void sort();
+
     /// Merge any adjacent samples in the pixel that exactly overlap in z
     /// range. This is only useful if the pixel has previously been split at
     /// all sample starts and ends, and sorted by Z.  Note that this may
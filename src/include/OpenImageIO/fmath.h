@@ -934,6 +934,13 @@ template<>
 void convert_type<half,float> (const half *src, float *dst, size_t n,
                                float /*_min*/, float /*_max*/)
 {
+#if OIIO_SIMD >= 16 && OIIO_F16C_ENABLED
+    // AVX-512 can convert a full cache line of halfs per instruction
+    for ( ; n >= 16; n -= 16, src += 16, dst += 16) {
+        simd::vfloat16 s_simd (src);
+        s_simd.store (dst);
+    }
+#endif
 #if OIIO_SIMD >= 8 && OIIO_F16C_ENABLED
     // If f16c ops are enabled, it's worth doing this by 8's
     for ( ; n >= 8; n -= 8, src += 8, dst += 8) {
@@ -956,6 +963,13 @@ void
 convert_type<float,half> (const float *src, half *dst, size_t n,
                           half /*_min*/, half /*_max*/)
 {
+#if OIIO_SIMD >= 16 && OIIO_F16C_ENABLED
+    // AVX-512 can convert a full cache line of halfs per instruction
+    for ( ; n >= 16; n -= 16, src += 16, dst += 16) {
+        simd::vfloat16 s (src);
+        s.store (dst);
+    }
+#endif
 #if OIIO_SIMD >= 8 && OIIO_F16C_ENABLED
     // If f16c ops are enabled, it's worth doing this by 8's
     for ( ; n >= 8; n -= 8, src += 8, dst += 8) {
@@ -2092,6 +2106,36 @@ OIIO_FORCEINLINE OIIO_HOSTDEVICE float fast_cbrt (float x) {
 }
 
 
+// Restricted to the simd vector types (which have a nested vint_t), so
+// that scalar arguments of other types still resolve to the float overload
+// below rather than instantiating this template.
+template<typename T, typename = typename T::vint_t>
+OIIO_FORCEINLINE OIIO_HOSTDEVICE T fast_erf (const T& x)
+{
+    using namespace simd;
+    typedef typename T::vint_t intN;
+    // See float fast_erf for explanations and error statistics.
+    const T a1 (0.0705230784f);
+    const T a2 (0.0422820123f);
+    const T a3 (0.0092705272f);
+    const T a4 (0.0001520143f);
+    const T a5 (0.0002765672f);
+    const T a6 (0.0000430638f);
+    const T one (1.0f);
+    const T a = abs(x);
+    const T b = one - (one - a); // crush denormals
+    const T r = madd(madd(madd(madd(madd(madd(a6, b, a5), b, a4), b, a3), b, a2), b, a1), b, one);
+    const T s = r * r; // ^2
+    const T t = s * s; // ^4
+    const T u = t * t; // ^8
+    const T v = u * u; // ^16
+    // copysign (1 - 1/v, x), done with bit twiddling
+    intN signbit = bitcast_to_int(x) & intN(int(0x80000000u));
+    return bitcast_to_float((bitcast_to_int(one - one / v)
+                             & intN(0x7fffffff)) | signbit);
+}
+
+
 OIIO_FORCEINLINE OIIO_HOSTDEVICE float fast_erf (float x)
 {
 #ifndef __CUDA_ARCH__
@@ -2116,6 +2160,15 @@ OIIO_FORCEINLINE OIIO_HOSTDEVICE float fast_erf (float x)
 #endif
 }
 
+// Like fast_erf, restricted to the simd vector types.
+template<typename T, typename = typename T::vint_t>
+OIIO_FORCEINLINE OIIO_HOSTDEVICE T fast_erfc (const T& x)
+{
+    // See float fast_erfc for error statistics.
+    return T(1.0f) - fast_erf(x);
+}
+
+
 OIIO_FORCEINLINE OIIO_HOSTDEVICE float fast_erfc (float x)
 {
 #ifndef __CUDA_ARCH__
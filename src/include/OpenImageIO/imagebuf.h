@@ -179,7 +179,14 @@ public:
     /// @param config
     ///             Optionally, a pointer to an ImageSpec whose metadata
     ///             contains configuration hints that set options related
-    ///             to the opening and reading of the file.
+    ///             to the opening and reading of the file. In addition to
+    ///             the hints understood by the file format readers, a hint
+    ///             of `"imagebuf:use_imagecache"` overrides the global
+    ///             attribute of the same name for this one file; hinting 0
+    ///             is a lightweight "peek" mode in which `init_spec()`
+    ///             reads the header directly with an ImageInput and
+    ///             registers nothing in any ImageCache, which is the cheap
+    ///             way to interrogate many files for their specs alone.
     /// @param ioproxy
     ///         Optional pointer to an IOProxy to use when reading from the
     ///         file. The caller retains ownership of the proxy, and must
@@ -1352,10 +1359,11 @@ public:
         // Note: called *after* m_x was incremented!
         inline void pos_xincr()
         {
-            OIIO_DASSERT(m_exists && m_valid);   // precondition
-            OIIO_DASSERT(valid(m_x, m_y, m_z));  // should be true by definition
+            OIIO_HOTPATH_DASSERT(m_exists && m_valid);  // precondition
+            OIIO_HOTPATH_DASSERT(
+                valid(m_x, m_y, m_z));  // should be true by definition
             if (m_localpixels) {
-                OIIO_DASSERT(m_proxydata != nullptr);
+                OIIO_HOTPATH_DASSERT(m_proxydata != nullptr);
                 m_proxydata += m_pixel_stride;
                 if (OIIO_UNLIKELY(m_x >= m_img_xend))
                     pos_xincr_local_past_end();
@@ -1386,11 +1394,19 @@ public:
         // about ImageCache.
         void OIIO_API release_tile();
 
-        // Check if the IB is writable, make it so if it isn't.
+        // Check if the IB is writable, make it so if it isn't. This branch
+        // runs once per set() on the write-iterator hot path, so the
+        // verified-fast build (OIIO_UNCHECKED_HOT_PATHS) elides it and
+        // instead demands -- checked in debug -- that write iterators only
+        // ever target buffers that are already local.
         OIIO_FORCEINLINE void ensure_writable()
         {
+#if defined(OIIO_UNCHECKED_HOT_PATHS) && OIIO_UNCHECKED_HOT_PATHS
+            OIIO_DASSERT(m_ib->storage() != IMAGECACHE);
+#else
             if (OIIO_UNLIKELY(m_ib->storage() == IMAGECACHE))
                 make_writable();
+#endif
         }
         // Do the dirty work of making the IB writable.
         void OIIO_API make_writable();
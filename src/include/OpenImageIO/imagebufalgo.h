@@ -199,6 +199,60 @@ namespace ImageBufAlgo {
 using KWArgs = ParamValueSpan;
 
 
+/// An ImageBufPool is a small arena of reusable ImageBuf allocations for
+/// chained image processing pipelines. Ops that take an initialized `dst`
+/// of the right spec reuse its storage, so by drawing destinations from a
+/// pool and releasing them when done, a chain of N ops ping-pongs between
+/// a couple of allocations instead of allocating N full images.
+///
+/// `get()` returns a `shared_ptr<ImageBuf>` whose deleter automatically
+/// returns the buffer to the pool, recycling both the ImageBuf and (when
+/// the spec footprint matches) its pixel allocation. Pixels of a recycled
+/// buffer are NOT cleared -- the expectation is that the buffer will be
+/// used as the destination of an op that overwrites its whole ROI.
+///
+/// Example:
+///
+///     ImageBufAlgo::ImageBufPool pool;
+///     auto a = pool.get(spec);
+///     ImageBufAlgo::add(*a, src, 0.5f);
+///     auto b = pool.get(spec);
+///     ImageBufAlgo::mul(*b, *a, 2.0f);
+///     a.reset();   // a's storage is now available for reuse
+///     ...
+///
+/// All methods are thread-safe. It is fine for handed-out buffers to
+/// outlive the pool; they are simply freed when released.
+///
+/// Also note that most element-wise operations (add, sub, mul, div, and
+/// the like, as well as colorconvert) may be executed fully in place by
+/// passing the same image as both `dst` and an input, which needs no
+/// extra buffer at all.
+class OIIO_API ImageBufPool {
+public:
+    ImageBufPool();
+    ~ImageBufPool();
+    ImageBufPool(const ImageBufPool&) = delete;
+    const ImageBufPool& operator=(const ImageBufPool&) = delete;
+
+    /// Return a buffer reset to `spec`, recycling a previously released
+    /// buffer if one is available (preferring one whose pixel allocation
+    /// is exactly the right size). The buffer returns to the pool when
+    /// the last copy of the shared_ptr is destroyed.
+    std::shared_ptr<ImageBuf> get(const ImageSpec& spec);
+
+    /// Discard all idle buffers held by the pool.
+    void clear();
+
+    /// Number of idle buffers currently held by the pool.
+    size_t size() const;
+
+private:
+    struct Impl;
+    std::shared_ptr<Impl> m_impl;
+};
+
+
 /// Create an all-black `float` image of size and channels as described by
 /// the ROI.
 ImageBuf OIIO_API zero (ROI roi, int nthreads=0);
@@ -681,6 +735,73 @@ ImageBuf OIIO_API resize(const ImageBuf &src, KWArgs options = {},
 bool OIIO_API resize(ImageBuf &dst, const ImageBuf &src, KWArgs options = {},
                      ROI roi = {}, int nthreads=0);
 
+
+/// A ResizePlan is a reusable, precomputed "plan" for repeated `resize()`
+/// calls that share the same source and destination geometry and filter
+/// (in the manner of FFTW plans). The first `resize()` call using a plan
+/// precomputes the per-column and per-row separable filter weight and
+/// index tables; subsequent calls reuse them, skipping all per-call filter
+/// evaluation and running a fast two-pass separable kernel. If the
+/// geometry or filter changes between calls, the plan is transparently
+/// rebuilt. A plan may be reused across any number of images, but a single
+/// plan must not be used concurrently by multiple threads.
+///
+/// Example:
+///
+///     ImageBufAlgo::ResizePlan plan;
+///     for (auto& frame : frames) {
+///         ImageBuf dst(dstspec);
+///         ImageBufAlgo::resize(dst, frame, plan, {{"filtername", "lanczos3"}});
+///         ...
+///     }
+///
+class OIIO_API ResizePlan {
+public:
+    ResizePlan();
+    ~ResizePlan();
+    // A plan holds precomputed tables tied to one geometry; copying it
+    // makes no sense.
+    ResizePlan(const ResizePlan&) = delete;
+    ResizePlan& operator=(const ResizePlan&) = delete;
+
+    struct Impl;
+
+private:
+    std::unique_ptr<Impl> m_impl;
+    friend bool resize(ImageBuf &dst, const ImageBuf &src, ResizePlan &plan,
+                       KWArgs options, ROI roi, int nthreads);
+};
+
+/// Resize using a reusable ResizePlan. The `options` are the same as for
+/// the plain `resize()` above, and the results are the same; the plan only
+/// caches the filter and its precomputed weight tables between calls.
+ImageBuf OIIO_API resize(const ImageBuf &src, ResizePlan &plan,
+                         KWArgs options = {}, ROI roi = {}, int nthreads = 0);
+bool OIIO_API resize(ImageBuf &dst, const ImageBuf &src, ResizePlan &plan,
+                     KWArgs options = {}, ROI roi = {}, int nthreads = 0);
+
+/// Fused proxy generation: resize `src` into `dst`, apply a display color
+/// transform, and lightly sharpen, all in a single traversal -- the trio
+/// that proxy/dailies pipelines otherwise run as three full-frame passes.
+/// The color transform and sharpen are applied to each destination
+/// scanline while it is still hot from the resize filter, roughly halving
+/// the memory traffic of the separate calls.
+///
+/// Optional `options` recognized include the `resize()` filter choices
+/// (`filtername`, `filterwidth`, `filterptr`) plus:
+/// - "fromspace", "tospace" : color space names for the display transform
+///   (as for `colorconvert()`; no transform if "tospace" is not supplied).
+/// - "contextkey", "contextvalue", "unpremult" : as for `colorconvert()`.
+/// - "sharpen" : unsharp mask contrast (float, default: 0 = no sharpen),
+///   using a 3-wide gaussian kernel as `unsharp_mask()` does by default.
+/// - "sharpenthreshold" : unsharp threshold (float, default: 0).
+///
+/// This was added in version 2.6.
+ImageBuf OIIO_API make_proxy(const ImageBuf &src, KWArgs options = {},
+                             ROI roi = {}, int nthreads = 0);
+bool OIIO_API make_proxy(ImageBuf &dst, const ImageBuf &src,
+                         KWArgs options = {}, ROI roi = {}, int nthreads = 0);
+
 /// @}
 
 
@@ -1067,6 +1188,57 @@ ImageBuf OIIO_API pow (const ImageBuf &A, cspan<float> B,
 bool OIIO_API pow (ImageBuf &dst, const ImageBuf &A, cspan<float> B,
                    ROI roi={}, int nthreads=0);
 
+
+/// `Deferred` builds a small expression graph of element-wise operations
+/// over one source image and executes the whole chain in a single
+/// tile-parallel traversal when `execute()` is called.  Compared to a
+/// chain of the individual immediate calls, which each allocate and
+/// traverse a full intermediate image, the fused execution reads the
+/// source once and writes the result once, so memory-bandwidth-bound
+/// chains speed up roughly in proportion to their length.
+///
+///     ImageBuf out = ImageBufAlgo::Deferred(src)
+///                        .mul(0.5f)
+///                        .add(offsets)
+///                        .clamp(0.0f, 1.0f)
+///                        .execute();
+///
+/// Per-channel constant spans follow the usual convention: missing
+/// trailing entries replicate the last supplied value.  Only element-wise
+/// stages can be fused; operations that change resolution or gather
+/// neighboring pixels (resize, blur, ...) still need their own pass.
+class OIIO_API Deferred {
+public:
+    /// Begin a deferred chain reading from `src`, which must remain valid
+    /// until `execute()` is called.
+    Deferred (const ImageBuf &src);
+    ~Deferred ();
+    Deferred (const Deferred&) = delete;
+    const Deferred& operator= (const Deferred&) = delete;
+
+    ///@{
+    /// Append an element-wise stage to the chain.
+    Deferred& add (cspan<float> val);
+    Deferred& sub (cspan<float> val);
+    Deferred& mul (cspan<float> val);
+    Deferred& div (cspan<float> val);           /// x/0 yields 0, as IBA::div
+    Deferred& mad (cspan<float> a, cspan<float> b);   /// pixel*a + b
+    Deferred& pow (cspan<float> p);
+    Deferred& clamp (cspan<float> min, cspan<float> max);
+    Deferred& invert ();                        /// 1 - pixel
+    Deferred& abs ();
+    ///@}
+
+    /// Run the fused chain over `roi` (default: the source's full pixel
+    /// window) and return the result.  If there was an error, the result
+    /// will be uninitialized with an error message set.
+    ImageBuf execute (ROI roi={}, int nthreads=0);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
 /// Normalize a 3D vector texture (i.e., divide each pixel by its length).
 /// This function assumes a 3-channel image that represents a 3-vector, or a
 /// 4-channel image that represents a 3-vector plus an alpha value. If an
@@ -1369,6 +1541,18 @@ struct OIIO_API PixelStats {
 /// PixelStats structure. Upon success, the returned vectors in the result
 /// structure will have size == src.nchannels(). If there is a failure, the
 /// vector sizes will be 0 and an error will be set in src.
+///
+/// The `options` list contains optional ParamValue's that control the
+/// statistics computation. The following options are recognized:
+///
+///   - "stride" : int (default: 1)
+///
+///     If greater than 1, only inspect every stride-th pixel of every
+///     stride-th row. This computes fast approximate statistics on large
+///     images; the counts and moments describe only the sampled pixels,
+///     and min/max are those of the sampled subset.
+PixelStats OIIO_API computePixelStats (const ImageBuf &src, KWArgs options,
+                                       ROI roi={}, int nthreads=0);
 PixelStats OIIO_API computePixelStats (const ImageBuf &src,
                                        ROI roi={}, int nthreads=0);
 
@@ -1414,6 +1598,29 @@ CompareResults OIIO_API compare (const ImageBuf &A, const ImageBuf &B,
                                  float failrelative, float warnrelative,
                                  ROI roi={}, int nthreads=0);
 
+/// Numerically compare two images, with the thresholds and other controls
+/// supplied as optional keyword arguments:
+///
+/// - "failthresh" : float (default: 0.0)
+/// - "warnthresh" : float (default: 0.0)
+/// - "failrelative" : float (default: 0.0)
+/// - "warnrelative" : float (default: 0.0)
+///
+///   The absolute and relative failure and warning thresholds, with the
+///   same meanings as for the other compare() varieties.
+///
+/// - "maxfailures" : int (default: 0)
+///
+///   If nonzero, abandon the comparison as soon as at least this many
+///   pixels have failed. This can return dramatically faster for grossly
+///   mismatched images when the caller only needs to know whether the
+///   failure count exceeds a criterion, at the expense of the aggregate
+///   statistics: when the early exit is taken, nfail and nwarn are lower
+///   bounds, and meanerror/rms_error/PSNR describe only the portion of
+///   the image scanned before giving up.
+CompareResults OIIO_API compare (const ImageBuf &A, const ImageBuf &B,
+                                 KWArgs options, ROI roi={}, int nthreads=0);
+
 /// Numerically compare two images.  The difference threshold (for any
 /// individual color channel in any pixel) for a "failure" is
 /// failthresh, and for a "warning" is warnthresh.  The results are
@@ -1576,6 +1783,33 @@ std::string OIIO_API computePixelHashSHA1 (const ImageBuf &src,
                                            int blocksize = 0, int nthreads=0);
 
 
+/// Compute a hash of the pixels of `src` within `roi` (defaulting to the
+/// whole image), like `computePixelHashSHA1()` but with a choice of hash
+/// `algorithm`:
+///
+/// - "sha1" (the default): identical in every way to
+///   `computePixelHashSHA1()`, returning its 40 hex digit digest.
+/// - "xxh64": the much faster (though non-cryptographic) 64-bit xxhash,
+///   returned as 16 hex digits. For `blocksize == 0`, the digest is the
+///   XXH64 hash of the raw pixels in scanline order followed by
+///   `extrainfo`, computed in chunks with each chunk's hash seeding the
+///   next (initial seed 0). For `blocksize > 0`, each `blocksize` batch of
+///   scanlines is hashed independently (seed 0, no extrainfo) and the
+///   final digest is the chained XXH64 hash of the block digest strings in
+///   order, then `extrainfo`. This tree construction lets the blocks be
+///   hashed concurrently by `nthreads` threads, but, as with the SHA-1
+///   version, yields a different (still stable and documented) digest than
+///   `blocksize == 0`.
+///
+/// An unrecognized algorithm name returns an empty string and sets an
+/// error on `src`.
+std::string OIIO_API computePixelHash (const ImageBuf &src,
+                                       string_view extrainfo = "",
+                                       string_view algorithm = "sha1",
+                                       ROI roi = {},
+                                       int blocksize = 0, int nthreads = 0);
+
+
 /// Compute a histogram of `src`, for the given channel and ROI. Return a
 /// vector of length `bins` that contains the counts of how many pixel
 /// values were in each of `bins` equally spaced bins covering the range of
@@ -1592,6 +1826,22 @@ std::vector<imagesize_t> histogram (const ImageBuf &src, int channel=0,
                                     ROI roi={}, int nthreads=0);
 
 
+/// Compute histograms of all the channels in `roi` in a single pass over
+/// the pixels, returning one vector of bin counts per channel (index 0 of
+/// the outer vector corresponds to channel `roi.chbegin`). Binning, range,
+/// and `ignore_empty` behave exactly as for the single-channel
+/// `histogram()`; this is simply cheaper than calling it once per channel,
+/// which would re-read the whole image each time.
+///
+/// If there was an error, the returned vector will be empty, and an error
+/// message will be retrievable from src.geterror().
+OIIO_API
+std::vector<std::vector<imagesize_t>>
+histogram_channels (const ImageBuf &src, int bins=256,
+                    float min=0.0f, float max=1.0f, bool ignore_empty=false,
+                    ROI roi={}, int nthreads=0);
+
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 /// DEPRECATED(1.9)
 OIIO_DEPRECATED("use version that returns vector (1.9)")
@@ -1805,6 +2055,46 @@ bool OIIO_API median_filter (ImageBuf &dst, const ImageBuf &src,
                              ROI roi={}, int nthreads=0);
 
 
+/// Return a bilateral-filtered version of the corresponding region of
+/// `src`. The bilateral filter is an edge-preserving smoother: each pixel
+/// is replaced by a weighted average of its neighborhood, where the weight
+/// combines a spatial Gaussian of standard deviation `sigma_s` (in pixels)
+/// with a range Gaussian of standard deviation `sigma_r` (in pixel value
+/// units) on the color difference, so averaging does not cross strong
+/// edges. Larger `sigma_r` smooths more aggressively; the window size is
+/// derived from `sigma_s`.
+///
+/// This was added in version 2.6.
+ImageBuf OIIO_API bilateral_filter (const ImageBuf &src,
+                                    float sigma_s = 2.0f, float sigma_r = 0.1f,
+                                    ROI roi={}, int nthreads=0);
+/// Write to an existing image `dst` (allocating if it is uninitialized).
+bool OIIO_API bilateral_filter (ImageBuf &dst, const ImageBuf &src,
+                                float sigma_s = 2.0f, float sigma_r = 0.1f,
+                                ROI roi={}, int nthreads=0);
+
+
+/// Return a guided-filtered version of the corresponding region of `src`,
+/// using He et al.'s box-filter formulation, whose cost is independent of
+/// `radius`. The guided filter is edge-preserving like the bilateral, but
+/// the edges it preserves are those of `guide`, making it useful for
+/// filtering noisy AOVs guided by a cleaner channel (albedo, normals); if
+/// `guide` is uninitialized, `src` guides itself. `radius` is the window
+/// half-width and `eps` is the regularization that controls how strong an
+/// edge must be to survive (in squared pixel-value units). Channel `c` of
+/// `src` is guided by channel `min(c, guide.nchannels()-1)` of `guide`.
+///
+/// This was added in version 2.6.
+ImageBuf OIIO_API guided_filter (const ImageBuf &src, const ImageBuf &guide,
+                                 int radius = 4, float eps = 0.01f,
+                                 ROI roi={}, int nthreads=0);
+/// Write to an existing image `dst` (allocating if it is uninitialized).
+bool OIIO_API guided_filter (ImageBuf &dst, const ImageBuf &src,
+                             const ImageBuf &guide,
+                             int radius = 4, float eps = 0.01f,
+                             ROI roi={}, int nthreads=0);
+
+
 /// Return a sharpened version of the corresponding region of `src` using
 /// the "unsharp mask" technique. Unsharp masking basically works by first
 /// blurring the image (low pass filter), subtracting this from the original
@@ -2359,6 +2649,13 @@ enum MakeTextureMode {
 ///                           When `maketx:cdf` is active, determines the
 ///                           number of bits to use for the size of the CDF
 ///                           table. (default: 8, meaning 256 bins)
+///    - `maketx:sidecar` (int) :
+///                           If nonzero, also write a sidecar index file
+///                           (named by appending ".txidx" to the output
+///                           filename) recording the specs of all subimages
+///                           and MIP levels, which lets the ImageCache
+///                           learn the layout of the texture with a single
+///                           small read when it first opens it. (default: 0)
 ///
 /// @param  mode
 ///    Describes what type of texture file we are creating and may
@@ -2417,6 +2714,28 @@ bool OIIO_API make_texture (MakeTextureMode mode,
 /// @}
 
 
+/// Return the cheapest available preview of the named image file, suitable
+/// for browsing or initial display, with longest edge approximately
+/// `goalsize` pixels. Sources are tried in strictly increasing cost order
+/// and the first that succeeds wins:
+///
+/// 1. A thumbnail embedded in the file (EXR, JPEG, camera raw).
+/// 2. The coarsest MIP level of a mipmapped file that still meets
+///    `goalsize`.
+/// 3. A reduced-resolution decode, for formats that can do one natively
+///    (e.g. JPEG DCT scaling via the "jpeg:scale" open hint).
+/// 4. As a last resort, a full decode followed by a fast resample.
+///
+/// The first three avoid ever decoding the full-resolution pixels. The
+/// returned proxy is not guaranteed to be exactly `goalsize` (embedded
+/// thumbnails come as authored; MIP levels and scaled decodes come in the
+/// steps the file provides). On failure, the returned ImageBuf has an
+/// error set.
+///
+/// This was added in version 2.6.
+ImageBuf OIIO_API fast_proxy (string_view filename, int goalsize = 256);
+
+
 /// Convert an OpenCV cv::Mat into an ImageBuf, copying the pixels (optionally
 /// converting to the pixel data type specified by `convert`, if not UNKNOWN,
 /// which means to preserve the original data type if possible).  Return true
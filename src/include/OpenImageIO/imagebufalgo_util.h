@@ -36,6 +36,13 @@ namespace ImageBufAlgo {
 /// fastest (due to cache layout issues?), but perhaps there are algorithms
 /// where it's better to split in X, Z, or along the longest axis.
 ///
+/// SplitDir::WSTile selects a work-stealing dispatch: the region is carved
+/// into small tiles, and each participating thread repeatedly claims the
+/// next unclaimed tile until none remain. This load-balances much better
+/// than the static splits when the per-pixel cost of `f` varies a lot
+/// across the image (threads that draw cheap tiles just take more of
+/// them), at the cost of slightly more scheduling overhead.
+///
 inline void
 parallel_image(ROI roi, paropt opt, std::function<void(ROI)> f)
 {
@@ -53,6 +60,35 @@ parallel_image(ROI roi, paropt opt, std::function<void(ROI)> f)
 
     // If splitdir was not explicit, find the longest edge.
     paropt::SplitDir splitdir = opt.splitdir();
+    if (splitdir == paropt::SplitDir::WSTile) {
+        // Work-stealing tile dispatch: carve the region into tiles sized
+        // like SplitDir::Tile, but instead of pre-assigning them, have
+        // each worker repeatedly claim the next unclaimed tile from a
+        // shared atomic counter until all are done.
+        int64_t n    = std::min<imagesize_t>(opt.minitems(), roi.npixels());
+        int tilesize = std::max(1, int(std::sqrt(n)) / 4);
+        int64_t nxtiles = (roi.width() + tilesize - 1) / tilesize;
+        int64_t nytiles = (roi.height() + tilesize - 1) / tilesize;
+        int64_t ntiles  = nxtiles * nytiles;
+        std::atomic<int64_t> nexttile(0);
+        auto worker = [&]() {
+            for (int64_t i = nexttile++; i < ntiles; i = nexttile++) {
+                int tx = int(i % nxtiles);
+                int ty = int(i / nxtiles);
+                f(ROI(roi.xbegin + tx * tilesize,
+                      std::min(roi.xbegin + (tx + 1) * tilesize, roi.xend),
+                      roi.ybegin + ty * tilesize,
+                      std::min(roi.ybegin + (ty + 1) * tilesize, roi.yend),
+                      roi.zbegin, roi.zend, roi.chbegin, roi.chend));
+            }
+        };
+        task_set tasks(opt.pool());
+        int nworkers = int(std::min(int64_t(opt.maxthreads()), ntiles));
+        for (int i = 1; i < nworkers; ++i)
+            tasks.push(opt.pool()->push([&](int /*id*/) { worker(); }));
+        worker();  // this thread claims tiles, too
+        return;    // task_set destructor waits for the helpers
+    }
     if (splitdir == paropt::SplitDir::Biggest)
         splitdir = roi.width() > roi.height() ? paropt::SplitDir::X
                                               : paropt::SplitDir::Y;
@@ -90,6 +126,45 @@ parallel_image(ROI roi, std::function<void(ROI)> f)
 
 
 
+/// Helper template for deterministic parallel reductions over an ROI.
+///
+/// The roi is carved into horizontal bands of `chunksize` scanlines. The
+/// band boundaries are fixed by the roi and chunksize alone -- never by
+/// the thread count -- and each band accumulates into its own
+/// default-constructed `Partial` via `accum(partial, bandroi)`. (A
+/// default-constructed Partial is presumed to be the reduction identity;
+/// any further initialization is `accum`'s job.) After all bands
+/// complete, the partials are folded into `result` strictly in band
+/// order on the calling thread with `merge(result, partial)`. Because
+/// both the band boundaries and the merge order are fixed, floating
+/// point reductions produce bit-identical results from run to run, no
+/// matter how many threads executed the bands or how they were
+/// scheduled. Bands are whole contiguous scanline runs, so `accum` is
+/// free to vectorize across x.
+template<class Partial, class Accum, class Merge>
+inline void
+parallel_reduce(ROI roi, paropt opt, Partial& result, Accum accum, Merge merge,
+                int64_t chunksize = 64)
+{
+    chunksize      = std::max(int64_t(1), chunksize);
+    size_t nchunks = size_t((roi.height() + chunksize - 1) / chunksize);
+    std::vector<Partial> partials(nchunks);
+    parallel_for_chunked(
+        roi.ybegin, roi.yend, chunksize,
+        [&](int64_t ybegin, int64_t yend) {
+            ROI bandroi(roi.xbegin, roi.xend, int(ybegin), int(yend),
+                        roi.zbegin, roi.zend, roi.chbegin, roi.chend);
+            Partial p;
+            accum(p, bandroi);
+            partials[size_t((ybegin - roi.ybegin) / chunksize)] = std::move(p);
+        },
+        opt);
+    for (auto& p : partials)
+        merge(result, p);
+}
+
+
+
 /// Common preparation for IBA functions: Given an ROI (which may or may not
 /// be the default ROI::All()), destination image (which may or may not yet
 /// be allocated), and optional input images, adjust roi if necessary and
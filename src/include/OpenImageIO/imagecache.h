@@ -21,9 +21,25 @@
 // Is the getattributetype() method present? (Added in 2.5)
 #define OIIO_IMAGECACHE_SUPPORTS_GETATTRIBUTETYPE 1
 
+// Are attribute transactions and batched getattributes() present?
+// (Added in 2.6)
+#define OIIO_IMAGECACHE_SUPPORTS_ATTRIBUTE_TRANSACTIONS 1
+
 // Does invalidate() support the optional `force` flag?
 #define OIIO_IMAGECACHE_INVALIDATE_FORCE 1
 
+// Is region-granular invalidate(filename, subimage, roi) present?
+// (Added in 2.6)
+#define OIIO_IMAGECACHE_INVALIDATE_REGION 1
+
+// Does add_tile() support the optional `replace` flag for write-through
+// replacement of already-cached tiles? (Added in 2.6)
+#define OIIO_IMAGECACHE_ADD_TILE_REPLACE 1
+
+// Are prefetch_sequence() and cancel_sequence_prefetch() present, for
+// background prefetching of frame sequences during playback? (Added in 2.6)
+#define OIIO_IMAGECACHE_SEQUENCE_PREFETCH 1
+
 
 
 OIIO_NAMESPACE_BEGIN
@@ -147,6 +163,92 @@ public:
     ///           application to see which leads to higher performance.
     /// - `int autoscanline` :
     ///           autotile using full width tiles
+    /// - `int volume_bricksize` :
+    ///           If nonzero, volumetric files whose native tiles are
+    ///           smaller than this in any dimension are cached in larger
+    ///           "bricks" of roughly this size per axis (rounded up to a
+    ///           multiple of the native tile size, e.g. 32 for the 8^3
+    ///           leaf nodes of OpenVDB). A ray marching through the
+    ///           volume then touches a handful of bricks instead of a new
+    ///           tiny tile every few samples. (default: 0)
+    /// - `int tile_prefetch` :
+    ///           If nonzero, a tile cache miss will also speculatively
+    ///           queue asynchronous reads of the adjacent tiles at the
+    ///           same MIP level, on the theory that coherent access
+    ///           patterns will want them soon and the I/O can overlap
+    ///           with other work. (default: 0)
+    /// - `int async_tile_reads` :
+    ///           If nonzero, `get_pixels()` will submit all the missing
+    ///           tiles covering the requested region as a batch of
+    ///           concurrent reads on the thread pool, rather than
+    ///           faulting them in serially. (default: 0)
+    /// - `int mmap_files` :
+    ///           If nonzero, the cache will memory-map each image file
+    ///           and have its reader do I/O through the mapping, so tile
+    ///           reads cost page-cache faults rather than read syscalls.
+    ///           Formats whose readers don't accept an IOProxy fall back
+    ///           to ordinary I/O. Not supported on Windows. (default: 0)
+    /// - `int microcache_tiles` :
+    ///           If nonzero, each thread keeps a set-associative
+    ///           microcache of roughly this many recently used tiles,
+    ///           consulted before the shared tile cache, so coherent
+    ///           access patterns avoid the shared-map probe and lock.
+    ///           Note that entries pin their tiles' memory until
+    ///           replaced or invalidated. (default: 0)
+    /// - `float max_compressed_memory_MB` :
+    ///           If nonzero, tiles evicted from the primary cache are
+    ///           compressed (zlib, fastest setting) into a second tier
+    ///           with this memory budget (in MB) instead of being
+    ///           discarded. A later request for such a tile decompresses
+    ///           it, which is much cheaper than re-reading and decoding
+    ///           it from disk. (default: 0, tier disabled)
+    /// - `string shared_tile_cache` :
+    ///           If set to a nonempty name, attach to (creating if
+    ///           needed) a named node-local shared-memory segment of
+    ///           decoded tiles, so that multiple processes reading the
+    ///           same textures on one machine share a single decode.
+    ///           Lookups that hit the shared pool copy pixels out of it
+    ///           instead of re-reading the file; freshly decoded tiles
+    ///           are published back. Set to "" to detach. Not supported
+    ///           on Windows. (default: "", disabled)
+    /// - `float shared_tile_cache_MB` :
+    ///           Size of the shared segment to create, in MB. Only
+    ///           consulted when `shared_tile_cache` is set and the
+    ///           segment does not already exist. (default: 512)
+    /// - `string eviction_policy` :
+    ///           Policy for choosing which tiles to drop when over the
+    ///           memory budget: "lru" (the default, pure recency) or
+    ///           "costaware", which additionally spares tiles that were
+    ///           measurably more expensive to read than the typical
+    ///           evictee (e.g. heavily compressed tiles on slow
+    ///           filesystems) for an extra sweep, sacrificing cheap
+    ///           tiles first.
+    /// - `int udim_preresolve` :
+    ///           If nonzero, the first lookup that touches any tile of a
+    ///           UDIM set resolves and opens all of the set's files
+    ///           concurrently on the thread pool, rather than each file
+    ///           being opened serially the first time shading happens to
+    ///           touch it. (default: 0)
+    /// - `int lazy_invalidate` :
+    ///           If nonzero, `invalidate()` is O(1): it bumps a per-file
+    ///           generation counter instead of walking the tile cache,
+    ///           and stale tiles are rejected at lookup time and evicted
+    ///           preferentially by the memory sweep. Helpful to keep
+    ///           interactive texture-edit reloads from stalling shading
+    ///           threads. (default: 0)
+    /// - `int async_file_close` :
+    ///           If nonzero, when the open file handle limit is exceeded,
+    ///           the sweep that closes least-recently-used handles runs as
+    ///           a background task on the thread pool instead of inside
+    ///           the tile request that tripped the limit. (default: 0)
+    /// - `int trace_events` :
+    ///           If nonzero, record a lightweight event log of file opens
+    ///           and tile reads (name, start time, duration). The log can
+    ///           be retrieved at any time as Chrome trace-event JSON via
+    ///           `getattribute("stat:chrome_trace")`, suitable for
+    ///           overlaying on an application's own traces. Enabling
+    ///           (from a disabled state) clears any prior log and resets
+    ///           the trace epoch. (default: 0)
     /// - `int automip` :
     ///           If 0 (the default), an untiled single-subimage file will
     ///           only be able to utilize that single subimage.
@@ -178,6 +280,16 @@ public:
     ///           simplify their image manipulations to only need to
     ///           consider `float` data. The default is zero, meaning that
     ///           image pixels are not forced to be `float` when in cache.
+    /// - `int storehalf` :
+    ///           If set to nonzero, image tiles that would otherwise be
+    ///           stored in the cache as `float` (such as those from
+    ///           `float` or `double` files) will be demoted to `half`,
+    ///           halving their cache footprint. Texture filtering and
+    ///           pixel retrieval convert back to `float` on the fly. This
+    ///           trades a bit of precision (usually well below render
+    ///           noise levels) for substantially more effective cache
+    ///           capacity. Has no effect when `forcefloat` is also set.
+    ///           The default is zero. (This was added in version 2.6.)
     /// - `int failure_retries` :
     ///           When an image file is opened or a tile/scanline is read but
     ///           a file error occurs, if this attribute is nonzero, it will
@@ -199,6 +311,28 @@ public:
     ///             If nonzero, work harder to make sure that we have
     ///             smaller possible overages to the max open files limit.
     ///             (Default: 0)
+    /// - `int max_open_files_auto` :
+    ///             If nonzero, the cache will automatically adjust
+    ///             `max_open_files` within bounds: it raises the limit when
+    ///             statistics show files being closed and promptly reopened
+    ///             (thrash), and lowers it when re-opens start failing,
+    ///             which indicates that the process is running short of
+    ///             file descriptors. The limit never rises above half the
+    ///             process's descriptor rlimit. The decisions made, and
+    ///             why, may be retrieved as a multi-line string via
+    ///             `getattribute("stat:max_open_files_trace")`.
+    ///             (Default: 0)
+    /// - `int device_memory` :
+    ///             If nonzero and a GPU compute device has been enabled
+    ///             (via the global `OIIO::attribute("gpu:device", ...)`),
+    ///             tile pixel memory is allocated from the device's
+    ///             unified memory, so GPU code can sample cached tiles
+    ///             directly while CPU-side use is unchanged. Tile
+    ///             eviction and cache budgets apply to these tiles
+    ///             exactly as to ordinary ones. Changing this option
+    ///             invalidates the cache, since existing tiles live in
+    ///             the wrong kind of memory. Has no effect when the
+    ///             compute device is the CPU. (Default: 0)
     /// - `string substitute_image` :
     ///           When set to anything other than the empty string, the
     ///           ImageCache will use the named image in place of *all*
@@ -225,6 +359,15 @@ public:
     ///           enabled, this reduces the number of file opens, at the
     ///           expense of not being able to open files if their format do
     ///           not actually match their filename extension). Default: 0
+    /// - `int use_sidecar` :
+    ///           When nonzero, if a texture file is accompanied by a
+    ///           sidecar index file (written by `maketx` with the
+    ///           `maketx:sidecar` option), use it to learn the specs of
+    ///           all the file's subimages and MIP levels with one small
+    ///           read, rather than seeking through every level's header
+    ///           when the file is first opened. The sidecar is validated
+    ///           against the texture's size, modification time, and a
+    ///           checksum, and is ignored if it appears stale. Default: 1
     /// - `string colorspace` :
     ///           The working colorspace of the texture system. Default: none.
     /// - `string colorconfig` :
@@ -363,6 +506,28 @@ public:
     /// Specialized `attribute()` for setting a single string value.
     virtual bool attribute (string_view name, string_view val) = 0;
 
+    /// Begin an "attribute transaction": until the matching
+    /// `commit_attribute_transaction()`, any `attribute()` calls record
+    /// their new values immediately but defer the cache invalidation or
+    /// other rebuild of derived state that the change would ordinarily
+    /// trigger. The commit then performs at most one invalidation pass, no
+    /// matter how many of the batched changes requested one. Use this when
+    /// reconfiguring many options at once (for example, between frames of
+    /// a render) to avoid paying for repeated invalidations. Transactions
+    /// may nest; only the outermost commit applies the deferred work. Like
+    /// `attribute()` itself, transactions must not be issued concurrently
+    /// from multiple threads.
+    ///
+    /// This was added in version 2.6.
+    virtual void begin_attribute_transaction() = 0;
+
+    /// End an attribute transaction started by
+    /// `begin_attribute_transaction()`, applying (once) any invalidation
+    /// that was deferred by the `attribute()` calls made in between.
+    ///
+    /// This was added in version 2.6.
+    virtual void commit_attribute_transaction() = 0;
+
     /// Get the named attribute, store it in `*val`. All of the attributes
     /// that may be set with the `attribute() call` may also be queried with
     /// `getattribute()`.
@@ -418,6 +583,16 @@ public:
     /// This was added in version 2.5.
     virtual TypeDesc getattributetype(string_view name) const = 0;
 
+    /// Retrieve a batch of attributes with a single call: for each entry
+    /// of `names`, look up the attribute's type and current value and
+    /// append it to `vals`. Names that are not recognized (or whose type
+    /// cannot be determined via `getattributetype()`) are skipped. Returns
+    /// the number of attributes retrieved.
+    ///
+    /// This was added in version 2.6.
+    virtual int getattributes(cspan<string_view> names,
+                              ParamValueList& vals) const = 0;
+
     /// @}
 
 
@@ -890,6 +1065,23 @@ public:
     /// already have an `ImageHandle*` for the file you want to invalidate.
     virtual void invalidate(ImageHandle* file, bool force = true) = 0;
 
+    /// Region-granular invalidation: drop only the cached tiles of
+    /// `subimage` of the named file that intersect `roi`, expressed in the
+    /// pixel coordinates of the highest-resolution MIP level. Tiles of
+    /// coarser MIP levels whose footprint overlaps the region are dropped
+    /// as well (re-MIPing changes them too), the open file handle is
+    /// closed so the next read sees the updated bytes, and everything
+    /// outside the region stays cached. This is the right call for
+    /// interactive paint-style loops that rewrite a small portion of a
+    /// texture: only the tiles under the brush are reread. It assumes the
+    /// image's geometry (resolution, tiling, channels) is unchanged; if
+    /// the file was restructured, use the whole-file `invalidate()`
+    /// instead. An undefined `roi` or out-of-range `subimage` falls back
+    /// to whole-file invalidation.
+    ///
+    /// This was added in version 2.6.
+    virtual void invalidate(ustring filename, int subimage, ROI roi) = 0;
+
     /// Invalidate all loaded tiles and close open file handles.  This is
     /// safe to do even if other procedures are currently holding
     /// reference-counted tile pointers from the named image, but those
@@ -909,6 +1101,42 @@ public:
     /// modify image files on disk.
     virtual void close (ustring filename) = 0;
 
+    /// Pre-open and parse the headers of all the named files (UTF-8
+    /// encoded) as concurrent tasks on the default thread pool, returning
+    /// the number that were successfully opened.  An app that knows up
+    /// front which textures a scene references can call this before
+    /// rendering starts so that first lookups are not dominated by serial
+    /// open + header parsing.  Files that are missing or broken are simply
+    /// not counted; they will produce errors later if actually used.
+    virtual int preopen (const std::vector<ustring>& filenames) = 0;
+
+    /// Hint that a playback tool is about to step through the frames of a
+    /// numbered file sequence, so the cache should pre-open upcoming
+    /// frames and pre-fill their tiles on background threads.  `pattern`
+    /// is a frame-number pattern of the kind understood by
+    /// `Filesystem::enumerate_file_sequence()` (such as
+    /// `"shot.%04d.exr"`), and the frames prefetched are `firstframe`,
+    /// `firstframe+stride`, ... for `nframes` frames.  Prefetching stops
+    /// when approximately `bytebudget` bytes of tiles have been queued (0
+    /// means one quarter of the cache's `max_memory_MB`).  The call
+    /// returns immediately; tiles appear in the cache as the background
+    /// reads complete, so a subsequent `get_pixels()` on a prefetched
+    /// frame finds its tiles already resident.  Calling this again --
+    /// e.g. each time the playhead advances or jumps -- cancels the
+    /// previous prefetch and starts over from the new position.
+    ///
+    /// This was added in version 2.6.
+    virtual void prefetch_sequence (string_view pattern, int firstframe,
+                                    int nframes, int stride = 1,
+                                    long long bytebudget = 0) = 0;
+
+    /// Cancel any sequence prefetch in progress (for example, when
+    /// playback stops).  Returns immediately; background tasks notice the
+    /// cancellation and wind down at tile granularity.
+    ///
+    /// This was added in version 2.6.
+    virtual void cancel_sequence_prefetch () = 0;
+
     /// `close()` all files known to the cache.
     virtual void close_all () = 0;
 
@@ -1001,11 +1229,26 @@ public:
     /// data is assumed to be in some kind of persistent storage and will
     /// not be copied, nor will its pixels take up additional memory in the
     /// cache.
+    ///
+    /// Ordinarily, if the cache already holds a tile with this ID (for
+    /// example, one read from a file-backed entry), the supplied pixels are
+    /// ignored and the cached copy stands. If `replace` is true, the
+    /// supplied pixels supplant the cached copy instead -- a "write
+    /// through" that lets an application that is modifying an image (e.g.,
+    /// interactive painting) update the cache immediately and defer the
+    /// file write, without paying for a whole-file or region invalidation
+    /// and re-read. Subsequent lookups, in any thread, will see the new
+    /// pixels. The caller is still responsible for eventually writing the
+    /// modified image to the file (followed by an `invalidate()` if the
+    /// pixels pushed here did not exactly match what was written).
+    ///
+    /// The `replace` parameter was added in version 2.6.
     virtual bool add_tile (ustring filename, int subimage, int miplevel,
                      int x, int y, int z, int chbegin, int chend,
                      TypeDesc format, const void *buffer,
                      stride_t xstride=AutoStride, stride_t ystride=AutoStride,
-                     stride_t zstride=AutoStride, bool copy = true) = 0;
+                     stride_t zstride=AutoStride, bool copy = true,
+                     bool replace = false) = 0;
 
     /// @}
 
@@ -663,6 +663,22 @@ public:
     /// Populates the fields of the `ImageSpec` based on the XML passed in.
     void from_xml (const char *xml);
 
+    /// Returns a compact, versioned binary serialization of the full
+    /// `ImageSpec`, including all metadata. It is length-prefixed and
+    /// little-endian regardless of the host, requires no text parsing to
+    /// reconstitute (see `from_blob()`), and is much faster than the XML
+    /// flavor for shipping specs between processes or caching them on
+    /// disk. It is not intended as a stable archival format -- blobs
+    /// should be read by the same or a newer OIIO release than wrote
+    /// them.
+    std::vector<char> to_blob () const;
+
+    /// Populates the fields of the `ImageSpec` from a binary blob
+    /// produced by `to_blob()`. Return true on success, false if the blob
+    /// is malformed or of an unsupported version (in which case the
+    /// `ImageSpec` is left unmodified).
+    bool from_blob (cspan<char> blob);
+
     /// Hunt for the "Compression" and "CompressionQuality" settings in the
     /// spec and turn them into the compression name and quality. This
     /// handles compression name/qual combos of the form "name:quality".
@@ -883,6 +899,21 @@ public:
         return open(Strutil::utf16_to_utf8(filename), config, ioproxy);
     }
 
+    /// Asynchronous version of `open()`: returns immediately with a
+    /// `std::future` that will eventually hold the result of opening the
+    /// file on a thread pool worker. This lets a server-style application
+    /// keep a very large number of opens and decodes in flight with only a
+    /// small number of threads -- the futures compose with any executor or
+    /// coroutine runtime that can adapt a `std::future` into an awaitable.
+    /// All the semantics of `open()` apply; in particular, a failed open
+    /// yields an empty `unique_ptr` with the error retrievable via
+    /// `OIIO::geterror()`.
+    ///
+    /// This was added in version 2.6.
+    static std::future<unique_ptr>
+    open_async(const std::string& filename, const ImageSpec* config = nullptr,
+               Filesystem::IOProxy* ioproxy = nullptr);
+
     /// Create and return an ImageInput implementation that is able to read
     /// the given file or format.  If `do_open` is true (and the `filename`
     /// is the name of a file, not just a format), fully open it if possible
@@ -1317,6 +1348,22 @@ public:
                                  stride_t xstride=AutoStride,
                                  stride_t ystride=AutoStride);
 
+    /// Asynchronous version of the thread-safe `read_scanlines()`: returns
+    /// immediately with a `std::future` that will hold the result of
+    /// performing the read on a thread pool worker. The caller must keep
+    /// `data` (and this ImageInput) alive until the future is ready.
+    /// Because the underlying call is the explicit subimage/miplevel
+    /// read_scanlines, multiple async reads of different regions of the
+    /// same input may safely be in flight simultaneously.
+    ///
+    /// This was added in version 2.6.
+    std::future<bool> read_scanlines_async(int subimage, int miplevel,
+                                           int ybegin, int yend, int z,
+                                           int chbegin, int chend,
+                                           TypeDesc format, void* data,
+                                           stride_t xstride = AutoStride,
+                                           stride_t ystride = AutoStride);
+
 #ifndef OIIO_DOXYGEN
     // DEPRECATED versions of read_scanlines (pre-1.9 OIIO). These will
     // eventually be removed. Try to replace these calls with ones to the
@@ -1485,6 +1532,18 @@ public:
                              ProgressCallback progress_callback=NULL,
                              void *progress_callback_data=NULL);
 
+    /// Asynchronous version of the thread-safe `read_image()`: returns
+    /// immediately with a `std::future` that will hold the result of
+    /// performing the read on a thread pool worker. The caller must keep
+    /// `data` (and this ImageInput) alive until the future is ready.
+    ///
+    /// This was added in version 2.6.
+    std::future<bool> read_image_async(int subimage, int miplevel, int chbegin,
+                                       int chend, TypeDesc format, void* data,
+                                       stride_t xstride = AutoStride,
+                                       stride_t ystride = AutoStride,
+                                       stride_t zstride = AutoStride);
+
 #ifndef OIIO_DOXYGEN
     // DEPRECATED versions of read_image (pre-1.9 OIIO). These will
     // eventually be removed. Try to replace these calls with ones to the
@@ -1617,6 +1676,22 @@ public:
                                         int ybegin, int yend, int z,
                                         int chbegin, int chend, void *data);
 
+    /// Return the height (in scanlines) of the format's natural unit of
+    /// independent decoding for this subimage and MIP level -- a TIFF
+    /// strip, an OpenEXR scanline chunk, a JPEG restart interval, etc.
+    /// A reader should only return a nonzero value if its
+    /// read_native_scanlines not merely tolerates but actually profits
+    /// from being called concurrently for disjoint unit-aligned scanline
+    /// ranges -- that is, if concurrent calls truly decode in parallel
+    /// rather than serializing on an internal lock or a stateful codec
+    /// stream. The base class read_image() uses this to orchestrate a
+    /// pool-parallel decode generically for any format that opts in,
+    /// instead of each reader reinventing its own threading. The default
+    /// returns 0, meaning reads of this file proceed one range at a time.
+    virtual int native_chunk_rows (int subimage, int miplevel) {
+        return 0;
+    }
+
     /// Read a single tile (all channels) of native data into contiguous
     /// memory. The base class read_native_tile fails. A format reader that
     /// supports tiles MUST overload this virtual method that reads a single
@@ -2843,6 +2918,17 @@ OIIO_API std::string geterror(bool clear = true);
 ///    many threads as the amount of hardware concurrency detected. Note
 ///    that this is separate from the OIIO `"threads"` attribute.
 ///
+/// - `int threads:adaptive_spin_count` (64)
+///
+///    How many optimistic spin attempts the adaptive locks guarding hot
+///    internal structures (such as the ImageCache shards) make before
+///    parking the waiting thread in the kernel. The default behaves like a
+///    brief spin lock in the common uncontended case while degrading
+///    gracefully when machines are oversubscribed. Set it to 0 to park
+///    immediately (pure blocking locks, recommended when several
+///    many-threaded processes share the same cores), or to a very large
+///    value to approximate pure spin locks.
+///
 /// - `string font_searchpath`
 ///
 ///    Colon-separated (or semicolon-separated) list of directories to search
@@ -2870,6 +2956,16 @@ OIIO_API std::string geterror(bool clear = true);
 ///    zero, the only reader that will be tried is the one implied by the file
 ///    extension.
 ///
+/// - `int read:drop_cache`
+///
+///    When nonzero, files opened for reading without a caller-supplied
+///    IOProxy are marked for one-pass streaming access: the OS is advised
+///    to use aggressive readahead and to drop the file's pages from its
+///    cache as they are consumed. Use when transcoding large files or
+///    sequences that will be read exactly once, so they don't evict more
+///    useful data from the page cache. The default is 0. (This was added
+///    in version 2.6.)
+///
 /// - `int read_chunk`
 ///
 ///    When performing a `read_image()`, this is the number of scanlines it
@@ -2925,6 +3021,22 @@ OIIO_API std::string geterror(bool clear = true);
 ///    When nonzero, use the new "OpenEXR core C library" when available,
 ///    for OpenEXR >= 3.1. This is experimental, and currently defaults to 0.
 ///
+/// - `int ptex:max_memory_MB` (1024)
+///
+///    Memory budget (in MB) of the shared Ptex cache through which all
+///    Ptex files are read. Must be set before the first Ptex file is
+///    opened to have any effect.
+///
+/// - `string ocio:lut3d_cache_dir`
+///
+///    If set to the name of a writable directory, color transforms
+///    created through OpenColorIO are baked to 3D lattice LUT files in
+///    that directory and reloaded by later processes, making cold-process
+///    colorconvert setup nearly free. The lattice (65^3, trilinearly
+///    interpolated over [0,1]) is an approximation of the exact
+///    transform, so this trades a small amount of precision for speed and
+///    is off by default (empty string).
+///
 /// - `int limits:channels` (1024)
 ///
 ///    When nonzero, the maximum number of color channels in an image. Image
@@ -2963,6 +3075,25 @@ OIIO_API std::string geterror(bool clear = true);
 ///    the log information. When the `log_times` attribute is disabled,
 ///    there is no additional performance cost.
 ///
+/// - `int profiler:enable` (0)
+///
+///    When nonzero, scoped `ProfilerZone` regions (see `profiler.h`) are
+///    recorded into per-thread buffers. The merged parent/child time tree
+///    may be retrieved with `OIIO::getattribute("profiler:report", ...)`,
+///    or the raw timeline in Chrome trace-event JSON with
+///    `OIIO::getattribute("profiler:trace", ...)`. Setting the write-only
+///    attribute `"profiler:clear"` (to any int) discards all recorded
+///    zones. When disabled (the default), a zone costs only a single
+///    atomic check.
+///
+///    Library operations are pre-instrumented: ImageBufAlgo op spans,
+///    ImageInput/ImageOutput open/read/write phases, ImageCache tile
+///    fetches, and thread-pool task execution all record zones. Setting
+///    the string attribute `"profiler:tracefile"` (or the environment
+///    variable `OPENIMAGEIO_TRACE_FILE`) names a file to receive the
+///    Chrome trace JSON at process exit and implicitly enables the
+///    profiler, so a slow job can produce a flame chart with no rebuild.
+///
 /// - `oiio:print_uncaught_errors` (1)
 ///
 ///   If nonzero, upon program exit, any error messages that would have been
@@ -2997,6 +3128,15 @@ OIIO_API std::string geterror(bool clear = true);
 ///   If nonzero, an `ImageBuf` that references a file but is not given an
 ///   ImageCache will read the image through the default ImageCache.
 ///
+/// - `imagebuf:device_memory` (0)
+///
+///   If nonzero and a GPU compute device has been enabled (see
+///   `gpu:device`), `ImageBuf` will allocate its local pixel memory from
+///   the device's unified memory, so that device code can read and write
+///   the pixels directly without an explicit transfer, while all CPU-side
+///   access continues to work as usual. Has no effect when the compute
+///   device is the CPU.
+///
 OIIO_API bool attribute(string_view name, TypeDesc type, const void* val);
 
 /// Shortcut attribute() for setting a single integer.
@@ -3126,6 +3266,16 @@ inline bool attribute (string_view name, string_view val) {
 ///   the approximate process memory used (resident) by the application, in
 ///   MB.
 ///
+/// - `int64 memory:imagebuf`, `int64 memory:imagebuf_peak`,
+///   `int64 memory:imagecache_tiles`, `int64 memory:deepdata`,
+///   `int64 memory:process`
+///
+///   Read-only per-subsystem memory telemetry, in bytes: pixel memory
+///   currently held by ImageBuf local buffers (and its process-lifetime
+///   peak), tile pixel memory held by all ImageCaches, DeepData sample
+///   storage, and total process resident size. These let monitoring
+///   attribute residency to a subsystem when setting memory budgets.
+///
 /// - `string timing_report`
 ///
 ///    Retrieving this attribute returns the timing report generated by the
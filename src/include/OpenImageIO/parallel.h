@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
@@ -79,7 +80,11 @@ public:
 class OIIO_UTIL_API paropt {
 public:
     enum class ParStrategy : short { Default = 0, TryTBB, OIIOpool };
-    enum class SplitDir : short { X, Y, Z, Biggest, Tile };
+    // Split strategies. Most carve the region up front; WSTile instead
+    // carves it into small tiles that worker threads claim dynamically
+    // (work-stealing), which load-balances much better when per-item cost
+    // varies across the region.
+    enum class SplitDir : short { X, Y, Z, Biggest, Tile, WSTile };
 
     constexpr paropt(int maxthreads = 0, SplitDir splitdir = SplitDir::Y,
                      size_t minitems = 1024) noexcept
@@ -165,6 +170,19 @@ public:
         return *this;
     }
 
+    /// If affinity is on, chunks are deterministically aimed at particular
+    /// pool workers (still stealable if those workers fall behind), so
+    /// that repeated passes over the same region touch the same threads.
+    /// Combined with NUMA pinning of the pool workers (env variable
+    /// OPENIMAGEIO_NUMA_PIN=1), this gives first-touch memory locality on
+    /// multi-node machines.
+    constexpr bool affinity() const noexcept { return m_affinity; }
+    paropt& affinity(bool a) noexcept
+    {
+        m_affinity = a;
+        return *this;
+    }
+
 private:
     int m_maxthreads       = 0;  // Max threads (0 = use all)
     ParStrategy m_strategy = ParStrategy::Default;
@@ -172,6 +190,7 @@ private:
     size_t m_minitems      = 16384;        // Min items per task
     thread_pool* m_pool    = nullptr;      // If non-NULL, custom thread pool
     bool m_recursive       = false;        // Allow thread pool recursion
+    bool m_affinity        = false;        // Aim chunks at specific workers
 };
 
 
@@ -297,6 +316,152 @@ parallel_for_2D(int64_t xbegin, int64_t xend, int64_t ybegin, int64_t yend,
 
 
 
+/// Parallel sort of the range [first, last), equivalent to
+/// `std::sort(first, last, comp)`: the range is carved into contiguous
+/// chunks that are sorted concurrently, then stitched together by rounds
+/// of pairwise merges (the merges within a round are independent and also
+/// run in parallel). Respects the usual paropt rules -- in particular, a
+/// caller that is itself a thread pool worker will just sort serially
+/// rather than oversubscribe the pool -- and falls back to a plain
+/// `std::sort` for ranges too small to be worth the task overhead.
+template<class RandomIt, class Compare = std::less<>>
+void
+parallel_sort(RandomIt first, RandomIt last, Compare comp = Compare(),
+              paropt opt = 0)
+{
+    int64_t n = last - first;
+    opt.resolve();
+    // Carve into roughly two chunks per thread (for load balancing), but
+    // no smaller than minitems.
+    int64_t chunksize = std::max(int64_t(opt.minitems()),
+                                 (n + 2 * opt.maxthreads() - 1)
+                                     / (2 * opt.maxthreads()));
+    if (opt.singlethread() || n <= chunksize) {
+        std::sort(first, last, comp);
+        return;
+    }
+    parallel_for_chunked(
+        0, n, chunksize,
+        [&](int64_t b, int64_t e) { std::sort(first + b, first + e, comp); },
+        opt);
+    // Merge adjacent pairs of sorted chunks, doubling the merged width
+    // each round, until the whole range is one sorted run.
+    for (int64_t width = chunksize; width < n; width *= 2) {
+        parallel_for_chunked(
+            0, n, 2 * width,
+            [&](int64_t b, int64_t e) {
+                int64_t mid = b + width;
+                if (mid < e)
+                    std::inplace_merge(first + b, first + mid, first + e,
+                                       comp);
+            },
+            opt);
+    }
+}
+
+
+
+/// Parallel reduction over the range [begin, end): partition it into
+/// chunks, concurrently have `func(b, e)` reduce each chunk to a single
+/// value of type T, then fold the per-chunk partials together with
+/// `combine`, which must be associative. `identity` is the value of an
+/// empty range (e.g. 0 for a sum, -infinity for a max). The partials are
+/// combined in range order, so results are reproducible from run to run
+/// even when `combine` is not commutative (though floating point sums may
+/// still differ from a serial reduction by rounding, since the grouping
+/// depends on the chunk count).
+template<class T, class Func, class Combine>
+T
+parallel_reduce(int64_t begin, int64_t end, const T& identity, Func&& func,
+                Combine&& combine, paropt opt = 0)
+{
+    int64_t n = end - begin;
+    if (n <= 0)
+        return identity;
+    opt.resolve();
+    int64_t chunksize = std::max(int64_t(opt.minitems()),
+                                 (n + 2 * opt.maxthreads() - 1)
+                                     / (2 * opt.maxthreads()));
+    if (opt.singlethread() || n <= chunksize)
+        return combine(identity, func(begin, end));
+    int64_t nchunks = (n + chunksize - 1) / chunksize;
+    std::vector<T> partials(size_t(nchunks), identity);
+    parallel_for_chunked(
+        begin, end, chunksize,
+        [&](int64_t b, int64_t e) {
+            partials[(b - begin) / chunksize] = func(b, e);
+        },
+        opt);
+    T result = identity;
+    for (const T& p : partials)
+        result = combine(result, p);
+    return result;
+}
+
+
+
+/// Parallel inclusive prefix scan ("running total"): for every i in
+/// [0, last-first), set `dest[i] = first[0] op first[1] op ... op
+/// first[i]`, where `op` must be associative (e.g. addition, for a
+/// prefix sum). `first` and `dest` may point to the same range for an
+/// in-place scan, but must not partially overlap. Returns the reduction
+/// of the entire range. Implemented as the usual three phases: concurrent
+/// chunk-local scans, a serial scan over the (few) chunk totals, then a
+/// concurrent pass applying each chunk's starting offset.
+template<class RandomIt, class OutIt, class T, class BinOp = std::plus<T>>
+T
+parallel_scan(RandomIt first, RandomIt last, OutIt dest, T identity,
+              BinOp op = BinOp(), paropt opt = 0)
+{
+    int64_t n = last - first;
+    if (n <= 0)
+        return identity;
+    opt.resolve();
+    int64_t chunksize = std::max(int64_t(opt.minitems()),
+                                 (n + 2 * opt.maxthreads() - 1)
+                                     / (2 * opt.maxthreads()));
+    if (opt.singlethread() || n <= chunksize) {
+        T run = identity;
+        for (int64_t i = 0; i < n; ++i) {
+            run     = op(run, first[i]);
+            dest[i] = run;
+        }
+        return run;
+    }
+    int64_t nchunks = (n + chunksize - 1) / chunksize;
+    std::vector<T> chunktotal(size_t(nchunks), identity);
+    parallel_for_chunked(
+        0, n, chunksize,
+        [&](int64_t b, int64_t e) {
+            T run = identity;
+            for (int64_t i = b; i < e; ++i) {
+                run     = op(run, first[i]);
+                dest[i] = run;
+            }
+            chunktotal[b / chunksize] = run;
+        },
+        opt);
+    // Exclusive scan of the chunk totals gives each chunk's start offset.
+    std::vector<T> offset(size_t(nchunks), identity);
+    T total = identity;
+    for (int64_t c = 0; c < nchunks; ++c) {
+        offset[c] = total;
+        total     = op(total, chunktotal[c]);
+    }
+    // Chunk 0 is already final; all later chunks add their offset.
+    parallel_for_chunked(
+        chunksize, n, chunksize,
+        [&](int64_t b, int64_t e) {
+            const T& off = offset[b / chunksize];
+            for (int64_t i = b; i < e; ++i)
+                dest[i] = op(off, dest[i]);
+        },
+        opt);
+    return total;
+}
+
+
+
 #if OIIO_VERSION < OIIO_MAKE_VERSION(3, 0, 0)
 
 // Deprecated versions of parallel loops where the task functions take a
@@ -12,11 +12,13 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 #include <OpenImageIO/attrdelegate.h>
 #include <OpenImageIO/export.h>
 #include <OpenImageIO/strongparam.h>
+#include <OpenImageIO/thread.h>
 #include <OpenImageIO/typedesc.h>
 #include <OpenImageIO/ustring.h>
 
@@ -310,7 +312,11 @@ private:
     ustring m_name;   ///< data name
     TypeDesc m_type;  ///< data type, which may itself be an array
     union {
-        char localval[16];
+        // Big enough that common metadata values -- including int/float
+        // vectors up to 8 elements (e.g. chromaticities), keycode,
+        // rational pairs, and GPS coordinate triples -- avoid a heap
+        // allocation apiece when ingesting attribute-heavy files.
+        char localval[32];
         const void* ptr;
     } m_data;  ///< Our data, either a pointer or small local value
     int m_nvalues          = 0;  ///< number of values of the given type
@@ -358,6 +364,21 @@ class OIIO_UTIL_API ParamValueList : public std::vector<ParamValue> {
 public:
     ParamValueList() {}
 
+    // Copies transfer the entries but not the lazily built name index (the
+    // copy will rebuild its own if and when it needs one).
+    ParamValueList(const ParamValueList& other)
+        : std::vector<ParamValue>(other)
+    {
+    }
+    ParamValueList(ParamValueList&& other) = default;
+    ParamValueList& operator=(const ParamValueList& other)
+    {
+        std::vector<ParamValue>::operator=(other);
+        m_index_state = IndexNone;
+        return *this;
+    }
+    ParamValueList& operator=(ParamValueList&& other) = default;
+
     /// Add space for one more ParamValue to the list, and return a
     /// reference to its slot.
     reference grow()
@@ -564,6 +585,41 @@ public:
     {
         return { this, name };
     }
+
+private:
+    enum IndexState : char {
+        IndexNone = 0,  // no index built (or explicitly invalidated)
+        IndexUsable,    // index is built and may be consulted
+        IndexUnusable   // list can't be indexed (case-colliding duplicates)
+    };
+
+    // Lazy hash index over the (lowercased) entry names, built by find()
+    // once the list exceeds a size threshold so that lookups on the large
+    // metadata lists some files carry (hundreds of attributes) are O(1)
+    // rather than a linear scan. The data/size snapshot detects growth,
+    // shrinkage, or reallocation performed through inherited vector methods;
+    // operations that can reorder or rename entries without changing the
+    // size (such as sort()) invalidate the index explicitly. Mutating entry
+    // names in place through iterators or operator[] is not detected --
+    // but note that such shenanigans have never been safe against
+    // concurrent find() calls anyway. The spin lock keeps concurrent
+    // find() calls on a const list safe from each other.
+    mutable std::unordered_map<ustring, int> m_index;
+    mutable const ParamValue* m_index_data = nullptr;
+    mutable size_t m_index_size            = 0;
+    mutable IndexState m_index_state       = IndexNone;
+    mutable spin_mutex m_index_mutex;
+
+    // Rebuild m_index from scratch, marking it unusable if the list has
+    // duplicate (case-insensitive) names.
+    void build_index() const;
+
+    // Look up `name` via the hash index, building or rebuilding the index
+    // first if necessary. Return 1 + the position of the matching entry,
+    // 0 if the index proves no entry matches, or -1 if the index can't be
+    // used and the caller must fall back on a linear scan.
+    int index_lookup(string_view name, TypeDesc type,
+                     bool casesensitive) const;
 };
 
 
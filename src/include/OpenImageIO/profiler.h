@@ -0,0 +1,121 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+
+/// @file profiler.h
+/// @brief Lightweight hierarchical scoped profiler.
+
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include <OpenImageIO/export.h>
+#include <OpenImageIO/oiioversion.h>
+#include <OpenImageIO/timer.h>
+#include <OpenImageIO/ustring.h>
+
+
+OIIO_NAMESPACE_BEGIN
+
+/// The Profiler namespace holds the global controls for the scoped zone
+/// profiler. Zones are declared with the RAII class ProfilerZone (below);
+/// each thread records its completed zones into a private buffer, so a zone
+/// costs just two timestamp reads plus a vector append (a few tens of ns)
+/// and nothing at all when profiling is disabled. The per-thread buffers
+/// are merged on demand -- by report() into a parent/child time tree, or by
+/// chrome_trace() into a raw timeline -- using the begin/end nesting of the
+/// zones, so zones on different threads with the same call path are
+/// aggregated together.
+///
+/// The same controls are reachable without including this header through
+/// the global OIIO attributes: `attribute("profiler:enable", 1)` and
+/// `getattribute("profiler:report", ...)` /
+/// `getattribute("profiler:trace", ...)`.
+namespace Profiler {
+
+/// Turn zone recording on or off, globally. Zones entered while profiling
+/// is disabled are never recorded, even if it is re-enabled before they
+/// close.
+OIIO_UTIL_API void enable(bool on);
+
+/// Is zone recording currently enabled?
+OIIO_UTIL_API bool enabled();
+
+/// Discard all zones recorded so far, on all threads.
+OIIO_UTIL_API void clear();
+
+/// Merge the per-thread buffers into a parent/child tree (keyed by the
+/// zone call path, aggregated across threads) and return it as a
+/// human-readable indented report: per node, the call count, total time,
+/// and time not accounted for by its children.
+OIIO_UTIL_API std::string report();
+
+/// Return all recorded zones as Chrome trace-event format JSON, suitable
+/// for loading into chrome://tracing or Perfetto. Times are microseconds;
+/// each recording thread appears as its own timeline row.
+OIIO_UTIL_API std::string chrome_trace();
+
+/// Arrange for the Chrome trace JSON of all recorded zones to be written
+/// to the named file when the process exits, and enable the profiler.
+/// Passing the empty string cancels the dump. The same thing can be
+/// triggered without any code change by setting the environment variable
+/// `OPENIMAGEIO_TRACE_FILE` to the desired path, or at runtime with
+/// `OIIO::attribute("profiler:tracefile", path)`.
+OIIO_UTIL_API void set_trace_file(string_view path);
+
+namespace pvt {
+extern OIIO_UTIL_API std::atomic<int> profiler_enabled;
+}
+
+}  // namespace Profiler
+
+
+/// ProfilerZone is a scoped RAII profiling zone: it records the interval
+/// from its construction to its destruction, attributed to the given name,
+/// nested within whatever zone is currently open on the same thread.
+/// Typical usage is one zone at the top of a function:
+///
+///     void expensive_thing() {
+///         ProfilerZone zone("expensive_thing");
+///         ...
+///     }
+///
+/// Zone names are ustrings; prefer a persistent or static name over
+/// building a new string per call. When profiling is disabled (the
+/// default), constructing a zone is a single relaxed atomic load.
+class ProfilerZone {
+public:
+    ProfilerZone(ustring name)
+    {
+        if (Profiler::pvt::profiler_enabled.load(std::memory_order_relaxed))
+            open(name);
+    }
+    /// Convenience: construct from a string_view name. The ustring
+    /// conversion is only paid when profiling is actually enabled.
+    ProfilerZone(string_view name)
+    {
+        if (Profiler::pvt::profiler_enabled.load(std::memory_order_relaxed))
+            open(ustring(name));
+    }
+    ~ProfilerZone()
+    {
+        if (m_start)
+            close();
+    }
+
+    ProfilerZone(const ProfilerZone&) = delete;
+    ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+private:
+    OIIO_UTIL_API void open(ustring name);
+    OIIO_UTIL_API void close();
+
+    ustring m_name;
+    Timer::ticks_t m_start = 0;
+};
+
+
+OIIO_NAMESPACE_END
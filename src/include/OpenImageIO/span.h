@@ -186,11 +186,13 @@ public:
     constexpr pointer data() const noexcept { return m_data; }
 
     constexpr reference operator[] (size_type idx) const {
-        OIIO_DASSERT(idx < m_size && "OIIO::span::operator[] range check");
+        OIIO_HOTPATH_DASSERT(idx < m_size
+                             && "OIIO::span::operator[] range check");
         return m_data[idx];
     }
     constexpr reference operator() (size_type idx) const {
-        OIIO_DASSERT(idx < m_size && "OIIO::span::operator() range check");
+        OIIO_HOTPATH_DASSERT(idx < m_size
+                             && "OIIO::span::operator() range check");
         return m_data[idx];
     }
     reference at (size_type idx) const {
@@ -1029,6 +1029,20 @@ parse_values(string_view& str, string_view prefix, span<float> values,
              string_view sep = "", string_view postfix = "",
              bool eat = true) noexcept;
 
+/// Parse from `str` up to `values.size()` whitespace-separated float
+/// values (with an optional additional `sep` separator string between
+/// values), placing them in the elements of `values` in order. Return the
+/// number of values successfully parsed, stopping early at the first
+/// element that doesn't parse as a float (unlike `parse_values`, a short
+/// run is not a failure). If `eat` is true, `str` will be trimmed of
+/// everything through the last value (and separator) consumed. This is the
+/// preferred entry point for bulk ingestion of long numeric runs (point
+/// clouds, calibration tables): it makes a single locale-free pass over
+/// the characters with no per-value temporary copies.
+size_t OIIO_UTIL_API
+parse_floats(string_view& str, span<float> values, string_view sep = "",
+             bool eat = true) noexcept;
+
 /// Similar to parse_values, but with no option to "eat" from
 /// or modify the source string.
 inline bool
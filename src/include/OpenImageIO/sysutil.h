@@ -105,6 +105,17 @@ OIIO_API unsigned int
 physical_concurrency();
 #endif
 
+/// Number of NUMA memory nodes on this system. Returns 1 on single-node
+/// systems and on platforms where the node count cannot be discovered.
+OIIO_API unsigned int
+numa_node_count();
+
+/// Restrict the calling thread to run only on the CPUs belonging to the
+/// given NUMA node. Return true on success, false upon failure or on
+/// platforms where thread placement is unsupported.
+OIIO_API bool
+pin_this_thread_to_numa_node(unsigned int node);
+
 /// Get the maximum number of open file handles allowed on this system.
 OIIO_API size_t
 max_open_files();
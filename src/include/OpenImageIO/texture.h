@@ -25,7 +25,14 @@
 // Is the getattributetype() method present? (Added in 2.5)
 #define OIIO_TEXTURESYSTEM_SUPPORTS_GETATTRIBUTETYPE 1
 
+// Are attribute transactions and batched getattributes() present?
+// (Added in 2.6)
+#define OIIO_TEXTURESYSTEM_SUPPORTS_ATTRIBUTE_TRANSACTIONS 1
+
 #define OIIO_TEXTURESYSTEM_SUPPORTS_STOCHASTIC 1
+
+// Is the multi-request texture_multi() call present? (Added in 2.6)
+#define OIIO_TEXTURESYSTEM_SUPPORTS_MULTI_REQUEST 1
 #define OIIO_TEXTURESYSTEM_SUPPORTS_DECODE_BY_USTRINGHASH 1
 
 #ifndef INCLUDED_IMATHVEC_H
@@ -111,8 +118,8 @@ enum class MipMode {
     OneLevel,   ///< Use just one mipmap level
     Trilinear,  ///< Use two MIPmap levels (trilinear)
     Aniso,      ///< Use two MIPmap levels w/ anisotropic
-    StochasticTrilinear, ///< DEPRECATED Stochastic trilinear
-    StochasticAniso, ///< DEPRECATED Stochastic anisotropic
+    StochasticTrilinear, ///< One stochastically chosen MIP level
+    StochasticAniso, ///< One stochastically chosen anisotropic probe
 };
 
 /// Interp mode determines how we sample within a mipmap level
@@ -137,6 +144,11 @@ enum class InterpMode {
 OIIO_INLINE_CONSTEXPR int BatchWidth = OIIO_TEXTURE_SIMD_BATCH_WIDTH;
 OIIO_INLINE_CONSTEXPR int BatchAlign = BatchWidth * sizeof(float);
 
+/// Width of the double-wide batched lookups, for shaders that execute
+/// `2*BatchWidth` lanes at a time (e.g. 32-wide programs on AVX-512 when
+/// the library is built with the default 16-wide batch).
+OIIO_INLINE_CONSTEXPR int BatchWidthWide = 2 * BatchWidth;
+
 /// A type alias for a SIMD vector of floats with the batch width.
 typedef simd::VecType<float, OIIO_TEXTURE_SIMD_BATCH_WIDTH>::type FloatWide;
 
@@ -210,8 +222,8 @@ public:
         MipModeOneLevel,   ///< Use just one mipmap level
         MipModeTrilinear,  ///< Use two MIPmap levels (trilinear)
         MipModeAniso,      ///< Use two MIPmap levels w/ anisotropic
-        MipModeStochasticTrilinear, ///< DEPRECATED Stochastic trilinear
-        MipModeStochasticAniso, ///< DEPRECATED Stochastic anisotropic
+        MipModeStochasticTrilinear, ///< One stochastically chosen MIP level
+        MipModeStochasticAniso, ///< One stochastically chosen aniso probe
     };
 
     /// Interp mode determines how we sample within a mipmap level
@@ -627,10 +639,23 @@ public:
     ///             If nonzero, `t` coordinates will be flipped `1-t` for
     ///             all texture lookups. The default is 0.
     /// - `int stochastic` :
-    ///             Bit field determining how to use stochastic sampling for
-    ///             MipModeStochasticAniso and/or MipModeStochasticTrilinear.
-    ///             Bit 1 = sample MIP level, bit 2 = sample anisotropy
-    ///             (default=0).
+    ///             Bit field that forces stochastic single-tap sampling for
+    ///             ordinary mip modes (for lookups supplying a `rnd` value
+    ///             in their TextureOpt). Bit 1 = sample one MIP level, bit
+    ///             2 = sample one anisotropic probe (default=0). Individual
+    ///             lookups may request the same treatment per lookup,
+    ///             without setting this attribute, by using
+    ///             MipModeStochasticTrilinear or MipModeStochasticAniso.
+    /// - `string trace:filename` :
+    ///             If set to a non-empty file name, every 2D texture lookup
+    ///             will be logged (file, s, t, derivatives, thread) to that
+    ///             file in a compact binary form, until the attribute is
+    ///             set to the empty string or the TextureSystem is
+    ///             destroyed. Such a trace of a real render can be replayed
+    ///             with `testtex --replay` to benchmark cache behavior
+    ///             against a production access pattern. Tracing adds
+    ///             per-lookup overhead, so leave this unset (the default)
+    ///             except when capturing.
     ///
     /// - `string options`
     ///             This catch-all is simply a comma-separated list of
@@ -697,6 +722,26 @@ public:
     /// Specialized `attribute()` for setting a single string value.
     virtual bool attribute (string_view name, string_view val) = 0;
 
+    /// Begin an "attribute transaction": until the matching
+    /// `commit_attribute_transaction()`, any `attribute()` calls record
+    /// their new values immediately but defer the cache invalidation or
+    /// other rebuild of derived state that the change would ordinarily
+    /// trigger. The commit then performs at most one invalidation pass, no
+    /// matter how many of the batched changes requested one. Transactions
+    /// may nest; only the outermost commit applies the deferred work. Like
+    /// `attribute()` itself, transactions must not be issued concurrently
+    /// from multiple threads.
+    ///
+    /// This was added in version 2.6.
+    virtual void begin_attribute_transaction() = 0;
+
+    /// End an attribute transaction started by
+    /// `begin_attribute_transaction()`, applying (once) any invalidation
+    /// that was deferred by the `attribute()` calls made in between.
+    ///
+    /// This was added in version 2.6.
+    virtual void commit_attribute_transaction() = 0;
+
     /// Get the named attribute of the texture system, store it in `*val`.
     /// All of the attributes that may be set with the `attribute() call`
     /// may also be queried with `getattribute()`.
@@ -752,6 +797,16 @@ public:
     /// This was added in version 2.5.
     virtual TypeDesc getattributetype (string_view name) const = 0;
 
+    /// Retrieve a batch of attributes with a single call: for each entry
+    /// of `names`, look up the attribute's type and current value and
+    /// append it to `vals`. Names that are not recognized (or whose type
+    /// cannot be determined via `getattributetype()`) are skipped. Returns
+    /// the number of attributes retrieved.
+    ///
+    /// This was added in version 2.6.
+    virtual int getattributes(cspan<string_view> names,
+                              ParamValueList& vals) const = 0;
+
     /// @}
 
     /// @{
@@ -948,6 +1003,35 @@ public:
                           int nchannels, float *result,
                           float *dresultds=nullptr, float *dresultdt=nullptr) = 0;
 
+    /// One independent 2D texture lookup, for texture_multi(). The
+    /// requests need not share a texture or options, and each writes its
+    /// own `result` (and optional derivative) storage.
+    struct TextureRequest {
+        TextureHandle *texture_handle;  ///< Handle of the texture
+        TextureOpt *options;            ///< Options for this lookup
+        float s, t;                     ///< Texture coordinates
+        float dsdx, dtdx;               ///< s,t differentials wrt x
+        float dsdy, dtdy;               ///< s,t differentials wrt y
+        float *result;                  ///< nchannels of result storage
+        float *dresultds = nullptr;     ///< deriv storage, or nullptr
+        float *dresultdt = nullptr;
+    };
+
+    /// Perform many independent filtered 2D texture lookups with a single
+    /// virtual call. Each request is evaluated exactly as the
+    /// handle-based scalar texture() would evaluate it, but the
+    /// implementation is free to reorder the evaluations -- in particular,
+    /// to group requests that touch the same texture tiles -- which
+    /// substantially improves cache behavior for large sets of incoherent
+    /// lookups (e.g. secondary rays) that cannot fill a SIMD batch.
+    /// All lookups use `nchannels` channels. Returns `true` only if every
+    /// lookup succeeded.
+    ///
+    /// This was added in version 2.6.
+    virtual bool texture_multi (cspan<TextureRequest> requests,
+                                Perthread *thread_info,
+                                int nchannels) = 0;
+
 
     /// Perform a filtered 3D volumetric texture lookup on a position
     /// centered at 3D position `P` (with given differentials) from the
@@ -1132,6 +1216,24 @@ public:
                               V3fParam dRdy, int nchannels, float *result,
                               float *dresultds=nullptr, float *dresultdt=nullptr) = 0;
 
+    /// Importance-sample a lat-long environment map, using the
+    /// marginal/conditional CDF tables that maketx bakes into the file's
+    /// metadata when given the "maketx:envcdf" configuration hint.  Given
+    /// two uniform random numbers `rnd[0]`, `rnd[1]` in [0,1), store in
+    /// `uv[0]`, `uv[1]` the sampled (s,t) position (distributed
+    /// proportionally to sin-theta-weighted luminance) and in `*pdf` the
+    /// probability density of that choice with respect to uniform (s,t)
+    /// area.  Return false, leaving the outputs untouched, if the file
+    /// does not exist or carries no baked CDF tables.
+    virtual bool environment_sample (ustring filename, Perthread *thread_info,
+                                     const float *rnd, float *uv,
+                                     float *pdf) = 0;
+    /// Slightly faster version of environment_sample() if the app already
+    /// has a texture handle and per-thread info.
+    virtual bool environment_sample (TextureHandle *texture_handle,
+                                     Perthread *thread_info, const float *rnd,
+                                     float *uv, float *pdf) = 0;
+
     /// @}
 
     /// @{
@@ -1202,6 +1304,36 @@ public:
                           float *dresultds=nullptr,
                           float *dresultdt=nullptr) = 0;
 
+    /// Double-wide batched 2D texture lookup, for callers whose shading
+    /// batches are `Tex::BatchWidthWide` (i.e., `2*BatchWidth`) lanes, such
+    /// as 32-wide programs on AVX-512 hardware.  It behaves like the
+    /// batched texture() above, except that `options` points to two
+    /// TextureOptBatch records (for lanes `[0,BatchWidth)` and
+    /// `[BatchWidth, 2*BatchWidth)` respectively), `mask` may have up to
+    /// `2*BatchWidth` bits set, the coordinate and derivative arrays are
+    /// each `float[2*BatchWidth]`, and the SOA results are laid out as
+    /// `float [nchannels][2*BatchWidth]`.  This services a full wide batch
+    /// with a single call -- one handle and per-thread resolution, and
+    /// results stored directly at the wide stride -- rather than requiring
+    /// the caller to split, dispatch twice, and re-interleave.
+    virtual bool texture (ustring filename, TextureOptBatch *options,
+                          Tex::RunMask mask, const float *s, const float *t,
+                          const float *dsdx, const float *dtdx,
+                          const float *dsdy, const float *dtdy,
+                          int nchannels, float *result,
+                          float *dresultds=nullptr,
+                          float *dresultdt=nullptr) = 0;
+    /// Slightly faster version of the double-wide texture() lookup if the
+    /// app already has a texture handle and per-thread info.
+    virtual bool texture (TextureHandle *texture_handle,
+                          Perthread *thread_info, TextureOptBatch *options,
+                          Tex::RunMask mask, const float *s, const float *t,
+                          const float *dsdx, const float *dtdx,
+                          const float *dsdy, const float *dtdy,
+                          int nchannels, float *result,
+                          float *dresultds=nullptr,
+                          float *dresultdt=nullptr) = 0;
+
 #ifndef OIIO_DOXYGEN
     // Old multi-point API call.
     // DEPRECATED (1.8)
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <vector>
 
@@ -29,6 +30,7 @@
 #include <OpenImageIO/export.h>
 #include <OpenImageIO/oiioversion.h>
 #include <OpenImageIO/platform.h>
+#include <OpenImageIO/span.h>
 
 
 
@@ -272,6 +274,86 @@ private:
 typedef spin_mutex::lock_guard spin_lock;
 
 
+namespace pvt {
+// Number of optimistic try_lock attempts an adaptive mutex makes before
+// parking the thread in the kernel. Settable at runtime via the global
+// attribute "threads:adaptive_spin_count".
+extern OIIO_UTIL_API std::atomic<int> adaptive_mutex_spins;
+}  // namespace pvt
+
+
+/// An adaptive mutex: briefly spins like spin_mutex, on the theory that
+/// the lock holder is running and will release momentarily, but after a
+/// bounded number of attempts parks the thread in the kernel (on Linux, a
+/// futex wait inside std::mutex) instead of burning CPU that the holder
+/// (or some other process) may need. Uncontended cost is a single CAS,
+/// like spin_mutex; the difference only shows under heavy contention or
+/// on oversubscribed machines, where pure spin locks collapse into convoy
+/// behavior. The spin budget is global and runtime-settable via
+/// OIIO::attribute("threads:adaptive_spin_count") -- 0 parks immediately
+/// (pure blocking lock), a huge value approximates a pure spin lock.
+class adaptive_mutex {
+public:
+    adaptive_mutex(void) {}
+    ~adaptive_mutex(void) {}
+
+    /// Copy constructor -- initialize to unlocked.
+    ///
+    adaptive_mutex(const adaptive_mutex&) {}
+
+    /// Assignment does not do anything, since lockedness should not
+    /// transfer.
+    const adaptive_mutex& operator=(const adaptive_mutex&) { return *this; }
+
+    /// Acquire the lock: spin briefly, then park.
+    ///
+    void lock()
+    {
+        atomic_backoff backoff;
+        for (int i = 0,
+                 spins = pvt::adaptive_mutex_spins.load(
+                     std::memory_order_relaxed);
+             i < spins; ++i) {
+            if (OIIO_LIKELY(try_lock()))
+                return;
+            backoff();
+        }
+        m_mutex.lock();
+    }
+
+    /// Release the lock that we hold.
+    ///
+    void unlock() { m_mutex.unlock(); }
+
+    /// Try to acquire the lock.  Return true if we have it, false if
+    /// somebody else is holding the lock.
+    bool try_lock() { return m_mutex.try_lock(); }
+
+    /// Helper class: scoped lock for an adaptive_mutex -- grabs the lock
+    /// upon construction, releases the lock when it exits scope.
+    class lock_guard {
+    public:
+        lock_guard(adaptive_mutex& fm)
+            : m_fm(fm)
+        {
+            m_fm.lock();
+        }
+        ~lock_guard() { m_fm.unlock(); }
+
+    private:
+        lock_guard() = delete;
+        lock_guard(const lock_guard& other) = delete;
+        lock_guard& operator=(const lock_guard& other) = delete;
+        adaptive_mutex& m_fm;
+    };
+
+private:
+    std::mutex m_mutex;
+};
+
+typedef adaptive_mutex::lock_guard adaptive_lock;
+
+
 
 #if 0
 
@@ -517,6 +599,126 @@ typedef spin_rw_mutex::read_lock_guard spin_rw_read_lock;
 typedef spin_rw_mutex::write_lock_guard spin_rw_write_lock;
 
 
+/// Reader/writer flavor of adaptive_mutex: spin briefly on the cheap
+/// try-lock, then park in the kernel (std::shared_mutex) rather than
+/// spinning indefinitely. Same interface as spin_rw_mutex, so it can be
+/// substituted anywhere one is used (including as the BINMUTEX of an
+/// unordered_map_concurrent). The spin budget is the shared
+/// "threads:adaptive_spin_count" attribute.
+class adaptive_rw_mutex {
+public:
+    adaptive_rw_mutex(void) {}
+    ~adaptive_rw_mutex(void) {}
+
+    /// Copy constructor -- initialize to unlocked.
+    ///
+    adaptive_rw_mutex(const adaptive_rw_mutex&) {}
+
+    /// Assignment does not do anything, since lockedness should not
+    /// transfer.
+    const adaptive_rw_mutex& operator=(const adaptive_rw_mutex&)
+    {
+        return *this;
+    }
+
+    /// Acquire the reader lock.
+    ///
+    void read_lock()
+    {
+        atomic_backoff backoff;
+        for (int i = 0,
+                 spins = pvt::adaptive_mutex_spins.load(
+                     std::memory_order_relaxed);
+             i < spins; ++i) {
+            if (OIIO_LIKELY(m_mutex.try_lock_shared()))
+                return;
+            backoff();
+        }
+        m_mutex.lock_shared();
+    }
+
+    /// Release the reader lock.
+    ///
+    void read_unlock() { m_mutex.unlock_shared(); }
+
+    /// Acquire the writer lock.
+    ///
+    void write_lock()
+    {
+        atomic_backoff backoff;
+        for (int i = 0,
+                 spins = pvt::adaptive_mutex_spins.load(
+                     std::memory_order_relaxed);
+             i < spins; ++i) {
+            if (OIIO_LIKELY(m_mutex.try_lock()))
+                return;
+            backoff();
+        }
+        m_mutex.lock();
+    }
+
+    /// Release the writer lock.
+    ///
+    void write_unlock() { m_mutex.unlock(); }
+
+    /// Acquire an exclusive ("writer") lock.
+    void lock() { write_lock(); }
+
+    /// Release an exclusive ("writer") lock.
+    void unlock() { write_unlock(); }
+
+    /// Acquire a shared ("reader") lock.
+    void lock_shared() { read_lock(); }
+
+    /// Release a shared ("reader") lock.
+    void unlock_shared() { read_unlock(); }
+
+    /// Helper class: scoped read lock for an adaptive_rw_mutex -- grabs
+    /// the read lock upon construction, releases the lock when it exits
+    /// scope.
+    class read_lock_guard {
+    public:
+        read_lock_guard(adaptive_rw_mutex& fm)
+            : m_fm(fm)
+        {
+            m_fm.read_lock();
+        }
+        ~read_lock_guard() { m_fm.read_unlock(); }
+
+    private:
+        read_lock_guard() = delete;
+        read_lock_guard(const read_lock_guard& other) = delete;
+        read_lock_guard& operator=(const read_lock_guard& other) = delete;
+        adaptive_rw_mutex& m_fm;
+    };
+
+    /// Helper class: scoped write lock for an adaptive_rw_mutex -- grabs
+    /// the write lock upon construction, releases the lock when it exits
+    /// scope.
+    class write_lock_guard {
+    public:
+        write_lock_guard(adaptive_rw_mutex& fm)
+            : m_fm(fm)
+        {
+            m_fm.write_lock();
+        }
+        ~write_lock_guard() { m_fm.write_unlock(); }
+
+    private:
+        write_lock_guard() = delete;
+        write_lock_guard(const write_lock_guard& other) = delete;
+        write_lock_guard& operator=(const write_lock_guard& other) = delete;
+        adaptive_rw_mutex& m_fm;
+    };
+
+private:
+    std::shared_mutex m_mutex;
+};
+
+typedef adaptive_rw_mutex::read_lock_guard adaptive_rw_read_lock;
+typedef adaptive_rw_mutex::write_lock_guard adaptive_rw_write_lock;
+
+
 
 /// Mutex pool. Sometimes, we have lots of objects that need to be
 /// individually locked for thread safety, but two separate objects don't
@@ -713,6 +915,29 @@ public:
         return pck->get_future();
     }
 
+    /// Like the multi-argument push(), but hint that the task would
+    /// preferably run on pool worker `worker` (0 <= worker < size()). This
+    /// is strictly advisory -- a task pushed this way may still be taken by
+    /// another worker if the preferred one is busy -- but submitting the
+    /// same work unit to the same worker across repeated passes gives
+    /// first-touch memory locality on NUMA systems. An out-of-range worker
+    /// is equivalent to an ordinary push().
+    template<typename F, typename... Rest>
+    auto push_to (int worker, F && f, Rest&&... rest) ->std::future<decltype(f(0, rest...))> {
+        auto pck = std::make_shared<std::packaged_task<decltype(f(0, rest...))(int)>>(
+            std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Rest>(rest)...)
+        );
+        if (size() < 1) {
+            (*pck)(-1); // No worker threads, run it with the calling thread
+        } else {
+            auto _f = new std::function<void(int id)>([pck](int id) {
+                (*pck)(id);
+            });
+            push_queue_and_notify (_f, worker);
+        }
+        return pck->get_future();
+    }
+
     /// If there are any tasks on the queue, pull one off and run it (on
     /// this calling thread) and return true. Otherwise (there are no
     /// pending jobs), return false immediately. This utility is what makes
@@ -765,6 +990,8 @@ private:
 
     // Utility function that helps us hide the implementation
     void push_queue_and_notify(std::function<void(int id)>* f);
+    // As above, but aim the task at a particular worker's inbox.
+    void push_queue_and_notify(std::function<void(int id)>* f, int worker);
 };
 
 
@@ -859,4 +1086,57 @@ private:
 };
 
 
+
+/// TaskGraph is a lightweight DAG executor layered on a thread_pool: a
+/// set of tasks (plain `std::function<void()>`s) connected by dependency
+/// edges. Tasks are submitted incrementally and each becomes eligible to
+/// run -- on the pool, or inline if the pool has no workers -- the moment
+/// the last of its dependencies completes, so the independent branches of
+/// a pipeline overlap automatically instead of every subsystem
+/// hand-rolling its own stage synchronization. A typical idiom:
+///
+///     TaskGraph graph;   // submits to the default thread pool
+///     auto a = graph.submit([&]{ compute(); });
+///     auto b = graph.submit([&]{ write(); }, { a });  // b runs after a
+///     graph.wait();      // or just let graph fall out of scope
+///
+/// Dependencies must name tasks previously submitted to the same graph,
+/// which makes cycles impossible by construction. submit() should be
+/// called from one thread at a time, but may safely overlap with tasks
+/// completing on pool workers. Task functions must not throw. Completion
+/// bookkeeping is a few counter updates under the graph's lock; no memory
+/// is allocated per edge while the graph is running.
+class OIIO_UTIL_API TaskGraph {
+public:
+    /// Each submitted task is identified by an id unique within its graph.
+    using TaskId = int64_t;
+
+    /// Create a task graph that submits its work to the given pool, or to
+    /// the default thread pool if none is specified.
+    TaskGraph(thread_pool* pool = nullptr);
+
+    /// Destroying the graph waits for all submitted tasks to complete.
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&)                  = delete;
+    const TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /// Add a task that may not start until all of `dependencies` (ids of
+    /// tasks previously submitted to this graph) have completed. A task
+    /// with no dependencies (the default) is eligible to run immediately.
+    /// Returns the new task's id.
+    TaskId submit(std::function<void()> func, cspan<TaskId> dependencies = {});
+
+    /// Wait until every task submitted so far has completed. Like
+    /// task_set, a waiting thread that is not itself a pool worker lends a
+    /// hand running queued pool tasks rather than just blocking.
+    void wait();
+
+private:
+    // PIMPL pattern hides all the guts far away from the public API
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+
 OIIO_NAMESPACE_END
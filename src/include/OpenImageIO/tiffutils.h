@@ -159,9 +159,24 @@ tiff_dir_data (const TIFFDirEntry &td, cspan<uint8_t> data);
 /// ImageSpec.  Return true if all is ok, false if the exif block was
 /// somehow malformed.  The binary data pointed to by 'exif' should
 /// start with a TIFF directory header.
+///
+/// If the global OIIO attribute "exif:lazy" is nonzero, the IFDs are not
+/// walked at all; instead the raw block is stashed in the spec as the
+/// "oiio:RawExif" attribute, to be decoded later by materialize_exif()
+/// if the metadata is ever actually wanted.  This makes opening
+/// metadata-heavy camera files (giant MakerNotes) much cheaper for
+/// applications that rarely look at it.
 OIIO_API bool decode_exif (cspan<uint8_t> exif, ImageSpec &spec);
 OIIO_API bool decode_exif (string_view exif, ImageSpec &spec);
 
+/// If the spec carries a raw Exif block stashed by a lazy decode_exif
+/// (see above), decode it now, replacing the "oiio:RawExif" stash with
+/// the individual metadata attributes.  Return true if a stashed block
+/// was present and decoded, false if there was nothing to materialize.
+///
+/// This was added in version 2.6.
+OIIO_API bool materialize_exif (ImageSpec &spec);
+
 OIIO_DEPRECATED("use version that takes a cspan<> (1.8)")
 OIIO_API bool decode_exif (const void *exif, int length, ImageSpec &spec); // DEPRECATED (1.8)
 
@@ -202,8 +217,32 @@ OIIO_API void encode_iptc_iim (const ImageSpec &spec, std::vector<char> &iptc);
 /// utility function to make it easy for multiple format plugins to
 /// support embedding XMP metadata without having to duplicate
 /// functionality within each plugin.
+///
+/// If the global OIIO attribute "xmp:lazy" is nonzero, the packet is not
+/// parsed at all; instead it is stashed verbatim in the spec as the
+/// "oiio:RawXMP" attribute, to be decoded later by materialize_xmp() --
+/// or probed for individual properties with extract_xmp_property() --
+/// if the metadata is ever actually wanted.
 OIIO_API bool decode_xmp (cspan<uint8_t> xml, ImageSpec &spec);
 OIIO_API bool decode_xmp (string_view xml, ImageSpec &spec);
+
+/// If the spec carries a raw XMP packet stashed by a lazy decode_xmp
+/// (see above), decode it now, replacing the "oiio:RawXMP" stash with
+/// the individual metadata attributes.  Return true if a stashed packet
+/// was present and decoded, false if there was nothing to materialize.
+///
+/// This was added in version 2.6.
+OIIO_API bool materialize_xmp (ImageSpec &spec);
+
+/// Streaming probe of a raw XMP packet: return the value of the single
+/// named property (e.g. "xmp:Rating" or "dc:format"), handling both the
+/// attribute and element serialization forms, without building an XML
+/// DOM or converting any other properties.  Return the empty string if
+/// the property is not present.
+///
+/// This was added in version 2.6.
+OIIO_API std::string extract_xmp_property (string_view xml,
+                                           string_view property);
 // DEPRECATED(2.1):
 OIIO_API bool decode_xmp (const char* xml, ImageSpec &spec);
 OIIO_API bool decode_xmp (const std::string& xml, ImageSpec &spec);
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/hash.h>
 #include <OpenImageIO/thread.h>
@@ -14,6 +16,99 @@ OIIO_NAMESPACE_BEGIN
 
 namespace pvt {
 
+/// Minimal epoch-based reclamation (EBR) domain, used to defer freeing
+/// memory that lock-free readers may still be traversing. A reader claims
+/// a slot (once per thread, cached thereafter) and announces the epoch it
+/// is reading under with a plain store to its own cache line; a writer
+/// tags retired garbage with the epoch at retirement and frees it only
+/// once no announced reader epoch is that old. Slots belonging to exited
+/// threads are never reclaimed -- the domain is meant for long-lived maps
+/// -- and if all slots are taken, reader_slot() returns -1 and the caller
+/// should fall back to its locked read path, which is always correct.
+class ebr_domain {
+public:
+    static constexpr int max_readers = 256;
+    static constexpr uint64_t idle   = ~uint64_t(0);
+
+    ebr_domain() {}
+
+    /// Claim (or recall) this thread's reader slot, or -1 if none free.
+    int reader_slot()
+    {
+        static thread_local const ebr_domain* cached_domain = nullptr;
+        static thread_local int cached_slot                 = -1;
+        if (cached_domain == this && cached_slot >= 0
+            && m_slots[cached_slot].owner.load(std::memory_order_relaxed)
+                   == tls_id())
+            return cached_slot;
+        int slot = -1;
+        for (int i = 0; i < max_readers; ++i) {
+            const void* owner = m_slots[i].owner.load(
+                std::memory_order_relaxed);
+            if (owner == tls_id()) {
+                slot = i;  // claimed by us on a previous pass
+                break;
+            }
+            if (owner == nullptr) {
+                const void* expected = nullptr;
+                if (m_slots[i].owner.compare_exchange_strong(expected,
+                                                             tls_id())) {
+                    slot = i;
+                    break;
+                }
+            }
+        }
+        cached_domain = this;
+        cached_slot   = slot;
+        return slot;
+    }
+
+    /// Announce that this thread is reading under the current epoch.
+    void enter(int slot)
+    {
+        m_slots[slot].epoch.store(m_epoch.load(std::memory_order_seq_cst),
+                                  std::memory_order_seq_cst);
+    }
+
+    /// Announce that this thread is done reading.
+    void exit(int slot)
+    {
+        m_slots[slot].epoch.store(idle, std::memory_order_release);
+    }
+
+    /// Tag garbage retired right now, advancing the epoch.
+    uint64_t retire_epoch()
+    {
+        return m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    /// May garbage tagged with epoch e be freed yet?
+    bool can_free(uint64_t e) const
+    {
+        for (const auto& s : m_slots) {
+            uint64_t r = s.epoch.load(std::memory_order_seq_cst);
+            if (r != idle && r <= e)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    // Address of a thread_local byte, as a cheap unique id per thread.
+    static const void* tls_id()
+    {
+        static thread_local char id;
+        return &id;
+    }
+
+    struct Slot {
+        OIIO_CACHE_ALIGN std::atomic<uint64_t> epoch { idle };
+        std::atomic<const void*> owner { nullptr };
+    };
+    std::atomic<uint64_t> m_epoch { 1 };
+    Slot m_slots[max_readers];
+};
+
 // SFINAE test for whether class T has method `iterator find(key,hash)`.
 // As described here: https://www.bfilipek.com/2016/02/sfinae-followup.html
 // clang-format off
@@ -94,7 +189,8 @@ find_with_hash(Map& map, const Key& key, size_t /*hash*/)
 
 template<class KEY, class VALUE, class HASH = std::hash<KEY>,
          class PRED = std::equal_to<KEY>, size_t BINS = 16,
-         class BINMAP = std::unordered_map<KEY, VALUE, HASH, PRED>>
+         class BINMAP = std::unordered_map<KEY, VALUE, HASH, PRED>,
+         class BINMUTEX = spin_rw_mutex>
 class unordered_map_concurrent {
 public:
     typedef BINMAP BinMap_t;
@@ -115,7 +211,7 @@ public:
     class iterator {
     public:
         friend class unordered_map_concurrent<KEY, VALUE, HASH, PRED, BINS,
-                                              BINMAP>;
+                                              BINMAP, BINMUTEX>;
 
     public:
         /// Construct an unordered_map_concurrent iterator that points
@@ -361,6 +457,7 @@ public:
             if (result.second) {
                 // the insert was successful!
                 ++m_size;
+                note_mutation(bin);
             }
             iret.m_biniterator = result.first;
             inserted           = true;
@@ -378,6 +475,21 @@ public:
         size_t hash = m_hash(key);
         size_t b    = whichbin(hash);
         Bin& bin(m_bins[b]);
+        if (do_lock && m_lockfree_reads) {
+            // Lock-free fast path: probe the bin's immutable snapshot,
+            // which epoch-based reclamation keeps alive while we read it.
+            int slot = m_ebr.reader_slot();
+            if (slot >= 0) {
+                m_ebr.enter(slot);
+                Snapshot* snap = bin.snapshot.load(std::memory_order_acquire);
+                bool found = snap && snap->find(key, hash, m_pred, value);
+                m_ebr.exit(slot);
+                if (found)
+                    return true;
+                // Not in the snapshot: it may simply be newer than the
+                // snapshot, so fall through to the authoritative map.
+            }
+        }
         if (do_lock)
             bin.read_lock();
         auto it    = find_with_hash(bin.map, key, hash);
@@ -408,6 +520,7 @@ public:
         if (result.second) {
             // the insert was successful!
             ++m_size;
+            note_mutation(bin);
         } else {
             // Replace caller's value with the one already in the table.
             value = result.first->second;
@@ -438,6 +551,7 @@ public:
         if (result.second) {
             // the insert was successful!
             ++m_size;
+            note_mutation(bin);
         }
         if (do_lock)
             bin.unlock();
@@ -457,6 +571,7 @@ public:
             bin.lock();
         bin.map.erase(key);
         --m_size;
+        note_mutation(bin);
         if (do_lock)
             bin.unlock();
     }
@@ -474,6 +589,8 @@ public:
                 bin.map.swap(map);
                 m_size -= map.size();
             }
+            if (m_lockfree_reads)
+                rebuild_snapshot(bin);  // publish the (now empty) state
             bin.unlock();
         }
     }
@@ -503,11 +620,53 @@ public:
     // determine the bin number.
     static constexpr size_t nobin_mask() { return ~size_t(0) >> log2(BINS); }
 
+    /// Enable (or disable) the lock-free read path for retrieve(): writers
+    /// periodically publish an immutable snapshot of each bin, which
+    /// readers probe without acquiring the bin lock (epoch-based
+    /// reclamation keeps old snapshots alive while anybody reads them).
+    /// The price is relaxed semantics -- a retrieve may return a value
+    /// that a concurrent erase already removed, and values retired from
+    /// the map may not be destroyed until a later snapshot rebuild. That
+    /// is harmless for cache-like uses (the main intent, e.g. the
+    /// ImageCache tile map), but wrong for anything needing strict
+    /// read/erase ordering, so it is off by default.
+    void enable_lockfree_reads(bool enable) { m_lockfree_reads = enable; }
+
 private:
+    // Immutable open-addressed copy of one bin's contents, safe for
+    // concurrent probing. Holds VALUE copies, so (for example) refcounted
+    // values stay alive as long as the snapshot does.
+    struct Snapshot {
+        std::vector<std::pair<KEY, VALUE>> entries;
+        std::vector<uint32_t> table;  // 1-based index into entries, 0=empty
+        size_t mask     = 0;          // table size - 1 (power of 2)
+        uint64_t retire = 0;          // epoch at which we were retired
+
+        bool find(const KEY& key, size_t hash, const PRED& pred,
+                  VALUE& value) const
+        {
+            if (!mask)
+                return false;
+            for (size_t i = hash & mask;; i = (i + 1) & mask) {
+                uint32_t e = table[i];
+                if (!e)
+                    return false;
+                const auto& kv = entries[e - 1];
+                if (pred(kv.first, key)) {
+                    value = kv.second;
+                    return true;
+                }
+            }
+        }
+    };
+
     struct Bin {
-        OIIO_CACHE_ALIGN                  // align bin to cache line
-            mutable spin_rw_mutex mutex;  // mutex for this bin
+        OIIO_CACHE_ALIGN             // align bin to cache line
+            mutable BINMUTEX mutex;  // mutex for this bin
         BinMap_t map;                     // hash map for this bin
+        std::atomic<Snapshot*> snapshot { nullptr };  // for lock-free reads
+        std::vector<Snapshot*> retired;  // old snapshots awaiting readers
+        int dirty = 0;  // mutations since last snapshot (guarded by lock)
 #ifndef NDEBUG
         mutable atomic_int m_nrlocks;  // for debugging
         mutable atomic_int m_nwlocks;  // for debugging
@@ -525,6 +684,9 @@ private:
 #ifndef NDEBUG
             OIIO_DASSERT(m_nrlocks == 0 && m_nwlocks == 0);
 #endif
+            delete snapshot.load(std::memory_order_relaxed);
+            for (auto s : retired)
+                delete s;
         }
 
         void read_lock() const
@@ -570,8 +732,62 @@ private:
         }
     };
 
+    // Note that a bin was mutated (called with the bin write lock held).
+    // Once enough mutations accumulate relative to the bin's size, rebuild
+    // and republish its snapshot, amortizing the O(n) rebuild across many
+    // writes.
+    void note_mutation(Bin& bin)
+    {
+        if (!m_lockfree_reads)
+            return;
+        if (++bin.dirty > int(std::max(size_t(16), bin.map.size() / 8)))
+            rebuild_snapshot(bin);
+    }
+
+    // Rebuild the bin's snapshot from its authoritative map and publish
+    // it, retiring the old snapshot until no reader can still see it.
+    // Called with the bin write lock held.
+    void rebuild_snapshot(Bin& bin)
+    {
+        Snapshot* snap = new Snapshot;
+        if (size_t n = bin.map.size()) {
+            size_t tsize = 16;
+            while (tsize < 2 * n)
+                tsize <<= 1;
+            snap->entries.reserve(n);
+            snap->table.assign(tsize, 0);
+            snap->mask = tsize - 1;
+            for (auto&& kv : bin.map) {
+                snap->entries.emplace_back(kv.first, kv.second);
+                size_t i = m_hash(kv.first) & snap->mask;
+                while (snap->table[i])
+                    i = (i + 1) & snap->mask;
+                snap->table[i] = uint32_t(snap->entries.size());
+            }
+        }
+        Snapshot* old = bin.snapshot.exchange(snap, std::memory_order_acq_rel);
+        if (old) {
+            old->retire = m_ebr.retire_epoch();
+            bin.retired.push_back(old);
+        }
+        // Free previously retired snapshots that nobody can see anymore.
+        for (size_t i = 0; i < bin.retired.size();) {
+            if (m_ebr.can_free(bin.retired[i]->retire)) {
+                delete bin.retired[i];
+                bin.retired[i] = bin.retired.back();
+                bin.retired.pop_back();
+            } else {
+                ++i;
+            }
+        }
+        bin.dirty = 0;
+    }
+
     HASH m_hash;        // hashing function
+    PRED m_pred;        // key equality predicate
     atomic_int m_size;  // total entries in all bins
+    bool m_lockfree_reads = false;  // use the snapshot read path?
+    pvt::ebr_domain m_ebr;          // reclamation domain for snapshots
     Bin m_bins[BINS];   // the bins
 
     static constexpr int log2(unsigned n)
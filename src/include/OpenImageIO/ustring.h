@@ -18,6 +18,7 @@
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/export.h>
 #include <OpenImageIO/oiioversion.h>
+#include <OpenImageIO/span.h>
 #include <OpenImageIO/string_view.h>
 #include <OpenImageIO/strutil.h>
 #include <cstring>
@@ -705,6 +706,21 @@ public:
     /// in the vector.
     static size_t hash_collisions(std::vector<ustring>* collisions = nullptr);
 
+    /// Serialize the contents of the ustring table to a snapshot file that
+    /// load_table() can read back. Only the strings themselves are stored
+    /// -- ustring identity is a per-process pointer, so a later process
+    /// must re-intern them. Return true on success.
+    static bool save_table(string_view filename);
+
+    /// Pre-populate the ustring table from a snapshot file written by
+    /// save_table(), interning all of its strings in one pass (e.g. at
+    /// startup of short-lived processes that would otherwise intern the
+    /// same file paths and attribute names one by one). Entries are
+    /// validated as they are read; a truncated or corrupt file just stops
+    /// early. Return the number of strings interned, or 0 if the file
+    /// could not be read or is not a valid snapshot.
+    static size_t load_table(string_view filename);
+
     /// Given a string_view, return a pointer to the unique
     /// version kept in the internal table (creating a new table entry
     /// if we haven't seen this sequence of characters before).
@@ -713,6 +729,15 @@ public:
     /// the canonical unique copy of the characters.
     static const char* make_unique(string_view str);
 
+    /// Bulk version of make_unique: intern every string in `strs`, writing
+    /// the resulting ustrings into the corresponding elements of `out`
+    /// (the two spans must be the same length). When converting a large
+    /// string table all at once, this is substantially cheaper than
+    /// interning one string at a time, because the strings are grouped so
+    /// that each shard of the internal table is locked only once per batch
+    /// rather than once per string.
+    static void make_unique(cspan<string_view> strs, span<ustring> out);
+
     /// Is this character pointer a unique ustring representation of
     /// those characters?  Useful for diagnostics and debugging.
     static bool is_unique(const char* str)
@@ -11,6 +11,7 @@
 #define OPENIMAGEIO_IMAGEIO_PVT_H
 
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/profiler.h>
 #include <OpenImageIO/thread.h>
 #include <OpenImageIO/timer.h>
 
@@ -31,6 +32,9 @@ extern std::recursive_mutex imageio_mutex;
 extern atomic_int oiio_threads;
 extern atomic_int oiio_read_chunk;
 extern atomic_int oiio_try_all_readers;
+extern atomic_int oiio_read_drop_cache;
+extern atomic_int oiio_lazy_exif;
+extern atomic_int oiio_lazy_xmp;
 extern ustring font_searchpath;
 extern ustring plugin_searchpath;
 extern std::string format_list;
@@ -46,8 +50,19 @@ extern int limit_imagesize_MB;
 extern int opencv_version;
 extern int imagebuf_print_uncaught_errors;
 extern int imagebuf_use_imagecache;
+extern int imagebuf_device_memory;
+extern int imagebuf_alloc_alignment;
+extern int imagebuf_alloc_hugepages;
+extern int imagebuf_scratch_pool;
+extern int imagebuf_spill_MB;
+
+// Free pooled ImageBuf scratch blocks down to the current
+// "imagebuf:scratch_pool" budget (called when the attribute is lowered).
+void imagebuf_scratch_pool_trim();
 extern atomic_ll IB_local_mem_current;
 extern atomic_ll IB_local_mem_peak;
+extern atomic_ll IC_tile_mem_current;  // ImageCache tile bytes (all caches)
+extern atomic_ll DD_mem_current;       // DeepData sample storage bytes
 extern std::atomic<float> IB_total_open_time;
 extern std::atomic<float> IB_total_image_read_time;
 extern OIIO_UTIL_API int oiio_use_tbb;  // This lives in libOpenImageIO_Util
@@ -115,6 +130,17 @@ const void*
 parallel_convert_from_float(const float* src, void* dst, size_t nvals,
                             TypeDesc format);
 
+/// A bulk value-conversion kernel: convert nvals values from src to dst,
+/// with the data types fixed when the kernel was instantiated.
+typedef void (*convert_values_fn)(const void* src, void* dst, size_t nvals);
+
+/// Retrieve the compile-time-specialized kernel that converts src_type
+/// values to dst_type, or nullptr if either is not a numeric type. Look the
+/// kernel up once per image operation and call it per scanline, rather than
+/// re-dispatching on the runtime types for every call.
+OIIO_API convert_values_fn
+get_convert_values_fn(TypeDesc src_type, TypeDesc dst_type);
+
 /// Internal utility: Error checking on the spec -- if it contains texture-
 /// specific metadata but there are clues it's not actually a texture file
 /// written by maketx or `oiiotool -otex`, then assume these metadata are
@@ -134,11 +160,15 @@ OIIO_API std::string
 timing_report();
 
 /// An object that, if oiio_log_times is nonzero, logs time until its
-/// destruction. If oiio_log_times is 0, it does nothing.
+/// destruction. If oiio_log_times is 0, it does nothing. It also doubles
+/// as a ProfilerZone, so when the scoped profiler is enabled, every op
+/// that declares a LoggedTimer shows up as a span in the trace timeline
+/// for free.
 class LoggedTimer {
 public:
     LoggedTimer(string_view name)
         : m_timer(oiio_log_times)
+        , m_zone(name)
     {
         if (oiio_log_times)
             m_name = name;
@@ -162,6 +192,7 @@ public:
 private:
     Timer m_timer;
     std::string m_name;
+    ProfilerZone m_zone;
     int m_count = 1;
 };
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause and Apache-2.0
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #ifndef _WIN32
@@ -167,6 +168,7 @@ ImageViewer::ImageViewer(bool use_ocio, const std::string& image_color_space,
 
 ImageViewer::~ImageViewer()
 {
+    stopTilePrefetch();
     for (auto i : m_images)
         delete i;
 }
@@ -941,6 +943,9 @@ ImageViewer::reload()
     if (m_images.empty())
         return;
     IvImage* newimage = m_images[m_current_image];
+    // The prefetch thread must not be touching the file while we
+    // invalidate it in the cache.
+    stopTilePrefetch();
     newimage->invalidate();
     //glwin->trigger_redraw ();
     displayCurrentImage();
@@ -1142,12 +1147,88 @@ ImageViewer::updateStatusBar()
 
 
 
+// Stream the current image's tiles into the ImageCache from a background
+// thread, so the UI can display immediately and fill in as data arrives.
+// The thread never touches pixels directly -- it just get_tile/release_tile
+// cycles the cache, which is fully thread-safe -- and every few tiles it
+// queues a repaint of the GL window, whose paintGL re-pulls the visible
+// region through the (now warmer) cache. Tiles are walked starting from
+// the current view center so the pixels under the user's eyes arrive
+// first, spiraling out to the rest of the image.
+void
+ImageViewer::startTilePrefetch()
+{
+    stopTilePrefetch();
+    IvImage* img = cur();
+    if (!img || !img->cachedpixels() || !img->imagecache())
+        return;
+    ImageCache* ic = img->imagecache();
+    ustring filename(img->name());
+    const ImageSpec& spec(img->spec());
+    int subimage = img->subimage();
+    int miplevel = img->miplevel();
+    // For untiled files the cache's "tile" is the whole (or autotile'd)
+    // image; stepping by the full size still touches every cache tile.
+    int tw = spec.tile_width ? spec.tile_width : spec.width;
+    int th = spec.tile_height ? spec.tile_height : spec.height;
+    int xbegin = spec.x, xend = spec.x + spec.width;
+    int ybegin = spec.y, yend = spec.y + spec.height;
+    int z = spec.z;
+    // Order tile rows by distance from the current view center.
+    float xcenter, ycenterf;
+    glwin->get_center(xcenter, ycenterf);
+    int ycenter = (int)ycenterf;
+    std::vector<int> yorder;
+    for (int y = ybegin; y < yend; y += th)
+        yorder.push_back(y);
+    std::sort(yorder.begin(), yorder.end(), [&](int a, int b) {
+        return std::abs(a - ycenter) < std::abs(b - ycenter);
+    });
+
+    m_prefetch_cancel = false;
+    IvGL* glwin_      = glwin;
+    m_prefetch_thread = std::thread([=]() {
+        int sincerepaint = 0;
+        for (int y : yorder) {
+            for (int x = xbegin; x < xend; x += tw) {
+                if (m_prefetch_cancel)
+                    return;
+                ImageCache::Tile* tile = ic->get_tile(filename, subimage,
+                                                      miplevel, x, y, z);
+                if (!tile)
+                    return;  // read error -- don't spin on it
+                ic->release_tile(tile);
+                if (++sincerepaint >= 16) {
+                    sincerepaint = 0;
+                    QMetaObject::invokeMethod(glwin_, "update",
+                                              Qt::QueuedConnection);
+                }
+            }
+        }
+        QMetaObject::invokeMethod(glwin_, "update", Qt::QueuedConnection);
+    });
+}
+
+
+
+void
+ImageViewer::stopTilePrefetch()
+{
+    m_prefetch_cancel = true;
+    if (m_prefetch_thread.joinable())
+        m_prefetch_thread.join();
+}
+
+
+
 bool
 ImageViewer::loadCurrentImage(int subimage, int miplevel)
 {
     if (m_current_image < 0 || m_current_image >= (int)m_images.size()) {
         m_current_image = 0;
     }
+    // Whatever the prefetch thread was working on, we're changing it.
+    stopTilePrefetch();
     IvImage* img = cur();
     if (img) {
         // We need the spec available to compare the image format with
@@ -1219,6 +1300,10 @@ ImageViewer::loadCurrentImage(int subimage, int miplevel)
                 img->pixel_transform(srgb_transform, (int)current_color_mode(),
                                      current_channel());
             }
+            // If the pixels stayed cache-backed (typical for large files),
+            // display right away and stream the rest of the tiles in the
+            // background rather than waiting for a full read.
+            startTilePrefetch();
             return true;
         } else {
             statusImgInfo->setText(
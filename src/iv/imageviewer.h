@@ -18,6 +18,8 @@
 // included to remove std::min/std::max errors
 #include <OpenImageIO/platform.h>
 
+#include <atomic>
+#include <thread>
 #include <vector>
 
 #include <QAction>
@@ -329,6 +331,8 @@ private:
     void updateRecentFilesMenu();
     bool loadCurrentImage(int subimage = 0, int miplevel = 0);
     void displayCurrentImage(bool update = true);
+    void startTilePrefetch();
+    void stopTilePrefetch();
     void updateTitle();
     void updateStatusBar();
     void keyPressEvent(QKeyEvent* event) override;
@@ -403,6 +407,10 @@ private:
 
     std::vector<IvImage*> m_images;  // List of images
     int m_current_image;             // Index of current image, -1 if none
+    // Background thread streaming the current image's tiles into the
+    // ImageCache so repaints find them already loaded.
+    std::thread m_prefetch_thread;
+    std::atomic<bool> m_prefetch_cancel { false };
     int m_current_channel;           // Channel we're viewing.
     COLOR_MODE m_color_mode;         // How to show the current channel(s).
     int m_last_image;                // Last image we viewed
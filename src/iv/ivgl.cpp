@@ -61,7 +61,7 @@ IvGL::IvGL(QWidget* parent, ImageViewer& viewer)
     , m_last_pbo_used(0)
     , m_current_image(NULL)
     , m_pixelview_left_corner(true)
-    , m_last_texbuf_used(0)
+    , m_texbuf_clock(0)
 {
 #if 0
     QGLFormat format;
@@ -161,6 +161,7 @@ IvGL::create_textures(void)
         m_texbufs.back().y          = 0;
         m_texbufs.back().width      = 0;
         m_texbufs.back().height     = 0;
+        m_texbufs.back().last_used  = 0;
     }
 
     // Create another texture for the pixelview.
@@ -1022,8 +1023,9 @@ IvGL::update()
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
     for (auto&& tb : m_texbufs) {
-        tb.width  = 0;
-        tb.height = 0;
+        tb.width     = 0;
+        tb.height    = 0;
+        tb.last_used = 0;
         glBindTexture(GL_TEXTURE_2D, tb.tex_object);
         glTexImage2D(GL_TEXTURE_2D, 0 /*mip level*/, glinternalformat,
                      m_texture_width, m_texture_height, 0 /*border width*/,
@@ -1500,6 +1502,7 @@ IvGL::load_texture(int x, int y, int width, int height)
     for (auto&& tb : m_texbufs) {
         if (tb.x == x && tb.y == y && tb.width >= width
             && tb.height >= height) {
+            tb.last_used = ++m_texbuf_clock;
             glBindTexture(GL_TEXTURE_2D, tb.tex_object);
             return;
         }
@@ -1517,31 +1520,55 @@ IvGL::load_texture(int x, int y, int width, int height)
     GLenum gltype, glformat, glinternalformat;
     typespec_to_opengl(spec, nchannels, gltype, glformat, glinternalformat);
 
-    TexBuffer& tb = m_texbufs[m_last_texbuf_used];
+    // Evict the least recently bound texture tile, so the tiles still on
+    // screen survive a pan or zoom and only stale ones get replaced.
+    TexBuffer* lru = &m_texbufs[0];
+    for (auto&& tb : m_texbufs)
+        if (tb.last_used < lru->last_used)
+            lru = &tb;
+    TexBuffer& tb = *lru;
     tb.x          = x;
     tb.y          = y;
     tb.width      = width;
     tb.height     = height;
-    // Copy the imagebuf pixels we need, that's the only way we can do
-    // it safely since ImageBuf has a cache underneath and the whole image
-    // may not be resident at once.
+    tb.last_used  = ++m_texbuf_clock;
+
+    GLsizeiptr size = GLsizeiptr(uint64_t(width) * uint64_t(height)
+                                 * uint64_t(nchannels)
+                                 * uint64_t(spec.format.size()));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo_objects[m_last_pbo_used]);
+    // Orphan the buffer's previous storage so the map below never blocks
+    // on a still-in-flight DMA from the other texture upload, then decode
+    // the pixels straight into the mapped driver memory -- no intermediate
+    // CPU staging copy. We copy from the imagebuf because it has a cache
+    // underneath and the whole image may not be resident at once.
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    print_error("After buffer data");
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                    GL_MAP_WRITE_BIT
+                                        | GL_MAP_INVALIDATE_BUFFER_BIT);
+    print_error("After map buffer");
+    void* dest = mapped ? mapped : &m_tex_buffer[0];
     if (!m_use_shaders) {
         m_current_image->get_pixels(ROI(x, x + width, y, y + height),
-                                    spec.format, &m_tex_buffer[0]);
+                                    spec.format, dest);
     } else {
         m_current_image->get_pixels(ROI(x, x + width, y, y + height, 0, 1,
                                         m_viewer.current_channel(),
                                         m_viewer.current_channel() + nchannels),
-                                    spec.format, &m_tex_buffer[0]);
+                                    spec.format, dest);
     }
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo_objects[m_last_pbo_used]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER,
-                 GLsizeiptr(uint64_t(width) * uint64_t(height)
-                            * uint64_t(nchannels)
-                            * uint64_t(spec.format.size())),
-                 &m_tex_buffer[0], GL_STREAM_DRAW);
-    print_error("After buffer data");
+    if (mapped) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        print_error("After unmap buffer");
+    } else {
+        // Mapping failed; fall back to uploading the staging buffer.
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, &m_tex_buffer[0],
+                     GL_STREAM_DRAW);
+        print_error("After buffer data (fallback)");
+    }
+    // Alternate PBOs so the driver can overlap this upload's DMA with the
+    // CPU fill of the next tile.
     m_last_pbo_used = (m_last_pbo_used + 1) & 1;
 
     // When using PBO this is the offset within the buffer.
@@ -1552,7 +1579,6 @@ IvGL::load_texture(int x, int y, int width, int height)
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, glformat, gltype,
                     data);
     print_error("After loading sub image");
-    m_last_texbuf_used = (m_last_texbuf_used + 1) % m_texbufs.size();
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
@@ -134,9 +134,10 @@ protected:
         int y;
         int width;
         int height;
+        uint64_t last_used;  ///< m_texbuf_clock value at last bind.
     };
     std::vector<TexBuffer> m_texbufs;
-    int m_last_texbuf_used;
+    uint64_t m_texbuf_clock;  ///< Monotonic counter for LRU eviction.
     bool m_mouse_activation;  ///< Can we expect the window to be activated by mouse?
 
 
@@ -69,6 +69,8 @@ public:
               const ImageSpec& config) override;
     bool read_native_scanline(int subimage, int miplevel, int y, int z,
                               void* data) override;
+    bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
+                               int z, void* data) override;
     bool close() override;
 
     const std::string& filename() const { return m_filename; }
@@ -117,6 +119,13 @@ private:
 
     bool read_icc_profile(j_decompress_ptr cinfo, ImageSpec& spec);
 
+    // Attempt to decode the whole image by splitting it at its JPEG
+    // restart markers and decompressing the pieces concurrently on the
+    // thread pool, writing the scanlines directly into `data`. Returns
+    // false (leaving the decoder untouched) if the file isn't amenable,
+    // in which case the caller should fall back on serial decode.
+    bool read_restarts_parallel(void* data);
+
     void close_file() { init(); }
 
     friend class JpgOutput;
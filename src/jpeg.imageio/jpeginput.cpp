@@ -9,6 +9,7 @@
 #include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/thread.h>
 #include <OpenImageIO/tiffutils.h>
 
 #include "jpeg_pvt.h"
@@ -242,6 +243,20 @@ JpgInput::open(const std::string& name, ImageSpec& newspec)
         m_cmyk                  = true;
     }
 
+    // Respond to the "jpeg:scale" config hint: ask libjpeg to decode at
+    // a reduced scale (1/2, 1/4, or 1/8). This is nearly free, because
+    // it shortcuts the inverse DCT to produce fewer samples per block,
+    // and is enormously faster than decoding the full resolution image
+    // and then downsizing.
+    if (m_config && !m_raw) {
+        int scale = m_config->get_int_attribute("jpeg:scale", 1);
+        if (scale > 1) {
+            // Round down to the nearest supported reduction (2, 4, 8).
+            m_cinfo.scale_num   = 1;
+            m_cinfo.scale_denom = scale >= 8 ? 8 : (scale >= 4 ? 4 : 2);
+        }
+    }
+
     if (m_raw)
         m_coeffs = jpeg_read_coefficients(&m_cinfo);
     else
@@ -424,6 +439,252 @@ cmyk_to_rgb(int n, const unsigned char* cmyk, size_t cmyk_stride,
 
 
 
+// Minimal error handler for the throwaway decompressors used by
+// decode_restart_chunk. Fatal errors longjmp back to the chunk decoder;
+// warnings are swallowed entirely (chopping the stream at a restart
+// marker makes libjpeg grumble about "premature end of data segment"
+// for rows we deliberately discard).
+struct chunk_error_mgr {
+    struct jpeg_error_mgr pub;
+    jmp_buf setjmp_buffer;
+};
+
+
+static void
+chunk_error_exit(j_common_ptr cinfo)
+{
+    chunk_error_mgr* myerr = (chunk_error_mgr*)cinfo->err;
+    longjmp(myerr->setjmp_buffer, 1);
+}
+
+
+static void
+chunk_output_message(j_common_ptr /*cinfo*/)
+{
+}
+
+
+
+// Decode one synthetic JPEG stream (original header + a slice of the
+// entropy data + EOI) with its own decompressor, discarding the first
+// `skiprows` scanlines and depositing the next `nrows` contiguously at
+// `out`. Returns true if all requested scanlines decoded.
+static bool
+decode_restart_chunk(const std::vector<unsigned char>& chunkbuf, int skiprows,
+                     int nrows, unsigned char* out, size_t rowbytes)
+{
+    struct jpeg_decompress_struct cinfo;
+    chunk_error_mgr jerr;
+    cinfo.err               = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit     = chunk_error_exit;
+    jerr.pub.output_message = chunk_output_message;
+    if (setjmp(jerr.setjmp_buffer)) {
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, const_cast<unsigned char*>(chunkbuf.data()),
+                 chunkbuf.size());
+    if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+    jpeg_start_decompress(&cinfo);
+    bool ok = true;
+    std::unique_ptr<unsigned char[]> junkrow(new unsigned char[rowbytes]);
+    for (int i = 0; i < skiprows && ok; ++i) {
+        // The chunk overlaps its neighbor by one restart interval so the
+        // chroma upsampler has correct context at the seam; these leading
+        // rows belong to the neighbor and are thrown away.
+        JSAMPLE* rowptr = (JSAMPLE*)junkrow.get();
+        ok              = (jpeg_read_scanlines(&cinfo, &rowptr, 1) == 1);
+    }
+    for (int i = 0; i < nrows && ok; ++i) {
+        JSAMPLE* rowptr = (JSAMPLE*)(out + size_t(i) * rowbytes);
+        ok              = (jpeg_read_scanlines(&cinfo, &rowptr, 1) == 1);
+    }
+    jpeg_abort_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return ok;
+}
+
+
+
+bool
+JpgInput::read_restarts_parallel(void* data)
+{
+    // Get the entire file contents in memory -- directly from the proxy
+    // if it's a memreader, otherwise read it ourselves.
+    Filesystem::IOProxy* io = ioproxy();
+    std::vector<unsigned char> filebuf;
+    cspan<unsigned char> buf;
+    if (io->proxytype() == "memreader") {
+        buf = reinterpret_cast<Filesystem::IOMemReader*>(io)->buffer();
+    } else {
+        size_t size = io->size();
+        filebuf.resize(size);
+        if (io->pread(filebuf.data(), size, 0) != size)
+            return false;
+        buf = cspan<unsigned char>(filebuf.data(), filebuf.size());
+    }
+    size_t n = size_t(buf.size());
+    if (n < 4)
+        return false;
+
+    // Walk the marker segments to find where the SOS header ends and the
+    // entropy-coded data begins.
+    size_t pos = 2, sos_end = 0;
+    while (pos + 4 <= n) {
+        if (buf[pos] != 0xff)
+            return false;
+        int marker = buf[pos + 1];
+        if (marker == 0xd8 || (marker >= 0xd0 && marker <= 0xd7)
+            || marker == 0x01) {
+            pos += 2;  // standalone markers have no length field
+            continue;
+        }
+        size_t seglen = (size_t(buf[pos + 2]) << 8) | buf[pos + 3];
+        if (marker == 0xda) {  // SOS
+            sos_end = pos + 2 + seglen;
+            break;
+        }
+        pos += 2 + seglen;
+    }
+    if (!sos_end || sos_end >= n)
+        return false;
+
+    // Scan the entropy-coded data, recording the position just past each
+    // restart marker. Any other marker (a second SOS, DNL, etc.) means
+    // this isn't the simple single-scan layout we know how to slice up.
+    std::vector<size_t> splits;
+    splits.push_back(sos_end);
+    size_t end = 0;
+    for (size_t p = sos_end; p + 1 < n;) {
+        if (buf[p] != 0xff) {
+            ++p;
+            continue;
+        }
+        int marker = buf[p + 1];
+        if (marker == 0x00) {  // stuffed data byte
+            p += 2;
+        } else if (marker == 0xff) {  // fill byte
+            ++p;
+        } else if (marker >= 0xd0 && marker <= 0xd7) {  // RSTn
+            splits.push_back(p + 2);
+            p += 2;
+        } else if (marker == 0xd9) {  // EOI
+            end = p;
+            break;
+        } else {
+            return false;
+        }
+    }
+    if (!end)
+        return false;
+
+    // An interval is worth whole MCU rows only if the restart interval is
+    // a multiple of the MCU row width; otherwise the pieces don't start
+    // on scanline boundaries and we punt.
+    int maxh         = m_cinfo.max_h_samp_factor;
+    int maxv         = m_cinfo.max_v_samp_factor;
+    int mcus_per_row = (m_spec.width + maxh * 8 - 1) / (maxh * 8);
+    int dri          = m_cinfo.restart_interval;
+    if (mcus_per_row <= 0 || (dri % mcus_per_row) != 0)
+        return false;
+    int rows_per_interval = (dri / mcus_per_row) * maxv * 8;
+    int nintervals = (m_spec.height + rows_per_interval - 1) / rows_per_interval;
+    if (nintervals < 2 || int(splits.size()) < nintervals)
+        return false;
+
+    // Carve the intervals into at most a few chunks per pool thread. Each
+    // chunk becomes a freestanding JPEG stream: the original header, the
+    // slice of entropy data (overlapping one extra interval on each side
+    // for upsampling context, with the restart markers renumbered to be
+    // sequential from the slice's point of view), and an EOI.
+    thread_pool* pool = default_thread_pool();
+    int nchunks       = std::min(nintervals, 4 * pool->size());
+    size_t rowbytes   = m_spec.scanline_bytes(true);
+    bool ok           = true;  // failed chunk decode will stash a false here
+    task_set tasks(pool);
+    for (int c = 0; c < nchunks; ++c) {
+        int i0 = c * nintervals / nchunks;
+        int i1 = (c + 1) * nintervals / nchunks;
+        tasks.push(pool->push([&, i0, i1](int /*id*/) {
+            int a  = i0 > 0 ? i0 - 1 : i0;  // overlap into prior interval
+            int b1 = i1 < nintervals ? i1 + 1 : i1;  // and the next one
+            size_t dbegin = splits[a];
+            size_t dend   = size_t(b1) < splits.size() ? splits[b1] - 2 : end;
+            std::vector<unsigned char> chunk;
+            chunk.reserve(sos_end + (dend - dbegin) + 2);
+            chunk.insert(chunk.end(), buf.begin(), buf.begin() + sos_end);
+            chunk.insert(chunk.end(), buf.begin() + dbegin,
+                         buf.begin() + dend);
+            for (int j = a + 1; j < b1 && size_t(j) < splits.size(); ++j) {
+                // Restart markers must count 0-7 cyclically from the
+                // start of the scan or the decoder declares them lost.
+                size_t off     = sos_end + (splits[j] - 2 - dbegin);
+                chunk[off + 1] = (unsigned char)(0xd0 + ((j - a - 1) & 7));
+            }
+            chunk.push_back(0xff);
+            chunk.push_back(0xd9);
+            int skiprows = (i0 - a) * rows_per_interval;
+            int ybegin   = i0 * rows_per_interval;
+            int nrows    = std::min((i1 - i0) * rows_per_interval,
+                                    m_spec.height - ybegin);
+            if (!decode_restart_chunk(chunk, skiprows, nrows,
+                                      (unsigned char*)data
+                                          + size_t(ybegin) * rowbytes,
+                                      rowbytes))
+                ok = false;
+        }));
+    }
+    tasks.wait();
+    return ok;
+}
+
+
+
+bool
+JpgInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
+                                int yend, int z, void* data)
+{
+    {
+        lock_guard lock(*this);
+        if (!seek_subimage(subimage, miplevel))
+            return false;
+        // If the file is a plain baseline scan peppered with restart
+        // markers, and the caller wants the whole image at once, we can
+        // decode the restart intervals concurrently on the thread pool.
+        thread_pool* pool = default_thread_pool();
+        bool parallelize  = !m_raw && !m_cmyk && m_next_scanline == 0
+                           && ybegin == 0 && yend >= m_spec.height
+                           && m_cinfo.restart_interval > 0
+                           && !m_cinfo.progressive_mode && !m_cinfo.arith_code
+                           && m_cinfo.data_precision == 8
+                           && m_cinfo.scale_denom == 1
+                           // only if we're threading and don't enter the
+                           // thread pool recursively!
+                           && pool->size() > 1
+                           && !pool->is_worker()
+                           // and not if the feature is turned off
+                           && m_spec.get_int_attribute(
+                               "jpeg:multithread",
+                               OIIO::get_int_attribute("jpeg:multithread"));
+        if (parallelize && read_restarts_parallel(data)) {
+            // The regular decompressor never saw these scanlines; mark
+            // them consumed so a subsequent read forces a fresh rewind.
+            m_next_scanline = m_spec.height;
+            return true;
+        }
+    }
+    // Anything else: fall back on the default implementation, which
+    // loops over read_native_scanline.
+    return ImageInput::read_native_scanlines(subimage, miplevel, ybegin, yend,
+                                             z, data);
+}
+
+
+
 bool
 JpgInput::read_native_scanline(int subimage, int miplevel, int y, int /*z*/,
                                void* data)
@@ -14,6 +14,7 @@
 
 #include <OpenImageIO/color.h>
 #include <OpenImageIO/filesystem.h>
+#include <OpenImageIO/hash.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
 #include <OpenImageIO/strutil.h>
@@ -359,6 +360,11 @@ public:
 #endif
     bool isColorSpaceLinear(string_view name) const;
 
+    // Return the CSInfo flags for the named color space, or 0 if it isn't a
+    // color space we know. Non-const because the first query of a space may
+    // need to examine and classify it.
+    int colorspace_flags(string_view name) { return flags(name); }
+
 private:
     // Return the CSInfo flags for the given color space name
     int flags(string_view name)
@@ -1489,20 +1495,265 @@ public:
 #    endif
     }
 
+    std::string gpu_shader_text(string_view language,
+                                string_view function) const override
+    {
+#    ifdef OCIO_v2
+        OCIO::GpuLanguage lang;
+        if (Strutil::iequals(language, "glsl"))
+            lang = OCIO::GPU_LANGUAGE_GLSL_4_0;
+        else if (Strutil::iequals(language, "hlsl"))
+            lang = OCIO::GPU_LANGUAGE_HLSL_DX11;
+#        if OCIO_VERSION_HEX >= MAKE_OCIO_VERSION_HEX(2, 3, 0)
+        else if (Strutil::iequals(language, "msl"))
+            lang = OCIO::GPU_LANGUAGE_MSL_2_0;
+        else if (Strutil::iequals(language, "osl"))
+            lang = OCIO::GPU_LANGUAGE_OSL_1;
+#        endif
+        else
+            return std::string();
+        try {
+            {
+                // The GPU processor is created once and kept alongside the
+                // CPU one for the life of this (colorprocmap-cached)
+                // processor, so repeated shader queries are cheap.
+                spin_lock lock(m_gpu_mutex);
+                if (!m_gpuproc)
+                    m_gpuproc = m_p->getDefaultGPUProcessor();
+            }
+            auto desc = OCIO::GpuShaderDesc::CreateShaderDesc();
+            desc->setLanguage(lang);
+            desc->setFunctionName(std::string(function).c_str());
+            m_gpuproc->extractGpuShaderInfo(desc);
+            return desc->getShaderText();
+        } catch (const std::exception&) {
+            return std::string();
+        }
+#    else
+        return std::string();
+#    endif
+    }
+
 private:
     OCIO::ConstProcessorRcPtr m_p;
 #    if OCIO_VERSION_HEX >= 0x02000000
     OCIO::ConstCPUProcessorRcPtr m_cpuproc;
 #    endif
+#    ifdef OCIO_v2
+    mutable spin_mutex m_gpu_mutex;
+    mutable OCIO::ConstGPUProcessorRcPtr m_gpuproc;
+#    endif
 };
 #endif
 
 
 
-#if OCIO_VERSION_HEX < MAKE_OCIO_VERSION_HEX(2, 2, 0)
-// For version 2.2 and later, missing OCIO config will always fall back on
-// built-in configs, so we don't need any of these secondary fallback
-// heuristics.
+// The processors below hard-code the transfer function changes we understand
+// exactly in closed form. createColorProcessor dispatches the trivial known
+// pairs (sRGB <-> lin_srgb, Rec709 <-> lin_srgb, identity) to them directly,
+// bypassing the much more expensive OCIO CPUProcessor machinery; for builds
+// against OCIO < 2.2, they also serve as fallbacks when no usable config
+// could be found at all.
+
+// vfloat8 flavors of the transfer function utilities in color.h, so that the
+// processors can chew through two packed RGBA pixels per iteration.
+static inline simd::vfloat8
+sRGB_to_linear(const simd::vfloat8& x)
+{
+    return simd::select(x <= 0.04045f, x * (1.0f / 12.92f),
+                        fast_pow_pos(madd(x, simd::vfloat8(1.0f / 1.055f),
+                                          simd::vfloat8(0.055f / 1.055f)),
+                                     simd::vfloat8(2.4f)));
+}
+
+static inline simd::vfloat8
+linear_to_sRGB(const simd::vfloat8& x)
+{
+    return simd::select(x <= 0.0031308f, 12.92f * x,
+                        madd(simd::vfloat8(1.055f),
+                             fast_pow_pos(x, simd::vfloat8(1.0f / 2.4f)),
+                             simd::vfloat8(-0.055f)));
+}
+
+static inline simd::vfloat8
+Rec709_to_linear(const simd::vfloat8& x)
+{
+    return simd::select(x < 0.081f, x * (1.0f / 4.5f),
+                        fast_pow_pos(madd(x, simd::vfloat8(1.0f / 1.099f),
+                                          simd::vfloat8(0.099f / 1.099f)),
+                                     simd::vfloat8(1.0f / 0.45f)));
+}
+
+static inline simd::vfloat4
+Rec709_to_linear(const simd::vfloat4& x)
+{
+    return simd::select(x < 0.081f, x * (1.0f / 4.5f),
+                        fast_pow_pos(madd(x, simd::vfloat4(1.0f / 1.099f),
+                                          simd::vfloat4(0.099f / 1.099f)),
+                                     simd::vfloat4(1.0f / 0.45f)));
+}
+
+static inline simd::vfloat8
+linear_to_Rec709(const simd::vfloat8& x)
+{
+    return simd::select(x < 0.018f, x * 4.5f,
+                        madd(simd::vfloat8(1.099f),
+                             fast_pow_pos(x, simd::vfloat8(0.45f)),
+                             simd::vfloat8(-0.099f)));
+}
+
+static inline simd::vfloat4
+linear_to_Rec709(const simd::vfloat4& x)
+{
+    return simd::select(x < 0.018f, x * 4.5f,
+                        madd(simd::vfloat4(1.099f),
+                             fast_pow_pos(x, simd::vfloat4(0.45f)),
+                             simd::vfloat4(-0.099f)));
+}
+
+// Mask selecting the RGB lanes of two packed RGBA pixels, leaving the alpha
+// lanes untouched.
+static const simd::vbool8 rgb_lanes_mask(true, true, true, false, true, true,
+                                         true, false);
+
+
+
+// Lookup tables backing the bulk transfer-function conversions declared in
+// color.h. Each covers every possible input value of its source type, so
+// the conversions are exact (true powf, not the fast_pow_pos approximation)
+// and never evaluate the transfer function at runtime. Built on first use;
+// the function-local statics make initialization thread safe.
+
+static const float*
+srgb_to_linear_table_uint8()
+{
+    static const std::vector<float> table = []() {
+        std::vector<float> t(256);
+        for (int i = 0; i < 256; ++i)
+            t[i] = sRGB_to_linear(i * (1.0f / 255.0f));
+        return t;
+    }();
+    return table.data();
+}
+
+
+static const float*
+srgb_to_linear_table_uint16()
+{
+    static const std::vector<float> table = []() {
+        std::vector<float> t(65536);
+        for (int i = 0; i < 65536; ++i)
+            t[i] = sRGB_to_linear(i * (1.0f / 65535.0f));
+        return t;
+    }();
+    return table.data();
+}
+
+
+// Tables for half are indexed by the 16 bit pattern, so every value --
+// including negatives, infinities, NaNs -- maps exactly to what the scalar
+// function would have produced.
+static const float*
+srgb_to_linear_table_half()
+{
+    static const std::vector<float> table = []() {
+        std::vector<float> t(65536);
+        for (int i = 0; i < 65536; ++i) {
+            half h;
+            h.setBits((unsigned short)i);
+            t[i] = sRGB_to_linear((float)h);
+        }
+        return t;
+    }();
+    return table.data();
+}
+
+
+static const float*
+linear_to_srgb_table_half()
+{
+    static const std::vector<float> table = []() {
+        std::vector<float> t(65536);
+        for (int i = 0; i < 65536; ++i) {
+            half h;
+            h.setBits((unsigned short)i);
+            t[i] = linear_to_sRGB((float)h);
+        }
+        return t;
+    }();
+    return table.data();
+}
+
+
+void
+sRGB_to_linear(cspan<unsigned char> src, span<float> dst)
+{
+    OIIO_DASSERT(dst.size() >= src.size());
+    const float* lut = srgb_to_linear_table_uint8();
+    for (size_t i = 0, n = src.size(); i < n; ++i)
+        dst[i] = lut[src[i]];
+}
+
+
+void
+sRGB_to_linear(cspan<unsigned short> src, span<float> dst)
+{
+    OIIO_DASSERT(dst.size() >= src.size());
+    const float* lut = srgb_to_linear_table_uint16();
+    for (size_t i = 0, n = src.size(); i < n; ++i)
+        dst[i] = lut[src[i]];
+}
+
+
+void
+sRGB_to_linear(cspan<half> src, span<float> dst)
+{
+    OIIO_DASSERT(dst.size() >= src.size());
+    const float* lut = srgb_to_linear_table_half();
+    for (size_t i = 0, n = src.size(); i < n; ++i)
+        dst[i] = lut[src[i].bits()];
+}
+
+
+void
+sRGB_to_linear(cspan<float> src, span<float> dst)
+{
+    OIIO_DASSERT(dst.size() >= src.size());
+    const float* s = src.data();
+    float* d       = dst.data();
+    size_t n = src.size(), i = 0;
+    for (; i + 8 <= n; i += 8)
+        sRGB_to_linear(simd::vfloat8(s + i)).store(d + i);
+    for (; i < n; ++i)
+        d[i] = sRGB_to_linear(s[i]);
+}
+
+
+void
+linear_to_sRGB(cspan<half> src, span<float> dst)
+{
+    OIIO_DASSERT(dst.size() >= src.size());
+    const float* lut = linear_to_srgb_table_half();
+    for (size_t i = 0, n = src.size(); i < n; ++i)
+        dst[i] = lut[src[i].bits()];
+}
+
+
+void
+linear_to_sRGB(cspan<float> src, span<float> dst)
+{
+    OIIO_DASSERT(dst.size() >= src.size());
+    const float* s = src.data();
+    float* d       = dst.data();
+    size_t n = src.size(), i = 0;
+    for (; i + 8 <= n; i += 8)
+        linear_to_sRGB(simd::vfloat8(s + i)).store(d + i);
+    for (; i < n; ++i)
+        d[i] = linear_to_sRGB(s[i]);
+}
+
+
+
 
 // ColorProcessor that hard-codes sRGB-to-linear
 class ColorProcessor_sRGB_to_linear final : public ColorProcessor {
@@ -1515,6 +1766,26 @@ public:
                stride_t chanstride, stride_t xstride,
                stride_t ystride) const override
     {
+        if ((channels == 3 || channels == 4) && chanstride == sizeof(float)
+            && xstride == 4 * sizeof(float)) {
+            // Contiguous RGBA pixels: convert two at a time (8 values per
+            // iteration), restoring the alpha lanes untouched.
+            for (int y = 0; y < height; ++y) {
+                float* d = (float*)((char*)data + y * ystride);
+                int x    = 0;
+                for (; x + 2 <= width; x += 2, d += 8) {
+                    simd::vfloat8 r(d);
+                    simd::select(rgb_lanes_mask, sRGB_to_linear(r), r)
+                        .store(d);
+                }
+                for (; x < width; ++x, d += 4) {
+                    simd::vfloat4 r;
+                    r.load(d, 3);
+                    sRGB_to_linear(r).store(d, 3);
+                }
+            }
+            return;
+        }
         if (channels > 3)
             channels = 3;
         if (channels == 3 && chanstride == sizeof(float)) {
@@ -1552,6 +1823,26 @@ public:
                stride_t chanstride, stride_t xstride,
                stride_t ystride) const override
     {
+        if ((channels == 3 || channels == 4) && chanstride == sizeof(float)
+            && xstride == 4 * sizeof(float)) {
+            // Contiguous RGBA pixels: convert two at a time (8 values per
+            // iteration), restoring the alpha lanes untouched.
+            for (int y = 0; y < height; ++y) {
+                float* d = (float*)((char*)data + y * ystride);
+                int x    = 0;
+                for (; x + 2 <= width; x += 2, d += 8) {
+                    simd::vfloat8 r(d);
+                    simd::select(rgb_lanes_mask, linear_to_sRGB(r), r)
+                        .store(d);
+                }
+                for (; x < width; ++x, d += 4) {
+                    simd::vfloat4 r;
+                    r.load(d, 3);
+                    linear_to_sRGB(r).store(d, 3);
+                }
+            }
+            return;
+        }
         if (channels > 3)
             channels = 3;
         if (channels == 3 && chanstride == sizeof(float)) {
@@ -1590,6 +1881,26 @@ public:
                stride_t chanstride, stride_t xstride,
                stride_t ystride) const override
     {
+        if ((channels == 3 || channels == 4) && chanstride == sizeof(float)
+            && xstride == 4 * sizeof(float)) {
+            // Contiguous RGBA pixels: convert two at a time (8 values per
+            // iteration), restoring the alpha lanes untouched.
+            for (int y = 0; y < height; ++y) {
+                float* d = (float*)((char*)data + y * ystride);
+                int x    = 0;
+                for (; x + 2 <= width; x += 2, d += 8) {
+                    simd::vfloat8 r(d);
+                    simd::select(rgb_lanes_mask, Rec709_to_linear(r), r)
+                        .store(d);
+                }
+                for (; x < width; ++x, d += 4) {
+                    simd::vfloat4 r;
+                    r.load(d, 3);
+                    Rec709_to_linear(r).store(d, 3);
+                }
+            }
+            return;
+        }
         if (channels > 3)
             channels = 3;
         for (int y = 0; y < height; ++y) {
@@ -1615,6 +1926,26 @@ public:
                stride_t chanstride, stride_t xstride,
                stride_t ystride) const override
     {
+        if ((channels == 3 || channels == 4) && chanstride == sizeof(float)
+            && xstride == 4 * sizeof(float)) {
+            // Contiguous RGBA pixels: convert two at a time (8 values per
+            // iteration), restoring the alpha lanes untouched.
+            for (int y = 0; y < height; ++y) {
+                float* d = (float*)((char*)data + y * ystride);
+                int x    = 0;
+                for (; x + 2 <= width; x += 2, d += 8) {
+                    simd::vfloat8 r(d);
+                    simd::select(rgb_lanes_mask, linear_to_Rec709(r), r)
+                        .store(d);
+                }
+                for (; x < width; ++x, d += 4) {
+                    simd::vfloat4 r;
+                    r.load(d, 3);
+                    linear_to_Rec709(r).store(d, 3);
+                }
+            }
+            return;
+        }
         if (channels > 3)
             channels = 3;
         for (int y = 0; y < height; ++y) {
@@ -1686,7 +2017,6 @@ public:
     {
     }
 };
-#endif
 
 
 
@@ -1750,6 +2080,160 @@ private:
 
 
 
+// ColorProcessor that applies a baked 3D lattice of the transform,
+// trilinearly interpolated over the [0,1] domain. This is the in-memory
+// form of the on-disk processor cache (see the "ocio:lut3d_cache_dir"
+// attribute): repeat invocations load the lattice from disk instead of
+// paying for OCIO's processor construction and LUT baking per process.
+class ColorProcessor_LUT3D final : public ColorProcessor {
+public:
+    ColorProcessor_LUT3D(int edgelen, std::vector<float> lattice)
+        : ColorProcessor()
+        , m_edgelen(edgelen)
+        , m_lattice(std::move(lattice))
+    {
+    }
+    ~ColorProcessor_LUT3D() override {}
+    bool hasChannelCrosstalk() const override { return true; }
+
+    void apply(float* data, int width, int height, int channels,
+               stride_t chanstride, stride_t xstride,
+               stride_t ystride) const override
+    {
+        using namespace simd;
+        channels = std::min(channels, 3);
+        for (int y = 0; y < height; ++y) {
+            char* d = (char*)data + y * ystride;
+            for (int x = 0; x < width; ++x, d += xstride) {
+                vfloat4 color(0.0f);
+                char* dc = d;
+                for (int c = 0; c < channels; ++c, dc += chanstride)
+                    color[c] = *(float*)dc;
+                vfloat4 xcolor = lookup(color);
+                dc             = d;
+                for (int c = 0; c < channels; ++c, dc += chanstride)
+                    *(float*)dc = xcolor[c];
+            }
+        }
+    }
+
+private:
+    int m_edgelen;
+    std::vector<float> m_lattice;  // edgelen^3 RGB triples, R fastest
+
+    simd::vfloat4 at(int r, int g, int b) const
+    {
+        simd::vfloat4 v;
+        v.load(m_lattice.data()
+                   + 3 * ((size_t(b) * m_edgelen + g) * m_edgelen + r),
+               3);
+        return v;
+    }
+
+    simd::vfloat4 lookup(const simd::vfloat4& color) const
+    {
+        using namespace simd;
+        int n     = m_edgelen;
+        vfloat4 c = clamp(color, vfloat4(0.0f), vfloat4(1.0f)) * float(n - 1);
+        vint4 ic  = min(vint4(c), vint4(n - 2));
+        vfloat4 f = c - vfloat4(ic);
+        int r = ic[0], g = ic[1], b = ic[2];
+        float fr = f[0], fg = f[1], fb = f[2];
+        vfloat4 c00 = lerp(at(r, g, b), at(r + 1, g, b), fr);
+        vfloat4 c10 = lerp(at(r, g + 1, b), at(r + 1, g + 1, b), fr);
+        vfloat4 c01 = lerp(at(r, g, b + 1), at(r + 1, g, b + 1), fr);
+        vfloat4 c11 = lerp(at(r, g + 1, b + 1), at(r + 1, g + 1, b + 1), fr);
+        return lerp(lerp(c00, c10, fg), lerp(c01, c11, fg), fb);
+    }
+};
+
+
+// On-disk format of a baked LUT cache entry: this header, followed by
+// edgelen^3 RGB float triples (R fastest).
+struct Lut3DCacheHeader {
+    char magic[8];    // "OIIOlut3"
+    int32_t version;  // file format version
+    int32_t edgelen;  // lattice edge length
+};
+
+static const char lut3d_cache_magic[8]
+    = { 'O', 'I', 'I', 'O', 'l', 'u', 't', '3' };
+static const int lut3d_cache_version = 1;
+static const int lut3d_edgelen       = 65;
+
+
+// Bake `proc` into a lattice by pushing the full grid of lattice
+// coordinates through it with one apply() call.
+OIIO_MAYBE_UNUSED static std::vector<float>
+bake_lut3d(const ColorProcessor& proc, int edgelen)
+{
+    size_t n = size_t(edgelen);
+    std::vector<float> lattice(n * n * n * 3);
+    size_t i    = 0;
+    float scale = 1.0f / float(edgelen - 1);
+    for (int b = 0; b < edgelen; ++b)
+        for (int g = 0; g < edgelen; ++g)
+            for (int r = 0; r < edgelen; ++r) {
+                lattice[i++] = r * scale;
+                lattice[i++] = g * scale;
+                lattice[i++] = b * scale;
+            }
+    proc.apply(lattice.data(), edgelen * edgelen, edgelen, 3, sizeof(float),
+               3 * sizeof(float),
+               stride_t(edgelen) * edgelen * 3 * sizeof(float));
+    return lattice;
+}
+
+
+// Write the lattice to the cache file, best effort -- failure just means
+// the next process re-bakes. Write to a temporary and rename so that
+// concurrent processes never see a partial file.
+OIIO_MAYBE_UNUSED static void
+save_lut3d_cache(const std::string& filename, int edgelen,
+                 const std::vector<float>& lattice)
+{
+    std::string tmpname = Filesystem::unique_path(filename + ".%%%%.tmp");
+    FILE* fd            = Filesystem::fopen(tmpname, "wb");
+    if (!fd)
+        return;
+    Lut3DCacheHeader hdr;
+    memcpy(hdr.magic, lut3d_cache_magic, sizeof(hdr.magic));
+    hdr.version = lut3d_cache_version;
+    hdr.edgelen = edgelen;
+    bool ok     = fwrite(&hdr, sizeof(hdr), 1, fd) == 1
+              && fwrite(lattice.data(), sizeof(float), lattice.size(), fd)
+                     == lattice.size();
+    fclose(fd);
+    if (!ok || !Filesystem::rename(tmpname, filename))
+        Filesystem::remove(tmpname);
+}
+
+
+OIIO_MAYBE_UNUSED static ColorProcessorHandle
+load_lut3d_cache(const std::string& filename)
+{
+    FILE* fd = Filesystem::fopen(filename, "rb");
+    if (!fd)
+        return ColorProcessorHandle();
+    ColorProcessorHandle handle;
+    Lut3DCacheHeader hdr;
+    if (fread(&hdr, sizeof(hdr), 1, fd) == 1
+        && !memcmp(hdr.magic, lut3d_cache_magic, sizeof(hdr.magic))
+        && hdr.version == lut3d_cache_version && hdr.edgelen >= 2
+        && hdr.edgelen <= 256) {
+        size_t n = size_t(hdr.edgelen);
+        std::vector<float> lattice(n * n * n * 3);
+        if (fread(lattice.data(), sizeof(float), lattice.size(), fd)
+            == lattice.size())
+            handle = ColorProcessorHandle(
+                new ColorProcessor_LUT3D(hdr.edgelen, std::move(lattice)));
+    }
+    fclose(fd);
+    return handle;
+}
+
+
+
 ColorProcessorHandle
 ColorConfig::createColorProcessor(string_view inputColorSpace,
                                   string_view outputColorSpace,
@@ -1778,6 +2262,38 @@ ColorConfig::createColorProcessor(ustring inputColorSpace,
     if (handle)
         return handle;
 
+    // If both spaces are fully classified as ones we understand in closed
+    // form and the conversion is one of the trivial pairs (identity,
+    // sRGB <-> lin_srgb, Rec709 <-> lin_srgb), dispatch to our vectorized
+    // processors and skip OCIO entirely -- the CPUProcessor overhead is
+    // several times the cost of the raw math for these cases.
+    if (context_key.empty()) {
+        int inflags  = getImpl()->colorspace_flags(inputColorSpace);
+        int outflags = getImpl()->colorspace_flags(outputColorSpace);
+        if ((inflags & CSInfo::is_known) && (outflags & CSInfo::is_known)) {
+            if ((inflags & CSInfo::is_known) == (outflags & CSInfo::is_known))
+                handle = ColorProcessorHandle(new ColorProcessor_Ident);
+            else if ((inflags & CSInfo::is_srgb)
+                     && (outflags & CSInfo::is_lin_srgb))
+                handle = ColorProcessorHandle(
+                    new ColorProcessor_sRGB_to_linear);
+            else if ((inflags & CSInfo::is_lin_srgb)
+                     && (outflags & CSInfo::is_srgb))
+                handle = ColorProcessorHandle(
+                    new ColorProcessor_linear_to_sRGB);
+            else if ((inflags & CSInfo::is_Rec709)
+                     && (outflags & CSInfo::is_lin_srgb))
+                handle = ColorProcessorHandle(
+                    new ColorProcessor_Rec709_to_linear);
+            else if ((inflags & CSInfo::is_lin_srgb)
+                     && (outflags & CSInfo::is_Rec709))
+                handle = ColorProcessorHandle(
+                    new ColorProcessor_linear_to_Rec709);
+            if (handle)
+                return getImpl()->addproc(prockey, handle);
+        }
+    }
+
 #ifdef USE_OCIO
     // DBG("createColorProcessor {} -> {}\n", inputColorSpace,
     //                outputColorSpace);
@@ -1801,6 +2317,30 @@ ColorConfig::createColorProcessor(ustring inputColorSpace,
             context = ctx;
         }
 
+        // If the on-disk baked-LUT cache is enabled, see if a previous
+        // process already baked this exact transform and saved it.
+        std::string lutcachefile;
+        std::string lutcachedir = get_string_attribute("ocio:lut3d_cache_dir");
+        if (lutcachedir.size()) {
+            std::string cacheid;
+            try {
+                cacheid = config->getCacheID();
+            } catch (...) {
+            }
+            if (cacheid.size()) {
+                std::string key = Strutil::fmt::format(
+                    "{}:{}:{}:{}:{}:{}:{}", cacheid, inputColorSpace,
+                    outputColorSpace, context_key, context_value, lut3d_edgelen,
+                    OIIO_VERSION);
+                lutcachefile = Strutil::fmt::format("{}/ocio-{}.lut3d",
+                                                    lutcachedir,
+                                                    SHA1(key).digest());
+                handle       = load_lut3d_cache(lutcachefile);
+                if (handle)
+                    return getImpl()->addproc(prockey, handle);
+            }
+        }
+
         try {
             // Get the processor corresponding to this transform.
             p = getImpl()->config_->getProcessor(context,
@@ -1829,6 +2369,17 @@ ColorConfig::createColorProcessor(ustring inputColorSpace,
             handle = ColorProcessorHandle(new ColorProcessor_OCIO(p));
             // DBG("OCIO processor '{}' -> '{}' is NOT NoOp, handle = {}\n",
             //                inputColorSpace, outputColorSpace, (bool)handle);
+            if (lutcachefile.size()) {
+                // Disk cache enabled: bake the processor into a lattice,
+                // save it for future processes, and also use the lattice
+                // in this process so that warm and cold runs compute
+                // identical results.
+                auto lattice = bake_lut3d(*handle, lut3d_edgelen);
+                save_lut3d_cache(lutcachefile, lut3d_edgelen, lattice);
+                handle = ColorProcessorHandle(
+                    new ColorProcessor_LUT3D(lut3d_edgelen,
+                                             std::move(lattice)));
+            }
         }
     }
 #endif
@@ -2351,64 +2902,72 @@ colorconvert_impl(ImageBuf& R, const ImageBuf& A,
         roi, parallel_options(nthreads),
         [&, unpremult, channelsToCopy, processor](ROI roi) {
             int width = roi.width();
-            // Temporary space to hold one RGBA scanline
+            // Hand OCIO as many scanlines per apply() call as fit in a
+            // scratch batch sized to stay resident in L2 -- the per-call
+            // setup inside OCIO is significant for short rows.
+            const int64_t batchbytes = 192 * 1024;
+            int batchrows = std::max(1, std::min(roi.height(),
+                                int(batchbytes / (width * 4 * int(sizeof(float))))));
+            // Temporary space to hold a batch of RGBA scanlines
             vfloat4* scanline;
-            OIIO_ALLOCATE_STACK_OR_HEAP(scanline, vfloat4, width);
+            OIIO_ALLOCATE_STACK_OR_HEAP(scanline, vfloat4, width * batchrows);
             float* alpha;
-            OIIO_ALLOCATE_STACK_OR_HEAP(alpha, float, width);
+            OIIO_ALLOCATE_STACK_OR_HEAP(alpha, float, width * batchrows);
             const float fltmin = std::numeric_limits<float>::min();
             ImageBuf::ConstIterator<Atype> a(A, roi);
             ImageBuf::Iterator<Rtype> r(R, roi);
             for (int k = roi.zbegin; k < roi.zend; ++k) {
-                for (int j = roi.ybegin; j < roi.yend; ++j) {
-                    // Load the scanline
-                    a.rerange(roi.xbegin, roi.xend, j, j + 1, k, k + 1);
+                for (int j = roi.ybegin; j < roi.yend; j += batchrows) {
+                    int jend  = std::min(j + batchrows, roi.yend);
+                    int nrows = jend - j;
+                    // Load the scanlines, unpremultiplying as we go. Be
+                    // careful of alpha==0 pixels, preserve their color
+                    // rather than div-by-zero.
+                    a.rerange(roi.xbegin, roi.xend, j, jend, k, k + 1);
                     for (int i = 0; !a.done(); ++a, ++i) {
                         vfloat4 v(0.0f);
                         for (int c = 0; c < channelsToCopy; ++c)
                             v[c] = a[c];
                         if (channelsToCopy == 1)
                             v[2] = v[1] = v[0];
-                        scanline[i] = v;
-                    }
-
-                    // Optionally unpremult. Be careful of alpha==0 pixels,
-                    // preserve their color rather than div-by-zero.
-                    if (unpremult) {
-                        for (int i = 0; i < width; ++i) {
-                            float a  = extract<3>(scanline[i]);
-                            alpha[i] = a;
-                            a        = a >= fltmin ? a : 1.0f;
-                            scanline[i] /= vfloat4(a,a,a,1.0f);
+                        if (unpremult) {
+                            float av = extract<3>(v);
+                            alpha[i] = av;
+                            av       = av >= fltmin ? av : 1.0f;
+                            v /= vfloat4(av,av,av,1.0f);
                         }
+                        scanline[i] = v;
                     }
 
-                    // Apply the color transformation in place
-                    processor->apply((float*)&scanline[0], width, 1, 4,
+                    // Apply the color transformation in place, one OCIO
+                    // call for the whole batch.
+                    processor->apply((float*)&scanline[0], width, nrows, 4,
                                      sizeof(float), 4 * sizeof(float),
                                      width * 4 * sizeof(float));
 
-                    // Optionally re-premult. Be careful of alpha==0 pixels,
-                    // preserve their value rather than crushing to black.
+                    // Store the scanlines, re-premultiplying as we go. Be
+                    // careful of alpha==0 pixels, preserve their value
+                    // rather than crushing to black.
+                    float* dstPtr = (float*)&scanline[0];
+                    r.rerange(roi.xbegin, roi.xend, j, jend, k, k + 1);
                     if (unpremult) {
-                        for (int i = 0; i < width; ++i) {
-                            float a  = alpha[i];
-                            a        = a >= fltmin ? a : 1.0f;
-                            scanline[i] *= vfloat4(a,a,a,1.0f);
+                        for (int i = 0; !r.done(); ++r, ++i, dstPtr += 4) {
+                            float av = alpha[i];
+                            av       = av >= fltmin ? av : 1.0f;
+                            vfloat4 v = vfloat4(dstPtr) * vfloat4(av,av,av,1.0f);
+                            for (int c = 0; c < channelsToCopy; ++c)
+                                r[c] = v[c];
                         }
+                    } else {
+                        for (; !r.done(); ++r, dstPtr += 4)
+                            for (int c = 0; c < channelsToCopy; ++c)
+                                r[c] = dstPtr[c];
                     }
-
-                    // Store the scanline
-                    float* dstPtr = (float*)&scanline[0];
-                    r.rerange(roi.xbegin, roi.xend, j, j + 1, k, k + 1);
-                    for (; !r.done(); ++r, dstPtr += 4)
-                        for (int c = 0; c < channelsToCopy; ++c)
-                            r[c] = dstPtr[c];
                     if (channelsToCopy < roi.chend && (&R != &A)) {
                         // If there are "leftover" channels, just copy them
                         // unaltered from the source.
-                        a.rerange(roi.xbegin, roi.xend, j, j + 1, k, k + 1);
-                        r.rerange(roi.xbegin, roi.xend, j, j + 1, k, k + 1);
+                        a.rerange(roi.xbegin, roi.xend, j, jend, k, k + 1);
+                        r.rerange(roi.xbegin, roi.xend, j, jend, k, k + 1);
                         for (; !r.done(); ++r, ++a)
                             for (int c = channelsToCopy; c < roi.chend; ++c)
                                 r[c] = 0.5 + 10 * a[c];
@@ -2436,48 +2995,68 @@ colorconvert_impl_float_rgba(ImageBuf& R, const ImageBuf& A,
                 && R.nchannels() == 4 && A.nchannels() == 4);
     parallel_image(roi, parallel_options(nthreads), [&](ROI roi) {
         int width = roi.width();
-        // Temporary space to hold one RGBA scanline
+        // Hand OCIO as many scanlines per apply() call as fit in a scratch
+        // batch sized to stay resident in L2 -- the per-call setup inside
+        // OCIO is significant for short rows.
+        const int64_t batchbytes = 192 * 1024;
+        int batchrows            = std::max(
+            1, std::min(roi.height(),
+                                   int(batchbytes / (width * 4 * int(sizeof(float))))));
+        // Temporary space to hold a batch of RGBA scanlines
         vfloat4* scanline;
-        OIIO_ALLOCATE_STACK_OR_HEAP(scanline, vfloat4, width);
+        OIIO_ALLOCATE_STACK_OR_HEAP(scanline, vfloat4, width * batchrows);
         float* alpha;
-        OIIO_ALLOCATE_STACK_OR_HEAP(alpha, float, width);
+        OIIO_ALLOCATE_STACK_OR_HEAP(alpha, float, width * batchrows);
         const float fltmin = std::numeric_limits<float>::min();
         for (int k = roi.zbegin; k < roi.zend; ++k) {
-            for (int j = roi.ybegin; j < roi.yend; ++j) {
-                // Load the scanline
-                memcpy((void*)scanline, A.pixeladdr(roi.xbegin, j, k),
-                       width * 4 * sizeof(float));
-                // Optionally unpremult
-                if (unpremult) {
-                    for (int i = 0; i < width; ++i) {
-                        vfloat4 p(scanline[i]);
-                        float a  = extract<3>(p);
-                        alpha[i] = a;
-                        a        = a >= fltmin ? a : 1.0f;
-                        if (a == 1.0f)
-                            scanline[i] = p;
-                        else
-                            scanline[i] = p / vfloat4(a, a, a, 1.0f);
+            for (int j = roi.ybegin; j < roi.yend; j += batchrows) {
+                int jend  = std::min(j + batchrows, roi.yend);
+                int nrows = jend - j;
+                // Load the scanlines, unpremultiplying in the same pass
+                for (int row = 0; row < nrows; ++row) {
+                    const float* srcptr
+                        = (const float*)A.pixeladdr(roi.xbegin, j + row, k);
+                    vfloat4* line = scanline + int64_t(row) * width;
+                    if (unpremult) {
+                        float* alphaline = alpha + int64_t(row) * width;
+                        for (int i = 0; i < width; ++i) {
+                            vfloat4 p(srcptr + 4 * i);
+                            float a      = extract<3>(p);
+                            alphaline[i] = a;
+                            a            = a >= fltmin ? a : 1.0f;
+                            if (a == 1.0f)
+                                line[i] = p;
+                            else
+                                line[i] = p / vfloat4(a, a, a, 1.0f);
+                        }
+                    } else {
+                        memcpy((void*)line, srcptr, width * 4 * sizeof(float));
                     }
                 }
 
-                // Apply the color transformation in place
-                processor->apply((float*)&scanline[0], width, 1, 4,
+                // Apply the color transformation in place, one OCIO call
+                // for the whole batch
+                processor->apply((float*)&scanline[0], width, nrows, 4,
                                  sizeof(float), 4 * sizeof(float),
                                  width * 4 * sizeof(float));
 
-                // Optionally premult
-                if (unpremult) {
-                    for (int i = 0; i < width; ++i) {
-                        vfloat4 p(scanline[i]);
-                        float a = alpha[i];
-                        a       = a >= fltmin ? a : 1.0f;
-                        p *= vfloat4(a, a, a, 1.0f);
-                        scanline[i] = p;
+                // Store the scanlines, re-premultiplying in the same pass
+                for (int row = 0; row < nrows; ++row) {
+                    float* dstptr = (float*)R.pixeladdr(roi.xbegin, j + row, k);
+                    vfloat4* line = scanline + int64_t(row) * width;
+                    if (unpremult) {
+                        const float* alphaline = alpha + int64_t(row) * width;
+                        for (int i = 0; i < width; ++i) {
+                            vfloat4 p(line[i]);
+                            float a = alphaline[i];
+                            a       = a >= fltmin ? a : 1.0f;
+                            p *= vfloat4(a, a, a, 1.0f);
+                            p.store(dstptr + 4 * i);
+                        }
+                    } else {
+                        memcpy(dstptr, line, width * 4 * sizeof(float));  //NOSONAR
                     }
                 }
-                memcpy(R.pixeladdr(roi.xbegin, j, k), scanline,
-                       width * 4 * sizeof(float));  //NOSONAR
             }
         }
     });
@@ -2486,6 +3065,72 @@ colorconvert_impl_float_rgba(ImageBuf& R, const ImageBuf& A,
 
 
 
+// Per-type glue for colorconvert_impl_srgb_lut below: exact LUT lookup of
+// the transfer function, and plain value conversion for non-color channels.
+static inline float
+srgb_lut_lookup(unsigned char v)
+{
+    return srgb_to_linear_table_uint8()[v];
+}
+static inline float
+srgb_lut_lookup(unsigned short v)
+{
+    return srgb_to_linear_table_uint16()[v];
+}
+static inline float
+srgb_lut_lookup(half v)
+{
+    return srgb_to_linear_table_half()[v.bits()];
+}
+static inline float
+tofloat_val(unsigned char v)
+{
+    return v * (1.0f / 255.0f);
+}
+static inline float
+tofloat_val(unsigned short v)
+{
+    return v * (1.0f / 65535.0f);
+}
+static inline float
+tofloat_val(half v)
+{
+    return (float)v;
+}
+
+
+// Specialized colorconvert for the built-in sRGB-to-linear processor when
+// the source is uint8, uint16, or half and the destination is local float
+// pixels: every possible source value is in a lookup table, so each color
+// value costs one table load instead of a float conversion plus transfer
+// math. Like the processors above, the first three channels are treated as
+// color; a fourth (alpha) channel is value-converted unchanged.
+template<typename Atype>
+static bool
+colorconvert_impl_srgb_lut(ImageBuf& R, const ImageBuf& A, ROI roi,
+                           int nthreads)
+{
+    using namespace ImageBufAlgo;
+    int nch     = roi.nchannels();
+    int colorch = std::min(3, nch);
+    parallel_image(roi, parallel_options(nthreads), [&](ROI roi) {
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                const Atype* s = (const Atype*)A.pixeladdr(roi.xbegin, y, z);
+                float* d       = (float*)R.pixeladdr(roi.xbegin, y, z);
+                for (int x = roi.width(); x; --x, s += nch, d += nch) {
+                    for (int c = 0; c < colorch; ++c)
+                        d[c] = srgb_lut_lookup(s[c]);
+                    for (int c = colorch; c < nch; ++c)
+                        d[c] = tofloat_val(s[c]);
+                }
+            }
+    });
+    return true;
+}
+
+
+
 bool
 ImageBufAlgo::colorconvert(ImageBuf& dst, const ImageBuf& src,
                            const ColorProcessor* processor, bool unpremult,
@@ -2521,6 +3166,24 @@ ImageBufAlgo::colorconvert(ImageBuf& dst, const ImageBuf& src,
         unpremult = false;
     }
 
+    // The common ingest case -- an 8/16-bit or half sRGB-tagged asset
+    // headed to linear float -- never needs the transfer math at all:
+    // every possible source value is pre-tabulated.
+    if ((!unpremult || src.spec().alpha_channel < 0) && dst.localpixels()
+        && src.localpixels() && dst.spec().format == TypeFloat
+        && dst.nchannels() == src.nchannels() && src.nchannels() <= 4
+        && roi.chbegin == 0 && roi.chend == src.nchannels()
+        && dynamic_cast<const ColorProcessor_sRGB_to_linear*>(processor)) {
+        if (src.spec().format == TypeUInt8)
+            return colorconvert_impl_srgb_lut<unsigned char>(dst, src, roi,
+                                                             nthreads);
+        if (src.spec().format == TypeUInt16)
+            return colorconvert_impl_srgb_lut<unsigned short>(dst, src, roi,
+                                                              nthreads);
+        if (src.spec().format == TypeHalf)
+            return colorconvert_impl_srgb_lut<half>(dst, src, roi, nthreads);
+    }
+
     if (dst.localpixels() && src.localpixels() && dst.spec().format == TypeFloat
         && src.spec().format == TypeFloat && dst.nchannels() == 4
         && src.nchannels() == 4) {
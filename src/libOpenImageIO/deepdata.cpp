@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <numeric>
 
 #include <OpenImageIO/half.h>
@@ -13,18 +14,33 @@
 #include <OpenImageIO/deepdata.h>
 #include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/thread.h>
 
+#include "imageio_pvt.h"
+
+
 OIIO_NAMESPACE_BEGIN
 
+namespace pvt {
+// Global tally of DeepData sample storage, for the
+// getattribute("memory:deepdata") telemetry.
+atomic_ll DD_mem_current(0);
+}  // namespace pvt
+
 
 // Each pixel has a capacity (number of samples allocated) and a number of
 // samples currently used. Erasing samples only reduces the samples in the
 // pixels without changing the capacity, so there is no reallocation or data
 // movement except for that pixel. Samples can be added without any
 // reallocation or copying data (other than that one pixel) unless the
-// capacity of the pixel is exceeded. Furthermore, only changes in capacity
+// capacity of the pixel is exceeded. When a pixel does outgrow its capacity
+// after allocation, its samples move to a run carved from pooled overflow
+// chunks rather than shifting the tail of the main data block, so growth
+// costs only that one pixel's data and every other pixel's samples stay at
+// stable addresses; compact() folds the overflow runs back into one
+// contiguous block. Furthermore, only changes in capacity
 // need to lock the mutex. As long as capacity is not changing, threads may
 // change number of samples (inserting or deleting) as well as altering
 // data, simultaneously, as long as they are working on separate pixels.
@@ -43,6 +59,12 @@ public:
     std::vector<unsigned int>
         m_cumcapacity;         // cumulative capacity before pixel [p]
     std::vector<char> m_data;  // for each sample [p][s][c]
+    std::vector<std::vector<char>>
+        m_chunks;        // pooled overflow chunks for grown pixels
+    size_t m_chunkused;  // bytes used in m_chunks.back()
+    std::vector<char*> m_pixelptr;  // per-pixel overflow run, or null if
+                                    // the pixel still lives in m_data
+                                    // (empty until a pixel first grows)
     std::vector<std::string> m_channelnames;  // For each channel[c]
     std::vector<int> m_myalphachannel;        // For each channel[c], its alpha
         // myalphachannel[c] gives the alpha channel corresponding to channel
@@ -56,6 +78,7 @@ public:
     int m_AB_channel;
     bool m_allocated;
     spin_mutex m_mutex;
+    size_t m_trackedmem = 0;  // bytes reported to pvt::DD_mem_current
 
     Impl()
         : m_allocated(false)
@@ -63,6 +86,21 @@ public:
         clear();
     }
 
+    ~Impl() { pvt::DD_mem_current -= int64_t(m_trackedmem); }
+
+    // Re-tally the bytes held by the big allocations (the contiguous
+    // sample block and the overflow chunks) and report the change to the
+    // global deep-data memory counter, so that per-subsystem telemetry
+    // (getattribute("memory:deepdata")) can attribute residency.
+    void track_mem()
+    {
+        size_t now = m_data.capacity();
+        for (auto& c : m_chunks)
+            now += c.capacity();
+        pvt::DD_mem_current += int64_t(now) - int64_t(m_trackedmem);
+        m_trackedmem = now;
+    }
+
     void clear()
     {
         m_channeltypes.clear();
@@ -72,6 +110,9 @@ public:
         m_capacity.clear();
         m_cumcapacity.clear();
         m_data.clear();
+        m_chunks.clear();
+        m_chunkused = 0;
+        m_pixelptr.clear();
         m_channelnames.clear();
         m_myalphachannel.clear();
         m_samplesize    = 0;
@@ -82,6 +123,7 @@ public:
         m_AG_channel    = -1;
         m_AB_channel    = -1;
         m_allocated     = false;
+        track_mem();
     }
 
     // If not already done, allocate data and cumcapacity
@@ -97,29 +139,82 @@ public:
                     totalcapacity += m_capacity[i];
                 }
                 m_data.resize(totalcapacity * m_samplesize);
+                // Size the overflow-run pointer table now (all null), so
+                // that later capacity growth only stores into an existing
+                // slot and never resizes the table while other threads
+                // may be computing other pixels' addresses.
+                m_pixelptr.assign(npixels, nullptr);
                 m_allocated = true;
+                track_mem();
             }
         }
     }
 
-    size_t data_offset(int64_t pixel, int channel, int sample)
+    // Address of the first sample of the pixel -- in its overflow run if
+    // the pixel has outgrown its original capacity, otherwise at its spot
+    // in the contiguous m_data block.
+    char* pixel_base(int64_t pixel)
+    {
+        OIIO_DASSERT(int64_t(m_cumcapacity.size()) > pixel);
+        if (m_pixelptr.size() && m_pixelptr[pixel])
+            return m_pixelptr[pixel];
+        return m_data.data() + m_cumcapacity[pixel] * m_samplesize;
+    }
+
+    void* data_ptr(int64_t pixel, int channel, int sample)
     {
-        OIIO_DASSERT(int(m_cumcapacity.size()) > pixel);
         OIIO_DASSERT(m_capacity[pixel] >= m_nsamples[pixel]);
-        return (m_cumcapacity[pixel] + sample) * m_samplesize
+        return pixel_base(pixel) + sample * m_samplesize
                + m_channeloffsets[channel];
     }
 
-    void* data_ptr(int64_t pixel, int channel, int sample)
+    // Carve `bytes` from the pooled overflow chunks, starting a new chunk
+    // when the current one can't fit the run. Runs never span chunks and
+    // never move, so addresses handed out here are stable until compact()
+    // or clear(). Caller must hold the mutex.
+    char* arena_alloc(size_t bytes)
     {
-        size_t offset = data_offset(pixel, channel, sample);
-        OIIO_DASSERT(offset < m_data.size());
-        return &m_data[offset];
+        static const size_t chunkbytes = 1 << 20;  // allocation granularity
+        if (m_chunks.empty() || m_chunkused + bytes > m_chunks.back().size()) {
+            m_chunks.emplace_back(std::max(bytes, chunkbytes));
+            m_chunkused = 0;
+            track_mem();
+        }
+        char* ptr = m_chunks.back().data() + m_chunkused;
+        m_chunkused += bytes;
+        return ptr;
     }
 
-    size_t total_capacity() const
+    // Rebuild the contiguous m_data from the current sample counts,
+    // folding any overflow runs back in and squeezing out the holes left
+    // by erase_samples and by grown pixels. Afterward, every pixel's
+    // capacity exactly equals its sample count -- the layout wanted for
+    // final file output. Invalidates previously returned data pointers.
+    void compact(int64_t npixels)
     {
-        return m_cumcapacity.back() + m_capacity.back();
+        spin_lock lock(m_mutex);
+        if (!m_allocated)
+            return;
+        size_t totalsamples = 0;
+        for (int64_t p = 0; p < npixels; ++p)
+            totalsamples += m_nsamples[p];
+        if (m_chunks.empty() && totalsamples * m_samplesize == m_data.size())
+            return;  // Already compact
+        std::vector<char> newdata(totalsamples * m_samplesize);
+        size_t pos = 0;  // position so far, in samples
+        for (int64_t p = 0; p < npixels; ++p) {
+            size_t nbytes = size_t(m_nsamples[p]) * m_samplesize;
+            if (nbytes)
+                memcpy(&newdata[pos * m_samplesize], pixel_base(p), nbytes);
+            m_cumcapacity[p] = pos;
+            m_capacity[p]    = m_nsamples[p];
+            pos += m_nsamples[p];
+        }
+        std::swap(m_data, newdata);
+        m_chunks.clear();
+        m_chunkused = 0;
+        m_pixelptr.assign(m_pixelptr.size(), nullptr);
+        track_mem();
     }
 
     inline void sanity() const
@@ -130,7 +225,7 @@ public:
         int64_t npixels = int64_t(m_capacity.size());
         OIIO_ASSERT(m_nsamples.size() == m_capacity.size());
         OIIO_ASSERT(m_cumcapacity.size() == m_capacity.size());
-        if (m_allocated) {
+        if (m_allocated && m_chunks.empty()) {
             size_t totalcapacity = 0;
             for (int64_t p = 0; p < npixels; ++p) {
                 OIIO_ASSERT(m_cumcapacity[p] == totalcapacity);
@@ -138,6 +233,13 @@ public:
                 OIIO_ASSERT(m_capacity[p] >= m_nsamples[p]);
             }
             OIIO_ASSERT(totalcapacity * m_samplesize == m_data.size());
+        } else if (m_allocated) {
+            // Some pixels have moved to overflow runs; m_cumcapacity still
+            // describes the original contiguous layout, so only the
+            // per-pixel invariants hold.
+            OIIO_ASSERT(m_pixelptr.size() == m_capacity.size());
+            for (int64_t p = 0; p < npixels; ++p)
+                OIIO_ASSERT(m_capacity[p] >= m_nsamples[p]);
         }
     }
 };
@@ -171,6 +273,11 @@ DeepData::DeepData(const DeepData& src)
     m_npixels   = src.m_npixels;
     m_nchannels = src.m_nchannels;
     if (src.m_impl) {
+        // Fold any overflow runs in src back into its contiguous block so
+        // the member-wise Impl copy doesn't leave us pointing into src's
+        // chunks.
+        if (src.m_impl->m_chunks.size())
+            src.m_impl->compact(src.m_npixels);
         m_impl  = new Impl;
         *m_impl = *(src.m_impl);
     }
@@ -220,9 +327,11 @@ DeepData::operator=(const DeepData& d)
         m_nchannels = d.m_nchannels;
         if (!m_impl)
             m_impl = new Impl;
-        if (d.m_impl)
+        if (d.m_impl) {
+            if (d.m_impl->m_chunks.size())
+                d.m_impl->compact(d.m_npixels);
             *m_impl = *(d.m_impl);
-        else
+        } else
             m_impl->clear();
     }
     return *this;
@@ -511,19 +620,23 @@ DeepData::set_capacity(int64_t pixel, int samps)
         // contract. (FIXME?)
         int n = (int)capacity(pixel);
         if (samps > n) {
-            int toadd = samps - n;
-            if (m_impl->m_data.empty()) {
-                size_t newtotal = (m_impl->total_capacity() + toadd);
-                m_impl->m_data.resize(newtotal * samplesize());
-            } else {
-                size_t offset = m_impl->data_offset(pixel, 0, n);
-                m_impl->m_data.insert(m_impl->m_data.begin() + offset,
-                                      toadd * samplesize(), 0);
-            }
-            // Adjust the cumulative prefix sum of samples for subsequent pixels
-            for (int64_t p = pixel + 1; p < m_npixels; ++p)
-                m_impl->m_cumcapacity[p] += toadd;
-            m_impl->m_capacity[pixel] = samps;
+            // Don't open a hole in m_data -- that shifts the tail and
+            // fixes up the prefix sums of every subsequent pixel, O(whole
+            // image) per growing pixel. Instead, move just this pixel's
+            // samples to a fresh run carved from a pooled overflow chunk;
+            // all other pixels' addresses are untouched. Grow with some
+            // headroom so a pixel that's appended to repeatedly (as deep
+            // mergers do) doesn't need a new run every time. The holes
+            // left behind are reclaimed by compact().
+            int newcap = std::max(samps, n + n / 2);
+            char* run     = m_impl->arena_alloc(size_t(newcap) * samplesize());
+            size_t nbytes = size_t(m_impl->m_nsamples[pixel]) * samplesize();
+            if (nbytes)
+                memcpy(run, m_impl->pixel_base(pixel), nbytes);
+            if (m_impl->m_pixelptr.empty())
+                m_impl->m_pixelptr.resize(m_npixels, nullptr);
+            m_impl->m_pixelptr[pixel] = run;
+            m_impl->m_capacity[pixel] = newcap;
         }
     } else {
         m_impl->m_capacity[pixel] = samps;
@@ -595,13 +708,13 @@ DeepData::insert_samples(int64_t pixel, int samplepos, int n)
     // the pixel without a lock, we presume that if multiple threads are
     // in play, they are working on separate pixels.
     if (m_impl->m_allocated) {
-        // Move the data
+        // Move the data within the pixel's run
         if (samplepos < oldsamps) {
-            size_t offset = m_impl->data_offset(pixel, 0, samplepos);
-            size_t end    = m_impl->data_offset(pixel, 0, oldsamps);
-            std::copy_backward(m_impl->m_data.begin() + offset,
-                               m_impl->m_data.begin() + end,
-                               m_impl->m_data.begin() + end + n * samplesize());
+            size_t samplebytes = samplesize();
+            char* base         = m_impl->pixel_base(pixel);
+            memmove(base + (samplepos + n) * samplebytes,
+                    base + samplepos * samplebytes,
+                    (oldsamps - samplepos) * samplebytes);
         }
     }
     // Add to this pixel's sample count
@@ -618,19 +731,28 @@ DeepData::erase_samples(int64_t pixel, int samplepos, int n)
     // change the capacity, no lock is needed.
     n = std::min(n, int(m_impl->m_nsamples[pixel]));
     if (m_impl->m_allocated) {
-        // Move the data
-        int oldsamps  = samples(pixel);
-        size_t offset = m_impl->data_offset(pixel, 0, samplepos);
-        size_t end    = m_impl->data_offset(pixel, 0, oldsamps);
-        std::copy(m_impl->m_data.begin() + offset + n * samplesize(),
-                  m_impl->m_data.begin() + end,
-                  m_impl->m_data.begin() + offset);
+        // Move the data within the pixel's run
+        int oldsamps       = samples(pixel);
+        size_t samplebytes = samplesize();
+        char* base         = m_impl->pixel_base(pixel);
+        memmove(base + samplepos * samplebytes,
+                base + (samplepos + n) * samplebytes,
+                (oldsamps - samplepos - n) * samplebytes);
     }
     m_impl->m_nsamples[pixel] -= n;
 }
 
 
 
+void
+DeepData::compact()
+{
+    if (m_impl)
+        m_impl->compact(m_npixels);
+}
+
+
+
 void*
 DeepData::data_ptr(int64_t pixel, int channel, int sample)
 {
@@ -647,8 +769,8 @@ const void*
 DeepData::data_ptr(int64_t pixel, int channel, int sample) const
 {
     if (pixel < 0 || pixel >= m_npixels || channel < 0 || channel >= m_nchannels
-        || !m_impl || !m_impl->m_data.size() || sample < 0
-        || sample >= int(m_impl->m_nsamples[pixel]))
+        || !m_impl || !(m_impl->m_data.size() || m_impl->m_chunks.size())
+        || sample < 0 || sample >= int(m_impl->m_nsamples[pixel]))
         return NULL;
     return m_impl->data_ptr(pixel, channel, sample);
 }
@@ -844,6 +966,10 @@ DeepData::all_data() const
 {
     OIIO_DASSERT(m_impl);
     m_impl->alloc(m_npixels);
+    // If any pixels have overflowed into pooled runs, fold them back in
+    // so that the span we return really covers all the data.
+    if (m_impl->m_chunks.size())
+        m_impl->compact(m_npixels);
     return m_impl->m_data;
 }
 
@@ -853,16 +979,44 @@ void
 DeepData::get_pointers(std::vector<void*>& pointers) const
 {
     OIIO_DASSERT(m_impl);
-    m_impl->alloc(m_npixels);
     pointers.resize(pixels() * channels());
-    for (int64_t i = 0; i < m_npixels; ++i) {
-        if (m_impl->m_nsamples[i])
+    get_pointers(0, m_npixels, pointers);
+}
+
+
+
+void
+DeepData::get_pointers(int64_t pixbegin, int64_t pixend,
+                       span<void*> pointers) const
+{
+    OIIO_DASSERT(m_impl);
+    OIIO_DASSERT(pixbegin >= 0 && pixbegin <= pixend && pixend <= m_npixels);
+    OIIO_DASSERT(pointers.size()
+                 >= size_t(pixend - pixbegin) * size_t(m_nchannels));
+    m_impl->alloc(m_npixels);
+    // Compute the addresses directly rather than calling data_ptr() for
+    // every pixel/channel -- for a big deep image, the per-call index
+    // arithmetic and range checks add up to a significant fix-up pass.
+    char* data                      = m_impl->m_data.data();
+    const unsigned int* nsamples    = m_impl->m_nsamples.data();
+    const unsigned int* cumcapacity = m_impl->m_cumcapacity.data();
+    const size_t* chanoffsets       = m_impl->m_channeloffsets.data();
+    const size_t samplebytes        = m_impl->m_samplesize;
+    char* const* pixelptr = m_impl->m_pixelptr.empty()
+                                ? nullptr
+                                : m_impl->m_pixelptr.data();
+    void** p              = pointers.data();
+    for (int64_t i = pixbegin; i < pixend; ++i) {
+        if (nsamples[i]) {
+            char* base = (pixelptr && pixelptr[i])
+                             ? pixelptr[i]
+                             : data + cumcapacity[i] * samplebytes;
             for (int c = 0; c < m_nchannels; ++c)
-                pointers[i * m_nchannels + c] = (void*)m_impl->data_ptr(i, c,
-                                                                        0);
-        else
+                *p++ = base + chanoffsets[c];
+        } else {
             for (int c = 0; c < m_nchannels; ++c)
-                pointers[i * m_nchannels + c] = NULL;
+                *p++ = NULL;
+        }
     }
 }
 
@@ -1094,6 +1248,21 @@ DeepData::sort(int64_t pixel)
 
 
 
+void
+DeepData::sort()
+{
+    if (m_impl->m_z_channel < 0)
+        return;  // No channel labeled Z -- we don't know what to do
+    // Force allocation up front so it doesn't happen lazily (under its
+    // lock) inside the parallel loop. After this, each pixel's samples
+    // occupy disjoint memory, so the per-pixel sorts are independent.
+    m_impl->alloc(m_npixels);
+    parallel_for(int64_t(0), m_npixels,
+                 [this](int64_t pixel) { sort(pixel); });
+}
+
+
+
 void
 DeepData::merge_overlaps(int64_t pixel)
 {
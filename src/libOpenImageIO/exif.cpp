@@ -19,6 +19,7 @@
 #include <OpenImageIO/tiffutils.h>
 
 #include "exif.h"
+#include "imageio_pvt.h"
 
 OIIO_NAMESPACE_BEGIN
 
@@ -1152,15 +1153,12 @@ decode_exif(string_view exif, ImageSpec& spec)
 
 
 
-bool
-decode_exif(cspan<uint8_t> exif, ImageSpec& spec)
+// The working half of decode_exif: walk all the IFDs (and any MakerNote)
+// and materialize their tags as attributes in the spec.  `exif` must
+// already have any "Exif" prefix stripped.
+static bool
+decode_exif_eager(cspan<uint8_t> exif, ImageSpec& spec)
 {
-    // Sometimes an exif blob starts with "Exif". Skip it.
-    if (exif.size() >= 6 && exif[0] == 'E' && exif[1] == 'x' && exif[2] == 'i'
-        && exif[3] == 'f' && exif[4] == 0 && exif[5] == 0) {
-        exif = exif.subspan(6);
-    }
-
 #if DEBUG_EXIF_READ
     std::cerr << "Exif dump:\n";
     for (size_t i = 0; i < std::min(200L, exif.size()); ++i) {
@@ -1240,6 +1238,53 @@ decode_exif(cspan<uint8_t> exif, ImageSpec& spec)
 
 
 
+bool
+decode_exif(cspan<uint8_t> exif, ImageSpec& spec)
+{
+    // Sometimes an exif blob starts with "Exif". Skip it.
+    if (exif.size() >= 6 && exif[0] == 'E' && exif[1] == 'x' && exif[2] == 'i'
+        && exif[3] == 'f' && exif[4] == 0 && exif[5] == 0) {
+        exif = exif.subspan(6);
+    }
+
+    if (pvt::oiio_lazy_exif) {
+        // Lazy mode ("exif:lazy" global attribute): don't walk the IFDs
+        // at all.  Just sanity check the TIFF header magic so obviously
+        // malformed blobs are still rejected, then stash the raw block in
+        // the spec for materialize_exif() to decode if and when somebody
+        // actually wants the metadata.
+        if (exif.size() < sizeof(TIFFHeader))
+            return false;
+        const TIFFHeader* head = (const TIFFHeader*)exif.data();
+        if (head->tiff_magic != 0x4949 && head->tiff_magic != 0x4d4d)
+            return false;
+        spec.attribute("oiio:RawExif",
+                       TypeDesc(TypeDesc::UINT8, int(exif.size())),
+                       exif.data());
+        return true;
+    }
+
+    return decode_exif_eager(exif, spec);
+}
+
+
+
+bool
+materialize_exif(ImageSpec& spec)
+{
+    ParamValue* p = spec.find_attribute("oiio:RawExif");
+    if (!p || p->type().basetype != TypeDesc::UINT8 || !p->type().is_array())
+        return false;
+    // Copy the blob aside before erasing its stash, since decoding will
+    // add (possibly many) attributes to the spec.
+    std::vector<uint8_t> blob((const uint8_t*)p->data(),
+                              (const uint8_t*)p->data() + p->type().arraylen);
+    spec.erase_attribute("oiio:RawExif");
+    return decode_exif_eager(blob, spec);
+}
+
+
+
 // DEPRECATED (1.8)
 bool
 decode_exif(const void* exif, int length, ImageSpec& spec)
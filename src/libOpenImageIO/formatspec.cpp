@@ -1182,6 +1182,304 @@ ImageSpec::from_xml(const char* xml)
 
 
 
+namespace {  // Helper classes for to_blob() and from_blob() methods.
+
+// Version of the binary blob layout. Bump it whenever the layout changes;
+// from_blob() rejects blobs with a version it doesn't understand.
+constexpr uint32_t spec_blob_version = 1;
+// Every blob starts with these four bytes: "OIsp"
+constexpr uint32_t spec_blob_magic = uint32_t('O') | (uint32_t('I') << 8)
+                                     | (uint32_t('s') << 16)
+                                     | (uint32_t('p') << 24);
+
+
+// Append little-endian scalars, strings, and TypeDescs to a byte buffer.
+class BlobWriter {
+public:
+    BlobWriter(std::vector<char>& buf)
+        : m_buf(buf)
+    {
+    }
+    void write_raw(const void* data, size_t size)
+    {
+        m_buf.insert(m_buf.end(), (const char*)data, (const char*)data + size);
+    }
+    template<typename T> void write(T val)
+    {
+        static_assert(std::is_arithmetic<T>::value, "scalar writes only");
+        if (bigendian())
+            swap_endian(&val);
+        write_raw(&val, sizeof(T));
+    }
+    void write_string(string_view s)
+    {
+        write(uint32_t(s.size()));
+        write_raw(s.data(), s.size());
+    }
+    void write_type(TypeDesc t)
+    {
+        write(uint8_t(t.basetype));
+        write(uint8_t(t.aggregate));
+        write(uint8_t(t.vecsemantics));
+        write(uint8_t(0));  // reserved
+        write(int32_t(t.arraylen));
+    }
+    // Write nvals scalar values of basesize bytes apiece, byte swapping to
+    // little-endian if this is a big-endian host.
+    void write_values(const void* data, size_t nvals, size_t basesize)
+    {
+        if (littleendian() || basesize == 1) {
+            write_raw(data, nvals * basesize);
+        } else {
+            std::vector<char> tmp((const char*)data,
+                                  (const char*)data + nvals * basesize);
+            if (basesize == 2)
+                swap_endian((uint16_t*)tmp.data(), int(nvals));
+            else if (basesize == 4)
+                swap_endian((uint32_t*)tmp.data(), int(nvals));
+            else if (basesize == 8)
+                swap_endian((uint64_t*)tmp.data(), int(nvals));
+            write_raw(tmp.data(), tmp.size());
+        }
+    }
+
+private:
+    std::vector<char>& m_buf;
+};
+
+
+// Mirror image of BlobWriter: consume a byte buffer, bounds-checking every
+// read. Any overrun latches m_ok to false and subsequent reads return
+// zeroes, so callers can defer error checks until convenient.
+class BlobReader {
+public:
+    BlobReader(cspan<char> buf)
+        : m_buf(buf)
+    {
+    }
+    bool ok() const { return m_ok; }
+    size_t remaining() const { return size_t(m_buf.size()) - m_pos; }
+    bool read_raw(void* data, size_t size)
+    {
+        if (size > remaining()) {
+            m_ok = false;
+            return false;
+        }
+        memcpy(data, m_buf.data() + m_pos, size);
+        m_pos += size;
+        return true;
+    }
+    template<typename T> T read()
+    {
+        T val = T(0);
+        if (read_raw(&val, sizeof(T)) && bigendian())
+            swap_endian(&val);
+        return m_ok ? val : T(0);
+    }
+    std::string read_string()
+    {
+        uint32_t len = read<uint32_t>();
+        std::string s;
+        if (m_ok && len) {
+            if (len <= remaining()) {
+                s.resize(len);
+                read_raw(&s[0], len);
+            } else {
+                m_ok = false;
+            }
+        }
+        return s;
+    }
+    TypeDesc read_type()
+    {
+        uint8_t bt = read<uint8_t>();
+        uint8_t ag = read<uint8_t>();
+        uint8_t vs = read<uint8_t>();
+        read<uint8_t>();  // reserved
+        int32_t alen = read<int32_t>();
+        return TypeDesc(TypeDesc::BASETYPE(bt), TypeDesc::AGGREGATE(ag),
+                        TypeDesc::VECSEMANTICS(vs), alen);
+    }
+    bool read_values(void* data, size_t nvals, size_t basesize)
+    {
+        if (!read_raw(data, nvals * basesize))
+            return false;
+        if (bigendian()) {
+            if (basesize == 2)
+                swap_endian((uint16_t*)data, int(nvals));
+            else if (basesize == 4)
+                swap_endian((uint32_t*)data, int(nvals));
+            else if (basesize == 8)
+                swap_endian((uint64_t*)data, int(nvals));
+        }
+        return true;
+    }
+
+private:
+    cspan<char> m_buf;
+    size_t m_pos = 0;
+    bool m_ok    = true;
+};
+
+
+void
+pvl_to_blob(BlobWriter& out, const ParamValueList& pvl)
+{
+    out.write(uint32_t(pvl.size()));
+    for (const ParamValue& p : pvl) {
+        out.write_string(p.name());
+        out.write_type(p.type());
+        out.write(int32_t(p.nvalues()));
+        out.write(uint8_t(p.interp()));
+        TypeDesc t   = p.type();
+        size_t nbase = size_t(p.nvalues()) * t.basevalues();
+        if (t.basetype == TypeDesc::STRING) {
+            // Strings are stored by content, not by pointer.
+            const ustring* s = (const ustring*)p.data();
+            for (size_t i = 0; i < nbase; ++i)
+                out.write_string(s[i]);
+        } else if (t.basetype == TypeDesc::USTRINGHASH) {
+            // Also by content -- raw hashes would not be resolvable in the
+            // receiving process's ustring table.
+            const ustringhash* s = (const ustringhash*)p.data();
+            for (size_t i = 0; i < nbase; ++i)
+                out.write_string(ustring(s[i]));
+        } else {
+            out.write_values(p.data(), nbase, t.basesize());
+        }
+    }
+}
+
+
+bool
+pvl_from_blob(BlobReader& in, ParamValueList& pvl)
+{
+    uint32_t nattribs = in.read<uint32_t>();
+    for (uint32_t a = 0; a < nattribs && in.ok(); ++a) {
+        ustring name(in.read_string());
+        TypeDesc type = in.read_type();
+        int nvalues   = in.read<int32_t>();
+        auto interp   = ParamValue::Interp(in.read<uint8_t>());
+        if (!in.ok() || nvalues < 0)
+            return false;
+        size_t nbase = size_t(nvalues) * type.basevalues();
+        if (type.basetype == TypeDesc::STRING) {
+            std::vector<ustring> strs(nbase);
+            for (size_t i = 0; i < nbase && in.ok(); ++i)
+                strs[i] = ustring(in.read_string());
+            if (!in.ok())
+                return false;
+            pvl.emplace_back(name, type, nvalues, interp, strs.data());
+        } else if (type.basetype == TypeDesc::USTRINGHASH) {
+            std::vector<ustringhash> strs(nbase);
+            for (size_t i = 0; i < nbase && in.ok(); ++i)
+                strs[i] = ustring(in.read_string()).uhash();
+            if (!in.ok())
+                return false;
+            pvl.emplace_back(name, type, nvalues, interp, strs.data());
+        } else {
+            size_t basesize = type.basesize();
+            if (nbase * basesize > in.remaining())
+                return false;  // can't possibly be enough data left
+            std::unique_ptr<char[]> data(new char[nbase * basesize]);
+            if (!in.read_values(data.get(), nbase, basesize))
+                return false;
+            pvl.emplace_back(name, type, nvalues, interp, data.get());
+        }
+    }
+    return in.ok();
+}
+
+}  // namespace
+
+
+
+std::vector<char>
+ImageSpec::to_blob() const
+{
+    std::vector<char> blob;
+    blob.reserve(256 + 64 * extra_attribs.size());
+    BlobWriter out(blob);
+    out.write(spec_blob_magic);
+    out.write(spec_blob_version);
+    out.write(int32_t(x));
+    out.write(int32_t(y));
+    out.write(int32_t(z));
+    out.write(int32_t(width));
+    out.write(int32_t(height));
+    out.write(int32_t(depth));
+    out.write(int32_t(full_x));
+    out.write(int32_t(full_y));
+    out.write(int32_t(full_z));
+    out.write(int32_t(full_width));
+    out.write(int32_t(full_height));
+    out.write(int32_t(full_depth));
+    out.write(int32_t(tile_width));
+    out.write(int32_t(tile_height));
+    out.write(int32_t(tile_depth));
+    out.write(int32_t(nchannels));
+    out.write_type(format);
+    out.write(int32_t(alpha_channel));
+    out.write(int32_t(z_channel));
+    out.write(uint8_t(deep));
+    out.write(uint32_t(channelformats.size()));
+    for (TypeDesc f : channelformats)
+        out.write_type(f);
+    out.write(uint32_t(channelnames.size()));
+    for (const std::string& n : channelnames)
+        out.write_string(n);
+    pvl_to_blob(out, extra_attribs);
+    return blob;
+}
+
+
+
+bool
+ImageSpec::from_blob(cspan<char> blob)
+{
+    BlobReader in(blob);
+    if (in.read<uint32_t>() != spec_blob_magic
+        || in.read<uint32_t>() != spec_blob_version)
+        return false;
+
+    // Accumulate into a temporary so a malformed blob can't leave *this
+    // half modified.
+    ImageSpec spec;
+    spec.x             = in.read<int32_t>();
+    spec.y             = in.read<int32_t>();
+    spec.z             = in.read<int32_t>();
+    spec.width         = in.read<int32_t>();
+    spec.height        = in.read<int32_t>();
+    spec.depth         = in.read<int32_t>();
+    spec.full_x        = in.read<int32_t>();
+    spec.full_y        = in.read<int32_t>();
+    spec.full_z        = in.read<int32_t>();
+    spec.full_width    = in.read<int32_t>();
+    spec.full_height   = in.read<int32_t>();
+    spec.full_depth    = in.read<int32_t>();
+    spec.tile_width    = in.read<int32_t>();
+    spec.tile_height   = in.read<int32_t>();
+    spec.tile_depth    = in.read<int32_t>();
+    spec.nchannels     = in.read<int32_t>();
+    spec.format        = in.read_type();
+    spec.alpha_channel = in.read<int32_t>();
+    spec.z_channel     = in.read<int32_t>();
+    spec.deep          = bool(in.read<uint8_t>());
+    uint32_t nformats  = in.read<uint32_t>();
+    for (uint32_t i = 0; i < nformats && in.ok(); ++i)
+        spec.channelformats.push_back(in.read_type());
+    uint32_t nnames = in.read<uint32_t>();
+    for (uint32_t i = 0; i < nnames && in.ok(); ++i)
+        spec.channelnames.push_back(in.read_string());
+    if (!pvl_from_blob(in, spec.extra_attribs) || !in.ok())
+        return false;
+
+    *this = std::move(spec);
+    return true;
+}
+
+
+
 std::pair<string_view, int>
 ImageSpec::decode_compression_metadata(string_view defaultcomp,
                                        int defaultqual) const
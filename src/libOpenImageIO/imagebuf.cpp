@@ -3,13 +3,20 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 
+#if defined(__linux__) || defined(__APPLE__)
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
 #include <OpenImageIO/half.h>
 
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/deepdata.h>
+#include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
@@ -31,6 +38,11 @@ OIIO_STRONG_PARAM_TYPE(DoLock, bool);
 namespace pvt {
 int imagebuf_print_uncaught_errors(1);
 int imagebuf_use_imagecache(0);
+int imagebuf_device_memory(0);
+int imagebuf_alloc_alignment(0);
+int imagebuf_alloc_hugepages(0);
+int imagebuf_scratch_pool(0);
+int imagebuf_spill_MB(0);
 atomic_ll IB_local_mem_current;
 atomic_ll IB_local_mem_peak;
 std::atomic<float> IB_total_open_time(0.0f);
@@ -84,6 +96,152 @@ set_roi_full(ImageSpec& spec, const ROI& newroi)
 
 
 
+// Deleter that remembers which allocator produced the pixel memory:
+// plain new[], aligned_alloc, an mmap-ed spill file, or the compute
+// device's unified allocator.
+struct PixelDeleter {
+    bool device   = false;
+    bool aligned  = false;
+    size_t mapped = 0;  // If nonzero, memory is an mmap of this many bytes
+    void operator()(char* p) const
+    {
+#if defined(__linux__) || defined(__APPLE__)
+        if (mapped) {
+            munmap(p, mapped);
+            return;
+        }
+#endif
+        if (device)
+            pvt::device_free(p);
+        else if (aligned)
+            free(p);
+        else
+            delete[] p;
+    }
+};
+using PixelStorage = std::unique_ptr<char[], PixelDeleter>;
+
+
+// Map an unlinked temporary file of the given size as writable memory, so
+// that rarely touched parts of a larger-than-RAM buffer can be paged out to
+// the filesystem instead of exhausting physical memory and swap. Returns
+// nullptr (and the caller falls back to ordinary allocation) on any
+// failure, or on platforms without mmap.
+static char*
+map_spill_file(size_t size)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    std::string pattern = Filesystem::temp_directory_path()
+                          + "/oiio-spill-XXXXXX";
+    int fd = mkstemp(&pattern[0]);
+    if (fd < 0)
+        return nullptr;
+    // Unlink right away: the mapping keeps the storage alive, and the file
+    // can't be leaked if we crash.
+    ::unlink(pattern.c_str());
+    if (ftruncate(fd, off_t(size)) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return p == MAP_FAILED ? nullptr : (char*)p;
+#else
+    return nullptr;
+#endif
+}
+
+
+
+// Process-wide recycling pool for local pixel allocations, enabled by
+// setting the "imagebuf:scratch_pool" attribute to a byte budget in MB.
+// When enabled, freed pixel blocks are parked here and same-sized requests
+// are satisfied from the pool, so processing chains that repeatedly destroy
+// and recreate same-shaped ImageBufs (e.g. oiiotool's per-op results) skip
+// both the allocator and first-touch page faulting of fresh pages. Blocks
+// keep their deleter, so each is eventually returned to the allocator that
+// made it. Device-memory blocks are never pooled.
+class ScratchPool {
+public:
+    // Fetch a pooled block of exactly this size and alignment flavor, or
+    // an empty PixelStorage if none is available.
+    PixelStorage get(size_t size, size_t align, bool aligned)
+    {
+        spin_lock lock(m_mutex);
+        for (size_t i = m_blocks.size(); i-- > 0;) {
+            Entry& e(m_blocks[i]);
+            if (e.size == size && e.mem.get_deleter().aligned == aligned
+                && (!align || !(uintptr_t(e.mem.get()) & (align - 1)))) {
+                PixelStorage p = std::move(e.mem);
+                m_bytes -= e.size;
+                m_blocks.erase(m_blocks.begin() + i);
+                return p;
+            }
+        }
+        return {};
+    }
+
+    // Offer a block to the pool. If it doesn't fit the budget, the oldest
+    // blocks are dropped first; if it still doesn't fit, it's simply freed
+    // when the moved-from storage goes out of scope.
+    void put(PixelStorage&& block, size_t size)
+    {
+        size_t budget = size_t(std::max(0, pvt::imagebuf_scratch_pool)) << 20;
+        std::vector<Entry> discard;  // deallocate outside the lock
+        {
+            spin_lock lock(m_mutex);
+            while (m_blocks.size()
+                   && (m_bytes + size > budget
+                       || m_blocks.size() >= max_blocks)) {
+                m_bytes -= m_blocks.front().size;
+                discard.push_back(std::move(m_blocks.front()));
+                m_blocks.erase(m_blocks.begin());
+            }
+            if (size && size <= budget) {
+                m_blocks.push_back({ std::move(block), size });
+                m_bytes += size;
+            }
+        }
+    }
+
+    // Free pooled blocks until total held bytes <= the current budget.
+    // Called when the budget attribute is lowered.
+    void trim()
+    {
+        size_t budget = size_t(std::max(0, pvt::imagebuf_scratch_pool)) << 20;
+        std::vector<Entry> discard;
+        {
+            spin_lock lock(m_mutex);
+            while (m_blocks.size() && m_bytes > budget) {
+                m_bytes -= m_blocks.front().size;
+                discard.push_back(std::move(m_blocks.front()));
+                m_blocks.erase(m_blocks.begin());
+            }
+        }
+    }
+
+private:
+    static constexpr size_t max_blocks = 64;
+    struct Entry {
+        PixelStorage mem;
+        size_t size;
+    };
+    spin_mutex m_mutex;
+    std::vector<Entry> m_blocks;  // few entries; linear scan is fine
+    size_t m_bytes = 0;
+};
+
+static ScratchPool imagebuf_scratch;
+
+
+void
+pvt::imagebuf_scratch_pool_trim()
+{
+    imagebuf_scratch.trim();
+}
+
+
+
 // Expansion of the opaque type that hides all the ImageBuf implementation
 // detail.
 class ImageBufImpl {
@@ -284,8 +442,8 @@ private:
     mutable int m_threads;          ///< thread policy for this image
     ImageSpec m_spec;               ///< Describes the image (size, etc)
     ImageSpec m_nativespec;         ///< Describes the true native image
-    std::unique_ptr<char[]> m_pixels;  ///< Pixel data, if local and we own it
-    char* m_localpixels;               ///< Pointer to local pixels
+    PixelStorage m_pixels;  ///< Pixel data, if local and we own it
+    char* m_localpixels;    ///< Pointer to local pixels
     typedef std::recursive_mutex mutex_t;
     typedef std::unique_lock<mutex_t> lock_t;
     mutable mutex_t m_mutex;      ///< Thread safety for this ImageBuf
@@ -302,6 +460,9 @@ private:
     TypeDesc m_cachedpixeltype;          ///< Data type stored in the cache
     DeepData m_deepdata;                 ///< Deep data
     size_t m_allocated_size;             ///< How much memory we've allocated
+    PixelStorage m_spare_pixels;  ///< Recycled allocation stashed
+                                  ///<   by reset() for reuse
+    size_t m_spare_size = 0;      ///< Size of m_spare_pixels
     std::vector<char> m_blackpixel;      ///< Pixel-sized zero bytes
     std::vector<TypeDesc> m_write_format;  /// Pixel data format to use for write()
     int m_write_tile_width;
@@ -320,6 +481,15 @@ private:
     char* new_pixels(size_t size, const void* data = nullptr);
     // Private release of m_pixels.
     void free_pixels();
+    // Discard any recycled allocation stashed by reset().
+    void drop_spare_pixels()
+    {
+        if (m_spare_size) {
+            pvt::IB_local_mem_current -= m_spare_size;
+            m_spare_size = 0;
+            m_spare_pixels.reset();
+        }
+    }
 
     TypeDesc write_format(int channel = 0) const
     {
@@ -601,21 +771,106 @@ ImageBufImpl::new_pixels(size_t size, const void* data)
 {
     if (m_allocated_size)
         free_pixels();
-    try {
-        m_pixels.reset(size ? new char[size] : nullptr);
-    } catch (const std::exception& e) {
-        // Could not allocate enough memory. So don't allocate anything,
-        // consider this an uninitialized ImageBuf, issue an error, and hope
-        // it's handled well downstream.
-        m_pixels.reset();
-        OIIO::debugfmt("ImageBuf unable to allocate {} bytes ({})\n", size,
-                       e.what());
-        error("ImageBuf unable to allocate {} bytes ({})\n", size, e.what());
-        size = 0;
-    }
-    m_allocated_size = size;
-    pvt::IB_local_mem_current += m_allocated_size;
-    atomic_max(pvt::IB_local_mem_peak, (long long)pvt::IB_local_mem_current);
+    // Should this allocation live in the compute device's unified memory,
+    // so that GPU code can touch the pixels without a copy?
+    bool devmem = pvt::imagebuf_device_memory
+                  && pvt::compute_device() != pvt::ComputeDevice::CPU;
+    // Optional alignment policy: if "imagebuf:alloc_alignment" is set to a
+    // power of 2, allocate on that boundary so SIMD kernels see an aligned
+    // base address (and aligned scanlines, whenever the row size is a
+    // multiple of the alignment). If "imagebuf:alloc_hugepages" is set,
+    // large allocations are additionally aligned and advised for huge pages
+    // to cut TLB misses on big (e.g. 16K float) buffers.
+    size_t align = size_t(std::max(0, pvt::imagebuf_alloc_alignment));
+    if (align & (align - 1))
+        align = 0;  // not a power of 2: ignore the request
+    if (align && align < sizeof(void*))
+        align = sizeof(void*);
+    constexpr size_t hugepage_size = 2 * 1024 * 1024;
+    bool hugepages = pvt::imagebuf_alloc_hugepages && size >= hugepage_size;
+    if (hugepages && !devmem)
+        align = std::max(align, hugepage_size);
+    bool aligned = align != 0 && !devmem;
+    // Optional spill policy: if "imagebuf:spill_MB" is set, allocations of
+    // at least that many MB are backed by a memory-mapped temporary file,
+    // so that buffers bigger than physical RAM stay fully readable and
+    // writable with the OS paging to the filesystem instead of OOMing.
+    size_t spill_bytes = size_t(std::max(0, pvt::imagebuf_spill_MB)) << 20;
+    bool spill         = spill_bytes && size >= spill_bytes && !devmem;
+    if (size && size == m_spare_size
+        && m_spare_pixels.get_deleter().device == devmem
+        && m_spare_pixels.get_deleter().aligned == aligned
+        && (m_spare_pixels.get_deleter().mapped != 0) == spill) {
+        // Reuse the recycled allocation stashed by reset() -- it is
+        // exactly the size we need, came from the right allocator, and
+        // IB_local_mem_current still counts those bytes.
+        m_pixels         = std::move(m_spare_pixels);
+        m_spare_size     = 0;
+        m_allocated_size = size;
+    } else {
+        drop_spare_pixels();
+        PixelStorage acquired;
+        if (!devmem && !spill && pvt::imagebuf_scratch_pool)
+            acquired = imagebuf_scratch.get(size, align, aligned);
+        if (!acquired && spill && size) {
+            if (char* p = map_spill_file(size)) {
+                PixelDeleter del;
+                del.mapped = size;
+                acquired   = PixelStorage(p, del);
+            }
+            // On mapping failure (tmp full, or a platform without mmap),
+            // just fall through to an ordinary allocation.
+        }
+        if (acquired) {
+            m_pixels = std::move(acquired);
+        } else if (devmem) {
+            char* p = size ? (char*)pvt::device_unified_malloc(size) : nullptr;
+            if (size && !p) {
+                OIIO::debugfmt(
+                    "ImageBuf unable to allocate {} bytes of unified memory\n",
+                    size);
+                error("ImageBuf unable to allocate {} bytes of unified memory",
+                      size);
+                size = 0;
+            }
+            m_pixels = PixelStorage(p, PixelDeleter { true });
+        } else if (aligned) {
+            size_t asize = (size + align - 1) & ~(align - 1);
+            char* p      = size ? (char*)aligned_alloc(align, asize) : nullptr;
+            if (size && !p) {
+                OIIO::debugfmt(
+                    "ImageBuf unable to allocate {} bytes aligned to {}\n",
+                    size, align);
+                error("ImageBuf unable to allocate {} bytes aligned to {}",
+                      size, align);
+                size = 0;
+            }
+#if defined(__linux__)
+            if (p && hugepages)
+                madvise(p, asize, MADV_HUGEPAGE);
+#endif
+            m_pixels = PixelStorage(p, PixelDeleter { false, true });
+        } else {
+            try {
+                m_pixels = PixelStorage(size ? new char[size] : nullptr,
+                                        PixelDeleter { false });
+            } catch (const std::exception& e) {
+                // Could not allocate enough memory. So don't allocate
+                // anything, consider this an uninitialized ImageBuf, issue an
+                // error, and hope it's handled well downstream.
+                m_pixels.reset();
+                OIIO::debugfmt("ImageBuf unable to allocate {} bytes ({})\n",
+                               size, e.what());
+                error("ImageBuf unable to allocate {} bytes ({})\n", size,
+                      e.what());
+                size = 0;
+            }
+        }
+        m_allocated_size = size;
+        pvt::IB_local_mem_current += m_allocated_size;
+        atomic_max(pvt::IB_local_mem_peak,
+                   (long long)pvt::IB_local_mem_current);
+    }
     if (data && size)
         memcpy(m_pixels.get(), data, size);
     m_localpixels = m_pixels.get();
@@ -637,6 +892,9 @@ ImageBufImpl::free_pixels()
                            m_allocated_size >> 20,
                            pvt::IB_local_mem_current >> 20);
         pvt::IB_local_mem_current -= m_allocated_size;
+        if (m_pixels && pvt::imagebuf_scratch_pool
+            && !m_pixels.get_deleter().device && !m_pixels.get_deleter().mapped)
+            imagebuf_scratch.put(std::move(m_pixels), m_allocated_size);
         m_allocated_size = 0;
     }
     m_pixels.reset();
@@ -815,6 +1073,18 @@ ImageBufImpl::reset(string_view filename, const ImageSpec& spec,
                     const ImageSpec* nativespec, void* buffer, stride_t xstride,
                     stride_t ystride, stride_t zstride)
 {
+    // If we already own a local allocation of exactly the size the new
+    // spec needs, stash it across the clear() so that new_pixels() can
+    // reuse it rather than freeing and reallocating. This makes reset()
+    // to a same-footprint spec (e.g. recycled scratch buffers in an image
+    // processing chain) not touch the heap at all.
+    if (!buffer && m_storage == ImageBuf::LOCALBUFFER && m_pixels
+        && !m_spec.deep && !spec.deep
+        && m_allocated_size == spec.image_bytes()) {
+        m_spare_pixels   = std::move(m_pixels);
+        m_spare_size     = m_allocated_size;
+        m_allocated_size = 0;  // keep clear() from double-accounting
+    }
     clear();
     if (!spec.image_bytes()) {
         m_storage = ImageBuf::UNINITIALIZED;
@@ -947,6 +1217,21 @@ ImageBufImpl::init_spec(string_view filename, int subimage, int miplevel,
     if (m_imagecache == nullptr && pvt::imagebuf_use_imagecache)
         m_imagecache = ImageCache::create(true);
 
+    // A configuration hint of the same name overrides the global attribute
+    // for just this file. In particular, hinting 0 is a lightweight "peek"
+    // mode: the header is read directly with an ImageInput (below) and
+    // nothing is ever registered in the cache's file map, which is what
+    // you want when interrogating a large number of files only for their
+    // specs.
+    if (m_configspec) {
+        int uic = m_configspec->get_int_attribute("imagebuf:use_imagecache",
+                                                  -1);
+        if (uic == 0)
+            m_imagecache = nullptr;
+        else if (uic > 0 && m_imagecache == nullptr)
+            m_imagecache = ImageCache::create(true);
+    }
+
     if (m_imagecache) {
         m_pixels_valid = false;
         m_nsubimages   = 0;
@@ -1378,6 +1663,42 @@ ImageBuf::write(ImageOutput* out, ProgressCallback progress_callback,
         // immediately writing out a file from disk, possibly with file
         // format or data format conversion, but without any ImageBufAlgo
         // functions having been applied.
+
+        // Since the pixels are unmodified file data, check whether the
+        // source and destination have the same format, layout, and
+        // compression, and if so give the format writer a chance to move
+        // the compressed data across verbatim (OpenEXR copyPixels, TIFF
+        // raw strip/tile copy), skipping both codecs. This makes
+        // metadata-only rewraps of large files nearly free. If the writer
+        // has no such fast path or the attempt doesn't pan out, fall
+        // through to the ordinary copy below.
+        const ImageSpec& natspec(nativespec());
+        if (!outspec.deep && file_format_name() == out->format_name()
+            && outspec.format == natspec.format
+            && outspec.channelformats == natspec.channelformats
+            && outspec.nchannels == natspec.nchannels
+            && outspec.width == natspec.width
+            && outspec.height == natspec.height
+            && outspec.depth == natspec.depth
+            && outspec.tile_width == natspec.tile_width
+            && outspec.tile_height == natspec.tile_height
+            && outspec.tile_depth == natspec.tile_depth
+            && outspec.get_string_attribute("compression", "none")
+                   == natspec.get_string_attribute("compression", "none")) {
+            auto in = ImageInput::open(name());
+            if (in && in->seek_subimage(subimage(), miplevel())
+                && out->copy_image(in.get())) {
+                if (progress_callback)
+                    progress_callback(progress_callback_data, 1.0f);
+                return ok;
+            }
+            // Didn't work out -- eat any errors from the attempt and do
+            // the regular pixel copy.
+            (void)out->geterror();
+            if (in)
+                (void)in->geterror();
+        }
+
         const imagesize_t budget = 1024 * 1024 * 64;  // 64 MB
         imagesize_t imagesize    = bufspec.image_bytes();
         if (imagesize <= budget) {
@@ -3,12 +3,14 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 #include <cmath>
+#include <map>
 #include <memory>
 
 #include <OpenImageIO/half.h>
 
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/filter.h>
+#include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
@@ -357,6 +359,78 @@ ImageBufAlgo::type_merge(TypeDesc::BASETYPE a, TypeDesc::BASETYPE b)
 
 
 
+struct ImageBufAlgo::ImageBufPool::Impl {
+    spin_mutex mutex;
+    std::vector<std::unique_ptr<ImageBuf>> freelist;
+};
+
+
+ImageBufAlgo::ImageBufPool::ImageBufPool()
+    : m_impl(new Impl)
+{
+}
+
+
+ImageBufAlgo::ImageBufPool::~ImageBufPool() {}
+
+
+
+std::shared_ptr<ImageBuf>
+ImageBufAlgo::ImageBufPool::get(const ImageSpec& spec)
+{
+    std::unique_ptr<ImageBuf> buf;
+    {
+        spin_lock lock(m_impl->mutex);
+        auto& freelist = m_impl->freelist;
+        // Prefer a recycled buffer whose pixel allocation is exactly the
+        // footprint we need, so the reset() below reuses it without
+        // touching the heap. Failing that, take any idle buffer.
+        size_t needed = spec.image_bytes();
+        for (size_t i = 0, e = freelist.size(); i < e; ++i) {
+            if (freelist[i]->spec().image_bytes() == needed) {
+                buf = std::move(freelist[i]);
+                freelist.erase(freelist.begin() + i);
+                break;
+            }
+        }
+        if (!buf && freelist.size()) {
+            buf = std::move(freelist.back());
+            freelist.pop_back();
+        }
+    }
+    if (!buf)
+        buf.reset(new ImageBuf);
+    buf->reset(spec, InitializePixels::No);
+    // Hand out a shared_ptr whose deleter returns the buffer to the pool.
+    // The deleter holds the Impl, so releasing a buffer after the pool
+    // itself is destroyed just frees it.
+    std::shared_ptr<Impl> impl(m_impl);
+    return std::shared_ptr<ImageBuf>(buf.release(), [impl](ImageBuf* b) {
+        spin_lock lock(impl->mutex);
+        impl->freelist.emplace_back(b);
+    });
+}
+
+
+
+void
+ImageBufAlgo::ImageBufPool::clear()
+{
+    spin_lock lock(m_impl->mutex);
+    m_impl->freelist.clear();
+}
+
+
+
+size_t
+ImageBufAlgo::ImageBufPool::size() const
+{
+    spin_lock lock(m_impl->mutex);
+    return m_impl->freelist.size();
+}
+
+
+
 template<typename DSTTYPE, typename SRCTYPE>
 static bool
 convolve_(ImageBuf& dst, const ImageBuf& src, const ImageBuf& kernel,
@@ -401,6 +475,69 @@ convolve_(ImageBuf& dst, const ImageBuf& src, const ImageBuf& kernel,
 
 
 
+// Test whether 2D kernel K is numerically rank-1, i.e. the outer product
+// of a row vector and a column vector, as is true of Gaussian and the
+// other multiplicative filters that make_kernel produces. If so, fill
+// Krow (w x 1) and Kcol (1 x h) with factors such that
+// K(x,y) = Krow(x) * Kcol(y), and return true.
+static bool
+separable_kernel(const ImageBuf& K, ImageBuf& Krow, ImageBuf& Kcol)
+{
+    ROI kroi = K.roi();
+    if (kroi.width() < 2 || kroi.height() < 2 || kroi.depth() != 1
+        || K.nchannels() != 1)
+        return false;
+    int w          = kroi.width();
+    int h          = kroi.height();
+    const float* k = (const float*)K.localpixels();
+    OIIO_DASSERT(k && K.spec().format == TypeDesc::FLOAT);
+    // Find the element with the largest magnitude -- the pivot.
+    int px = 0, py = 0;
+    float maxabs = 0.0f;
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x) {
+            float a = fabsf(k[y * w + x]);
+            if (a > maxabs) {
+                maxabs = a;
+                px     = x;
+                py     = y;
+            }
+        }
+    if (!(maxabs > 0.0f))
+        return false;  // all-zero kernel
+    // If K is rank-1, then K(x,y) == K(x,py) * K(px,y) / K(px,py) for
+    // every element. Verify to within a small relative tolerance, so that
+    // kernels that are separable in exact arithmetic but were computed in
+    // float still pass.
+    float pivot = k[py * w + px];
+    float tol   = 1.0e-5f * maxabs;
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            if (fabsf(k[y * w + x] - k[py * w + x] * (k[y * w + px] / pivot))
+                > tol)
+                return false;
+    // Build the two 1D factors, keeping the kernel's pixel offsets so
+    // that convolve_ centers them the same way as the original. The
+    // pivot scaling goes entirely into the column factor.
+    ImageSpec rowspec(w, 1, 1, TypeDesc::FLOAT);
+    rowspec.x = rowspec.full_x = kroi.xbegin;
+    rowspec.full_width         = w;
+    Krow.reset(rowspec);
+    ImageSpec colspec(1, h, 1, TypeDesc::FLOAT);
+    colspec.y = colspec.full_y = kroi.ybegin;
+    colspec.full_height        = h;
+    Kcol.reset(colspec);
+    float* kr = (float*)Krow.localpixels();
+    for (int x = 0; x < w; ++x)
+        kr[x] = k[py * w + x];
+    float* kc = (float*)Kcol.localpixels();
+    for (int y = 0; y < h; ++y)
+        kc[y] = k[y * w + px] / pivot;
+    return true;
+}
+
+
+
 bool
 ImageBufAlgo::convolve(ImageBuf& dst, const ImageBuf& src,
                        const ImageBuf& kernel, bool normalize, ROI roi,
@@ -417,6 +554,36 @@ ImageBufAlgo::convolve(ImageBuf& dst, const ImageBuf& src,
         Ktmp.copy(kernel, TypeDesc::FLOAT);
         K = &Ktmp;
     }
+
+    // If the kernel is separable -- a rank-1 outer product of a row and a
+    // column, as Gaussian and friends are -- convolving with it is
+    // equivalent to a horizontal 1D pass followed by a vertical 1D pass:
+    // O(w+h) work per pixel instead of O(w*h). The horizontal pass must
+    // cover extra rows above and below the roi, since the vertical pass
+    // reaches that far into its input. The float intermediate also
+    // preserves precision for integer and half images.
+    ImageBuf Krow, Kcol;
+    if (separable_kernel(*K, Krow, Kcol)) {
+        ROI roi1 = roi;
+        roi1.ybegin += Kcol.roi().ybegin;
+        roi1.yend += Kcol.roi().yend - 1;
+        ImageBuf tmp;
+        if (IBAprep(roi1, &tmp, &src,
+                    IBAprep_REQUIRE_SAME_NCHANNELS
+                        | IBAprep_DST_FLOAT_PIXELS)) {
+            bool ok2;
+            OIIO_DISPATCH_COMMON_TYPES2(ok, "convolve", convolve_,
+                                        tmp.spec().format, src.spec().format,
+                                        tmp, src, Krow, normalize, roi1,
+                                        nthreads);
+            OIIO_DISPATCH_COMMON_TYPES2(ok2, "convolve", convolve_,
+                                        dst.spec().format, tmp.spec().format,
+                                        dst, tmp, Kcol, normalize, roi,
+                                        nthreads);
+            return ok && ok2;
+        }
+    }
+
     OIIO_DISPATCH_COMMON_TYPES2(ok, "convolve", convolve_, dst.spec().format,
                                 src.spec().format, dst, src, *K, normalize, roi,
                                 nthreads);
@@ -653,6 +820,135 @@ ImageBufAlgo::laplacian(const ImageBuf& src, ROI roi, int nthreads)
 
 
 
+// Constant-time median for 8-bit images, using the classic sliding
+// histogram technique: one 256-bin histogram per image column covering
+// the window's rows, merged into a window histogram that slides across
+// the scanline by adding the entering column and subtracting the leaving
+// one. Per-pixel cost is independent of the filter radius (a radius-15
+// median costs the same as radius-3), versus the generic path's
+// re-sort of the whole window for every pixel. A 16-bin coarse histogram
+// rides along so the median is found in at most 32 bin probes.
+// Border pixels skip samples outside the data window, matching the
+// a.exists() behavior of the generic implementation. Scanline bands are
+// distributed over the pool by parallel_image; each band initializes its
+// own column histograms.
+template<class Rtype>
+static bool
+median_filter_hist_(ImageBuf& R, const ImageBuf& A, int width, int height,
+                    ROI roi, int nthreads)
+{
+    using namespace ImageBufAlgo;
+    OIIO_DASSERT(A.localpixels() && A.spec().format == TypeDesc::UINT8);
+    if (width < 1)
+        width = 1;
+    if (height < 1)
+        height = width;
+    parallel_image(roi, nthreads, [&, width, height](ROI roi) {
+        int w_2    = std::max(1, width / 2);
+        int h_2    = std::max(1, height / 2);
+        ROI adata  = A.roi();
+        int xfirst = roi.xbegin - w_2;  // leftmost column any window needs
+        int ncols  = roi.width() + width;
+        std::vector<uint16_t> colhist(size_t(ncols) * 256, 0);
+        std::vector<uint16_t> colcount(ncols, 0);
+        uint32_t winfine[256], wincoarse[16];
+        auto colptr = [&](int i) { return &colhist[size_t(i) * 256]; };
+        auto sample = [&](int x, int y, int c) {
+            return ((const unsigned char*)A.pixeladdr(x, y, roi.zbegin))[c];
+        };
+        for (int c = roi.chbegin; c < roi.chend; ++c) {
+            // Build each column's histogram for the top row's window.
+            std::fill(colhist.begin(), colhist.end(), 0);
+            std::fill(colcount.begin(), colcount.end(), 0);
+            for (int i = 0; i < ncols; ++i) {
+                int x = xfirst + i;
+                if (x < adata.xbegin || x >= adata.xend)
+                    continue;
+                int y0 = std::max(roi.ybegin - h_2, adata.ybegin);
+                int y1 = std::min(roi.ybegin - h_2 + height, adata.yend);
+                for (int y = y0; y < y1; ++y)
+                    ++colptr(i)[sample(x, y, c)];
+                colcount[i] = uint16_t(std::max(0, y1 - y0));
+            }
+            ImageBuf::Iterator<Rtype> r(R, roi);
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                // Sum the first window's columns into the window histogram.
+                memset(winfine, 0, sizeof(winfine));
+                memset(wincoarse, 0, sizeof(wincoarse));
+                uint32_t n = 0;
+                for (int i = 0; i < width; ++i) {
+                    const uint16_t* ch = colptr(i);
+                    for (int b = 0; b < 256; ++b)
+                        winfine[b] += ch[b];
+                    n += colcount[i];
+                }
+                for (int b = 0; b < 256; ++b)
+                    wincoarse[b >> 4] += winfine[b];
+                for (int x = roi.xbegin; x < roi.xend; ++x, ++r) {
+                    if (n) {
+                        // The generic path takes sorted element n/2, so
+                        // find the smallest value whose cumulative count
+                        // exceeds n/2.
+                        uint32_t half = n / 2, cum = 0;
+                        int coarse = 0;
+                        for (; coarse < 15; ++coarse) {
+                            if (cum + wincoarse[coarse] > half)
+                                break;
+                            cum += wincoarse[coarse];
+                        }
+                        int v = coarse << 4;
+                        for (; v < (coarse << 4) + 15; ++v) {
+                            if (cum + winfine[v] > half)
+                                break;
+                            cum += winfine[v];
+                        }
+                        r[c] = v * (1.0f / 255.0f);
+                    } else {
+                        r[c] = 0.0f;
+                    }
+                    // Slide the window right one column.
+                    if (x + 1 < roi.xend) {
+                        int addi           = (x + 1) - xfirst + (width - 1);
+                        int remi           = (x - w_2) - xfirst;
+                        const uint16_t* ca = colptr(addi);
+                        const uint16_t* cr = colptr(remi);
+                        for (int b = 0; b < 256; ++b) {
+                            uint32_t delta = uint32_t(ca[b]) - uint32_t(cr[b]);
+                            winfine[b] += delta;
+                            wincoarse[b >> 4] += delta;
+                        }
+                        n += colcount[addi];
+                        n -= colcount[remi];
+                    }
+                }
+                // Advance the column histograms down one row.
+                if (y + 1 < roi.yend) {
+                    int yrem = y - h_2;
+                    int yadd = y - h_2 + height;
+                    bool remok = (yrem >= adata.ybegin && yrem < adata.yend);
+                    bool addok = (yadd >= adata.ybegin && yadd < adata.yend);
+                    for (int i = 0; i < ncols; ++i) {
+                        int x = xfirst + i;
+                        if (x < adata.xbegin || x >= adata.xend)
+                            continue;
+                        if (remok) {
+                            --colptr(i)[sample(x, yrem, c)];
+                            --colcount[i];
+                        }
+                        if (addok) {
+                            ++colptr(i)[sample(x, yadd, c)];
+                            ++colcount[i];
+                        }
+                    }
+                }
+            }
+        }
+    });
+    return true;
+}
+
+
+
 template<class Rtype, class Atype>
 static bool
 median_filter_impl(ImageBuf& R, const ImageBuf& A, int width, int height,
@@ -711,6 +1007,13 @@ ImageBufAlgo::median_filter(ImageBuf& dst, const ImageBuf& src, int width,
         return false;
 
     bool ok;
+    if (src.spec().format == TypeDesc::UINT8 && src.localpixels()) {
+        // 8-bit images get the constant-time sliding histogram median.
+        OIIO_DISPATCH_TYPES(ok, "median_filter", median_filter_hist_,
+                            dst.spec().format, dst, src, width, height, roi,
+                            nthreads);
+        return ok;
+    }
     OIIO_DISPATCH_COMMON_TYPES2(ok, "median_filter", median_filter_impl,
                                 dst.spec().format, src.spec().format, dst, src,
                                 width, height, roi, nthreads);
@@ -732,6 +1035,226 @@ ImageBufAlgo::median_filter(const ImageBuf& src, int width, int height, ROI roi,
 
 
 
+template<class Rtype, class Atype>
+static bool
+bilateral_filter_impl(ImageBuf& R, const ImageBuf& A, float sigma_s,
+                      float sigma_r, ROI roi, int nthreads)
+{
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        int radius    = std::max(1, int(ceilf(2.5f * sigma_s)));
+        int width     = 2 * radius + 1;
+        float s2inv   = -0.5f / (sigma_s * sigma_s);
+        float r2inv   = -0.5f / (sigma_r * sigma_r);
+        int nchannels = R.nchannels();
+        // The spatial Gaussian depends only on window offsets; compute it
+        // once. The range weight has to be computed per sample.
+        float* spatial = OIIO_ALLOCA(float, width * width);
+        for (int j = -radius, i = 0; j <= radius; ++j)
+            for (int k = -radius; k <= radius; ++k, ++i)
+                spatial[i] = fast_exp(float(j * j + k * k) * s2inv);
+        float* center = OIIO_ALLOCA(float, nchannels);
+        float* accum  = OIIO_ALLOCA(float, nchannels);
+        ImageBuf::ConstIterator<Atype> a(A, roi);
+        ImageBuf::ConstIterator<Atype> ctr(A, roi);
+        for (ImageBuf::Iterator<Rtype> r(R, roi); !r.done(); ++r, ++ctr) {
+            for (int c = 0; c < nchannels; ++c) {
+                center[c] = ctr[c];
+                accum[c]  = 0.0f;
+            }
+            float wsum = 0.0f;
+            a.rerange(r.x() - radius, r.x() + radius + 1, r.y() - radius,
+                      r.y() + radius + 1, r.z(), r.z() + 1,
+                      ImageBuf::WrapClamp);
+            for (int i = 0; !a.done(); ++a, ++i) {
+                if (!a.exists())
+                    continue;
+                // Joint range distance over all channels, so edges in any
+                // channel suppress bleeding in all of them.
+                float d2 = 0.0f;
+                for (int c = 0; c < nchannels; ++c) {
+                    float d = a[c] - center[c];
+                    d2 += d * d;
+                }
+                float w = spatial[i] * fast_exp(d2 * r2inv);
+                for (int c = 0; c < nchannels; ++c)
+                    accum[c] += w * a[c];
+                wsum += w;
+            }
+            float scale = wsum > 0.0f ? 1.0f / wsum : 0.0f;
+            for (int c = 0; c < nchannels; ++c)
+                r[c] = accum[c] * scale;
+        }
+    });
+    return true;
+}
+
+
+
+bool
+ImageBufAlgo::bilateral_filter(ImageBuf& dst, const ImageBuf& src,
+                               float sigma_s, float sigma_r, ROI roi,
+                               int nthreads)
+{
+    pvt::LoggedTimer logtime("IBA::bilateral_filter");
+    if (!IBAprep(roi, &dst, &src,
+                 IBAprep_REQUIRE_SAME_NCHANNELS | IBAprep_NO_SUPPORT_VOLUME))
+        return false;
+    if (sigma_s <= 0.0f || sigma_r <= 0.0f) {
+        dst.errorfmt("bilateral_filter sigmas must be positive");
+        return false;
+    }
+    bool ok;
+    OIIO_DISPATCH_COMMON_TYPES2(ok, "bilateral_filter", bilateral_filter_impl,
+                                dst.spec().format, src.spec().format, dst, src,
+                                sigma_s, sigma_r, roi, nthreads);
+    return ok;
+}
+
+
+
+ImageBuf
+ImageBufAlgo::bilateral_filter(const ImageBuf& src, float sigma_s,
+                               float sigma_r, ROI roi, int nthreads)
+{
+    ImageBuf result;
+    bool ok = bilateral_filter(result, src, sigma_s, sigma_r, roi, nthreads);
+    if (!ok && !result.has_error())
+        result.errorfmt("ImageBufAlgo::bilateral_filter() error");
+    return result;
+}
+
+
+
+// Normalized box blur of a single w x h float plane, in place, using
+// running (prefix) sums so the cost is independent of the radius. Windows
+// shrink at the plane edges and are normalized by the actual sample count.
+static void
+box_blur_plane(float* data, int w, int h, int radius,
+               std::vector<float>& scratch)
+{
+    // Horizontal pass, one row at a time via a row prefix sum.
+    scratch.resize(size_t(w) + 1);
+    for (int y = 0; y < h; ++y) {
+        float* row = data + size_t(y) * w;
+        scratch[0] = 0.0f;
+        for (int x = 0; x < w; ++x)
+            scratch[x + 1] = scratch[x] + row[x];
+        for (int x = 0; x < w; ++x) {
+            int lo = std::max(x - radius, 0);
+            int hi = std::min(x + radius + 1, w);
+            row[x] = (scratch[hi] - scratch[lo]) / float(hi - lo);
+        }
+    }
+    // Vertical pass via a column-wise prefix sum plane.
+    scratch.resize(size_t(w) * (h + 1));
+    std::fill(scratch.begin(), scratch.begin() + w, 0.0f);
+    for (int y = 0; y < h; ++y) {
+        const float* row = data + size_t(y) * w;
+        const float* ps  = &scratch[size_t(y) * w];
+        float* psnext    = &scratch[size_t(y + 1) * w];
+        for (int x = 0; x < w; ++x)
+            psnext[x] = ps[x] + row[x];
+    }
+    for (int y = 0; y < h; ++y) {
+        int lo           = std::max(y - radius, 0);
+        int hi           = std::min(y + radius + 1, h);
+        const float* pl  = &scratch[size_t(lo) * w];
+        const float* ph  = &scratch[size_t(hi) * w];
+        float* row       = data + size_t(y) * w;
+        float countscale = 1.0f / float(hi - lo);
+        for (int x = 0; x < w; ++x)
+            row[x] = (ph[x] - pl[x]) * countscale;
+    }
+}
+
+
+
+static bool
+guided_filter_impl(ImageBuf& R, const ImageBuf& A, const ImageBuf& G,
+                   int radius, float eps, ROI roi, int /*nthreads*/)
+{
+    // He et al.'s box-filter formulation: per channel, a and b are fit in
+    // every window so that q = a*I + b, with the fit means box-blurred
+    // before reconstruction. All the heavy lifting is O(npixels),
+    // independent of radius.
+    const ImageBuf& guide(G.initialized() ? G : A);
+    int w      = roi.width();
+    int h      = roi.height();
+    size_t npx = size_t(w) * h;
+    std::unique_ptr<float[]> I(new float[npx]), p(new float[npx]),
+        mean_I(new float[npx]), mean_p(new float[npx]),
+        corr_II(new float[npx]), corr_Ip(new float[npx]);
+    std::vector<float> scratch;
+    for (int c = roi.chbegin; c < roi.chend; ++c) {
+        int gc = std::min(c, guide.nchannels() - 1);
+        ROI proi(roi.xbegin, roi.xend, roi.ybegin, roi.yend, roi.zbegin,
+                 roi.zbegin + 1, c, c + 1);
+        ROI groi(roi.xbegin, roi.xend, roi.ybegin, roi.yend, roi.zbegin,
+                 roi.zbegin + 1, gc, gc + 1);
+        if (!guide.get_pixels(groi, TypeFloat, I.get())
+            || !A.get_pixels(proi, TypeFloat, p.get()))
+            return false;
+        for (size_t i = 0; i < npx; ++i) {
+            mean_I[i]  = I[i];
+            mean_p[i]  = p[i];
+            corr_II[i] = I[i] * I[i];
+            corr_Ip[i] = I[i] * p[i];
+        }
+        box_blur_plane(mean_I.get(), w, h, radius, scratch);
+        box_blur_plane(mean_p.get(), w, h, radius, scratch);
+        box_blur_plane(corr_II.get(), w, h, radius, scratch);
+        box_blur_plane(corr_Ip.get(), w, h, radius, scratch);
+        // Reuse the corr planes to hold the per-pixel fit: a then b.
+        for (size_t i = 0; i < npx; ++i) {
+            float var  = corr_II[i] - mean_I[i] * mean_I[i];
+            float cov  = corr_Ip[i] - mean_I[i] * mean_p[i];
+            float a    = cov / (var + eps);
+            corr_II[i] = a;
+            corr_Ip[i] = mean_p[i] - a * mean_I[i];
+        }
+        box_blur_plane(corr_II.get(), w, h, radius, scratch);  // mean_a
+        box_blur_plane(corr_Ip.get(), w, h, radius, scratch);  // mean_b
+        for (size_t i = 0; i < npx; ++i)
+            p[i] = corr_II[i] * I[i] + corr_Ip[i];
+        if (!R.set_pixels(proi, TypeFloat, p.get()))
+            return false;
+    }
+    return true;
+}
+
+
+
+bool
+ImageBufAlgo::guided_filter(ImageBuf& dst, const ImageBuf& src,
+                            const ImageBuf& guide, int radius, float eps,
+                            ROI roi, int nthreads)
+{
+    pvt::LoggedTimer logtime("IBA::guided_filter");
+    if (!IBAprep(roi, &dst, &src,
+                 IBAprep_REQUIRE_SAME_NCHANNELS | IBAprep_NO_SUPPORT_VOLUME))
+        return false;
+    if (radius < 1 || eps <= 0.0f) {
+        dst.errorfmt("guided_filter needs radius >= 1 and eps > 0");
+        return false;
+    }
+    return guided_filter_impl(dst, src, guide, radius, eps, roi, nthreads);
+}
+
+
+
+ImageBuf
+ImageBufAlgo::guided_filter(const ImageBuf& src, const ImageBuf& guide,
+                            int radius, float eps, ROI roi, int nthreads)
+{
+    ImageBuf result;
+    bool ok = guided_filter(result, src, guide, radius, eps, roi, nthreads);
+    if (!ok && !result.has_error())
+        result.errorfmt("ImageBufAlgo::guided_filter() error");
+    return result;
+}
+
+
+
 enum MorphOp { MorphDilate, MorphErode };
 
 template<class Rtype, class Atype>
@@ -845,6 +1368,28 @@ ImageBufAlgo::erode(const ImageBuf& src, int width, int height, ROI roi,
 
 
 
+// Process-wide cache of kissfft plans, keyed by (length, inverse).
+// Building a plan computes the twiddle tables and stage factorization,
+// which is worth doing only once per size when the same transform is
+// applied repeatedly (both passes of every 2D fft, every frame of a
+// sequence). Once built, a plan is immutable and may be driven by many
+// threads at once. Distinct sizes in one process are few, so the cache
+// is left unbounded.
+static std::shared_ptr<kissfft<float>>
+fft_plan(int nfft, bool inverse)
+{
+    static spin_mutex plan_mutex;
+    static std::map<std::pair<int, bool>, std::shared_ptr<kissfft<float>>>
+        plans;
+    spin_lock lock(plan_mutex);
+    std::shared_ptr<kissfft<float>>& plan = plans[{ nfft, inverse }];
+    if (!plan)
+        plan = std::make_shared<kissfft<float>>(nfft, inverse);
+    return plan;
+}
+
+
+
 // Helper function: fft of the horizontal rows
 static bool
 hfft_(ImageBuf& dst, const ImageBuf& src, bool inverse, bool unitary, ROI roi,
@@ -859,16 +1404,19 @@ hfft_(ImageBuf& dst, const ImageBuf& src, bool inverse, bool unitary, ROI roi,
                 && (src.storage() == ImageBuf::LOCALBUFFER
                     || src.storage() == ImageBuf::APPBUFFER));
 
+    // One cached plan for the whole image (parallel_image splits the
+    // batch of rows in y, so every chunk transforms full-width rows);
+    // each thread drives the shared plan over its own rows.
+    std::shared_ptr<kissfft<float>> F = fft_plan(roi.width(), inverse);
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         int width     = roi.width();
         float rescale = sqrtf(1.0f / width);
-        kissfft<float> F(width, inverse);
         for (int z = roi.zbegin; z < roi.zend; ++z) {
             for (int y = roi.ybegin; y < roi.yend; ++y) {
                 std::complex<float>*s, *d;
                 s = (std::complex<float>*)src.pixeladdr(roi.xbegin, y, z);
                 d = (std::complex<float>*)dst.pixeladdr(roi.xbegin, y, z);
-                F.transform(s, d);
+                F->transform(s, d);
                 if (unitary)
                     for (int x = 0; x < width; ++x)
                         d[x] *= rescale;
@@ -1244,4 +1792,88 @@ ImageBufAlgo::fillholes_pushpull(const ImageBuf& src, ROI roi, int nthreads)
 }
 
 
+
+ImageBuf
+ImageBufAlgo::fast_proxy(string_view filename, int goalsize)
+{
+    pvt::LoggedTimer logtime("IBA::fast_proxy");
+    ImageBuf result;
+    if (goalsize < 1) {
+        result.errorfmt("fast_proxy: invalid goalsize {}", goalsize);
+        return result;
+    }
+
+    auto in = ImageInput::open(filename);
+    if (!in) {
+        result.errorfmt("Could not open \"{}\": {}", filename,
+                        OIIO::geterror());
+        return result;
+    }
+
+    // Source 1: an embedded thumbnail, if the file has one. This is by far
+    // the cheapest option -- the pixels are already tiny and precomputed.
+    if (in->supports("thumbnail")) {
+        ImageBuf thumb;
+        if (in->get_thumbnail(thumb, 0) && thumb.initialized())
+            return thumb;
+    }
+
+    // Source 2: for a mipmapped file, the coarsest MIP level that still
+    // meets goalsize. spec_dimensions() is cheap -- it never touches
+    // pixels -- so probing the levels costs almost nothing.
+    const ImageSpec& fullspec(in->spec());
+    int fullsize  = std::max(fullspec.width, fullspec.height);
+    int bestlevel = -1;
+    for (int level = 1; ; ++level) {
+        ImageSpec mipspec = in->spec_dimensions(0, level);
+        if (mipspec.width <= 0 || mipspec.height <= 0)
+            break;
+        if (std::max(mipspec.width, mipspec.height) >= goalsize)
+            bestlevel = level;
+        else
+            break;  // levels only get smaller from here
+    }
+    std::string formatname = in->format_name();
+    in.reset();  // done probing; let ImageBuf reopen as it pleases
+    if (bestlevel > 0) {
+        ImageBuf mip(filename, 0, bestlevel);
+        if (mip.read(0, bestlevel))
+            return mip;
+    }
+
+    // Source 3: a reduced-resolution decode, for formats that can do one
+    // natively. JPEG can decode at 1/2, 1/4, or 1/8 scale directly from
+    // the DCT coefficients via the "jpeg:scale" open hint.
+    if (Strutil::iequals(formatname, "jpeg") && fullsize >= 2 * goalsize) {
+        int scale = 2;
+        if (fullsize >= 8 * goalsize)
+            scale = 8;
+        else if (fullsize >= 4 * goalsize)
+            scale = 4;
+        ImageSpec config;
+        config.attribute("jpeg:scale", scale);
+        ImageBuf scaled(filename, 0, 0, nullptr, &config);
+        if (scaled.read())
+            return scaled;
+    }
+
+    // Source 4: last resort -- full decode plus a fast resample down to
+    // goalsize (preserving aspect ratio).
+    ImageBuf full(filename);
+    if (!full.read()) {
+        result.errorfmt("Could not read \"{}\": {}", filename,
+                        full.geterror());
+        return result;
+    }
+    const ImageSpec& spec(full.spec());
+    int longest = std::max(spec.width, spec.height);
+    if (longest <= goalsize)
+        return full;  // already small enough
+    int w = std::max(1, int(spec.width * float(goalsize) / longest + 0.5f));
+    int h = std::max(1, int(spec.height * float(goalsize) / longest + 0.5f));
+    ROI roi(0, w, 0, h, 0, 1, 0, spec.nchannels);
+    return ImageBufAlgo::resample(full, true, roi);
+}
+
+
 OIIO_NAMESPACE_END
@@ -13,6 +13,7 @@
 #include <OpenImageIO/half.h>
 
 #include <OpenImageIO/deepdata.h>
+#include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
@@ -24,11 +25,61 @@
 OIIO_NAMESPACE_BEGIN
 
 
+// Shuffle channels between two local, same-typed buffers with raw pointer
+// loops. Working channel-major turns the copy of each output channel into a
+// constant-stride walk that the compiler vectorizes into the same shuffles
+// a hand-written AoS<->SoA permute would use, without per-pixel iterator
+// overhead. Channel shuffles are pure data movement, so this runs at or
+// near memcpy speed.
+template<typename DSTTYPE>
+static void
+channels_shuffle_scanlines_(ImageBuf& dst, const ImageBuf& src,
+                            cspan<int> channelorder,
+                            cspan<float> channelvalues, ROI roi)
+{
+    int nchannels    = src.nchannels();
+    const int snc    = src.spec().nchannels;
+    const int dnc    = dst.spec().nchannels;
+    const int width  = roi.width();
+    for (int z = roi.zbegin; z < roi.zend; ++z) {
+        for (int y = roi.ybegin; y < roi.yend; ++y) {
+            const DSTTYPE* srow = (const DSTTYPE*)src.pixeladdr(roi.xbegin, y,
+                                                                z);
+            DSTTYPE* drow       = (DSTTYPE*)dst.pixeladdr(roi.xbegin, y, z);
+            for (int c = roi.chbegin; c < roi.chend; ++c) {
+                int cc = channelorder[c];
+                if (cc >= 0 && cc < nchannels) {
+                    const DSTTYPE* s = srow + cc;
+                    DSTTYPE* d       = drow + c;
+                    for (int x = 0; x < width; ++x)
+                        d[x * dnc] = s[x * snc];
+                } else if (channelvalues.size() > c) {
+                    DSTTYPE val = convert_type<float, DSTTYPE>(
+                        channelvalues[c]);
+                    DSTTYPE* d  = drow + c;
+                    for (int x = 0; x < width; ++x)
+                        d[x * dnc] = val;
+                }
+            }
+        }
+    }
+}
+
+
 template<typename DSTTYPE>
 static bool
 channels_(ImageBuf& dst, const ImageBuf& src, cspan<int> channelorder,
           cspan<float> channelvalues, ROI roi, int nthreads = 0)
 {
+    if (dst.localpixels() && src.localpixels()
+        && src.spec().format == dst.spec().format
+        && src.spec().format == BaseTypeFromC<DSTTYPE>::value) {
+        ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+            channels_shuffle_scanlines_<DSTTYPE>(dst, src, channelorder,
+                                                 channelvalues, roi);
+        });
+        return true;
+    }
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         int nchannels = src.nchannels();
         ImageBuf::ConstIterator<DSTTYPE> s(src, roi);
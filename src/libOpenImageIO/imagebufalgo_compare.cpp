@@ -17,6 +17,7 @@
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
+#include <OpenImageIO/simd.h>
 #include <OpenImageIO/thread.h>
 
 #include "imageio_pvt.h"
@@ -121,7 +122,7 @@ finalize(ImageBufAlgo::PixelStats& p)
 template<class T>
 static bool
 computePixelStats_(const ImageBuf& src, ImageBufAlgo::PixelStats& stats,
-                   ROI roi, int nthreads)
+                   int stride, ROI roi, int nthreads)
 {
     // clang-format off
     if (!roi.defined())
@@ -132,17 +133,27 @@ computePixelStats_(const ImageBuf& src, ImageBufAlgo::PixelStats& stats,
     int nchannels = src.spec().nchannels;
 
     stats.reset(nchannels);
-    OIIO::spin_mutex mutex;  // protect the shared stats when merging
+
+    // Accumulate per-band partials with parallel_reduce, which merges
+    // them in band order afterward, so the (float) results are identical
+    // from run to run no matter how the bands were scheduled.
+    auto merge = [](ImageBufAlgo::PixelStats& r,
+                    const ImageBufAlgo::PixelStats& p) {
+        if (p.min.size())
+            r.merge(p);
+    };
 
     parallel_options opt(nthreads);
     if (src.deep()) {
-        parallel_for_chunked(roi.ybegin, roi.yend, 64,
-                             [&](int64_t ybegin, int64_t yend) {
-            ROI subroi(roi.xbegin, roi.xend, ybegin, yend, roi.zbegin,
-                       roi.zend, roi.chbegin, roi.chend);
-            ImageBufAlgo::PixelStats tmp(nchannels);
+        ImageBufAlgo::parallel_reduce(roi, opt, stats,
+            [&](ImageBufAlgo::PixelStats& tmp, ROI subroi) {
+            tmp.reset(nchannels);
             for (ImageBuf::ConstIterator<T> s(src, subroi); !s.done();
                  ++s) {
+                if (stride > 1
+                    && ((s.x() - roi.xbegin) % stride
+                        || (s.y() - roi.ybegin) % stride))
+                    continue;
                 int samples = s.deep_samples();
                 if (!samples)
                     continue;
@@ -153,29 +164,54 @@ computePixelStats_(const ImageBuf& src, ImageBufAlgo::PixelStats& stats,
                     }
                 }
             }
-            std::lock_guard<OIIO::spin_mutex> lock(mutex);
-            stats.merge(tmp);
-        }, opt);
+        }, merge);
 
     } else {  // Non-deep case
-        parallel_for_chunked(roi.ybegin, roi.yend, 64,
-                             [&](int64_t ybegin, int64_t yend) {
-            ROI subroi(roi.xbegin, roi.xend, ybegin, yend, roi.zbegin,
-                       roi.zend, roi.chbegin, roi.chend);
-            ImageBufAlgo::PixelStats tmp(nchannels);
-            for (ImageBuf::ConstIterator<T> s(src, subroi); !s.done();
-                 ++s) {
-                for (int c = subroi.chbegin; c < subroi.chend; ++c) {
-                    float value = s[c];
-                    val(tmp, c, value);
+        bool flat = (stride == 1 && src.localpixels() && src.contiguous()
+                     && roi.chbegin == 0 && roi.chend == nchannels);
+        ImageBufAlgo::parallel_reduce(roi, opt, stats,
+            [&](ImageBufAlgo::PixelStats& tmp, ROI subroi) {
+            tmp.reset(nchannels);
+            if (flat) {
+                // Contiguous local pixels over the full channel range:
+                // accumulate each scanline from the flat array, skipping
+                // all the iterator machinery.
+                for (int z = subroi.zbegin; z < subroi.zend; ++z)
+                    for (int y = subroi.ybegin; y < subroi.yend; ++y) {
+                        const T* raw
+                            = (const T*)src.pixeladdr(roi.xbegin, y, z);
+                        for (int x = 0, n = roi.width(); x < n; ++x)
+                            for (int c = 0; c < nchannels; ++c)
+                                val(tmp, c, float(raw[x * nchannels + c]));
+                    }
+            } else if (stride == 1) {
+                for (ImageBuf::ConstIterator<T> s(src, subroi); !s.done();
+                     ++s) {
+                    for (int c = subroi.chbegin; c < subroi.chend; ++c) {
+                        float value = s[c];
+                        val(tmp, c, value);
+                    }
+                }
+            } else {
+                // Sampled mode: inspect every stride-th pixel of every
+                // stride-th row, with the phase anchored to the ROI origin
+                // so banding doesn't change which pixels are sampled.
+                ImageBuf::ConstIterator<T> s(src);
+                for (int z = subroi.zbegin; z < subroi.zend; ++z) {
+                    int y0 = subroi.ybegin
+                             + (stride - (subroi.ybegin - roi.ybegin) % stride)
+                                   % stride;
+                    for (int y = y0; y < subroi.yend; y += stride)
+                        for (int x = roi.xbegin; x < roi.xend; x += stride) {
+                            s.pos(x, y, z);
+                            for (int c = roi.chbegin; c < roi.chend; ++c)
+                                val(tmp, c, s[c]);
+                        }
                 }
             }
-            std::lock_guard<OIIO::spin_mutex> lock(mutex);
-            stats.merge(tmp);
-        }, opt);
+        }, merge);
     }
 
-    // Compute final results
     finalize(stats);
 
     return !src.has_error();
@@ -185,9 +221,12 @@ computePixelStats_(const ImageBuf& src, ImageBufAlgo::PixelStats& stats,
 
 
 ImageBufAlgo::PixelStats
-ImageBufAlgo::computePixelStats(const ImageBuf& src, ROI roi, int nthreads)
+ImageBufAlgo::computePixelStats(const ImageBuf& src, KWArgs options, ROI roi,
+                                int nthreads)
 {
     pvt::LoggedTimer logtimer("IBA::computePixelStats");
+    static const ustring stride_us("stride");
+    int stride = std::max(1, options.get_int(stride_us, 1));
     ImageBufAlgo::PixelStats stats;
     if (!roi.defined())
         roi = get_roi(src.spec());
@@ -201,7 +240,7 @@ ImageBufAlgo::computePixelStats(const ImageBuf& src, ROI roi, int nthreads)
 
     bool ok = true;
     OIIO_DISPATCH_TYPES(ok, "computePixelStats", computePixelStats_,
-                        src.spec().format, src, stats, roi, nthreads);
+                        src.spec().format, src, stats, stride, roi, nthreads);
     if (!ok)
         stats.reset(0);
     return stats;
@@ -209,6 +248,14 @@ ImageBufAlgo::computePixelStats(const ImageBuf& src, ROI roi, int nthreads)
 
 
 
+ImageBufAlgo::PixelStats
+ImageBufAlgo::computePixelStats(const ImageBuf& src, ROI roi, int nthreads)
+{
+    return computePixelStats(src, {}, roi, nthreads);
+}
+
+
+
 // Deprecated:
 bool
 ImageBufAlgo::computePixelStats(PixelStats& stats, const ImageBuf& src, ROI roi,
@@ -220,10 +267,10 @@ ImageBufAlgo::computePixelStats(PixelStats& stats, const ImageBuf& src, ROI roi,
 
 
 
-template<class BUFT, class VALT>
+template<class VALT>
 inline void
-compare_value(ImageBuf::ConstIterator<BUFT, float>& a, int chan, VALT aval,
-              VALT bval, ImageBufAlgo::CompareResults& result, float& maxval,
+compare_value(int x, int y, int z, int chan, VALT aval, VALT bval,
+              ImageBufAlgo::CompareResults& result, float& maxval,
               double& batcherror, double& batch_sqrerror, bool& failed,
               bool& warned, float failthresh, float warnthresh,
               float failrelative, float warnrelative)
@@ -234,9 +281,9 @@ compare_value(ImageBuf::ConstIterator<BUFT, float>& a, int chan, VALT aval,
         if (isfinite(result.maxerror)) {
             // non-finite errors trump finite ones
             result.maxerror = std::numeric_limits<float>::infinity();
-            result.maxx     = a.x();
-            result.maxy     = a.y();
-            result.maxz     = a.z();
+            result.maxx     = x;
+            result.maxy     = y;
+            result.maxz     = z;
             result.maxc     = chan;
             return;
         }
@@ -255,9 +302,9 @@ compare_value(ImageBuf::ConstIterator<BUFT, float>& a, int chan, VALT aval,
     // return false).
     if (!(f <= result.maxerror)) {
         result.maxerror = f;
-        result.maxx     = a.x();
-        result.maxy     = a.y();
-        result.maxz     = a.z();
+        result.maxx     = x;
+        result.maxy     = y;
+        result.maxz     = z;
         result.maxc     = chan;
     }
     if (!warned && !(f <= warnthresh) && !(rel <= warnrelative)) {
@@ -271,12 +318,27 @@ compare_value(ImageBuf::ConstIterator<BUFT, float>& a, int chan, VALT aval,
 }
 
 
+template<class BUFT, class VALT>
+inline void
+compare_value(ImageBuf::ConstIterator<BUFT, float>& a, int chan, VALT aval,
+              VALT bval, ImageBufAlgo::CompareResults& result, float& maxval,
+              double& batcherror, double& batch_sqrerror, bool& failed,
+              bool& warned, float failthresh, float warnthresh,
+              float failrelative, float warnrelative)
+{
+    compare_value(a.x(), a.y(), a.z(), chan, aval, bval, result, maxval,
+                  batcherror, batch_sqrerror, failed, warned, failthresh,
+                  warnthresh, failrelative, warnrelative);
+}
+
+
 
 template<class Atype, class Btype>
 static bool
 compare_(const ImageBuf& A, const ImageBuf& B, float failthresh,
          float warnthresh, float failrelative, float warnrelative,
-         ImageBufAlgo::CompareResults& result, ROI roi, int /*nthreads*/)
+         imagesize_t maxfailures, ImageBufAlgo::CompareResults& result, ROI roi,
+         int /*nthreads*/)
 {
     imagesize_t npels = roi.npixels();
     imagesize_t nvals = npels * roi.nchannels();
@@ -298,42 +360,95 @@ compare_(const ImageBuf& A, const ImageBuf& B, float failthresh,
     // either image. The compare_value() function we call on every pixel value
     // will check and adjust our max as needed.
 
-    ImageBuf::ConstIterator<Atype> a(A, roi, ImageBuf::WrapBlack);
-    ImageBuf::ConstIterator<Btype> b(B, roi, ImageBuf::WrapBlack);
     bool deep = A.deep();
-    // Break up into batches to reduce cancellation errors as the error
-    // sums become too much larger than the error for individual pixels.
-    const int batchsize = 4096;  // As good a guess as any
-    for (; !a.done();) {
-        double batcherror     = 0;
-        double batch_sqrerror = 0;
-        if (deep) {
-            for (int i = 0; i < batchsize && !a.done(); ++i, ++a, ++b) {
-                bool warned = false, failed = false;  // For this pixel
-                auto nsamps = std::max(a.deep_samples(), b.deep_samples());
-                for (int c = roi.chbegin; c < roi.chend; ++c)
-                    for (int s = 0, e = nsamps; s < e; ++s) {
-                        compare_value(a, c, a.deep_value(c, s),
-                                      b.deep_value(c, s), result, maxval,
-                                      batcherror, batch_sqrerror, failed,
-                                      warned, failthresh, warnthresh,
+    // Keep track of how many pixels we actually examined, so that if we
+    // abandon the scan early, the mean/RMS/PSNR reflect just the portion
+    // of the image we visited.
+    imagesize_t npelscanned = 0;
+
+    // Fast path: neither image is deep, both have their pixels in local
+    // memory as float or half covering the region, and the ROI doesn't
+    // spill past either channel range. Use flat raw-pointer loops rather
+    // than paying the per-sample cost of iterators.
+    if (!deep
+        && (std::is_same<Atype, float>::value
+            || std::is_same<Atype, half>::value)
+        && (std::is_same<Btype, float>::value
+            || std::is_same<Btype, half>::value)
+        && A.localpixels() && B.localpixels() && A.contains_roi(roi)
+        && B.contains_roi(roi) && roi.chbegin == 0 && roi.chend <= Achannels
+        && roi.chend <= Bchannels) {
+        int nch        = roi.chend;
+        bool earlyexit = false;
+        for (int z = roi.zbegin; z < roi.zend && !earlyexit; ++z)
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                const Atype* araw = (const Atype*)A.pixeladdr(roi.xbegin, y, z);
+                const Btype* braw = (const Btype*)B.pixeladdr(roi.xbegin, y, z);
+                // Per-scanline batches are small enough to control the
+                // cancellation errors the batching is there to avoid.
+                double batcherror     = 0;
+                double batch_sqrerror = 0;
+                for (int x = 0, xe = roi.width(); x < xe; ++x) {
+                    bool warned = false, failed = false;  // For this pixel
+                    for (int c = 0; c < nch; ++c)
+                        compare_value(x + roi.xbegin, y, z, c,
+                                      float(araw[x * Achannels + c]),
+                                      float(braw[x * Bchannels + c]), result,
+                                      maxval, batcherror, batch_sqrerror,
+                                      failed, warned, failthresh, warnthresh,
                                       failrelative, warnrelative);
-                    }
+                }
+                totalerror += batcherror;
+                totalsqrerror += batch_sqrerror;
+                npelscanned += roi.width();
+                if (maxfailures && result.nfail >= maxfailures) {
+                    earlyexit = true;
+                    break;
+                }
             }
-        } else {  // non-deep
-            for (int i = 0; i < batchsize && !a.done(); ++i, ++a, ++b) {
-                bool warned = false, failed = false;  // For this pixel
-                for (int c = roi.chbegin; c < roi.chend; ++c)
-                    compare_value(a, c, c < Achannels ? a[c] : 0.0f,
-                                  c < Bchannels ? b[c] : 0.0f, result, maxval,
-                                  batcherror, batch_sqrerror, failed, warned,
-                                  failthresh, warnthresh, failrelative,
-                                  warnrelative);
+    } else {
+        ImageBuf::ConstIterator<Atype> a(A, roi, ImageBuf::WrapBlack);
+        ImageBuf::ConstIterator<Btype> b(B, roi, ImageBuf::WrapBlack);
+        // Break up into batches to reduce cancellation errors as the error
+        // sums become too much larger than the error for individual pixels.
+        const int batchsize = 4096;  // As good a guess as any
+        for (; !a.done();) {
+            double batcherror     = 0;
+            double batch_sqrerror = 0;
+            if (deep) {
+                for (int i = 0; i < batchsize && !a.done(); ++i, ++a, ++b) {
+                    bool warned = false, failed = false;  // For this pixel
+                    auto nsamps = std::max(a.deep_samples(), b.deep_samples());
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        for (int s = 0, e = nsamps; s < e; ++s) {
+                            compare_value(a, c, a.deep_value(c, s),
+                                          b.deep_value(c, s), result, maxval,
+                                          batcherror, batch_sqrerror, failed,
+                                          warned, failthresh, warnthresh,
+                                          failrelative, warnrelative);
+                        }
+                    ++npelscanned;
+                }
+            } else {  // non-deep
+                for (int i = 0; i < batchsize && !a.done(); ++i, ++a, ++b) {
+                    bool warned = false, failed = false;  // For this pixel
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        compare_value(a, c, c < Achannels ? a[c] : 0.0f,
+                                      c < Bchannels ? b[c] : 0.0f, result,
+                                      maxval, batcherror, batch_sqrerror,
+                                      failed, warned, failthresh, warnthresh,
+                                      failrelative, warnrelative);
+                    ++npelscanned;
+                }
             }
+            totalerror += batcherror;
+            totalsqrerror += batch_sqrerror;
+            if (maxfailures && result.nfail >= maxfailures)
+                break;
         }
-        totalerror += batcherror;
-        totalsqrerror += batch_sqrerror;
     }
+    if (npelscanned < npels)
+        nvals = npelscanned * roi.nchannels();
     result.meanerror = totalerror / nvals;
     result.rms_error = sqrt(totalsqrerror / nvals);
     result.PSNR      = 20.0 * log10(maxval / result.rms_error);
@@ -352,10 +467,10 @@ ImageBufAlgo::compare(const ImageBuf& A, const ImageBuf& B, float failthresh,
 
 
 
-ImageBufAlgo::CompareResults
-ImageBufAlgo::compare(const ImageBuf& A, const ImageBuf& B, float failthresh,
-                      float warnthresh, float failrelative, float warnrelative,
-                      ROI roi, int nthreads)
+static ImageBufAlgo::CompareResults
+compare_impl(const ImageBuf& A, const ImageBuf& B, float failthresh,
+             float warnthresh, float failrelative, float warnrelative,
+             imagesize_t maxfailures, ROI roi, int nthreads)
 {
     pvt::LoggedTimer logtimer("IBA::compare");
     ImageBufAlgo::CompareResults result;
@@ -377,7 +492,7 @@ ImageBufAlgo::compare(const ImageBuf& A, const ImageBuf& B, float failthresh,
     OIIO_DISPATCH_COMMON_TYPES2_CONST(ok, "compare", compare_, A.spec().format,
                                       B.spec().format, A, B, failthresh,
                                       warnthresh, failrelative, warnrelative,
-                                      result, roi, nthreads);
+                                      maxfailures, result, roi, nthreads);
     // FIXME - The nthreads argument is for symmetry with the rest of
     // ImageBufAlgo and for future expansion. But for right now, we
     // don't actually split by threads.  Maybe later.
@@ -386,6 +501,36 @@ ImageBufAlgo::compare(const ImageBuf& A, const ImageBuf& B, float failthresh,
 }
 
 
+ImageBufAlgo::CompareResults
+ImageBufAlgo::compare(const ImageBuf& A, const ImageBuf& B, float failthresh,
+                      float warnthresh, float failrelative, float warnrelative,
+                      ROI roi, int nthreads)
+{
+    return compare_impl(A, B, failthresh, warnthresh, failrelative,
+                        warnrelative, 0, roi, nthreads);
+}
+
+
+ImageBufAlgo::CompareResults
+ImageBufAlgo::compare(const ImageBuf& A, const ImageBuf& B, KWArgs options,
+                      ROI roi, int nthreads)
+{
+    static const ustring failthresh_us("failthresh");
+    static const ustring warnthresh_us("warnthresh");
+    static const ustring failrelative_us("failrelative");
+    static const ustring warnrelative_us("warnrelative");
+    static const ustring maxfailures_us("maxfailures");
+    float failthresh        = options.get_float(failthresh_us, 0.0f);
+    float warnthresh        = options.get_float(warnthresh_us, 0.0f);
+    float failrelative      = options.get_float(failrelative_us, 0.0f);
+    float warnrelative      = options.get_float(warnrelative_us, 0.0f);
+    imagesize_t maxfailures = imagesize_t(
+        std::max(0, options.get_int(maxfailures_us, 0)));
+    return compare_impl(A, B, failthresh, warnthresh, failrelative,
+                        warnrelative, maxfailures, roi, nthreads);
+}
+
+
 
 bool
 ImageBufAlgo::compare(const ImageBuf& A, const ImageBuf& B, float failthresh,
@@ -406,8 +551,11 @@ isConstantColor_(const ImageBuf& src, float threshold, span<float> color,
     // Single flag that will be set to false by any of the threads if they
     // discover that the image is non-constant, so the others can abort early. It
     // does NOT need to be atomic, because the timing is not critical and we
-    // don't want to slow things down by locking.
-    bool result = true;
+    // don't want to slow things down by locking. The authoritative answer
+    // is the AND of the per-band partials, merged deterministically by
+    // parallel_reduce; this flag is only a hint.
+    bool failed = false;
+    char result = 1;
 
     imagesize_t npixels = roi.npixels();
     if (npixels == 0) {
@@ -432,37 +580,44 @@ isConstantColor_(const ImageBuf& src, float threshold, span<float> color,
                 return false;
     }
 
+    auto mergeand = [](char& r, char p) { r = r & p; };
     if (npixels == 1) {
         // One pixel? Yes, it's a constant color! Skip the image scan.
     } else if (threshold == 0.0f) {
         // For 0.0 threshold, use shortcut of avoiding the conversion
         // to float, just compare original type values.
-        ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-            if (!result)
-                return;  // another parallel bucket already failed, don't bother
-            for (ImageBuf::ConstIterator<T, T> s(src, roi); result && !s.done();
-                 ++s) {
+        ImageBufAlgo::parallel_reduce(roi, parallel_options(nthreads), result,
+            [&](char& bandok, ROI roi) {
+            bandok = 1;
+            if (failed)
+                return;  // another parallel band already failed, don't bother
+            for (ImageBuf::ConstIterator<T, T> s(src, roi);
+                 !failed && !s.done(); ++s) {
                 for (int c = roi.chbegin; c < roi.chend; ++c)
                     if (s[c] != constval[c]) {
-                        result = false;
+                        failed = true;
+                        bandok = 0;
                         return;
                     }
             }
-        });
+        }, mergeand);
     } else {
         // Nonzero threshold case
-        ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-            if (!result)
-                return;  // another parallel bucket already failed, don't bother
-            for (ImageBuf::ConstIterator<T> s(src, roi); result && !s.done();
-                 ++s) {
+        ImageBufAlgo::parallel_reduce(roi, parallel_options(nthreads), result,
+            [&](char& bandok, ROI roi) {
+            bandok = 1;
+            if (failed)
+                return;  // another parallel band already failed, don't bother
+            for (ImageBuf::ConstIterator<T> s(src, roi);
+                 !failed && !s.done(); ++s) {
                 for (int c = roi.chbegin; c < roi.chend; ++c)
                     if (std::abs(s[c] - constval[c]) > threshold) {
-                        result = false;
+                        failed = true;
+                        bandok = 0;
                         return;
                     }
             }
-        });
+        }, mergeand);
     }
 
     if (color.size()) {
@@ -621,11 +776,11 @@ static bool
 color_count_(const ImageBuf& src, atomic_ll* count, int ncolors,
              const float* color, const float* eps, ROI roi, int nthreads)
 {
-    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+    std::vector<long long> totals(ncolors, 0);
+    ImageBufAlgo::parallel_reduce(roi, parallel_options(nthreads), totals,
+        [&](std::vector<long long>& n, ROI roi) {
         int nchannels = src.nchannels();
-        long long* n  = OIIO_ALLOCA(long long, ncolors);
-        for (int col = 0; col < ncolors; ++col)
-            n[col] = 0;
+        n.assign(ncolors, 0);
         for (ImageBuf::ConstIterator<T> p(src, roi); !p.done(); ++p) {
             int coloffset = 0;
             for (int col = 0; col < ncolors; ++col, coloffset += nchannels) {
@@ -639,9 +794,13 @@ color_count_(const ImageBuf& src, atomic_ll* count, int ncolors,
                 n[col] += match;
             }
         }
-        for (int col = 0; col < ncolors; ++col)
-            count[col] += n[col];
+    },
+        [&](std::vector<long long>& r, const std::vector<long long>& n) {
+        for (int col = 0; col < ncolors && col < int(n.size()); ++col)
+            r[col] += n[col];
     });
+    for (int col = 0; col < ncolors; ++col)
+        count[col] += totals[col];
     return true;
 }
 
@@ -683,8 +842,12 @@ color_range_check_(const ImageBuf& src, atomic_ll* lowcount,
                    atomic_ll* highcount, atomic_ll* inrangecount,
                    const float* low, const float* high, ROI roi, int nthreads)
 {
-    ImageBufAlgo::parallel_image(roi, nthreads, [=, &src](ROI roi) {
+    struct RangeCounts {
         long long lc = 0, hc = 0, inrange = 0;
+    };
+    RangeCounts totals;
+    ImageBufAlgo::parallel_reduce(roi, parallel_options(nthreads), totals,
+        [low, high, &src](RangeCounts& n, ROI roi) {
         for (ImageBuf::ConstIterator<T> p(src, roi); !p.done(); ++p) {
             bool lowval = false, highval = false;
             for (int c = roi.chbegin; c < roi.chend; ++c) {
@@ -693,20 +856,25 @@ color_range_check_(const ImageBuf& src, atomic_ll* lowcount,
                 highval |= (f > high[c]);
             }
             if (lowval)
-                ++lc;
+                ++n.lc;
             if (highval)
-                ++hc;
+                ++n.hc;
             if (!lowval && !highval)
-                ++inrange;
+                ++n.inrange;
         }
-
-        if (lowcount)
-            *lowcount += lc;
-        if (highcount)
-            *highcount += hc;
-        if (inrangecount)
-            *inrangecount += inrange;
+    },
+        [](RangeCounts& r, const RangeCounts& n) {
+        r.lc += n.lc;
+        r.hc += n.hc;
+        r.inrange += n.inrange;
     });
+
+    if (lowcount)
+        *lowcount += totals.lc;
+    if (highcount)
+        *highcount += totals.hc;
+    if (inrangecount)
+        *inrangecount += totals.inrange;
     return true;
 }
 
@@ -872,6 +1040,51 @@ simplePixelHashSHA1(const ImageBuf& src, string_view extrainfo, ROI roi)
     return sha.digest();
 }
 
+
+
+// Serial XXH64 hash of the pixels in roi, with the extrainfo appended.
+// Like simplePixelHashSHA1, we process a few scanlines at a time; since
+// xxhash is exposed only as a one-shot function, the chunks are chained by
+// using each chunk's hash as the seed for the next. The digest is the final
+// 64-bit hash as 16 uppercase hex digits.
+std::string
+simplePixelHashXXH64(const ImageBuf& src, string_view extrainfo, ROI roi)
+{
+    if (!roi.defined())
+        roi = get_roi(src.spec());
+
+    bool localpixels           = src.localpixels();
+    imagesize_t scanline_bytes = roi.width() * src.spec().pixel_bytes();
+    OIIO_ASSERT(scanline_bytes < std::numeric_limits<unsigned int>::max());
+    // Do it a few scanlines at a time
+    int chunk = std::max(1, int(16 * 1024 * 1024 / scanline_bytes));
+
+    std::vector<unsigned char> tmp;
+    if (!localpixels)
+        tmp.resize(chunk * scanline_bytes);
+
+    unsigned long long h = 0;
+    for (int z = roi.zbegin, zend = roi.zend; z < zend; ++z) {
+        for (int y = roi.ybegin, yend = roi.yend; y < yend; y += chunk) {
+            int y1 = std::min(y + chunk, yend);
+            if (localpixels) {
+                h = xxhash::XXH64(src.pixeladdr(roi.xbegin, y, z),
+                                  size_t(scanline_bytes) * (y1 - y), h);
+            } else {
+                src.get_pixels(ROI(roi.xbegin, roi.xend, y, y1, z, z + 1),
+                               src.spec().format, &tmp[0]);
+                h = xxhash::XXH64(&tmp[0], size_t(scanline_bytes) * (y1 - y),
+                                  h);
+            }
+        }
+    }
+
+    // If extra info is specified, also include it in the hash
+    h = xxhash::XXH64(extrainfo.data(), extrainfo.size(), h);
+
+    return Strutil::fmt::format("{:016X}", (unsigned long long)h);
+}
+
 }  // namespace
 
 
@@ -913,6 +1126,53 @@ ImageBufAlgo::computePixelHashSHA1(const ImageBuf& src, string_view extrainfo,
 
 
 
+std::string
+ImageBufAlgo::computePixelHash(const ImageBuf& src, string_view extrainfo,
+                               string_view algorithm, ROI roi, int blocksize,
+                               int nthreads)
+{
+    if (Strutil::iequals(algorithm, "sha1")
+        || Strutil::iequals(algorithm, "sha-1"))
+        return computePixelHashSHA1(src, extrainfo, roi, blocksize, nthreads);
+
+    if (!Strutil::iequals(algorithm, "xxh64")
+        && !Strutil::iequals(algorithm, "xxhash")) {
+        src.errorfmt("computePixelHash: unknown algorithm \"{}\"", algorithm);
+        return std::string();
+    }
+
+    pvt::LoggedTimer logtimer("IBA::computePixelHash");
+    if (!roi.defined())
+        roi = get_roi(src.spec());
+
+    if (blocksize <= 0 || blocksize >= roi.height())
+        return simplePixelHashXXH64(src, extrainfo, roi);
+
+    // Tree mode: hash each blocksize batch of scanlines independently (and
+    // therefore in parallel), then hash the concatenated block digests.
+    // clang-format off
+    int nblocks = (roi.height() + blocksize - 1) / blocksize;
+    OIIO_ASSERT(nblocks > 1);
+    std::vector<std::string> results(nblocks);
+    parallel_for_chunked(roi.ybegin, roi.yend, blocksize,
+                         [&](int64_t ybegin, int64_t yend) {
+        int64_t b   = (ybegin - src.ybegin()) / blocksize;  // block number
+        ROI broi    = roi;
+        broi.ybegin = ybegin;
+        broi.yend   = yend;
+        results[b]  = simplePixelHashXXH64(src, "", broi);
+    }, nthreads);
+    // clang-format on
+
+    unsigned long long h = 0;
+    for (int b = 0; b < nblocks; ++b)
+        h = xxhash::XXH64(results[b].data(), results[b].size(), h);
+    h = xxhash::XXH64(extrainfo.data(), extrainfo.size(), h);
+    return Strutil::fmt::format("{:016X}", h);
+}
+
+
+
 template<class Atype>
 static bool
 histogram_impl(const ImageBuf& src, int channel, std::vector<imagesize_t>& hist,
@@ -925,14 +1185,68 @@ histogram_impl(const ImageBuf& src, int channel, std::vector<imagesize_t>& hist,
         return false;
     }
 
-    std::mutex mutex;  // thread safety for the histogram result
-
-    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+    ImageBufAlgo::parallel_reduce(roi, parallel_options(nthreads), hist,
+        [&](std::vector<imagesize_t>& h, ROI roi) {
         float ratio      = bins / (max - min);
         int bins_minus_1 = bins - 1;
 
-        // Compute histogram to thread-local h.
-        std::vector<imagesize_t> h(bins, 0);
+        // Compute histogram of this band to band-local h.
+        h.assign(bins, 0);
+        if (!ignore_empty && src.localpixels()
+            && std::is_same<Atype, unsigned char>::value) {
+            // 8-bit fast path: only 256 possible values, so precompute the
+            // bin index of each and histogram raw bytes through the LUT.
+            int nc = src.nchannels();
+            unsigned short lut[256];
+            for (int v = 0; v < 256; ++v) {
+                float fv = clamp(v * (1.0f / 255.0f), min, max);
+                lut[v] = (unsigned short)clamp(int((fv - min) * ratio), 0,
+                                               bins_minus_1);
+            }
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    const unsigned char* p
+                        = (const unsigned char*)src.pixeladdr(roi.xbegin, y, z)
+                          + channel;
+                    for (int x = 0, n = roi.width(); x < n; ++x)
+                        ++h[lut[p[x * nc]]];
+                }
+            return;
+        }
+        if (!ignore_empty && src.localpixels()
+            && std::is_same<Atype, float>::value) {
+            // float fast path: gather 8 channel values at a time and do the
+            // bin-index arithmetic (clamp, scale, truncate, clamp) in SIMD;
+            // only the final bin increments are scalar.
+            using namespace simd;
+            int nc         = src.nchannels();
+            vint8 chanidx  = vint8::Iota(0, nc);
+            vfloat8 vmin(min), vmax(max);
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    const float* p = (const float*)src.pixeladdr(roi.xbegin, y,
+                                                                 z)
+                                     + channel;
+                    int n = roi.width(), x = 0;
+                    for (; x + 8 <= n; x += 8) {
+                        vfloat8 v;
+                        v.gather(p + int64_t(x) * nc, chanidx);
+                        v = simd::min(simd::max(v, vmin), vmax);
+                        vint8 bi((v - vmin) * ratio);
+                        bi = simd::max(simd::min(bi, vint8(bins_minus_1)),
+                                       vint8(0));
+                        OIIO_SIMD8_ALIGN int ibuf[8];
+                        bi.store(ibuf);
+                        for (int i = 0; i < 8; ++i)
+                            ++h[ibuf[i]];
+                    }
+                    for (; x < n; ++x) {
+                        float val = clamp(p[x * nc], min, max);
+                        ++h[clamp(int((val - min) * ratio), 0, bins_minus_1)];
+                    }
+                }
+            return;
+        }
         for (ImageBuf::ConstIterator<Atype> a(src, roi); !a.done(); a++) {
             if (ignore_empty) {
                 bool allblack = true;
@@ -946,11 +1260,10 @@ histogram_impl(const ImageBuf& src, int channel, std::vector<imagesize_t>& hist,
             int i     = clamp(int((val - min) * ratio), 0, bins_minus_1);
             h[i] += 1;
         }
-
-        // Safely update the master histogram
-        lock_guard lock(mutex);
-        for (int i = 0; i < bins; ++i)
-            hist[i] += h[i];
+    },
+        [&](std::vector<imagesize_t>& r, const std::vector<imagesize_t>& h) {
+        for (int i = 0; i < bins && i < int(h.size()); ++i)
+            r[i] += h[i];
     });
     return true;
 }
@@ -1000,6 +1313,94 @@ ImageBufAlgo::histogram(const ImageBuf& src, int channel, int bins, float min,
 
 
 
+template<class Atype>
+static bool
+histogram_channels_impl(const ImageBuf& src,
+                        std::vector<std::vector<imagesize_t>>& hists, int bins,
+                        float min, float max, bool ignore_empty, ROI roi,
+                        int nthreads)
+{
+    // Double check A's type.
+    if (src.spec().format != BaseTypeFromC<Atype>::value) {
+        src.errorfmt("Unsupported pixel data format '{}'", src.spec().format);
+        return false;
+    }
+
+    int nchannels = roi.nchannels();
+    ImageBufAlgo::parallel_reduce(roi, parallel_options(nthreads), hists,
+        [&](std::vector<std::vector<imagesize_t>>& h, ROI roi) {
+        float ratio      = bins / (max - min);
+        int bins_minus_1 = bins - 1;
+
+        // One pass over the pixels, binning every channel as we go.
+        h.assign(nchannels, std::vector<imagesize_t>(bins, 0));
+        for (ImageBuf::ConstIterator<Atype> a(src, roi); !a.done(); a++) {
+            if (ignore_empty) {
+                bool allblack = true;
+                for (int c = roi.chbegin; c < roi.chend; ++c)
+                    allblack &= (a[c] == 0.0f);
+                if (allblack)
+                    continue;
+            }
+            for (int c = roi.chbegin; c < roi.chend; ++c) {
+                float val = a[c];
+                val       = clamp(val, min, max);
+                int i     = clamp(int((val - min) * ratio), 0, bins_minus_1);
+                h[c - roi.chbegin][i] += 1;
+            }
+        }
+    },
+        [&](std::vector<std::vector<imagesize_t>>& r,
+            const std::vector<std::vector<imagesize_t>>& h) {
+        for (int c = 0; c < nchannels && c < int(h.size()); ++c)
+            for (int i = 0; i < bins; ++i)
+                r[c][i] += h[c][i];
+    });
+    return true;
+}
+
+
+
+std::vector<std::vector<imagesize_t>>
+ImageBufAlgo::histogram_channels(const ImageBuf& src, int bins, float min,
+                                 float max, bool ignore_empty, ROI roi,
+                                 int nthreads)
+{
+    pvt::LoggedTimer logtimer("IBA::histogram_channels");
+    std::vector<std::vector<imagesize_t>> h;
+
+    // Sanity checks
+    if (src.nchannels() == 0) {
+        src.errorfmt("Input image must have at least 1 channel");
+        return h;
+    }
+    if (bins < 1) {
+        src.errorfmt("The number of bins must be at least 1");
+        return h;
+    }
+    if (max <= min) {
+        src.errorfmt("Invalid range, min must be strictly smaller than max");
+        return h;
+    }
+
+    // Specified ROI -> use it. Unspecified ROI -> initialize from src.
+    if (!roi.defined())
+        roi = get_roi(src.spec());
+    roi.chend = std::min(roi.chend, src.nchannels());
+
+    h.assign(roi.nchannels(), std::vector<imagesize_t>(bins, 0));
+    bool ok = true;
+    OIIO_DISPATCH_TYPES(ok, "histogram_channels", histogram_channels_impl,
+                        src.spec().format, src, h, bins, min, max, ignore_empty,
+                        roi, nthreads);
+
+    if (!ok && src.has_error())
+        h.clear();
+    return h;
+}
+
+
+
 /// histogram_impl -----------------------------------------------------------
 /// Fully type-specialized version of histogram.
 ///
@@ -14,6 +14,7 @@
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
+#include <OpenImageIO/simd.h>
 #include <OpenImageIO/thread.h>
 #include <OpenImageIO/timer.h>
 
@@ -29,6 +30,7 @@ template<class DSTTYPE>
 static bool
 flatten_(ImageBuf& dst, const ImageBuf& src, ROI roi, int nthreads)
 {
+    using namespace simd;
     ImageBufAlgo::parallel_image(roi, nthreads, [=, &dst, &src](ROI roi) {
         const ImageSpec& srcspec(src.spec());
         const DeepData* dd = src.deepdata();
@@ -41,16 +43,37 @@ flatten_(ImageBuf& dst, const ImageBuf& src, ROI roi, int nthreads)
         int R_channel      = srcspec.channelindex("R");
         int G_channel      = srcspec.channelindex("G");
         int B_channel      = srcspec.channelindex("B");
-        float* val         = OIIO_ALLOCA(float, nc);
+        // Pad the per-channel arrays to a vfloat8 boundary so the
+        // accumulation loop below needs no scalar tail; the pad lanes are
+        // computed but never read back.
+        int ncpad  = (nc + vfloat8::elements - 1) & ~(vfloat8::elements - 1);
+        float* val = OIIO_ALLOCA(float, ncpad);
+        float* v   = OIIO_ALLOCA(float, ncpad);
+        float* oma = OIIO_ALLOCA(float, ncpad);  // (1-a) per channel
         float& ARval(val[AR_channel]);
         float& AGval(val[AG_channel]);
         float& ABval(val[AB_channel]);
+        // Which accumulated alpha applies to each channel: R/G/B each use
+        // their own alpha, everything else the average alpha.
+        int* agroup = OIIO_ALLOCA(int, ncpad);
+        for (int c = 0; c < ncpad; ++c)
+            agroup[c] = (c == R_channel)   ? 0
+                        : (c == G_channel) ? 1
+                        : (c == B_channel) ? 2
+                                           : 3;
+        // If every channel is float data, a sample's values sit contiguous
+        // in memory and we can copy them out in one go instead of making a
+        // type-dispatched deep_value call per channel.
+        bool allfloat = true;
+        for (int c = 0; c < nc; ++c)
+            allfloat &= (dd->channeltype(c) == TypeDesc::FLOAT);
 
         for (ImageBuf::Iterator<DSTTYPE> r(dst, roi); !r.done(); ++r) {
             int x = r.x(), y = r.y(), z = r.z();
-            int samps = src.deep_samples(x, y, z);
+            int pixel = src.pixelindex(x, y, z, true);
+            int samps = dd->samples(pixel);
             // Clear accumulated values for this pixel (0 for colors, big for Z)
-            memset(val, 0, nc * sizeof(float));
+            memset(val, 0, ncpad * sizeof(float));
             if (Z_channel >= 0 && samps == 0)
                 val[Z_channel] = 1.0e30;
             if (Zback_channel >= 0 && samps == 0)
@@ -60,20 +83,25 @@ flatten_(ImageBuf& dst, const ImageBuf& src, ROI roi, int nthreads)
                 float alpha = (AR + AG + AB) / 3.0f;
                 if (alpha >= 1.0f)
                     break;
-                for (int c = 0; c < nc; ++c) {
-                    float v = src.deep_value(x, y, z, c, s);
-                    if (c == Z_channel || c == Zback_channel)
-                        val[c] *= alpha;  // because Z are not premultiplied
-                    float a;
-                    if (c == R_channel)
-                        a = AR;
-                    else if (c == G_channel)
-                        a = AG;
-                    else if (c == B_channel)
-                        a = AB;
-                    else
-                        a = alpha;
-                    val[c] += (1.0f - a) * v;
+                // Gather this sample's channel values
+                if (allfloat)
+                    memcpy(v, dd->data_ptr(pixel, 0, s), nc * sizeof(float));
+                else
+                    for (int c = 0; c < nc; ++c)
+                        v[c] = dd->deep_value(pixel, c, s);
+                // Z values are not premultiplied, so scale the accumulators
+                if (Z_channel >= 0)
+                    val[Z_channel] *= alpha;
+                if (Zback_channel >= 0)
+                    val[Zback_channel] *= alpha;
+                // val[c] += (1-a[c]) * v[c] for all channels, 8 at a time
+                const float oma4[4] = { 1.0f - AR, 1.0f - AG, 1.0f - AB,
+                                        1.0f - alpha };
+                for (int c = 0; c < ncpad; ++c)
+                    oma[c] = oma4[agroup[c]];
+                for (int c = 0; c < ncpad; c += vfloat8::elements) {
+                    vfloat8 vv(v + c), vval(val + c), voma(oma + c);
+                    madd(voma, vv, vval).store(val + c);
                 }
             }
 
@@ -266,84 +294,107 @@ ImageBufAlgo::deep_merge(ImageBuf& dst, const ImageBuf& A, const ImageBuf& B,
     int Azbackchan = Add.Zback_channel();
     int Bzchan     = Bdd.Z_channel();
     int Bzbackchan = Bdd.Zback_channel();
-    for (int z = roi.zbegin; z < roi.zend; ++z)
-        for (int y = roi.ybegin; y < roi.yend; ++y)
-            for (int x = roi.xbegin; x < roi.xend; ++x) {
-                int dstpixel            = dst.pixelindex(x, y, z, true);
-                int Apixel              = A.pixelindex(x, y, z, true);
-                int Bpixel              = B.pixelindex(x, y, z, true);
-                int Asamps              = Add.samples(Apixel);
-                int Bsamps              = Bdd.samples(Bpixel);
-                int nsplits             = 0;
-                int self_overlap_splits = 0;
-                for (int s = 0; s < Asamps; ++s) {
-                    float src_z     = Add.deep_value(Apixel, Azchan, s);
-                    float src_zback = Add.deep_value(Apixel, Azbackchan, s);
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        // Fetch each pixel's Z/Zback into flat arrays up front, so that
+        // the O(samples^2) split-counting loops below compare contiguous
+        // floats (which the compiler can vectorize) rather than making a
+        // type-dispatched deep_value call per comparison.
+        std::vector<float> Az, Azback, Bz, Bzback;
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int y = roi.ybegin; y < roi.yend; ++y)
+                for (int x = roi.xbegin; x < roi.xend; ++x) {
+                    int dstpixel = dst.pixelindex(x, y, z, true);
+                    int Apixel   = A.pixelindex(x, y, z, true);
+                    int Bpixel   = B.pixelindex(x, y, z, true);
+                    int Asamps   = Add.samples(Apixel);
+                    int Bsamps   = Bdd.samples(Bpixel);
+                    Az.resize(Asamps);
+                    Azback.resize(Asamps);
+                    Bz.resize(Bsamps);
+                    Bzback.resize(Bsamps);
+                    for (int s = 0; s < Asamps; ++s) {
+                        Az[s]     = Add.deep_value(Apixel, Azchan, s);
+                        Azback[s] = Add.deep_value(Apixel, Azbackchan, s);
+                    }
                     for (int d = 0; d < Bsamps; ++d) {
-                        float dst_z     = Bdd.deep_value(Bpixel, Bzchan, d);
-                        float dst_zback = Bdd.deep_value(Bpixel, Bzbackchan, d);
-                        if (src_z > dst_z && src_z < dst_zback)
-                            ++nsplits;
-                        if (src_zback > dst_z && src_zback < dst_zback)
-                            ++nsplits;
-                        if (dst_z > src_z && dst_z < src_zback)
-                            ++nsplits;
-                        if (dst_zback > src_z && dst_zback < src_zback)
-                            ++nsplits;
+                        Bz[d]     = Bdd.deep_value(Bpixel, Bzchan, d);
+                        Bzback[d] = Bdd.deep_value(Bpixel, Bzbackchan, d);
                     }
-                    // Check for splits src vs src -- in case they overlap!
-                    for (int ss = s; ss < Asamps; ++ss) {
-                        float src_z2     = Add.deep_value(Apixel, Azchan, ss);
-                        float src_zback2 = Add.deep_value(Apixel, Azbackchan,
-                                                          ss);
-                        if (src_z2 > src_z && src_z2 < src_zback)
-                            ++self_overlap_splits;
-                        if (src_zback2 > src_z && src_zback2 < src_zback)
-                            ++self_overlap_splits;
-                        if (src_z > src_z2 && src_z < src_zback2)
-                            ++self_overlap_splits;
-                        if (src_zback > src_z2 && src_zback < src_zback2)
-                            ++self_overlap_splits;
+                    int nsplits             = 0;
+                    int self_overlap_splits = 0;
+                    for (int s = 0; s < Asamps; ++s) {
+                        float src_z     = Az[s];
+                        float src_zback = Azback[s];
+                        for (int d = 0; d < Bsamps; ++d) {
+                            float dst_z     = Bz[d];
+                            float dst_zback = Bzback[d];
+                            nsplits += int(src_z > dst_z && src_z < dst_zback);
+                            nsplits += int(src_zback > dst_z
+                                           && src_zback < dst_zback);
+                            nsplits += int(dst_z > src_z && dst_z < src_zback);
+                            nsplits += int(dst_zback > src_z
+                                           && dst_zback < src_zback);
+                        }
+                        // Check for splits src vs src -- in case they overlap!
+                        for (int ss = s; ss < Asamps; ++ss) {
+                            float src_z2     = Az[ss];
+                            float src_zback2 = Azback[ss];
+                            self_overlap_splits
+                                += int(src_z2 > src_z && src_z2 < src_zback);
+                            self_overlap_splits += int(src_zback2 > src_z
+                                                       && src_zback2
+                                                              < src_zback);
+                            self_overlap_splits
+                                += int(src_z > src_z2 && src_z < src_zback2);
+                            self_overlap_splits += int(src_zback > src_z2
+                                                       && src_zback
+                                                              < src_zback2);
+                        }
                     }
-                }
-                // Check for splits dst vs dst -- in case they overlap!
-                for (int d = 0; d < Bsamps; ++d) {
-                    float dst_z     = Bdd.deep_value(Bpixel, Bzchan, d);
-                    float dst_zback = Bdd.deep_value(Bpixel, Bzbackchan, d);
-                    for (int dd = d; dd < Bsamps; ++dd) {
-                        float dst_z2     = Bdd.deep_value(Bpixel, Bzchan, dd);
-                        float dst_zback2 = Bdd.deep_value(Bpixel, Bzbackchan,
-                                                          dd);
-                        if (dst_z2 > dst_z && dst_z2 < dst_zback)
-                            ++self_overlap_splits;
-                        if (dst_zback2 > dst_z && dst_zback2 < dst_zback)
-                            ++self_overlap_splits;
-                        if (dst_z > dst_z2 && dst_z < dst_zback2)
-                            ++self_overlap_splits;
-                        if (dst_zback > dst_z2 && dst_zback < dst_zback2)
-                            ++self_overlap_splits;
+                    // Check for splits dst vs dst -- in case they overlap!
+                    for (int d = 0; d < Bsamps; ++d) {
+                        float dst_z     = Bz[d];
+                        float dst_zback = Bzback[d];
+                        for (int dd = d; dd < Bsamps; ++dd) {
+                            float dst_z2     = Bz[dd];
+                            float dst_zback2 = Bzback[dd];
+                            self_overlap_splits
+                                += int(dst_z2 > dst_z && dst_z2 < dst_zback);
+                            self_overlap_splits += int(dst_zback2 > dst_z
+                                                       && dst_zback2
+                                                              < dst_zback);
+                            self_overlap_splits
+                                += int(dst_z > dst_z2 && dst_z < dst_zback2);
+                            self_overlap_splits += int(dst_zback > dst_z2
+                                                       && dst_zback
+                                                              < dst_zback2);
+                        }
                     }
-                }
 
-                dstdd.set_capacity(dstpixel, Asamps + Bsamps + nsplits
-                                                 + self_overlap_splits);
-            }
+                    dstdd.set_capacity(dstpixel, Asamps + Bsamps + nsplits
+                                                     + self_overlap_splits);
+                }
+    });
 
     bool ok = ImageBufAlgo::copy(dst, A, TypeDesc::UNKNOWN, roi, nthreads);
 
-    for (int z = roi.zbegin; z < roi.zend; ++z)
-        for (int y = roi.ybegin; y < roi.yend; ++y)
-            for (int x = roi.xbegin; x < roi.xend; ++x) {
-                int dstpixel = dst.pixelindex(x, y, z, true);
-                int Bpixel   = B.pixelindex(x, y, z, true);
-                OIIO_DASSERT(dstpixel >= 0);
-                // OIIO_UNUSED_OK int oldcap = dstdd.capacity (dstpixel);
-                dstdd.merge_deep_pixels(dstpixel, Bdd, Bpixel);
-                // OIIO_DASSERT (oldcap == dstdd.capacity(dstpixel) &&
-                //          "Broken: we did not preallocate enough capacity");
-                if (occlusion_cull)
-                    dstdd.occlusion_cull(dstpixel);
-            }
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        // Merging alters only the dst pixel's own samples (we reserved
+        // capacity above), so separate pixels can proceed concurrently.
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int y = roi.ybegin; y < roi.yend; ++y)
+                for (int x = roi.xbegin; x < roi.xend; ++x) {
+                    int dstpixel = dst.pixelindex(x, y, z, true);
+                    int Bpixel   = B.pixelindex(x, y, z, true);
+                    OIIO_DASSERT(dstpixel >= 0);
+                    // OIIO_UNUSED_OK int oldcap = dstdd.capacity (dstpixel);
+                    dstdd.merge_deep_pixels(dstpixel, Bdd, Bpixel);
+                    // OIIO_DASSERT (oldcap == dstdd.capacity(dstpixel) &&
+                    //          "Broken: we did not preallocate enough capacity");
+                    if (occlusion_cull)
+                        dstdd.occlusion_cull(dstpixel);
+                }
+    });
     return ok;
 }
 
@@ -364,7 +415,7 @@ ImageBufAlgo::deep_merge(const ImageBuf& A, const ImageBuf& B,
 
 bool
 ImageBufAlgo::deep_holdout(ImageBuf& dst, const ImageBuf& src,
-                           const ImageBuf& thresh, ROI roi, int /*nthreads*/)
+                           const ImageBuf& thresh, ROI roi, int nthreads)
 {
     pvt::LoggedTimer logtime("IBA::deep_holdout");
     if (!src.deep() || !thresh.deep()) {
@@ -396,37 +447,45 @@ ImageBufAlgo::deep_holdout(ImageBuf& dst, const ImageBuf& src,
     int Zchan     = dstdd.Z_channel();
     int Zbackchan = dstdd.Zback_channel();
     const DeepData& threshdd(*thresh.deepdata());
-    for (ImageBuf::Iterator<float> r(dst, roi); !r.done(); ++r) {
-        int x = r.x(), y = r.y(), z = r.z();
-        int srcpixel = src.pixelindex(x, y, z, true);
-        if (srcpixel < 0)
-            continue;  // Nothing in this pixel
-        int dstpixel = dst.pixelindex(x, y, z, true);
-        dstdd.copy_deep_pixel(dstpixel, srcdd, srcpixel);
-        int threshpixel = thresh.pixelindex(x, y, z, true);
-        if (threshpixel < 0)
-            continue;  // No threshold mask for this pixel
-        float zthresh = threshdd.opaque_z(threshpixel);
-        // Eliminate the samples that are entirely beyond the depth
-        // threshold. Do this before the split; that makes it less
-        // likely that the split will force a re-allocation.
-        for (int s = 0, n = dstdd.samples(dstpixel); s < n; ++s) {
-            if (dstdd.deep_value(dstpixel, Zchan, s) > zthresh) {
-                dstdd.set_samples(dstpixel, s);
-                break;
-            }
-        }
-        // Now split any samples that straddle the z.
-        if (dstdd.split(dstpixel, zthresh)) {
-            // If a split did occur, do another discard pass.
-            for (int s = 0, n = dstdd.samples(dstpixel); s < n; ++s) {
-                if (dstdd.deep_value(dstpixel, Zbackchan, s) > zthresh) {
-                    dstdd.set_samples(dstpixel, s);
-                    break;
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        // Each iteration touches only its own dst pixel, so pixels can
+        // be computed concurrently.
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int y = roi.ybegin; y < roi.yend; ++y)
+                for (int x = roi.xbegin; x < roi.xend; ++x) {
+                    int srcpixel = src.pixelindex(x, y, z, true);
+                    if (srcpixel < 0)
+                        continue;  // Nothing in this pixel
+                    int dstpixel = dst.pixelindex(x, y, z, true);
+                    dstdd.copy_deep_pixel(dstpixel, srcdd, srcpixel);
+                    int threshpixel = thresh.pixelindex(x, y, z, true);
+                    if (threshpixel < 0)
+                        continue;  // No threshold mask for this pixel
+                    float zthresh = threshdd.opaque_z(threshpixel);
+                    // Eliminate the samples that are entirely beyond the
+                    // depth threshold. Do this before the split; that
+                    // makes it less likely that the split will force a
+                    // re-allocation.
+                    for (int s = 0, n = dstdd.samples(dstpixel); s < n; ++s) {
+                        if (dstdd.deep_value(dstpixel, Zchan, s) > zthresh) {
+                            dstdd.set_samples(dstpixel, s);
+                            break;
+                        }
+                    }
+                    // Now split any samples that straddle the z.
+                    if (dstdd.split(dstpixel, zthresh)) {
+                        // If a split did occur, do another discard pass.
+                        for (int s = 0, n = dstdd.samples(dstpixel); s < n;
+                             ++s) {
+                            if (dstdd.deep_value(dstpixel, Zbackchan, s)
+                                > zthresh) {
+                                dstdd.set_samples(dstpixel, s);
+                                break;
+                            }
+                        }
+                    }
                 }
-            }
-        }
-    }
+    });
     return true;
 }
 
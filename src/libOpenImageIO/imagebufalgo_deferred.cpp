@@ -0,0 +1,249 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+/// \file
+/// Deferred, fused execution of chains of element-wise ImageBufAlgo
+/// operations.  See the ImageBufAlgo::Deferred class comment in
+/// imagebufalgo.h.
+
+#include <cmath>
+#include <vector>
+
+#include <OpenImageIO/dassert.h>
+#include <OpenImageIO/imagebuf.h>
+#include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/imagebufalgo_util.h>
+
+#include "imageio_pvt.h"
+
+
+OIIO_NAMESPACE_BEGIN
+
+namespace {
+
+// One recorded stage of a deferred chain: the operation plus its constant
+// operands as supplied by the caller (padded to the channel count only at
+// execute() time).
+struct Stage {
+    enum Op { Add, Sub, Mul, Mad, Pow, Clamp, Invert, Abs };
+    Op op;
+    std::vector<float> a, b;
+};
+
+}  // anonymous namespace
+
+
+struct ImageBufAlgo::Deferred::Impl {
+    const ImageBuf* src;
+    std::vector<Stage> stages;
+};
+
+
+
+// Pad per-channel constants to exactly n entries, replicating the last
+// supplied value (or 0 if none were supplied), the same convention as
+// IBA_FIX_PERCHAN_LEN_DEF uses for the immediate operations.
+static void
+pad_perchan(std::vector<float>& v, int n)
+{
+    float fill = v.size() ? v.back() : 0.0f;
+    while ((int)v.size() < n)
+        v.push_back(fill);
+}
+
+
+
+template<class Rtype, class Atype>
+static bool
+deferred_impl(ImageBuf& R, const ImageBuf& A, const std::vector<Stage>& stages,
+              ROI roi, int nthreads)
+{
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        float* vals = OIIO_ALLOCA(float, roi.chend);
+        ImageBuf::Iterator<Rtype> r(R, roi);
+        ImageBuf::ConstIterator<Atype> a(A, roi);
+        for (; !r.done(); ++r, ++a) {
+            for (int c = roi.chbegin; c < roi.chend; ++c)
+                vals[c] = a[c];
+            // The whole chain runs on the in-register values; the source
+            // is read once and the result written once, no matter how
+            // many stages were recorded.
+            for (const Stage& s : stages) {
+                switch (s.op) {
+                case Stage::Add:
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        vals[c] += s.a[c];
+                    break;
+                case Stage::Sub:
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        vals[c] -= s.a[c];
+                    break;
+                case Stage::Mul:
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        vals[c] *= s.a[c];
+                    break;
+                case Stage::Mad:
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        vals[c] = vals[c] * s.a[c] + s.b[c];
+                    break;
+                case Stage::Pow:
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        vals[c] = std::pow(vals[c], s.a[c]);
+                    break;
+                case Stage::Clamp:
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        vals[c] = OIIO::clamp(vals[c], s.a[c], s.b[c]);
+                    break;
+                case Stage::Invert:
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        vals[c] = 1.0f - vals[c];
+                    break;
+                case Stage::Abs:
+                    for (int c = roi.chbegin; c < roi.chend; ++c)
+                        vals[c] = fabsf(vals[c]);
+                    break;
+                }
+            }
+            for (int c = roi.chbegin; c < roi.chend; ++c)
+                r[c] = vals[c];
+        }
+    });
+    return true;
+}
+
+
+
+ImageBufAlgo::Deferred::Deferred(const ImageBuf& src)
+    : m_impl(new Impl)
+{
+    m_impl->src = &src;
+}
+
+
+
+ImageBufAlgo::Deferred::~Deferred() {}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::add(cspan<float> val)
+{
+    m_impl->stages.push_back(
+        { Stage::Add, { val.begin(), val.end() }, {} });
+    return *this;
+}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::sub(cspan<float> val)
+{
+    m_impl->stages.push_back(
+        { Stage::Sub, { val.begin(), val.end() }, {} });
+    return *this;
+}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::mul(cspan<float> val)
+{
+    m_impl->stages.push_back(
+        { Stage::Mul, { val.begin(), val.end() }, {} });
+    return *this;
+}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::div(cspan<float> val)
+{
+    // Record division by a constant as multiplication by its reciprocal,
+    // with the usual IBA convention that x/0 yields 0.
+    std::vector<float> recip(val.begin(), val.end());
+    for (float& v : recip)
+        v = (v == 0.0f) ? 0.0f : 1.0f / v;
+    m_impl->stages.push_back({ Stage::Mul, std::move(recip), {} });
+    return *this;
+}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::mad(cspan<float> a, cspan<float> b)
+{
+    m_impl->stages.push_back(
+        { Stage::Mad, { a.begin(), a.end() }, { b.begin(), b.end() } });
+    return *this;
+}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::pow(cspan<float> p)
+{
+    m_impl->stages.push_back(
+        { Stage::Pow, { p.begin(), p.end() }, {} });
+    return *this;
+}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::clamp(cspan<float> min, cspan<float> max)
+{
+    m_impl->stages.push_back(
+        { Stage::Clamp, { min.begin(), min.end() }, { max.begin(), max.end() } });
+    return *this;
+}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::invert()
+{
+    m_impl->stages.push_back({ Stage::Invert, {}, {} });
+    return *this;
+}
+
+
+
+ImageBufAlgo::Deferred&
+ImageBufAlgo::Deferred::abs()
+{
+    m_impl->stages.push_back({ Stage::Abs, {}, {} });
+    return *this;
+}
+
+
+
+ImageBuf
+ImageBufAlgo::Deferred::execute(ROI roi, int nthreads)
+{
+    pvt::LoggedTimer logtime("IBA::deferred");
+    const ImageBuf& A(*m_impl->src);
+    ImageBuf dst;
+    if (!IBAprep(roi, &dst, &A))
+        return dst;
+    roi.chend = std::min(roi.chend, A.nchannels());
+
+    // Pad every stage's constants to the channel range once, up front,
+    // so the inner loop can index them unconditionally.
+    std::vector<Stage> stages(m_impl->stages);
+    for (Stage& s : stages) {
+        pad_perchan(s.a, roi.chend);
+        pad_perchan(s.b, roi.chend);
+    }
+
+    bool ok;
+    OIIO_DISPATCH_COMMON_TYPES2(ok, "deferred", deferred_impl,
+                                dst.spec().format, A.spec().format, dst, A,
+                                stages, roi, nthreads);
+    if (!ok && !dst.has_error())
+        dst.errorfmt("ImageBufAlgo::Deferred::execute error");
+    return dst;
+}
+
+
+OIIO_NAMESPACE_END
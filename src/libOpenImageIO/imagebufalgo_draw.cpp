@@ -5,7 +5,9 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <map>
 #include <set>
+#include <tuple>
 #include <unordered_map>
 
 #include <OpenImageIO/half.h>
@@ -17,6 +19,7 @@
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
+#include <OpenImageIO/simd.h>
 #include <OpenImageIO/sysutil.h>
 #include <OpenImageIO/thread.h>
 
@@ -547,6 +550,74 @@ hashrand(int x, int y, int z, int c, int seed)
 }
 
 
+// Eight lanes of hashrand for 8 consecutive x positions, using a
+// vectorized bjfinal. This is a counter-based generator -- the value is
+// a pure function of (x,y,z,c,seed) -- so it is bit-identical to eight
+// scalar hashrand calls, deterministic, and trivially parallel.
+OIIO_FORCEINLINE simd::vfloat8
+hashrand8(const simd::vint8& x, int y, int z, int c, int seed)
+{
+    using namespace simd;
+    const uint32_t magic = 0xfffff;
+    auto vbjfinal = [](vint8 a, vint8 b, vint8 c) {
+        // Same mixing as bjhash::bjfinal, 8 lanes wide.
+        // clang-format off
+        c ^= b; c -= rotl(b,14);
+        a ^= c; a -= rotl(c,11);
+        b ^= a; b -= rotl(a,25);
+        c ^= b; c -= rotl(b,16);
+        a ^= c; a -= rotl(c,4);
+        b ^= a; b -= rotl(a,14);
+        c ^= b; c -= rotl(b,24);
+        // clang-format on
+        return c;
+    };
+    vint8 h = vbjfinal(vbjfinal(x, vint8(y), vint8(z)), vint8(c), vint8(seed));
+    h &= vint8(int(magic));
+    return vfloat8(h) * (1.0f / (magic + 1));
+}
+
+
+// Eight lanes of normal-distributed values via the Acklam rational
+// approximation of the inverse normal CDF (max relative error ~1.2e-9,
+// far below what's visible in grain). Unlike the Marsaglia polar method
+// used by scalar hashnormal, this has no rejection loop, so it maps
+// cleanly onto SIMD: one uniform draw per output value, a polynomial for
+// the central region, and a sqrt(-2 log u) form for the tails, blended
+// with lane masks.
+OIIO_FORCEINLINE simd::vfloat8
+hashnormal8(const simd::vint8& x, int y, int z, int c, int seed)
+{
+    using namespace simd;
+    // Nudge the uniform draw to the bin center so u is strictly in (0,1)
+    // and the tail logs can never see zero.
+    vfloat8 u = hashrand8(x, y, z, c, seed) + (0.5f / 0x100000);
+    const float plow = 0.02425f;
+    vfloat8 q        = u - 0.5f;
+    // Central region: rational polynomial in q^2.
+    vfloat8 r  = q * q;
+    vfloat8 xc = (((((-3.969683028665376e+01f * r + 2.209460984245205e+02f) * r
+                     - 2.759285104469687e+02f) * r + 1.383577518672690e+02f) * r
+                   - 3.066479806614716e+01f) * r + 2.506628277459239e+00f)
+                 * q
+                 / (((((-5.447609879822406e+01f * r + 1.615858368580409e+02f) * r
+                       - 1.556989798598866e+02f) * r + 6.680131188771972e+01f) * r
+                     - 1.328068155288572e+01f) * r + 1.0f);
+    // Tails: fold the upper tail onto the lower and negate afterward.
+    vbool8 lower = u < plow;
+    vbool8 upper = u > (1.0f - plow);
+    vfloat8 t    = sqrt(-2.0f * log(select(lower, u, 1.0f - u)));
+    vfloat8 xt   = (((((-7.784894002430293e-03f * t - 3.223964580411365e-01f) * t
+                     - 2.400758277161838e+00f) * t - 2.549732539343734e+00f) * t
+                   + 4.374664141464968e+00f) * t + 2.938163982698783e+00f)
+                 / ((((7.784695709041462e-03f * t + 3.224671290700398e-01f) * t
+                      + 2.445134137142996e+00f) * t + 3.754408661907416e+00f) * t
+                    + 1.0f);
+    xt = select(upper, -xt, xt);
+    return select(lower | upper, xt, xc);
+}
+
+
 // Return a hash-based normal-distributed pseudorandom value.
 // We use the Marsaglia polar method, and hashrand to
 OIIO_FORCEINLINE float
@@ -566,11 +637,57 @@ hashnormal(int x, int y, int z, int c, int seed)
 
 
 
+// SIMD scanline kernel for uniform/gaussian noise on float buffers with
+// local pixels: generate 8 values at a time with the lane-parallel hash
+// and add them to the interleaved channels with scalar stores (the RNG,
+// not the store, is the expensive part).
+template<bool gaussian>
+static void
+noise_simd_scanlines_(ImageBuf& dst, float A, float B, bool mono, int seed,
+                      ROI roi)
+{
+    using namespace simd;
+    int nc = dst.nchannels();
+    for (int z = roi.zbegin; z < roi.zend; ++z) {
+        for (int y = roi.ybegin; y < roi.yend; ++y) {
+            float* pix = (float*)dst.pixeladdr(roi.xbegin, y, z);
+            for (int x = roi.xbegin; x < roi.xend; x += 8, pix += 8 * nc) {
+                int nlanes = std::min(8, roi.xend - x);
+                vint8 xv   = vint8::Iota(x);
+                OIIO_SIMD8_ALIGN float nbuf[8];
+                for (int c = roi.chbegin; c < roi.chend; ++c) {
+                    if (c == roi.chbegin || !mono) {
+                        vfloat8 n;
+                        if (gaussian)
+                            n = A + B * hashnormal8(xv, y, z, c, seed);
+                        else
+                            n = lerp(vfloat8(A), vfloat8(B),
+                                     hashrand8(xv, y, z, c, seed));
+                        n.store(nbuf);
+                    }
+                    for (int i = 0; i < nlanes; ++i)
+                        pix[i * nc + c] += nbuf[i];
+                }
+            }
+        }
+    }
+}
+
+
+
 template<typename T>
 static bool
 noise_uniform_(ImageBuf& dst, float min, float max, bool mono, int seed,
                ROI roi, int nthreads)
 {
+    if (std::is_same<T, float>::value && dst.localpixels()) {
+        // Vectorized path: identical values to the scalar hash below,
+        // 8 pixels per iteration.
+        ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+            noise_simd_scanlines_<false>(dst, min, max, mono, seed, roi);
+        });
+        return true;
+    }
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         for (ImageBuf::Iterator<T> p(dst, roi); !p.done(); ++p) {
             int x = p.x(), y = p.y(), z = p.z();
@@ -592,6 +709,16 @@ static bool
 noise_gaussian_(ImageBuf& dst, float mean, float stddev, bool mono, int seed,
                 ROI roi, int nthreads)
 {
+    if (std::is_same<T, float>::value && dst.localpixels()) {
+        // Vectorized path. Note: draws the normal variate via the
+        // inverse-CDF transform rather than the Marsaglia rejection loop
+        // below, so the grain pattern differs from the scalar path (but
+        // is just as deterministic for a given seed).
+        ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+            noise_simd_scanlines_<true>(dst, mean, stddev, mono, seed, roi);
+        });
+        return true;
+    }
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         for (ImageBuf::Iterator<T> p(dst, roi); !p.done(); ++p) {
             int x = p.x(), y = p.y(), z = p.z();
@@ -887,33 +1014,92 @@ static const char* default_font_name[] = { "DroidSans", "cour", "Courier New",
 
 
 
+// A pre-rasterized glyph: coverage bitmap plus the metrics needed to
+// position it and advance the pen.
+struct GlyphBitmap {
+    int left = 0, top = 0;        // bearing of the bitmap from the pen
+    int width = 0, rows = 0;      // bitmap dimensions
+    int advance_x = 0;            // pen advance, in pixels
+    std::vector<float> coverage;  // width*rows coverage values in [0,1]
+};
+
+
+// Process-wide cache of opened font faces, keyed by resolved font file.
+// Faces stay open for the life of the process. Like all FreeType state,
+// guarded by ft_mutex (held by the caller).
+static FT_Face
+get_font_face(const std::string& font)
+{
+    static std::map<std::string, FT_Face> face_map;
+    auto it = face_map.find(font);
+    if (it != face_map.end())
+        return it->second;
+    FT_Face face = nullptr;
+    if (FT_New_Face(ft_library, font.c_str(), 0 /* face index */, &face))
+        return nullptr;
+    face_map[font] = face;
+    return face;
+}
+
+
+// Look up the rasterized bitmap of character `ch` of the given font and
+// pixel size in the process-wide glyph cache, rasterizing through
+// FreeType (and caching the result) only on the first request. Repeatedly
+// stamping the same slates/burn-ins then reduces to blits of the cached
+// coverage bitmaps. The face must already be set to `fontsize`; ft_mutex
+// must be held. Returns nullptr if the glyph can't be rasterized.
+static const GlyphBitmap*
+get_glyph(FT_Face face, const std::string& font, int fontsize, uint32_t ch)
+{
+    static std::map<std::tuple<std::string, int, uint32_t>, GlyphBitmap>
+        glyph_cache;
+    auto key = std::make_tuple(font, fontsize, ch);
+    auto it  = glyph_cache.find(key);
+    if (it != glyph_cache.end())
+        return &it->second;
+    if (FT_Load_Char(face, ch, FT_LOAD_RENDER))
+        return nullptr;  // ignore errors
+    FT_GlyphSlot slot = face->glyph;
+    GlyphBitmap g;
+    g.left      = slot->bitmap_left;
+    g.top       = slot->bitmap_top;
+    g.width     = int(slot->bitmap.width);
+    g.rows      = int(slot->bitmap.rows);
+    g.advance_x = int(slot->advance.x >> 6);
+    g.coverage.resize(size_t(g.width) * g.rows);
+    for (int j = 0; j < g.rows; ++j)
+        for (int i = 0; i < g.width; ++i)
+            g.coverage[j * g.width + i]
+                = slot->bitmap.buffer[slot->bitmap.pitch * j + i] / 255.0f;
+    return &glyph_cache.emplace(key, std::move(g)).first->second;
+}
+
+
 // Helper: given unicode and a font face, compute its size
 static ROI
-text_size_from_unicode(cspan<uint32_t> utext, FT_Face face, int fontsize)
+text_size_from_unicode(cspan<uint32_t> utext, FT_Face face,
+                       const std::string& font, int fontsize)
 {
     int y = 0;
     int x = 0;
     ROI size;
     size.xbegin = size.ybegin = std::numeric_limits<int>::max();
     size.xend = size.yend = std::numeric_limits<int>::min();
-    FT_GlyphSlot slot     = face->glyph;
     for (auto ch : utext) {
         if (ch == '\n') {
             x = 0;
             y += fontsize;
             continue;
         }
-        int error = FT_Load_Char(face, ch, FT_LOAD_RENDER);
-        if (error)
+        const GlyphBitmap* g = get_glyph(face, font, fontsize, ch);
+        if (!g)
             continue;  // ignore errors
-        size.ybegin = std::min(size.ybegin, y - slot->bitmap_top);
-        size.yend   = std::max(size.yend, y + int(slot->bitmap.rows)
-                                              - int(slot->bitmap_top) + 1);
-        size.xbegin = std::min(size.xbegin, x + int(slot->bitmap_left));
-        size.xend   = std::max(size.xend, x + int(slot->bitmap.width)
-                                              + int(slot->bitmap_left) + 1);
+        size.ybegin = std::min(size.ybegin, y - g->top);
+        size.yend   = std::max(size.yend, y + g->rows - g->top + 1);
+        size.xbegin = std::min(size.xbegin, x + g->left);
+        size.xend   = std::max(size.xend, x + g->width + g->left + 1);
         // increment pen position
-        x += slot->advance.x >> 6;
+        x += g->advance_x;
     }
     return size;  // Font rendering not supported
 }
@@ -999,26 +1185,21 @@ ImageBufAlgo::text_size(string_view text, int fontsize, string_view font_)
         return size;
     }
 
-    int error = 0;
-    FT_Face face;  // handle to face object
-    error = FT_New_Face(ft_library, font.c_str(), 0 /* face index */, &face);
-    if (error) {
+    FT_Face face = get_font_face(font);
+    if (!face) {
         return size;  // couldn't open the face
     }
 
-    error = FT_Set_Pixel_Sizes(face /*handle*/, 0 /*width*/,
-                               fontsize /*height*/);
+    int error = FT_Set_Pixel_Sizes(face /*handle*/, 0 /*width*/,
+                                   fontsize /*height*/);
     if (error) {
-        FT_Done_Face(face);
         return size;  // couldn't set the character size
     }
 
     std::vector<uint32_t> utext;
     utext.reserve(text.size());
     Strutil::utf8_to_unicode(text, utext);
-    size = text_size_from_unicode(utext, face, fontsize);
-
-    FT_Done_Face(face);
+    size = text_size_from_unicode(utext, face, font, fontsize);
 #endif
 
     return size;  // Font rendering not supported
@@ -1051,23 +1232,19 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
         return false;
     }
 
-    int error = 0;
-    FT_Face face;  // handle to face object
-    error = FT_New_Face(ft_library, font.c_str(), 0 /* face index */, &face);
-    if (error) {
+    FT_Face face = get_font_face(font);
+    if (!face) {
         R.errorfmt("Could not set font face to \"{}\"", font);
         return false;  // couldn't open the face
     }
 
-    error = FT_Set_Pixel_Sizes(face /*handle*/, 0 /*width*/,
-                               fontsize /*height*/);
+    int error = FT_Set_Pixel_Sizes(face /*handle*/, 0 /*width*/,
+                                   fontsize /*height*/);
     if (error) {
-        FT_Done_Face(face);
         R.errorfmt("Could not set font size to {}", fontsize);
         return false;  // couldn't set the character size
     }
 
-    FT_GlyphSlot slot = face->glyph;  // a small shortcut
     int nchannels(R.nchannels());
     IBA_FIX_PERCHAN_LEN_DEF(textcolor, nchannels);
 
@@ -1090,7 +1267,7 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
     Strutil::utf8_to_unicode(text, utext);
 
     // Compute the size that the text will render as, into an ROI
-    ROI textroi     = text_size_from_unicode(utext, face, fontsize);
+    ROI textroi     = text_size_from_unicode(utext, face, font, fontsize);
     textroi.zbegin  = 0;
     textroi.zend    = 1;
     textroi.chbegin = 0;
@@ -1126,21 +1303,20 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
             y += fontsize;
             continue;
         }
-        int error = FT_Load_Char(face, ch, FT_LOAD_RENDER);
-        if (error)
+        const GlyphBitmap* g = get_glyph(face, font, fontsize, ch);
+        if (!g)
             continue;  // ignore errors
         // now, draw to our target surface
-        for (int j = 0; j < static_cast<int>(slot->bitmap.rows); ++j) {
-            int ry = y + j - slot->bitmap_top;
-            for (int i = 0; i < static_cast<int>(slot->bitmap.width); ++i) {
-                int rx  = x + i + slot->bitmap_left;
-                float b = slot->bitmap.buffer[slot->bitmap.pitch * j + i]
-                          / 255.0f;
+        for (int j = 0; j < g->rows; ++j) {
+            int ry = y + j - g->top;
+            for (int i = 0; i < g->width; ++i) {
+                int rx  = x + i + g->left;
+                float b = g->coverage[j * g->width + i];
                 textimg.setpixel(rx, ry, &b, 1);
             }
         }
         // increment pen position
-        x += slot->advance.x >> 6;
+        x += g->advance_x;
     }
 
     // Generate the alpha image -- if drop shadow is requested, dilate,
@@ -1171,7 +1347,6 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
         R.setpixel(r.x(), r.y(), pixelcolor);
     }
 
-    FT_Done_Face(face);
     return true;
 
 #else
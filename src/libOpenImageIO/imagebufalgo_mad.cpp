@@ -90,12 +90,39 @@ mad_impl_ici(ImageBuf& R, const ImageBuf& A, cspan<float> b, const ImageBuf& C,
              ROI roi, int nthreads)
 {
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        ImageBuf::Iterator<Rtype> r(R, roi);
-        ImageBuf::ConstIterator<ABCtype> a(A, roi);
-        ImageBuf::ConstIterator<ABCtype> c(C, roi);
-        for (; !r.done(); ++r, ++a, ++c) {
-            for (int ch = roi.chbegin; ch < roi.chend; ++ch)
-                r[ch] = a[ch] * b[ch] + c[ch];
+        if ((std::is_same<Rtype, float>::value
+             || std::is_same<Rtype, half>::value)
+            && (std::is_same<ABCtype, float>::value
+                || std::is_same<ABCtype, half>::value)
+            && A.localpixels() && C.localpixels() && A.contains_roi(roi)
+            && C.contains_roi(roi) && roi.chbegin == 0
+            && roi.chend == R.nchannels() && roi.chend == A.nchannels()
+            && roi.chend == C.nchannels()) {
+            // Raw-memory loops for half/float with a per-channel constant
+            // scale; see mad_impl above.
+            int nc    = R.nchannels();
+            int width = roi.width();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    Rtype* rraw = (Rtype*)R.pixeladdr(roi.xbegin, y, z);
+                    const ABCtype* araw
+                        = (const ABCtype*)A.pixeladdr(roi.xbegin, y, z);
+                    const ABCtype* craw
+                        = (const ABCtype*)C.pixeladdr(roi.xbegin, y, z);
+                    OIIO_DASSERT(rraw && araw && craw);
+                    for (int x = 0; x < width; ++x)
+                        for (int ch = 0; ch < nc; ++ch)
+                            rraw[x * nc + ch] = araw[x * nc + ch] * b[ch]
+                                                + craw[x * nc + ch];
+                }
+        } else {
+            ImageBuf::Iterator<Rtype> r(R, roi);
+            ImageBuf::ConstIterator<ABCtype> a(A, roi);
+            ImageBuf::ConstIterator<ABCtype> c(C, roi);
+            for (; !r.done(); ++r, ++a, ++c) {
+                for (int ch = roi.chbegin; ch < roi.chend; ++ch)
+                    r[ch] = a[ch] * b[ch] + c[ch];
+            }
         }
     });
     return true;
@@ -109,11 +136,34 @@ mad_impl_icc(ImageBuf& R, const ImageBuf& A, cspan<float> b, cspan<float> c,
              ROI roi, int nthreads)
 {
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        ImageBuf::Iterator<Rtype> r(R, roi);
-        ImageBuf::ConstIterator<Atype> a(A, roi);
-        for (; !r.done(); ++r, ++a)
-            for (int ch = roi.chbegin; ch < roi.chend; ++ch)
-                r[ch] = a[ch] * b[ch] + c[ch];
+        if ((std::is_same<Rtype, float>::value
+             || std::is_same<Rtype, half>::value)
+            && (std::is_same<Atype, float>::value
+                || std::is_same<Atype, half>::value)
+            && A.localpixels() && A.contains_roi(roi) && roi.chbegin == 0
+            && roi.chend == R.nchannels() && roi.chend == A.nchannels()) {
+            // Raw-memory loops for half/float with per-channel constant
+            // scale and bias; see mad_impl above.
+            int nc    = R.nchannels();
+            int width = roi.width();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    Rtype* rraw = (Rtype*)R.pixeladdr(roi.xbegin, y, z);
+                    const Atype* araw
+                        = (const Atype*)A.pixeladdr(roi.xbegin, y, z);
+                    OIIO_DASSERT(rraw && araw);
+                    for (int x = 0; x < width; ++x)
+                        for (int ch = 0; ch < nc; ++ch)
+                            rraw[x * nc + ch] = araw[x * nc + ch] * b[ch]
+                                                + c[ch];
+                }
+        } else {
+            ImageBuf::Iterator<Rtype> r(R, roi);
+            ImageBuf::ConstIterator<Atype> a(A, roi);
+            for (; !r.done(); ++r, ++a)
+                for (int ch = roi.chbegin; ch < roi.chend; ++ch)
+                    r[ch] = a[ch] * b[ch] + c[ch];
+        }
     });
     return true;
 }
@@ -126,6 +176,35 @@ mad_impl_iic(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, cspan<float> c,
              ROI roi, int nthreads)
 {
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        if ((std::is_same<Rtype, float>::value
+             || std::is_same<Rtype, half>::value)
+            && (std::is_same<Atype, float>::value
+                || std::is_same<Atype, half>::value)
+            && A.localpixels() && B.localpixels() && A.contains_roi(roi)
+            && B.contains_roi(roi) && roi.chbegin == 0
+            && roi.chend == R.nchannels() && roi.chend == A.nchannels()
+            && roi.chend == B.nchannels()
+            && A.spec().format == B.spec().format) {
+            // Raw-memory loops for half/float with a per-channel constant
+            // bias; see mad_impl above.
+            int nc    = R.nchannels();
+            int width = roi.width();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    Rtype* rraw = (Rtype*)R.pixeladdr(roi.xbegin, y, z);
+                    const Atype* araw
+                        = (const Atype*)A.pixeladdr(roi.xbegin, y, z);
+                    const Atype* braw
+                        = (const Atype*)B.pixeladdr(roi.xbegin, y, z);
+                    OIIO_DASSERT(rraw && araw && braw);
+                    for (int x = 0; x < width; ++x)
+                        for (int ch = 0; ch < nc; ++ch)
+                            rraw[x * nc + ch] = araw[x * nc + ch]
+                                                    * braw[x * nc + ch]
+                                                + c[ch];
+                }
+            return;
+        }
         ImageBuf::Iterator<Rtype> r(R, roi);
         ImageBuf::ConstIterator<Atype> a(A, roi);
         ImageBuf::ConstIterator<Atype> b(B, roi);
@@ -31,12 +31,39 @@ mul_impl(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, ROI roi,
          int nthreads)
 {
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        ImageBuf::Iterator<Rtype> r(R, roi);
-        ImageBuf::ConstIterator<Atype> a(A, roi);
-        ImageBuf::ConstIterator<Btype> b(B, roi);
-        for (; !r.done(); ++r, ++a, ++b)
-            for (int c = roi.chbegin; c < roi.chend; ++c)
-                r[c] = a[c] * b[c];
+        if ((std::is_same<Rtype, float>::value
+             || std::is_same<Rtype, half>::value)
+            && (std::is_same<Atype, float>::value
+                || std::is_same<Atype, half>::value)
+            && (std::is_same<Btype, float>::value
+                || std::is_same<Btype, half>::value)
+            && A.localpixels() && B.localpixels()
+            && A.contains_roi(roi) && B.contains_roi(roi)
+            && roi.chbegin == 0 && roi.chend == R.nchannels()
+            && roi.chend == A.nchannels() && roi.chend == B.nchannels()) {
+            // Flat-array fast path for contiguous float/half data over the
+            // full channel range; auto-vectorizes.  See mad_impl.
+            int nxvalues = roi.width() * R.nchannels();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    Rtype* rraw = (Rtype*)R.pixeladdr(roi.xbegin, y, z);
+                    const Atype* araw
+                        = (const Atype*)A.pixeladdr(roi.xbegin, y, z);
+                    const Btype* braw
+                        = (const Btype*)B.pixeladdr(roi.xbegin, y, z);
+                    OIIO_DASSERT(rraw && araw && braw);
+                    for (int x = 0; x < nxvalues; ++x)
+                        rraw[x] = araw[x] * braw[x];
+                }
+        } else {
+            ImageBuf::Iterator<Rtype> r(R, roi);
+            ImageBuf::ConstIterator<Atype> a(A, roi);
+            ImageBuf::ConstIterator<Btype> b(B, roi);
+            for (; !r.done(); ++r, ++a, ++b)
+                for (int c = roi.chbegin; c < roi.chend; ++c)
+                    r[c] = a[c] * b[c];
+        }
+
     });
     return true;
 }
@@ -143,14 +170,45 @@ div_impl(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, ROI roi,
          int nthreads)
 {
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        ImageBuf::Iterator<Rtype> r(R, roi);
-        ImageBuf::ConstIterator<Atype> a(A, roi);
-        ImageBuf::ConstIterator<Btype> b(B, roi);
-        for (; !r.done(); ++r, ++a, ++b)
-            for (int c = roi.chbegin; c < roi.chend; ++c) {
-                float v = b[c];
-                r[c]    = (v == 0.0f) ? 0.0f : (a[c] / v);
-            }
+        if ((std::is_same<Rtype, float>::value
+             || std::is_same<Rtype, half>::value)
+            && (std::is_same<Atype, float>::value
+                || std::is_same<Atype, half>::value)
+            && (std::is_same<Btype, float>::value
+                || std::is_same<Btype, half>::value)
+            && A.localpixels() && B.localpixels()
+            && A.contains_roi(roi) && B.contains_roi(roi)
+            && roi.chbegin == 0 && roi.chend == R.nchannels()
+            && roi.chend == A.nchannels() && roi.chend == B.nchannels()) {
+            // Flat-array fast path for contiguous float/half data over the
+            // full channel range; auto-vectorizes.  See mad_impl.
+            int nxvalues = roi.width() * R.nchannels();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    Rtype* rraw = (Rtype*)R.pixeladdr(roi.xbegin, y, z);
+                    const Atype* araw
+                        = (const Atype*)A.pixeladdr(roi.xbegin, y, z);
+                    const Btype* braw
+                        = (const Btype*)B.pixeladdr(roi.xbegin, y, z);
+                    OIIO_DASSERT(rraw && araw && braw);
+                    for (int x = 0; x < nxvalues; ++x)
+                    {
+                        float v = braw[x];
+                        rraw[x] = (v == 0.0f) ? Rtype(0.0f)
+                                              : Rtype(araw[x] / v);
+                    }
+                }
+        } else {
+            ImageBuf::Iterator<Rtype> r(R, roi);
+            ImageBuf::ConstIterator<Atype> a(A, roi);
+            ImageBuf::ConstIterator<Btype> b(B, roi);
+            for (; !r.done(); ++r, ++a, ++b)
+                for (int c = roi.chbegin; c < roi.chend; ++c) {
+                    float v = b[c];
+                    r[c]    = (v == 0.0f) ? 0.0f : (a[c] / v);
+                }
+        }
+
     });
     return true;
 }
@@ -141,18 +141,66 @@ ImageBufAlgo::flop(const ImageBuf& src, ROI roi, int nthreads)
 
 
 
+// Block size (in pixels on a side) for the cache-blocked traversal of the
+// transposing ops (rotate90, rotate270, transpose). These ops read source
+// columns while writing destination rows, so a naive scan strides across
+// the entire source scanline-to-scanline for every destination pixel.
+// Working in square blocks keeps both the reads and the writes within a
+// footprint that stays cache resident, even on very large images.
+static const int transpose_blocksize = 64;
+
+
 template<class D, class S = D>
 static bool
-rotate90_(ImageBuf& dst, const ImageBuf& src, ROI dst_roi, int /*nthreads*/)
+rotate90_(ImageBuf& dst, const ImageBuf& src, ROI dst_roi, int nthreads)
 {
     ROI dst_roi_full = dst.roi_full();
-    ImageBuf::ConstIterator<S, D> s(src);
-    ImageBuf::Iterator<D, D> d(dst, dst_roi);
-    for (; !d.done(); ++d) {
-        s.pos(d.y(), dst_roi_full.xend - d.x() - 1, d.z());
-        for (int c = dst_roi.chbegin; c < dst_roi.chend; ++c)
-            d[c] = s[c];
-    }
+    ImageBufAlgo::parallel_image(dst_roi, nthreads, [&](ROI roi) {
+        // The source region feeding this destination region
+        ROI src_roi(roi.ybegin, roi.yend, dst_roi_full.xend - roi.xend,
+                    dst_roi_full.xend - roi.xbegin, roi.zbegin, roi.zend,
+                    roi.chbegin, roi.chend);
+        const int bs = transpose_blocksize;
+        if (std::is_same<D, S>::value && dst.localpixels()
+            && src.localpixels() && src.contains_roi(src_roi)) {
+            // Fast path: both buffers are in local memory with the same
+            // data type. Use raw pointers, in cache-sized blocks.
+            int nch  = roi.chend - roi.chbegin;
+            int dnch = dst.nchannels();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int yb = roi.ybegin; yb < roi.yend; yb += bs)
+                    for (int xb = roi.xbegin; xb < roi.xend; xb += bs) {
+                        int ye = std::min(yb + bs, roi.yend);
+                        int xe = std::min(xb + bs, roi.xend);
+                        for (int y = yb; y < ye; ++y) {
+                            D* d = (D*)dst.pixeladdr(xb, y, z, roi.chbegin);
+                            for (int x = xb; x < xe; ++x, d += dnch) {
+                                const S* s = (const S*)
+                                    src.pixeladdr(y, dst_roi_full.xend - x - 1,
+                                                  z, roi.chbegin);
+                                for (int c = 0; c < nch; ++c)
+                                    d[c] = D(s[c]);
+                            }
+                        }
+                    }
+            return;
+        }
+        ImageBuf::ConstIterator<S, D> s(src);
+        ImageBuf::Iterator<D, D> d(dst);
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int yb = roi.ybegin; yb < roi.yend; yb += bs)
+                for (int xb = roi.xbegin; xb < roi.xend; xb += bs) {
+                    int ye = std::min(yb + bs, roi.yend);
+                    int xe = std::min(xb + bs, roi.xend);
+                    for (int y = yb; y < ye; ++y)
+                        for (int x = xb; x < xe; ++x) {
+                            d.pos(x, y, z);
+                            s.pos(y, dst_roi_full.xend - x - 1, z);
+                            for (int c = roi.chbegin; c < roi.chend; ++c)
+                                d[c] = s[c];
+                        }
+                }
+    });
     return true;
 }
 
@@ -257,16 +305,55 @@ ImageBufAlgo::rotate180(ImageBuf& dst, const ImageBuf& src, ROI roi,
 
 template<class D, class S = D>
 static bool
-rotate270_(ImageBuf& dst, const ImageBuf& src, ROI dst_roi, int /*nthreads*/)
+rotate270_(ImageBuf& dst, const ImageBuf& src, ROI dst_roi, int nthreads)
 {
     ROI dst_roi_full = dst.roi_full();
-    ImageBuf::ConstIterator<S, D> s(src);
-    ImageBuf::Iterator<D, D> d(dst, dst_roi);
-    for (; !d.done(); ++d) {
-        s.pos(dst_roi_full.yend - d.y() - 1, d.x(), d.z());
-        for (int c = dst_roi.chbegin; c < dst_roi.chend; ++c)
-            d[c] = s[c];
-    }
+    ImageBufAlgo::parallel_image(dst_roi, nthreads, [&](ROI roi) {
+        // The source region feeding this destination region
+        ROI src_roi(dst_roi_full.yend - roi.yend,
+                    dst_roi_full.yend - roi.ybegin, roi.xbegin, roi.xend,
+                    roi.zbegin, roi.zend, roi.chbegin, roi.chend);
+        const int bs = transpose_blocksize;
+        if (std::is_same<D, S>::value && dst.localpixels()
+            && src.localpixels() && src.contains_roi(src_roi)) {
+            // Fast path: both buffers are in local memory with the same
+            // data type. Use raw pointers, in cache-sized blocks.
+            int nch  = roi.chend - roi.chbegin;
+            int dnch = dst.nchannels();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int yb = roi.ybegin; yb < roi.yend; yb += bs)
+                    for (int xb = roi.xbegin; xb < roi.xend; xb += bs) {
+                        int ye = std::min(yb + bs, roi.yend);
+                        int xe = std::min(xb + bs, roi.xend);
+                        for (int y = yb; y < ye; ++y) {
+                            D* d = (D*)dst.pixeladdr(xb, y, z, roi.chbegin);
+                            for (int x = xb; x < xe; ++x, d += dnch) {
+                                const S* s = (const S*)
+                                    src.pixeladdr(dst_roi_full.yend - y - 1, x,
+                                                  z, roi.chbegin);
+                                for (int c = 0; c < nch; ++c)
+                                    d[c] = D(s[c]);
+                            }
+                        }
+                    }
+            return;
+        }
+        ImageBuf::ConstIterator<S, D> s(src);
+        ImageBuf::Iterator<D, D> d(dst);
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int yb = roi.ybegin; yb < roi.yend; yb += bs)
+                for (int xb = roi.xbegin; xb < roi.xend; xb += bs) {
+                    int ye = std::min(yb + bs, roi.yend);
+                    int xe = std::min(xb + bs, roi.xend);
+                    for (int y = yb; y < ye; ++y)
+                        for (int x = xb; x < xe; ++x) {
+                            d.pos(x, y, z);
+                            s.pos(dst_roi_full.yend - y - 1, x, z);
+                            for (int c = roi.chbegin; c < roi.chend; ++c)
+                                d[c] = s[c];
+                        }
+                }
+    });
     return true;
 }
 
@@ -401,15 +488,53 @@ static bool
 transpose_(ImageBuf& dst, const ImageBuf& src, ROI roi, int nthreads)
 {
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        ImageBuf::ConstIterator<SRCTYPE, DSTTYPE> s(src, roi);
-        ImageBuf::Iterator<DSTTYPE, DSTTYPE> d(dst);
-        for (; !s.done(); ++s) {
-            d.pos(s.y(), s.x(), s.z());
-            if (!d.exists())
-                continue;
-            for (int c = roi.chbegin; c < roi.chend; ++c)
-                d[c] = s[c];
+        // The destination region written by this source region
+        ROI dst_roi(roi.ybegin, roi.yend, roi.xbegin, roi.xend, roi.zbegin,
+                    roi.zend, roi.chbegin, roi.chend);
+        const int bs = transpose_blocksize;
+        if (std::is_same<DSTTYPE, SRCTYPE>::value && dst.localpixels()
+            && src.localpixels() && src.contains_roi(roi)
+            && dst.contains_roi(dst_roi)) {
+            // Fast path: both buffers are in local memory with the same
+            // data type. Use raw pointers, in cache-sized blocks.
+            int nch  = roi.chend - roi.chbegin;
+            int dnch = dst.nchannels();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int yb = roi.ybegin; yb < roi.yend; yb += bs)
+                    for (int xb = roi.xbegin; xb < roi.xend; xb += bs) {
+                        int ye = std::min(yb + bs, roi.yend);
+                        int xe = std::min(xb + bs, roi.xend);
+                        // Write dst rows (= src columns) within the block
+                        for (int x = xb; x < xe; ++x) {
+                            DSTTYPE* d = (DSTTYPE*)dst.pixeladdr(yb, x, z,
+                                                                 roi.chbegin);
+                            for (int y = yb; y < ye; ++y, d += dnch) {
+                                const SRCTYPE* s = (const SRCTYPE*)
+                                    src.pixeladdr(y, x, z, roi.chbegin);
+                                for (int c = 0; c < nch; ++c)
+                                    d[c] = DSTTYPE(s[c]);
+                            }
+                        }
+                    }
+            return;
         }
+        ImageBuf::ConstIterator<SRCTYPE, DSTTYPE> s(src);
+        ImageBuf::Iterator<DSTTYPE, DSTTYPE> d(dst);
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int yb = roi.ybegin; yb < roi.yend; yb += bs)
+                for (int xb = roi.xbegin; xb < roi.xend; xb += bs) {
+                    int ye = std::min(yb + bs, roi.yend);
+                    int xe = std::min(xb + bs, roi.xend);
+                    for (int y = yb; y < ye; ++y)
+                        for (int x = xb; x < xe; ++x) {
+                            d.pos(y, x, z);
+                            if (!d.exists())
+                                continue;
+                            s.pos(x, y, z);
+                            for (int c = roi.chbegin; c < roi.chend; ++c)
+                                d[c] = s[c];
+                        }
+                }
     });
     return true;
 }
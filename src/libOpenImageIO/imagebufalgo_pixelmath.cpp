@@ -31,12 +31,40 @@ min_impl(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, ROI roi,
          int nthreads)
 {
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        ImageBuf::Iterator<Rtype> r(R, roi);
-        ImageBuf::ConstIterator<Atype> a(A, roi);
-        ImageBuf::ConstIterator<Btype> b(B, roi);
-        for (; !r.done(); ++r, ++a, ++b)
-            for (int c = roi.chbegin; c < roi.chend; ++c)
-                r[c] = std::min(a[c], b[c]);
+        if ((std::is_same<Rtype, float>::value
+             || std::is_same<Rtype, half>::value)
+            && (std::is_same<Atype, float>::value
+                || std::is_same<Atype, half>::value)
+            && (std::is_same<Btype, float>::value
+                || std::is_same<Btype, half>::value)
+            && A.localpixels() && B.localpixels()
+            && A.contains_roi(roi) && B.contains_roi(roi)
+            && roi.chbegin == 0 && roi.chend == R.nchannels()
+            && roi.chend == A.nchannels() && roi.chend == B.nchannels()) {
+            // Flat-array fast path for contiguous float/half data over the
+            // full channel range; auto-vectorizes.  See mad_impl.
+            int nxvalues = roi.width() * R.nchannels();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    Rtype* rraw = (Rtype*)R.pixeladdr(roi.xbegin, y, z);
+                    const Atype* araw
+                        = (const Atype*)A.pixeladdr(roi.xbegin, y, z);
+                    const Btype* braw
+                        = (const Btype*)B.pixeladdr(roi.xbegin, y, z);
+                    OIIO_DASSERT(rraw && araw && braw);
+                    for (int x = 0; x < nxvalues; ++x)
+                        rraw[x] = Rtype(
+                            std::min(float(araw[x]), float(braw[x])));
+                }
+        } else {
+            ImageBuf::Iterator<Rtype> r(R, roi);
+            ImageBuf::ConstIterator<Atype> a(A, roi);
+            ImageBuf::ConstIterator<Btype> b(B, roi);
+            for (; !r.done(); ++r, ++a, ++b)
+                for (int c = roi.chbegin; c < roi.chend; ++c)
+                    r[c] = std::min(a[c], b[c]);
+        }
+
     });
     return true;
 }
@@ -128,12 +156,40 @@ max_impl(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, ROI roi,
          int nthreads)
 {
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        ImageBuf::Iterator<Rtype> r(R, roi);
-        ImageBuf::ConstIterator<Atype> a(A, roi);
-        ImageBuf::ConstIterator<Btype> b(B, roi);
-        for (; !r.done(); ++r, ++a, ++b)
-            for (int c = roi.chbegin; c < roi.chend; ++c)
-                r[c] = std::max(a[c], b[c]);
+        if ((std::is_same<Rtype, float>::value
+             || std::is_same<Rtype, half>::value)
+            && (std::is_same<Atype, float>::value
+                || std::is_same<Atype, half>::value)
+            && (std::is_same<Btype, float>::value
+                || std::is_same<Btype, half>::value)
+            && A.localpixels() && B.localpixels()
+            && A.contains_roi(roi) && B.contains_roi(roi)
+            && roi.chbegin == 0 && roi.chend == R.nchannels()
+            && roi.chend == A.nchannels() && roi.chend == B.nchannels()) {
+            // Flat-array fast path for contiguous float/half data over the
+            // full channel range; auto-vectorizes.  See mad_impl.
+            int nxvalues = roi.width() * R.nchannels();
+            for (int z = roi.zbegin; z < roi.zend; ++z)
+                for (int y = roi.ybegin; y < roi.yend; ++y) {
+                    Rtype* rraw = (Rtype*)R.pixeladdr(roi.xbegin, y, z);
+                    const Atype* araw
+                        = (const Atype*)A.pixeladdr(roi.xbegin, y, z);
+                    const Btype* braw
+                        = (const Btype*)B.pixeladdr(roi.xbegin, y, z);
+                    OIIO_DASSERT(rraw && araw && braw);
+                    for (int x = 0; x < nxvalues; ++x)
+                        rraw[x] = Rtype(
+                            std::max(float(araw[x]), float(braw[x])));
+                }
+        } else {
+            ImageBuf::Iterator<Rtype> r(R, roi);
+            ImageBuf::ConstIterator<Atype> a(A, roi);
+            ImageBuf::ConstIterator<Btype> b(B, roi);
+            for (; !r.done(); ++r, ++a, ++b)
+                for (int c = roi.chbegin; c < roi.chend; ++c)
+                    r[c] = std::max(a[c], b[c]);
+        }
+
     });
     return true;
 }
@@ -796,6 +852,111 @@ ImageBufAlgo::rangeexpand(const ImageBuf& src, bool useluma, ROI roi,
 
 
 
+// Do dst/src/roi qualify for the specialized float RGBA premult/unpremult
+// paths below?
+static inline bool
+premult_fastpath_ok(const ImageBuf& dst, const ImageBuf& src, const ROI& roi)
+{
+    return dst.localpixels() && src.localpixels()
+           && dst.spec().format == TypeFloat && src.spec().format == TypeFloat
+           && dst.nchannels() == 4 && src.nchannels() == 4
+           && src.spec().alpha_channel == 3 && src.spec().z_channel < 0
+           && roi.chbegin == 0 && roi.chend == 4;
+}
+
+
+// Specialized unpremult for the overwhelmingly common comp case: local
+// float RGBA with alpha in channel 3 and no z channel. Each scanline's
+// alpha is scanned first; rows where every alpha is exactly 0 or 1 (most
+// comp frames are mostly one or the other) are a straight copy. The
+// remaining rows divide with a masked, Newton-refined SIMD reciprocal
+// instead of a per-pixel branch.
+static bool
+unpremult_float_rgba_(ImageBuf& R, const ImageBuf& A, ROI roi, int nthreads)
+{
+    using namespace simd;
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        int width = roi.width();
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                const float* a = (const float*)A.pixeladdr(roi.xbegin, y, z);
+                float* r       = (float*)R.pixeladdr(roi.xbegin, y, z);
+                bool trivial   = true;
+                for (int x = 0; x < width; ++x) {
+                    float av = a[4 * x + 3];
+                    if (av != 0.0f && av != 1.0f) {
+                        trivial = false;
+                        break;
+                    }
+                }
+                if (trivial) {
+                    if (r != a)
+                        memcpy(r, a, width * 4 * sizeof(float));
+                    continue;
+                }
+                for (int x = 0; x < width; ++x) {
+                    vfloat4 p(a + 4 * x);
+                    vfloat4 av = shuffle<3>(p);
+                    // Approximate reciprocal plus one Newton step is
+                    // effectively full precision here.
+                    vfloat4 recip = rcp_fast(av);
+                    recip         = recip * (vfloat4(2.0f) - av * recip);
+                    vfloat4 factor
+                        = select((av == vfloat4::Zero())
+                                     | (av == vfloat4::One()),
+                                 vfloat4::One(), recip);
+                    factor = insert<3>(factor, 1.0f);
+                    (p * factor).store(r + 4 * x);
+                }
+            }
+    });
+    return true;
+}
+
+
+// The premult counterpart of unpremult_float_rgba_ above. Rows whose
+// alphas are all exactly 1 (or, when preserving alpha==0, all 0 or 1) are
+// a straight copy; others multiply with a masked broadcast alpha.
+static bool
+premult_float_rgba_(ImageBuf& R, const ImageBuf& A, bool preserve_alpha0,
+                    ROI roi, int nthreads)
+{
+    using namespace simd;
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        int width = roi.width();
+        for (int z = roi.zbegin; z < roi.zend; ++z)
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                const float* a = (const float*)A.pixeladdr(roi.xbegin, y, z);
+                float* r       = (float*)R.pixeladdr(roi.xbegin, y, z);
+                bool trivial   = true;
+                for (int x = 0; x < width; ++x) {
+                    float av = a[4 * x + 3];
+                    if (av != 1.0f && !(preserve_alpha0 && av == 0.0f)) {
+                        trivial = false;
+                        break;
+                    }
+                }
+                if (trivial) {
+                    if (r != a)
+                        memcpy(r, a, width * 4 * sizeof(float));
+                    continue;
+                }
+                for (int x = 0; x < width; ++x) {
+                    vfloat4 p(a + 4 * x);
+                    vfloat4 av    = shuffle<3>(p);
+                    vbool4 keep   = (av == vfloat4::One());
+                    if (preserve_alpha0)
+                        keep |= (av == vfloat4::Zero());
+                    vfloat4 factor = select(keep, vfloat4::One(), av);
+                    factor         = insert<3>(factor, 1.0f);
+                    (p * factor).store(r + 4 * x);
+                }
+            }
+    });
+    return true;
+}
+
+
 template<class Rtype, class Atype>
 static bool
 unpremult_(ImageBuf& R, const ImageBuf& A, ROI roi, int nthreads)
@@ -852,8 +1013,12 @@ ImageBufAlgo::unpremult(ImageBuf& dst, const ImageBuf& src, ROI roi,
         return true;
     }
     bool ok;
-    OIIO_DISPATCH_COMMON_TYPES2(ok, "unpremult", unpremult_, dst.spec().format,
-                                src.spec().format, dst, src, roi, nthreads);
+    if (premult_fastpath_ok(dst, src, roi))
+        ok = unpremult_float_rgba_(dst, src, roi, nthreads);
+    else
+        OIIO_DISPATCH_COMMON_TYPES2(ok, "unpremult", unpremult_,
+                                    dst.spec().format, src.spec().format, dst,
+                                    src, roi, nthreads);
     // Mark the output as having unassociated alpha
     dst.specmod().attribute("oiio:UnassociatedAlpha", 1);
     return ok;
@@ -927,9 +1092,12 @@ ImageBufAlgo::premult(ImageBuf& dst, const ImageBuf& src, ROI roi, int nthreads)
         return true;
     }
     bool ok;
-    OIIO_DISPATCH_COMMON_TYPES2(ok, "premult", premult_, dst.spec().format,
-                                src.spec().format, dst, src, false, roi,
-                                nthreads);
+    if (premult_fastpath_ok(dst, src, roi))
+        ok = premult_float_rgba_(dst, src, false, roi, nthreads);
+    else
+        OIIO_DISPATCH_COMMON_TYPES2(ok, "premult", premult_, dst.spec().format,
+                                    src.spec().format, dst, src, false, roi,
+                                    nthreads);
     // Clear the output of any prior marking of associated alpha
     dst.specmod().erase_attribute("oiio:UnassociatedAlpha");
     return ok;
@@ -963,9 +1131,12 @@ ImageBufAlgo::repremult(ImageBuf& dst, const ImageBuf& src, ROI roi,
         return true;
     }
     bool ok;
-    OIIO_DISPATCH_COMMON_TYPES2(ok, "repremult", premult_, dst.spec().format,
-                                src.spec().format, dst, src, true, roi,
-                                nthreads);
+    if (premult_fastpath_ok(dst, src, roi))
+        ok = premult_float_rgba_(dst, src, true, roi, nthreads);
+    else
+        OIIO_DISPATCH_COMMON_TYPES2(ok, "repremult", premult_,
+                                    dst.spec().format, src.spec().format, dst,
+                                    src, true, roi, nthreads);
     // Clear the output of any prior marking of associated alpha
     dst.specmod().erase_attribute("oiio:UnassociatedAlpha");
     return ok;
@@ -507,6 +507,46 @@ test_mad()
 
 
 
+// Tests ImageBufAlgo::Deferred fused chains
+void
+test_deferred()
+{
+    std::cout << "test deferred\n";
+    const int WIDTH = 4, HEIGHT = 4, CHANNELS = 4;
+    ImageSpec spec(WIDTH, HEIGHT, CHANNELS, TypeDesc::FLOAT);
+
+    ImageBuf A(spec);
+    const float Aval[CHANNELS] = { 0.1f, 0.2f, 0.3f, 0.4f };
+    ImageBufAlgo::fill(A, Aval);
+    const float Bval[CHANNELS] = { 1, 2, 3, 4 };
+    const float Cval[CHANNELS] = { 0.01f, 0.02f, 0.03f, 0.04f };
+
+    // A fused mul+add chain should match the equivalent immediate calls.
+    ImageBuf R = ImageBufAlgo::Deferred(A).mul(Bval).add(Cval).execute();
+    for (int j = 0; j < spec.height; ++j)
+        for (int i = 0; i < spec.width; ++i)
+            for (int c = 0; c < spec.nchannels; ++c)
+                OIIO_CHECK_EQUAL(R.getchannel(i, j, 0, c),
+                                 Aval[c] * Bval[c] + Cval[c]);
+
+    // Longer chain, including clamp and a short (replicated) constant.
+    ImageBuf D = ImageBufAlgo::Deferred(A)
+                     .mad(Bval, Cval)
+                     .sub(cspan<float>(0.5f))
+                     .abs()
+                     .clamp(0.0f, 0.25f)
+                     .execute();
+    for (int j = 0; j < spec.height; ++j)
+        for (int i = 0; i < spec.width; ++i)
+            for (int c = 0; c < spec.nchannels; ++c)
+                OIIO_CHECK_EQUAL(D.getchannel(i, j, 0, c),
+                                 OIIO::clamp(fabsf(Aval[c] * Bval[c] + Cval[c]
+                                                   - 0.5f),
+                                             0.0f, 0.25f));
+}
+
+
+
 // Tests ImageBufAlgo::min
 void
 test_min()
@@ -559,6 +599,42 @@ test_max()
 
 
 
+// Tests ImageBufAlgo::bilateral_filter and guided_filter
+void
+test_edge_preserving_filters()
+{
+    std::cout << "test bilateral_filter/guided_filter\n";
+
+    // Both filters are smoothers, so a constant image must pass through
+    // unchanged (to within float roundoff).
+    const float Aval[] = { 0.25f, 0.5f, 0.75f, 1.0f };
+    ImageBuf A         = filled_image(Aval, 16, 16);
+
+    ImageBuf B = ImageBufAlgo::bilateral_filter(A, 2.0f, 0.1f);
+    OIIO_CHECK_ASSERT(!B.has_error());
+    for (ImageBuf::ConstIterator<float> r(B); !r.done(); ++r)
+        for (int c = 0, nc = B.nchannels(); c < nc; ++c)
+            OIIO_CHECK_EQUAL_THRESH(r[c], Aval[c], 1e-5f);
+
+    ImageBuf G = ImageBufAlgo::guided_filter(A, ImageBuf(), 4, 0.01f);
+    OIIO_CHECK_ASSERT(!G.has_error());
+    for (ImageBuf::ConstIterator<float> r(G); !r.done(); ++r)
+        for (int c = 0, nc = G.nchannels(); c < nc; ++c)
+            OIIO_CHECK_EQUAL_THRESH(r[c], Aval[c], 1e-5f);
+
+    // An isolated impulse should be strongly suppressed by the bilateral
+    // filter (it looks like noise, not an edge-bounded region).
+    ImageBuf C     = filled_image({ 0.0f, 0.0f, 0.0f, 0.0f }, 16, 16);
+    float impulse[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    C.setpixel(8, 8, impulse);
+    ImageBuf D = ImageBufAlgo::bilateral_filter(C, 2.0f, 2.0f);
+    float pix[4];
+    D.getpixel(8, 8, pix);
+    OIIO_CHECK_ASSERT(pix[0] < 0.5f);
+}
+
+
+
 // Test ImageBuf::over
 void
 test_over(TypeDesc dtype = TypeFloat)
@@ -705,6 +781,23 @@ test_compare()
     OIIO_CHECK_EQUAL(comp.maxx, 9);
     OIIO_CHECK_EQUAL(comp.maxy, 0);
     OIIO_CHECK_EQUAL_THRESH(comp.meanerror, 0.0045f, 1.0e-8f);
+
+    // The keyword-argument variety should match the first comparison.
+    comp = ImageBufAlgo::compare(
+        A, B, { { "failthresh", failthresh }, { "warnthresh", warnthresh } });
+    OIIO_CHECK_EQUAL(comp.nfail, 5);
+    OIIO_CHECK_EQUAL(comp.nwarn, 7);
+    OIIO_CHECK_EQUAL_THRESH(comp.meanerror, 0.0045f, 1.0e-8f);
+
+    // With "maxfailures", the scan should be abandoned after the first
+    // scanline (which contains all 5 failures), so the mean error reflects
+    // only the 10 scanned pixels: 3 * 0.45 / (10*3) = 0.045.
+    comp = ImageBufAlgo::compare(A, B,
+                                 { { "failthresh", failthresh },
+                                   { "warnthresh", warnthresh },
+                                   { "maxfailures", 1 } });
+    OIIO_CHECK_EQUAL(comp.nfail, 5);
+    OIIO_CHECK_EQUAL_THRESH(comp.meanerror, 0.045f, 1.0e-8f);
 }
 
 
@@ -825,6 +918,15 @@ test_computePixelStats()
         OIIO_CHECK_EQUAL(stats.infcount[c], 0);
         OIIO_CHECK_EQUAL(stats.finitecount[c], 4);
     }
+
+    // Sampled mode: with stride 2, only the (even,even) pixels -- all
+    // black in the image above -- should be inspected.
+    auto sampled = ImageBufAlgo::computePixelStats(img, { { "stride", 2 } });
+    for (int c = 0; c < 3; ++c) {
+        OIIO_CHECK_EQUAL(sampled.min[c], 0.0f);
+        OIIO_CHECK_EQUAL(sampled.max[c], 0.0f);
+        OIIO_CHECK_EQUAL(sampled.finitecount[c], 1);
+    }
 }
 
 
@@ -1030,6 +1132,86 @@ test_validate_st_warp_checks()
 }
 
 
+void
+test_imagebuf_pool()
+{
+    std::cout << "test ImageBufPool buffer recycling\n";
+    ImageSpec spec(64, 64, 3, TypeDesc::FLOAT);
+    ImageBufAlgo::ImageBufPool pool;
+    auto a = pool.get(spec);
+    ImageBufAlgo::zero(*a);
+    const void* pixels = a->localpixels();
+    a.reset();  // returns the buffer to the pool
+    OIIO_CHECK_EQUAL(pool.size(), 1);
+    // Getting the same spec again should recycle the very same allocation.
+    auto b = pool.get(spec);
+    OIIO_CHECK_EQUAL(b->localpixels(), pixels);
+    OIIO_CHECK_EQUAL(pool.size(), 0);
+
+    // In-place execution: the same buffer as both dst and input.
+    ImageBufAlgo::fill(*b, { 0.25f, 0.25f, 0.25f });
+    ImageBufAlgo::add(*b, *b, 0.5f);
+    float pel[3];
+    b->getpixel(3, 7, pel);
+    OIIO_CHECK_EQUAL(pel[0], 0.75f);
+    OIIO_CHECK_EQUAL(pel[2], 0.75f);
+}
+
+
+
+void
+test_resize_plan()
+{
+    std::cout << "test resize with a reusable ResizePlan\n";
+    ImageBuf src(ImageSpec(64, 64, 3, TypeDesc::FLOAT));
+    float top[3]    = { 0.1f, 0.2f, 0.3f };
+    float bottom[3] = { 1.0f, 0.8f, 0.6f };
+    ImageBufAlgo::fill(src, top, bottom);
+
+    ImageBuf ref(ImageSpec(37, 23, 3, TypeDesc::FLOAT));
+    // Spell out the KWArgs to avoid ambiguity with the deprecated
+    // resize(dst, src, filtername, ...) overload.
+    ParamValue filterarg[] = { { "filtername", "lanczos3" } };
+    ImageBufAlgo::resize(ref, src, ImageBufAlgo::KWArgs(filterarg));
+
+    // Resize twice through the same plan (the second call reuses the
+    // precomputed tables) and make sure both match the plain resize.
+    ImageBufAlgo::ResizePlan plan;
+    for (int iter = 0; iter < 2; ++iter) {
+        ImageBuf dst(ImageSpec(37, 23, 3, TypeDesc::FLOAT));
+        ImageBufAlgo::resize(dst, src, plan, { { "filtername", "lanczos3" } });
+        auto comp = ImageBufAlgo::compare(ref, dst, 1e-4f, 1e-4f);
+        OIIO_CHECK_EQUAL(comp.nfail, 0);
+    }
+}
+
+
+
+void
+test_parallel_image_wstile()
+{
+    std::cout << "test parallel_image work-stealing tile dispatch\n";
+    // Make sure the work-stealing dispatch covers every pixel exactly once.
+    const int res = 160;
+    ImageSpec spec(res, res, 3, TypeDesc::FLOAT);
+    ImageBuf A(spec);
+    ImageBufAlgo::zero(A);
+    ImageBufAlgo::parallel_image(A.roi(),
+                                 paropt(0, paropt::SplitDir::WSTile, 1024),
+                                 [&](ROI roi) {
+                                     ImageBuf::Iterator<float> a(A, roi);
+                                     for (; !a.done(); ++a)
+                                         for (int c = roi.chbegin;
+                                              c < roi.chend; ++c)
+                                             a[c] = a[c] + 1.0f;
+                                 });
+    auto stats = ImageBufAlgo::computePixelStats(A);
+    OIIO_CHECK_EQUAL(stats.min[0], 1.0f);
+    OIIO_CHECK_EQUAL(stats.max[2], 1.0f);
+}
+
+
+
 void
 benchmark_parallel_image(int res, int iters)
 {
@@ -1084,6 +1266,25 @@ benchmark_parallel_image(int res, int iters)
         if (!wedge)
             break;  // don't loop if we're not wedging
     }
+
+    print("\nTime work-stealing parallel_image for {}x{}\n", res, res);
+
+    print("  threads time    rate   (best of {})\n", ntrials);
+    print("  ------- ------- -------\n");
+    for (int i = 0; threadcounts[i] <= numthreads; ++i) {
+        int nt = wedge ? threadcounts[i] : numthreads;
+        zero(Y);
+        auto func = [&]() {
+            parallel_image(Y.roi(), paropt(nt, paropt::SplitDir::WSTile),
+                           exercise);
+        };
+        double range;
+        double t = time_trial(func, ntrials, iters, &range) / iters;
+        print("  {:4}   {:6.2f} ms  {:5.1f} Mpels/s\n", nt, t * 1000,
+              double(res * res) / t / 1.0e6);
+        if (!wedge)
+            break;  // don't loop if we're not wedging
+    }
 }
 
 
@@ -1210,8 +1411,10 @@ main(int argc, char** argv)
     test_sub();
     test_mul();
     test_mad();
+    test_deferred();
     test_min();
     test_max();
+    test_edge_preserving_filters();
     test_over(TypeFloat);
     test_over(TypeHalf);
     test_zover();
@@ -1227,6 +1430,9 @@ main(int argc, char** argv)
     test_opencv();
     test_color_management();
     test_yee();
+    test_imagebuf_pool();
+    test_resize_plan();
+    test_parallel_image_wstile();
 
     benchmark_parallel_image(64, iterations * 64);
     benchmark_parallel_image(512, iterations * 16);
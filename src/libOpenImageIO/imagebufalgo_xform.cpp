@@ -7,16 +7,20 @@
 
 
 #include <cmath>
+#include <limits>
 #include <memory>
 
 #include <OpenImageIO/Imath.h>
 
 #include "imageio_pvt.h"
+#include <OpenImageIO/color.h>
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/filter.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/imagecache.h>
 #include <OpenImageIO/imagebufalgo_util.h>
+#include <OpenImageIO/simd.h>
 #include <OpenImageIO/thread.h>
 
 #include <Imath/ImathBox.h>
@@ -34,6 +38,13 @@ static const ustring filterptr_us("filterptr");
 static const ustring filterwidth_us("filterwidth");
 static const ustring recompute_roi_us("recompute_roi");
 static const ustring wrap_us("wrap");
+static const ustring fromspace_us("fromspace");
+static const ustring tospace_us("tospace");
+static const ustring contextkey_us("contextkey");
+static const ustring contextvalue_us("contextvalue");
+static const ustring unpremult_us("unpremult");
+static const ustring sharpen_us("sharpen");
+static const ustring sharpenthreshold_us("sharpenthreshold");
 
 
 #if 0
@@ -345,27 +356,100 @@ get_warp_filter(string_view filtername_, float filterwidth, ImageBuf& dst)
 
 
 
+// Compute the axis-aligned source-space bounding box of destination block
+// `broi` under the inverse mapping Minv, expanded by the filter support at
+// each corner, and clamped to the source data window.
+static ROI
+warp_src_bbox(const ImageBuf& src, const Imath::M33f& Minv, ROI broi,
+              const Filter2D* filter)
+{
+    float smin = std::numeric_limits<float>::max();
+    float smax = -std::numeric_limits<float>::max();
+    float tmin = smin, tmax = smax;
+    for (int corner = 0; corner < 4; ++corner) {
+        Dual2 x((corner & 1) ? float(broi.xend) : float(broi.xbegin), 1.0f,
+                0.0f);
+        Dual2 y((corner & 2) ? float(broi.yend) : float(broi.ybegin), 0.0f,
+                1.0f);
+        robust_multVecMatrix(Minv, x, y, x, y);
+        // Filter footprint at this corner, same sizing as filtered_sample.
+        float ds  = std::max(1.0f, std::max(fabsf(x.dx()), fabsf(x.dy())));
+        float dt  = std::max(1.0f, std::max(fabsf(y.dx()), fabsf(y.dy())));
+        float rs  = 0.5f * ds * filter->width();
+        float rt  = 0.5f * dt * filter->width();
+        smin      = std::min(smin, x.val() - rs);
+        smax      = std::max(smax, x.val() + rs);
+        tmin      = std::min(tmin, y.val() - rt);
+        tmax      = std::max(tmax, y.val() + rt);
+    }
+    ROI r((int)floorf(smin), (int)ceilf(smax) + 1, (int)floorf(tmin),
+          (int)ceilf(tmax) + 1);
+    return roi_intersection(r, src.roi());
+}
+
+
+
 template<typename DSTTYPE, typename SRCTYPE>
 static bool
 warp_(ImageBuf& dst, const ImageBuf& src, const Imath::M33f& M,
       const Filter2D* filter, ImageBuf::WrapMode wrap, bool edgeclamp, ROI roi,
       int nthreads)
 {
+    // If the source is backed by an ImageCache, we'll pin its tiles for
+    // each destination block before filtering, so the wildly striding
+    // access pattern of the inverse mapping can't evict tiles we are
+    // about to revisit.
+    ImageCache* cache = src.cachedpixels() ? src.imagecache() : nullptr;
+    const ustring srcname = src.uname();
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         int nc     = dst.nchannels();
         float* pel = OIIO_ALLOCA(float, nc);
         memset(pel, 0, nc * sizeof(float));
         Imath::M33f Minv = M.inverse();
-        ImageBuf::Iterator<DSTTYPE> out(dst, roi);
-        for (; !out.done(); ++out) {
-            Dual2 x(out.x() + 0.5f, 1.0f, 0.0f);
-            Dual2 y(out.y() + 0.5f, 0.0f, 1.0f);
-            robust_multVecMatrix(Minv, x, y, x, y);
-            filtered_sample<SRCTYPE>(src, x.val(), y.val(), x.dx(), y.dx(),
-                                     x.dy(), y.dy(), filter, wrap, edgeclamp,
-                                     pel);
-            for (int c = roi.chbegin; c < roi.chend; ++c)
-                out[c] = pel[c];
+        // Traverse the assigned region in destination blocks rather than
+        // scanline order: successive pixels of one block map to a compact
+        // source region, which keeps cache-backed sources tile-resident.
+        const int blocksize = 64;
+        std::vector<ImageCache::Tile*> pinned;
+        for (int by = roi.ybegin; by < roi.yend; by += blocksize) {
+            for (int bx = roi.xbegin; bx < roi.xend; bx += blocksize) {
+                ROI broi(bx, std::min(bx + blocksize, roi.xend), by,
+                         std::min(by + blocksize, roi.yend), roi.zbegin,
+                         roi.zend, roi.chbegin, roi.chend);
+                if (cache) {
+                    ROI sbbox = warp_src_bbox(src, Minv, broi, filter);
+                    const ImageSpec& srcspec(src.spec());
+                    int tw = srcspec.tile_width ? srcspec.tile_width
+                                                : srcspec.width;
+                    int th = srcspec.tile_height ? srcspec.tile_height
+                                                 : srcspec.height;
+                    for (int ty = sbbox.ybegin; ty < sbbox.yend;
+                         ty = ((ty - srcspec.y) / th + 1) * th + srcspec.y)
+                        for (int tx = sbbox.xbegin; tx < sbbox.xend;
+                             tx = ((tx - srcspec.x) / tw + 1) * tw
+                                  + srcspec.x) {
+                            ImageCache::Tile* t
+                                = cache->get_tile(srcname, src.subimage(),
+                                                  src.miplevel(), tx, ty, 0);
+                            if (t)
+                                pinned.push_back(t);
+                        }
+                }
+                ImageBuf::Iterator<DSTTYPE> out(dst, broi);
+                for (; !out.done(); ++out) {
+                    Dual2 x(out.x() + 0.5f, 1.0f, 0.0f);
+                    Dual2 y(out.y() + 0.5f, 0.0f, 1.0f);
+                    robust_multVecMatrix(Minv, x, y, x, y);
+                    filtered_sample<SRCTYPE>(src, x.val(), y.val(), x.dx(),
+                                             y.dx(), x.dy(), y.dy(), filter,
+                                             wrap, edgeclamp, pel);
+                    for (int c = broi.chbegin; c < broi.chend; ++c)
+                        out[c] = pel[c];
+                }
+                for (auto t : pinned)
+                    cache->release_tile(t);
+                pinned.clear();
+            }
         }
     });
     return true;
@@ -904,6 +988,384 @@ get_resize_filter(string_view filtername, float fwidth, ImageBuf& dst,
 
 
 
+// Precomputed separable weight and index tables for a ResizePlan. These
+// depend only on the source/destination geometry and the filter, so they
+// can be built once and reused across any number of images.
+struct ImageBufAlgo::ResizePlan::Impl {
+    // Geometry and filter identity the tables were built for.
+    int src_x = 0, src_y = 0, srcw = 0, srch = 0;
+    int dst_x = 0, dst_y = 0, dstw = 0, dsth = 0;
+    ustring filtername;
+    float filterwidth         = 0.0f;
+    const Filter2D* rawfilter = nullptr;  // if supplied via "filterptr"
+    Filter2D::ref filter;
+    bool valid     = false;
+    bool separable = false;
+    int radi = 0, radj = 0, xtaps = 0, ytaps = 0;
+    // Normalized filter tap weights: xtaps per destination column, ytaps
+    // per destination row.
+    std::vector<float> xweights, yweights;
+    // Per destination column: index of the first tap within a source row
+    // padded by radi replicated edge pixels on each side.
+    std::vector<int> xstart;
+    // Per destination row: first source row of the vertical taps, relative
+    // to the top of the source (unclamped; clamped at lookup time).
+    std::vector<int> ystart;
+
+    bool matches(const ImageSpec& srcspec, const ImageSpec& dstspec,
+                 ustring fname, float fwidth, const Filter2D* rawf) const
+    {
+        return valid && src_x == srcspec.full_x && src_y == srcspec.full_y
+               && srcw == srcspec.full_width && srch == srcspec.full_height
+               && dst_x == dstspec.full_x && dst_y == dstspec.full_y
+               && dstw == dstspec.full_width && dsth == dstspec.full_height
+               && filtername == fname && filterwidth == fwidth
+               && rawfilter == rawf;
+    }
+
+    void build(const ImageSpec& srcspec, const ImageSpec& dstspec,
+               Filter2D::ref f, ustring fname, float fwidth,
+               const Filter2D* rawf);
+};
+
+
+
+void
+ImageBufAlgo::ResizePlan::Impl::build(const ImageSpec& srcspec,
+                                      const ImageSpec& dstspec,
+                                      Filter2D::ref f, ustring fname,
+                                      float fwidth, const Filter2D* rawf)
+{
+    src_x       = srcspec.full_x;
+    src_y       = srcspec.full_y;
+    srcw        = srcspec.full_width;
+    srch        = srcspec.full_height;
+    dst_x       = dstspec.full_x;
+    dst_y       = dstspec.full_y;
+    dstw        = dstspec.full_width;
+    dsth        = dstspec.full_height;
+    filtername  = fname;
+    filterwidth = fwidth;
+    rawfilter   = rawf;
+    filter      = f;
+    separable   = filter->separable();
+
+    // Same filter geometry computation as resize_.
+    float xratio    = float(dstw) / float(srcw);
+    float yratio    = float(dsth) / float(srch);
+    float filterrad = filter->width() / 2.0f;
+    radi            = (int)ceilf(filterrad / xratio);
+    radj            = (int)ceilf(filterrad / yratio);
+    xtaps           = 2 * radi + 1;
+    ytaps           = 2 * radj + 1;
+
+    xweights.clear();
+    yweights.clear();
+    xstart.clear();
+    ystart.clear();
+    if (separable) {
+        // Precompute normalized tap weights for every destination column
+        // and row, exactly as resize_ computes them on the fly.
+        float dstpixelwidth  = 1.0f / float(dstw);
+        float dstpixelheight = 1.0f / float(dsth);
+        xweights.assign((size_t)dstw * xtaps, 0.0f);
+        xstart.resize(dstw);
+        for (int x = 0; x < dstw; ++x) {
+            float* xfiltval = xweights.data() + (size_t)x * xtaps;
+            float s         = (x + 0.5f) * dstpixelwidth;
+            float src_xf    = src_x + s * srcw;
+            int src_px;
+            float src_xf_frac   = floorfrac(src_xf, &src_px);
+            float totalweight_x = 0.0f;
+            for (int i = 0; i < xtaps; ++i) {
+                float w = filter->xfilt(xratio
+                                        * (i - radi - (src_xf_frac - 0.5f)));
+                xfiltval[i] = w;
+                totalweight_x += w;
+            }
+            if (totalweight_x != 0.0f)
+                for (int i = 0; i < xtaps; ++i)
+                    xfiltval[i] /= totalweight_x;
+            // Index of tap 0 within a source row padded by radi replicated
+            // edge pixels on each side (this bakes in the edge clamp).
+            xstart[x] = OIIO::clamp(src_px - src_x, 0, srcw - 1);
+        }
+        yweights.assign((size_t)dsth * ytaps, 0.0f);
+        ystart.resize(dsth);
+        for (int y = 0; y < dsth; ++y) {
+            float* yfiltval = yweights.data() + (size_t)y * ytaps;
+            float t         = (y + 0.5f) * dstpixelheight;
+            float src_yf    = src_y + t * srch;
+            int src_py;
+            float src_yf_frac   = floorfrac(src_yf, &src_py);
+            float totalweight_y = 0.0f;
+            for (int j = 0; j < ytaps; ++j) {
+                float w = filter->yfilt(yratio
+                                        * (j - radj - (src_yf_frac - 0.5f)));
+                yfiltval[j] = w;
+                totalweight_y += w;
+            }
+            if (totalweight_y != 0.0f)
+                for (int j = 0; j < ytaps; ++j)
+                    yfiltval[j] /= totalweight_y;
+            ystart[y] = src_py - radj - src_y;
+        }
+    }
+    valid = true;
+}
+
+
+
+// Pixel-wise transpose of rows [rbegin,rend) of an image with 'cols'
+// columns of nch-float pixels: dst(c, r) = src(r, c), where dst rows are
+// 'rowstride_out' pixels long. Works in 32x32 pixel blocks so reads and
+// writes each stay within a handful of cache lines; the single-channel
+// case additionally transposes 4x4 tiles with SIMD shuffles. Callers may
+// parallelize over disjoint row ranges, since each range writes disjoint
+// elements of dst.
+static void
+transpose_pixels(const float* OIIO_RESTRICT src, float* OIIO_RESTRICT dst,
+                 int rbegin, int rend, int cols, int rowstride_out, int nch)
+{
+    const int B = 32;
+    for (int rb = rbegin; rb < rend; rb += B) {
+        int rblockend = std::min(rb + B, rend);
+        for (int cb = 0; cb < cols; cb += B) {
+            int cblockend = std::min(cb + B, cols);
+            if (nch == 1) {
+                int r = rb;
+                for (; r + 4 <= rblockend; r += 4) {
+                    int c = cb;
+                    for (; c + 4 <= cblockend; c += 4) {
+                        simd::vfloat4 row0(src + (size_t)r * cols + c);
+                        simd::vfloat4 row1(src + (size_t)(r + 1) * cols + c);
+                        simd::vfloat4 row2(src + (size_t)(r + 2) * cols + c);
+                        simd::vfloat4 row3(src + (size_t)(r + 3) * cols + c);
+                        simd::transpose(row0, row1, row2, row3);
+                        row0.store(dst + (size_t)c * rowstride_out + r);
+                        row1.store(dst + (size_t)(c + 1) * rowstride_out + r);
+                        row2.store(dst + (size_t)(c + 2) * rowstride_out + r);
+                        row3.store(dst + (size_t)(c + 3) * rowstride_out + r);
+                    }
+                    for (; c < cblockend; ++c)
+                        for (int rr = r; rr < r + 4; ++rr)
+                            dst[(size_t)c * rowstride_out + rr]
+                                = src[(size_t)rr * cols + c];
+                }
+                for (; r < rblockend; ++r)
+                    for (int c = cb; c < cblockend; ++c)
+                        dst[(size_t)c * rowstride_out + r]
+                            = src[(size_t)r * cols + c];
+            } else {
+                for (int r = rb; r < rblockend; ++r)
+                    for (int c = cb; c < cblockend; ++c) {
+                        const float* s = src + ((size_t)r * cols + c) * nch;
+                        float* d = dst + ((size_t)c * rowstride_out + r) * nch;
+                        for (int ch = 0; ch < nch; ++ch)
+                            d[ch] = s[ch];
+                    }
+            }
+        }
+    }
+}
+
+
+
+// The horizontal pass of the planned separable resize, shared with
+// make_proxy below: resample every source scanline to the destination
+// width, producing a float intermediate of srch x dstw pixels.
+template<typename SRCTYPE>
+static void
+planned_horizontal_pass_(const ImageBuf& src,
+                         const ImageBufAlgo::ResizePlan::Impl& p, int nch,
+                         std::vector<float>& intermediate, int nthreads)
+{
+    const int srcw  = p.srcw;
+    const int srch  = p.srch;
+    const int dstw  = p.dstw;
+    const int radi  = p.radi;
+    const int xtaps = p.xtaps;
+    intermediate.resize((size_t)srch * dstw * nch);
+    parallel_for_chunked(
+        0, srch, 0,
+        [&](int64_t ybegin, int64_t yend) {
+            // Source scanline, converted to float, with radi replicated
+            // edge pixels on each side so the tap loop needs no clamping.
+            std::vector<float> srcrow((size_t)(srcw + 2 * radi) * nch);
+            for (int y = int(ybegin); y < int(yend); ++y) {
+                float* row = srcrow.data() + (size_t)radi * nch;
+                ImageBuf::ConstIterator<SRCTYPE> pel(
+                    src, ROI(p.src_x, p.src_x + srcw, p.src_y + y,
+                             p.src_y + y + 1, 0, 1, 0, nch));
+                for (int i = 0; !pel.done(); ++pel, ++i)
+                    for (int c = 0; c < nch; ++c)
+                        row[i * nch + c] = pel[c];
+                for (int i = 0; i < radi; ++i)
+                    for (int c = 0; c < nch; ++c) {
+                        srcrow[(size_t)i * nch + c] = row[c];
+                        srcrow[(size_t)(radi + srcw + i) * nch + c]
+                            = row[(size_t)(srcw - 1) * nch + c];
+                    }
+                float* out = intermediate.data() + (size_t)y * dstw * nch;
+                for (int x = 0; x < dstw; ++x, out += nch) {
+                    const float* w  = p.xweights.data() + (size_t)x * xtaps;
+                    const float* in = srcrow.data()
+                                      + (size_t)p.xstart[x] * nch;
+                    for (int c = 0; c < nch; ++c)
+                        out[c] = 0.0f;
+                    for (int i = 0; i < xtaps; ++i, in += nch) {
+                        float wi = w[i];
+                        for (int c = 0; c < nch; ++c)
+                            out[c] += wi * in[c];
+                    }
+                }
+            }
+        },
+        nthreads);
+}
+
+
+
+// Two-pass separable resize consuming the precomputed tables of a
+// ResizePlan: a horizontal pass resamples each source scanline to the
+// destination width (float intermediate), then a vertical pass combines
+// the intermediate rows. Requires the geometry restrictions checked by
+// the planned resize() below. The per-scanline inner loops run on flat
+// float arrays and auto-vectorize.
+template<typename DSTTYPE, typename SRCTYPE>
+static bool
+resize_planned_(ImageBuf& dst, const ImageBuf& src,
+                const ImageBufAlgo::ResizePlan::Impl* plan, ROI roi,
+                int nthreads)
+{
+    const ImageBufAlgo::ResizePlan::Impl& p(*plan);
+    const int nch   = dst.nchannels();
+    const int srch  = p.srch;
+    const int dstw  = p.dstw;
+    const int ytaps = p.ytaps;
+
+    // Pass 1: horizontal.
+    std::vector<float> intermediate;
+    planned_horizontal_pass_<SRCTYPE>(src, p, nch, intermediate, nthreads);
+
+    // Pass 2: vertical.
+    //
+    // For large intermediates with many vertical taps, the row-streaming
+    // loop below re-reads every intermediate row ytaps times, which blows
+    // out the cache on very large images (a 16K scanline alone is several
+    // hundred KB). In that regime it is cheaper to pay for two blocked
+    // transposes and run the vertical resample along contiguous memory as
+    // well: resize horizontally, transpose, resize "horizontally" again,
+    // transpose back -- the classic bandwidth-optimal scheme.
+    const int dsth     = p.dsth;
+    bool use_transpose = ytaps >= 8 && srch >= 64 && dsth >= 64
+                         && intermediate.size() * sizeof(float)
+                                > (size_t)4 * 1024 * 1024;
+    if (use_transpose) {
+        // Transpose the intermediate so each source column is contiguous.
+        std::vector<float> transposed((size_t)dstw * srch * nch);
+        parallel_for_chunked(
+            0, srch, 0,
+            [&](int64_t rbegin, int64_t rend) {
+                transpose_pixels(intermediate.data(), transposed.data(),
+                                 int(rbegin), int(rend), dstw, srch, nch);
+            },
+            nthreads);
+        intermediate.clear();
+        intermediate.shrink_to_fit();
+        // Resample every (transposed) column to the destination height,
+        // exactly the same tap loop as the horizontal pass.
+        std::vector<float> outcols((size_t)dstw * dsth * nch);
+        parallel_for_chunked(
+            0, dstw, 0,
+            [&](int64_t xbegin, int64_t xend) {
+                for (int x = int(xbegin); x < int(xend); ++x) {
+                    const float* col = transposed.data()
+                                       + (size_t)x * srch * nch;
+                    float* out = outcols.data() + (size_t)x * dsth * nch;
+                    for (int dy = 0; dy < dsth; ++dy, out += nch) {
+                        const float* wy = p.yweights.data()
+                                          + (size_t)dy * ytaps;
+                        for (int c = 0; c < nch; ++c)
+                            out[c] = 0.0f;
+                        for (int j = 0; j < ytaps; ++j) {
+                            float wj = wy[j];
+                            if (wj == 0.0f)
+                                continue;
+                            int srow = OIIO::clamp(p.ystart[dy] + j, 0,
+                                                   srch - 1);
+                            const float* in = col + (size_t)srow * nch;
+                            for (int c = 0; c < nch; ++c)
+                                out[c] += wj * in[c];
+                        }
+                    }
+                }
+            },
+            nthreads);
+        transposed.clear();
+        transposed.shrink_to_fit();
+        // Transpose back to scanline order and write out.
+        std::vector<float> outrows((size_t)dsth * dstw * nch);
+        parallel_for_chunked(
+            0, dstw, 0,
+            [&](int64_t rbegin, int64_t rend) {
+                transpose_pixels(outcols.data(), outrows.data(), int(rbegin),
+                                 int(rend), dsth, dstw, nch);
+            },
+            nthreads);
+        ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                const float* row = outrows.data()
+                                   + ((size_t)(y - p.dst_y) * dstw
+                                      + (roi.xbegin - p.dst_x))
+                                         * nch;
+                ImageBuf::Iterator<DSTTYPE> out(dst,
+                                                ROI(roi.xbegin, roi.xend, y,
+                                                    y + 1, 0, 1, roi.chbegin,
+                                                    roi.chend));
+                for (int i = 0; !out.done(); ++out, ++i)
+                    for (int c = 0; c < nch; ++c)
+                        out[c] = row[(size_t)i * nch + c];
+            }
+        });
+        return true;
+    }
+
+    // Each destination scanline is a weighted sum of ytaps intermediate
+    // rows.
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        const int w = roi.width();
+        std::vector<float> acc((size_t)w * nch);
+        for (int y = roi.ybegin; y < roi.yend; ++y) {
+            int dy          = y - p.dst_y;
+            const float* wy = p.yweights.data() + (size_t)dy * ytaps;
+            std::fill(acc.begin(), acc.end(), 0.0f);
+            for (int j = 0; j < ytaps; ++j) {
+                float wj = wy[j];
+                if (wj == 0.0f)
+                    continue;
+                int srow         = OIIO::clamp(p.ystart[dy] + j, 0, srch - 1);
+                const float* row = intermediate.data()
+                                   + ((size_t)srow * dstw
+                                      + (roi.xbegin - p.dst_x))
+                                         * nch;
+                const int n = w * nch;
+                for (int i = 0; i < n; ++i)
+                    acc[i] += wj * row[i];
+            }
+            ImageBuf::Iterator<DSTTYPE> out(dst,
+                                            ROI(roi.xbegin, roi.xend, y, y + 1,
+                                                0, 1, roi.chbegin, roi.chend));
+            for (int i = 0; !out.done(); ++out, ++i)
+                for (int c = 0; c < nch; ++c)
+                    out[c] = acc[(size_t)i * nch + c];
+        }
+    });
+    return true;
+}
+
+
+
 bool
 ImageBufAlgo::resize(ImageBuf& dst, const ImageBuf& src, KWArgs options,
                      ROI roi, int nthreads)
@@ -1014,6 +1476,348 @@ ImageBufAlgo::resize(const ImageBuf& src, string_view filtername,
 
 
 
+ImageBufAlgo::ResizePlan::ResizePlan()
+    : m_impl(new Impl)
+{
+}
+
+
+ImageBufAlgo::ResizePlan::~ResizePlan() {}
+
+
+
+bool
+ImageBufAlgo::resize(ImageBuf& dst, const ImageBuf& src, ResizePlan& plan,
+                     KWArgs options, ROI roi, int nthreads)
+{
+    pvt::LoggedTimer logtime("IBA::resize");
+
+    static const ustring recognized[] = { filtername_us, filterwidth_us,
+                                          filterptr_us };
+    IBA_check_optional(options, recognized);
+
+    if (!IBAprep(roi, &dst, &src,
+                 IBAprep_NO_SUPPORT_VOLUME | IBAprep_NO_COPY_ROI_FULL))
+        return false;
+    const ImageSpec& srcspec(src.spec());
+    const ImageSpec& dstspec(dst.spec());
+
+    ResizePlan::Impl& impl(*plan.m_impl);
+    ustring filtername(options.get_string(filtername_us));
+    float filterwidth         = options.get_float(filterwidth_us);
+    Filter2D::ref filterptr   = get_filterptr_option(options);
+    const Filter2D* rawfilter = filterptr.get();
+
+    if (!impl.matches(srcspec, dstspec, filtername, filterwidth, rawfilter)) {
+        // First use, or the geometry/filter changed: (re)build the tables.
+        if (!filterptr) {
+            float wratio = float(dstspec.full_width)
+                           / float(srcspec.full_width);
+            float hratio = float(dstspec.full_height)
+                           / float(srcspec.full_height);
+            filterptr = get_resize_filter(filtername, filterwidth, dst, wratio,
+                                          hratio);
+            if (!filterptr)
+                return false;  // error issued in get_resize_filter
+        }
+        impl.build(srcspec, dstspec, filterptr, filtername, filterwidth,
+                   rawfilter);
+    }
+
+    // The precomputed tables cover the full image for a separable filter
+    // with data windows that match the display windows. Anything else
+    // falls back on the general resize_ (still reusing the plan's filter).
+    bool fastpath = impl.separable && !src.deep() && !dst.deep()
+                    && srcspec.x == srcspec.full_x
+                    && srcspec.y == srcspec.full_y
+                    && srcspec.width == srcspec.full_width
+                    && srcspec.height == srcspec.full_height
+                    && dstspec.x == dstspec.full_x
+                    && dstspec.y == dstspec.full_y
+                    && dstspec.width == dstspec.full_width
+                    && dstspec.height == dstspec.full_height
+                    && roi.xbegin == dstspec.x
+                    && roi.xend == dstspec.x + dstspec.width
+                    && roi.ybegin == dstspec.y
+                    && roi.yend == dstspec.y + dstspec.height
+                    && roi.chbegin == 0 && roi.chend == dstspec.nchannels
+                    && srcspec.nchannels == dstspec.nchannels;
+    bool ok;
+    if (fastpath) {
+        OIIO_DISPATCH_COMMON_TYPES2(ok, "resize", resize_planned_,
+                                    dst.spec().format, src.spec().format, dst,
+                                    src, &impl, roi, nthreads);
+    } else {
+        OIIO_DISPATCH_COMMON_TYPES2(ok, "resize", resize_, dst.spec().format,
+                                    src.spec().format, dst, src,
+                                    impl.filter.get(), roi, nthreads);
+    }
+    return ok;
+}
+
+
+
+ImageBuf
+ImageBufAlgo::resize(const ImageBuf& src, ResizePlan& plan, KWArgs options,
+                     ROI roi, int nthreads)
+{
+    ImageBuf result;
+    bool ok = resize(result, src, plan, options, roi, nthreads);
+    if (!ok && !result.has_error())
+        result.errorfmt("ImageBufAlgo::resize() error");
+    return result;
+}
+
+
+
+// Fused kernel for make_proxy: the planned horizontal resize pass feeds a
+// vertical pass that applies the display transform and the unsharp to
+// each destination scanline while it is still hot in cache, instead of
+// re-traversing the full frame once per operation. Requires the same
+// geometry restrictions as resize_planned_ (checked by make_proxy below).
+template<typename DSTTYPE, typename SRCTYPE>
+static bool
+make_proxy_impl_(ImageBuf& dst, const ImageBuf& src,
+                 const ImageBufAlgo::ResizePlan::Impl* plan,
+                 const ColorProcessor* processor, bool unpremult,
+                 float sharpen, float sharpenthreshold, ROI roi, int nthreads)
+{
+    const ImageBufAlgo::ResizePlan::Impl& p(*plan);
+    const int nch   = dst.nchannels();
+    const int srch  = p.srch;
+    const int dstw  = p.dstw;
+    const int dsth  = p.dsth;
+    const int ytaps = p.ytaps;
+    const int alpha = unpremult && processor ? dst.spec().alpha_channel : -1;
+
+    // Pass 1: horizontal resize, exactly as the planned resize does it.
+    std::vector<float> intermediate;
+    planned_horizontal_pass_<SRCTYPE>(src, p, nch, intermediate, nthreads);
+
+    // Compute one destination scanline: vertical filter taps, then the
+    // display transform (with colorconvert's unpremult dance, one
+    // scanline at a time).
+    auto compute_row = [&](int dy, float* row) {
+        const float* wy = p.yweights.data() + (size_t)dy * ytaps;
+        const int n     = dstw * nch;
+        std::fill(row, row + n, 0.0f);
+        for (int j = 0; j < ytaps; ++j) {
+            float wj = wy[j];
+            if (wj == 0.0f)
+                continue;
+            int srow        = OIIO::clamp(p.ystart[dy] + j, 0, srch - 1);
+            const float* in = intermediate.data() + (size_t)srow * dstw * nch;
+            for (int i = 0; i < n; ++i)
+                row[i] += wj * in[i];
+        }
+        if (processor) {
+            if (alpha >= 0)
+                for (int x = 0; x < dstw; ++x) {
+                    float a = row[(size_t)x * nch + alpha];
+                    if (a != 0.0f && a != 1.0f)
+                        for (int c = 0; c < nch; ++c)
+                            if (c != alpha)
+                                row[(size_t)x * nch + c] /= a;
+                }
+            processor->apply(row, dstw, 1, nch, sizeof(float),
+                             nch * sizeof(float),
+                             (stride_t)dstw * nch * sizeof(float));
+            if (alpha >= 0)
+                for (int x = 0; x < dstw; ++x) {
+                    float a = row[(size_t)x * nch + alpha];
+                    if (a != 0.0f && a != 1.0f)
+                        for (int c = 0; c < nch; ++c)
+                            if (c != alpha)
+                                row[(size_t)x * nch + c] *= a;
+                }
+        }
+    };
+
+    // Pass 2: vertical + colorconvert + sharpen. Each chunk computes one
+    // apron row above and below its range (recomputed rather than shared,
+    // so there is no cross-chunk communication), letting the 3x3 unsharp
+    // read its vertical neighbors from chunk-local storage.
+    parallel_for_chunked(
+        0, dsth, 0,
+        [&](int64_t ybegin, int64_t yend) {
+            int chunkrows = int(yend - ybegin);
+            std::vector<float> rows((size_t)(chunkrows + 2) * dstw * nch);
+            auto rowptr = [&](int dy) {
+                return rows.data()
+                       + (size_t)(dy - int(ybegin) + 1) * dstw * nch;
+            };
+            for (int dy = int(ybegin) - 1; dy <= int(yend); ++dy)
+                compute_row(OIIO::clamp(dy, 0, dsth - 1), rowptr(dy));
+            std::vector<float> sharprow((size_t)dstw * nch);
+            for (int dy = int(ybegin); dy < int(yend); ++dy) {
+                const float* out = rowptr(dy);
+                if (sharpen != 0.0f) {
+                    // out = row + sharpen * thresh(row - blur3x3(row)),
+                    // the same shape as unsharp_mask with its default
+                    // 3-wide gaussian kernel.
+                    const float* rm = rowptr(dy - 1);
+                    const float* r0 = rowptr(dy);
+                    const float* rp = rowptr(dy + 1);
+                    for (int x = 0; x < dstw; ++x) {
+                        int xm = std::max(x - 1, 0) * nch;
+                        int x0 = x * nch;
+                        int xp = std::min(x + 1, dstw - 1) * nch;
+                        for (int c = 0; c < nch; ++c) {
+                            float blur = (rm[xm + c] + 2.0f * rm[x0 + c]
+                                          + rm[xp + c] + 2.0f * r0[xm + c]
+                                          + 4.0f * r0[x0 + c]
+                                          + 2.0f * r0[xp + c] + rp[xm + c]
+                                          + 2.0f * rp[x0 + c] + rp[xp + c])
+                                         * (1.0f / 16.0f);
+                            float delta = r0[x0 + c] - blur;
+                            if (fabsf(delta) < sharpenthreshold)
+                                delta = 0.0f;
+                            sharprow[x0 + c] = r0[x0 + c] + sharpen * delta;
+                        }
+                    }
+                    out = sharprow.data();
+                }
+                int y = p.dst_y + dy;
+                ImageBuf::Iterator<DSTTYPE> o(dst,
+                                              ROI(roi.xbegin, roi.xend, y,
+                                                  y + 1, 0, 1, roi.chbegin,
+                                                  roi.chend));
+                const float* row = out + (size_t)(roi.xbegin - p.dst_x) * nch;
+                for (int i = 0; !o.done(); ++o, ++i)
+                    for (int c = 0; c < nch; ++c)
+                        o[c] = row[(size_t)i * nch + c];
+            }
+        },
+        nthreads);
+    return true;
+}
+
+
+
+bool
+ImageBufAlgo::make_proxy(ImageBuf& dst, const ImageBuf& src, KWArgs options,
+                         ROI roi, int nthreads)
+{
+    pvt::LoggedTimer logtime("IBA::make_proxy");
+
+    static const ustring recognized[]
+        = { filtername_us,   tospace_us,      filterwidth_us,
+            filterptr_us,    fromspace_us,    contextkey_us,
+            contextvalue_us, unpremult_us,    sharpen_us,
+            sharpenthreshold_us };
+    IBA_check_optional(options, recognized);
+
+    if (!IBAprep(roi, &dst, &src,
+                 IBAprep_NO_SUPPORT_VOLUME | IBAprep_NO_COPY_ROI_FULL))
+        return false;
+    const ImageSpec& srcspec(src.spec());
+    const ImageSpec& dstspec(dst.spec());
+
+    // Resize filter, chosen exactly as resize() chooses it.
+    Filter2D::ref filterptr = get_filterptr_option(options);
+    if (!filterptr) {
+        float wratio = float(dstspec.full_width) / float(srcspec.full_width);
+        float hratio = float(dstspec.full_height) / float(srcspec.full_height);
+        filterptr    = get_resize_filter(options.get_string(filtername_us),
+                                         options.get_float(filterwidth_us), dst,
+                                         wratio, hratio);
+        if (!filterptr)
+            return false;  // error issued in get_resize_filter
+    }
+
+    // Display transform (skipped if no "tospace" was given).
+    string_view from = options.get_string(fromspace_us);
+    string_view to   = options.get_string(tospace_us);
+    bool unpremult   = options.get_int(unpremult_us, 1);
+    ColorProcessorHandle processor;
+    if (to.size()) {
+        if (from.empty() || from == "current")
+            from = srcspec.get_string_attribute("oiio:Colorspace", "linear");
+        const ColorConfig& colorconfig(ColorConfig::default_colorconfig());
+        processor = colorconfig.createColorProcessor(
+            colorconfig.resolve(from), colorconfig.resolve(to),
+            options.get_string(contextkey_us),
+            options.get_string(contextvalue_us));
+        if (!processor) {
+            dst.errorfmt("Could not construct the color transform {} -> {}",
+                         from, to);
+            return false;
+        }
+        if (processor->isNoOp())
+            processor.reset();
+    }
+    if (unpremult && srcspec.alpha_channel >= 0
+        && srcspec.get_int_attribute("oiio:UnassociatedAlpha") != 0)
+        unpremult = false;
+
+    float sharpen          = options.get_float(sharpen_us, 0.0f);
+    float sharpenthreshold = options.get_float(sharpenthreshold_us, 0.0f);
+
+    // The fused kernel has the same geometry restrictions as the planned
+    // resize (separable filter, matching data/display windows, full-image
+    // ROI) -- which is exactly what proxy generation looks like.
+    bool fastpath = filterptr->separable() && !src.deep() && !dst.deep()
+                    && srcspec.x == srcspec.full_x
+                    && srcspec.y == srcspec.full_y
+                    && srcspec.width == srcspec.full_width
+                    && srcspec.height == srcspec.full_height
+                    && dstspec.x == dstspec.full_x
+                    && dstspec.y == dstspec.full_y
+                    && dstspec.width == dstspec.full_width
+                    && dstspec.height == dstspec.full_height
+                    && roi.xbegin == dstspec.x
+                    && roi.xend == dstspec.x + dstspec.width
+                    && roi.ybegin == dstspec.y
+                    && roi.yend == dstspec.y + dstspec.height
+                    && roi.chbegin == 0 && roi.chend == dstspec.nchannels
+                    && srcspec.nchannels == dstspec.nchannels;
+    bool ok;
+    if (fastpath) {
+        ResizePlan::Impl impl;
+        impl.build(srcspec, dstspec, filterptr, ustring(), 0.0f, nullptr);
+        OIIO_DISPATCH_COMMON_TYPES2(ok, "make_proxy", make_proxy_impl_,
+                                    dstspec.format, srcspec.format, dst, src,
+                                    &impl, processor.get(), unpremult, sharpen,
+                                    sharpenthreshold, roi, nthreads);
+    } else {
+        // Unusual geometry: fall back on composing the unfused ops.
+        ImageBuf tmp;
+        ok = resize(tmp, src,
+                    { make_pv(filterptr_us, (Filter2D*)filterptr.get()) }, roi,
+                    nthreads);
+        if (ok && processor)
+            ok = colorconvert(tmp, tmp, processor.get(), unpremult, roi,
+                              nthreads);
+        if (ok) {
+            if (sharpen != 0.0f)
+                ok = unsharp_mask(dst, tmp, "gaussian", 3.0f, sharpen,
+                                  sharpenthreshold, roi, nthreads);
+            else
+                ok = dst.copy(tmp);
+        }
+        if (!ok && !dst.has_error() && tmp.has_error())
+            dst.errorfmt("{}", tmp.geterror());
+    }
+    if (ok && to.size())
+        dst.specmod().set_colorspace(to);
+    return ok;
+}
+
+
+
+ImageBuf
+ImageBufAlgo::make_proxy(const ImageBuf& src, KWArgs options, ROI roi,
+                         int nthreads)
+{
+    ImageBuf result;
+    bool ok = make_proxy(result, src, options, roi, nthreads);
+    if (!ok && !result.has_error())
+        result.errorfmt("ImageBufAlgo::make_proxy() error");
+    return result;
+}
+
+
+
 bool
 ImageBufAlgo::fit(ImageBuf& dst, const ImageBuf& src, KWArgs options, ROI roi,
                   int nthreads)
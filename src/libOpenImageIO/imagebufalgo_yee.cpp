@@ -8,6 +8,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <mutex>
 
 #include <OpenImageIO/Imath.h>
 #include <OpenImageIO/dassert.h>
@@ -43,6 +44,18 @@ public:
         ImageBuf kernel = ImageBufAlgo::make_kernel("gaussian", 5, 5);
         for (int i = 1; i < PYRAMID_MAX_LEVELS; ++i)
             ImageBufAlgo::convolve(level[i], level[i - 1], kernel);
+        // Cache raw addressing for each level, so that value() -- called
+        // many times per pixel by the contrast test -- can index the
+        // pixels directly rather than going through getchannel().
+        for (int i = 0; i < PYRAMID_MAX_LEVELS; ++i) {
+            const ImageSpec& spec(level[i].spec());
+            bool fast   = (1 < spec.nchannels && level[i].localpixels()
+                         && spec.format == TypeFloat);
+            fastbase[i] = fast ? (const float*)level[i].localpixels()
+                               : nullptr;
+            nchans[i]   = spec.nchannels;
+            width[i]    = spec.width;
+        }
     }
 
     ~GaussianPyramid() {}
@@ -51,8 +64,9 @@ public:
     {
         if (lev >= PYRAMID_MAX_LEVELS)
             return 0.0f;
-        else
-            return level[lev].getchannel(x, y, 0, 1);
+        if (const float* base = fastbase[lev])
+            return base[(size_t(y) * width[lev] + x) * nchans[lev] + 1];
+        return level[lev].getchannel(x, y, 0, 1);
     }
 
 #if 0 /* unused */
@@ -71,6 +85,9 @@ public:
 
 private:
     ImageBuf level[PYRAMID_MAX_LEVELS];
+    const float* fastbase[PYRAMID_MAX_LEVELS];
+    int nchans[PYRAMID_MAX_LEVELS];
+    int width[PYRAMID_MAX_LEVELS];
 };
 
 
@@ -268,70 +285,93 @@ ImageBufAlgo::compare_Yee(const ImageBuf& img0, const ImageBuf& img1,
     for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; ++i)
         F_freq[i] = csf_max / contrast_sensitivity(cpd[i], 100.0f);
 
-    for (int y = 0; y < nscanlines; ++y) {
-        for (int x = 0; x < roi.width(); ++x) {
-            float contrast[PYRAMID_MAX_LEVELS - 2];
-            float sum_contrast = 0;
-            for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++) {
-                float n1 = fabsf(la.value(x, y, i) - la.value(x, y, i + 1));
-                float n2 = fabsf(lb.value(x, y, i) - lb.value(x, y, i + 1));
-                float numerator   = std::max(n1, n2);
-                float d1          = fabsf(la.value(x, y, i + 2));
-                float d2          = fabsf(lb.value(x, y, i + 2));
-                float denominator = std::max(std::max(d1, d2), 1.0e-5f);
-                contrast[i]       = numerator / denominator;
-                sum_contrast += contrast[i];
-            }
-            if (sum_contrast < 1e-5)
-                sum_contrast = 1e-5f;
-            float F_mask[PYRAMID_MAX_LEVELS - 2];
-            float adapt = la.value(x, y, adaptation_level)
-                          + lb.value(x, y, adaptation_level);
-            adapt *= 0.5f;
-            if (adapt < 1e-5)
-                adapt = 1e-5f;
-            for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++)
-                F_mask[i] = mask(contrast[i]
-                                 * contrast_sensitivity(cpd[i], adapt));
-            float factor = 0;
-            for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++)
-                factor += contrast[i] * F_freq[i] * F_mask[i] / sum_contrast;
-            factor      = OIIO::clamp(factor, 1.0f, 10.0f);
-            float delta = fabsf(la.value(x, y, 0) - lb.value(x, y, 0));
-            bool pass   = true;
-            // pure luminance test
-            delta /= tvi(adapt);
-            if (delta > factor) {
-                pass = false;
-            } else if (!luminanceOnly) {
-                // CIE delta E test with modifications
-                float color_scale = 1.0f;
-                // ramp down the color test in scotopic regions
-                if (adapt < 10.0f) {
-                    color_scale = 1.0f - (10.0f - color_scale) / 10.0f;
-                    color_scale = color_scale * color_scale;
+    // The per-pixel contrast/adaptation test is independent per pixel, so
+    // carve the (0-origin) region into scanline chunks and run them
+    // concurrently, each accumulating into its own tally that is merged
+    // into `result` under a lock at the end of the chunk.
+    const float* aLABpix = (const float*)aLAB.localpixels();
+    const float* bLABpix = (const float*)bLAB.localpixels();
+    OIIO_DASSERT(aLABpix && bLABpix);
+    std::mutex result_mutex;
+    ImageBufAlgo::parallel_image(ROI(0, roi.width(), 0, nscanlines), nthreads,
+                                 [&](ROI chunk) {
+        imagesize_t nfail = 0;
+        float maxerror    = 0.0f;
+        int maxx = 0, maxy = 0;
+        for (int y = chunk.ybegin; y < chunk.yend; ++y)
+            for (int x = chunk.xbegin; x < chunk.xend; ++x) {
+                float contrast[PYRAMID_MAX_LEVELS - 2];
+                float sum_contrast = 0;
+                for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++) {
+                    float n1 = fabsf(la.value(x, y, i) - la.value(x, y, i + 1));
+                    float n2 = fabsf(lb.value(x, y, i) - lb.value(x, y, i + 1));
+                    float numerator   = std::max(n1, n2);
+                    float d1          = fabsf(la.value(x, y, i + 2));
+                    float d2          = fabsf(lb.value(x, y, i + 2));
+                    float denominator = std::max(std::max(d1, d2), 1.0e-5f);
+                    contrast[i]       = numerator / denominator;
+                    sum_contrast += contrast[i];
                 }
-                float da = aLAB.getchannel(x, y, 0, 1)
-                           - bLAB.getchannel(x, y, 0, 1);  // diff in A
-                float db = aLAB.getchannel(x, y, 0, 2)
-                           - bLAB.getchannel(x, y, 0, 2);  // diff in B
-                da    = da * da;
-                db    = db * db;
-                delta = (da + db) * color_scale;
-                if (delta > factor)
+                if (sum_contrast < 1e-5)
+                    sum_contrast = 1e-5f;
+                float F_mask[PYRAMID_MAX_LEVELS - 2];
+                float adapt = la.value(x, y, adaptation_level)
+                              + lb.value(x, y, adaptation_level);
+                adapt *= 0.5f;
+                if (adapt < 1e-5)
+                    adapt = 1e-5f;
+                for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++)
+                    F_mask[i] = mask(contrast[i]
+                                     * contrast_sensitivity(cpd[i], adapt));
+                float factor = 0;
+                for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++)
+                    factor += contrast[i] * F_freq[i] * F_mask[i]
+                              / sum_contrast;
+                factor      = OIIO::clamp(factor, 1.0f, 10.0f);
+                float delta = fabsf(la.value(x, y, 0) - lb.value(x, y, 0));
+                bool pass   = true;
+                // pure luminance test
+                delta /= tvi(adapt);
+                if (delta > factor) {
                     pass = false;
-            }
-            if (!pass) {
-                ++result.nfail;
-                if (factor > result.maxerror) {
-                    result.maxerror = factor;
-                    result.maxx     = x;
-                    result.maxy     = y;
-                    //                    result.maxz = z;
+                } else if (!luminanceOnly) {
+                    // CIE delta E test with modifications
+                    float color_scale = 1.0f;
+                    // ramp down the color test in scotopic regions
+                    if (adapt < 10.0f) {
+                        color_scale = 1.0f - (10.0f - color_scale) / 10.0f;
+                        color_scale = color_scale * color_scale;
+                    }
+                    size_t idx = (size_t(y) * roi.width() + x) * 3;
+                    // diff in A, diff in B
+                    float da = aLABpix[idx + 1] - bLABpix[idx + 1];
+                    float db = aLABpix[idx + 2] - bLABpix[idx + 2];
+                    da       = da * da;
+                    db       = db * db;
+                    delta    = (da + db) * color_scale;
+                    if (delta > factor)
+                        pass = false;
                 }
+                if (!pass) {
+                    ++nfail;
+                    if (factor > maxerror) {
+                        maxerror = factor;
+                        maxx     = x;
+                        maxy     = y;
+                        //                    maxz = z;
+                    }
+                }
+            }
+        if (nfail) {
+            std::lock_guard<std::mutex> lock(result_mutex);
+            result.nfail += nfail;
+            if (maxerror > result.maxerror) {
+                result.maxerror = maxerror;
+                result.maxx     = maxx;
+                result.maxy     = maxy;
             }
         }
-    }
+    });
 
     return result.nfail;
 }
@@ -227,6 +227,22 @@ test_app_buffer()
     OIIO_CHECK_EQUAL(testpixel[1], pixels[1][1][1]);
     OIIO_CHECK_EQUAL(testpixel[2], pixels[1][1][2]);
 
+    // Now push updated pixels for the same tile with replace=true
+    // ("write-through") and verify that lookups see the new values even
+    // though the old tile was already resident.
+    float newpixels[yres][xres][chans] = { { { 0.5f, 0, 0 }, { 0.5f, 1, 0 } },
+                                           { { 0.5f, 0, 1 }, { 0.5f, 1, 1 } } };
+    ok = imagecache->add_tile(fooname, 0, 0, 0, 0, 0, 0, chans, imgtype,
+                              newpixels, AutoStride, AutoStride, AutoStride,
+                              true /*copy*/, true /*replace*/);
+    OIIO_CHECK_ASSERT(ok);
+    float testpixel2[3] = { -1, -1, -1 };
+    imagecache->get_pixels(fooname, 0, 0, 1, 2, 1, 2, 0, 1, 0, 3,
+                           TypeDesc::FLOAT, testpixel2);
+    OIIO_CHECK_EQUAL(testpixel2[0], newpixels[1][1][0]);
+    OIIO_CHECK_EQUAL(testpixel2[1], newpixels[1][1][1]);
+    OIIO_CHECK_EQUAL(testpixel2[2], newpixels[1][1][2]);
+
     ImageCache::destroy(imagecache);
 }
 
@@ -332,6 +348,31 @@ test_imagespec()
 
 
 
+static void
+test_sequence_prefetch()
+{
+    Strutil::print("\nTesting sequence prefetch\n");
+    ImageCache* ic = ImageCache::create();
+    // The checker texture happens to be named like frame 1001 of a
+    // sequence, so use it as a one-frame playback prefetch target.
+    std::string temp_dir = Filesystem::temp_directory_path();
+    std::string pattern  = Strutil::fmt::format("{}/checkertex.%04d.exr",
+                                                temp_dir);
+    ic->prefetch_sequence(pattern, 1001, 1);
+    // Prefetch is advisory and asynchronous; the frame must read correctly
+    // whether or not the background tasks have finished yet.
+    float pixel[3];
+    OIIO_CHECK_ASSERT(ic->get_pixels(checkertex, 0, 0, 0, 1, 0, 1, 0, 1,
+                                     TypeFloat, pixel));
+    // A playhead jump or stop cancels cleanly.
+    ic->cancel_sequence_prefetch();
+    // Missing frames are quietly skipped -- they error only if played.
+    ic->prefetch_sequence("noexist.%04d.exr", 1, 4);
+    ic->cancel_sequence_prefetch();
+}
+
+
+
 int
 main(int /*argc*/, char* /*argv*/[])
 {
@@ -349,6 +390,7 @@ main(int /*argc*/, char* /*argv*/[])
     test_get_pixels_errors();
     test_custom_threadinfo();
     test_imagespec();
+    test_sequence_prefetch();
 
     ImageCache* ic = ImageCache::create();
     Strutil::print("\n\n{}\n", ic->getstats(5));
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -149,6 +150,8 @@ std::unique_ptr<ImageInput>
 ImageInput::open(const std::string& filename, const ImageSpec* config,
                  Filesystem::IOProxy* ioproxy)
 {
+    static const ustring zone_name("ImageInput::open");
+    ProfilerZone zone(zone_name);
     if (!config) {
         // Without config, this is really just a call to create-with-open.
         return ImageInput::create(filename, true, nullptr, ioproxy);
@@ -173,6 +176,23 @@ ImageInput::open(const std::string& filename, const ImageSpec* config,
 
 
 
+std::future<ImageInput::unique_ptr>
+ImageInput::open_async(const std::string& filename, const ImageSpec* config,
+                       Filesystem::IOProxy* ioproxy)
+{
+    // Capture the config by value -- the caller only guarantees its
+    // lifetime for the duration of this call, not until the open runs.
+    std::shared_ptr<ImageSpec> configcopy;
+    if (config)
+        configcopy = std::make_shared<ImageSpec>(*config);
+    return default_thread_pool()->push(
+        [filename, configcopy, ioproxy](int /*threadid*/) {
+            return ImageInput::open(filename, configcopy.get(), ioproxy);
+        });
+}
+
+
+
 ImageSpec
 ImageInput::spec(int subimage, int miplevel)
 {
@@ -311,6 +331,8 @@ ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
                            int z, int chbegin, int chend, TypeDesc format,
                            void* data, stride_t xstride, stride_t ystride)
 {
+    static const ustring zone_name("ImageInput::read_scanlines");
+    ProfilerZone zone(zone_name);
     ImageSpec spec;
     int rps = 0;
     {
@@ -369,27 +391,67 @@ ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
     int chunk = std::max(1, (1 << 26) / int(spec.scanline_bytes(true)));
     chunk     = std::max(chunk, int(oiio_read_chunk));
     chunk     = round_to_multiple(chunk, rps);
-    std::unique_ptr<char[]> buf(new char[chunk * native_scanline_bytes]);
+
+    // If there is more than one chunk, pipeline: a helper task reads the
+    // native scanlines of chunk N+1 (double buffered) while this thread
+    // converts chunk N, so decompressing I/O and data conversion overlap
+    // instead of strictly alternating. Only one read is ever in flight, so
+    // stateful format readers still see sequential reads. Skip the helper
+    // if the caller asked for single-threaded operation, or if we are
+    // already running inside a pool worker (a full pool blocking on its
+    // own queue could deadlock).
+    thread_pool* pool = default_thread_pool();
+    bool pipelined    = (imagesize_t(yend) - ybegin > imagesize_t(chunk))
+                     && threads() != 1 && pool->size() >= 1
+                     && !pool->is_worker();
+    imagesize_t chunk_bytes = chunk * native_scanline_bytes;
+    std::unique_ptr<char[]> buf(new char[(pipelined ? 2 : 1) * chunk_bytes]);
+    int which = 0;
+    std::future<bool> readahead;
+    if (pipelined) {
+        int y1      = std::min(ybegin + chunk, yend);
+        char* first = &buf[0];
+        int yb      = ybegin;
+        readahead   = pool->push([=](int /*id*/) {
+            return read_native_scanlines(subimage, miplevel, yb, y1, z,
+                                         chbegin, chend, first);
+        });
+    }
 
     bool ok             = true;
     int scanline_values = spec.width * nchans;
     for (; ok && ybegin < yend; ybegin += chunk) {
-        int y1 = std::min(ybegin + chunk, yend);
-        ok &= read_native_scanlines(subimage, miplevel, ybegin, y1, z, chbegin,
-                                    chend, &buf[0]);
-        if (!ok)
-            break;
+        int y1  = std::min(ybegin + chunk, yend);
+        char* b = &buf[which * chunk_bytes];
+        if (pipelined) {
+            ok &= readahead.get();
+            if (!ok)
+                break;
+            if (y1 < yend) {
+                int nexty1    = std::min(y1 + chunk, yend);
+                char* nextbuf = &buf[(which ^ 1) * chunk_bytes];
+                readahead     = pool->push([=](int /*id*/) {
+                    return read_native_scanlines(subimage, miplevel, y1,
+                                                 nexty1, z, chbegin, chend,
+                                                 nextbuf);
+                });
+            }
+        } else {
+            ok &= read_native_scanlines(subimage, miplevel, ybegin, y1, z,
+                                        chbegin, chend, b);
+            if (!ok)
+                break;
+        }
 
         int nscanlines  = y1 - ybegin;
         int chunkvalues = scanline_values * nscanlines;
         if (spec.channelformats.empty()) {
             // No per-channel formats -- do the conversion in one shot
             if (contiguous) {
-                ok = convert_types(spec.format, &buf[0], format, data,
-                                   chunkvalues);
+                ok = convert_types(spec.format, b, format, data, chunkvalues);
             } else {
                 ok = parallel_convert_image(nchans, spec.width, nscanlines, 1,
-                                            &buf[0], spec.format, AutoStride,
+                                            b, spec.format, AutoStride,
                                             AutoStride, AutoStride, data,
                                             format, xstride, ystride, zstride,
                                             threads());
@@ -407,7 +469,7 @@ ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
                     if (spec.channelformats[c + chbegin + n] != chanformat)
                         break;
                 ok = parallel_convert_image(n /* channels */, spec.width,
-                                            nscanlines, 1, &buf[offset],
+                                            nscanlines, 1, &b[offset],
                                             chanformat, native_pixel_bytes,
                                             AutoStride, AutoStride,
                                             (char*)data + c * format.size(),
@@ -416,16 +478,35 @@ ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
                 offset += n * chanformat.size();
             }
         }
+        which ^= 1;
         if (!ok)
             errorfmt("ImageInput::read_scanlines : no support for format {}",
                      spec.format);
         data = (char*)data + ystride * nscanlines;
     }
+    // If we bailed out with a read still in flight, wait for it -- it
+    // writes into buf, which is about to be freed.
+    if (readahead.valid())
+        readahead.get();
     return ok;
 }
 
 
 
+std::future<bool>
+ImageInput::read_scanlines_async(int subimage, int miplevel, int ybegin,
+                                 int yend, int z, int chbegin, int chend,
+                                 TypeDesc format, void* data, stride_t xstride,
+                                 stride_t ystride)
+{
+    return default_thread_pool()->push([=](int /*threadid*/) {
+        return read_scanlines(subimage, miplevel, ybegin, yend, z, chbegin,
+                              chend, format, data, xstride, ystride);
+    });
+}
+
+
+
 bool
 ImageInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
                                   int yend, int z, void* data)
@@ -616,6 +697,8 @@ ImageInput::read_tiles(int subimage, int miplevel, int xbegin, int xend,
                        int chend, TypeDesc format, void* data, stride_t xstride,
                        stride_t ystride, stride_t zstride)
 {
+    static const ustring zone_name("ImageInput::read_tiles");
+    ProfilerZone zone(zone_name);
     ImageSpec spec = spec_dimensions(subimage, miplevel);  // thread-safe
     if (spec.undefined())
         return false;
@@ -936,6 +1019,8 @@ ImageInput::read_image(int subimage, int miplevel, int chbegin, int chend,
                        ProgressCallback progress_callback,
                        void* progress_callback_data)
 {
+    static const ustring zone_name("ImageInput::read_image");
+    ProfilerZone zone(zone_name);
     ImageSpec spec;
     int rps = 0;
     {
@@ -996,6 +1081,50 @@ ImageInput::read_image(int subimage, int miplevel, int chbegin, int chend,
                     return ok;
             }
         }
+    } else if (!progress_callback) {  // Scanline image, no progress callback
+        // If the reader advertises independently decodable chunks via
+        // native_chunk_rows (meaning concurrent reads really decode in
+        // parallel instead of queueing on a plugin lock), slice each
+        // plane into chunk-aligned bands and decode the bands on the
+        // thread pool. This one orchestration serves every format that
+        // opts in, so individual readers don't each reinvent threading.
+        int crows         = native_chunk_rows(subimage, miplevel);
+        thread_pool* pool = default_thread_pool();
+        int64_t nchunks   = crows > 0 ? (spec.height + crows - 1) / crows : 0;
+        if (nchunks >= 4 && !spec.deep && threads() != 1 && pool->size() >= 1
+            && !pool->is_worker()) {
+            int nthreads = threads() ? threads() : pool->size() + 1;
+            // Bands of several chunks apiece, so tasks aren't too tiny.
+            int64_t band = std::max(int64_t(2), nchunks / (4 * nthreads))
+                           * int64_t(crows);
+            std::atomic<bool> bandok(true);
+            for (int z = 0; z < spec.depth && ok; ++z) {
+                parallel_for_chunked(
+                    0, int64_t(spec.height), band,
+                    [&, z](int64_t yb, int64_t ye) {
+                        if (!read_scanlines(subimage, miplevel,
+                                            spec.y + int(yb), spec.y + int(ye),
+                                            z + spec.z, chbegin, chend, format,
+                                            (char*)data + z * zstride
+                                                + yb * ystride,
+                                            xstride, ystride))
+                            bandok = false;
+                    },
+                    paropt(threads()));
+                ok &= bandok.load();
+            }
+        } else {
+            // Hand each whole plane to read_scanlines, whose internal
+            // chunking pipelines the native reads of one chunk with the
+            // conversion of the previous one. (With a progress callback,
+            // we instead chunk here, below, so the callback fires as the
+            // read advances.)
+            for (int z = 0; z < spec.depth && ok; ++z)
+                ok &= read_scanlines(subimage, miplevel, spec.y,
+                                     spec.y + spec.height, z + spec.z, chbegin,
+                                     chend, format, (char*)data + z * zstride,
+                                     xstride, ystride);
+        }
     } else {  // Scanline image -- rely on read_scanlines.
         // Split into reasonable chunks -- try to use around 64 MB or the
         // oiio_read_chunk value, which ever is bigger, but also round up to
@@ -1024,6 +1153,20 @@ ImageInput::read_image(int subimage, int miplevel, int chbegin, int chend,
 
 
 
+std::future<bool>
+ImageInput::read_image_async(int subimage, int miplevel, int chbegin,
+                             int chend, TypeDesc format, void* data,
+                             stride_t xstride, stride_t ystride,
+                             stride_t zstride)
+{
+    return default_thread_pool()->push([=](int /*threadid*/) {
+        return read_image(subimage, miplevel, chbegin, chend, format, data,
+                          xstride, ystride, zstride);
+    });
+}
+
+
+
 bool
 ImageInput::read_native_deep_scanlines(int /*subimage*/, int /*miplevel*/,
                                        int /*ybegin*/, int /*yend*/, int /*z*/,
@@ -1239,7 +1382,15 @@ ImageInput::ioproxy_use_or_open(string_view name)
     Filesystem::IOProxy*& m_io(m_impl->m_io);
     if (!m_io) {
         // If no proxy was supplied, create an IOFile
-        m_io = new Filesystem::IOFile(name, Filesystem::IOProxy::Mode::Read);
+        auto io = new Filesystem::IOFile(name,
+                                         Filesystem::IOProxy::Mode::Read);
+        if (pvt::oiio_read_drop_cache) {
+            // One-pass read: advise sequential access and drop pages
+            // behind the read position so huge streaming reads don't
+            // evict more useful data from the page cache.
+            io->set_drop_cache(true);
+        }
+        m_io = io;
         m_impl->m_io_local.reset(m_io);
     }
     if (!m_io || m_io->mode() != Filesystem::IOProxy::Mode::Read) {
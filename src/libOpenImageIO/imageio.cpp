@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
+#include <array>
 #include <cstdio>
 #include <cstdlib>
 
@@ -15,6 +16,7 @@
 #include <OpenImageIO/imageio.h>
 #include <OpenImageIO/optparser.h>
 #include <OpenImageIO/parallel.h>
+#include <OpenImageIO/profiler.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
 #include <OpenImageIO/thread.h>
@@ -43,6 +45,9 @@ atomic_int oiio_threads(threads_default());
 atomic_int oiio_exr_threads(threads_default());
 atomic_int oiio_read_chunk(256);
 atomic_int oiio_try_all_readers(1);
+atomic_int oiio_read_drop_cache(0);
+atomic_int oiio_lazy_exif(0);
+atomic_int oiio_lazy_xmp(0);
 #ifndef OIIO_OPENEXR_CORE_DEFAULT
 #    define OIIO_OPENEXR_CORE_DEFAULT 0
 #endif
@@ -50,6 +55,9 @@ atomic_int oiio_try_all_readers(1);
 int openexr_core(OIIO_OPENEXR_CORE_DEFAULT);
 int tiff_half(0);
 int tiff_multithread(1);
+int jpeg_multithread(1);
+int ptex_max_memory_MB(1024);
+ustring ocio_lut3d_cache_dir;
 int dds_bc5normal(0);
 int limit_channels(1024);
 int limit_imagesize_MB(std::min(32 * 1024,
@@ -421,6 +429,18 @@ attribute(string_view name, TypeDesc type, const void* val)
         tiff_multithread = *(const int*)val;
         return true;
     }
+    if (name == "jpeg:multithread" && type == TypeInt) {
+        jpeg_multithread = *(const int*)val;
+        return true;
+    }
+    if (name == "ptex:max_memory_MB" && type == TypeInt) {
+        ptex_max_memory_MB = *(const int*)val;
+        return true;
+    }
+    if (name == "ocio:lut3d_cache_dir" && type == TypeString) {
+        ocio_lut3d_cache_dir = ustring(*(const char**)val);
+        return true;
+    }
     if (name == "dds:bc5normal" && type == TypeInt) {
         dds_bc5normal = *(const int*)val;
         return true;
@@ -445,6 +465,27 @@ attribute(string_view name, TypeDesc type, const void* val)
         imagebuf_use_imagecache = *(const int*)val;
         return true;
     }
+    if (name == "imagebuf:device_memory" && type == TypeInt) {
+        imagebuf_device_memory = *(const int*)val;
+        return true;
+    }
+    if (name == "imagebuf:alloc_alignment" && type == TypeInt) {
+        imagebuf_alloc_alignment = *(const int*)val;
+        return true;
+    }
+    if (name == "imagebuf:alloc_hugepages" && type == TypeInt) {
+        imagebuf_alloc_hugepages = *(const int*)val;
+        return true;
+    }
+    if (name == "imagebuf:scratch_pool" && type == TypeInt) {
+        imagebuf_scratch_pool = *(const int*)val;
+        imagebuf_scratch_pool_trim();
+        return true;
+    }
+    if (name == "imagebuf:spill_MB" && type == TypeInt) {
+        imagebuf_spill_MB = *(const int*)val;
+        return true;
+    }
     if (name == "use_tbb" && type == TypeInt) {
         oiio_use_tbb = *(const int*)val;
         return true;
@@ -457,6 +498,22 @@ attribute(string_view name, TypeDesc type, const void* val)
         oiio_log_times = *(const int*)val;
         return true;
     }
+    if (name == "profiler:enable" && type == TypeInt) {
+        Profiler::enable(*(const int*)val != 0);
+        return true;
+    }
+    if (name == "threads:adaptive_spin_count" && type == TypeInt) {
+        pvt::adaptive_mutex_spins = std::max(0, *(const int*)val);
+        return true;
+    }
+    if (name == "profiler:clear" && type == TypeInt) {
+        Profiler::clear();
+        return true;
+    }
+    if (name == "profiler:tracefile" && type == TypeString) {
+        Profiler::set_trace_file(*(const char**)val);
+        return true;
+    }
     if (name == "missingcolor" && type.basetype == TypeDesc::FLOAT) {
         // missingcolor as float array
         oiio_missingcolor.assign((const float*)val,
@@ -473,6 +530,18 @@ attribute(string_view name, TypeDesc type, const void* val)
         oiio_try_all_readers = *(const int*)val;
         return true;
     }
+    if (name == "read:drop_cache" && type == TypeInt) {
+        oiio_read_drop_cache = *(const int*)val;
+        return true;
+    }
+    if (name == "exif:lazy" && type == TypeInt) {
+        oiio_lazy_exif = *(const int*)val;
+        return true;
+    }
+    if (name == "xmp:lazy" && type == TypeInt) {
+        oiio_lazy_xmp = *(const int*)val;
+        return true;
+    }
 
     return false;
 }
@@ -583,6 +652,18 @@ getattribute(string_view name, TypeDesc type, void* val)
         *(int*)val = tiff_multithread;
         return true;
     }
+    if (name == "jpeg:multithread" && type == TypeInt) {
+        *(int*)val = jpeg_multithread;
+        return true;
+    }
+    if (name == "ptex:max_memory_MB" && type == TypeInt) {
+        *(int*)val = ptex_max_memory_MB;
+        return true;
+    }
+    if (name == "ocio:lut3d_cache_dir" && type == TypeString) {
+        *(ustring*)val = ocio_lut3d_cache_dir;
+        return true;
+    }
     if (name == "dds:bc5normal" && type == TypeInt) {
         *(int*)val = dds_bc5normal;
         return true;
@@ -599,6 +680,26 @@ getattribute(string_view name, TypeDesc type, void* val)
         *(int*)val = imagebuf_use_imagecache;
         return true;
     }
+    if (name == "imagebuf:device_memory" && type == TypeInt) {
+        *(int*)val = imagebuf_device_memory;
+        return true;
+    }
+    if (name == "imagebuf:alloc_alignment" && type == TypeInt) {
+        *(int*)val = imagebuf_alloc_alignment;
+        return true;
+    }
+    if (name == "imagebuf:alloc_hugepages" && type == TypeInt) {
+        *(int*)val = imagebuf_alloc_hugepages;
+        return true;
+    }
+    if (name == "imagebuf:scratch_pool" && type == TypeInt) {
+        *(int*)val = imagebuf_scratch_pool;
+        return true;
+    }
+    if (name == "imagebuf:spill_MB" && type == TypeInt) {
+        *(int*)val = imagebuf_spill_MB;
+        return true;
+    }
     if (name == "use_tbb" && type == TypeInt) {
         *(int*)val = oiio_use_tbb;
         return true;
@@ -615,6 +716,22 @@ getattribute(string_view name, TypeDesc type, void* val)
         *(ustring*)val = ustring(timing_log.report());
         return true;
     }
+    if (name == "profiler:enable" && type == TypeInt) {
+        *(int*)val = Profiler::enabled();
+        return true;
+    }
+    if (name == "threads:adaptive_spin_count" && type == TypeInt) {
+        *(int*)val = pvt::adaptive_mutex_spins;
+        return true;
+    }
+    if (name == "profiler:report" && type == TypeString) {
+        *(ustring*)val = ustring(Profiler::report());
+        return true;
+    }
+    if (name == "profiler:trace" && type == TypeString) {
+        *(ustring*)val = ustring(Profiler::chrome_trace());
+        return true;
+    }
     if (name == "hw:simd" && type == TypeString) {
         *(ustring*)val = ustring(hw_simd_caps());
         return true;
@@ -639,6 +756,26 @@ getattribute(string_view name, TypeDesc type, void* val)
         *(int*)val = int(Sysutil::memory_used(true) >> 20);
         return true;
     }
+    if (name == "memory:imagebuf" && type == TypeInt64) {
+        *(long long*)val = IB_local_mem_current;
+        return true;
+    }
+    if (name == "memory:imagebuf_peak" && type == TypeInt64) {
+        *(long long*)val = IB_local_mem_peak;
+        return true;
+    }
+    if (name == "memory:imagecache_tiles" && type == TypeInt64) {
+        *(long long*)val = IC_tile_mem_current;
+        return true;
+    }
+    if (name == "memory:deepdata" && type == TypeInt64) {
+        *(long long*)val = DD_mem_current;
+        return true;
+    }
+    if (name == "memory:process" && type == TypeInt64) {
+        *(long long*)val = (long long)Sysutil::memory_used(true);
+        return true;
+    }
     if (name == "missingcolor" && type.basetype == TypeDesc::FLOAT
         && oiio_missingcolor.size()) {
         // missingcolor as float array
@@ -659,6 +796,18 @@ getattribute(string_view name, TypeDesc type, void* val)
         *(int*)val = oiio_try_all_readers;
         return true;
     }
+    if (name == "read:drop_cache" && type == TypeInt) {
+        *(int*)val = oiio_read_drop_cache;
+        return true;
+    }
+    if (name == "exif:lazy" && type == TypeInt) {
+        *(int*)val = oiio_lazy_exif;
+        return true;
+    }
+    if (name == "xmp:lazy" && type == TypeInt) {
+        *(int*)val = oiio_lazy_xmp;
+        return true;
+    }
     if (name == "opencolorio_version" && type == TypeString) {
         int v          = ColorConfig::OpenColorIO_version_hex();
         *(ustring*)val = ustring::fmtformat("{}.{}.{}", v >> 24,
@@ -857,6 +1006,80 @@ pvt::parallel_convert_from_float(const float* src, void* dst, size_t nvals,
 
 
 
+namespace {
+
+// One conversion kernel per (src type, dst type) pair, with both types
+// fixed at compile time so each instantiation is a tight loop (hitting the
+// SIMD specializations of convert_type where they exist).
+template<typename S, typename D>
+void
+convert_values_kernel(const void* src, void* dst, size_t nvals)
+{
+    convert_type((const S*)src, (D*)dst, nvals);
+}
+
+
+// One row of the kernel table: src type S converting to every dst type.
+// Non-numeric destination basetypes are left null.
+template<typename S>
+constexpr std::array<pvt::convert_values_fn, TypeDesc::LASTBASE>
+convert_values_row()
+{
+    std::array<pvt::convert_values_fn, TypeDesc::LASTBASE> row = {};
+    row[TypeDesc::UINT8]  = convert_values_kernel<S, unsigned char>;
+    row[TypeDesc::INT8]   = convert_values_kernel<S, char>;
+    row[TypeDesc::UINT16] = convert_values_kernel<S, unsigned short>;
+    row[TypeDesc::INT16]  = convert_values_kernel<S, short>;
+    row[TypeDesc::UINT]   = convert_values_kernel<S, unsigned int>;
+    row[TypeDesc::INT]    = convert_values_kernel<S, int>;
+    row[TypeDesc::UINT64] = convert_values_kernel<S, unsigned long long>;
+    row[TypeDesc::INT64]  = convert_values_kernel<S, long long>;
+    row[TypeDesc::HALF]   = convert_values_kernel<S, half>;
+    row[TypeDesc::FLOAT]  = convert_values_kernel<S, float>;
+    row[TypeDesc::DOUBLE] = convert_values_kernel<S, double>;
+    return row;
+}
+
+
+// The full (src basetype x dst basetype) kernel matrix, built once at
+// compile time.
+constexpr std::array<std::array<pvt::convert_values_fn, TypeDesc::LASTBASE>,
+                     TypeDesc::LASTBASE>
+make_convert_values_table()
+{
+    std::array<std::array<pvt::convert_values_fn, TypeDesc::LASTBASE>,
+               TypeDesc::LASTBASE>
+        table = {};
+    table[TypeDesc::UINT8]  = convert_values_row<unsigned char>();
+    table[TypeDesc::INT8]   = convert_values_row<char>();
+    table[TypeDesc::UINT16] = convert_values_row<unsigned short>();
+    table[TypeDesc::INT16]  = convert_values_row<short>();
+    table[TypeDesc::UINT]   = convert_values_row<unsigned int>();
+    table[TypeDesc::INT]    = convert_values_row<int>();
+    table[TypeDesc::UINT64] = convert_values_row<unsigned long long>();
+    table[TypeDesc::INT64]  = convert_values_row<long long>();
+    table[TypeDesc::HALF]   = convert_values_row<half>();
+    table[TypeDesc::FLOAT]  = convert_values_row<float>();
+    table[TypeDesc::DOUBLE] = convert_values_row<double>();
+    return table;
+}
+
+constexpr auto convert_values_table = make_convert_values_table();
+
+}  // namespace
+
+
+pvt::convert_values_fn
+pvt::get_convert_values_fn(TypeDesc src_type, TypeDesc dst_type)
+{
+    if (src_type.basetype < TypeDesc::LASTBASE
+        && dst_type.basetype < TypeDesc::LASTBASE)
+        return convert_values_table[src_type.basetype][dst_type.basetype];
+    return nullptr;
+}
+
+
+
 bool
 convert_pixel_values(TypeDesc src_type, const void* src, TypeDesc dst_type,
                      void* dst, int n)
@@ -867,45 +1090,15 @@ convert_pixel_values(TypeDesc src_type, const void* src, TypeDesc dst_type,
         return true;
     }
 
-    if (dst_type == TypeFloat) {
-        // Special case -- converting non-float to float
-        pvt::convert_to_float(src, (float*)dst, n, src_type);
+    // Direct conversion with both types fixed at compile time. (Note that
+    // this also converts between two non-float types in a single pass,
+    // where we formerly went through an intermediate float buffer.)
+    if (pvt::convert_values_fn cvt = pvt::get_convert_values_fn(src_type,
+                                                                dst_type)) {
+        cvt(src, dst, size_t(n));
         return true;
     }
-
-    // Conversion is to a non-float type
-
-    std::unique_ptr<float[]> tmp;  // In case we need a lot of temp space
-    float* buf = (float*)src;
-    if (src_type != TypeFloat) {
-        // If src is also not float, convert through an intermediate buffer
-        if (n <= 4096)  // If < 16k, use the stack
-            buf = OIIO_ALLOCA(float, n);
-        else {
-            tmp.reset(new float[n]);  // Freed when tmp exists its scope
-            buf = tmp.get();
-        }
-        pvt::convert_to_float(src, buf, n, src_type);
-    }
-
-    // Convert float to 'dst_type'
-    switch (dst_type.basetype) {
-    case TypeDesc::UINT8: convert_type(buf, (unsigned char*)dst, n); break;
-    case TypeDesc::UINT16: convert_type(buf, (unsigned short*)dst, n); break;
-    case TypeDesc::HALF: convert_type(buf, (half*)dst, n); break;
-    case TypeDesc::INT8: convert_type(buf, (char*)dst, n); break;
-    case TypeDesc::INT16: convert_type(buf, (short*)dst, n); break;
-    case TypeDesc::INT: convert_type(buf, (int*)dst, n); break;
-    case TypeDesc::UINT: convert_type(buf, (unsigned int*)dst, n); break;
-    case TypeDesc::INT64: convert_type(buf, (long long*)dst, n); break;
-    case TypeDesc::UINT64:
-        convert_type(buf, (unsigned long long*)dst, n);
-        break;
-    case TypeDesc::DOUBLE: convert_type(buf, (double*)dst, n); break;
-    default: return false;  // unknown format
-    }
-
-    return true;
+    return false;  // unknown format
 }
 
 
@@ -928,7 +1121,13 @@ convert_image(int nchannels, int width, int height, int depth, const void* src,
                            nchannels, width, height);
     ImageSpec::auto_stride(dst_xstride, dst_ystride, dst_zstride, dst_type,
                            nchannels, width, height);
-    bool result = true;
+    // Look up the specialized conversion kernel once for the whole image,
+    // rather than re-dispatching on the types per scanline (or, for the
+    // strided case, per pixel).
+    pvt::convert_values_fn cvt = pvt::get_convert_values_fn(src_type,
+                                                            dst_type);
+    if (!cvt)
+        return false;  // unknown format
     bool contig = (src_xstride == stride_t(nchannels * src_type.size())
                    && dst_xstride == stride_t(nchannels * dst_type.size()));
     for (int z = 0; z < depth; ++z) {
@@ -940,22 +1139,19 @@ convert_image(int nchannels, int width, int height, int depth, const void* src,
                 // Special case: pixels within each row are contiguous
                 // in both src and dst and we're copying all channels.
                 // Be efficient by converting each scanline as a single
-                // unit.  (Note that within convert_pixel_values, a memcpy
-                // will be used if the formats are identical.)
-                result &= convert_pixel_values(src_type, f, dst_type, t,
-                                               nchannels * width);
+                // unit.
+                cvt(f, t, size_t(nchannels) * width);
             } else {
                 // General case -- anything goes with strides.
                 for (int x = 0; x < width; ++x) {
-                    result &= convert_pixel_values(src_type, f, dst_type, t,
-                                                   nchannels);
+                    cvt(f, t, size_t(nchannels));
                     f += src_xstride;
                     t += dst_xstride;
                 }
             }
         }
     }
-    return result;
+    return true;
 }
 
 
@@ -995,6 +1191,21 @@ parallel_convert_image(int nchannels, int width, int height, int depth,
 
 
 
+// Copy a row of pixels with arbitrary x strides, moving SIZE bytes per
+// pixel. With the size a compile-time constant, the memcpy decays into a
+// register move and the loop vectorizes, rather than making a real library
+// call per pixel.
+template<int SIZE>
+static inline void
+copy_row_strided(char* t, const char* f, int width, stride_t dst_xstride,
+                 stride_t src_xstride)
+{
+    for (int x = 0; x < width; ++x, f += src_xstride, t += dst_xstride)
+        memcpy(t, f, SIZE);
+}
+
+
+
 bool
 copy_image(int nchannels, int width, int height, int depth, const void* src,
            stride_t pixelsize, stride_t src_xstride, stride_t src_ystride,
@@ -1019,13 +1230,28 @@ copy_image(int nchannels, int width, int height, int depth, const void* src,
                 // Be efficient by converting each scanline as a single
                 // unit.
                 memcpy(t, f, width * pixelsize);
-            } else {
-                // General case -- anything goes with strides.
+                continue;
+            }
+            // Strided case: dispatch the common pixel sizes (single
+            // channels and full pixels of 8/16/32 bit data) to
+            // constant-size copy loops; anything exotic falls back to
+            // per-pixel memcpy with a runtime size.
+            switch (pixelsize) {
+            case 1: copy_row_strided<1>(t, f, width, dst_xstride, src_xstride); break;
+            case 2: copy_row_strided<2>(t, f, width, dst_xstride, src_xstride); break;
+            case 3: copy_row_strided<3>(t, f, width, dst_xstride, src_xstride); break;
+            case 4: copy_row_strided<4>(t, f, width, dst_xstride, src_xstride); break;
+            case 6: copy_row_strided<6>(t, f, width, dst_xstride, src_xstride); break;
+            case 8: copy_row_strided<8>(t, f, width, dst_xstride, src_xstride); break;
+            case 12: copy_row_strided<12>(t, f, width, dst_xstride, src_xstride); break;
+            case 16: copy_row_strided<16>(t, f, width, dst_xstride, src_xstride); break;
+            default:
                 for (int x = 0; x < width; ++x) {
                     memcpy(t, f, pixelsize);
                     f += src_xstride;
                     t += dst_xstride;
                 }
+                break;
             }
         }
     }
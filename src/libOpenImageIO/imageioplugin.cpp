@@ -4,6 +4,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <map>
 #include <set>
 #include <string>
@@ -48,6 +49,19 @@ static std::vector<ustring> format_list_vector;
 // Which format names and extensions are procedural (not reading from files)
 static std::set<std::string> procedural_plugins;
 
+// Plugins we know about from an install-time manifest but have not yet
+// dlopened. Maps format name and each extension to the plugin that
+// provides it. Guarded by imageio_mutex.
+struct DeferredPlugin {
+    std::string format_name;
+    std::string fullpath;
+};
+static std::map<std::string, DeferredPlugin> deferred_plugins;
+
+// Format names that were declared from a manifest, so that the eventual
+// real load doesn't append them to the master format lists a second time.
+static std::set<std::string> deferred_declared;
+
 static std::string pattern = Strutil::fmt::format(".imageio.{}",
                                                   Plugin::plugin_extension());
 
@@ -59,6 +73,83 @@ add_if_missing(std::vector<std::string>& vec, const std::string& val)
         vec.push_back(val);
 }
 
+
+// "Magic number" signatures that identify file formats by their first few
+// bytes, used to guess the format of a file whose extension is missing or
+// misleading. Only formats with reliable leading signatures are listed;
+// anything else falls through to the usual try-every-plugin search. A
+// match here is just a strong hint -- the file is still opened and
+// verified by the plugin before we commit to it.
+struct MagicSignature {
+    const char* format;  // format name
+    int offset;          // byte offset of the signature within the file
+    int len;             // signature length in bytes
+    const char* bytes;   // the signature itself (may contain NUL bytes)
+};
+
+// clang-format off
+static const MagicSignature format_signatures[] = {
+    { "openexr",   0,  4, "\x76\x2f\x31\x01" },
+    { "tiff",      0,  4, "II\x2a\x00" },
+    { "tiff",      0,  4, "MM\x00\x2a" },
+    { "tiff",      0,  4, "II\x2b\x00" },  // BigTIFF
+    { "tiff",      0,  4, "MM\x00\x2b" },  // BigTIFF
+    { "jpeg",      0,  3, "\xff\xd8\xff" },
+    { "png",       0,  8, "\x89PNG\r\n\x1a\n" },
+    { "gif",       0,  6, "GIF87a" },
+    { "gif",       0,  6, "GIF89a" },
+    { "bmp",       0,  2, "BM" },
+    { "dds",       0,  4, "DDS " },
+    { "dpx",       0,  4, "SDPX" },
+    { "dpx",       0,  4, "XPDS" },
+    { "cineon",    0,  4, "\x80\x2a\x5f\xd7" },
+    { "cineon",    0,  4, "\xd7\x5f\x2a\x80" },
+    { "fits",      0,  6, "SIMPLE" },
+    { "hdr",       0,  2, "#?" },     // "#?RADIANCE" or "#?RGBE"
+    { "iff",       0,  4, "FOR4" },
+    { "jpeg2000",  0, 12, "\x00\x00\x00\x0c\x6a\x50\x20\x20\x0d\x0a\x87\x0a" },
+    { "jpeg2000",  0,  4, "\xff\x4f\xff\x51" },  // raw codestream
+    { "jpegxl",    0,  2, "\xff\x0a" },
+    { "jpegxl",    0, 12, "\x00\x00\x00\x0c\x4a\x58\x4c\x20\x0d\x0a\x87\x0a" },
+    { "pnm",       0,  2, "P1" }, { "pnm", 0, 2, "P2" },
+    { "pnm",       0,  2, "P3" }, { "pnm", 0, 2, "P4" },
+    { "pnm",       0,  2, "P5" }, { "pnm", 0, 2, "P6" },
+    { "pnm",       0,  2, "P7" },
+    { "pnm",       0,  2, "PF" }, { "pnm", 0, 2, "Pf" },  // PFM
+    { "psd",       0,  4, "8BPS" },
+    { "ptex",      0,  4, "Ptex" },
+    { "sgi",       0,  2, "\x01\xda" },
+    { "softimage", 0,  4, "\x53\x80\xf6\x34" },
+    { "webp",      8,  4, "WEBP" },  // RIFF container with a WEBP chunk
+    { "heif",      4,  8, "ftypheic" },
+    { "heif",      4,  8, "ftypheix" },
+    { "heif",      4,  8, "ftypmif1" },
+    { "heif",      4,  8, "ftypavif" },
+    { "zfile",     0,  4, "\xab\x67\x08\x2f" },
+    { "zfile",     0,  4, "\x2f\x08\x67\xab" },  // other endianness
+};
+// clang-format on
+
+
+// Check the first bytes of the file (or IOProxy) against the signature
+// table, returning the name of the matching format, or the empty string if
+// the contents match no signature we know. This costs one small read,
+// versus speculatively opening the file with every plugin in turn.
+static std::string
+format_from_magic(string_view filename, Filesystem::IOProxy* ioproxy)
+{
+    char header[64];
+    size_t n = ioproxy ? ioproxy->pread(header, sizeof(header), 0)
+                       : Filesystem::read_bytes(filename, header,
+                                                sizeof(header));
+    for (const MagicSignature& sig : format_signatures) {
+        if (size_t(sig.offset) + size_t(sig.len) <= n
+            && !memcmp(header + sig.offset, sig.bytes, sig.len))
+            return sig.format;
+    }
+    return {};
+}
+
 }  // namespace
 
 
@@ -112,25 +203,29 @@ declare_imageio_format_locked(const std::string& format_name,
     }
 
     // Add the name to the master list of format_names, and extensions to
-    // their master list.
-    format_list_vector.emplace_back(Strutil::lower(format_name));
-    if (format_list.length())
-        format_list += std::string(",");
-    format_list += format_name;
-    if (input_creator) {
-        if (input_format_list.length())
-            input_format_list += std::string(",");
-        input_format_list += format_name;
-    }
-    if (output_creator) {
-        if (output_format_list.length())
-            output_format_list += std::string(",");
-        output_format_list += format_name;
+    // their master list -- unless this format was already declared from a
+    // plugin manifest, in which case the lists include it already.
+    if (deferred_declared.find(Strutil::lower(format_name))
+        == deferred_declared.end()) {
+        format_list_vector.emplace_back(Strutil::lower(format_name));
+        if (format_list.length())
+            format_list += std::string(",");
+        format_list += format_name;
+        if (input_creator) {
+            if (input_format_list.length())
+                input_format_list += std::string(",");
+            input_format_list += format_name;
+        }
+        if (output_creator) {
+            if (output_format_list.length())
+                output_format_list += std::string(",");
+            output_format_list += format_name;
+        }
+        if (extension_list.length())
+            extension_list += std::string(";");
+        extension_list += format_name + std::string(":");
+        extension_list += Strutil::join(all_extensions, ",");
     }
-    if (extension_list.length())
-        extension_list += std::string(";");
-    extension_list += format_name + std::string(":");
-    extension_list += Strutil::join(all_extensions, ",");
     if (lib_version) {
         format_library_versions[format_name] = lib_version;
         if (library_list.length())
@@ -245,6 +340,116 @@ catalog_plugin(const std::string& format_name,
 
 
 
+// Each directory in the plugin searchpath may contain a manifest file,
+// "oiio_plugin_manifest.txt", typically generated at install time, listing
+// the plugins that live there: one line per plugin of the form
+//
+//     formatname;io;ext1,ext2,...
+//
+// where the middle field says whether the plugin can read ("i"), write
+// ("o"), or both ("io"), and the plugin file itself is presumed to be
+// named "<formatname>.imageio.<ext>" in the same directory, as always.
+// Blank lines and lines starting with '#' are ignored. When a manifest is
+// present, we register the format names and extensions it lists without
+// dlopening anything, deferring the load of each plugin until its format
+// is actually requested; directories without a manifest are scanned and
+// loaded eagerly as they always have been. Returns true if a manifest was
+// found and parsed. Caller must hold imageio_mutex.
+static bool
+catalog_manifest(const std::string& dir)
+{
+    std::string contents;
+    if (!Filesystem::read_text_file(dir + "/oiio_plugin_manifest.txt",
+                                    contents))
+        return false;
+    for (auto line : Strutil::splitsv(contents, "\n")) {
+        line = Strutil::strip(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+        auto fields = Strutil::splitsv(line, ";");
+        if (fields.size() != 3)
+            continue;  // malformed line -- just skip it
+        std::string name = Strutil::lower(Strutil::strip(fields[0]));
+        if (input_formats.find(name) != input_formats.end()
+            || output_formats.find(name) != output_formats.end()
+            || deferred_plugins.find(name) != deferred_plugins.end())
+            continue;  // we already have this format covered
+        bool has_input  = fields[1].find('i') != string_view::npos;
+        bool has_output = fields[1].find('o') != string_view::npos;
+        DeferredPlugin plugin { name, dir + "/" + name + pattern };
+        deferred_plugins[name] = plugin;
+        std::vector<std::string> exts;
+        for (auto e : Strutil::splitsv(fields[2], ",")) {
+            std::string ext = Strutil::lower(Strutil::strip(e));
+            if (ext.empty())
+                continue;
+            add_if_missing(exts, ext);
+            if (deferred_plugins.find(ext) == deferred_plugins.end())
+                deferred_plugins[ext] = plugin;
+            if (extension_to_format_map.find(ext)
+                == extension_to_format_map.end())
+                extension_to_format_map[ext] = name;
+        }
+        // Add the format to the master lists now, so that queries about
+        // the available formats and extensions are answered correctly
+        // without loading anything.
+        deferred_declared.insert(name);
+        format_list_vector.emplace_back(name);
+        if (format_list.length())
+            format_list += std::string(",");
+        format_list += name;
+        if (has_input) {
+            if (input_format_list.length())
+                input_format_list += std::string(",");
+            input_format_list += name;
+        }
+        if (has_output) {
+            if (output_format_list.length())
+                output_format_list += std::string(",");
+            output_format_list += name;
+        }
+        if (extension_list.length())
+            extension_list += std::string(";");
+        extension_list += name + std::string(":");
+        extension_list += Strutil::join(exts, ",");
+    }
+    return true;
+}
+
+
+
+// If the given format name or extension refers to a manifest-declared
+// plugin that hasn't been dlopened yet, load it for real, then drop the
+// deferred entries that pointed at it. Caller must hold imageio_mutex.
+static void
+load_deferred_plugin(const std::string& key)
+{
+    auto found = deferred_plugins.find(key);
+    if (found == deferred_plugins.end())
+        return;
+    DeferredPlugin plugin = found->second;
+    catalog_plugin(plugin.format_name, plugin.fullpath);
+    for (auto i = deferred_plugins.begin(); i != deferred_plugins.end();)
+        if (i->second.fullpath == plugin.fullpath)
+            i = deferred_plugins.erase(i);
+        else
+            ++i;
+}
+
+
+
+// Load every manifest-declared plugin that hasn't been loaded yet, for
+// the cases (like trying every reader in turn) where any of them might be
+// the one we need. Caller must hold imageio_mutex.
+static void
+load_all_deferred_plugins()
+{
+    while (!deferred_plugins.empty())
+        load_deferred_plugin(deferred_plugins.begin()->first);
+}
+
+
+
 #ifdef EMBED_PLUGINS
 
 // Make extern declarations for the input and output create routines and
@@ -474,6 +679,10 @@ pvt::catalog_all_plugins(std::string searchpath)
     std::vector<std::string> dirs;
     Filesystem::searchpath_split(searchpath, dirs, true);
     for (const auto& dir : dirs) {
+        // If the directory has a plugin manifest, register its contents
+        // lazily rather than dlopening every plugin it holds.
+        if (catalog_manifest(dir))
+            continue;
         std::vector<std::string> dir_entries;
         Filesystem::get_directory_entries(dir, dir_entries);
         for (const auto& full_filename : dir_entries) {
@@ -552,6 +761,13 @@ ImageOutput::create(string_view filename, Filesystem::IOProxy* ioproxy,
             lock.lock();
             found = output_formats.find(format);
         }
+        if (found == output_formats.end()
+            && deferred_plugins.find(format) != deferred_plugins.end()) {
+            // The format is known from a plugin manifest but its plugin
+            // hasn't been loaded yet. Load it now.
+            load_deferred_plugin(format);
+            found = output_formats.find(format);
+        }
         if (found != output_formats.end()) {
             create_function = found->second;
         } else {
@@ -693,6 +909,13 @@ ImageInput::create(string_view filename, bool do_open, const ImageSpec* config,
             lock.lock();
             found = input_formats.find(format);
         }
+        if (found == input_formats.end()
+            && deferred_plugins.find(format) != deferred_plugins.end()) {
+            // The format is known from a plugin manifest but its plugin
+            // hasn't been loaded yet. Load it now.
+            load_deferred_plugin(format);
+            found = input_formats.find(format);
+        }
         if (found != input_formats.end())
             create_function = found->second;
     }
@@ -755,8 +978,23 @@ ImageInput::create(string_view filename, bool do_open, const ImageSpec* config,
         if (config)
             myconfig = *config;
         myconfig.attribute("nowait", (int)1);
+        // Before working through every plugin, peek at the first bytes of
+        // the file and check them against the table of known format
+        // signatures. If we get a match, try that format first -- in the
+        // common case (extensionless file of a well-known format) this
+        // means one small read and one open attempt instead of dozens.
+        std::string magic_format = format_from_magic(filename, ioproxy);
         std::lock_guard<std::recursive_mutex> lock(imageio_mutex);
-        for (auto f : format_list_vector) {
+        // Any manifest-declared plugins not yet loaded might be the right
+        // reader; bring them all in before trying everything.
+        load_all_deferred_plugins();
+        std::vector<ustring> formats_to_try;
+        formats_to_try.reserve(format_list_vector.size() + 1);
+        if (magic_format.size())
+            formats_to_try.emplace_back(magic_format);
+        formats_to_try.insert(formats_to_try.end(), format_list_vector.begin(),
+                              format_list_vector.end());
+        for (auto f : formats_to_try) {
             auto plugin = input_formats.find(f.string());
             if (plugin == input_formats.end() || !plugin->second)
                 continue;  // format that's output only
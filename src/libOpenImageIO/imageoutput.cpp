@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -115,6 +116,8 @@ ImageOutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
                              const void* data, stride_t xstride,
                              stride_t ystride)
 {
+    static const ustring zone_name("ImageOutput::write_scanlines");
+    ProfilerZone zone(zone_name);
     // Default implementation: write each scanline individually
     stride_t native_pixel_bytes = (stride_t)m_spec.pixel_bytes(true);
     if (format == TypeDesc::UNKNOWN && xstride == AutoStride)
@@ -148,6 +151,8 @@ ImageOutput::write_tiles(int xbegin, int xend, int ybegin, int yend, int zbegin,
                          int zend, TypeDesc format, const void* data,
                          stride_t xstride, stride_t ystride, stride_t zstride)
 {
+    static const ustring zone_name("ImageOutput::write_tiles");
+    ProfilerZone zone(zone_name);
     if (!m_spec.valid_tile_range(xbegin, xend, ybegin, yend, zbegin, zend))
         return false;
 
@@ -482,6 +487,8 @@ ImageOutput::write_image(TypeDesc format, const void* data, stride_t xstride,
                          ProgressCallback progress_callback,
                          void* progress_callback_data)
 {
+    static const ustring zone_name("ImageOutput::write_image");
+    ProfilerZone zone(zone_name);
     bool native          = (format == TypeDesc::UNKNOWN);
     stride_t pixel_bytes = native ? (stride_t)m_spec.pixel_bytes(native)
                                   : format.size() * m_spec.nchannels;
@@ -543,11 +550,56 @@ ImageOutput::write_image(TypeDesc format, const void* data, stride_t xstride,
         const int yDelta     = isDecreasingY ? -chunk : chunk;
         const int yLoopEnd   = yLoopStart + numChunks * yDelta;
 
+        // Double-buffered pipeline: copy each chunk of the caller's buffer
+        // into one of two staging buffers, then hand it to a pool task that
+        // runs write_scanlines (conversion and format-level writing) while
+        // we stage the next chunk. Only one write is ever in flight, since
+        // format writers are stateful and expect ordered scanlines. Don't
+        // pipeline if there's only one chunk, if the caller registered a
+        // progress callback (whose accounting assumes synchronous writes),
+        // if this output is limited to one thread, or if we're already a
+        // pool worker (blocking on the pool from within it can deadlock).
+        thread_pool* pool = default_thread_pool();
+        bool pipelined = m_spec.depth * numChunks > 1 && !progress_callback
+                         && threads() != 1 && pool->size() >= 1
+                         && !pool->is_worker();
+        stride_t chunk_bytes = stride_t(chunk) * m_spec.width * pixel_bytes;
+        std::unique_ptr<char[]> staging;
+        if (pipelined)
+            staging.reset(new char[2 * chunk_bytes]);
+        int which = 0;
+        std::future<bool> pending;
+
         for (int z = 0; z < m_spec.depth; ++z)
             for (int y = yLoopStart; y != yLoopEnd && ok; y += yDelta) {
                 int yend      = std::min(y + m_spec.y + chunk,
                                          m_spec.y + m_spec.height);
                 const char* d = (const char*)data + z * zstride + y * ystride;
+                if (pipelined) {
+                    // Stage this chunk contiguously, so the caller's buffer
+                    // is no longer referenced once we return.
+                    char* sb = &staging[which * chunk_bytes];
+                    OIIO::copy_image(m_spec.nchannels, m_spec.width,
+                                     yend - (y + m_spec.y), 1, d, pixel_bytes,
+                                     xstride, ystride, AutoStride, sb,
+                                     pixel_bytes, pixel_bytes * m_spec.width,
+                                     AutoStride);
+                    // Wait for the previous chunk's write before issuing
+                    // the next, then push this one to the writer lane.
+                    if (pending.valid())
+                        ok &= pending.get();
+                    if (!ok)
+                        break;
+                    int yb  = y + m_spec.y;
+                    int zb  = z + m_spec.z;
+                    pending = pool->push([=](int /*id*/) {
+                        return write_scanlines(yb, yend, zb, format, sb,
+                                               pixel_bytes,
+                                               pixel_bytes * m_spec.width);
+                    });
+                    which ^= 1;
+                    continue;
+                }
                 ok &= write_scanlines(y + m_spec.y, yend, z + m_spec.z, format,
                                       d, xstride, ystride);
                 if (progress_callback
@@ -558,6 +610,10 @@ ImageOutput::write_image(TypeDesc format, const void* data, stride_t xstride,
                             / (m_spec.height * m_spec.depth)))
                     return ok;
             }
+        // Drain the last in-flight write before the staging buffers go out
+        // of scope.
+        if (pending.valid())
+            ok &= pending.get();
     }
     if (progress_callback)
         progress_callback(progress_callback_data, 1.0f);
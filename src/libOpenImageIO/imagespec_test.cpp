@@ -328,6 +328,58 @@ test_imagespec_from_xml()
 
 
 
+static void
+test_imagespec_blob_roundtrip()
+{
+    std::cout << "test_imagespec_blob_roundtrip\n";
+    ImageSpec spec(1920, 1080, 4, TypeHalf);
+    spec.x             = 16;
+    spec.y             = -8;
+    spec.full_width    = 2048;
+    spec.full_height   = 1152;
+    spec.tile_width    = 64;
+    spec.tile_height   = 64;
+    spec.tile_depth    = 1;
+    spec.alpha_channel = 3;
+    spec.channelnames  = { "R", "G", "B", "A" };
+    spec.attribute("compression", "zip");
+    spec.attribute("PixelAspectRatio", 1.5f);
+    spec.attribute("oiio:subimages", 3);
+    float chroma[8] = { 0.64f, 0.33f, 0.3f, 0.6f, 0.15f, 0.06f, 0.3127f,
+                        0.329f };
+    spec.attribute("chromaticities", TypeDesc(TypeDesc::FLOAT, 8), chroma);
+
+    std::vector<char> blob = spec.to_blob();
+    ImageSpec spec2;
+    OIIO_CHECK_ASSERT(spec2.from_blob(blob));
+    OIIO_CHECK_EQUAL(spec2.x, spec.x);
+    OIIO_CHECK_EQUAL(spec2.y, spec.y);
+    OIIO_CHECK_EQUAL(spec2.width, spec.width);
+    OIIO_CHECK_EQUAL(spec2.height, spec.height);
+    OIIO_CHECK_EQUAL(spec2.full_width, spec.full_width);
+    OIIO_CHECK_EQUAL(spec2.tile_width, spec.tile_width);
+    OIIO_CHECK_EQUAL(spec2.nchannels, spec.nchannels);
+    OIIO_CHECK_EQUAL(spec2.format, spec.format);
+    OIIO_CHECK_EQUAL(spec2.alpha_channel, spec.alpha_channel);
+    OIIO_CHECK_ASSERT(spec2.channelnames == spec.channelnames);
+    OIIO_CHECK_EQUAL(spec2.extra_attribs.size(), spec.extra_attribs.size());
+    OIIO_CHECK_EQUAL(spec2.get_string_attribute("compression"), "zip");
+    OIIO_CHECK_EQUAL(spec2.get_float_attribute("PixelAspectRatio"), 1.5f);
+    OIIO_CHECK_EQUAL(spec2.get_int_attribute("oiio:subimages"), 3);
+    const ParamValue* c = spec2.extra_attribs.find_pv("chromaticities");
+    OIIO_CHECK_ASSERT(c && c->type() == TypeDesc(TypeDesc::FLOAT, 8)
+                      && !memcmp(c->data(), chroma, sizeof(chroma)));
+
+    // Malformed input must fail without touching the destination spec.
+    ImageSpec spec3;
+    OIIO_CHECK_ASSERT(!spec3.from_blob(cspan<char>(blob.data(), 20)));
+    OIIO_CHECK_EQUAL(spec3.width, 0);
+    blob[0] ^= 1;  // corrupt the magic number
+    OIIO_CHECK_ASSERT(!spec3.from_blob(blob));
+}
+
+
+
 int
 main(int /*argc*/, char* /*argv*/[])
 {
@@ -337,6 +389,7 @@ main(int /*argc*/, char* /*argv*/[])
     test_get_attribute();
     test_imagespec_from_ROI();
     test_imagespec_from_xml();
+    test_imagespec_blob_roundtrip();
 
     return unit_test_failures;
 }
@@ -280,7 +280,11 @@ class kissfft
             cpx_type * twiddles = &_twiddles[0];
             cpx_type t;
             int Norig = _nfft;
-            scratchbuf.resize (p);
+            // Local scratch (rather than a member) so that a single plan
+            // may safely be driven by many threads concurrently. This
+            // butterfly only runs for radices > 5, so the allocation is
+            // not in the common power-of-two/mixed-radix path.
+            std::vector<cpx_type> scratchbuf (p);
 
             for ( u=0; u<m; ++u ) {
                 k=u;
@@ -311,6 +315,5 @@ class kissfft
         std::vector<int> _stageRadix;
         std::vector<int> _stageRemainder;
         traits_type _traits;
-        std::vector<cpx_type> scratchbuf;
 };
 #endif
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <future>
 #include <iostream>
 #include <iterator>
 #include <limits>
@@ -18,6 +19,7 @@
 #include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/filter.h>
 #include <OpenImageIO/fmath.h>
+#include <OpenImageIO/hash.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
@@ -613,7 +615,9 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
              ImageOutput* out, TypeDesc outputdatatype, bool mipmap,
              string_view filtername, const ImageSpec& configspec,
              std::ostream& outstream, double& stat_writetime,
-             double& stat_miptime, size_t& peak_mem)
+             double& stat_miptime, size_t& peak_mem,
+             const std::string& incr_oldfile = std::string(),
+             ROI incr_changedroi = ROI())
 {
     using OIIO::pvt::errorfmt;
     using OIIO::Strutil::sync::print;  // Be sure to use synchronized one
@@ -734,8 +738,48 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
         bool allow_shift
             = configspec.get_int_attribute("maketx:allow_pixel_shift") != 0;
 
+        // Pipelined mip writes: while a background task compresses and
+        // appends level N, the main thread filters level N+1 from the
+        // in-memory copy of level N (both only read those pixels). The
+        // ImageOutput itself still sees strictly serialized open/write
+        // calls. Disabled when highlight compensation is on, because
+        // rangecompress modifies the level being written in place.
+        bool pipelined = configspec.get_int_attribute("maketx:pipeline_mips",
+                                                      1)
+                         && !do_highlight_compensation;
+        std::future<std::string> pending_write;
+        auto wait_pending = [&]() -> bool {
+            if (pending_write.valid()) {
+                std::string e = pending_write.get();
+                if (e.size()) {
+                    errorfmt("{}", e);
+                    out->close();
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (pipelined)
+            // Normally done at the top of each loop iteration, but the
+            // writer task may be reading the buffer by then, so align the
+            // top level's display window to its pixel window now.
+            img->set_full(img->xbegin(), img->xend(), img->ybegin(),
+                          img->yend(), img->zbegin(), img->zend());
+
+        // Incremental rebuild: if the caller identified which region of the
+        // top level actually changed (and supplied the previous texture),
+        // each mip level outside the changed region's (scaled, padded)
+        // footprint is copied from the old file instead of refiltered.
+        bool incremental = !incr_oldfile.empty();
+        // Padding applied per level around the scaled changed region. Must
+        // be at least twice the widest filter radius in dst pixels so that
+        // the dirty footprint propagating down the mip chain stays covered.
+        const int incr_pad = 8;
+
         std::shared_ptr<ImageBuf> small(new ImageBuf);
+        int miplevel = 0;
         while (outspec.width > 1 || outspec.height > 1) {
+            ++miplevel;
             Timer miptimer;
             ImageSpec smallspec;
 
@@ -786,12 +830,50 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
                 smallspec.full_x = 0;
                 smallspec.full_y = 0;
                 small->reset(smallspec);  // Realocate with new size
-                img->set_full(img->xbegin(), img->xend(), img->ybegin(),
-                              img->yend(), img->zbegin(), img->zend());
+                if (!pipelined)
+                    img->set_full(img->xbegin(), img->xend(), img->ybegin(),
+                                  img->yend(), img->zbegin(), img->zend());
+
+                ROI refilter_roi = get_roi(small->spec());
+                if (incremental) {
+                    // Scale the changed region down to this level, pad by
+                    // the filter support, and prefill everything else from
+                    // the same level of the old texture.
+                    int scale = 1 << miplevel;
+                    ROI lroi(0, 0, 0, 0);
+                    if (incr_changedroi.npixels())
+                        lroi = ROI(
+                            std::max(0, incr_changedroi.xbegin / scale
+                                            - incr_pad),
+                            std::min(smallspec.width,
+                                     (incr_changedroi.xend + scale - 1) / scale
+                                         + incr_pad),
+                            std::max(0, incr_changedroi.ybegin / scale
+                                            - incr_pad),
+                            std::min(smallspec.height,
+                                     (incr_changedroi.yend + scale - 1) / scale
+                                         + incr_pad));
+                    bool prefilled = false;
+                    if ((imagesize_t)lroi.npixels()
+                        < smallspec.image_pixels()) {
+                        ImageBuf oldlevel(incr_oldfile, 0, miplevel);
+                        if (oldlevel.read(0, miplevel, true, TypeDesc::FLOAT)
+                            && oldlevel.spec().width == smallspec.width
+                            && oldlevel.spec().height == smallspec.height
+                            && oldlevel.nchannels() == smallspec.nchannels)
+                            prefilled = small->copy_pixels(oldlevel);
+                    }
+                    if (prefilled)
+                        refilter_roi = lroi;
+                    else
+                        incremental = false;  // be safe: full refilter
+                }
 
-                if (filtername == "box" && !orig_was_overscan
+                if (!refilter_roi.npixels()) {
+                    // Nothing to refilter at this level (all from old file)
+                } else if (filtername == "box" && !orig_was_overscan
                     && sharpen <= 0.0f) {
-                    ImageBufAlgo::parallel_image(get_roi(small->spec()),
+                    ImageBufAlgo::parallel_image(refilter_roi,
                                                  std::bind(resize_block,
                                                            std::ref(*small),
                                                            std::cref(*img), _1,
@@ -827,7 +909,7 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
                             errorfmt("{}", sharp->geterror());
                         std::swap(img, sharp);
                     }
-                    ImageBufAlgo::resize(*small, *img, filter);
+                    ImageBufAlgo::resize(*small, *img, filter, refilter_roi);
                     if (sharpen > 0.0f && !sharpen_first) {
                         std::shared_ptr<ImageBuf> sharp(new ImageBuf);
                         bool uok = ImageBufAlgo::unsharp_mask(*sharp, *small,
@@ -859,21 +941,52 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
             Timer writetimer;
             // If the format explicitly supports MIP-maps, use that,
             // otherwise try to simulate MIP-mapping with multi-image.
-            ImageOutput::OpenMode mode = out->supports("mipmap")
-                                             ? ImageOutput::AppendMIPLevel
-                                             : ImageOutput::AppendSubimage;
-            if (!out->open(outputfilename.c_str(), outspec, mode)) {
-                errorfmt("Could not append \"{}\" : {}", outputfilename,
-                         out->geterror());
-                return false;
-            }
-            if (!small->write(out)) {
-                // ImageBuf::write transfers any errors from the
-                // ImageOutput to the ImageBuf.
-                errorfmt("Error writing \"{}\" : {}", outputfilename,
-                         small->geterror());
-                out->close();
-                return false;
+            ImageOutput::OpenMode openmode = out->supports("mipmap")
+                                                 ? ImageOutput::AppendMIPLevel
+                                                 : ImageOutput::AppendSubimage;
+            if (pipelined) {
+                // Wait until the previous level is fully appended (the
+                // ImageOutput handles one level at a time), then hand this
+                // one to the writer task and go filter the next level
+                // while it is being compressed and written.
+                if (!wait_pending())
+                    return false;
+                // Keep this level's display window aligned to its pixel
+                // window before the writer can see it (see above).
+                small->set_full(small->xbegin(), small->xend(),
+                                small->ybegin(), small->yend(),
+                                small->zbegin(), small->zend());
+                std::shared_ptr<ImageBuf> towrite = small;
+                ImageSpec levelspec               = outspec;
+                pending_write                     = std::async(
+                    std::launch::async,
+                    [out, towrite, levelspec, openmode,
+                     outputfilename]() -> std::string {
+                        if (!out->open(outputfilename.c_str(), levelspec,
+                                       openmode))
+                            return Strutil::fmt::format(
+                                "Could not append \"{}\" : {}",
+                                outputfilename, out->geterror());
+                        if (!towrite->write(out))
+                            return Strutil::fmt::format(
+                                "Error writing \"{}\" : {}", outputfilename,
+                                towrite->geterror());
+                        return std::string();
+                    });
+            } else {
+                if (!out->open(outputfilename.c_str(), outspec, openmode)) {
+                    errorfmt("Could not append \"{}\" : {}", outputfilename,
+                             out->geterror());
+                    return false;
+                }
+                if (!small->write(out)) {
+                    // ImageBuf::write transfers any errors from the
+                    // ImageOutput to the ImageBuf.
+                    errorfmt("Error writing \"{}\" : {}", outputfilename,
+                             small->geterror());
+                    out->close();
+                    return false;
+                }
             }
             double wtime = writetimer();
             stat_writetime += wtime;
@@ -887,6 +1000,9 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
             }
             std::swap(img, small);
         }
+        // Drain the last in-flight level before closing the file.
+        if (!wait_pending())
+            return false;
     }
 
     if (verbose)
@@ -972,6 +1088,81 @@ stripdir_cmd_line(string_view cmdline)
 
 
 
+// Write a sidecar index file, "<texfile>.txidx", recording the native
+// ImageSpec of every subimage and MIP level of the just-written texture, so
+// that ImageCacheFile::open can learn the full layout of the file with one
+// small read instead of seeking through every level's header (for TIFF,
+// walking the whole IFD chain). Layout, all fields native endianness:
+//
+//     char     magic[8]      "OIIOtxi1"
+//     uint64   size of the texture file in bytes
+//     int64    modification time of the texture file
+//     uint32   number of subimages
+//     for each subimage:
+//         uint32  number of MIP levels
+//         for each level:  uint32 length, then ImageSpec::to_xml() bytes
+//     uint64   xxhash of everything between the magic and the hash
+//
+// The reader (read_sidecar_index in imagecache.cpp) validates the magic,
+// the size/time stamps, and the hash, and silently falls back to the
+// normal level discovery on any mismatch, so a stale or damaged index is
+// merely useless, never harmful.
+static bool
+write_sidecar_index(const std::string& texfilename, std::ostream& outstream,
+                    bool verbose)
+{
+    auto in = ImageInput::open(texfilename);
+    if (!in)
+        return false;
+    std::string payload;
+    auto append = [&](const void* data, size_t size) {
+        payload.append((const char*)data, size);
+    };
+    uint64_t fsize = Filesystem::file_size(texfilename);
+    int64_t ftime  = int64_t(Filesystem::last_write_time(texfilename));
+    append(&fsize, sizeof(fsize));
+    append(&ftime, sizeof(ftime));
+    std::vector<std::vector<std::string>> xmlspecs;
+    ImageSpec spec;
+    for (int s = 0; in->seek_subimage(s, 0, spec); ++s) {
+        xmlspecs.resize(s + 1);
+        for (int m = 0; in->seek_subimage(s, m, spec); ++m) {
+            if (spec.channelformats.size())
+                return false;  // per-channel formats don't round-trip
+            xmlspecs[s].push_back(spec.to_xml());
+        }
+    }
+    uint32_t nsub = uint32_t(xmlspecs.size());
+    append(&nsub, sizeof(nsub));
+    for (auto& sub : xmlspecs) {
+        uint32_t nmip = uint32_t(sub.size());
+        append(&nmip, sizeof(nmip));
+        for (auto& xml : sub) {
+            uint32_t len = uint32_t(xml.size());
+            append(&len, sizeof(len));
+            payload += xml;
+        }
+    }
+    uint64_t hash = uint64_t(
+        xxhash::xxhash((const void*)payload.data(), payload.size()));
+    static const char magic[8] = { 'O', 'I', 'I', 'O', 't', 'x', 'i', '1' };
+    std::string idxname        = texfilename + ".txidx";
+    FILE* f                    = Filesystem::fopen(idxname, "wb");
+    if (!f)
+        return false;
+    bool ok = fwrite(magic, 1, sizeof(magic), f) == sizeof(magic)
+              && fwrite(payload.data(), 1, payload.size(), f) == payload.size()
+              && fwrite(&hash, 1, sizeof(hash), f) == sizeof(hash);
+    fclose(f);
+    if (!ok)
+        Filesystem::remove(idxname);
+    else if (verbose)
+        outstream << "  Wrote sidecar index: " << idxname << "\n";
+    return ok;
+}
+
+
+
 static bool
 make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
                   std::string filename, std::string outputfilename,
@@ -1279,6 +1470,67 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
         mode = ImageBufAlgo::MakeTxTexture;
     }
 
+    if (envlatlmode && configspec.get_int_attribute("maketx:envcdf")) {
+        // Bake marginal/conditional CDF tables for importance sampling the
+        // environment light into the file's metadata, so renderers can
+        // light-sample the map (via TextureSystem::environment_sample)
+        // without each process reading the whole map back at startup.
+        // The tables are built over a reduced-resolution luminance image
+        // (the sampling distribution gains nothing from full res), with
+        // each row weighted by sin(theta) for lat-long solid angle.
+        int res = configspec.get_int_attribute("maketx:envcdfres", 512);
+        res     = clamp(res, 4, 4096);
+        const int ncols = std::min(src->spec().width, res);
+        const int nrows = std::min(src->spec().height, res);
+        ImageBuf lum    = ImageBufAlgo::resize(*src, "box", 0.0f,
+                                               ROI(0, ncols, 0, nrows));
+        const int nc    = lum.nchannels();
+        std::vector<float> cond((size_t)nrows * ncols);
+        std::vector<float> marg(nrows);
+        for (int r = 0; r < nrows; ++r) {
+            float sintheta = sinf((r + 0.5f) * float(M_PI) / nrows);
+            float* row     = &cond[(size_t)r * ncols];
+            float rowsum   = 0.0f;
+            for (int c = 0; c < ncols; ++c) {
+                float pel[4] = { 0, 0, 0, 0 };
+                lum.getpixel(c, r, pel, std::min(nc, 4));
+                float l = nc >= 3 ? 0.2126f * pel[0] + 0.7152f * pel[1]
+                                        + 0.0722f * pel[2]
+                                  : pel[0];
+                rowsum += std::max(l, 0.0f) * sintheta;
+                row[c] = rowsum;
+            }
+            if (rowsum > 0.0f) {
+                float scale = 1.0f / rowsum;
+                for (int c = 0; c < ncols; ++c)
+                    row[c] *= scale;
+            } else {
+                for (int c = 0; c < ncols; ++c)
+                    row[c] = float(c + 1) / ncols;
+            }
+            marg[r] = rowsum;
+        }
+        float total = 0.0f;
+        for (int r = 0; r < nrows; ++r) {
+            total += marg[r];
+            marg[r] = total;
+        }
+        if (total > 0.0f) {
+            for (int r = 0; r < nrows; ++r)
+                marg[r] /= total;
+        } else {
+            for (int r = 0; r < nrows; ++r)
+                marg[r] = float(r + 1) / nrows;
+        }
+        configspec.attribute("envcdf:cols", ncols);
+        configspec.attribute("envcdf:rows", nrows);
+        configspec.attribute("envcdf:marginal",
+                             TypeDesc(TypeDesc::FLOAT, nrows), marg.data());
+        configspec.attribute("envcdf:conditional",
+                             TypeDesc(TypeDesc::FLOAT, nrows * ncols),
+                             cond.data());
+    }
+
     double misc_time_2 = alltime.lap();
     STATUS("misc2", misc_time_2);
 
@@ -1781,6 +2033,7 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
     dstspec.erase_attribute("AverageColor=");
     dstspec.erase_attribute("oiio:SHA-1=");
     dstspec.erase_attribute("SHA-1=");
+    dstspec.erase_attribute("oiio:RegionSHA-1=");
     if (desc.size()) {
         Strutil::excise_string_after_head(desc, "oiio:ConstantColor=");
         Strutil::excise_string_after_head(desc, "ConstantColor=");
@@ -1830,6 +2083,79 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
     double stat_hashtime = alltime.lap();
     STATUS("SHA-1 hash", stat_hashtime);
 
+    // Incremental rebuild: when requested, and the previous output file is
+    // still in place and was stamped with a per-region hash grid
+    // ("oiio:RegionSHA-1"), figure out which regions of the new top level
+    // actually differ from the previous build.  write_mipmap then copies
+    // everything outside the changed regions' mip footprint from the old
+    // file instead of refiltering it.  (The old file is safe to read here
+    // because we write to tmpfilename and only rename at the very end.)
+    std::string incr_oldfile;
+    ROI incr_changedroi;
+    if (configspec.get_int_attribute("maketx:incremental")
+        && hash_digest.length() && out->supports("arbitrary_metadata")
+        && !envlatlmode && sharpen == 0.0f
+        && !configspec.get_int_attribute("maketx:highlightcomp", 0)
+        && configspec.get_string_attribute("maketx:mipimages").empty()) {
+        const int region_size = 4 * sha1_blocksize;
+        int nrx = (dstspec.width + region_size - 1) / region_size;
+        int nry = (dstspec.height + region_size - 1) / region_size;
+        std::vector<std::string> regionhashes;
+        regionhashes.reserve(size_t(nrx) * size_t(nry));
+        for (int ry = 0; ry < nry; ++ry)
+            for (int rx = 0; rx < nrx; ++rx) {
+                ROI roi(rx * region_size,
+                        std::min((rx + 1) * region_size, dstspec.width),
+                        ry * region_size,
+                        std::min((ry + 1) * region_size, dstspec.height));
+                regionhashes.push_back(ImageBufAlgo::computePixelHashSHA1(
+                    *toplevel, addlHashData.str(), roi, sha1_blocksize));
+            }
+        if (Filesystem::exists(outputfilename)) {
+            ImageBuf old(outputfilename);
+            const ImageSpec& oldspec(old.spec());
+            std::vector<std::string> oldhashes;
+            Strutil::split(oldspec.get_string_attribute("oiio:RegionSHA-1"),
+                           oldhashes, ";");
+            // The old texture is only reusable if it matches the new one
+            // in shape, tiling, and data format, and carries a region hash
+            // grid of the same layout.  Config changes (filter, sharpen,
+            // etc.) force a full rebuild via the extra hash data.
+            if (!old.has_error() && oldspec.width == dstspec.width
+                && oldspec.height == dstspec.height
+                && oldspec.nchannels == dstspec.nchannels
+                && oldspec.tile_width == dstspec.tile_width
+                && oldspec.tile_height == dstspec.tile_height
+                && oldspec.format == out_dataformat
+                && oldhashes.size() == regionhashes.size()) {
+                int nchanged = 0;
+                for (int ry = 0; ry < nry; ++ry)
+                    for (int rx = 0; rx < nrx; ++rx) {
+                        if (oldhashes[ry * nrx + rx]
+                            == regionhashes[ry * nrx + rx])
+                            continue;
+                        ROI roi(rx * region_size,
+                                std::min((rx + 1) * region_size,
+                                         dstspec.width),
+                                ry * region_size,
+                                std::min((ry + 1) * region_size,
+                                         dstspec.height));
+                        incr_changedroi = nchanged
+                                              ? roi_union(incr_changedroi, roi)
+                                              : roi;
+                        ++nchanged;
+                    }
+                incr_oldfile = outputfilename;
+                if (verbose)
+                    print(outstream,
+                          "  Incremental: {} of {} regions changed\n",
+                          nchanged, nrx * nry);
+            }
+        }
+        dstspec.attribute("oiio:RegionSHA-1",
+                          Strutil::join(regionhashes, ";"));
+    }
+
     if (isConstantColor) {
         std::string colstr = Strutil::join(constantColor, ",",
                                            dstspec.nchannels);
@@ -1892,7 +2218,7 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
     bool ok = write_mipmap(mode, toplevel, dstspec, tmpfilename, out.get(),
                            out_dataformat, !shadowmode && !nomipmap, filtername,
                            configspec, outstream, stat_writetime, stat_miptime,
-                           peak_mem);
+                           peak_mem, incr_oldfile, incr_changedroi);
     out.reset();  // don't need it any more
 
     // If using update mode, stamp the output file with a modification time
@@ -1911,6 +2237,15 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
     if (!ok)
         Filesystem::remove(tmpfilename);
 
+    // If requested, write a sidecar index of the finished texture's levels
+    // to speed up later opens. Do this after the rename and the update-mode
+    // time stamping, so the index records the final size and time.
+    if (ok && configspec.get_int_attribute("maketx:sidecar")) {
+        if (!write_sidecar_index(outputfilename, outstream, verbose))
+            outstream << "maketx: could not write sidecar index for \""
+                      << outputfilename << "\"\n";
+    }
+
     if (verbose || configspec.get_int_attribute("maketx:runstats")
         || configspec.get_int_attribute("maketx:stats")) {
         double all = alltime();
@@ -17,6 +17,8 @@ extern "C" {
 #include "tiff.h"
 }
 
+#include "imageio_pvt.h"
+
 #if USE_EXTERNAL_PUGIXML
 #    include <pugixml.hpp>
 #else
@@ -541,16 +543,16 @@ decode_xmp(cspan<uint8_t> xml, ImageSpec& spec)
 
 
 
-bool
-decode_xmp(string_view xml, ImageSpec& spec)
+// The working half of decode_xmp: parse the packet with pugixml and
+// convert every recognized property into a spec attribute.
+static bool
+decode_xmp_eager(string_view xml, ImageSpec& spec)
 {
 #if DEBUG_XMP_READ
     Timer timer;
     std::cerr << "XMP size is " << xml.size() << "\n";
     std::cerr << "XMP dump:\n---\n" << xml.substr(0, 4096) << "\n---\n";
 #endif
-    if (!xml.length())
-        return true;
     for (size_t startpos = 0, endpos = 0;
          extract_middle(xml, endpos, "<rdf:Description", "</rdf:Description>",
                         startpos, endpos);) {
@@ -589,6 +591,79 @@ decode_xmp(string_view xml, ImageSpec& spec)
 
 
 
+bool
+decode_xmp(string_view xml, ImageSpec& spec)
+{
+    if (!xml.length())
+        return true;
+
+    if (pvt::oiio_lazy_xmp) {
+        // Lazy mode ("xmp:lazy" global attribute): skip the DOM parse and
+        // per-property conversion entirely; stash the raw packet in the
+        // spec for materialize_xmp() (or extract_xmp_property()) to
+        // consult if the metadata is ever actually wanted.
+        spec.attribute("oiio:RawXMP", xml);
+        return true;
+    }
+
+    return decode_xmp_eager(xml, spec);
+}
+
+
+
+bool
+materialize_xmp(ImageSpec& spec)
+{
+    ParamValue* p = spec.find_attribute("oiio:RawXMP", TypeString);
+    if (!p)
+        return false;
+    // Copy the packet aside before erasing its stash, since decoding will
+    // add attributes to the spec.
+    std::string xml = p->get_string();
+    spec.erase_attribute("oiio:RawXMP");
+    return decode_xmp_eager(xml, spec);
+}
+
+
+
+std::string
+extract_xmp_property(string_view xml, string_view property)
+{
+    // XMP properties may appear in attribute form (prop="value" on an
+    // rdf:Description element) or element form (<prop>value</prop>).
+    // Simple string scans find either without building a DOM.
+    std::string attrpat = Strutil::fmt::format("{}=\"", property);
+    size_t pos          = xml.find(attrpat);
+    if (pos != string_view::npos
+        && (pos == 0 || xml[pos - 1] == ' ' || xml[pos - 1] == '\t'
+            || xml[pos - 1] == '\n')) {
+        size_t vstart = pos + attrpat.size();
+        size_t vend   = xml.find('"', vstart);
+        if (vend != string_view::npos)
+            return std::string(xml.substr(vstart, vend - vstart));
+    }
+    std::string open  = Strutil::fmt::format("<{}", property);
+    std::string close = Strutil::fmt::format("</{}>", property);
+    for (pos = xml.find(open); pos != string_view::npos;
+         pos = xml.find(open, pos + 1)) {
+        // Make sure we matched the whole element name, not a prefix.
+        char next = pos + open.size() < xml.size() ? xml[pos + open.size()]
+                                                   : '\0';
+        if (next != '>' && next != ' ' && next != '\t' && next != '\n')
+            continue;
+        size_t tagend = xml.find('>', pos);
+        if (tagend == string_view::npos || xml[tagend - 1] == '/')
+            continue;  // malformed or self-closing (empty) element
+        size_t vstart = tagend + 1;
+        size_t vend   = xml.find(close, vstart);
+        if (vend != string_view::npos)
+            return std::string(xml.substr(vstart, vend - vstart));
+    }
+    return std::string();
+}
+
+
+
 // Turn one ParamValue (whose xmp info we know) into a properly
 // serialized xmp string.
 static std::string
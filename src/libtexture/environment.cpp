@@ -3,6 +3,7 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 
+#include <algorithm>
 #include <cmath>
 #include <list>
 #include <sstream>
@@ -657,6 +658,71 @@ TextureSystemImpl::environment(ustring filename, TextureOptBatch& options,
 }
 
 
+bool
+TextureSystemImpl::environment_sample(ustring filename, Perthread* thread_info,
+                                      const float* rnd, float* uv, float* pdf)
+{
+    PerThreadInfo* ti = m_imagecache->get_perthread_info(
+        (PerThreadInfo*)thread_info);
+    TextureHandle* texture_handle = get_texture_handle(filename,
+                                                       (Perthread*)ti);
+    return environment_sample(texture_handle, (Perthread*)ti, rnd, uv, pdf);
+}
+
+
+
+bool
+TextureSystemImpl::environment_sample(TextureHandle* texture_handle,
+                                      Perthread* thread_info, const float* rnd,
+                                      float* uv, float* pdf)
+{
+    PerThreadInfo* ti = m_imagecache->get_perthread_info(
+        (PerThreadInfo*)thread_info);
+    TextureFile* texturefile = verify_texturefile((TextureFile*)texture_handle,
+                                                  ti);
+    if (!texturefile || texturefile->broken())
+        return false;
+
+    // The CDF tables baked by maketx ("maketx:envcdf") live in the file's
+    // metadata, which the cache already holds; no pixel I/O happens here.
+    const ImageSpec& spec(texturefile->spec(0, 0));
+    const ParamValue* margp = spec.find_attribute("envcdf:marginal",
+                                                  TypeDesc::UNKNOWN, false);
+    const ParamValue* condp = spec.find_attribute("envcdf:conditional",
+                                                  TypeDesc::UNKNOWN, false);
+    int nrows = spec.get_int_attribute("envcdf:rows");
+    int ncols = spec.get_int_attribute("envcdf:cols");
+    if (!margp || !condp || nrows <= 0 || ncols <= 0
+        || margp->type() != TypeDesc(TypeDesc::FLOAT, nrows)
+        || condp->type() != TypeDesc(TypeDesc::FLOAT, nrows * ncols))
+        return false;
+    const float* marg = (const float*)margp->data();
+    const float* cond = (const float*)condp->data();
+
+    // Pick the row from the marginal CDF, then the column from that row's
+    // conditional CDF, interpolating within the chosen bin.
+    int r = int(std::upper_bound(marg, marg + nrows, rnd[1]) - marg);
+    r     = std::min(r, nrows - 1);
+    float mlo   = r > 0 ? marg[r - 1] : 0.0f;
+    float mbin  = marg[r] - mlo;
+    float rfrac = mbin > 0.0f ? (rnd[1] - mlo) / mbin : 0.5f;
+
+    const float* row = cond + (size_t)r * ncols;
+    int c            = int(std::upper_bound(row, row + ncols, rnd[0]) - row);
+    c                = std::min(c, ncols - 1);
+    float clo   = c > 0 ? row[c - 1] : 0.0f;
+    float cbin  = row[c] - clo;
+    float cfrac = cbin > 0.0f ? (rnd[0] - clo) / cbin : 0.5f;
+
+    uv[0] = (c + cfrac) / ncols;
+    uv[1] = (r + rfrac) / nrows;
+    // Density with respect to uniform (s,t) area.
+    *pdf = (mbin * nrows) * (cbin * ncols);
+    return true;
+}
+
+
+
 }  // end namespace pvt
 
 OIIO_NAMESPACE_END
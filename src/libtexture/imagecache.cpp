@@ -16,11 +16,13 @@
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/fmath.h>
+#include <OpenImageIO/hash.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagecache.h>
 #include <OpenImageIO/imageio.h>
 #include <OpenImageIO/optparser.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/simd.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
@@ -31,6 +33,15 @@
 #include <OpenImageIO/ustring.h>
 #include <OpenImageIO/varyingref.h>
 
+#include <zlib.h>
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 #include "imagecache_pvt.h"
 #include "imageio_pvt.h"
 
@@ -43,7 +54,11 @@ namespace pvt {
 // The static perthread mutex needs to outlive the shared_image_cache
 // instance, so must be declared first in this file to avoid static
 // initialization order problems.
-spin_mutex ImageCacheImpl::m_perthread_info_mutex;
+adaptive_mutex ImageCacheImpl::m_perthread_info_mutex;
+
+// Global (cross-cache) tally of tile pixel memory, for the
+// getattribute("memory:imagecache_tiles") telemetry.
+atomic_ll IC_tile_mem_current(0);
 
 }  // namespace pvt
 
@@ -219,9 +234,13 @@ ImageCacheStatistics::merge(const ImageCacheStatistics& s)
 
 ImageCacheFile::LevelInfo::LevelInfo(const ImageSpec& spec_,
                                      const ImageSpec& nativespec_)
-    : spec(spec_)
-    , nativespec(nativespec_)
+    : m_spec(std::make_shared<ImageSpec>(spec_))
 {
+    // Share one payload when the caller passed the same spec for both.
+    m_nativespec = (&nativespec_ == &spec_)
+                       ? m_spec
+                       : std::make_shared<ImageSpec>(nativespec_);
+    const ImageSpec& spec(*m_spec);
     full_pixel_range
         = (spec.x == spec.full_x && spec.y == spec.full_y
            && spec.z == spec.full_z && spec.width == spec.full_width
@@ -251,8 +270,8 @@ ImageCacheFile::LevelInfo::LevelInfo(const ImageSpec& spec_,
 
 
 ImageCacheFile::LevelInfo::LevelInfo(const LevelInfo& src)
-    : spec(src.spec)
-    , nativespec(src.nativespec)
+    : m_spec(src.m_spec)
+    , m_nativespec(src.m_nativespec)
     , full_pixel_range(src.full_pixel_range)
     , onetile(src.onetile)
     , polecolorcomputed(src.polecolorcomputed)
@@ -318,7 +337,11 @@ ImageCacheFile::ImageCacheFile(ImageCacheImpl& imagecache,
 
 
 
-ImageCacheFile::~ImageCacheFile() { close(); }
+ImageCacheFile::~ImageCacheFile()
+{
+    close();
+    close_mmap();
+}
 
 
 
@@ -375,7 +398,8 @@ ImageCacheFile::set_imageinput(std::shared_ptr<ImageInput> newval)
 
 void
 ImageCacheFile::SubimageInfo::init(ImageCacheFile& icfile,
-                                   const ImageSpec& spec, bool forcefloat)
+                                   const ImageSpec& spec, bool forcefloat,
+                                   bool storehalf)
 {
     volume = (spec.depth > 1 || spec.full_depth > 1);
     full_pixel_range
@@ -401,6 +425,13 @@ ImageCacheFile::SubimageInfo::init(ImageCacheFile& icfile,
             /* future expansion:  || spec.format == AnotherFormat ... */)
             datatype = spec.format;
     }
+    if (storehalf && !forcefloat && datatype == TypeDesc::FLOAT) {
+        // "storehalf" mode: tiles that would be cached as float are
+        // demoted to half, halving their cache footprint.  The filtering
+        // kernels read half texels directly, so the only cost is the
+        // on-sample conversion (a native instruction on most hardware).
+        datatype = TypeDesc::HALF;
+    }
     channelsize = datatype.size();
     pixelsize   = channelsize * spec.nchannels;
 
@@ -452,6 +483,81 @@ ImageCacheFile::SubimageInfo::init(ImageCacheFile& icfile,
 
 
 
+// Read and validate the sidecar index file, "<filename>.txidx", optionally
+// written by maketx ("maketx:sidecar"), which records the native ImageSpec
+// of every subimage and MIP level. See write_sidecar_index in
+// maketexture.cpp for the exact layout. On success, fill `specs` (indexed
+// [subimage][miplevel]) and return true. Return false if there is no
+// sidecar, or if it fails validation against the magic, the recorded
+// size/time of the texture file, or the trailing hash -- in which case the
+// caller discovers the levels the usual way, by seeking through each one.
+static bool
+read_sidecar_index(const std::string& filename,
+                   std::vector<std::vector<ImageSpec>>& specs)
+{
+    std::string idxname = filename + ".txidx";
+    uint64_t idxsize    = Filesystem::file_size(idxname);
+    const size_t minsize = 8 /*magic*/ + 8 + 8 + 4 + 8 /*hash*/;
+    if (idxsize < minsize || idxsize > uint64_t(1) << 30)
+        return false;
+    std::unique_ptr<char[]> buf(new char[idxsize]);
+    if (Filesystem::read_bytes(idxname, buf.get(), idxsize) != idxsize)
+        return false;
+    static const char magic[8] = { 'O', 'I', 'I', 'O', 't', 'x', 'i', '1' };
+    if (memcmp(buf.get(), magic, sizeof(magic)))
+        return false;
+    uint64_t hash;
+    memcpy(&hash, buf.get() + idxsize - sizeof(hash), sizeof(hash));
+    if (hash
+        != uint64_t(xxhash::xxhash((const void*)(buf.get() + sizeof(magic)),
+                                   idxsize - sizeof(magic) - sizeof(hash))))
+        return false;
+    const char* p   = buf.get() + sizeof(magic);
+    const char* end = buf.get() + idxsize - sizeof(hash);
+    auto get        = [&](void* data, size_t n) {
+        if (size_t(end - p) < n)
+            return false;
+        memcpy(data, p, n);
+        p += n;
+        return true;
+    };
+    uint64_t fsize;
+    int64_t ftime;
+    uint32_t nsub;
+    if (!get(&fsize, sizeof(fsize)) || !get(&ftime, sizeof(ftime))
+        || !get(&nsub, sizeof(nsub)))
+        return false;
+    // The index is only trustworthy if the texture file is still the one
+    // it was computed from.
+    if (fsize != Filesystem::file_size(filename)
+        || ftime != int64_t(Filesystem::last_write_time(filename)))
+        return false;
+    if (nsub < 1 || nsub > 65535)
+        return false;
+    specs.resize(nsub);
+    for (uint32_t s = 0; s < nsub; ++s) {
+        uint32_t nmip;
+        if (!get(&nmip, sizeof(nmip)) || nmip < 1 || nmip > 64) {
+            specs.clear();
+            return false;
+        }
+        for (uint32_t m = 0; m < nmip; ++m) {
+            uint32_t len;
+            if (!get(&len, sizeof(len)) || size_t(end - p) < len) {
+                specs.clear();
+                return false;
+            }
+            std::string xml(p, len);
+            p += len;
+            specs[s].emplace_back();
+            specs[s].back().from_xml(xml.c_str());
+        }
+    }
+    return true;
+}
+
+
+
 std::shared_ptr<ImageInput>
 ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
 {
@@ -464,6 +570,9 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
     if (inp)
         return inp;
 
+    static const ustring zone_name("IC::open_file");
+    ProfilerZone zone(zone_name);
+
     // The file wasn't already opened and in a good state.
 
     // Enforce limits on maximum number of open files.
@@ -493,6 +602,16 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
     if (imagecache().unassociatedalpha())
         configspec.attribute("oiio:UnassociatedAlpha", 1);
 
+    // In mmap mode, map the raw file and hand the plugin an IOMemReader
+    // over the mapping, turning its reads into page-cache faults.
+    bool using_mmap = false;
+    if (imagecache().mmap_files() && !m_inputcreator && !m_configspec
+        && open_mmap()) {
+        Filesystem::IOProxy* proxy = m_mmap_reader.get();
+        configspec.attribute("oiio:ioproxy", TypeDesc::PTR, &proxy);
+        using_mmap = true;
+    }
+
     if (m_inputcreator)
         inp.reset(m_inputcreator());
     else {
@@ -507,6 +626,16 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
             fmt = m_filename.string();
         inp = ImageInput::create(fmt, false, &configspec,
                                  m_imagecache.plugin_searchpath());
+        if (!inp && using_mmap) {
+            // The format may not support IOProxy reads. Drop the mapping
+            // and let the plugin do its own I/O.
+            (void)OIIO::geterror();
+            close_mmap();
+            configspec.erase_attribute("oiio:ioproxy");
+            using_mmap = false;
+            inp = ImageInput::create(fmt, false, &configspec,
+                                     m_imagecache.plugin_searchpath());
+        }
     }
     if (!inp) {
         mark_broken(OIIO::geterror());
@@ -531,8 +660,28 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
             Sysutil::usleep(1000 * 100);  // 100 ms
         }
     }
+    if (!ok && using_mmap) {
+        // The open failed through the mapping; retry with ordinary I/O
+        // before declaring the file broken.
+        (void)inp->geterror();
+        close_mmap();
+        configspec.erase_attribute("oiio:ioproxy");
+        using_mmap = false;
+        inp = ImageInput::create(m_filename.string(), false, &configspec,
+                                 m_imagecache.plugin_searchpath());
+        ok  = inp && inp->open(m_filename.c_str(), nativespec, configspec);
+        if (ok) {
+            tempspec = nativespec;
+            (void)inp->geterror();  // Eat the errors
+        }
+    }
     if (!ok) {
-        mark_broken(inp->geterror());
+        if (m_timesopened)
+            // A file that opened fine before won't open now: a good sign
+            // that the process is short of file descriptors. Let the
+            // adaptive limit tuner know.
+            imagecache().note_open_failure();
+        mark_broken(inp ? inp->geterror() : OIIO::geterror());
         inp.reset();
         return {};
     }
@@ -553,6 +702,24 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
     m_subimages.clear();
     int nsubimages = 0;
 
+    // If a sidecar index written by maketx accompanies the file, it tells
+    // us the native spec of every subimage and MIP level up front, and we
+    // can skip seeking through each level's header (for TIFF, a walk of
+    // the whole IFD chain) just to learn the file's layout.
+    std::vector<std::vector<ImageSpec>> sidecar;
+    if (imagecache().use_sidecar() && !m_inputcreator)
+        read_sidecar_index(m_filename.string(), sidecar);
+    auto next_level = [&](int subimage, int miplevel) {
+        if (sidecar.size()) {
+            if (subimage >= (int)sidecar.size()
+                || miplevel >= (int)sidecar[subimage].size())
+                return false;
+            nativespec = sidecar[subimage][miplevel];
+            return true;
+        }
+        return inp->seek_subimage(subimage, miplevel, nativespec);
+    };
+
     // Since each subimage can potentially have its own mipmap levels,
     // keep track of the highest level discovered
     imagesize_t old_total_imagesize        = m_total_imagesize;
@@ -567,7 +734,8 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
             tempspec = nativespec;
             if (nmip == 0) {
                 // Things to do on MIP level 0, i.e. once per subimage
-                si.init(*this, tempspec, imagecache().forcefloat());
+                si.init(*this, tempspec, imagecache().forcefloat(),
+                        imagecache().storehalf());
             }
             if (tempspec.tile_width == 0 || tempspec.tile_height == 0) {
                 si.untiled   = true;
@@ -598,6 +766,31 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
                     tempspec.tile_height = tempspec.height;
                     tempspec.tile_depth  = tempspec.depth;
                 }
+            } else if (tempspec.depth > 1 && imagecache().volume_bricksize()) {
+                // Volume files often report tiny native tiles (e.g. the 8^3
+                // leaf nodes of OpenVDB), and caching at that granule means
+                // a marching ray touches a new cache tile every few samples
+                // and per-tile overhead dominates. Re-brick the cache's
+                // view into larger tiles whose dimensions are multiples of
+                // the native tile size, so each cache tile spans many
+                // leaves while reads stay aligned to native tile
+                // boundaries.
+                int brick = imagecache().volume_bricksize();
+                if (tempspec.tile_width < brick)
+                    tempspec.tile_width
+                        = std::min(tempspec.width,
+                                   round_to_multiple(brick,
+                                                     tempspec.tile_width));
+                if (tempspec.tile_height < brick)
+                    tempspec.tile_height
+                        = std::min(tempspec.height,
+                                   round_to_multiple(brick,
+                                                     tempspec.tile_height));
+                if (tempspec.tile_depth < brick)
+                    tempspec.tile_depth
+                        = std::min(tempspec.depth,
+                                   round_to_multiple(brick,
+                                                     tempspec.tile_depth));
             }
             // If a request was made for a maximum MIP resolution to use for
             // texture lookups and this level is too big, bump up this
@@ -623,7 +816,7 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
             LevelInfo levelinfo(tempspec, nativespec);
             si.levels.push_back(levelinfo);
             ++nmip;
-        } while (inp->seek_subimage(nsubimages, nmip, nativespec));
+        } while (next_level(nsubimages, nmip));
 
         // Special work for non-MIPmapped images -- but only if "automip"
         // is on, it's a non-mipmapped image, and it doesn't have a
@@ -691,7 +884,7 @@ ImageCacheFile::open(ImageCachePerThreadInfo* thread_info)
             si.minwh[m] = std::min(si.spec(m).width, si.spec(m).height);
         si.minwh[nmip] = 0;  // One past the end, set to 0
         ++nsubimages;
-    } while (inp->seek_subimage(nsubimages, 0, nativespec));
+    } while (next_level(nsubimages, 0));
     OIIO_DASSERT((size_t)nsubimages == m_subimages.size());
 
     m_total_imagesize_ondisk = imagesize_t(Filesystem::file_size(m_filename));
@@ -804,6 +997,8 @@ ImageCacheFile::read_tile(ImageCachePerThreadInfo* thread_info,
                           const TileID& id, void* data)
 {
     OIIO_DASSERT(id.chend() > id.chbegin());
+    static const ustring zone_name("IC::read_tile");
+    ProfilerZone zone(zone_name);
 
     // Mark if we ever use a mip level that's not the first
     int miplevel = id.miplevel();
@@ -1053,27 +1248,49 @@ ImageCacheFile::read_untiled(ImageCachePerThreadInfo* thread_info,
         // asked for -- save it in 'data' rather than adding a tile.
         int xx = x - spec.x;      // counting from left row
         int x0 = xx - (xx % tw);  // start of the tile we are retrieving
+        // First figure out which tiles of the row need to be repacked at
+        // all: everything not already in the cache. (The one we were
+        // asked for goes straight to 'data' instead.)
+        std::vector<int> needed;  // x offsets (from left) needing repack
         for (int i = 0; i < spec.width; i += tw) {
-            if (i == xx) {
-                // This is the tile we've been asked for
-                convert_image(nchans, tw, th, 1, &buf[x0 * pixelsize], format,
-                              pixelsize, scanlinesize, scanlinesize * th, data,
-                              format, xstride, ystride, zstride);
-            } else {
-                // Not the tile we asked for, but it's in the same
-                // tile-row, so let's put it in the cache anyway so
-                // it'll be there when asked for.
-                TileID id(*this, subimage, miplevel, i + spec.x, y0, z, chbegin,
-                          chend, colortransformid);
-                if (!imagecache().tile_in_cache(id, thread_info)) {
-                    ImageCacheTileRef tile;
-                    tile = new ImageCacheTile(id, &buf[i * pixelsize], format,
-                                              pixelsize, scanlinesize,
-                                              scanlinesize * th);
-                    ok &= tile->valid();
-                    ok &= imagecache().add_tile_to_cache(tile, thread_info);
-                }
-            }
+            if (i == xx)
+                continue;
+            TileID tid(*this, subimage, miplevel, i + spec.x, y0, z, chbegin,
+                       chend, colortransformid);
+            if (!imagecache().tile_in_cache(tid, thread_info))
+                needed.push_back(i);
+        }
+        // Repack the scanline buffer into tile-major layout. Each tile's
+        // repack is an independent gather of rows out of the buffer (and
+        // with no data conversion involved, convert_image inside the
+        // ImageCacheTile constructor reduces to contiguous row memcpys),
+        // so for a wide plate fan the tiles of the row out across the
+        // thread pool rather than marching across them one by one.
+        std::vector<ImageCacheTileRef> rowtiles(needed.size());
+        auto repack = [&](int64_t t) {
+            int i = needed[t];
+            TileID tid(*this, subimage, miplevel, i + spec.x, y0, z, chbegin,
+                       chend, colortransformid);
+            rowtiles[t] = new ImageCacheTile(tid, &buf[i * pixelsize], format,
+                                             pixelsize, scanlinesize,
+                                             scanlinesize * th);
+        };
+        if (needed.size() >= 4) {
+            parallel_for(int64_t(0), int64_t(needed.size()), repack);
+        } else {
+            for (int64_t t = 0, e = int64_t(needed.size()); t < e; ++t)
+                repack(t);
+        }
+        // The tile we've been asked for goes into the caller's buffer.
+        convert_image(nchans, tw, th, 1, &buf[x0 * pixelsize], format,
+                      pixelsize, scanlinesize, scanlinesize * th, data, format,
+                      xstride, ystride, zstride);
+        // Enter the rest into the cache so they'll be there when asked
+        // for. (add_tile_to_cache uses the caller's per-thread info, so
+        // this part stays on this thread.)
+        for (ImageCacheTileRef& tile : rowtiles) {
+            ok &= tile->valid();
+            ok &= imagecache().add_tile_to_cache(tile, thread_info);
         }
     } else {
         // No auto-tile -- the tile is the whole image
@@ -1107,6 +1324,58 @@ ImageCacheFile::close()
     // are still hanging onto it.
     std::shared_ptr<ImageInput> empty;
     set_imageinput(empty);
+    // N.B. any memory mapping is NOT released here -- it consumes no file
+    // descriptor, and keeping it makes a subsequent reopen nearly free.
+}
+
+
+
+bool
+ImageCacheFile::open_mmap()
+{
+#ifdef _WIN32
+    // Not yet implemented for Windows file mapping.
+    return false;
+#else
+    if (m_mmap_addr)
+        return true;  // already mapped
+    // Only plain local files can be mapped, not "REST-ful" constructions.
+    if (m_filename.find('?') != m_filename.npos)
+        return false;
+    int fd = ::open(m_filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode) || sb.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* addr = ::mmap(nullptr, size_t(sb.st_size), PROT_READ, MAP_SHARED,
+                        fd, 0);
+    ::close(fd);  // The mapping persists without the descriptor
+    if (addr == MAP_FAILED)
+        return false;
+    m_mmap_addr = addr;
+    m_mmap_size = size_t(sb.st_size);
+    m_mmap_reader.reset(
+        new Filesystem::IOMemReader(m_mmap_addr, m_mmap_size));
+    return true;
+#endif
+}
+
+
+
+void
+ImageCacheFile::close_mmap()
+{
+#ifndef _WIN32
+    m_mmap_reader.reset();
+    if (m_mmap_addr) {
+        ::munmap(m_mmap_addr, m_mmap_size);
+        m_mmap_addr = nullptr;
+        m_mmap_size = 0;
+    }
+#endif
 }
 
 
@@ -1142,6 +1411,7 @@ ImageCacheFile::invalidate()
     recursive_timed_lock_guard guard(m_input_mutex);
     m_mutex_wait_time += input_mutex_timer();
     close();
+    close_mmap();  // the file may have changed; don't trust the mapping
     invalidate_spec();
     mark_not_broken();
     m_fingerprint.clear();
@@ -1317,6 +1587,7 @@ ImageCacheImpl::verify_file(ImageCacheFile* tf,
             stats.fileio_time += createtime;
             stats.fileopen_time += createtime;
             tf->iotime() += createtime;
+            trace_event(tf->filename(), "open", createtime);
 
             // What if we've opened another file, with a different name,
             // but the SAME pixels?  It can happen!  Bad user, bad!  But
@@ -1407,11 +1678,31 @@ ImageCacheImpl::check_max_files(ImageCachePerThreadInfo* /*thread_info*/)
     }
 #endif
 
+    if (m_max_open_files_auto
+        && m_stat_open_files_created - m_autotune_last_opens >= 256)
+        tune_max_open_files();
+
     int open_files = m_stat_open_files_current;
     if (open_files < m_max_open_files) {
         // Early out if we aren't exceeding the open file handle limit
         return;
     }
+    if (m_async_file_close) {
+        // Hand the sweep to a background task, so that closing files
+        // (which may flush state inside the ImageInput) doesn't add
+        // latency to the tile request that happened to trip the limit.
+        // Only one reaper task is in flight at a time.
+        if (!m_file_sweep_pending.exchange(1)) {
+            ++m_outstanding_prefetches;
+            default_thread_pool()->push([this](int) {
+                m_file_sweep_mutex.lock();
+                file_sweep();
+                m_file_sweep_pending = 0;
+                --m_outstanding_prefetches;
+            });
+        }
+        return;
+    }
     if (!m_max_open_files_strict || open_files < m_max_open_files + 16) {
         // If we're only exceeding the open files limit by a little bit (or by
         // any amount if we aren't trying to be strict about), try to grab the
@@ -1431,7 +1722,14 @@ ImageCacheImpl::check_max_files(ImageCachePerThreadInfo* /*thread_info*/)
         // and do the work to close some of those handles.
         m_file_sweep_mutex.lock();
     }
+    file_sweep();
+}
 
+
+
+void
+ImageCacheImpl::file_sweep()
+{
     // Now, what we want to do is have a "clock hand" that sweeps across
     // the cache, releasing files that haven't been used for a long
     // time.  Because of multi-thread, rather than keep an iterator
@@ -1490,6 +1788,59 @@ ImageCacheImpl::check_max_files(ImageCachePerThreadInfo* /*thread_info*/)
 
 
 
+void
+ImageCacheImpl::tune_max_open_files()
+{
+    // Only one tuner at a time; if another thread is already at it, just
+    // move on rather than blocking a tile request.
+    if (!m_autotune_mutex.try_lock())
+        return;
+    long long opens       = m_stat_open_files_created;
+    long long reopens     = opens - m_autotune_last_opens;
+    m_autotune_last_opens = opens;
+    int failures          = m_open_failures.exchange(0);
+    int oldlimit          = m_max_open_files;
+
+    // Hard ceiling: never tune above half the process rlimit, so that
+    // other libraries sharing the process still have descriptor headroom
+    // no matter how much reopen churn we observe.
+    int ceiling = int(std::min(Sysutil::max_open_files(),
+                               size_t(std::numeric_limits<int>::max())));
+    ceiling     = std::max(16, ceiling / 2);
+
+    int newlimit    = oldlimit;
+    const char* why = nullptr;
+    if (failures) {
+        // Re-opening files that were fine before is now failing -- the
+        // process is running out of descriptors (not necessarily our
+        // doing). Back off hard to leave room.
+        newlimit = std::max(16, oldlimit / 2);
+        why      = "open failures";
+    } else if (m_stat_open_files_current >= oldlimit - 1
+               && reopens > 4 * (long long)oldlimit) {
+        // We're pinned at the limit and have churned through several
+        // times more opens than we're allowed to keep, so the clock
+        // sweep is closing files we promptly need again. Raise the
+        // limit (but stay under the ceiling).
+        newlimit = std::min(ceiling, oldlimit + oldlimit / 4 + 1);
+        why      = "reopen churn";
+    }
+    if (newlimit != oldlimit) {
+        set_max_open_files(newlimit);
+        // Append to the decision trace for monitoring, but don't let it
+        // grow without bound in a long-running process.
+        if (m_autotune_trace.size() < 16384)
+            m_autotune_trace += Strutil::fmt::format(
+                "max_open_files {} -> {} ({}: {} opens, {} failures, "
+                "{} current, ceiling {})\n",
+                oldlimit, m_max_open_files, why, reopens, failures,
+                int(m_stat_open_files_current), ceiling);
+    }
+    m_autotune_mutex.unlock();
+}
+
+
+
 void
 ImageCacheImpl::set_min_cache_size(long long newsize)
 {
@@ -1498,19 +1849,186 @@ ImageCacheImpl::set_min_cache_size(long long newsize)
 
 
 
+namespace {
+
+// Recycling pools for tile storage. A busy ImageCache in steady state
+// continually evicts tiles and reads new ones of identical size, so routing
+// every fill and eviction through the global allocator just buys lock
+// contention. We keep a small freelist of recently freed pixel blocks,
+// bucketed by exact size (real workloads only ever see a few distinct tile
+// sizes), plus a freelist of ImageCacheTile shells, so the steady-state
+// miss path doesn't touch malloc at all. The pools are shared by all
+// ImageCache instances and capped at a modest size; anything beyond the
+// caps falls through to ordinary allocation.
+
+class TilePixelPool {
+public:
+    ~TilePixelPool()
+    {
+        for (SizeClass& c : m_class)
+            for (char* p : c.blocks)
+                free(p);
+    }
+
+    char* alloc(size_t size)
+    {
+        {
+            spin_lock lock(m_mutex);
+            for (SizeClass& c : m_class)
+                if (c.size == size && !c.blocks.empty()) {
+                    char* p = c.blocks.back();
+                    c.blocks.pop_back();
+                    m_bytes -= size;
+                    return p;
+                }
+        }
+        // Allocate tile storage on a SIMD-register boundary, so filtering
+        // kernels can use aligned loads on any tile whose row pitch is a
+        // multiple of the SIMD width (power-of-2 tile sizes with 1/2/4/8
+        // byte texels -- the common case by far). Together with the
+        // OIIO_SIMD_MAX_SIZE_BYTES of zeroed end padding (see
+        // memsize_needed), this permits unconditional full-width loads.
+        constexpr size_t align = OIIO_SIMD_MAX_SIZE_BYTES;
+        return (char*)aligned_alloc(align, round_to_multiple(size, align));
+    }
+
+    void release(char* p, size_t size)
+    {
+        if (size && size <= max_block_bytes) {
+            spin_lock lock(m_mutex);
+            SizeClass* avail = nullptr;
+            for (SizeClass& c : m_class) {
+                if (c.size == size) {
+                    avail = &c;
+                    break;
+                }
+                if (!avail && c.blocks.empty())
+                    avail = &c;  // idle size class we may repurpose
+            }
+            if (avail && avail->blocks.size() < max_per_class
+                && m_bytes + size <= max_pool_bytes) {
+                avail->size = size;
+                avail->blocks.push_back(p);
+                m_bytes += size;
+                return;
+            }
+        }
+        free(p);
+    }
+
+private:
+    static constexpr size_t max_block_bytes = 16 * 1024 * 1024;
+    static constexpr size_t max_pool_bytes  = 64 * 1024 * 1024;
+    static constexpr size_t max_per_class   = 64;
+    struct SizeClass {
+        size_t size = 0;
+        std::vector<char*> blocks;
+    };
+    spin_mutex m_mutex;
+    size_t m_bytes = 0;
+    SizeClass m_class[8];
+};
+
+
+class TileShellPool {
+public:
+    ~TileShellPool()
+    {
+        for (void* p : m_free)
+            ::operator delete(p);
+    }
+
+    void* alloc(size_t size)
+    {
+        {
+            spin_lock lock(m_mutex);
+            if (!m_free.empty()) {
+                void* p = m_free.back();
+                m_free.pop_back();
+                return p;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void release(void* p)
+    {
+        {
+            spin_lock lock(m_mutex);
+            if (m_free.size() < max_shells) {
+                m_free.push_back(p);
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+private:
+    static constexpr size_t max_shells = 4096;
+    spin_mutex m_mutex;
+    std::vector<void*> m_free;
+};
+
+static TilePixelPool tile_pixel_pool;
+static TileShellPool tile_shell_pool;
+
+}  // anonymous namespace
+
+
+
+void*
+ImageCacheTile::operator new(size_t size)
+{
+    // All tiles are the same size (the class is final), so they recycle
+    // perfectly through a single freelist.
+    return tile_shell_pool.alloc(size);
+}
+
+
+
+void
+ImageCacheTile::operator delete(void* ptr)
+{
+    tile_shell_pool.release(ptr);
+}
+
+
+
 ImageCacheTile::ImageCacheTile(const TileID& id)
     : m_id(id)
     , m_valid(true)
+    , m_file_generation(id.file().generation())
 {
     id.file().imagecache().incr_tiles(0);  // mem counted separately in read
 }
 
 
 
+char*
+ImageCacheTile::alloc_pixels(size_t size)
+{
+    m_pixels_size = size;
+    m_devmem      = m_id.file().imagecache().device_memory();
+    if (m_devmem) {
+        char* p = (char*)pvt::device_unified_malloc(size);
+        if (p) {
+            m_pixels.reset(p);
+            return p;
+        }
+        // Unified allocation failed; fall back to ordinary memory.
+        m_devmem = false;
+    }
+    m_pixels.reset(tile_pixel_pool.alloc(size));
+    return m_pixels.get();
+}
+
+
+
 ImageCacheTile::ImageCacheTile(const TileID& id, const void* pels,
                                TypeDesc format, stride_t xstride,
                                stride_t ystride, stride_t zstride, bool copy)
     : m_id(id)
+    , m_file_generation(id.file().generation())
 {
     ImageCacheFile& file(m_id.file());
     const ImageSpec& spec(file.spec(id.subimage(), id.miplevel()));
@@ -1523,8 +2041,7 @@ ImageCacheTile::ImageCacheTile(const TileID& id, const void* pels,
                         "size was %llu, memsize = %llu",
                         (unsigned long long)size,
                         (unsigned long long)memsize());
-        m_pixels_size = size;
-        m_pixels.reset(new char[m_pixels_size]);
+        alloc_pixels(size);
         m_valid
             = convert_image(id.nchannels(), spec.tile_width, spec.tile_height,
                             spec.tile_depth, pels, format, xstride, ystride,
@@ -1549,6 +2066,10 @@ ImageCacheTile::~ImageCacheTile()
     m_id.file().imagecache().decr_tiles(memsize());
     if (m_nofree)
         m_pixels.release();  // release without freeing
+    else if (m_devmem)
+        pvt::device_free(m_pixels.release());
+    else if (m_pixels)
+        tile_pixel_pool.release(m_pixels.release(), m_pixels_size);
 }
 
 
@@ -1574,7 +2095,7 @@ ImageCacheTile::read(ImageCachePerThreadInfo* thread_info)
     m_pixelsize   = m_id.nchannels() * m_channelsize;
     size_t size   = memsize_needed();
     OIIO_ASSERT(memsize() == 0 && size > OIIO_SIMD_MAX_SIZE_BYTES);
-    m_pixels.reset(new char[m_pixels_size = size]);
+    alloc_pixels(size);
     // Clear the end pad values so there aren't NaNs sucked up by simd loads
     memset(m_pixels.get() + size - OIIO_SIMD_MAX_SIZE_BYTES, 0,
            OIIO_SIMD_MAX_SIZE_BYTES);
@@ -1583,18 +2104,18 @@ ImageCacheTile::read(ImageCachePerThreadInfo* thread_info)
     if (m_valid) {
         ImageCacheFile::LevelInfo& lev(
             file.levelinfo(m_id.subimage(), m_id.miplevel()));
-        m_tile_width = lev.spec.tile_width;
+        m_tile_width = lev.spec().tile_width;
         OIIO_DASSERT(m_tile_width > 0);
-        int whichtile = ((m_id.x() - lev.spec.x) / lev.spec.tile_width)
-                        + ((m_id.y() - lev.spec.y) / lev.spec.tile_height)
+        int whichtile = ((m_id.x() - lev.spec().x) / lev.spec().tile_width)
+                        + ((m_id.y() - lev.spec().y) / lev.spec().tile_height)
                               * lev.nxtiles
-                        + ((m_id.z() - lev.spec.z) / lev.spec.tile_depth)
+                        + ((m_id.z() - lev.spec().z) / lev.spec().tile_depth)
                               * (lev.nxtiles * lev.nytiles);
         int index       = whichtile / 64;
         int64_t bitmask = int64_t(1ULL << (whichtile & 63));
         int64_t oldval  = lev.tiles_read[index].fetch_or(bitmask);
         if (oldval & bitmask)  // Was it previously read?
-            file.register_redundant_tile(lev.spec.tile_bytes());
+            file.register_redundant_tile(lev.spec().tile_bytes());
     } else {
         // (! m_valid)
         m_used = false;  // Don't let it hold mem if invalid
@@ -1678,12 +2199,30 @@ ImageCacheImpl::set_max_open_files(int max_open_files)
 void
 ImageCacheImpl::init()
 {
+    // Tile lookups vastly outnumber insertions and erasures, and a stale
+    // hit (a tile the sweep just evicted) is still a perfectly good tile,
+    // so let tile-map reads go through the lock-free snapshot path.
+    m_tilecache.enable_lockfree_reads(true);
     set_max_open_files(100);
     m_max_memory_bytes     = 1024LL * 1024 * 1024;  // 1 GB default cache size
     m_autotile             = 0;
+    m_volume_bricksize     = 0;
     m_autoscanline         = false;
+    m_tile_prefetch        = false;
+    m_async_tile_reads     = false;
+    m_mmap_files           = false;
+    m_microcache_tiles     = 0;
+    m_udim_preresolve      = false;
+    m_async_file_close     = false;
+    m_lazy_invalidate      = false;
+    m_file_sweep_pending   = 0;
+    m_compressed_mem_used  = 0;
+    m_max_compressed_memory_bytes = 0;
+    m_shm_tilecache_bytes  = 512LL * 1024 * 1024;
+    m_disk_tilecache_bytes = 4LL * 1024 * 1024 * 1024;
     m_automip              = false;
     m_forcefloat           = false;
+    m_storehalf            = false;
     m_accept_untiled       = true;
     m_accept_unmipped      = true;
     m_deduplicate          = true;
@@ -1693,15 +2232,25 @@ ImageCacheImpl::init()
     m_Mw2c.makeIdentity();
     m_colorspace              = ustring("scene_linear");
     m_mem_used                = 0;
+    m_outstanding_prefetches  = 0;
+    m_seq_prefetch_epoch      = 0;
+    m_seq_prefetch_bytes      = 0;
     m_statslevel              = 0;
     m_max_errors_per_file     = 100;
     m_stat_tiles_created      = 0;
+    m_stat_tiles_evicted      = 0;
+    m_trace_events            = false;
+    m_trace_epoch             = std::chrono::steady_clock::now();
     m_stat_tiles_current      = 0;
     m_stat_tiles_peak         = 0;
     m_stat_open_files_created = 0;
     m_stat_open_files_current = 0;
     m_stat_open_files_peak    = 0;
     m_max_open_files_strict   = false;
+    m_max_open_files_auto     = false;
+    m_device_memory           = false;
+    m_open_failures           = 0;
+    m_autotune_last_opens     = 0;
 
     // Allow environment variable to override default options
     const char* options = getenv("OPENIMAGEIO_IMAGECACHE_OPTIONS");
@@ -1713,11 +2262,12 @@ ImageCacheImpl::init()
 
 ImageCacheImpl::~ImageCacheImpl()
 {
+    wait_for_prefetches();
     printstats();
     // All the per_thread_infos get destroyed here, regardless of if they were created implicitly
     // or manually by the caller
     {
-        spin_lock lock(m_perthread_info_mutex);
+        adaptive_lock lock(m_perthread_info_mutex);
         m_all_perthread_info.clear();
     }
     // Erase any leftover errors from this thread
@@ -1732,10 +2282,25 @@ void
 ImageCacheImpl::mergestats(ImageCacheStatistics& stats) const
 {
     stats.init();
-    spin_lock lock(m_perthread_info_mutex);
-    for (auto& p : m_all_perthread_info)
-        if (p)
-            stats.merge(p->m_stats);
+    // Snapshot the registry of per-thread blocks while holding the lock,
+    // but do the actual merge walk outside it. The lock guards only the
+    // vector of blocks (mutated when a new thread registers), so frequent
+    // stats sampling -- e.g. a live dashboard polling getattribute() many
+    // times a second during a render -- holds the lock just long enough to
+    // copy some pointers and never stalls working threads. The blocks
+    // themselves are written lock-free by their owning threads and live
+    // until the cache is destroyed; reading them without synchronization
+    // may catch a counter mid-update, which is acceptable for telemetry.
+    std::vector<const ImageCachePerThreadInfo*> blocks;
+    {
+        adaptive_lock lock(m_perthread_info_mutex);
+        blocks.reserve(m_all_perthread_info.size());
+        for (auto& p : m_all_perthread_info)
+            if (p)
+                blocks.push_back(p.get());
+    }
+    for (const ImageCachePerThreadInfo* p : blocks)
+        stats.merge(p->m_stats);
 }
 
 
@@ -1900,10 +2465,13 @@ ImageCacheImpl::getstats(int level) const
                                     m_max_memory_bytes / (1024.0 * 1024.0));
         INTOPT(max_open_files);
         BOOLOPT(max_open_files_strict);
+        BOOLOPT(max_open_files_auto);
+        BOOLOPT(device_memory);
         INTOPT(autotile);
         INTOPT(autoscanline);
         INTOPT(automip);
         INTOPT(forcefloat);
+        INTOPT(storehalf);
         INTOPT(accept_untiled);
         INTOPT(accept_unmipped);
         INTOPT(deduplicate);
@@ -1939,7 +2507,7 @@ ImageCacheImpl::getstats(int level) const
             print(out, "    File I/O time : {}",
                   Strutil::timeintervalformat(stats.fileio_time));
             {
-                spin_lock lock(m_perthread_info_mutex);
+                adaptive_lock lock(m_perthread_info_mutex);
                 size_t nthreads = m_all_perthread_info.size();
                 if (nthreads > 1 || level > 2) {
                     double perthreadtime = stats.fileio_time
@@ -2142,7 +2710,7 @@ void
 ImageCacheImpl::reset_stats()
 {
     {
-        spin_lock lock(m_perthread_info_mutex);
+        adaptive_lock lock(m_perthread_info_mutex);
         for (size_t i = 0; i < m_all_perthread_info.size(); ++i)
             if (m_all_perthread_info[i])
                 m_all_perthread_info[i]->m_stats.init();
@@ -2168,7 +2736,13 @@ ImageCacheImpl::attribute(string_view name, TypeDesc type, const void* val)
     bool do_invalidate    = false;
     bool force_invalidate = false;
     if (name == "options" && type == TypeDesc::STRING) {
-        return optparser(*this, *(const char**)val);
+        // Apply the whole option string as one transaction, so that at
+        // most one invalidation results no matter how many of the options
+        // would individually have triggered one.
+        begin_attribute_transaction();
+        bool ok = optparser(*this, *(const char**)val);
+        commit_attribute_transaction();
+        return ok;
     }
     if (name == "max_open_files" && type == TypeDesc::INT) {
         set_max_open_files(*(const int*)val);
@@ -2215,12 +2789,107 @@ ImageCacheImpl::attribute(string_view name, TypeDesc type, const void* val)
             m_autotile    = a;
             do_invalidate = true;
         }
+    } else if (name == "volume_bricksize" && type == TypeDesc::INT) {
+        int b = *(const int*)val;
+        if (b != m_volume_bricksize) {
+            m_volume_bricksize = b;
+            do_invalidate      = true;
+        }
     } else if (name == "autoscanline" && type == TypeDesc::INT) {
         bool a = (*(const int*)val != 0);
         if (a != m_autoscanline) {
             m_autoscanline = a;
             do_invalidate  = true;
         }
+    } else if (name == "tile_prefetch" && type == TypeDesc::INT) {
+        m_tile_prefetch = (*(const int*)val != 0);
+    } else if (name == "async_tile_reads" && type == TypeDesc::INT) {
+        m_async_tile_reads = (*(const int*)val != 0);
+    } else if (name == "udim_preresolve" && type == TypeDesc::INT) {
+        m_udim_preresolve = (*(const int*)val != 0);
+    } else if (name == "async_file_close" && type == TypeDesc::INT) {
+        m_async_file_close = (*(const int*)val != 0);
+    } else if (name == "lazy_invalidate" && type == TypeDesc::INT) {
+        m_lazy_invalidate = (*(const int*)val != 0);
+    } else if (name == "trace_events" && type == TypeDesc::INT) {
+        bool enable = (*(const int*)val != 0);
+        if (enable && !m_trace_events) {
+            // (Re)starting a trace: begin with an empty log and a fresh
+            // epoch so timestamps are small and comparable.
+            spin_lock lock(m_trace_mutex);
+            m_trace_log.clear();
+            m_trace_epoch = std::chrono::steady_clock::now();
+        }
+        m_trace_events = enable;
+    } else if (name == "eviction_policy" && type == TypeDesc::STRING) {
+        string_view policy(*(const char**)val);
+        if (policy == "costaware")
+            m_cost_aware_eviction = true;
+        else if (policy == "lru" || policy.empty())
+            m_cost_aware_eviction = false;
+        else
+            return false;  // unrecognized policy name
+    } else if (name == "shared_tile_cache" && type == TypeDesc::STRING) {
+        std::string newname(*(const char**)val);
+        if (newname != m_shm_tilecache_name) {
+            m_shm_tilecache_name = newname;
+            m_shm_tilecache.reset();
+            if (!newname.empty()) {
+                std::unique_ptr<ShmTileCache> shm(
+                    new ShmTileCache(newname, size_t(m_shm_tilecache_bytes)));
+                if (shm->valid())
+                    m_shm_tilecache = std::move(shm);
+                else
+                    error("Could not attach shared tile cache \"{}\"",
+                          newname);
+            }
+        }
+    } else if (name == "shared_tile_cache_MB"
+               && (type == TypeDesc::FLOAT || type == TypeDesc::INT)) {
+        float size = (type == TypeDesc::FLOAT) ? *(const float*)val
+                                               : float(*(const int*)val);
+        m_shm_tilecache_bytes = (long long)(size * (long long)(1024 * 1024));
+    } else if (name == "disk_tile_cache" && type == TypeDesc::STRING) {
+        std::string newpath(*(const char**)val);
+        if (newpath != m_disk_tilecache_path) {
+            m_disk_tilecache_path = newpath;
+            m_disk_tilecache.reset();
+            if (!newpath.empty()) {
+                std::unique_ptr<DiskTileCache> dc(
+                    new DiskTileCache(newpath,
+                                      size_t(m_disk_tilecache_bytes)));
+                if (dc->valid())
+                    m_disk_tilecache = std::move(dc);
+                else
+                    error("Could not open disk tile cache \"{}\"", newpath);
+            }
+        }
+    } else if (name == "disk_tile_cache_MB"
+               && (type == TypeDesc::FLOAT || type == TypeDesc::INT)) {
+        float size = (type == TypeDesc::FLOAT) ? *(const float*)val
+                                               : float(*(const int*)val);
+        m_disk_tilecache_bytes = (long long)(size * (long long)(1024 * 1024));
+    } else if (name == "max_compressed_memory_MB"
+               && (type == TypeDesc::FLOAT || type == TypeDesc::INT)) {
+        float size = (type == TypeDesc::FLOAT) ? *(const float*)val
+                                               : float(*(const int*)val);
+        m_max_compressed_memory_bytes = (long long)(size
+                                                    * (long long)(1024 * 1024));
+        if (!compressed_tier_enabled()) {
+            // Tier turned off -- drop anything it holds.
+            m_compressed_tilecache.clear();
+            m_compressed_mem_used = 0;
+        }
+    } else if (name == "microcache_tiles" && type == TypeDesc::INT) {
+        m_microcache_tiles = *(const int*)val;
+        if (m_microcache_tiles == 0)
+            purge_perthread_microcaches();  // release any pinned tiles
+    } else if (name == "mmap_files" && type == TypeDesc::INT) {
+        bool a = (*(const int*)val != 0);
+        if (a != m_mmap_files) {
+            m_mmap_files  = a;
+            do_invalidate = true;  // files must reopen through the mapping
+        }
     } else if (name == "automip" && type == TypeDesc::INT) {
         bool a = (*(const int*)val != 0);
         if (a != m_automip) {
@@ -2233,6 +2902,12 @@ ImageCacheImpl::attribute(string_view name, TypeDesc type, const void* val)
             m_forcefloat  = a;
             do_invalidate = true;
         }
+    } else if (name == "storehalf" && type == TypeDesc::INT) {
+        bool a = (*(const int*)val != 0);
+        if (a != m_storehalf) {
+            m_storehalf   = a;
+            do_invalidate = true;
+        }
     } else if (name == "accept_untiled" && type == TypeDesc::INT) {
         bool a = (*(const int*)val != 0);
         if (a != m_accept_untiled) {
@@ -2261,8 +2936,18 @@ ImageCacheImpl::attribute(string_view name, TypeDesc type, const void* val)
         m_failure_retries = *(const int*)val;
     } else if (name == "trust_file_extensions" && type == TypeDesc::INT) {
         m_trust_file_extensions = *(const int*)val;
+    } else if (name == "use_sidecar" && type == TypeDesc::INT) {
+        m_use_sidecar = *(const int*)val;
     } else if (name == "max_open_files_strict" && type == TypeDesc::INT) {
         m_max_open_files_strict = *(const int*)val;
+    } else if (name == "max_open_files_auto" && type == TypeDesc::INT) {
+        m_max_open_files_auto = *(const int*)val;
+    } else if (name == "device_memory" && type == TypeDesc::INT) {
+        bool devmem = *(const int*)val;
+        if (devmem != m_device_memory) {
+            m_device_memory = devmem;
+            do_invalidate   = true;  // existing tiles have the wrong home
+        }
     } else if (name == "latlong_up" && type == TypeDesc::STRING) {
         bool y_up = !strcmp("y", *(const char**)val);
         if (y_up != m_latlong_y_up_default) {
@@ -2295,30 +2980,82 @@ ImageCacheImpl::attribute(string_view name, TypeDesc type, const void* val)
         return false;
     }
 
-    if (do_invalidate)
-        invalidate_all(force_invalidate);
+    if (do_invalidate) {
+        if (m_attr_transaction_depth) {
+            // Inside a transaction: just note that an invalidation is
+            // owed; commit_attribute_transaction will do it exactly once.
+            m_pending_invalidate = true;
+            m_pending_force_invalidate |= force_invalidate;
+        } else {
+            invalidate_all(force_invalidate);
+        }
+    }
     return true;
 }
 
 
 
+void
+ImageCacheImpl::begin_attribute_transaction()
+{
+    ++m_attr_transaction_depth;
+}
+
+
+
+void
+ImageCacheImpl::commit_attribute_transaction()
+{
+    OIIO_DASSERT(m_attr_transaction_depth > 0);
+    if (m_attr_transaction_depth <= 0)
+        return;  // Unmatched commit -- ignore
+    if (--m_attr_transaction_depth == 0 && m_pending_invalidate) {
+        bool force                 = m_pending_force_invalidate;
+        m_pending_invalidate       = false;
+        m_pending_force_invalidate = false;
+        invalidate_all(force);
+    }
+}
+
+
+
 TypeDesc
 ImageCacheImpl::getattributetype(string_view name) const
 {
     static std::unordered_map<std::string, TypeDesc> attr_types {
         { "max_open_files", TypeInt },
+        { "max_open_files_auto", TypeInt },
+        { "device_memory", TypeInt },
+        { "stat:max_open_files_trace", TypeString },
         { "max_memory_MB", TypeFloat },
         { "statistics:level", TypeInt },
         { "max_errors_per_file", TypeInt },
         { "autotile", TypeInt },
+        { "volume_bricksize", TypeInt },
         { "autoscanline", TypeInt },
+        { "tile_prefetch", TypeInt },
+        { "async_tile_reads", TypeInt },
+        { "mmap_files", TypeInt },
+        { "microcache_tiles", TypeInt },
+        { "max_compressed_memory_MB", TypeFloat },
+        { "shared_tile_cache", TypeString },
+        { "eviction_policy", TypeString },
+        { "udim_preresolve", TypeInt },
+        { "async_file_close", TypeInt },
+        { "lazy_invalidate", TypeInt },
+        { "trace_events", TypeInt },
+        { "stat:tiles_evicted", TypeInt },
+        { "stat:chrome_trace", TypeString },
+        { "shared_tile_cache_MB", TypeFloat },
         { "automip", TypeInt },
         { "forcefloat", TypeInt },
+        { "storehalf", TypeInt },
         { "accept_untiled", TypeInt },
         { "accept_unmipped", TypeInt },
         { "deduplicate", TypeInt },
         { "unassociatedalpha", TypeInt },
         { "trust_file_extensions", TypeInt },
+        { "use_sidecar", TypeInt },
         { "failure_retries", TypeInt },
         { "total_files", TypeInt },
         { "max_mip_res", TypeInt },
@@ -2368,6 +3105,11 @@ ImageCacheImpl::getattributetype(string_view name) const
         // number of files we've encountered.
         return TypeDesc(TypeDesc::STRING, int(m_files.size()));
     }
+    if (name == "stat:all_file_bytes_read" || name == "stat:all_file_tiles_read"
+        || name == "stat:all_file_redundant_bytes_read")
+        return TypeDesc(TypeDesc::INT64, int(m_files.size()));
+    if (name == "stat:all_file_iotime")
+        return TypeDesc(TypeDesc::FLOAT, int(m_files.size()));
 
     return TypeUnknown;
 }
@@ -2389,15 +3131,36 @@ ImageCacheImpl::getattribute(string_view name, TypeDesc type, void* val) const
     ATTR_DECODE("statistics:level", int, m_statslevel);
     ATTR_DECODE("max_errors_per_file", int, m_max_errors_per_file);
     ATTR_DECODE("autotile", int, m_autotile);
+    ATTR_DECODE("volume_bricksize", int, m_volume_bricksize);
     ATTR_DECODE("autoscanline", int, m_autoscanline);
+    ATTR_DECODE("tile_prefetch", int, m_tile_prefetch);
+    ATTR_DECODE("async_tile_reads", int, m_async_tile_reads);
+    ATTR_DECODE("mmap_files", int, m_mmap_files);
+    ATTR_DECODE("microcache_tiles", int, m_microcache_tiles);
+    ATTR_DECODE("udim_preresolve", int, m_udim_preresolve);
+    ATTR_DECODE("async_file_close", int, m_async_file_close);
+    ATTR_DECODE("lazy_invalidate", int, m_lazy_invalidate);
+    ATTR_DECODE("trace_events", int, m_trace_events);
+    ATTR_DECODE("max_compressed_memory_MB", float,
+                m_max_compressed_memory_bytes / (1024.0 * 1024.0));
+    ATTR_DECODE("shared_tile_cache_MB", float,
+                m_shm_tilecache_bytes / (1024.0 * 1024.0));
+    ATTR_DECODE("disk_tile_cache_MB", float,
+                m_disk_tilecache_bytes / (1024.0 * 1024.0));
+    ATTR_DECODE("stat:compressed_cache_memory_used", long long,
+                m_compressed_mem_used);
     ATTR_DECODE("automip", int, m_automip);
     ATTR_DECODE("forcefloat", int, m_forcefloat);
+    ATTR_DECODE("storehalf", int, m_storehalf);
     ATTR_DECODE("accept_untiled", int, m_accept_untiled);
     ATTR_DECODE("accept_unmipped", int, m_accept_unmipped);
     ATTR_DECODE("deduplicate", int, m_deduplicate);
     ATTR_DECODE("unassociatedalpha", int, m_unassociatedalpha);
     ATTR_DECODE("trust_file_extensions", int, m_trust_file_extensions);
+    ATTR_DECODE("use_sidecar", int, m_use_sidecar);
     ATTR_DECODE("max_open_files_strict", int, m_max_open_files_strict);
+    ATTR_DECODE("max_open_files_auto", int, m_max_open_files_auto);
+    ATTR_DECODE("device_memory", int, m_device_memory);
     ATTR_DECODE("failure_retries", int, m_failure_retries);
     ATTR_DECODE("total_files", int, m_files.size());
     ATTR_DECODE("max_mip_res", int, m_max_mip_res);
@@ -2407,6 +3170,18 @@ ImageCacheImpl::getattribute(string_view name, TypeDesc type, void* val) const
         *(ustring*)val = m_searchpath;
         return true;
     }
+    if (name == "shared_tile_cache" && type == TypeDesc::STRING) {
+        *(ustring*)val = m_shm_tilecache_name;
+        return true;
+    }
+    if (name == "disk_tile_cache" && type == TypeDesc::STRING) {
+        *(ustring*)val = m_disk_tilecache_path;
+        return true;
+    }
+    if (name == "eviction_policy" && type == TypeDesc::STRING) {
+        *(ustring*)val = ustring(m_cost_aware_eviction ? "costaware" : "lru");
+        return true;
+    }
     if (name == "plugin_searchpath" && type == TypeDesc::STRING) {
         *(ustring*)val = m_plugin_searchpath;
         return true;
@@ -2448,12 +3223,83 @@ ImageCacheImpl::getattribute(string_view name, TypeDesc type, void* val) const
         return true;
     }
 
+    // Per-file counter arrays, in the same iteration order as (and thus
+    // parallel to) "all_filenames", provided no new files were encountered
+    // between the two queries.
+    if (name == "stat:all_file_bytes_read" && type.basetype == TypeDesc::INT64
+        && type.is_sized_array()) {
+        long long* v = (long long*)val;
+        int n        = type.arraylen;
+        for (FilenameMap::iterator f = m_files.begin();
+             f != m_files.end() && n-- > 0; ++f)
+            *v++ = (long long)f->second->bytesread();
+        return true;
+    }
+    if (name == "stat:all_file_tiles_read" && type.basetype == TypeDesc::INT64
+        && type.is_sized_array()) {
+        long long* v = (long long*)val;
+        int n        = type.arraylen;
+        for (FilenameMap::iterator f = m_files.begin();
+             f != m_files.end() && n-- > 0; ++f)
+            *v++ = (long long)f->second->tilesread();
+        return true;
+    }
+    if (name == "stat:all_file_redundant_bytes_read"
+        && type.basetype == TypeDesc::INT64 && type.is_sized_array()) {
+        long long* v = (long long*)val;
+        int n        = type.arraylen;
+        for (FilenameMap::iterator f = m_files.begin();
+             f != m_files.end() && n-- > 0; ++f)
+            *v++ = (long long)f->second->redundant_bytesread();
+        return true;
+    }
+    if (name == "stat:all_file_iotime" && type.basetype == TypeDesc::FLOAT
+        && type.is_sized_array()) {
+        float* v = (float*)val;
+        int n    = type.arraylen;
+        for (FilenameMap::iterator f = m_files.begin();
+             f != m_files.end() && n-- > 0; ++f)
+            *v++ = (float)f->second->iotime();
+        return true;
+    }
+
+    if (name == "stat:chrome_trace" && type == TypeDesc::STRING) {
+        // Serialize the recorded events in Chrome trace-event JSON, with
+        // times in microseconds as that format requires.
+        std::string json = "{\"traceEvents\":[";
+        {
+            spin_lock lock(m_trace_mutex);
+            for (size_t i = 0, e = m_trace_log.size(); i < e; ++i) {
+                const TraceEvent& ev(m_trace_log[i]);
+                if (i)
+                    json += ',';
+                json += Strutil::fmt::format(
+                    "{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\","
+                    "\"ts\":{:.1f},\"dur\":{:.1f},\"pid\":1,\"tid\":1}}",
+                    Strutil::escape_chars(ev.name), ev.cat, ev.ts * 1.0e6,
+                    ev.dur * 1.0e6);
+            }
+        }
+        json += "]}";
+        *(ustring*)val = ustring(json);
+        return true;
+    }
+
+    if (name == "stat:max_open_files_trace" && type == TypeDesc::STRING) {
+        // One line per adjustment made by tune_max_open_files, so that
+        // monitoring can see why the limit moved.
+        spin_lock lock(m_autotune_mutex);
+        *(ustring*)val = ustring(m_autotune_trace);
+        return true;
+    }
+
     if (Strutil::starts_with(name, "stat:")) {
         // Stats we can just grab
         ATTR_DECODE("stat:cache_memory_used", long long, m_mem_used);
         ATTR_DECODE("stat:tiles_created", int, m_stat_tiles_created);
         ATTR_DECODE("stat:tiles_current", int, m_stat_tiles_current);
         ATTR_DECODE("stat:tiles_peak", int, m_stat_tiles_peak);
+        ATTR_DECODE("stat:tiles_evicted", int, m_stat_tiles_evicted);
         ATTR_DECODE("stat:open_files_created", int, m_stat_open_files_created);
         ATTR_DECODE("stat:open_files_current", int, m_stat_open_files_current);
         ATTR_DECODE("stat:open_files_peak", int, m_stat_open_files_peak);
@@ -2496,6 +3342,26 @@ ImageCacheImpl::getattribute(string_view name, TypeDesc type, void* val) const
 
 
 
+int
+ImageCacheImpl::getattributes(cspan<string_view> names,
+                              ParamValueList& vals) const
+{
+    int found = 0;
+    for (string_view name : names) {
+        TypeDesc t = getattributetype(name);
+        char buf[64];  // big enough for any simple attribute value
+        if (t == TypeUnknown || t.size() > sizeof(buf))
+            continue;
+        if (getattribute(name, t, buf)) {
+            vals.emplace_back(name, t, 1, buf);
+            ++found;
+        }
+    }
+    return found;
+}
+
+
+
 bool
 ImageCacheImpl::find_tile_main_cache(const TileID& id, ImageCacheTileRef& tile,
                                      ImageCachePerThreadInfo* thread_info)
@@ -2513,6 +3379,13 @@ ImageCacheImpl::find_tile_main_cache(const TileID& id, ImageCacheTileRef& tile,
 #if IMAGECACHE_TIME_STATS
         stats.find_tile_time += timer1();
 #endif
+        if (found && tile->stale()) {
+            // The file was invalidated after this tile was read.  Drop
+            // the stale copy and treat the lookup as a miss.
+            m_tilecache.erase(id);
+            tile  = nullptr;
+            found = false;
+        }
         if (found) {
             // We found the tile in the cache, but we need to make sure we
             // wait until the pixels are ready to read.  We purposely have
@@ -2531,6 +3404,58 @@ ImageCacheImpl::find_tile_main_cache(const TileID& id, ImageCacheTileRef& tile,
 
     ++stats.find_tile_cache_misses;
 
+    // Before going back to disk, see if the compressed spill tier still
+    // holds this tile; rehydrating it is much cheaper than a re-read.
+    if (compressed_tier_enabled() && restore_compressed_tile(id, tile)) {
+        bool ok = add_tile_to_cache(tile, thread_info);
+        OIIO_DASSERT(id == tile->id());
+        return ok && tile->valid();
+    }
+
+    // Next try the node-wide shared-memory pool, where another process
+    // may already have decoded this very tile.
+    if (m_shm_tilecache) {
+        ImageCacheFile& file(id.file());
+        const ImageSpec& spec(file.spec(id.subimage(), id.miplevel()));
+        TypeDesc format    = file.datatype(id.subimage());
+        stride_t pixelsize = (stride_t)id.nchannels() * format.size();
+        size_t size        = spec.tile_pixels() * (size_t)pixelsize;
+        if (size <= ShmTileCache::slot_payload) {
+            std::unique_ptr<char[]> pixels(new char[size]);
+            if (m_shm_tilecache->retrieve(id, pixels.get(), size)) {
+                tile = new ImageCacheTile(id, pixels.get(), format, pixelsize,
+                                          pixelsize * spec.tile_width,
+                                          pixelsize * spec.tile_width
+                                              * spec.tile_height);
+                if (tile->valid()) {
+                    bool ok = add_tile_to_cache(tile, thread_info);
+                    return ok && tile->valid();
+                }
+            }
+        }
+    }
+
+    // Last chance before going back to the filer: the persistent local
+    // disk cache may hold the tile from an earlier run on this node.
+    if (m_disk_tilecache) {
+        ImageCacheFile& file(id.file());
+        const ImageSpec& spec(file.spec(id.subimage(), id.miplevel()));
+        TypeDesc format    = file.datatype(id.subimage());
+        stride_t pixelsize = (stride_t)id.nchannels() * format.size();
+        size_t size        = spec.tile_pixels() * (size_t)pixelsize;
+        std::unique_ptr<char[]> pixels(new char[size]);
+        if (m_disk_tilecache->retrieve(id, pixels.get(), size)) {
+            tile = new ImageCacheTile(id, pixels.get(), format, pixelsize,
+                                      pixelsize * spec.tile_width,
+                                      pixelsize * spec.tile_width
+                                          * spec.tile_height);
+            if (tile->valid()) {
+                bool ok = add_tile_to_cache(tile, thread_info);
+                return ok && tile->valid();
+            }
+        }
+    }
+
     // Yes, we're creating and reading a tile with no lock -- this is to
     // prevent all the other threads from blocking because of our
     // expensive disk read.  We believe this is safe, since underneath
@@ -2543,16 +3468,161 @@ ImageCacheImpl::find_tile_main_cache(const TileID& id, ImageCacheTileRef& tile,
 
     bool ok = add_tile_to_cache(tile, thread_info);
     OIIO_DASSERT(id == tile->id());
+    if (ok && tile->valid() && (m_shm_tilecache || m_disk_tilecache)) {
+        const ImageSpec& spec(id.file().spec(id.subimage(), id.miplevel()));
+        size_t size = spec.tile_pixels() * (size_t)tile->pixelsize();
+        // Share the freshly decoded tile with the other processes on
+        // this node.
+        if (m_shm_tilecache)
+            m_shm_tilecache->store(id, tile->data(), size);
+        // And persist it to local scratch, so later runs on this node
+        // (and re-render iterations) skip the filer entirely.
+        if (m_disk_tilecache)
+            m_disk_tilecache->store(id, tile->data(), size);
+    }
+    if (ok && m_tile_prefetch)
+        prefetch_neighbor_tiles(id, thread_info);
     return ok && tile->valid();
 }
 
 
 
+void
+ImageCacheImpl::batch_read_tiles(ImageCacheFile* file,
+                                 ImageCachePerThreadInfo* thread_info,
+                                 int subimage, int miplevel, int xbegin,
+                                 int xend, int ybegin, int yend, int zbegin,
+                                 int zend, int chbegin, int chend)
+{
+    // The serial loop in get_pixels() faults in each missing tile with a
+    // blocking read, one at a time.  Here we pre-scan the covering tiles,
+    // and if more than one is absent, submit all the misses to the default
+    // thread pool at once so the reads (and decompression) overlap.  This
+    // is the portable stand-in for a native async I/O submission queue:
+    // the ImageInput plugin API is where the actual decode happens, so the
+    // concurrency has to live above it.
+    const ImageSpec& spec(file->spec(subimage, miplevel));
+    // Clamp to the pixel data window; the copy loop zero-fills the rest.
+    xbegin = std::max(xbegin, spec.x);
+    xend   = std::min(xend, spec.x + spec.width);
+    ybegin = std::max(ybegin, spec.y);
+    yend   = std::min(yend, spec.y + spec.height);
+    zbegin = std::max(zbegin, spec.z);
+    zend   = std::min(zend, spec.z + spec.depth);
+    if (xbegin >= xend || ybegin >= yend || zbegin >= zend)
+        return;
+    thread_pool* pool = default_thread_pool();
+    if (pool->size() < 1)
+        return;  // No workers -- the serial loop is all there is
+    std::vector<TileID> misses;
+    for (int tz = zbegin - ((zbegin - spec.z) % spec.tile_depth); tz < zend;
+         tz += spec.tile_depth) {
+        for (int ty = ybegin - ((ybegin - spec.y) % spec.tile_height);
+             ty < yend; ty += spec.tile_height) {
+            for (int tx = xbegin - ((xbegin - spec.x) % spec.tile_width);
+                 tx < xend; tx += spec.tile_width) {
+                TileID id(*file, subimage, miplevel, tx, ty, tz, chbegin,
+                          chend);
+                if (!tile_in_cache(id, thread_info))
+                    misses.push_back(id);
+            }
+        }
+    }
+    if (misses.size() < 2)
+        return;  // Not worth the queueing overhead for a lone miss
+    task_set tasks(pool);
+    for (const TileID& id : misses) {
+        tasks.push(pool->push([this, id](int) {
+            ImageCachePerThreadInfo* ti = get_perthread_info();
+            if (!tile_in_cache(id, ti)) {
+                ImageCacheTileRef tile = new ImageCacheTile(id);
+                // Any read failure will be rediscovered (and reported) by
+                // the caller's subsequent find_tile of the same id.
+                (void)add_tile_to_cache(tile, ti);
+            }
+        }));
+    }
+    tasks.wait();
+}
+
+
+
+void
+ImageCacheImpl::prefetch_neighbor_tiles(const TileID& id,
+                                        ImageCachePerThreadInfo* thread_info)
+{
+    // A miss on this tile suggests that a coherent access pattern (like a
+    // shading grid walk) will shortly want the adjacent tiles, too.  Queue
+    // speculative reads of the 4-neighbors at the same MIP level onto the
+    // default thread pool, so the I/O overlaps with the caller's work
+    // rather than stalling a later lookup.
+    ImageCacheFile& file(id.file());
+    if (file.broken() || file.is_udim())
+        return;
+    const ImageCacheFile::SubimageInfo& si(file.subimageinfo(id.subimage()));
+    if (si.untiled || si.volume)
+        return;
+    thread_pool* pool = default_thread_pool();
+    if (pool->size() < 1 || pool->very_busy())
+        return;  // Don't pile speculative work onto a saturated pool
+    const ImageSpec& spec(file.spec(id.subimage(), id.miplevel()));
+    const int offsets[4][2] = { { -spec.tile_width, 0 },
+                                { spec.tile_width, 0 },
+                                { 0, -spec.tile_height },
+                                { 0, spec.tile_height } };
+    for (const auto& offset : offsets) {
+        int x = id.x() + offset[0];
+        int y = id.y() + offset[1];
+        if (x < spec.x || x >= spec.x + spec.width || y < spec.y
+            || y >= spec.y + spec.height)
+            continue;
+        TileID neighbor(file, id.subimage(), id.miplevel(), x, y, id.z(),
+                        id.chbegin(), id.chend(), id.colortransformid());
+        if (tile_in_cache(neighbor, thread_info))
+            continue;
+        ++m_outstanding_prefetches;
+        pool->push([this, neighbor](int) {
+            ImageCachePerThreadInfo* ti = get_perthread_info();
+            if (!tile_in_cache(neighbor, ti)) {
+                ImageCacheTileRef tile = new ImageCacheTile(neighbor);
+                // Insertion failure just means the speculation was wasted;
+                // the tile will be re-read on demand if actually needed.
+                (void)add_tile_to_cache(tile, ti);
+            }
+            --m_outstanding_prefetches;
+        });
+    }
+}
+
+
+
+void
+ImageCacheImpl::wait_for_prefetches() const
+{
+    while (m_outstanding_prefetches > 0)
+        std::this_thread::yield();
+}
+
+
+
 bool
 ImageCacheImpl::add_tile_to_cache(ImageCacheTileRef& tile,
-                                  ImageCachePerThreadInfo* thread_info)
+                                  ImageCachePerThreadInfo* thread_info,
+                                  bool replace)
 {
-    bool ourtile = m_tilecache.insert_retrieve(tile->id(), tile, tile);
+    bool ourtile;
+    if (replace) {
+        // Write-through replacement: our tile must supplant any existing
+        // copy rather than defer to it.  Erase-then-insert can race
+        // another thread re-reading the (not yet rewritten) file; loop
+        // until our copy is the one that lands.
+        ImageCacheTileRef oldtile;
+        while (
+            !(ourtile = m_tilecache.insert_retrieve(tile->id(), tile, oldtile)))
+            m_tilecache.erase(tile->id());
+    } else {
+        ourtile = m_tilecache.insert_retrieve(tile->id(), tile, tile);
+    }
 
     // If we added a new tile to the cache, we may still need to read the
     // pixels; and if we found the tile in cache, we may need to wait for
@@ -2565,6 +3635,8 @@ ImageCacheImpl::add_tile_to_cache(ImageCacheTileRef& tile,
             double readtime = timer();
             thread_info->m_stats.fileio_time += readtime;
             tile->id().file().iotime() += readtime;
+            tile->set_readtime(readtime);
+            trace_event(tile->id().file().filename(), "tileread", readtime);
         }
         check_max_mem(thread_info);
     } else {
@@ -2637,20 +3709,53 @@ ImageCacheImpl::check_max_mem(ImageCachePerThreadInfo* /*thread_info*/)
             break;
         OIIO_DASSERT(sweep->second);
 
-        if (!sweep->second->release()) {
+        bool stale = sweep->second->stale();
+        if (stale || !sweep->second->release()) {
+            // This is a candidate for eviction.  Under the cost-aware
+            // policy, a tile that was much more expensive to read than
+            // the typical evictee gets spared for one extra sweep, so
+            // cheap-to-reload tiles are sacrificed first.  (Skipped once
+            // we're on a repeat loop, to guarantee forward progress, and
+            // for stale tiles, which are dead weight.)
+            if (m_cost_aware_eviction && full_loops < 2 && !stale) {
+                ImageCacheTile* t = sweep->second.get();
+                double cost       = t->memsize()
+                                        ? double(t->readtime()) / t->memsize()
+                                        : 0.0;
+                if (m_evict_cost_ema > 0.0 && cost > 2.0 * m_evict_cost_ema
+                    && !t->evict_spared()) {
+                    t->spare_once();
+                    ++sweep;
+                    continue;
+                }
+                m_evict_cost_ema = m_evict_cost_ema <= 0.0
+                                       ? cost
+                                       : 0.99 * m_evict_cost_ema + 0.01 * cost;
+            }
             // This is a tile we should delete.  To keep iterating
             // safely, we have a good trick:
             // 1. remember the TileID of the tile to delete
             TileID todelete = sweep->first;
             size_t size     = sweep->second->memsize();
             OIIO_DASSERT(m_mem_used >= (long long)size);
+            // If the compressed spill tier is enabled, squirrel away the
+            // tile's pixels before dropping it, so near-future re-use
+            // costs a decompress rather than disk I/O and decode.
+            ImageCacheTileRef victim;
+            if (compressed_tier_enabled() && !stale)
+                victim = sweep->second;
             // 2. Find the TileID of the NEXT item. We do this by
             // incrementing the sweep iterator and grabbing its id.
             ++sweep;
             m_tile_sweep_id = (sweep ? sweep->first : TileID());
             // 3. Release the bin lock and erase the tile we wish to delete.
             sweep.unlock();
+            if (victim) {
+                stash_compressed_tile(victim);
+                victim.reset();
+            }
             m_tilecache.erase(todelete);
+            ++m_stat_tiles_evicted;
             // 4. Re-establish a locked iterator for the next item, since
             // the old iterator may have been invalidated by the erasure.
             if (!m_tile_sweep_id.empty())
@@ -2675,6 +3780,128 @@ ImageCacheImpl::check_max_mem(ImageCachePerThreadInfo* /*thread_info*/)
 
 
 
+void
+ImageCacheImpl::stash_compressed_tile(const ImageCacheTileRef& tile)
+{
+    if (!tile->valid() || !tile->pixels_ready())
+        return;
+    const TileID& id(tile->id());
+    {
+        // Already stashed (e.g. re-evicted after a tier hit)?  Just renew.
+        CompressedTileRef existing;
+        if (m_compressed_tilecache.retrieve(id, existing)) {
+            existing->m_used = 1;
+            return;
+        }
+    }
+    const ImageSpec& spec(id.file().spec(id.subimage(), id.miplevel()));
+    size_t usize = spec.tile_pixels() * tile->pixelsize();
+    uLongf csize = compressBound((uLong)usize);
+    std::unique_ptr<char[]> scratch(new char[csize]);
+    if (compress2((Bytef*)scratch.get(), &csize, (const Bytef*)tile->data(),
+                  (uLong)usize, Z_BEST_SPEED)
+        != Z_OK)
+        return;
+    if (csize >= usize)
+        return;  // Incompressible -- not worth holding at full size
+    CompressedTileRef ct = new CompressedTile(id);
+    ct->m_generation     = id.file().generation();
+    ct->m_cdata.reset(new char[csize]);
+    memcpy(ct->m_cdata.get(), scratch.get(), csize);
+    ct->m_csize = (uint32_t)csize;
+    ct->m_usize = (uint32_t)usize;
+    if (m_compressed_tilecache.insert_retrieve(id, ct, ct)) {
+        m_compressed_mem_used += (long long)csize;
+        check_max_compressed_mem();
+    }
+}
+
+
+
+bool
+ImageCacheImpl::restore_compressed_tile(const TileID& id,
+                                        ImageCacheTileRef& tile)
+{
+    CompressedTileRef ct;
+    if (!m_compressed_tilecache.retrieve(id, ct))
+        return false;
+    if (ct->m_generation != id.file().generation()) {
+        // Stashed before the file was invalidated; discard it.
+        m_compressed_tilecache.erase(id);
+        m_compressed_mem_used -= (long long)ct->m_csize;
+        return false;
+    }
+    std::unique_ptr<char[]> pixels(new char[ct->m_usize]);
+    uLongf usize = ct->m_usize;
+    if (uncompress((Bytef*)pixels.get(), &usize, (const Bytef*)ct->m_cdata.get(),
+                   ct->m_csize)
+            != Z_OK
+        || usize != ct->m_usize) {
+        // Corrupt entry; drop it and fall back to a disk read.
+        m_compressed_tilecache.erase(id);
+        m_compressed_mem_used -= (long long)ct->m_csize;
+        return false;
+    }
+    ct->m_used = 1;
+    ImageCacheFile& file(id.file());
+    const ImageSpec& spec(file.spec(id.subimage(), id.miplevel()));
+    TypeDesc format    = file.datatype(id.subimage());
+    stride_t pixelsize = (stride_t)id.nchannels() * format.size();
+    tile = new ImageCacheTile(id, pixels.get(), format, pixelsize,
+                              pixelsize * spec.tile_width,
+                              pixelsize * spec.tile_width * spec.tile_height);
+    return tile->valid();
+}
+
+
+
+void
+ImageCacheImpl::check_max_compressed_mem()
+{
+    if (m_compressed_tilecache.empty())
+        return;
+    if (m_compressed_mem_used < m_max_compressed_memory_bytes)
+        return;
+    // Same single-sweeper convention as check_max_mem: whoever holds the
+    // sweep mutex enforces the budget, everybody else just moves on.
+    if (!m_comp_sweep_mutex.try_lock())
+        return;
+
+    CompressedTileCache::iterator sweep;
+    if (!m_comp_sweep_id.empty())
+        sweep = m_compressed_tilecache.find(m_comp_sweep_id);
+    int full_loops = 0;
+    while (m_compressed_mem_used >= m_max_compressed_memory_bytes
+           && full_loops < 100) {
+        if (!sweep) {
+            sweep = m_compressed_tilecache.begin();
+            ++full_loops;
+        }
+        if (!sweep)
+            break;
+        CompressedTileRef ct = sweep->second;
+        int one              = 1;
+        if (!ct->m_used.compare_exchange_strong(one, 0)) {
+            // Second chance already spent -- evict this entry.
+            TileID todelete = sweep->first;
+            size_t size     = ct->m_csize;
+            ++sweep;
+            m_comp_sweep_id = (sweep ? sweep->first : TileID());
+            sweep.unlock();
+            m_compressed_tilecache.erase(todelete);
+            m_compressed_mem_used -= (long long)size;
+            if (!m_comp_sweep_id.empty())
+                sweep = m_compressed_tilecache.find(m_comp_sweep_id);
+        } else {
+            ++sweep;
+        }
+    }
+    m_comp_sweep_id = (sweep ? sweep->first : TileID());
+    m_comp_sweep_mutex.unlock();
+}
+
+
+
 std::string
 ImageCacheImpl::resolve_filename(const std::string& filename) const
 {
@@ -3226,6 +4453,65 @@ ImageCacheImpl::get_pixels(ImageCacheFile* file,
     stride_t zplanesize         = (yend - ybegin) * scanlinesize;
     OIIO_DASSERT(spec.depth >= 1 && spec.tile_depth >= 1);
 
+    // Optionally gang up the reads of all the missing tiles covering the
+    // region, so they proceed concurrently rather than faulting in one at
+    // a time inside the serial copy loop below.
+    if (m_async_tile_reads)
+        batch_read_tiles(file, thread_info, subimage, miplevel, xbegin, xend,
+                         ybegin, yend, zbegin, zend, cache_chbegin,
+                         cache_chend);
+
+    // Fast path: if the caller wants the cache's native data type and full
+    // channel range into a contiguous buffer, and the region lies inside
+    // the data window (no zero-padding needed), walk the region tile by
+    // tile and bulk-memcpy each tile's scanline runs. This skips the
+    // per-scanline tile lookup and type-conversion dispatch of the
+    // general loop below, which matters to apps reading back entire MIP
+    // levels in native layout.
+    if (format == cachetype && chbegin == cache_chbegin
+        && result_nchans == cache_nchans && xstride == result_pixelsize
+        && ystride == scanlinesize && zstride == zplanesize
+        && xbegin >= spec.x && xend <= spec.x + spec.width
+        && ybegin >= spec.y && yend <= spec.y + spec.height
+        && zbegin >= spec.z && zend <= spec.z + spec.depth) {
+        bool first = true;
+        for (int z0 = zbegin; z0 < zend;) {
+            int tz    = z0 - ((z0 - spec.z) % spec.tile_depth);
+            int zlast = std::min(tz + spec.tile_depth, zend);
+            for (int y0 = ybegin; y0 < yend;) {
+                int ty    = y0 - ((y0 - spec.y) % spec.tile_height);
+                int ylast = std::min(ty + spec.tile_height, yend);
+                for (int x0 = xbegin; x0 < xend;) {
+                    int tx    = x0 - ((x0 - spec.x) % spec.tile_width);
+                    int xlast = std::min(tx + spec.tile_width, xend);
+                    TileID tileid(*file, subimage, miplevel, tx, ty, tz,
+                                  cache_chbegin, cache_chend);
+                    if (!find_tile(tileid, thread_info, first))
+                        return false;
+                    first = false;
+                    ImageCacheTileRef& tile(thread_info->tile);
+                    OIIO_DASSERT(tile);
+                    size_t spanbytes = (xlast - x0) * result_pixelsize;
+                    for (int z = z0; z < zlast; ++z) {
+                        char* zp = (char*)result + (z - zbegin) * zstride;
+                        for (int y = y0; y < ylast; ++y) {
+                            const char* src
+                                = (const char*)tile->data(x0, y, z, chbegin);
+                            OIIO_DASSERT(src);
+                            memcpy(zp + (y - ybegin) * ystride
+                                       + (x0 - xbegin) * xstride,
+                                   src, spanbytes);
+                        }
+                    }
+                    x0 = xlast;
+                }
+                y0 = ylast;
+            }
+            z0 = zlast;
+        }
+        return true;
+    }
+
     imagesize_t npixelsread = 0;
     char* zptr              = (char*)result;
     for (int z = zbegin; z < zend; ++z, zptr += zstride) {
@@ -3434,7 +4720,7 @@ bool
 ImageCacheImpl::add_tile(ustring filename, int subimage, int miplevel, int x,
                          int y, int z, int chbegin, int chend, TypeDesc format,
                          const void* buffer, stride_t xstride, stride_t ystride,
-                         stride_t zstride, bool copy)
+                         stride_t zstride, bool copy, bool replace)
 {
     ImageCachePerThreadInfo* thread_info = get_perthread_info();
     ImageCacheFile* file                 = find_file(filename, thread_info);
@@ -3461,7 +4747,32 @@ ImageCacheImpl::add_tile(ustring filename, int subimage, int miplevel, int x,
             error("Could not construct the tile; unknown reasons.");
         return false;
     }
-    return add_tile_to_cache(tile, thread_info);
+    bool ok = add_tile_to_cache(tile, thread_info, replace);
+    if (ok && replace) {
+        // Write-through: make sure no fallback path can resurrect the
+        // superseded pixels.  Drop any compressed-tier copy, and push the
+        // fresh pixels through to the cross-process tiers (store()
+        // overwrites in place).
+        if (compressed_tier_enabled()) {
+            CompressedTileRef ct;
+            if (m_compressed_tilecache.retrieve(tileid, ct)) {
+                m_compressed_tilecache.erase(tileid);
+                m_compressed_mem_used -= (long long)ct->m_csize;
+            }
+        }
+        if (m_shm_tilecache || m_disk_tilecache) {
+            const ImageSpec& spec(file->spec(subimage, miplevel));
+            size_t size = spec.tile_pixels() * (size_t)tile->pixelsize();
+            if (m_shm_tilecache)
+                m_shm_tilecache->store(tileid, tile->data(), size);
+            if (m_disk_tilecache)
+                m_disk_tilecache->store(tileid, tile->data(), size);
+        }
+        // Other threads' microcaches may still pin the superseded tile;
+        // have them all start fresh.
+        purge_perthread_microcaches();
+    }
+    return ok;
 }
 
 
@@ -3486,6 +4797,9 @@ ImageCacheImpl::invalidate(ImageHandle* handle, bool force)
 {
     ImageCacheFileRef file(handle);
 
+    // Let any speculative tile reads for this (or any) file finish first.
+    wait_for_prefetches();
+
     if (!force) {
         // If not in force mode, we don't do anything if the modification
         // time of the file has not changed since we opened it.
@@ -3495,6 +4809,23 @@ ImageCacheImpl::invalidate(ImageHandle* handle, bool force)
             return;
     }
 
+    if (m_lazy_invalidate) {
+        // O(1) invalidation: bump the file's generation so that all of
+        // its cached tiles (main cache, compressed tier, and per-thread
+        // microcache copies) are rejected lazily at lookup time and
+        // evicted preferentially by the memory sweep, rather than
+        // walking the whole tile cache here while shading threads wait.
+        file->bump_generation();
+        const ustring fingerprint = file->fingerprint();
+        file->invalidate();
+        {
+            spin_lock lock(m_fingerprints_mutex);
+            m_fingerprints.erase(fingerprint);
+        }
+        purge_perthread_microcaches();
+        return;
+    }
+
     // Iterate over the entire tilecache, record the TileID's of all
     // tiles that are from the file we are invalidating.
     std::vector<TileID> tiles_to_delete;
@@ -3509,6 +4840,24 @@ ImageCacheImpl::invalidate(ImageHandle* handle, bool force)
     for (const TileID& id : tiles_to_delete)
         m_tilecache.erase(id);
 
+    // Ditto for any compressed spill-tier copies of this file's tiles.
+    if (compressed_tier_enabled()) {
+        tiles_to_delete.clear();
+        for (CompressedTileCache::iterator tci = m_compressed_tilecache.begin(),
+                                           e   = m_compressed_tilecache.end();
+             tci != e; ++tci) {
+            if ((*tci).second->id().file_ptr() == file.get())
+                tiles_to_delete.push_back((*tci).second->id());
+        }
+        for (const TileID& id : tiles_to_delete) {
+            CompressedTileRef ct;
+            if (m_compressed_tilecache.retrieve(id, ct)) {
+                m_compressed_tilecache.erase(id);
+                m_compressed_mem_used -= (long long)ct->m_csize;
+            }
+        }
+    }
+
     const ustring fingerprint = file->fingerprint();
 
     // Invalidate the file itself (close it and clear its spec)
@@ -3525,14 +4874,105 @@ ImageCacheImpl::invalidate(ImageHandle* handle, bool force)
 
 
 
+void
+ImageCacheImpl::invalidate(ustring filename, int subimage, ROI roi)
+{
+    ImageCacheFileRef file;
+    {
+        bool found = m_files.retrieve(filename, file);
+        if (!found)
+            return;  // no such file
+    }
+    if (!roi.defined() || file->broken() || subimage < 0
+        || subimage >= file->subimages()) {
+        // Degenerate requests get the whole-file treatment.
+        invalidate(file.get(), true);
+        return;
+    }
+
+    // Let any speculative tile reads for this (or any) file finish first.
+    wait_for_prefetches();
+
+    // A tile of MIP level m covers a 2^m-times-larger footprint in level-0
+    // coordinates, so scale the region (rounding outward) to each tile's
+    // level before testing for overlap.
+    auto intersects = [&](const TileID& id) {
+        if (id.file_ptr() != file.get() || id.subimage() != subimage)
+            return false;
+        int m = id.miplevel();
+        if (m >= file->miplevels(subimage))
+            return true;  // don't trust odd levels; drop them
+        const ImageSpec& spec(file->spec(subimage, m));
+        int tw = spec.tile_width ? spec.tile_width : spec.width;
+        int th = spec.tile_height ? spec.tile_height : spec.height;
+        int td = spec.tile_depth ? spec.tile_depth : std::max(1, spec.depth);
+        int xb = roi.xbegin >> m, xe = ((roi.xend - 1) >> m) + 1;
+        int yb = roi.ybegin >> m, ye = ((roi.yend - 1) >> m) + 1;
+        int zb = roi.zbegin >> m, ze = ((roi.zend - 1) >> m) + 1;
+        return xb < id.x() + tw && xe > id.x() && yb < id.y() + th
+               && ye > id.y() && zb < id.z() + td && ze > id.z();
+    };
+
+    // Gather, then drop, the intersecting in-memory tiles.
+    std::vector<TileID> tiles_to_delete;
+    for (TileCache::iterator tci = m_tilecache.begin(), e = m_tilecache.end();
+         tci != e; ++tci)
+        if (intersects((*tci).second->id()))
+            tiles_to_delete.push_back((*tci).second->id());
+    for (const TileID& id : tiles_to_delete)
+        m_tilecache.erase(id);
+
+    // Ditto for compressed spill-tier copies.
+    if (compressed_tier_enabled()) {
+        tiles_to_delete.clear();
+        for (CompressedTileCache::iterator tci = m_compressed_tilecache.begin(),
+                                           e   = m_compressed_tilecache.end();
+             tci != e; ++tci)
+            if (intersects((*tci).second->id()))
+                tiles_to_delete.push_back((*tci).second->id());
+        for (const TileID& id : tiles_to_delete) {
+            CompressedTileRef ct;
+            if (m_compressed_tilecache.retrieve(id, ct)) {
+                m_compressed_tilecache.erase(id);
+                m_compressed_mem_used -= (long long)ct->m_csize;
+            }
+        }
+    }
+
+    // Close the file handle (and mapping) so the next read sees the
+    // rewritten bytes, and pick up the new mod time -- which also retires
+    // any cross-process shm/disk tier entries, since those keys include
+    // the mod time. Specs are deliberately kept: region invalidation
+    // promises unchanged geometry.
+    {
+        Timer input_mutex_timer;
+        recursive_timed_lock_guard guard(file->m_input_mutex);
+        file->m_mutex_wait_time += input_mutex_timer();
+        file->close();
+        file->close_mmap();
+        file->m_mod_time = Filesystem::last_write_time(file->filename());
+    }
+
+    // Per-thread microcaches hold raw tile pointers; start them fresh.
+    purge_perthread_microcaches();
+}
+
+
+
 void
 ImageCacheImpl::invalidate_all(bool force)
 {
+    // In-flight prefetch tasks hold raw file pointers; let them drain
+    // before we start tearing down specs and tiles.
+    wait_for_prefetches();
+
     // Special case: invalidate EVERYTHING -- we can take some shortcuts
     // to do it all in one shot.
     if (force) {
         // Clear the whole tile cache
         m_tilecache.clear();
+        m_compressed_tilecache.clear();
+        m_compressed_mem_used = 0;
         // Invalidate (close and clear spec) all individual files
         for (FilenameMap::iterator fileit = m_files.begin(), e = m_files.end();
              fileit != e; ++fileit) {
@@ -3585,8 +5025,8 @@ ImageCacheImpl::invalidate_all(bool force)
             if (sub.untiled) {
                 for (int m = 0, mend = f->miplevels(s); m < mend; ++m) {
                     const ImageCacheFile::LevelInfo& level(f->levelinfo(s, m));
-                    if (level.spec.tile_width != m_autotile
-                        || level.spec.tile_height != m_autotile) {
+                    if (level.spec().tile_width != m_autotile
+                        || level.spec().tile_height != m_autotile) {
                         all_files.push_back(name);
                         break;
                     }
@@ -3607,6 +5047,117 @@ ImageCacheImpl::invalidate_all(bool force)
 
 
 
+int
+ImageCacheImpl::preopen(const std::vector<ustring>& filenames)
+{
+    // Open and parse the headers of all the named files as concurrent
+    // tasks on the default thread pool, so that an app can pay the
+    // open+header cost for a whole scene's worth of textures up front,
+    // in parallel, rather than serially upon each file's first lookup.
+    std::atomic<int> nok(0);
+    thread_pool* pool = default_thread_pool();
+    task_set tasks(pool);
+    for (ustring filename : filenames) {
+        tasks.push(pool->push([this, filename, &nok](int) {
+            ImageCachePerThreadInfo* thread_info = get_perthread_info();
+            ImageCacheFile* file = find_file(filename, thread_info);
+            file                 = verify_file(file, thread_info, true);
+            if (file && !file->broken())
+                ++nok;
+        }));
+    }
+    tasks.wait();
+    return nok;
+}
+
+
+
+void
+ImageCacheImpl::prefetch_sequence(string_view pattern, int firstframe,
+                                 int nframes, int stride, long long bytebudget)
+{
+    // Starting a new prefetch implicitly cancels the previous one: tasks
+    // tagged with an older epoch notice the mismatch and wind down, so a
+    // playhead jump just redirects the background I/O rather than piling
+    // a second prefetch on top of the first.
+    int epoch            = ++m_seq_prefetch_epoch;
+    m_seq_prefetch_bytes = 0;
+    if (nframes < 1 || stride == 0)
+        return;
+    if (bytebudget <= 0) {
+        // Default budget: a quarter of the tile memory limit, so playback
+        // prefetch can't evict the bulk of the current working set.
+        bytebudget = std::max(1LL, (long long)m_max_memory_bytes / 4);
+    }
+    std::vector<int> frames(nframes);
+    for (int i = 0; i < nframes; ++i)
+        frames[i] = firstframe + i * stride;
+    std::vector<std::string> filenames;
+    if (!Filesystem::enumerate_file_sequence(std::string(pattern), frames,
+                                             filenames))
+        return;  // malformed pattern
+    thread_pool* pool = default_thread_pool();
+    for (const std::string& f : filenames) {
+        ustring filename(f);
+        ++m_outstanding_prefetches;
+        pool->push([this, filename, epoch, bytebudget](int) {
+            prefetch_frame_tiles(filename, epoch, bytebudget);
+            --m_outstanding_prefetches;
+        });
+    }
+}
+
+
+
+void
+ImageCacheImpl::prefetch_frame_tiles(ustring filename, int epoch,
+                                     long long budget)
+{
+    if (epoch != m_seq_prefetch_epoch)
+        return;  // canceled before we even started
+    ImageCachePerThreadInfo* thread_info = get_perthread_info();
+    ImageCacheFile* file                 = find_file(filename, thread_info);
+    file = verify_file(file, thread_info, true);
+    if (!file || file->broken() || file->is_udim())
+        return;  // missing frames produce errors only if actually played
+    const ImageSpec& spec(file->spec(0, 0));
+    // Untiled files are represented in the cache as one whole-image tile
+    // (or autotile-sized tiles, already reflected in the spec).
+    int tw = spec.tile_width ? spec.tile_width : spec.width;
+    int th = spec.tile_height ? spec.tile_height : spec.height;
+    int td = spec.tile_depth ? spec.tile_depth : std::max(1, spec.depth);
+    for (int z = spec.z; z < spec.z + std::max(1, spec.depth); z += td) {
+        for (int y = spec.y; y < spec.y + spec.height; y += th) {
+            for (int x = spec.x; x < spec.x + spec.width; x += tw) {
+                if (epoch != m_seq_prefetch_epoch)
+                    return;  // playhead jumped; a newer prefetch owns us
+                if (m_seq_prefetch_bytes > budget)
+                    return;  // byte budget exhausted
+                TileID id(*file, 0, 0, x, y, z, 0, spec.nchannels);
+                if (tile_in_cache(id, thread_info))
+                    continue;
+                ImageCacheTileRef tile = new ImageCacheTile(id);
+                m_seq_prefetch_bytes += (long long)tile->memsize();
+                // Insertion failure just means another thread beat us to
+                // this tile, which is fine.
+                (void)add_tile_to_cache(tile, thread_info);
+            }
+        }
+    }
+}
+
+
+
+void
+ImageCacheImpl::cancel_sequence_prefetch()
+{
+    // Tasks check the epoch before each tile read and exit when it no
+    // longer matches the one they were launched with.
+    ++m_seq_prefetch_epoch;
+}
+
+
+
 void
 ImageCacheImpl::close(ustring filename)
 {
@@ -3760,6 +5311,29 @@ ImageCacheImpl::resolve_udim(ImageCacheFile* udimfile, Perthread* thread_info,
     OIIO_DASSERT(index >= 0 && size_t(index) < udimfile->m_udim_lookup.size());
     UdimInfo& udiminfo(udimfile->m_udim_lookup[index]);
 
+    // On the first touch of any tile of this udim set, optionally fan the
+    // resolution and header parsing of ALL its populated tiles out across
+    // the thread pool, so the remaining 899 opens don't happen serially
+    // as shading first brushes against each one.
+    if (m_udim_preresolve && !udimfile->m_udim_preresolved.exchange(1)) {
+        thread_pool* pool = default_thread_pool();
+        for (UdimInfo& info : udimfile->m_udim_lookup) {
+            if (info.filename.empty() || info.icfile.load())
+                continue;
+            ustring fname   = info.filename;
+            UdimInfo* infop = &info;
+            ++m_outstanding_prefetches;
+            pool->push([this, fname, infop](int) {
+                ImageCachePerThreadInfo* ti = get_perthread_info();
+                ImageCacheFile* f           = find_file(fname, ti);
+                f                           = verify_file(f, ti, true);
+                if (f && !f->broken())
+                    infop->icfile = f;
+                --m_outstanding_prefetches;
+            });
+        }
+    }
+
     // An empty filename in the record means that tile is not populated.
     if (udiminfo.filename.empty())
         return nullptr;
@@ -3802,7 +5376,7 @@ ImageCacheImpl::create_thread_info()
 {
     ImageCachePerThreadInfo* p = new ImageCachePerThreadInfo;
     // printf ("New perthread %p\n", (void *)p);
-    spin_lock lock(m_perthread_info_mutex);
+    adaptive_lock lock(m_perthread_info_mutex);
     m_all_perthread_info.emplace_back(p);
     return p;
 }
@@ -3817,7 +5391,7 @@ ImageCacheImpl::destroy_thread_info(ImageCachePerThreadInfo* thread_info)
     // the ImageCache owns the thread_infos associated with it,
     // so all we need to do is find the entry and reset the unique pointer
     // to fully destroy the object
-    spin_lock lock(m_perthread_info_mutex);
+    adaptive_lock lock(m_perthread_info_mutex);
     for (auto& p : m_all_perthread_info) {
         if (p.get() == thread_info) {
             p.reset();
@@ -3840,15 +5414,16 @@ ImageCacheImpl::get_perthread_info(ImageCachePerThreadInfo* p)
             // this thread doesn't have a ImageCachePerThreadInfo for this ImageCacheImpl yet
             ptr = p = new ImageCachePerThreadInfo;
             // printf ("New perthread %p\n", (void *)p);
-            spin_lock lock(m_perthread_info_mutex);
+            adaptive_lock lock(m_perthread_info_mutex);
             m_all_perthread_info.emplace_back(p);
         }
     }
     if (p->purge) {  // has somebody requested a tile purge?
         // This is safe, because it's our thread.
-        spin_lock lock(m_perthread_info_mutex);
+        adaptive_lock lock(m_perthread_info_mutex);
         p->tile     = NULL;
         p->lasttile = NULL;
+        p->microcache_clear();
         p->purge    = 0;
         p->m_thread_files.clear();
     }
@@ -3859,7 +5434,7 @@ void
 ImageCacheImpl::purge_perthread_microcaches()
 {
     // Mark the per-thread microcaches as invalid
-    spin_lock lock(m_perthread_info_mutex);
+    adaptive_lock lock(m_perthread_info_mutex);
     for (size_t i = 0, e = m_all_perthread_info.size(); i < e; ++i)
         if (m_all_perthread_info[i])
             m_all_perthread_info[i]->purge = 1;
@@ -0,0 +1,286 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+
+/// \file
+/// Persistent node-local disk tile cache used by ImageCacheImpl.  See
+/// the DiskTileCache class comment in imagecache_pvt.h for the design.
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include <OpenImageIO/hash.h>
+#include <OpenImageIO/imagecache.h>
+
+#include "imagecache_pvt.h"
+
+
+OIIO_NAMESPACE_BEGIN
+
+namespace pvt {
+
+namespace {
+
+// Bumping this invalidates cache files written by older builds.
+static const uint64_t disk_magic = 0x4f49494f44736b31ULL;  // "OIIODsk1"
+
+// Payload offsets are rounded up to this, so a generation's allocations
+// never share a device block with their neighbors.
+static const uint64_t disk_payload_align = 64;
+
+// Index capacity: one slot per this many payload bytes.  With typical
+// 64x64 half-float RGBA tiles (~64 KB) the index ends up generously
+// over-provisioned, which keeps the open-addressed probe chains short.
+static const uint64_t disk_bytes_per_slot = 32 * 1024;
+
+}  // anonymous namespace
+
+
+struct DiskTileCache::Header {
+    std::atomic<uint64_t> magic;       // disk_magic once initialized
+    uint64_t nslots;                   // number of index slots
+    uint64_t data_start;               // file offset of the payload region
+    uint64_t data_capacity;            // payload region size, bytes
+    std::atomic<uint64_t> generation;  // bumped when the payload recycles
+    std::atomic<uint64_t> data_used;   // payload append cursor, bytes
+};
+
+
+struct DiskTileCache::SlotHeader {
+    // Seqlock: even = stable, odd = write in progress.  Readers copy the
+    // metadata, pread the payload, and then re-check the sequence.
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> key;
+    uint64_t offset;   // payload offset within the data region
+    uint32_t size;     // payload bytes
+    uint32_t gen;      // payload generation when written
+    uint64_t pad[2];   // round the slot up to a cache line
+};
+
+
+
+uint64_t
+DiskTileCache::key(const TileID& id)
+{
+    // The key must be stable across processes and across restarts, so
+    // hash the filename characters and tile coordinates, never in-process
+    // pointers.  The file's modification time is folded in too, so a
+    // texture republished in place never matches its stale cached tiles.
+    uint64_t h[8] = { id.file().filename().hash(),
+                      (uint64_t)(uint32_t)id.x() | ((uint64_t)(uint32_t)id.y() << 32),
+                      (uint64_t)(uint32_t)id.z(),
+                      (uint64_t)(uint32_t)id.subimage()
+                          | ((uint64_t)(uint32_t)id.miplevel() << 32),
+                      (uint64_t)(uint32_t)id.chbegin()
+                          | ((uint64_t)(uint32_t)id.chend() << 32),
+                      (uint64_t)(uint32_t)id.colortransformid(),
+                      (uint64_t)id.file().mod_time(),
+                      0 };
+    return fasthash::fasthash64(h, sizeof(h), disk_magic);
+}
+
+
+
+DiskTileCache::SlotHeader*
+DiskTileCache::slot(uint64_t key) const
+{
+    char* base = (char*)m_index + 64;  // header occupies the first line
+    return (SlotHeader*)(base + (key % m_nslots) * sizeof(SlotHeader));
+}
+
+
+
+DiskTileCache::DiskTileCache(string_view filename, size_t bytes)
+{
+#ifdef _WIN32
+    // Windows file mappings are not yet implemented for this tier.
+    (void)filename;
+    (void)bytes;
+#else
+    if (filename.empty() || bytes < 4 * 1024 * 1024)
+        return;
+    std::string name(filename);
+    int fd = ::open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+        return;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0) {
+        ::close(fd);
+        return;
+    }
+    uint64_t nslots     = std::max(uint64_t(1024),
+                                   uint64_t(bytes) / disk_bytes_per_slot);
+    uint64_t index_bytes = 64 + nslots * sizeof(SlotHeader);
+    if (index_bytes + disk_payload_align >= bytes) {
+        ::close(fd);
+        return;
+    }
+    if ((size_t)sb.st_size < bytes && ftruncate(fd, (off_t)bytes) != 0) {
+        ::close(fd);
+        return;
+    }
+    // Peek at the header first: if we're attaching to an existing cache
+    // file, its recorded geometry governs, not the requested size.
+    Header probe;
+    memset(&probe, 0, sizeof(probe));
+    if ((size_t)sb.st_size >= sizeof(Header))
+        (void)!::pread(fd, &probe, sizeof(probe), 0);
+    bool attach = (probe.magic.load() == disk_magic);
+    if (attach) {
+        nslots      = probe.nslots;
+        index_bytes = 64 + nslots * sizeof(SlotHeader);
+        if (nslots == 0
+            || probe.data_start + probe.data_capacity > (uint64_t)sb.st_size) {
+            ::close(fd);
+            return;  // corrupt or truncated; leave it alone
+        }
+    }
+    void* addr = ::mmap(nullptr, index_bytes, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        ::close(fd);
+        return;
+    }
+
+    Header* h         = (Header*)addr;
+    uint64_t expected = 0;
+    if (h->magic.compare_exchange_strong(expected, 1)) {
+        // We won the right to initialize the fresh file.  The slot array
+        // is already zero-filled by ftruncate.
+        h->nslots        = nslots;
+        h->data_start    = index_bytes;
+        h->data_capacity = bytes - index_bytes;
+        h->generation.store(1);
+        h->data_used.store(0);
+        h->magic.store(disk_magic, std::memory_order_release);
+    } else {
+        // Somebody else created it (or it persists from an earlier run);
+        // wait until initialized, then verify the layout.
+        while (h->magic.load(std::memory_order_acquire) == 1)
+            ;
+        if (h->magic.load() != disk_magic || h->nslots != nslots) {
+            ::munmap(addr, index_bytes);
+            ::close(fd);
+            return;
+        }
+    }
+    m_fd            = fd;
+    m_index         = addr;
+    m_index_bytes   = index_bytes;
+    m_nslots        = h->nslots;
+    m_data_start    = h->data_start;
+    m_data_capacity = h->data_capacity;
+#endif
+}
+
+
+
+DiskTileCache::~DiskTileCache()
+{
+#ifndef _WIN32
+    if (m_index)
+        ::munmap(m_index, m_index_bytes);
+    if (m_fd >= 0)
+        ::close(m_fd);
+    // N.B. The cache file itself is deliberately NOT unlinked -- its
+    // whole point is to outlive this process.
+#endif
+}
+
+
+
+bool
+DiskTileCache::retrieve(const TileID& id, void* pixels, size_t size)
+{
+#ifndef _WIN32
+    if (!valid() || size == 0)
+        return false;
+    uint64_t k    = key(id);
+    SlotHeader* s = slot(k);
+    uint64_t seq0 = s->seq.load(std::memory_order_acquire);
+    if (seq0 & 1)
+        return false;  // write in progress
+    if (s->key.load(std::memory_order_relaxed) != k || s->size != size)
+        return false;
+    uint64_t off = s->offset;
+    uint32_t gen = s->gen;
+    if (off + size > m_data_capacity
+        || gen != (uint32_t)header()->generation.load(std::memory_order_acquire))
+        return false;  // recycled since this entry was written
+    if (::pread(m_fd, pixels, size, (off_t)(m_data_start + off))
+        != (ssize_t)size)
+        return false;
+    // Within a generation, payload regions are disjoint and never
+    // rewritten, so the copy is intact unless a recycle (generation
+    // bump) or a slot reuse raced the pread.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return s->seq.load(std::memory_order_relaxed) == seq0
+           && (uint32_t)header()->generation.load() == gen;
+#else
+    (void)id;
+    (void)pixels;
+    (void)size;
+    return false;
+#endif
+}
+
+
+
+void
+DiskTileCache::store(const TileID& id, const void* pixels, size_t size)
+{
+#ifndef _WIN32
+    if (!valid() || size == 0 || size > m_data_capacity / 2)
+        return;
+    Header* h     = header();
+    uint64_t need = (size + disk_payload_align - 1) & ~(disk_payload_align - 1);
+    uint64_t gen  = h->generation.load(std::memory_order_acquire);
+    uint64_t off  = h->data_used.fetch_add(need);
+    if (off + need > m_data_capacity) {
+        // The payload region is full.  Whoever wins this CAS recycles it
+        // wholesale: bump the generation (instantly invalidating every
+        // index entry), then start appending from the beginning.  Losers
+        // just drop their stores -- this is best-effort persistence.
+        uint64_t expected = off + need;
+        if (!h->data_used.compare_exchange_strong(expected, need))
+            return;
+        gen = h->generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+        off = 0;
+    }
+    if (::pwrite(m_fd, pixels, size, (off_t)(m_data_start + off))
+        != (ssize_t)size)
+        return;
+    uint64_t k    = key(id);
+    SlotHeader* s = slot(k);
+    uint64_t seq0 = s->seq.load(std::memory_order_relaxed);
+    if (seq0 & 1)
+        return;  // another writer owns the slot; just skip
+    if (!s->seq.compare_exchange_strong(seq0, seq0 + 1,
+                                        std::memory_order_acq_rel))
+        return;
+    s->key.store(k, std::memory_order_relaxed);
+    s->offset = off;
+    s->size   = (uint32_t)size;
+    s->gen    = (uint32_t)gen;
+    s->seq.store(seq0 + 2, std::memory_order_release);
+#else
+    (void)id;
+    (void)pixels;
+    (void)size;
+#endif
+}
+
+
+}  // end namespace pvt
+
+OIIO_NAMESPACE_END
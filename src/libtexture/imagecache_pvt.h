@@ -10,10 +10,13 @@
 #ifndef OPENIMAGEIO_IMAGECACHE_PVT_H
 #define OPENIMAGEIO_IMAGECACHE_PVT_H
 
+#include <chrono>
+
 #include <tsl/robin_map.h>
 
 #include <OpenImageIO/Imath.h>
 #include <OpenImageIO/export.h>
+#include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/hash.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/refcnt.h>
@@ -21,6 +24,8 @@
 #include <OpenImageIO/timer.h>
 #include <OpenImageIO/unordered_map_concurrent.h>
 
+#include "imageio_pvt.h"
+
 
 OIIO_NAMESPACE_BEGIN
 
@@ -40,6 +45,7 @@ namespace pvt {
 #define TILE_CACHE_SHARDS 128
 
 struct TileID;
+class ImageCacheFile;
 class ImageCacheImpl;
 class ImageCachePerThreadInfo;
 
@@ -164,15 +170,15 @@ public:
     }
     const ImageSpec& spec(int subimage, int miplevel) const
     {
-        return levelinfo(subimage, miplevel).spec;
+        return levelinfo(subimage, miplevel).spec();
     }
     ImageSpec& spec(int subimage, int miplevel)
     {
-        return levelinfo(subimage, miplevel).spec;
+        return levelinfo(subimage, miplevel).spec();
     }
     const ImageSpec& nativespec(int subimage, int miplevel) const
     {
-        return levelinfo(subimage, miplevel).nativespec;
+        return levelinfo(subimage, miplevel).nativespec();
     }
     ustring filename(void) const { return m_filename; }
     ustring fileformat(void) const { return m_fileformat; }
@@ -240,6 +246,12 @@ public:
 
     std::time_t mod_time() const { return m_mod_time; }
     ustring fingerprint() const { return m_fingerprint; }
+
+    /// Invalidation generation of this file.  Lazy invalidation bumps
+    /// the counter; tiles read under an older generation are rejected at
+    /// lookup time and evicted eagerly by the sweeps.
+    int generation() const { return m_generation; }
+    void bump_generation() { ++m_generation; }
     void duplicate(ImageCacheFile* dup) { m_duplicate = dup; }
     ImageCacheFile* duplicate() const { return m_duplicate; }
 
@@ -250,8 +262,12 @@ public:
     /// Info for each MIP level that isn't in the ImageSpec, or that we
     /// precompute.
     struct LevelInfo {
-        ImageSpec spec;         ///< ImageSpec for the mip level
-        ImageSpec nativespec;   ///< Native ImageSpec for the mip level
+        // The specs are heavyweight (channel names, metadata), so levels
+        // hold them by shared pointer: copying a LevelInfo (e.g. when the
+        // levels vector grows) bumps refcounts instead of deep-copying.
+        // m_nativespec aliases m_spec when the two are identical.
+        std::shared_ptr<ImageSpec> m_spec;        ///< ImageSpec for the level
+        std::shared_ptr<ImageSpec> m_nativespec;  ///< Native ImageSpec
         bool full_pixel_range;  ///< pixel data window matches image window
         bool onetile;           ///< Whole level fits on one tile
         mutable bool polecolorcomputed;        ///< Pole color was computed
@@ -262,6 +278,9 @@ public:
                   const ImageSpec& nativespec);  ///< Initialize based on spec
         LevelInfo(const LevelInfo& src);         // needed for vector<LevelInfo>
         ~LevelInfo() { delete[] tiles_read; }
+        ImageSpec& spec() { return *m_spec; }
+        const ImageSpec& spec() const { return *m_spec; }
+        const ImageSpec& nativespec() const { return *m_nativespec; }
     };
 
     /// Info for each subimage
@@ -293,12 +312,12 @@ public:
 
         SubimageInfo() {}
         void init(ImageCacheFile& icfile, const ImageSpec& spec,
-                  bool forcefloat);
-        ImageSpec& spec(int m) { return levels[m].spec; }
-        const ImageSpec& spec(int m) const { return levels[m].spec; }
+                  bool forcefloat, bool storehalf);
+        ImageSpec& spec(int m) { return levels[m].spec(); }
+        const ImageSpec& spec(int m) const { return levels[m].spec(); }
         const ImageSpec& nativespec(int m) const
         {
-            return levels[m].nativespec;
+            return levels[m].nativespec();
         }
         int miplevels() const { return (int)levels.size(); }
     };
@@ -405,8 +424,18 @@ private:
     imagesize_t m_total_imagesize_ondisk;  ///< Total size, compressed on disk
     ImageInput::Creator m_inputcreator;    ///< Custom ImageInput-creator
     std::unique_ptr<ImageSpec> m_configspec;  // Optional configuration hints
+    // When the cache's "mmap_files" mode is active, the raw file contents
+    // are memory-mapped and the ImageInput reads through an IOMemReader
+    // over the mapping, so tile reads cost page faults rather than read
+    // syscalls. The mapping outlives close() -- it holds no descriptor --
+    // and is torn down only on invalidate or destruction.
+    std::unique_ptr<Filesystem::IOMemReader> m_mmap_reader;
+    void* m_mmap_addr  = nullptr;  ///< Mapped file contents, if mapped
+    size_t m_mmap_size = 0;        ///< Size of the mapping
     std::vector<UdimInfo> m_udim_lookup;      ///< Used for decoding udim tiles
                                               /// protected by mutex elsewhere!
+    atomic_int m_udim_preresolved { 0 };  ///< Bulk udim warm-up already run?
+    atomic_int m_generation { 0 };        ///< Invalidation generation counter
 
     // Thread-safe retrieve a shared pointer to the ImageInput (which may
     // not currently be open). The one returned is safe to use as long as
@@ -425,6 +454,16 @@ private:
     /// requires no external lock.
     std::shared_ptr<ImageInput> open(ImageCachePerThreadInfo* thread_info);
 
+    /// Try to memory-map the file's raw contents, creating an IOMemReader
+    /// over the mapping for the ImageInput to read through.  Returns true
+    /// if the mapping is in place (including if it already was). Always
+    /// returns false on platforms without mmap support.
+    bool open_mmap();
+
+    /// Unmap the file contents and destroy the associated IOMemReader,
+    /// if present.
+    void close_mmap();
+
     /// Release the ImageInput, if currently open. It will close and destroy
     /// when the last thread holding it is done with its shared ptr. This
     /// is thread-safe, no need to hold a lock to call it. It will close the
@@ -466,10 +505,18 @@ private:
 typedef intrusive_ptr<ImageCacheFile> ImageCacheFileRef;
 
 
-/// Map file names to file references
-typedef unordered_map_concurrent<ustring, ImageCacheFileRef, std::hash<ustring>,
-                                 std::equal_to<ustring>, FILE_CACHE_SHARDS,
-                                 tsl::robin_map<ustring, ImageCacheFileRef>>
+/// Map file names to file references. The robin_map bins store each key's
+/// hash inline in the bucket array (StoreHash=true), so probing during an
+/// open storm compares cached hashes within one or two cache lines instead
+/// of dereferencing every candidate ustring's rep.
+typedef unordered_map_concurrent<
+    ustring, ImageCacheFileRef, std::hash<ustring>, std::equal_to<ustring>,
+    FILE_CACHE_SHARDS,
+    tsl::robin_map<ustring, ImageCacheFileRef, std::hash<ustring>,
+                   std::equal_to<ustring>,
+                   std::allocator<std::pair<ustring, ImageCacheFileRef>>,
+                   true /*StoreHash*/>,
+    adaptive_rw_mutex>
     FilenameMap;
 typedef tsl::robin_map<ustring, ImageCacheFileRef> FingerprintMap;
 
@@ -660,6 +707,11 @@ public:
     ///
     size_t memsize_needed() const;
 
+    /// Allocate/free tile shells through a recycling pool rather than the
+    /// global allocator, to take malloc out of the cache miss path.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+
     /// Mark the tile as recently used.
     ///
     void use() { m_used = 1; }
@@ -693,6 +745,22 @@ public:
     int channelsize() const { return m_channelsize; }
     int pixelsize() const { return m_pixelsize; }
 
+    /// Wall-clock seconds it took to read this tile from its file (0 if
+    /// the pixels were supplied rather than read).  Used by the
+    /// cost-aware eviction policy to judge how painful a re-read would be.
+    float readtime() const { return m_readtime; }
+    void set_readtime(double t) { m_readtime = float(t); }
+
+    /// One-shot "spared from eviction" flag, touched only by the (single)
+    /// sweeping thread in check_max_mem.
+    bool evict_spared() const { return m_spared; }
+    void spare_once() { m_spared = true; }
+
+    /// Was the file invalidated (its generation bumped) after this tile
+    /// was read?  Stale tiles are dropped at lookup time and evicted
+    /// preferentially by the memory sweep.
+    bool stale() const { return m_file_generation != file().generation(); }
+
     // 1D index of the 2D tile coordinate. 64 bit safe.
     imagesize_t pixel_index(int tile_s, int tile_t) const
     {
@@ -707,14 +775,23 @@ public:
     }
 
 private:
+    // Allocate m_pixels to hold `size` bytes, honoring the cache's
+    // device_memory preference (and setting m_devmem to match where the
+    // memory actually came from). Returns the allocation.
+    char* alloc_pixels(size_t size);
+
     TileID m_id;                       ///< ID of this tile
     std::unique_ptr<char[]> m_pixels;  ///< The pixel data
     size_t m_pixels_size { 0 };        ///< How much m_pixels has allocated
     int m_channelsize { 0 };           ///< How big is each channel (bytes)
     int m_pixelsize { 0 };             ///< How big is each pixel (bytes)
     int m_tile_width { 0 };            ///< Tile width
+    float m_readtime { 0 };            ///< Seconds it took to read (0=n/a)
     bool m_valid { false };            ///< Valid pixels
     bool m_nofree { false };  ///< We do NOT own the pixels, do not free!
+    bool m_devmem { false };  ///< Pixels are compute-device unified memory
+    bool m_spared { false };  ///< Already spared once by cost-aware evict
+    int m_file_generation { 0 };  ///< File's generation when tile was read
     volatile bool m_pixels_ready {
         false
     };                        ///< The pixels have been read from disk
@@ -730,13 +807,143 @@ typedef intrusive_ptr<ImageCacheTile> ImageCacheTileRef;
 
 
 /// Hash table that maps TileID to ImageCacheTileRef -- this is the type of the
-/// main tile cache.
+/// main tile cache. StoreHash=true keeps each entry's hash inline in the
+/// bucket array, so a probe rejects non-matching slots on the cached hash
+/// rather than rehashing or comparing whole TileIDs.
 typedef unordered_map_concurrent<
     TileID, ImageCacheTileRef, TileID::Hasher, std::equal_to<TileID>,
-    TILE_CACHE_SHARDS, tsl::robin_map<TileID, ImageCacheTileRef, TileID::Hasher>>
+    TILE_CACHE_SHARDS,
+    tsl::robin_map<TileID, ImageCacheTileRef, TileID::Hasher,
+                   std::equal_to<TileID>,
+                   std::allocator<std::pair<TileID, ImageCacheTileRef>>,
+                   true /*StoreHash*/>,
+    adaptive_rw_mutex>
     TileCache;
 
 
+/// A tile that has been evicted from the primary cache, holding its
+/// pixels in zlib-compressed form.  Rehydrating one of these is far
+/// cheaper than re-reading and re-decoding the tile from disk, so they
+/// form an optional second cache tier with its own memory budget.
+class CompressedTile final : public RefCnt {
+public:
+    CompressedTile(const TileID& id)
+        : m_id(id)
+    {
+    }
+    const TileID& id(void) const { return m_id; }
+
+    TileID m_id;                      ///< ID of the tile
+    std::unique_ptr<char[]> m_cdata;  ///< Compressed pixel data
+    uint32_t m_csize = 0;             ///< Compressed size, bytes
+    uint32_t m_usize = 0;             ///< Uncompressed size, bytes
+    int m_generation = 0;             ///< File generation when stashed
+    atomic_int m_used { 1 };          ///< Used recently (clock algorithm)
+};
+
+
+/// Reference-counted pointer to a CompressedTile
+typedef intrusive_ptr<CompressedTile> CompressedTileRef;
+
+
+/// Hash table for the second-tier cache of compressed evicted tiles.
+typedef unordered_map_concurrent<
+    TileID, CompressedTileRef, TileID::Hasher, std::equal_to<TileID>,
+    TILE_CACHE_SHARDS,
+    tsl::robin_map<TileID, CompressedTileRef, TileID::Hasher,
+                   std::equal_to<TileID>,
+                   std::allocator<std::pair<TileID, CompressedTileRef>>,
+                   true /*StoreHash*/>,
+    adaptive_rw_mutex>
+    CompressedTileCache;
+
+
+
+/// Node-local cross-process cache of decoded tiles, living in a named
+/// shared-memory segment so that multiple processes reading the same
+/// textures share one decode.  The table is a direct-mapped array of
+/// fixed-capacity slots guarded by per-slot seqlocks; tiles are keyed by
+/// a hash of the filename and tile coordinates (never by process-local
+/// pointers).  Lookups copy pixels out of the segment; misses and
+/// oversized tiles simply fall through to the normal read path.
+class ShmTileCache {
+public:
+    /// Attach to (creating if necessary) the named segment of the given
+    /// total size.  Check valid() afterward.
+    ShmTileCache(string_view name, size_t bytes);
+    ~ShmTileCache();
+
+    /// Is the segment mapped and usable?
+    bool valid() const { return m_addr != nullptr; }
+
+    /// Maximum tile size (bytes) a slot can hold.
+    static constexpr size_t slot_payload = 256 * 1024;
+
+    /// If the shared cache holds the tile, copy its pixels (exactly
+    /// 'size' bytes) into 'pixels' and return true.
+    bool retrieve(const TileID& id, void* pixels, size_t size);
+
+    /// Publish the tile's pixels to the shared cache (no-op if the tile
+    /// exceeds the slot capacity or the slot is being written).
+    void store(const TileID& id, const void* pixels, size_t size);
+
+private:
+    struct SlotHeader;
+    static uint64_t key(const TileID& id);
+    SlotHeader* slot(uint64_t key) const;
+
+    void* m_addr    = nullptr;  ///< Mapped segment (nullptr if invalid)
+    size_t m_bytes  = 0;        ///< Total mapped size
+    uint64_t m_nslots = 0;      ///< Number of tile slots
+};
+
+
+
+/// Persistent node-local tile cache for farms whose textures live on a
+/// filer but whose nodes have fast local scratch (NVMe).  Decoded tiles
+/// are appended to the payload region of a single cache file, keyed by a
+/// hash of the filename, its modification time, and the tile coordinates;
+/// a memory-mapped open-addressed index probed under per-slot seqlocks
+/// makes lookups lock-light, cross-process safe, and -- because it all
+/// lives in a file -- persistent across process restarts.  When the
+/// payload region fills, the whole file is recycled wholesale by bumping
+/// a generation counter that instantly invalidates every index entry.
+/// Everything is best-effort: any mismatch, race, or I/O failure simply
+/// falls through to the normal read path.
+class DiskTileCache {
+public:
+    /// Open the cache file, creating and sizing it to 'bytes' total if it
+    /// does not already exist.  Check valid() afterward.
+    DiskTileCache(string_view filename, size_t bytes);
+    ~DiskTileCache();
+
+    /// Is the cache file open and its index mapped?
+    bool valid() const { return m_index != nullptr; }
+
+    /// If the disk cache holds the tile, copy its pixels (exactly 'size'
+    /// bytes) into 'pixels' and return true.
+    bool retrieve(const TileID& id, void* pixels, size_t size);
+
+    /// Persist the tile's pixels to the cache file (best effort).
+    void store(const TileID& id, const void* pixels, size_t size);
+
+private:
+    struct Header;
+    struct SlotHeader;
+    static uint64_t key(const TileID& id);
+    SlotHeader* slot(uint64_t key) const;
+    Header* header() const { return (Header*)m_index; }
+
+    int m_fd             = -1;       ///< Cache file (payload pread/pwrite)
+    void* m_index        = nullptr;  ///< Mapped header + slot array
+    size_t m_index_bytes = 0;        ///< Mapped size, bytes
+    uint64_t m_nslots    = 0;        ///< Number of index slots
+    uint64_t m_data_start    = 0;    ///< File offset of the payload region
+    uint64_t m_data_capacity = 0;    ///< Payload region size, bytes
+};
+
+
+
 /// A very small amount of per-thread data that saves us from locking
 /// the mutex quite as often.  We store things here used by both
 /// ImageCache and TextureSystem, so they don't each need a costly
@@ -756,6 +963,61 @@ public:
     atomic_int purge;  // If set, tile ptrs need purging!
     ImageCacheStatistics m_stats;
 
+    // A wider N-way set-associative tile microcache, consulted after the
+    // two-entry tile/lasttile pair but before the shared tile cache, so
+    // that mostly-coherent access patterns don't pay the shared-map hash
+    // probe and shard lock on every lookup.  Sized (total entries) by the
+    // "microcache_tiles" attribute; 0 disables it.  Entries pin their
+    // tiles' memory until replaced or purged, which is why it is opt-in.
+    static constexpr int microcache_assoc = 4;
+    std::vector<ImageCacheTileRef> m_microcache;
+    size_t m_microcache_sets         = 0;  // Number of sets (power of 2)
+    unsigned int m_microcache_victim = 0;  // Round-robin replacement
+
+    // Look up the tile in the set-associative microcache, returning a
+    // pointer to its entry, or nullptr if absent (or cache disabled).
+    ImageCacheTileRef* microcache_find(const TileID& id)
+    {
+        if (!m_microcache_sets)
+            return nullptr;
+        size_t set = id.hash() & (m_microcache_sets - 1);
+        ImageCacheTileRef* entry = &m_microcache[set * microcache_assoc];
+        for (int i = 0; i < microcache_assoc; ++i)
+            if (entry[i] && entry[i]->id() == id)
+                return &entry[i];
+        return nullptr;
+    }
+
+    // Remember the tile in the set-associative microcache, (re)sizing the
+    // table if the configured total number of entries has changed.
+    void microcache_insert(const ImageCacheTileRef& t, int totalentries)
+    {
+        size_t sets = totalentries > 0 ? size_t(totalentries) / microcache_assoc
+                                       : 0;
+        while (sets & (sets - 1))  // round down to a power of 2
+            sets &= sets - 1;
+        if (sets != m_microcache_sets) {
+            m_microcache_sets = sets;
+            m_microcache.assign(sets * microcache_assoc, ImageCacheTileRef());
+        }
+        if (!m_microcache_sets)
+            return;
+        size_t set = t->id().hash() & (m_microcache_sets - 1);
+        ImageCacheTileRef* entry = &m_microcache[set * microcache_assoc];
+        for (int i = 0; i < microcache_assoc; ++i)
+            if (!entry[i]) {
+                entry[i] = t;
+                return;
+            }
+        entry[m_microcache_victim++ % microcache_assoc] = t;
+    }
+
+    // Drop all set-associative microcache entries (but keep the table).
+    void microcache_clear()
+    {
+        m_microcache.assign(m_microcache.size(), ImageCacheTileRef());
+    }
+
     ImageCachePerThreadInfo()
     {
         // std::cout << "Creating PerThreadInfo " << (void*)this << "\n";
@@ -814,8 +1076,14 @@ public:
         return attribute(name, TypeDesc::STRING, &s);
     }
 
+    void begin_attribute_transaction() override;
+    void commit_attribute_transaction() override;
+
     TypeDesc getattributetype(string_view name) const override;
 
+    int getattributes(cspan<string_view> names,
+                      ParamValueList& vals) const override;
+
     bool getattribute(string_view name, TypeDesc type,
                       void* val) const override;
     bool getattribute(string_view name, int& val) const override
@@ -853,13 +1121,23 @@ public:
     const std::string& searchpath() const { return m_searchpath; }
     const std::string& plugin_searchpath() const { return m_plugin_searchpath; }
     int autotile() const { return m_autotile; }
+    int volume_bricksize() const { return m_volume_bricksize; }
     bool autoscanline() const { return m_autoscanline; }
+    bool tile_prefetch() const { return m_tile_prefetch; }
+    bool mmap_files() const { return m_mmap_files; }
     bool automip() const { return m_automip; }
     bool forcefloat() const { return m_forcefloat; }
+    bool storehalf() const { return m_storehalf; }
     bool accept_untiled() const { return m_accept_untiled; }
     bool accept_unmipped() const { return m_accept_unmipped; }
     bool unassociatedalpha() const { return m_unassociatedalpha; }
     bool trust_file_extensions() const { return m_trust_file_extensions; }
+    bool use_sidecar() const { return m_use_sidecar; }
+    bool device_memory() const
+    {
+        return m_device_memory
+               && pvt::compute_device() != pvt::ComputeDevice::CPU;
+    }
     int failure_retries() const { return m_failure_retries; }
     bool latlong_y_up_default() const { return m_latlong_y_up_default; }
     void get_commontoworld(Imath::M44f& result) const { result = m_Mc2w; }
@@ -986,9 +1264,11 @@ public:
     }
 
     /// Add the tile to the cache.  This will also enforce cache memory
-    /// limits.
+    /// limits.  If `replace` is true and the cache already holds a tile
+    /// with this ID, the new tile supplants it rather than deferring to it.
     OIIO_NODISCARD bool add_tile_to_cache(ImageCacheTileRef& tile,
-                                          ImageCachePerThreadInfo* thread_info);
+                                          ImageCachePerThreadInfo* thread_info,
+                                          bool replace = false);
 
     /// Find the tile specified by id.  If found, return true and place
     /// the tile ref in thread_info->tile; if not found, return false.
@@ -1018,8 +1298,19 @@ public:
                 return true;
             }
         }
-        return find_tile_main_cache(id, tile, thread_info);
+        // Next, consult the per-thread set-associative microcache, which
+        // can absorb semi-coherent repeat lookups without ever touching
+        // the shared tile map.
+        if (ImageCacheTileRef* mc = thread_info->microcache_find(id)) {
+            tile = *mc;
+            tile->use();
+            return true;
+        }
+        bool ok = find_tile_main_cache(id, tile, thread_info);
         // N.B. find_tile_main_cache marks the tile as used
+        if (ok && m_microcache_tiles)
+            thread_info->microcache_insert(tile, m_microcache_tiles);
+        return ok;
     }
 
     Tile* get_tile(ustring filename, int subimage, int miplevel, int x, int y,
@@ -1036,7 +1327,7 @@ public:
     bool add_tile(ustring filename, int subimage, int miplevel, int x, int y,
                   int z, int chbegin, int chend, TypeDesc format,
                   const void* buffer, stride_t xstride, stride_t ystride,
-                  stride_t zstride, bool copy) override;
+                  stride_t zstride, bool copy, bool replace) override;
 
     /// Return the numerical subimage index for the given subimage name,
     /// as stored in the "oiio:subimagename" metadata.  Return -1 if no
@@ -1049,8 +1340,13 @@ public:
     void reset_stats() override;
     void invalidate(ustring filename, bool force) override;
     void invalidate(ImageHandle* file, bool force) override;
+    void invalidate(ustring filename, int subimage, ROI roi) override;
     void invalidate_all(bool force = false) override;
     void close(ustring filename) override;
+    int preopen(const std::vector<ustring>& filenames) override;
+    void prefetch_sequence(string_view pattern, int firstframe, int nframes,
+                           int stride = 1, long long bytebudget = 0) override;
+    void cancel_sequence_prefetch() override;
     void close_all() override;
 
     /// Merge all the per-thread statistics into one set of stats.
@@ -1078,11 +1374,16 @@ public:
         ++m_stat_tiles_created;
         atomic_max(m_stat_tiles_peak, ++m_stat_tiles_current);
         m_mem_used += size;
+        pvt::IC_tile_mem_current += size;
     }
 
     /// Called when a tile's pixel memory is allocated, but a new tile
     /// is not created.
-    void incr_mem(size_t size) { m_mem_used += size; }
+    void incr_mem(size_t size)
+    {
+        m_mem_used += size;
+        pvt::IC_tile_mem_current += size;
+    }
 
     /// Called when a tile is destroyed, to update all the stats.
     ///
@@ -1090,6 +1391,7 @@ public:
     {
         --m_stat_tiles_current;
         m_mem_used -= size;
+        pvt::IC_tile_mem_current -= size;
         OIIO_DASSERT(m_mem_used >= 0);
     }
 
@@ -1115,6 +1417,20 @@ public:
     /// Enforce the max number of open files.
     void check_max_files(ImageCachePerThreadInfo* thread_info);
 
+    /// The body of the open-file clock sweep: release file handles until
+    /// we're back under the limit.  Expects m_file_sweep_mutex to be held
+    /// upon entry, and releases it before returning.
+    void file_sweep();
+
+    /// Adaptive adjustment of m_max_open_files, called periodically from
+    /// check_max_files when the "max_open_files_auto" attribute is on.
+    void tune_max_open_files();
+
+    /// Called when re-opening a file that previously opened fine fails --
+    /// a strong hint that the process is running short of file
+    /// descriptors (possibly because of other libraries, not us).
+    void note_open_failure() { ++m_open_failures; }
+
     int max_mip_res() const noexcept { return m_max_mip_res; }
 
     ustring colorspace() const noexcept { return m_colorspace; }
@@ -1128,9 +1444,58 @@ private:
     bool find_tile_main_cache(const TileID& id, ImageCacheTileRef& tile,
                               ImageCachePerThreadInfo* thread_info);
 
+    /// For the region of pixels described (already clipped to the pixel
+    /// data window), determine which covering tiles are absent from the
+    /// cache and submit their reads as a batch of concurrent tasks on the
+    /// default thread pool, waiting for all of them to complete.  This is
+    /// the async-I/O emulation used by get_pixels() to keep many tile
+    /// reads in flight at once instead of faulting them one at a time.
+    void batch_read_tiles(ImageCacheFile* file,
+                          ImageCachePerThreadInfo* thread_info, int subimage,
+                          int miplevel, int xbegin, int xend, int ybegin,
+                          int yend, int zbegin, int zend, int chbegin,
+                          int chend);
+
+    /// Speculatively queue reads of the tiles adjacent to 'id' (which just
+    /// missed in the cache) onto the default thread pool, so that coherent
+    /// access patterns find them already resident.  Honored only when the
+    /// "tile_prefetch" attribute is enabled.
+    void prefetch_neighbor_tiles(const TileID& id,
+                                 ImageCachePerThreadInfo* thread_info);
+
+    /// Body of one background sequence-prefetch task: open `filename` and
+    /// pull its subimage-0, miplevel-0 tiles into the cache, bailing out
+    /// if `epoch` no longer matches m_seq_prefetch_epoch (cancellation) or
+    /// if the running byte total passes `budget`.
+    void prefetch_frame_tiles(ustring filename, int epoch, long long budget);
+
+    /// Block until all outstanding speculative tile prefetches have
+    /// completed.  Must be called before invalidating files or tearing
+    /// down the cache, since in-flight prefetch tasks hold raw file
+    /// pointers and TileIDs.
+    void wait_for_prefetches() const;
+
     /// Enforce the max memory for tile data.
     void check_max_mem(ImageCachePerThreadInfo* thread_info);
 
+    /// Is the compressed second-tier tile cache enabled?
+    bool compressed_tier_enabled() const
+    {
+        return m_max_compressed_memory_bytes > 0;
+    }
+
+    /// Compress the pixels of a tile being evicted from the primary cache
+    /// and remember them in the second-tier cache, enforcing its budget.
+    void stash_compressed_tile(const ImageCacheTileRef& tile);
+
+    /// If the second-tier cache holds the tile identified by 'id',
+    /// decompress it into a fresh ready-to-use ImageCacheTile and return
+    /// true; return false if absent or unrecoverable.
+    bool restore_compressed_tile(const TileID& id, ImageCacheTileRef& tile);
+
+    /// Enforce the memory budget of the compressed second tier.
+    void check_max_compressed_mem();
+
     /// Internal statistics printing routine
     ///
     void printstats() const;
@@ -1156,25 +1521,40 @@ private:
 
     uint64_t imagecache_id;
     std::vector<std::unique_ptr<ImageCachePerThreadInfo>> m_all_perthread_info;
-    static spin_mutex m_perthread_info_mutex;  ///< Thread safety for perthread
+    static adaptive_mutex m_perthread_info_mutex;  ///< Thread safety for perthread
     int m_max_open_files;
     atomic_ll m_max_memory_bytes;
     std::string m_searchpath;  ///< Colon-separated image directory list
     std::vector<std::string> m_searchdirs;  ///< Searchpath split into dirs
     std::string m_plugin_searchpath;  ///< Colon-separated plugin directory list
     int m_autotile;            ///< if nonzero, pretend tiles of this size
+    int m_volume_bricksize;    ///< if nonzero, re-brick volume tiles to ~this
     bool m_autoscanline;       ///< autotile using full width tiles
+    bool m_tile_prefetch;      ///< speculatively read neighbor tiles?
+    bool m_async_tile_reads;   ///< batch concurrent tile reads in get_pixels?
+    bool m_mmap_files;         ///< read files through memory mappings?
+    bool m_udim_preresolve;    ///< bulk-resolve udim tiles on first touch?
+    bool m_async_file_close;   ///< sweep over-limit file handles in background?
+    bool m_lazy_invalidate;    ///< O(1) invalidation via generation bumps?
+    int m_microcache_tiles;    ///< size of per-thread tile microcache
     bool m_automip;            ///< auto-mipmap on demand?
     bool m_forcefloat;         ///< force all cache tiles to be float
+    bool m_storehalf;          ///< demote float tiles to half in cache
     bool m_accept_untiled;     ///< Accept untiled images?
     bool m_accept_unmipped;    ///< Accept unmipped images?
     bool m_deduplicate;        ///< Detect duplicate files?
     bool m_unassociatedalpha;  ///< Keep unassociated alpha files as they are?
     bool m_latlong_y_up_default;  ///< Is +y the default "up" for latlong?
     bool m_trust_file_extensions = false;  ///< Assume file extensions don't lie?
+    bool m_use_sidecar = true;  ///< Use maketx sidecar indexes if present?
     bool m_max_open_files_strict = false;  ///< Be strict about open files limit?
+    bool m_max_open_files_auto = false;  ///< Auto-tune the open files limit?
+    bool m_device_memory = false;  ///< Allocate tiles in unified memory?
     int m_failure_retries;                 ///< Times to re-try disk failures
     int m_max_mip_res = 1 << 30;  ///< Don't use MIP levels higher than this
+    int m_attr_transaction_depth = 0;  ///< Open attribute transactions
+    bool m_pending_invalidate = false;  ///< Transaction deferred invalidation
+    bool m_pending_force_invalidate = false;  ///< ...with force=true
     Imath::M44f m_Mw2c;           ///< world-to-"common" matrix
     Imath::M44f m_Mc2w;           ///< common-to-world matrix
     ustring m_substitute_image;   ///< Substitute this image for all others
@@ -1184,6 +1564,13 @@ private:
     mutable FilenameMap m_files;    ///< Map file names to ImageCacheFile's
     ustring m_file_sweep_name;      ///< Sweeper for "clock" paging algorithm
     spin_mutex m_file_sweep_mutex;  ///< Ensure only one in check_max_files
+    atomic_int m_file_sweep_pending;  ///< Background file sweep scheduled?
+
+    // State for adaptive open-file limit tuning (tune_max_open_files)
+    mutable spin_mutex m_autotune_mutex;  ///< One thread tunes at a time
+    long long m_autotune_last_opens = 0;  ///< Opens created at last tuning
+    atomic_int m_open_failures;       ///< Failed re-opens since last tuning
+    std::string m_autotune_trace;     ///< Decision log (guard: autotune mutex)
 
     spin_mutex m_fingerprints_mutex;  ///< Protect m_fingerprints
     FingerprintMap m_fingerprints;    ///< Map fingerprints to files
@@ -1191,8 +1578,29 @@ private:
     TileCache m_tilecache;          ///< Our in-memory tile cache
     TileID m_tile_sweep_id;         ///< Sweeper for "clock" paging algorithm
     spin_mutex m_tile_sweep_mutex;  ///< Ensure only one in check_max_mem
+    bool m_cost_aware_eviction = false;  ///< Weigh reload cost when evicting
+    double m_evict_cost_ema    = 0;      ///< Mean read cost/byte of evictees
+                                         ///  (guarded by m_tile_sweep_mutex)
+
+    std::unique_ptr<ShmTileCache> m_shm_tilecache;  ///< Cross-process pool
+    std::string m_shm_tilecache_name;  ///< Segment name ("" = disabled)
+    long long m_shm_tilecache_bytes;   ///< Segment size when creating
+
+    std::unique_ptr<DiskTileCache> m_disk_tilecache;  ///< Local NVMe tier
+    std::string m_disk_tilecache_path;  ///< Cache file ("" = disabled)
+    long long m_disk_tilecache_bytes;   ///< Cache file size when creating
+
+    CompressedTileCache m_compressed_tilecache;  ///< Evicted-tile spill tier
+    TileID m_comp_sweep_id;         ///< Sweeper for the compressed tier
+    spin_mutex m_comp_sweep_mutex;  ///< One thread in its budget check
+    atomic_ll m_compressed_mem_used;           ///< Bytes in compressed tier
+    atomic_ll m_max_compressed_memory_bytes;   ///< Its budget (0 = disabled)
 
     atomic_ll m_mem_used;       ///< Memory being used for tiles
+    mutable atomic_int m_outstanding_prefetches;  ///< In-flight prefetch tasks
+    atomic_int m_seq_prefetch_epoch;  ///< Bumped to cancel sequence prefetch
+    atomic_ll m_seq_prefetch_bytes;   ///< Bytes queued by current prefetch
+    bool m_trace_events;        ///< Record trace events?
     int m_statslevel;           ///< Statistics level
     int m_max_errors_per_file;  ///< Max errors to print for each file.
 
@@ -1206,6 +1614,32 @@ private:
     atomic_int m_stat_open_files_created;
     atomic_int m_stat_open_files_current;
     atomic_int m_stat_open_files_peak;
+    atomic_int m_stat_tiles_evicted;
+
+    // One recorded trace event: `name` is the file involved, `cat` is a
+    // static category string ("open" or "tileread"), and ts/dur are the
+    // start and duration in seconds relative to the trace epoch.
+    struct TraceEvent {
+        ustring name;
+        const char* cat;
+        double ts, dur;
+    };
+    mutable spin_mutex m_trace_mutex;  ///< Guards m_trace_log
+    std::vector<TraceEvent> m_trace_log;
+    std::chrono::steady_clock::time_point m_trace_epoch;
+
+    // Append a trace event that just finished and took `dur` seconds.
+    // Cheap no-op check when tracing is off, one spin lock when it's on.
+    void trace_event(ustring name, const char* cat, double dur)
+    {
+        if (!m_trace_events)
+            return;
+        double end = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - m_trace_epoch)
+                         .count();
+        spin_lock lock(m_trace_mutex);
+        m_trace_log.push_back({ name, cat, end - dur, dur });
+    }
 
     // Simulate an atomic double with a long long!
     void incr_time_stat(double& stat, double incr)
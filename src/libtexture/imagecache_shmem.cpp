@@ -0,0 +1,211 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+
+/// \file
+/// Cross-process shared-memory tile cache used by ImageCacheImpl.  See
+/// the ShmTileCache class comment in imagecache_pvt.h for the design.
+
+
+#include <atomic>
+#include <cstring>
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include <OpenImageIO/hash.h>
+#include <OpenImageIO/imagecache.h>
+
+#include "imagecache_pvt.h"
+
+
+OIIO_NAMESPACE_BEGIN
+
+namespace pvt {
+
+namespace {
+
+// Bumping this invalidates segments created by older builds.
+static const uint64_t shm_magic = 0x4f49494f54696c31ULL;  // "OIIOTil1"
+
+struct ShmHeader {
+    std::atomic<uint64_t> magic;  // shm_magic once initialized
+    uint64_t nslots;              // number of tile slots
+    uint64_t slot_payload;        // per-slot pixel capacity, bytes
+};
+
+}  // anonymous namespace
+
+
+struct ShmTileCache::SlotHeader {
+    // Seqlock: even = stable, odd = write in progress.  Readers copy the
+    // payload and then re-check that the sequence did not change.
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> key;
+    uint32_t size;  // valid payload bytes
+    uint32_t pad;
+    // Pixel payload of slot_payload bytes follows, 64-byte aligned.
+};
+
+static const size_t shm_slot_stride
+    = 64 + ShmTileCache::slot_payload;  // header rounded up to a cache line
+
+
+
+uint64_t
+ShmTileCache::key(const TileID& id)
+{
+    // The key must be stable across processes, so hash the filename
+    // characters and the tile coordinates, never in-process pointers.
+    uint64_t h[8] = { id.file().filename().hash(),
+                      (uint64_t)(uint32_t)id.x() | ((uint64_t)(uint32_t)id.y() << 32),
+                      (uint64_t)(uint32_t)id.z(),
+                      (uint64_t)(uint32_t)id.subimage()
+                          | ((uint64_t)(uint32_t)id.miplevel() << 32),
+                      (uint64_t)(uint32_t)id.chbegin()
+                          | ((uint64_t)(uint32_t)id.chend() << 32),
+                      (uint64_t)(uint32_t)id.colortransformid(),
+                      0,
+                      0 };
+    return fasthash::fasthash64(h, sizeof(h), shm_magic);
+}
+
+
+
+ShmTileCache::SlotHeader*
+ShmTileCache::slot(uint64_t key) const
+{
+    char* base = (char*)m_addr + 64;  // header occupies the first line
+    return (SlotHeader*)(base + (key % m_nslots) * shm_slot_stride);
+}
+
+
+
+ShmTileCache::ShmTileCache(string_view name, size_t bytes)
+{
+#ifdef _WIN32
+    // Windows shared sections are not yet implemented.
+    (void)name;
+    (void)bytes;
+#else
+    if (name.empty() || bytes < 64 + shm_slot_stride)
+        return;
+    std::string shmname(name);
+    if (shmname.front() != '/')
+        shmname = "/" + shmname;
+    int fd = shm_open(shmname.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+        return;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0) {
+        ::close(fd);
+        return;
+    }
+    if ((size_t)sb.st_size < bytes && ftruncate(fd, (off_t)bytes) != 0) {
+        ::close(fd);
+        return;
+    }
+    if ((size_t)sb.st_size > bytes)
+        bytes = (size_t)sb.st_size;  // attach to the existing, larger segment
+    void* addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return;
+
+    uint64_t nslots   = (bytes - 64) / shm_slot_stride;
+    ShmHeader* header = (ShmHeader*)addr;
+    uint64_t expected = 0;
+    if (header->magic.compare_exchange_strong(expected, 1)) {
+        // We won the right to initialize the fresh segment.  The slot
+        // array is already zero-filled by ftruncate.
+        header->nslots       = nslots;
+        header->slot_payload = slot_payload;
+        header->magic.store(shm_magic, std::memory_order_release);
+    } else {
+        // Somebody else created it; wait until initialized, then verify
+        // the layout matches what this build expects.
+        while (header->magic.load(std::memory_order_acquire) == 1)
+            ;
+        if (header->magic.load() != shm_magic
+            || header->slot_payload != slot_payload || header->nslots == 0
+            || header->nslots > nslots) {
+            ::munmap(addr, bytes);
+            return;
+        }
+        nslots = header->nslots;
+    }
+    m_addr   = addr;
+    m_bytes  = bytes;
+    m_nslots = nslots;
+#endif
+}
+
+
+
+ShmTileCache::~ShmTileCache()
+{
+#ifndef _WIN32
+    if (m_addr)
+        ::munmap(m_addr, m_bytes);
+    // N.B. The segment itself is deliberately NOT unlinked -- it is a
+    // node-wide resource shared with (and possibly still used by) other
+    // processes.
+#endif
+}
+
+
+
+bool
+ShmTileCache::retrieve(const TileID& id, void* pixels, size_t size)
+{
+    if (!valid() || size > slot_payload)
+        return false;
+    uint64_t k    = key(id);
+    SlotHeader* s = slot(k);
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        uint64_t seq0 = s->seq.load(std::memory_order_acquire);
+        if (seq0 & 1)
+            return false;  // write in progress
+        if (s->key.load(std::memory_order_relaxed) != k || s->size != size)
+            return false;
+        memcpy(pixels, (const char*)s + 64, size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s->seq.load(std::memory_order_relaxed) == seq0)
+            return true;  // the copy was not torn by a concurrent write
+    }
+    return false;
+}
+
+
+
+void
+ShmTileCache::store(const TileID& id, const void* pixels, size_t size)
+{
+    if (!valid() || size == 0 || size > slot_payload)
+        return;
+    uint64_t k    = key(id);
+    SlotHeader* s = slot(k);
+    uint64_t seq0 = s->seq.load(std::memory_order_relaxed);
+    if (seq0 & 1)
+        return;  // another process is writing this slot; just skip
+    // Claim the slot by making the sequence odd.  Losing the race is
+    // fine -- this is best-effort publication.
+    if (!s->seq.compare_exchange_strong(seq0, seq0 + 1,
+                                        std::memory_order_acq_rel))
+        return;
+    s->key.store(k, std::memory_order_relaxed);
+    s->size = (uint32_t)size;
+    memcpy((char*)s + 64, pixels, size);
+    s->seq.store(seq0 + 2, std::memory_order_release);
+}
+
+
+}  // end namespace pvt
+
+OIIO_NAMESPACE_END
@@ -10,6 +10,10 @@
 #ifndef OPENIMAGEIO_TEXTURE_PVT_H
 #define OPENIMAGEIO_TEXTURE_PVT_H
 
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+
 #include <OpenImageIO/simd.h>
 #include <OpenImageIO/texture.h>
 
@@ -61,8 +65,14 @@ public:
         return attribute(name, TypeDesc::STRING, &s);
     }
 
+    void begin_attribute_transaction() override;
+    void commit_attribute_transaction() override;
+
     TypeDesc getattributetype(string_view name) const override;
 
+    int getattributes(cspan<string_view> names,
+                      ParamValueList& vals) const override;
+
     bool getattribute(string_view name, TypeDesc type,
                       void* val) const override;
     bool getattribute(string_view name, int& val) const override
@@ -148,6 +158,8 @@ public:
                  TextureOpt& options, float s, float t, float dsdx, float dtdx,
                  float dsdy, float dtdy, int nchannels, float* result,
                  float* dresultds = NULL, float* dresultdt = NULL) override;
+    bool texture_multi(cspan<TextureRequest> requests, Perthread* thread_info,
+                       int nchannels) override;
     bool texture(ustring filename, TextureOptBatch& options, Tex::RunMask mask,
                  const float* s, const float* t, const float* dsdx,
                  const float* dtdx, const float* dsdy, const float* dtdy,
@@ -159,6 +171,17 @@ public:
                  const float* dsdy, const float* dtdy, int nchannels,
                  float* result, float* dresultds = nullptr,
                  float* dresultdt = nullptr) override;
+    bool texture(ustring filename, TextureOptBatch* options, Tex::RunMask mask,
+                 const float* s, const float* t, const float* dsdx,
+                 const float* dtdx, const float* dsdy, const float* dtdy,
+                 int nchannels, float* result, float* dresultds = nullptr,
+                 float* dresultdt = nullptr) override;
+    bool texture(TextureHandle* texture_handle, Perthread* thread_info,
+                 TextureOptBatch* options, Tex::RunMask mask, const float* s,
+                 const float* t, const float* dsdx, const float* dtdx,
+                 const float* dsdy, const float* dtdy, int nchannels,
+                 float* result, float* dresultds = nullptr,
+                 float* dresultdt = nullptr) override;
     bool texture(ustring filename, TextureOptions& options, Runflag* runflags,
                  int beginactive, int endactive, VaryingRef<float> s,
                  VaryingRef<float> t, VaryingRef<float> dsdx,
@@ -262,6 +285,11 @@ public:
                      TextureOpt& options, V3fParam R, V3fParam dRdx,
                      V3fParam dRdy, int nchannels, float* result,
                      float* dresultds = NULL, float* dresultdt = NULL) override;
+    bool environment_sample(ustring filename, Perthread* thread_info,
+                            const float* rnd, float* uv, float* pdf) override;
+    bool environment_sample(TextureHandle* texture_handle,
+                            Perthread* thread_info, const float* rnd,
+                            float* uv, float* pdf) override;
     bool environment(ustring filename, TextureOptBatch& options,
                      Tex::RunMask mask, const float* R, const float* dRdx,
                      const float* dRdy, int nchannels, float* result,
@@ -550,6 +578,16 @@ private:
     void visualize_ellipse(const std::string& name, float dsdx, float dtdx,
                            float dsdy, float dtdy, float sblur, float tblur);
 
+    // Texture access tracing, enabled by setting the "trace:filename"
+    // attribute (see the file format notes in texturesys.cpp). Append one
+    // lookup record to the open trace.
+    void trace_lookup(ustring filename, float s, float t, float dsdx,
+                      float dtdx, float dsdy, float dtdy);
+    // Begin tracing to the named file (closing any prior trace).
+    bool open_trace(const std::string& filename);
+    // Stop tracing and close the trace file, if one is open.
+    void close_trace();
+
     ImageCacheImpl* m_imagecache = nullptr;
     uint64_t m_id;                    // A unique ID for this TextureSystem
     Imath::M44f m_Mw2c;               ///< world-to-"common" matrix
@@ -571,6 +609,11 @@ private:
 
     std::unique_ptr<Filter1D> hq_filter;  // Better filter for magnification
     int m_statslevel;
+    FILE* m_trace_file = nullptr;  ///< Open trace output, or null
+    std::string m_trace_filename;  ///< Name of the trace output file
+    std::mutex m_trace_mutex;      ///< Serializes trace writes
+    std::unordered_map<ustring, uint32_t, ustringHash>
+        m_trace_fileids;  ///< Map file name -> id within the trace
     friend class TextureSystem;
 };
 
@@ -358,6 +358,7 @@ TextureSystemImpl::init()
 
 TextureSystemImpl::~TextureSystemImpl()
 {
+    close_trace();
     printstats();
     // Erase any leftover errors from this thread
     // TODO: can we clear other threads' errors?
@@ -451,11 +452,114 @@ TextureSystemImpl::reset_stats()
 
 
 
+// Texture access trace file format, produced when the "trace:filename"
+// attribute names an output file and consumed by `testtex --replay`:
+//
+//     8 bytes     magic/version "OIIOtrc1"
+//
+// followed by a stream of records in native endianness. An ordinary lookup
+// record is 32 bytes:
+//
+//     uint32      file id
+//     uint32      thread id (small dense ints, in order of first lookup)
+//     6 floats    s, t, dsdx, dtdx, dsdy, dtdy
+//
+// The first lookup of each distinct file is preceded by a record that
+// introduces its name:
+//
+//     uint32      0xffffffff (sentinel distinguishing it from a lookup)
+//     uint32      file id being introduced
+//     uint32      length of the file name
+//     N bytes     the file name (not padded or terminated)
+
+static constexpr char trace_magic[8] = { 'O', 'I', 'I', 'O',
+                                         't', 'r', 'c', '1' };
+
+namespace {
+// Small dense per-thread id so a replay can reproduce the original
+// distribution of lookups across threads.
+std::atomic<int> next_trace_threadid(0);
+thread_local int trace_threadid = -1;
+}  // namespace
+
+
+bool
+TextureSystemImpl::open_trace(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(m_trace_mutex);
+    if (m_trace_file) {
+        fclose(m_trace_file);
+        m_trace_file = nullptr;
+        m_trace_filename.clear();
+    }
+    m_trace_fileids.clear();
+    if (filename.empty())
+        return true;
+    m_trace_file = Filesystem::fopen(filename, "wb");
+    if (!m_trace_file) {
+        error("Could not open texture trace file \"{}\"", filename);
+        return false;
+    }
+    fwrite(trace_magic, sizeof(trace_magic), 1, m_trace_file);
+    m_trace_filename = filename;
+    return true;
+}
+
+
+
+void
+TextureSystemImpl::close_trace()
+{
+    std::lock_guard<std::mutex> lock(m_trace_mutex);
+    if (m_trace_file) {
+        fclose(m_trace_file);
+        m_trace_file = nullptr;
+        m_trace_filename.clear();
+        m_trace_fileids.clear();
+    }
+}
+
+
+
+void
+TextureSystemImpl::trace_lookup(ustring filename, float s, float t, float dsdx,
+                                float dtdx, float dsdy, float dtdy)
+{
+    if (trace_threadid < 0)
+        trace_threadid = next_trace_threadid++;
+    std::lock_guard<std::mutex> lock(m_trace_mutex);
+    if (!m_trace_file)
+        return;  // tracing was just turned off by another thread
+    uint32_t id;
+    auto found = m_trace_fileids.find(filename);
+    if (found != m_trace_fileids.end()) {
+        id = found->second;
+    } else {
+        id                        = uint32_t(m_trace_fileids.size());
+        m_trace_fileids[filename] = id;
+        uint32_t intro[3] = { 0xffffffff, id, uint32_t(filename.size()) };
+        fwrite(intro, sizeof(intro), 1, m_trace_file);
+        fwrite(filename.c_str(), 1, filename.size(), m_trace_file);
+    }
+    uint32_t head[2] = { id, uint32_t(trace_threadid) };
+    float vals[6]    = { s, t, dsdx, dtdx, dsdy, dtdy };
+    fwrite(head, sizeof(head), 1, m_trace_file);
+    fwrite(vals, sizeof(vals), 1, m_trace_file);
+}
+
+
+
 bool
 TextureSystemImpl::attribute(string_view name, TypeDesc type, const void* val)
 {
     if (name == "options" && type == TypeDesc::STRING) {
-        return optparser(*this, *(const char**)val);
+        // One transaction for the whole option string, so the underlying
+        // cache invalidates at most once no matter how many options
+        // changed.
+        begin_attribute_transaction();
+        bool ok = optparser(*this, *(const char**)val);
+        commit_attribute_transaction();
+        return ok;
     }
     if (name == "worldtocommon"
         && (type == TypeMatrix || type == TypeDesc(TypeDesc::FLOAT, 16))) {
@@ -485,6 +589,15 @@ TextureSystemImpl::attribute(string_view name, TypeDesc type, const void* val)
         m_stochastic = *(const int*)val;
         return true;
     }
+    if (name == "trace:filename" && type == TypeDesc::STRING) {
+        std::string newname(*(const char**)val);
+        if (newname != m_trace_filename) {
+            close_trace();
+            if (newname.size())
+                return open_trace(newname);
+        }
+        return true;
+    }
     if (name == "statistics:level" && type == TypeInt) {
         m_statslevel = *(const int*)val;
         // DO NOT RETURN! pass the same message to the image cache
@@ -504,6 +617,24 @@ TextureSystemImpl::attribute(string_view name, TypeDesc type, const void* val)
 
 
 
+void
+TextureSystemImpl::begin_attribute_transaction()
+{
+    // The TextureSystem's own attributes never trigger invalidation, so
+    // the transaction state lives entirely in the underlying cache.
+    m_imagecache->begin_attribute_transaction();
+}
+
+
+
+void
+TextureSystemImpl::commit_attribute_transaction()
+{
+    m_imagecache->commit_attribute_transaction();
+}
+
+
+
 TypeDesc
 TextureSystemImpl::getattributetype(string_view name) const
 {
@@ -516,6 +647,7 @@ TextureSystemImpl::getattributetype(string_view name) const
         { "flip_t", TypeInt },
         { "max_tile_channels", TypeInt },
         { "stochastic", TypeInt },
+        { "trace:filename", TypeString },
     };
     // clang-format on
 
@@ -565,6 +697,10 @@ TextureSystemImpl::getattribute(string_view name, TypeDesc type,
         *(int*)val = m_stochastic;
         return true;
     }
+    if (name == "trace:filename" && type == TypeDesc::STRING) {
+        *(const char**)val = ustring(m_trace_filename).c_str();
+        return true;
+    }
 
     // If not one of these, maybe it's an attribute meant for the image cache?
     return m_imagecache->getattribute(name, type, val);
@@ -574,6 +710,26 @@ TextureSystemImpl::getattribute(string_view name, TypeDesc type,
 
 
 
+int
+TextureSystemImpl::getattributes(cspan<string_view> names,
+                                 ParamValueList& vals) const
+{
+    int found = 0;
+    for (string_view name : names) {
+        TypeDesc t = getattributetype(name);
+        char buf[64];  // big enough for any simple attribute value
+        if (t == TypeUnknown || t.size() > sizeof(buf))
+            continue;
+        if (getattribute(name, t, buf)) {
+            vals.emplace_back(name, t, 1, buf);
+            ++found;
+        }
+    }
+    return found;
+}
+
+
+
 std::string
 TextureSystemImpl::resolve_filename(const std::string& filename) const
 {
@@ -1124,6 +1280,67 @@ TextureSystemImpl::texture(TextureHandle* texture_handle,
 
 
 
+// Locality key for reordering independent lookups: Morton code of the
+// wrapped (s,t) quantized to a 1024x1024 grid, which approximates tile
+// granularity well across common texture resolutions. (Exact TileIDs
+// would require resolving each lookup's MIP level first, which costs
+// nearly as much as the lookup itself.)
+static inline uint32_t
+st_locality_key(float s, float t)
+{
+    s           = s - floorf(s);
+    t           = t - floorf(t);
+    uint32_t is = uint32_t(s * 1024.0f) & 1023;
+    uint32_t it = uint32_t(t * 1024.0f) & 1023;
+    uint32_t m  = 0;
+    for (int b = 0; b < 10; ++b)
+        m |= (((is >> b) & 1) << (2 * b)) | (((it >> b) & 1) << (2 * b + 1));
+    return m;
+}
+
+
+
+bool
+TextureSystemImpl::texture_multi(cspan<TextureRequest> requests,
+                                 Perthread* thread_info, int nchannels)
+{
+    size_t n = requests.size();
+    bool ok  = true;
+    // For small batches, sorting costs more than it saves.
+    if (n < 16) {
+        for (const TextureRequest& q : requests)
+            ok &= texture(q.texture_handle, thread_info, *q.options, q.s, q.t,
+                          q.dsdx, q.dtdx, q.dsdy, q.dtdy, nchannels, q.result,
+                          q.dresultds, q.dresultdt);
+        return ok;
+    }
+
+    // Evaluate in tile-coherent order: sort the request indices by
+    // (texture, locality key) so lookups that touch the same tiles run
+    // back to back and hit the per-thread microcache instead of churning
+    // it.
+    auto key = [](const TextureRequest& q) -> uint64_t {
+        // High bits say which texture, low bits where within it. (Losing
+        // the pointer's top bits to the shift is harmless; this is a
+        // grouping key, not an identity.)
+        return (uint64_t(uintptr_t(q.texture_handle)) << 20)
+               | st_locality_key(q.s, q.t);
+    };
+    std::vector<std::pair<uint64_t, uint32_t>> order(n);
+    for (size_t i = 0; i < n; ++i)
+        order[i] = { key(requests[i]), uint32_t(i) };
+    std::sort(order.begin(), order.end());
+    for (const auto& o : order) {
+        const TextureRequest& q(requests[o.second]);
+        ok &= texture(q.texture_handle, thread_info, *q.options, q.s, q.t,
+                      q.dsdx, q.dtdx, q.dsdy, q.dtdy, nchannels, q.result,
+                      q.dresultds, q.dresultdt);
+    }
+    return ok;
+}
+
+
+
 bool
 TextureSystemImpl::texture(ustring filename, TextureOpt& options, float s,
                            float t, float dsdx, float dtdx, float dsdy,
@@ -1168,6 +1385,12 @@ TextureSystemImpl::texture(TextureHandle* texture_handle_,
         return true;
     }
 
+    // If tracing is on, log the lookup (below the >4 channel recursion, so
+    // wide lookups are recorded as the 4-channel lookups they turn into).
+    if (OIIO_UNLIKELY(m_trace_file))
+        trace_lookup(((TextureFile*)texture_handle_)->filename(), s, t, dsdx,
+                     dtdx, dsdy, dtdy);
+
     static const texture_lookup_prototype lookup_functions[] = {
         // Must be in the same order as Mipmode enum
         &TextureSystemImpl::texture_lookup,
@@ -1362,28 +1585,140 @@ TextureSystemImpl::texture(TextureHandle* texture_handle,
     float* r         = OIIO_ALLOCA(float, 3 * nchannels);
     float* drds      = r + nchannels;
     float* drdt      = drds + nchannels;
+    // Visit the active lanes in tile-coherent order rather than lane
+    // order: on divergent UV sets (fur, scatter instances), adjacent
+    // lanes often touch interleaved tiles, and grouping them means one
+    // tile fetch and one microcache probe per group instead of per lane.
+    // A tiny insertion sort on the locality key orders the lane list.
+    int lanes[Tex::BatchWidth];
+    int nlanes = 0;
+    uint32_t keys[Tex::BatchWidth];
     for (int i = 0; i < Tex::BatchWidth; ++i, bit <<= 1) {
         if (mask & bit) {
-            opt.sblur  = options.sblur[i];
-            opt.tblur  = options.tblur[i];
-            opt.swidth = options.swidth[i];
-            opt.twidth = options.twidth[i];
-            opt.rnd    = options.rnd[i];
-            // rblur, rwidth not needed for 2D texture
+            uint32_t k = st_locality_key(s[i], t[i]);
+            int j      = nlanes++;
+            for (; j > 0 && keys[j - 1] > k; --j) {
+                keys[j]  = keys[j - 1];
+                lanes[j] = lanes[j - 1];
+            }
+            keys[j]  = k;
+            lanes[j] = i;
+        }
+    }
+    for (int li = 0; li < nlanes; ++li) {
+        int i      = lanes[li];
+        opt.sblur  = options.sblur[i];
+        opt.tblur  = options.tblur[i];
+        opt.swidth = options.swidth[i];
+        opt.twidth = options.twidth[i];
+        opt.rnd    = options.rnd[i];
+        // rblur, rwidth not needed for 2D texture
+        if (dresultds) {
+            ok &= texture(texture_handle, thread_info, opt, s[i], t[i], dsdx[i],
+                          dtdx[i], dsdy[i], dtdy[i], nchannels, r, drds, drdt);
+            for (int c = 0; c < nchannels; ++c) {
+                result[c * Tex::BatchWidth + i]    = r[c];
+                dresultds[c * Tex::BatchWidth + i] = drds[c];
+                dresultdt[c * Tex::BatchWidth + i] = drdt[c];
+            }
+        } else {
+            ok &= texture(texture_handle, thread_info, opt, s[i], t[i], dsdx[i],
+                          dtdx[i], dsdy[i], dtdy[i], nchannels, r);
+            for (int c = 0; c < nchannels; ++c) {
+                result[c * Tex::BatchWidth + i] = r[c];
+            }
+        }
+    }
+    return ok;
+}
+
+
+
+bool
+TextureSystemImpl::texture(ustring filename, TextureOptBatch* options,
+                           Tex::RunMask mask, const float* s, const float* t,
+                           const float* dsdx, const float* dtdx,
+                           const float* dsdy, const float* dtdy, int nchannels,
+                           float* result, float* dresultds, float* dresultdt)
+{
+    Perthread* thread_info        = get_perthread_info();
+    TextureHandle* texture_handle = get_texture_handle(filename, thread_info);
+    return texture(texture_handle, thread_info, options, mask, s, t, dsdx,
+                   dtdx, dsdy, dtdy, nchannels, result, dresultds, dresultdt);
+}
+
+
+bool
+TextureSystemImpl::texture(TextureHandle* texture_handle,
+                           Perthread* thread_info, TextureOptBatch* options,
+                           Tex::RunMask mask, const float* s, const float* t,
+                           const float* dsdx, const float* dtdx,
+                           const float* dsdy, const float* dtdy, int nchannels,
+                           float* result, float* dresultds, float* dresultdt)
+{
+    // Double-wide (2*BatchWidth lane) batch. Like the batched lookup above,
+    // this points individually, but it resolves the handle and per-thread
+    // info once and stores straight into the wide-stride SOA results, so a
+    // wide shading batch pays neither a second dispatch nor a repack.
+    bool ok          = true;
+    Tex::RunMask bit = 1;
+    float* r         = OIIO_ALLOCA(float, 3 * nchannels);
+    float* drds      = r + nchannels;
+    float* drdt      = drds + nchannels;
+    // Same tile-coherent lane reordering as the single-width batch above.
+    int lanes[Tex::BatchWidthWide];
+    int nlanes = 0;
+    uint32_t keys[Tex::BatchWidthWide];
+    for (int i = 0; i < Tex::BatchWidthWide; ++i, bit <<= 1) {
+        if (mask & bit) {
+            uint32_t k = st_locality_key(s[i], t[i]);
+            int j      = nlanes++;
+            for (; j > 0 && keys[j - 1] > k; --j) {
+                keys[j]  = keys[j - 1];
+                lanes[j] = lanes[j - 1];
+            }
+            keys[j]  = k;
+            lanes[j] = i;
+        }
+    }
+    for (int li = 0; li < nlanes; ++li) {
+        int i = lanes[li];
+        {
+            const TextureOptBatch& batchopt(options[i / Tex::BatchWidth]);
+            int lane = i % Tex::BatchWidth;
+            TextureOpt opt;
+            opt.firstchannel        = batchopt.firstchannel;
+            opt.subimage            = batchopt.subimage;
+            opt.subimagename        = batchopt.subimagename;
+            opt.swrap               = (TextureOpt::Wrap)batchopt.swrap;
+            opt.twrap               = (TextureOpt::Wrap)batchopt.twrap;
+            opt.mipmode             = (TextureOpt::MipMode)batchopt.mipmode;
+            opt.interpmode          = (TextureOpt::InterpMode)batchopt.interpmode;
+            opt.anisotropic         = batchopt.anisotropic;
+            opt.conservative_filter = batchopt.conservative_filter;
+            opt.fill                = batchopt.fill;
+            opt.missingcolor        = batchopt.missingcolor;
+            opt.colortransformid    = batchopt.colortransformid;
+            opt.sblur               = batchopt.sblur[lane];
+            opt.tblur               = batchopt.tblur[lane];
+            opt.swidth              = batchopt.swidth[lane];
+            opt.twidth              = batchopt.twidth[lane];
+            opt.rnd                 = batchopt.rnd[lane];
+            // rwrap, rblur, rwidth not needed for 2D texture
             if (dresultds) {
                 ok &= texture(texture_handle, thread_info, opt, s[i], t[i],
                               dsdx[i], dtdx[i], dsdy[i], dtdy[i], nchannels, r,
                               drds, drdt);
                 for (int c = 0; c < nchannels; ++c) {
-                    result[c * Tex::BatchWidth + i]    = r[c];
-                    dresultds[c * Tex::BatchWidth + i] = drds[c];
-                    dresultdt[c * Tex::BatchWidth + i] = drdt[c];
+                    result[c * Tex::BatchWidthWide + i]    = r[c];
+                    dresultds[c * Tex::BatchWidthWide + i] = drds[c];
+                    dresultdt[c * Tex::BatchWidthWide + i] = drdt[c];
                 }
             } else {
                 ok &= texture(texture_handle, thread_info, opt, s[i], t[i],
                               dsdx[i], dtdx[i], dsdy[i], dtdy[i], nchannels, r);
                 for (int c = 0; c < nchannels; ++c) {
-                    result[c * Tex::BatchWidth + i] = r[c];
+                    result[c * Tex::BatchWidthWide + i] = r[c];
                 }
             }
         }
@@ -1658,7 +1993,11 @@ TextureSystemImpl::texture_lookup_trilinear_mipmap(
     }
 
     bool stoch_mip = (options.rnd >= 0.0f
-                      && (m_stochastic & StochasticStrategy_MIP));
+                      && ((m_stochastic & StochasticStrategy_MIP)
+                          || options.mipmode
+                                 == TextureOpt::MipModeStochasticTrilinear
+                          || options.mipmode
+                                 == TextureOpt::MipModeStochasticAniso));
 
     adjust_width(dsdx, dtdx, dsdy, dtdy, options.swidth, options.twidth);
 
@@ -1876,9 +2215,18 @@ TextureSystemImpl::texture_lookup(TextureFile& texturefile,
     int naturalsres    = (int)(1.0f / sfilt_noblur);
     int naturaltres    = (int)(1.0f / tfilt_noblur);
 
-    bool stoch       = (options.rnd >= 0.0f);
-    bool stoch_mip   = stoch && (m_stochastic & StochasticStrategy_MIP);
-    bool stoch_aniso = stoch && (m_stochastic & StochasticStrategy_Aniso);
+    bool stoch = (options.rnd >= 0.0f);
+    // The stochastic mip modes request single-tap sampling per lookup,
+    // regardless of the global "stochastic" attribute, which in turn can
+    // force the same treatment for ordinary mip modes.
+    bool stoch_request = (options.mipmode
+                          == TextureOpt::MipModeStochasticAniso);
+    bool stoch_mip     = stoch
+                     && ((m_stochastic & StochasticStrategy_MIP)
+                         || stoch_request);
+    bool stoch_aniso = stoch
+                       && ((m_stochastic & StochasticStrategy_Aniso)
+                           || stoch_request);
     // Scale by 'width'
     adjust_width(dsdx, dtdx, dsdy, dtdy, options.swidth, options.twidth);
 
@@ -2042,7 +2390,7 @@ TextureSystemImpl::pole_color(TextureFile& texturefile,
 {
     if (!levelinfo.onetile)
         return NULL;  // Only compute color for one-tile MIP levels
-    const ImageSpec& spec(levelinfo.spec);
+    const ImageSpec& spec(levelinfo.spec());
     if (!levelinfo.polecolorcomputed) {
         static spin_mutex mutex;  // Protect everybody's polecolor
         spin_lock lock(mutex);
@@ -2271,15 +2619,10 @@ TextureSystemImpl::sample_bilinear(
     const ImageCacheFile::LevelInfo& levelinfo(
         texturefile.levelinfo(options.subimage, miplevel));
     TypeDesc::BASETYPE pixeltype = texturefile.pixeltype(options.subimage);
-    wrap_impl swrap_func         = wrap_functions[(int)options.swrap];
-    wrap_impl twrap_func         = wrap_functions[(int)options.twrap];
-    wrap_impl_simd wrap_func     = (swrap_func == twrap_func)
-                                       ? wrap_functions_simd[(int)options.swrap]
-                                       : NULL;
+    wrap_impl_simd swrap_func_simd = wrap_functions_simd[(int)options.swrap];
+    wrap_impl_simd twrap_func_simd = wrap_functions_simd[(int)options.twrap];
     simd::vint4 xy(spec.x, spec.y);
-    simd::vint4 widthheight(spec.width, spec.height);
     simd::vint4 tilewh(spec.tile_width, spec.tile_height);
-    simd::vint4 tilewhmask = tilewh - 1;
     bool use_fill      = (nchannels_result > actualchannels && options.fill);
     bool tilepow2      = ispow2(spec.tile_width) && ispow2(spec.tile_height);
     size_t channelsize = texturefile.channelsize(options.subimage);
@@ -2311,67 +2654,79 @@ TextureSystemImpl::sample_bilinear(
     vfloat4 s_simd, t_simd;
     vint4 sint_simd, tint_simd;
     vfloat4 sfrac_simd, tfrac_simd;
+    // Per-tap data for a block of four samples, computed SIMD *across* the
+    // samples: wrapped texel coords, tap validity, tile-relative addresses
+    // and tile origins, and the "all four texels on one tile" test.
+    vint4 s0_simd, s1_simd, t0_simd, t1_simd;
+    vbool4 s0ok_simd, s1ok_simd, t0ok_simd, t1ok_simd;
+    vint4 tile_s_simd, tile_t_simd, tileorig_s_simd, tileorig_t_simd;
+    vbool4 s_onetile_simd, t_onetile_simd;
+    const vint4 specx(spec.x), specy(spec.y);
+    const vint4 specw(spec.width), spech(spec.height);
+    const vint4 tilew(spec.tile_width), tileh(spec.tile_height);
     for (int sample = 0; sample < nsamples; ++sample) {
         // To utilize SIMD ops in an inherently scalar loop, every fourth
-        // step, we compute the st_to_texel for the next four samples.
+        // step, we compute the st_to_texel, the wrapping, and the tile
+        // address arithmetic of every tap for the next four samples, so
+        // none of that is done per tap below. (The sample arrays are
+        // rounded up to a multiple of 4 entries, so the overrun lanes are
+        // harmless.)
         int sample4 = sample & 3;
         if (sample4 == 0) {
             s_simd.load(s_ + sample);
             t_simd.load(t_ + sample);
             st_to_texel_simd(s_simd, t_simd, texturefile, spec, sint_simd,
                              tint_simd, sfrac_simd, tfrac_simd);
+            s0_simd   = sint_simd;
+            s1_simd   = sint_simd + 1;
+            t0_simd   = tint_simd;
+            t1_simd   = tint_simd + 1;
+            s0ok_simd = swrap_func_simd(s0_simd, specx, specw);
+            s1ok_simd = swrap_func_simd(s1_simd, specx, specw);
+            t0ok_simd = twrap_func_simd(t0_simd, specy, spech);
+            t1ok_simd = twrap_func_simd(t1_simd, specy, spech);
+            // Account for crop windows
+            if (!levelinfo.full_pixel_range) {
+                s0ok_simd &= (s0_simd >= specx) & (s0_simd < specx + specw);
+                s1ok_simd &= (s1_simd >= specx) & (s1_simd < specx + specw);
+                t0ok_simd &= (t0_simd >= specy) & (t0_simd < specy + spech);
+                t1ok_simd &= (t1_simd >= specy) & (t1_simd < specy + spech);
+            }
+            tile_s_simd = s0_simd - specx;
+            tile_t_simd = t0_simd - specy;
+            if (tilepow2) {
+                tile_s_simd &= tilew - 1;
+                tile_t_simd &= tileh - 1;
+            } else {
+                tile_s_simd %= tilew;
+                tile_t_simd %= tileh;
+            }
+            tileorig_s_simd = s0_simd - tile_s_simd;
+            tileorig_t_simd = t0_simd - tile_t_simd;
+            s_onetile_simd  = (tile_s_simd != tilew - 1)
+                             & (s0_simd + 1 == s1_simd);
+            t_onetile_simd = (tile_t_simd != tileh - 1)
+                             & (t0_simd + 1 == t1_simd);
         }
-        int sint = sint_simd[sample4], tint = tint_simd[sample4];
         float sfrac = sfrac_simd[sample4], tfrac = tfrac_simd[sample4];
         float weight = weight_[sample];
 
-        // SIMD-ize the indices. We have four texels, fit them into one SIMD
-        // 4-vector as S0,S1,T0,T1.
+        // Lane layout for this sample's four taps: S0,S1,T0,T1.
         enum { S0 = 0, S1 = 1, T0 = 2, T1 = 3 };
 
-        simd::vint4 sttex(sint, sint + 1, tint,
-                          tint + 1);  // Texel coords: s0,s1,t0,t1
         simd::vbool4 stvalid;
-        if (wrap_func) {
-            // Both directions use the same wrap function, call in parallel.
-            stvalid = wrap_func(sttex, xy, widthheight);
-        } else {
-            stvalid.load(swrap_func(sttex[S0], spec.x, spec.width),
-                         swrap_func(sttex[S1], spec.x, spec.width),
-                         twrap_func(sttex[T0], spec.y, spec.height),
-                         twrap_func(sttex[T1], spec.y, spec.height));
-        }
-
-        // Account for crop windows
-        if (!levelinfo.full_pixel_range) {
-            stvalid &= (sttex >= xy) & (sttex < (xy + widthheight));
-        }
+        stvalid.load(s0ok_simd[sample4] != 0, s1ok_simd[sample4] != 0,
+                     t0ok_simd[sample4] != 0, t1ok_simd[sample4] != 0);
         if (none(stvalid)) {
             nonfill += weight;
             continue;  // All texels we need were out of range and using 'black' wrap
         }
 
         simd::vfloat4 texel_simd[2][2];
-        simd::vint4 tile_st = (simd::vint4(simd::shuffle<S0, S0, T0, T0>(sttex))
-                               - xy);
-        if (tilepow2)
-            tile_st &= tilewhmask;
-        else
-            tile_st %= tilewh;
-        OIIO_PRAGMA_WARNING_PUSH
-#if OIIO_CLANG_VERSION >= 140000 || OIIO_INTEL_CLANG_VERSION >= 140000 \
-    || OIIO_APPLE_CLANG_VERSION >= 140000
-        OIIO_CLANG_PRAGMA(GCC diagnostic ignored "-Wbitwise-instead-of-logical")
-#endif
-        bool s_onetile = (tile_st[S0] != tilewhmask[S0])
-                         & (sttex[S0] + 1 == sttex[S1]);
-        bool t_onetile = (tile_st[T0] != tilewhmask[T0])
-                         & (sttex[T0] + 1 == sttex[T1]);
-        OIIO_PRAGMA_WARNING_POP
-        bool onetile = (s_onetile & t_onetile);
+        bool onetile = s_onetile_simd[sample4] && t_onetile_simd[sample4];
         if (onetile && all(stvalid)) {
             // Shortcut if all the texels we need are on the same tile
-            id.xy(sttex[S0] - tile_st[S0], sttex[T0] - tile_st[T0]);
+            id.xy(tileorig_s_simd[sample4], tileorig_t_simd[sample4]);
             bool ok = find_tile(id, thread_info, sample == 0);
             if (!ok)
                 error("{}", m_imagecache->geterror());
@@ -2379,7 +2734,8 @@ TextureSystemImpl::sample_bilinear(
             if (!tile->valid())
                 return false;
             int pixelsize      = tile->pixelsize();
-            imagesize_t offset = tile->pixel_offset(tile_st[S0], tile_st[T0]);
+            imagesize_t offset = tile->pixel_offset(tile_s_simd[sample4],
+                                                    tile_t_simd[sample4]);
             const unsigned char* p = tile->bytedata() + offset
                                      + channelsize
                                            * (firstchannel - id.chbegin());
@@ -2410,6 +2766,10 @@ TextureSystemImpl::sample_bilinear(
                 texel_simd[1][1].load((const float*)(p + pixelsize));
             }
         } else {
+            // Rare case: this sample's taps straddle tiles or are partly
+            // invalid. Reassemble them in the S0,S1,T0,T1 lane layout.
+            simd::vint4 sttex(s0_simd[sample4], s1_simd[sample4],
+                              t0_simd[sample4], t1_simd[sample4]);
             bool noreusetile      = (options.swrap == TextureOpt::WrapMirror);
             simd::vint4 tile_st   = (sttex - xy) % tilewh;
             simd::vint4 tile_edge = sttex - tile_st;
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fcntl.h>
@@ -18,6 +19,7 @@
 #include <OpenImageIO/platform.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
+#include <OpenImageIO/thread.h>
 #include <OpenImageIO/ustring.h>
 
 #ifdef _WIN32
@@ -1212,12 +1214,33 @@ void
 Filesystem::IOFile::close()
 {
     if (m_file) {
+#if !defined(_WIN32) && defined(POSIX_FADV_DONTNEED)
+        if (m_drop_cache) {
+            // One-pass file: drop whatever pages are still cached.
+            fflush(m_file);
+            posix_fadvise(fileno(m_file), 0, 0, POSIX_FADV_DONTNEED);
+        }
+#endif
         fclose(m_file);
         m_file = nullptr;
     }
     m_mode = Closed;
 }
 
+
+
+void
+Filesystem::IOFile::set_drop_cache(bool enable)
+{
+    m_drop_cache = enable;
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+    if (enable && m_file && m_mode == Read) {
+        // One-pass streaming read: let the kernel ramp up readahead.
+        posix_fadvise(fileno(m_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+}
+
 bool
 Filesystem::IOFile::seek(int64_t offset)
 {
@@ -1234,6 +1257,19 @@ Filesystem::IOFile::read(void* buf, size_t size)
         return 0;
     size_t r = fread(buf, 1, size, m_file);
     m_pos += r;
+#if !defined(_WIN32) && defined(POSIX_FADV_DONTNEED)
+    if (m_drop_cache) {
+        // Drop fully-consumed chunks behind the streaming position so a
+        // one-pass read of a huge file doesn't pollute the page cache.
+        const int64_t chunk = 16 * 1024 * 1024;
+        int64_t consumed    = m_pos & ~(chunk - 1);
+        if (consumed > m_drop_mark) {
+            posix_fadvise(fileno(m_file), m_drop_mark,
+                          consumed - m_drop_mark, POSIX_FADV_DONTNEED);
+            m_drop_mark = consumed;
+        }
+    }
+#endif
     if (r < size) {
         if (feof(m_file))
             error("end of file");
@@ -1315,6 +1351,32 @@ Filesystem::IOFile::flush() const
         fflush(m_file);
 }
 
+bool
+Filesystem::IOFile::sync()
+{
+    if (!m_file)
+        return false;
+    if (fflush(m_file) != 0)
+        return false;
+#ifdef _WIN32
+    if (_commit(_fileno(m_file)) != 0)
+        return false;
+#else
+    int fd = fileno(m_file);
+    if (::fsync(fd) != 0)
+        return false;
+#    ifdef POSIX_FADV_DONTNEED
+    if (m_drop_cache) {
+        // The data is durable; tell the kernel we won't re-read it, so a
+        // huge sequential write doesn't evict more useful pages. Advisory
+        // only -- failure doesn't compromise the sync.
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+#    endif
+#endif
+    return true;
+}
+
 
 
 size_t
@@ -1377,4 +1439,302 @@ Filesystem::IOMemReader::pread(void* buf, size_t size, int64_t offset)
 }
 
 
+
+Filesystem::BufferedIOProxy::BufferedIOProxy(IOProxy* proxy, size_t buffer_size)
+    : IOProxy(proxy ? string_view(proxy->filename()) : string_view(),
+              proxy ? proxy->mode() : Closed)
+    , m_proxy(proxy)
+    , m_bufsize(std::max(buffer_size, size_t(4096)))
+{
+    if (m_proxy)
+        m_pos = m_proxy->tell();
+}
+
+
+
+Filesystem::BufferedIOProxy::~BufferedIOProxy() { close(); }
+
+
+
+void
+Filesystem::BufferedIOProxy::close()
+{
+    flush_writebehind();
+    finish_prefetch(m_rdbuf[0]);
+    finish_prefetch(m_rdbuf[1]);
+    m_rdbuf[0].data.clear();
+    m_rdbuf[1].data.clear();
+    // N.B. We do not close the wrapped proxy -- we don't own it.
+    m_mode = Closed;
+}
+
+
+
+bool
+Filesystem::BufferedIOProxy::seek(int64_t offset)
+{
+    // Flush pending write-behind data before moving the write position.
+    // Reads need no special action -- a position outside the buffered
+    // window simply misses and refills.
+    if (m_mode == Write && !flush_writebehind())
+        return false;
+    m_pos = offset;
+    return true;
+}
+
+
+
+void
+Filesystem::BufferedIOProxy::finish_prefetch(ReadBuffer& rb)
+{
+    if (!rb.pending.valid())
+        return;
+    // Wait for the in-flight prefetch to complete. If this thread is a
+    // pool worker, just block; otherwise, opportunistically run queued
+    // tasks while waiting (same idiom as task_set::wait_for_task).
+    thread_pool* pool = default_thread_pool();
+    if (!pool->is_worker()) {
+        const std::chrono::milliseconds wait_time(0);
+        while (rb.pending.wait_for(wait_time) != std::future_status::ready)
+            if (!pool->run_one_task(std::this_thread::get_id()))
+                std::this_thread::yield();
+    }
+    size_t got = rb.pending.get();
+    rb.data.resize(got);
+    m_stats.bytes_fetched += got;
+}
+
+
+
+void
+Filesystem::BufferedIOProxy::start_prefetch(ReadBuffer& rb, int64_t offset)
+{
+    OIIO_DASSERT(!rb.pending.valid());
+    rb.offset = offset;
+    rb.data.resize(m_bufsize);
+    ++m_stats.fetches;
+    // N.B. rb is one of the m_rdbuf members, so the reference stays valid
+    // until the prefetch is finished (close() and the destructor wait).
+    rb.pending = default_thread_pool()->push([this, &rb, offset](int) {
+        return m_proxy->pread(rb.data.data(), m_bufsize, offset);
+    });
+}
+
+
+
+size_t
+Filesystem::BufferedIOProxy::read(void* buf, size_t size)
+{
+    if (!m_proxy || !size || m_mode != Read)
+        return 0;
+    ++m_stats.read_calls;
+    char* out   = (char*)buf;
+    size_t n    = size;
+    bool allhit = true;
+    while (n) {
+        ReadBuffer& cur = m_rdbuf[m_currdbuf];
+        if (m_pos >= cur.offset
+            && m_pos < cur.offset + int64_t(cur.data.size())) {
+            // Serve from the current buffer.
+            size_t boff  = size_t(m_pos - cur.offset);
+            size_t avail = std::min(cur.data.size() - boff, n);
+            memcpy(out, cur.data.data() + boff, avail);
+            m_pos += avail;
+            out += avail;
+            n -= avail;
+            continue;
+        }
+        // Miss in the current buffer. Adopt the prefetch buffer if the
+        // position lands inside it.
+        ReadBuffer& next = m_rdbuf[m_currdbuf ^ 1];
+        if (next.pending.valid() || next.data.size()) {
+            finish_prefetch(next);
+            if (m_pos >= next.offset
+                && m_pos < next.offset + int64_t(next.data.size())) {
+                // Was this buffer filled to the brim? If so, the file
+                // continues past it and is worth prefetching further.
+                bool more = (next.data.size() == m_bufsize);
+                m_currdbuf ^= 1;
+                if (more)
+                    start_prefetch(cur /* now the spare */,
+                                   next.offset + int64_t(next.data.size()));
+                continue;
+            }
+        }
+        allhit = false;
+        if (n >= m_bufsize) {
+            // Request at least a whole buffer: read the remainder straight
+            // through, there is nothing to coalesce.
+            size_t r = m_proxy->pread(out, n, m_pos);
+            ++m_stats.fetches;
+            m_stats.bytes_fetched += r;
+            m_pos += r;
+            n -= r;
+            break;  // r < n means EOF or error; either way we're done
+        }
+        // Was this read sequential with the data we last buffered? Only
+        // then is it worth prefetching ahead once the synchronous fill
+        // below completes -- random access would just waste I/O.
+        bool sequential = cur.data.size()
+                          && m_pos == cur.offset + int64_t(cur.data.size());
+        // Synchronously fill the current buffer at the read position.
+        cur.offset = m_pos;
+        cur.data.resize(m_bufsize);
+        size_t r = m_proxy->pread(cur.data.data(), m_bufsize, m_pos);
+        ++m_stats.fetches;
+        m_stats.bytes_fetched += r;
+        cur.data.resize(r);
+        if (!r)
+            break;  // EOF or error
+        if (sequential && r == m_bufsize)
+            start_prefetch(next, cur.offset + int64_t(r));
+    }
+    m_stats.bytes_read += size - n;
+    if (allhit && !n)
+        ++m_stats.read_hits;
+    return size - n;
+}
+
+
+
+size_t
+Filesystem::BufferedIOProxy::write(const void* buf, size_t size)
+{
+    if (!m_proxy || !size || m_mode != Write)
+        return 0;
+    ++m_stats.write_calls;
+    if (size >= m_bufsize) {
+        // Request at least a whole buffer: flush anything pending, then
+        // write straight through.
+        if (!flush_writebehind())
+            return 0;
+        size_t r = m_proxy->pwrite(buf, size, m_pos);
+        ++m_stats.flushes;
+        m_stats.bytes_written += r;
+        m_pos += r;
+        return r;
+    }
+    if (m_wrbuf.size() && m_pos != m_wroffset + int64_t(m_wrbuf.size())) {
+        // Not contiguous with the pending data: flush, start fresh.
+        if (!flush_writebehind())
+            return 0;
+    }
+    if (!m_wrbuf.size()) {
+        m_wrbuf.reserve(m_bufsize);
+        m_wroffset = m_pos;
+    }
+    m_wrbuf.insert(m_wrbuf.end(), (const char*)buf, (const char*)buf + size);
+    m_pos += size;
+    m_stats.bytes_written += size;
+    if (m_wrbuf.size() >= m_bufsize && !flush_writebehind())
+        return 0;
+    return size;
+}
+
+
+
+bool
+Filesystem::BufferedIOProxy::flush_writebehind()
+{
+    if (!m_wrbuf.size())
+        return true;
+    size_t r = m_proxy->pwrite(m_wrbuf.data(), m_wrbuf.size(), m_wroffset);
+    ++m_stats.flushes;
+    bool ok = (r == m_wrbuf.size());
+    if (!ok) {
+        std::string e = m_proxy->error();
+        error(e.size() ? string_view(e) : string_view("write error"));
+    }
+    m_wroffset += m_wrbuf.size();
+    m_wrbuf.clear();
+    return ok;
+}
+
+
+
+size_t
+Filesystem::BufferedIOProxy::size() const
+{
+    // Account for data still sitting in the write-behind buffer.
+    return std::max(m_proxy ? m_proxy->size() : size_t(0),
+                    size_t(m_wroffset) + m_wrbuf.size());
+}
+
+
+
+void
+Filesystem::BufferedIOProxy::flush() const
+{
+    // Cast away const to push out the pending write-behind data --
+    // flush() is morally non-mutating even though it empties the buffer.
+    const_cast<BufferedIOProxy*>(this)->flush_writebehind();
+    if (m_proxy)
+        m_proxy->flush();
+}
+
+
+
+bool
+Filesystem::BufferedIOProxy::sync()
+{
+    bool ok = flush_writebehind();
+    if (m_proxy)
+        ok &= m_proxy->sync();
+    return ok;
+}
+
+
+
+Filesystem::SyncGroup::~SyncGroup() { sync(); }
+
+
+
+void
+Filesystem::SyncGroup::add(IOProxy* proxy)
+{
+    if (!proxy)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::find(m_proxies.begin(), m_proxies.end(), proxy)
+        == m_proxies.end())
+        m_proxies.push_back(proxy);
+}
+
+
+
+void
+Filesystem::SyncGroup::remove(IOProxy* proxy)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_proxies.erase(std::remove(m_proxies.begin(), m_proxies.end(), proxy),
+                    m_proxies.end());
+}
+
+
+
+bool
+Filesystem::SyncGroup::frame_done()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_interval <= 0 || ++m_count < m_interval)
+            return true;
+    }
+    return sync();
+}
+
+
+
+bool
+Filesystem::SyncGroup::sync()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool ok = true;
+    for (IOProxy* p : m_proxies)
+        ok &= p->sync();
+    m_count = 0;
+    return ok;
+}
+
+
 OIIO_NAMESPACE_END
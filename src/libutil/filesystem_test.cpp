@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: Apache-2.0
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -594,6 +596,89 @@ test_mem_proxies()
 
 
 
+void
+test_buffered_proxy()
+{
+    std::cout << "Testing buffered I/O proxy:\n";
+    // Build a pattern buffer spanning several buffering units.
+    const size_t len = 20000;
+    std::vector<unsigned char> input_buf(len);
+    for (size_t i = 0; i < len; ++i)
+        input_buf[i] = (unsigned char)(i * 2557);
+
+    // Read through a BufferedIOProxy in small odd-sized increments and
+    // make sure we reconstruct the input exactly.
+    Filesystem::IOMemReader mem(input_buf);
+    Filesystem::BufferedIOProxy in(&mem, 4096);
+    std::vector<unsigned char> check;
+    unsigned char b[7];
+    size_t r;
+    while ((r = in.read(b, sizeof(b))))
+        check.insert(check.end(), b, b + r);
+    OIIO_CHECK_ASSERT(check == input_buf);
+    auto rstats = in.stats();
+    OIIO_CHECK_EQUAL(rstats.bytes_read, len);
+    // The thousands of small reads should have collapsed into a handful
+    // of large fetches from the wrapped proxy.
+    OIIO_CHECK_ASSERT(rstats.fetches <= 2 * (len / 4096 + 1));
+    OIIO_CHECK_ASSERT(rstats.read_hits > 0);
+    // Seeking and re-reading still yields the right data.
+    in.seek(5000);
+    OIIO_CHECK_EQUAL(in.read(b, 4), 4);
+    OIIO_CHECK_ASSERT(!memcmp(b, &input_buf[5000], 4));
+
+    // Write through a BufferedIOProxy in small increments and make sure
+    // the wrapped proxy receives the coalesced result.
+    std::vector<unsigned char> output_buf;
+    Filesystem::IOVecOutput vec(output_buf);
+    Filesystem::BufferedIOProxy out(&vec, 4096);
+    for (size_t i = 0; i < len; i += 5) {
+        size_t n = std::min(size_t(5), len - i);
+        OIIO_CHECK_EQUAL(out.write(&input_buf[i], n), n);
+    }
+    out.flush();
+    OIIO_CHECK_ASSERT(output_buf == input_buf);
+    auto wstats = out.stats();
+    OIIO_CHECK_EQUAL(wstats.bytes_written, len);
+    OIIO_CHECK_ASSERT(wstats.flushes <= len / 4096 + 1);
+}
+
+
+
+void
+test_sync_group()
+{
+    std::cout << "Testing sync group:\n";
+    struct CountingProxy final : public Filesystem::IOVecOutput {
+        int syncs = 0;
+        bool sync() override
+        {
+            ++syncs;
+            return IOVecOutput::sync();
+        }
+    };
+    CountingProxy a, b;
+    {
+        Filesystem::SyncGroup group(3);  // sync every 3 frames
+        group.add(&a);
+        group.add(&b);
+        group.add(&a);  // duplicate add is a no-op
+        OIIO_CHECK_ASSERT(group.frame_done());
+        OIIO_CHECK_ASSERT(group.frame_done());
+        OIIO_CHECK_EQUAL(a.syncs, 0);  // not yet at the interval
+        OIIO_CHECK_ASSERT(group.frame_done());
+        OIIO_CHECK_EQUAL(a.syncs, 1);
+        OIIO_CHECK_EQUAL(b.syncs, 1);
+        OIIO_CHECK_ASSERT(group.sync());  // explicit group sync
+        OIIO_CHECK_EQUAL(a.syncs, 2);
+        group.remove(&b);
+    }  // destruction syncs remaining members
+    OIIO_CHECK_EQUAL(a.syncs, 3);
+    OIIO_CHECK_EQUAL(b.syncs, 2);
+}
+
+
+
 void
 test_last_write_time()
 {
@@ -616,6 +701,8 @@ main(int /*argc*/, char* /*argv*/[])
     test_frame_sequences();
     test_scan_sequences();
     test_mem_proxies();
+    test_buffered_proxy();
+    test_sync_group();
     test_last_write_time();
 
     return unit_test_failures;
@@ -117,6 +117,93 @@ test_parallel_for_2D()
 
 
 
+void
+test_parallel_for_2D_affinity()
+{
+    // Same as test_parallel_for_2D, but with worker-affinity scheduling,
+    // which aims each chunk at a deterministically chosen pool worker.
+    const int size = 100;
+    std::vector<int> vals(size * size, 0);
+
+    parallel_for_chunked_2D(
+        0, size, 10, 0, size, 10,
+        [&](int64_t xb, int64_t xe, int64_t yb, int64_t ye) {
+            for (auto j = yb; j < ye; ++j)
+                for (auto i = xb; i < xe; ++i)
+                    vals[j * size + i] += 1;
+        },
+        paropt().affinity(true));
+
+    // Verify that all elements are exactly 1
+    bool all_one = std::all_of(vals.cbegin(), vals.cend(),
+                               [&](int i) { return vals[i] == 1; });
+    OIIO_CHECK_ASSERT(all_one);
+}
+
+
+
+void
+test_parallel_sort()
+{
+    // Sort a deterministic pseudo-random array, with minitems set small
+    // enough that multiple chunks (and merge rounds) actually happen.
+    const int length = 20000;
+    std::vector<int> vals(length);
+    uint32_t seed = 1;
+    for (int i = 0; i < length; ++i) {
+        seed    = 1664525 * seed + 1013904223;  // cheap LCG
+        vals[i] = int(seed % 9973);
+    }
+    parallel_sort(vals.begin(), vals.end(), std::less<>(),
+                  paropt().minitems(1000));
+    OIIO_CHECK_ASSERT(std::is_sorted(vals.begin(), vals.end()));
+}
+
+
+
+void
+test_parallel_reduce()
+{
+    const int64_t length = 20000;
+    int64_t sum          = parallel_reduce(
+        int64_t(0), length, int64_t(0),
+        [](int64_t b, int64_t e) {
+            int64_t s = 0;
+            for (int64_t i = b; i < e; ++i)
+                s += i;
+            return s;
+        },
+        [](const int64_t& a, const int64_t& b) { return a + b; },
+        paropt().minitems(1000));
+    OIIO_CHECK_EQUAL(sum, length * (length - 1) / 2);
+}
+
+
+
+void
+test_parallel_scan()
+{
+    const int length = 20000;
+    std::vector<int64_t> vals(length, 1);
+    std::vector<int64_t> prefix(length, 0);
+    int64_t total = parallel_scan(vals.begin(), vals.end(), prefix.begin(),
+                                  int64_t(0), std::plus<int64_t>(),
+                                  paropt().minitems(1000));
+    OIIO_CHECK_EQUAL(total, int64_t(length));
+    bool ok = true;
+    for (int i = 0; i < length; ++i)
+        ok &= (prefix[i] == i + 1);
+    OIIO_CHECK_ASSERT(ok);
+
+    // Also check the in-place case (src and dest the same).
+    total = parallel_scan(prefix.begin(), prefix.end(), prefix.begin(),
+                          int64_t(0), std::plus<int64_t>(),
+                          paropt().minitems(1000));
+    OIIO_CHECK_EQUAL(total, int64_t(length) * (length + 1) / 2);
+}
+
+
+
 void
 test_thread_pool_recursion()
 {
@@ -192,6 +279,10 @@ main(int argc, char** argv)
 
     test_parallel_for();
     test_parallel_for_2D();
+    test_parallel_for_2D_affinity();
+    test_parallel_sort();
+    test_parallel_reduce();
+    test_parallel_scan();
     time_parallel_for();
     test_thread_pool_recursion();
     test_empty_thread_pool();
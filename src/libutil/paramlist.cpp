@@ -383,9 +383,66 @@ ParamValue::clear_value() noexcept
 
 
 
+// Lists smaller than this are searched with a plain linear scan; the hash
+// index only pays for itself on the big metadata lists.
+static const size_t index_size_threshold = 32;
+
+
+void
+ParamValueList::build_index() const
+{
+    m_index.clear();
+    m_index.reserve(size());
+    m_index_data  = data();
+    m_index_size  = size();
+    m_index_state = IndexUsable;
+    for (size_t i = 0, e = size(); i < e; ++i) {
+        ustring lowername(Strutil::lower((*this)[i].name()));
+        if (!m_index.emplace(lowername, int(i)).second) {
+            // Two entries with case-colliding names: a hash table can't
+            // answer order-sensitive searches, so mark the list unindexable
+            // (until a mutation gives us reason to try again).
+            m_index.clear();
+            m_index_state = IndexUnusable;
+            return;
+        }
+    }
+}
+
+
+
+int
+ParamValueList::index_lookup(string_view name, TypeDesc type,
+                             bool casesensitive) const
+{
+    if (size() < index_size_threshold)
+        return -1;
+    spin_lock lock(m_index_mutex);
+    if (m_index_state == IndexNone || m_index_data != data()
+        || m_index_size != size())
+        build_index();
+    if (m_index_state != IndexUsable)
+        return -1;
+    auto f = m_index.find(ustring(Strutil::lower(name)));
+    if (f == m_index.end())
+        return 0;
+    const ParamValue& p = (*this)[f->second];
+    // Since indexed names are unique (case-insensitively), a mismatch here
+    // means no entry in the list can match.
+    if (casesensitive && p.name() != name)
+        return 0;
+    if (type != TypeDesc::UNKNOWN && type != p.type())
+        return 0;
+    return 1 + f->second;
+}
+
+
+
 ParamValueList::const_iterator
 ParamValueList::find(ustring name, TypeDesc type, bool casesensitive) const
 {
+    if (int i = index_lookup(name, type, casesensitive); i >= 0)
+        return i ? cbegin() + (i - 1) : cend();
     if (casesensitive) {
         for (const_iterator i = cbegin(), e = cend(); i != e; ++i) {
             if (i->name() == name
@@ -407,6 +464,8 @@ ParamValueList::find(ustring name, TypeDesc type, bool casesensitive) const
 ParamValueList::const_iterator
 ParamValueList::find(string_view name, TypeDesc type, bool casesensitive) const
 {
+    if (int i = index_lookup(name, type, casesensitive); i >= 0)
+        return i ? cbegin() + (i - 1) : cend();
     if (casesensitive) {
         return find(ustring(name), type, casesensitive);
     } else {
@@ -424,6 +483,8 @@ ParamValueList::find(string_view name, TypeDesc type, bool casesensitive) const
 ParamValueList::iterator
 ParamValueList::find(ustring name, TypeDesc type, bool casesensitive)
 {
+    if (int i = index_lookup(name, type, casesensitive); i >= 0)
+        return i ? begin() + (i - 1) : end();
     if (casesensitive) {
         for (iterator i = begin(), e = end(); i != e; ++i) {
             if (i->name() == name
@@ -445,6 +506,8 @@ ParamValueList::find(ustring name, TypeDesc type, bool casesensitive)
 ParamValueList::iterator
 ParamValueList::find(string_view name, TypeDesc type, bool casesensitive)
 {
+    if (int i = index_lookup(name, type, casesensitive); i >= 0)
+        return i ? begin() + (i - 1) : end();
     if (casesensitive) {
         return find(ustring(name), type, casesensitive);
     } else {
@@ -624,6 +687,9 @@ ParamValueList::getattribute_indexed(string_view name, int index,
 void
 ParamValueList::sort(bool casesensitive)
 {
+    // Reordering invalidates the name index without changing the size or
+    // storage, so it won't be detected lazily; invalidate it explicitly.
+    m_index_state = IndexNone;
     if (casesensitive)
         std::sort(begin(), end(),
                   [&](const ParamValue& a, const ParamValue& b) -> bool {
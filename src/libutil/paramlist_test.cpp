@@ -458,6 +458,43 @@ test_paramlistspan()
 
 
 
+static void
+test_indexed_find()
+{
+    std::cout << "test_indexed_find\n";
+    // Build a list big enough to trigger the lazy hash index and make sure
+    // searches behave identically to the small-list linear scan.
+    ParamValueList pl;
+    for (int i = 0; i < 100; ++i)
+        pl.attribute(Strutil::fmt::format("attrib{:03d}", i), i);
+    OIIO_CHECK_EQUAL(pl.get_int("attrib042"), 42);
+    OIIO_CHECK_ASSERT(pl.find("attrib099") != pl.end());
+    OIIO_CHECK_ASSERT(pl.find("notthere") == pl.end());
+    OIIO_CHECK_ASSERT(pl.find("ATTRIB042", TypeUnknown, false) != pl.end());
+    OIIO_CHECK_ASSERT(pl.find("ATTRIB042", TypeUnknown, true) == pl.end());
+    OIIO_CHECK_ASSERT(pl.find("attrib042", TypeDesc::INT) != pl.end());
+    OIIO_CHECK_ASSERT(pl.find("attrib042", TypeDesc::FLOAT) == pl.end());
+
+    // Mutations after the index is built must be reflected in searches.
+    pl.attribute("newcomer", 1.5f);
+    OIIO_CHECK_EQUAL(pl.get_float("newcomer"), 1.5f);
+    pl.remove("attrib050");
+    OIIO_CHECK_ASSERT(pl.find("attrib050") == pl.end());
+    OIIO_CHECK_EQUAL(pl.get_int("attrib099"), 99);
+    pl.sort();
+    OIIO_CHECK_EQUAL(pl.get_int("attrib000"), 0);
+    OIIO_CHECK_EQUAL(pl.get_int("attrib099"), 99);
+
+    // A list with case-colliding duplicate names can't be indexed; searches
+    // must still honor first-match order via the linear scan.
+    pl.emplace_back("Dup", 1);
+    pl.emplace_back("dup", 2);
+    OIIO_CHECK_EQUAL(pl.get_int("dup"), 1);  // case-insensitive first match
+    OIIO_CHECK_EQUAL(pl.find("dup", TypeUnknown, true)->get_int(), 2);
+}
+
+
+
 static void
 print_pv(const ParamValue& pv)
 {
@@ -533,6 +570,7 @@ main(int /*argc*/, char* /*argv*/[])
     test_delegates();
     test_implied_construction();
     test_paramlistspan();
+    test_indexed_find();
 
     return unit_test_failures;
 }
@@ -0,0 +1,322 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include <OpenImageIO/filesystem.h>
+#include <OpenImageIO/profiler.h>
+#include <OpenImageIO/strutil.h>
+#include <OpenImageIO/sysutil.h>
+#include <OpenImageIO/thread.h>
+
+#ifdef _WIN32
+#    include <windows.h>
+#endif
+
+
+OIIO_NAMESPACE_BEGIN
+
+namespace Profiler {
+namespace pvt {
+std::atomic<int> profiler_enabled { 0 };
+}
+}  // namespace Profiler
+
+
+namespace {
+
+// Same platform tick source as Timer (timer.h keeps its now() private, and
+// we don't want a Timer object per zone).
+inline Timer::ticks_t
+now_ticks()
+{
+#ifdef _WIN32
+    LARGE_INTEGER n;
+    QueryPerformanceCounter(&n);
+    return n.QuadPart;
+#elif defined(__APPLE__)
+    return mach_absolute_time();
+#elif OIIO_TIMER_LINUX_USE_clock_gettime
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return int64_t(t.tv_sec) * int64_t(1000000000) + t.tv_nsec;
+#else
+    struct timeval t;
+    gettimeofday(&t, NULL);
+    return int64_t(t.tv_sec) * int64_t(1000000) + t.tv_usec;
+#endif
+}
+
+
+// One completed zone. Zones are appended as they close, so a thread's
+// buffer holds children before their parents; the nesting is recovered
+// from the start/stop intervals when a report is requested.
+struct ZoneRecord {
+    ustring name;
+    Timer::ticks_t start;
+    Timer::ticks_t stop;
+};
+
+
+// The per-thread zone buffer. Buffers are owned by the central registry
+// (as shared_ptrs, co-owned by the creating thread's thread_local) so they
+// survive thread exit and can be merged later.
+struct ThreadBuffer {
+    std::vector<ZoneRecord> zones;
+    spin_mutex mutex;  // guards zones against a concurrent merge/clear
+    size_t index;      // position in the registry, for trace labeling
+};
+
+
+class ZoneRegistry {
+public:
+    std::shared_ptr<ThreadBuffer> create_buffer()
+    {
+        auto buf = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        buf->index = m_buffers.size();
+        m_buffers.push_back(buf);
+        return buf;
+    }
+
+    // Run f(buffer) on every registered buffer.
+    template<typename F> void foreach (F f)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& b : m_buffers)
+            f(*b);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+};
+
+
+ZoneRegistry&
+zone_registry()
+{
+    static ZoneRegistry registry;
+    return registry;
+}
+
+
+ThreadBuffer&
+thread_buffer()
+{
+    static thread_local std::shared_ptr<ThreadBuffer> buf
+        = zone_registry().create_buffer();
+    return *buf;
+}
+
+
+// A node of the merged parent/child tree built by report().
+struct TreeNode {
+    Timer::ticks_t ticks = 0;
+    size_t count         = 0;
+    std::map<ustring, TreeNode> children;
+};
+
+
+void
+print_tree(std::ostream& out, const std::map<ustring, TreeNode>& children,
+           int indent)
+{
+    // Biggest time first; name breaks ties for deterministic output.
+    std::vector<const std::pair<const ustring, TreeNode>*> order;
+    for (const auto& c : children)
+        order.push_back(&c);
+    std::sort(order.begin(), order.end(), [](const auto* a, const auto* b) {
+        if (a->second.ticks != b->second.ticks)
+            return a->second.ticks > b->second.ticks;
+        return a->first < b->first;
+    });
+    for (const auto* c : order) {
+        const TreeNode& node(c->second);
+        Timer::ticks_t childticks = 0;
+        for (const auto& gc : node.children)
+            childticks += gc.second.ticks;
+        print(out, "{:{}}{:24} {:8d} {:10.3f}s", "", indent, c->first,
+              node.count, Timer::seconds(node.ticks));
+        if (childticks)
+            print(out, "  (self {:.3f}s)",
+                  Timer::seconds(node.ticks - childticks));
+        print(out, "\n");
+        print_tree(out, node.children, indent + 2);
+    }
+}
+
+// The trace-file sink: a path registered here is written (as Chrome trace
+// JSON) by an atexit handler, so a farm job only needs the environment
+// variable set to produce a flame chart, no code change or rebuild.
+std::mutex trace_file_mutex;
+std::string trace_file_path;
+std::once_flag trace_file_atexit_once;
+
+
+void
+write_trace_file_at_exit()
+{
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(trace_file_mutex);
+        path = trace_file_path;
+    }
+    if (path.empty())
+        return;
+    std::string json = Profiler::chrome_trace();
+    OIIO::ofstream out;
+    Filesystem::open(out, path);
+    if (out)
+        out << json;
+}
+
+
+// Static initializer that honors OPENIMAGEIO_TRACE_FILE at load time.
+struct TraceEnvInit {
+    TraceEnvInit()
+    {
+        std::string path = Sysutil::getenv("OPENIMAGEIO_TRACE_FILE");
+        if (!path.empty())
+            Profiler::set_trace_file(path);
+    }
+} trace_env_init;
+
+}  // namespace
+
+
+
+namespace Profiler {
+
+void
+enable(bool on)
+{
+    pvt::profiler_enabled.store(on ? 1 : 0);
+}
+
+
+
+bool
+enabled()
+{
+    return pvt::profiler_enabled.load() != 0;
+}
+
+
+
+void
+clear()
+{
+    zone_registry().foreach ([](ThreadBuffer& buf) {
+        spin_lock lock(buf.mutex);
+        buf.zones.clear();
+    });
+}
+
+
+
+std::string
+report()
+{
+    // Merge every thread's zones into one tree keyed by call path. Within
+    // a thread, sorting by start tick and replaying against a stack of
+    // still-open intervals recovers the nesting.
+    TreeNode root;
+    zone_registry().foreach ([&](ThreadBuffer& buf) {
+        std::vector<ZoneRecord> zones;
+        {
+            spin_lock lock(buf.mutex);
+            zones = buf.zones;
+        }
+        std::sort(zones.begin(), zones.end(),
+                  [](const ZoneRecord& a, const ZoneRecord& b) {
+                      return a.start < b.start;
+                  });
+        std::vector<std::pair<Timer::ticks_t, TreeNode*>> stack;  // stop,node
+        for (const ZoneRecord& z : zones) {
+            while (stack.size() && z.start >= stack.back().first)
+                stack.pop_back();
+            TreeNode* parent = stack.size() ? stack.back().second : &root;
+            TreeNode& node   = parent->children[z.name];
+            node.ticks += z.stop - z.start;
+            node.count += 1;
+            stack.emplace_back(z.stop, &node);
+        }
+    });
+
+    std::stringstream out;
+    print_tree(out, root.children, 0);
+    return out.str();
+}
+
+
+
+void
+set_trace_file(string_view path)
+{
+    {
+        std::lock_guard<std::mutex> lock(trace_file_mutex);
+        trace_file_path = path;
+    }
+    if (path.size()) {
+        enable(true);
+        std::call_once(trace_file_atexit_once,
+                       []() { std::atexit(write_trace_file_at_exit); });
+    }
+}
+
+
+
+std::string
+chrome_trace()
+{
+    std::stringstream out;
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    zone_registry().foreach ([&](ThreadBuffer& buf) {
+        spin_lock lock(buf.mutex);
+        for (const ZoneRecord& z : buf.zones) {
+            print(out,
+                  "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},"
+                  "\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                  first ? "" : ",", Strutil::escape_chars(z.name),
+                  buf.index + 1, Timer::seconds(z.start) * 1.0e6,
+                  Timer::seconds(z.stop - z.start) * 1.0e6);
+            first = false;
+        }
+    });
+    out << "]}\n";
+    return out.str();
+}
+
+}  // namespace Profiler
+
+
+
+void
+ProfilerZone::open(ustring name)
+{
+    m_name  = name;
+    m_start = now_ticks();
+}
+
+
+
+void
+ProfilerZone::close()
+{
+    Timer::ticks_t stop = now_ticks();
+    ThreadBuffer& buf(thread_buffer());
+    spin_lock lock(buf.mutex);
+    buf.zones.push_back({ m_name, m_start, stop });
+}
+
+
+OIIO_NAMESPACE_END
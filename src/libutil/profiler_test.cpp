@@ -0,0 +1,121 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+
+#include <thread>
+#include <vector>
+
+#include <OpenImageIO/benchmark.h>
+#include <OpenImageIO/profiler.h>
+#include <OpenImageIO/strutil.h>
+#include <OpenImageIO/unittest.h>
+
+#include <iostream>
+
+using namespace OIIO;
+
+
+static void
+leaf_work()
+{
+    ProfilerZone zone(ustring("leaf"));
+    float f = 0.5f;
+    for (int i = 0; i < 100; ++i)
+        f = std::sqrt(f + 1.0f);
+    DoNotOptimize(f);
+}
+
+
+
+static void
+branch_work()
+{
+    ProfilerZone zone(ustring("branch"));
+    for (int i = 0; i < 10; ++i)
+        leaf_work();
+}
+
+
+
+void
+test_hierarchy()
+{
+    Profiler::clear();
+    Profiler::enable(true);
+    {
+        ProfilerZone zone(ustring("top"));
+        branch_work();
+        branch_work();
+        leaf_work();
+    }
+    Profiler::enable(false);
+
+    std::string rep = Profiler::report();
+    std::cout << "Report:\n" << rep << "\n";
+    // "leaf" appears both under "branch" (2x10 calls) and directly under
+    // "top" (1 call), so the report must list it twice at different depths.
+    OIIO_CHECK_EQUAL(Strutil::contains(rep, "top"), true);
+    OIIO_CHECK_EQUAL(Strutil::contains(rep, "branch"), true);
+    size_t first = rep.find("leaf");
+    OIIO_CHECK_ASSERT(first != std::string::npos
+                      && rep.find("leaf", first + 1) != std::string::npos);
+}
+
+
+
+void
+test_threads()
+{
+    Profiler::clear();
+    Profiler::enable(true);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < 4; ++t)
+        pool.emplace_back(branch_work);
+    for (auto& t : pool)
+        t.join();
+    Profiler::enable(false);
+
+    // All four threads' identical call paths merge into one tree.
+    std::string rep = Profiler::report();
+    OIIO_CHECK_EQUAL(Strutil::contains(rep, "branch"), true);
+    OIIO_CHECK_EQUAL(Strutil::contains(rep, "40"), true);  // 4 x 10 leaves
+
+    std::string trace = Profiler::chrome_trace();
+    OIIO_CHECK_EQUAL(Strutil::contains(trace, "\"traceEvents\""), true);
+    OIIO_CHECK_EQUAL(Strutil::contains(trace, "\"leaf\""), true);
+}
+
+
+
+void
+test_disabled_is_cheap()
+{
+    Profiler::clear();
+    // Zones entered while disabled must record nothing.
+    {
+        ProfilerZone zone(ustring("invisible"));
+    }
+    OIIO_CHECK_EQUAL(Profiler::report(), "");
+
+    Benchmarker bench;
+    bench("disabled ProfilerZone",
+          [&]() { ProfilerZone zone(ustring("invisible")); });
+    Profiler::enable(true);
+    bench("enabled ProfilerZone",
+          [&]() { ProfilerZone zone(ustring("visible")); });
+    Profiler::enable(false);
+    Profiler::clear();
+}
+
+
+
+int
+main(int /*argc*/, char** /*argv*/)
+{
+    test_hierarchy();
+    test_threads();
+    test_disabled_is_cheap();
+
+    return unit_test_failures;
+}
@@ -1619,6 +1619,10 @@ void test_mathfuncs ()
                 mkvec<VEC>(fast_log(expA[0]), fast_log(expA[1]), fast_log(expA[2]), fast_log(expA[3])), 0.00001f);
     OIIO_CHECK_SIMD_EQUAL_THRESH (fast_pow_pos(VEC(2.0f), A),
                            mkvec<VEC>(0.5f, 1.0f, 2.0f, 22.62741699796952f), 0.0001f);
+    OIIO_CHECK_SIMD_EQUAL_THRESH (fast_erf(F),
+                mkvec<VEC>(fast_erf(F[0]), fast_erf(F[1]), fast_erf(F[2]), fast_erf(F[3])), 1e-6f);
+    OIIO_CHECK_SIMD_EQUAL_THRESH (fast_erfc(F),
+                mkvec<VEC>(fast_erfc(F[0]), fast_erfc(F[1]), fast_erfc(F[2]), fast_erfc(F[3])), 1e-6f);
 
     OIIO_CHECK_SIMD_EQUAL (safe_div(mkvec<VEC>(1.0f,2.0f,3.0f,4.0f), mkvec<VEC>(2.0f,0.0f,2.0f,0.0f)),
                            mkvec<VEC>(0.5f,0.0f,1.5f,0.0f));
@@ -1664,6 +1668,8 @@ void test_mathfuncs ()
     benchmark ("simd fast_log", fast_log<VEC>, VEC(0.67f));
     benchmark2 ("float powf", powf, 0.67f, 0.67f);
     benchmark2 ("simd fast_pow_pos", [](const VEC& x,const VEC& y){ return fast_pow_pos(x,y); }, VEC(0.67f), VEC(0.67f));
+    benchmark ("float fast_erf", [](float x){ return fast_erf(x); }, 0.67f);
+    benchmark ("simd fast_erf", [](const VEC& v){ return fast_erf(v); }, VEC(0.67f));
     benchmark ("float sqrt", sqrtf, 4.0f);
     benchmark ("simd sqrt", [](const VEC& v){ return sqrt(v); }, mkvec<VEC>(1.0f,4.0f,9.0f,16.0f));
     benchmark ("float rsqrt", rsqrtf, 4.0f);
@@ -33,6 +33,7 @@ static spin_mutex print_mutex;  // make the prints not clobber each other
 long long accum = 0;
 float faccum    = 0;
 spin_mutex mymutex;
+adaptive_mutex myadaptivemutex;
 
 
 
@@ -49,6 +50,11 @@ time_lock_cycle()
         sm.lock();
         sm.unlock();
     });
+    adaptive_mutex am;
+    bench("adaptive_mutex", [&]() {
+        am.lock();
+        am.unlock();
+    });
     bench("std::mutex", [&]() {
         m.lock();
         m.unlock();
@@ -89,6 +95,17 @@ do_accum(int iterations)
 
 
 
+static void
+do_accum_adaptive(int iterations)
+{
+    for (int i = 0; i < iterations; ++i) {
+        adaptive_lock lock(myadaptivemutex);
+        accum += 1;
+    }
+}
+
+
+
 static void
 getargs(int argc, char* argv[])
 {
@@ -130,5 +147,26 @@ main(int argc, char* argv[])
         timed_thread_wedge(do_accum, numthreads, iterations, ntrials,
                            numthreads);
 
+    std::cout << "\nTiming thread contention for adaptive_mutex...\n";
+    accum = 0;
+    if (wedge)
+        timed_thread_wedge(do_accum_adaptive, numthreads, iterations, ntrials);
+    else
+        timed_thread_wedge(do_accum_adaptive, numthreads, iterations, ntrials,
+                           numthreads);
+
+    // Correctness: exact count with an adaptive_mutex, including with a
+    // zero spin budget (pure blocking mode).
+    for (int spins : { 64, 0 }) {
+        pvt::adaptive_mutex_spins = spins;
+        accum                     = 0;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numthreads; ++t)
+            threads.emplace_back(do_accum_adaptive, 1000000);
+        for (auto& t : threads)
+            t.join();
+        OIIO_CHECK_EQUAL(accum, 1000000LL * numthreads);
+    }
+
     return unit_test_failures;
 }
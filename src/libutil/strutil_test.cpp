@@ -951,6 +951,10 @@ test_numeric_conversion()
     OIIO_CHECK_EQUAL(Strutil::stof(" 123.45 "), 123.45f);
     OIIO_CHECK_EQUAL(Strutil::stof("123.45+12"), 123.45f);
     OIIO_CHECK_EQUAL(Strutil::stof("1.2345e+2"), 123.45f);
+    OIIO_CHECK_EQUAL(Strutil::stof("+2.5"), 2.5f);
+    OIIO_CHECK_EQUAL(Strutil::stof("0x1p2"), 4.0f);
+    OIIO_CHECK_EQUAL(Strutil::stof("1e50"),
+                     std::numeric_limits<float>::infinity());
 
     OIIO_CHECK_EQUAL(Strutil::stof("hi", &pos), 0.0f);
     OIIO_CHECK_EQUAL(pos, 0);
@@ -1403,6 +1407,25 @@ void test_parse ()
                           && sv == ", 4, 5,6");
     }
 
+    {
+        // parse_floats: bulk runs, short runs are not failures
+        string_view sv;
+        float vals[4] = { 0, 0, 0, 0 };
+        sv            = " 1 2.5 -3e1 4 5";
+        OIIO_CHECK_EQUAL(parse_floats(sv, vals), 4);
+        OIIO_CHECK_ASSERT(vals[0] == 1 && vals[1] == 2.5f && vals[2] == -30
+                          && vals[3] == 4 && sv == " 5");
+        sv = " 1 2 shazbot";
+        OIIO_CHECK_EQUAL(parse_floats(sv, vals), 2);
+        OIIO_CHECK_ASSERT(vals[0] == 1 && vals[1] == 2 && sv == " shazbot");
+        sv = "1, 2, 3, 4, 5";
+        OIIO_CHECK_EQUAL(parse_floats(sv, vals, ","), 4);
+        OIIO_CHECK_ASSERT(vals[3] == 4 && sv == ", 5");
+        sv = "nope";
+        OIIO_CHECK_EQUAL(parse_floats(sv, vals), 0);
+        OIIO_CHECK_ASSERT(sv == "nope");
+    }
+
     string_view ss;
     s = "foo bar";
     OIIO_CHECK_ASSERT (parse_string (s, ss) && ss == "foo" && s == " bar");
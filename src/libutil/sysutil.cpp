@@ -17,6 +17,7 @@
 #include <thread>
 
 #ifdef __linux__
+#    include <sched.h>
 #    include <sys/ioctl.h>
 #    include <sys/sysinfo.h>
 #    include <unistd.h>
@@ -602,6 +603,68 @@ Sysutil::physical_concurrency()
 
 
 
+unsigned int
+Sysutil::numa_node_count()
+{
+#if defined(__linux__)
+    static unsigned int count = []() -> unsigned int {
+        unsigned int n = 0;
+        while (Filesystem::exists(
+            Strutil::fmt::format("/sys/devices/system/node/node{}", n)))
+            ++n;
+        return n ? n : 1;
+    }();
+    return count;
+#elif defined(_WIN32)
+    ULONG highest = 0;
+    if (GetNumaHighestNodeNumber(&highest))
+        return (unsigned int)highest + 1;
+    return 1;
+#else
+    return 1;
+#endif
+}
+
+
+
+bool
+Sysutil::pin_this_thread_to_numa_node(unsigned int node)
+{
+#if defined(__linux__)
+    // The kernel publishes each node's processors as a cpulist, e.g.
+    // "0-15,32-47". Parse it into a cpu_set_t and restrict ourselves
+    // to those CPUs.
+    std::string cpulist;
+    if (!Filesystem::read_text_file(
+            Strutil::fmt::format("/sys/devices/system/node/node{}/cpulist",
+                                 node),
+            cpulist))
+        return false;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    int ncpus = 0;
+    for (auto range : Strutil::splitsv(Strutil::strip(cpulist), ",")) {
+        int lo = -1, hi = -1;
+        if (!Strutil::parse_int(range, lo))
+            return false;
+        if (Strutil::parse_char(range, '-')) {
+            if (!Strutil::parse_int(range, hi))
+                return false;
+        } else {
+            hi = lo;
+        }
+        for (int c = lo; c <= hi && c < CPU_SETSIZE; ++c, ++ncpus)
+            CPU_SET(c, &cpus);
+    }
+    return ncpus > 0 && sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+    // Not (yet) supported on this platform.
+    return false;
+#endif
+}
+
+
+
 size_t
 Sysutil::max_open_files()
 {
@@ -18,12 +18,14 @@
 #    define _ENABLE_ATOMIC_ALIGNMENT_FIX /* Avoid MSVS error, ugh */
 #endif
 
+#include <deque>
 #include <exception>
 #include <functional>
 #include <future>
 #include <memory>
 
 #include <OpenImageIO/parallel.h>
+#include <OpenImageIO/profiler.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
 #include <OpenImageIO/thread.h>
@@ -45,6 +47,13 @@
 OIIO_NAMESPACE_BEGIN
 namespace pvt {
 
+// Spin budget shared by all adaptive_mutex/adaptive_rw_mutex instances;
+// see the doc comment in thread.h. The default of 64 backoff rounds is a
+// few microseconds -- plenty for the short critical sections these locks
+// guard, while bounding the CPU wasted when the holder has been preempted.
+std::atomic<int> adaptive_mutex_spins { 64 };
+
+
 template<typename T> class ThreadsafeQueue {
 public:
     ThreadsafeQueue(int /*size*/) {}
@@ -81,6 +90,135 @@ private:
     Mutex mutex;
 };
 
+
+
+// Lock-free work-stealing deque, after Chase & Lev, "Dynamic Circular
+// Work-Stealing Deques" (SPAA 2005), using the memory orderings worked out
+// by Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+// Models" (PPoPP 2013). The owning thread pushes and pops at the bottom
+// with no locks and (usually) no contended atomic RMW; any other thread
+// may steal from the top. T must be trivially copyable -- we use it for
+// task pointers.
+template<typename T> class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(int64_t capacity = 64)
+    {
+        m_ring.store(new Ring(capacity), std::memory_order_relaxed);
+    }
+
+    ~WorkStealingDeque()
+    {
+        // Free the current ring and any smaller retired incarnations.
+        for (Ring* r = m_ring.load(std::memory_order_relaxed); r;) {
+            Ring* prev = r->retired;
+            delete r;
+            r = prev;
+        }
+    }
+
+    // Push v onto the bottom. Owner thread only.
+    void push(T v)
+    {
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_acquire);
+        Ring* r   = m_ring.load(std::memory_order_relaxed);
+        if (b - t > r->capacity - 1) {
+            // Full: double the ring. The old ring is kept around (chained
+            // off the new one) rather than freed, because concurrent
+            // thieves may still be reading it.
+            Ring* bigger = new Ring(r->capacity * 2);
+            for (int64_t i = t; i < b; ++i)
+                bigger->put(i, r->get(i));
+            bigger->retired = r;
+            m_ring.store(bigger, std::memory_order_release);
+            r = bigger;
+        }
+        r->put(b, v);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Pop from the bottom into v, returning true if anything was there.
+    // Owner thread only.
+    bool pop(T& v)
+    {
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Ring* r   = m_ring.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        if (t > b) {
+            m_bottom.store(b + 1, std::memory_order_relaxed);  // was empty
+            return false;
+        }
+        v = r->get(b);
+        if (t == b) {
+            // Taking the last element: race the thieves for it.
+            bool won = m_top.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst,
+                std::memory_order_relaxed);
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Steal from the top into v, returning true on success. Any thread.
+    bool steal(T& v)
+    {
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return false;  // empty
+        Ring* r = m_ring.load(std::memory_order_acquire);
+        v       = r->get(t);
+        return m_top.compare_exchange_strong(t, t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed);
+        // A failed CAS means another thief (or the owner) got there first.
+    }
+
+    // Approximate number of queued items -- racy, only advisory.
+    size_t size() const
+    {
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        return size_t(b > t ? b - t : 0);
+    }
+
+private:
+    struct Ring {
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+        Ring* retired = nullptr;  // previous, smaller incarnation
+        explicit Ring(int64_t cap)
+            : capacity(cap)
+            , mask(cap - 1)
+            , items(new std::atomic<T>[cap])
+        {
+            OIIO_DASSERT((cap & mask) == 0);  // must be a power of 2
+        }
+        T get(int64_t i) const
+        {
+            return items[i & mask].load(std::memory_order_relaxed);
+        }
+        void put(int64_t i, T v)
+        {
+            items[i & mask].store(v, std::memory_order_relaxed);
+        }
+    };
+
+    WorkStealingDeque(const WorkStealingDeque&)            = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Keep the owner-side and thief-side indices on separate cache lines.
+    OIIO_CACHE_ALIGN std::atomic<int64_t> m_bottom { 0 };
+    OIIO_CACHE_ALIGN std::atomic<int64_t> m_top { 0 };
+    OIIO_CACHE_ALIGN std::atomic<Ring*> m_ring;
+};
+
 }  // namespace pvt
 OIIO_NAMESPACE_END
 
@@ -105,6 +243,30 @@ threads_default()
 
 
 
+// Which pool (if any) is the current thread a worker of, and what is its
+// worker index in that pool? Used to route task pushes from a worker to
+// its own work-stealing deque rather than the contended central queue.
+static thread_local void* tl_worker_pool  = nullptr;
+static thread_local int tl_worker_index = -1;
+
+
+// If the user asked for NUMA pinning (OPENIMAGEIO_NUMA_PIN=1) and the
+// machine actually has multiple nodes, return the node count, else 0.
+static int
+numa_pin_nodes()
+{
+    static int nodes = []() -> int {
+        if (Strutil::from_string<int>(Sysutil::getenv("OPENIMAGEIO_NUMA_PIN"))
+            == 0)
+            return 0;
+        int n = int(Sysutil::numa_node_count());
+        return n > 1 ? n : 0;
+    }();
+    return nodes;
+}
+
+
+
 class thread_pool::Impl {
 public:
     Impl(int nThreads = 0, int queueSize = 1024)
@@ -140,11 +302,16 @@ public:
             int oldNThreads = size();
             if (oldNThreads
                 <= nThreads) {  // if the number of threads is increased
+                this->ensure_deques(nThreads);
                 this->threads.resize(nThreads);
                 this->flags.resize(nThreads);
                 for (int i = oldNThreads; i < nThreads; ++i) {
                     this->flags[i] = std::make_shared<std::atomic<bool>>(false);
-                    this->set_thread(i);
+                    // N.B. The OS thread itself is NOT started here -- slots
+                    // are filled lazily by maybe_spawn() the first time work
+                    // is pushed with no idle worker available. A process
+                    // that only ever runs tiny inline-able jobs never pays
+                    // thread creation at all.
                 }
             } else {  // the number of threads is decreased
                 std::vector<std::unique_ptr<std::thread>> terminating_threads;
@@ -158,9 +325,10 @@ public:
                     std::unique_lock<std::mutex> lock(this->mutex);
                     this->cv.notify_all();
                 }
-                // wait for the terminated threads to finish
+                // wait for the terminated threads to finish (slots that
+                // were never lazily spawned hold no thread at all)
                 for (auto& thread : terminating_threads) {
-                    if (thread->joinable())
+                    if (thread && thread->joinable())
                         thread->join();
                 }
                 this->threads.resize(
@@ -169,22 +337,33 @@ public:
                     nThreads);  // safe to delete because the threads have copies of shared_ptr of the flags, not originals
             }
         }
-        m_size = nThreads;
+        m_size      = nThreads;
+        int spawned = 0;
+        for (auto& t : this->threads)
+            spawned += (t != nullptr);
+        m_spawned = spawned;
     }
 
-    // empty the queue
+    // empty the queue and all the per-worker deques
     void clear_queue()
     {
         std::function<void(int id)>* _f;
         while (this->q.pop(_f))
             delete _f;  // empty the queue
+        DequeList* dl = m_deques.load(std::memory_order_acquire);
+        for (auto d : dl->deques)
+            while (d->steal(_f))
+                delete _f;
+        for (auto b : dl->inboxes)
+            while (b->pop(_f))
+                delete _f;
     }
 
     // pops a functional wrapper to the original function
     std::function<void(int)> pop()
     {
         std::function<void(int id)>* _f = nullptr;
-        this->q.pop(_f);
+        this->next_task(-1, _f);
         std::unique_ptr<std::function<void(int id)>> func(
             _f);  // at return, delete the function even if an exception occurred
         std::function<void(int)> f;
@@ -222,6 +401,8 @@ public:
         bool hasTerminatedThread
             = std::any_of(this->threads.begin(), this->threads.end(),
                           [](std::unique_ptr<std::thread>& t) {
+                              if (!t)
+                                  return false;  // slot never spawned
                               DWORD rcode;
                               GetExitCodeThread((HANDLE)t->native_handle(),
                                                 &rcode);
@@ -234,9 +415,10 @@ public:
             std::unique_lock<std::mutex> lock(this->mutex);
             this->cv.notify_all();  // stop all waiting threads
         }
-        // wait for the computing threads to finish
+        // wait for the computing threads to finish (never-spawned slots
+        // hold no thread)
         for (auto& thread : this->threads) {
-            if (thread->joinable())
+            if (thread && thread->joinable())
                 thread->join();
         }
         // if there were no threads in the pool but some functors in the queue, the functors are not deleted by the threads
@@ -248,23 +430,72 @@ public:
 
     void push_queue_and_notify(std::function<void(int id)>* f)
     {
-        this->q.push(f);
+        // A worker of this pool pushes to its own deque -- no contention,
+        // and LIFO order gives good locality for nested tasks. Any other
+        // thread submits through the central queue.
+        DequeList* dl = m_deques.load(std::memory_order_acquire);
+        if (tl_worker_pool == this
+            && size_t(tl_worker_index) < dl->deques.size())
+            dl->deques[tl_worker_index]->push(f);
+        else
+            this->q.push(f);
+        maybe_spawn();
         std::unique_lock<std::mutex> lock(this->mutex);
         this->cv.notify_one();
     }
 
-    // If any tasks are on the queue, pop and run one with the calling
-    // thread.
+    // Targeted variant: drop the task in the preferred worker's inbox, so
+    // that it runs there unless some other worker steals it first. An
+    // out-of-range worker number degrades to the central queue.
+    void push_queue_and_notify(std::function<void(int id)>* f, int worker)
+    {
+        DequeList* dl = m_deques.load(std::memory_order_acquire);
+        if (size_t(worker) < dl->inboxes.size())
+            dl->inboxes[worker]->push(f);
+        else
+            this->q.push(f);
+        maybe_spawn();
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->cv.notify_one();
+    }
+
+    // Spawn a worker lazily: if no existing worker is idle and not all of
+    // the pool's slots have been filled with running OS threads yet, start
+    // one more. Called on every push, but the cheap unlocked test means
+    // the steady state (fully spawned, or somebody idle) costs two atomic
+    // loads. Incremental spawning means short-lived processes with light
+    // parallelism only create the threads they actually need.
+    void maybe_spawn()
+    {
+        if (this->nWaiting > 0 || m_spawned >= m_size || this->isStop
+            || this->isDone)
+            return;
+        std::unique_lock<std::mutex> lock(this->mutex);
+        for (int i = 0; i < m_size; ++i) {
+            if (!this->threads[i]) {
+                this->set_thread(i);
+                m_spawned += 1;
+                break;  // just one; the next push can add another
+            }
+        }
+    }
+
+    // If any tasks are on the queue (or stealable from a worker's deque),
+    // pop and run one with the calling thread.
     bool run_one_task(std::thread::id id)
     {
         std::function<void(int)>* f = nullptr;
-        bool isPop                  = this->q.pop(f);
+        bool isPop                  = this->next_task(-1, f);
         if (isPop) {
             OIIO_DASSERT(f);
             std::unique_ptr<std::function<void(int id)>> func(
                 f);  // at return, delete the function even if an exception occurred
             register_worker(id);
-            (*f)(-1);
+            {
+                static const ustring zone_name("thread_pool task");
+                ProfilerZone zone(zone_name);
+                (*f)(-1);
+            }
             deregister_worker(id);
         } else {
             OIIO_DASSERT(f == nullptr);
@@ -288,7 +519,16 @@ public:
         return m_worker_threadids[id] != 0;
     }
 
-    size_t jobs_in_queue() const { return q.size(); }
+    size_t jobs_in_queue() const
+    {
+        size_t n      = q.size();
+        DequeList* dl = m_deques.load(std::memory_order_acquire);
+        for (auto d : dl->deques)
+            n += d->size();
+        for (auto b : dl->inboxes)
+            n += b->size();
+        return n;
+    }
 
     bool very_busy() const { return jobs_in_queue() > size_t(4 * m_size); }
 
@@ -304,52 +544,148 @@ private:
             this->flags[i]);  // a copy of the shared ptr to the flag
         auto f = [this, i, flag /* a copy of the shared ptr to the flag */]() {
             register_worker(std::this_thread::get_id());
+            tl_worker_pool           = this;
+            tl_worker_index          = i;
+            if (int nodes = numa_pin_nodes()) {
+                // Spread the workers across the NUMA nodes and keep each
+                // one there, so targeted pushes (push_to) can exploit
+                // first-touch memory locality.
+                Sysutil::pin_this_thread_to_numa_node(unsigned(i % nodes));
+            }
             std::atomic<bool>& _flag = *flag;
             std::function<void(int id)>* _f;
-            bool isPop = this->q.pop(_f);
+            bool isPop = this->next_task(i, _f);
             while (true) {
-                while (isPop) {  // if there is anything in the queue
+                while (isPop) {  // if there is anything to run
                     std::unique_ptr<std::function<void(int id)>> func(
                         _f);  // at return, delete the function even if an exception occurred
-                    (*_f)(i);
+                    {
+                        static const ustring zone_name("thread_pool task");
+                        ProfilerZone zone(zone_name);
+                        (*_f)(i);
+                    }
                     if (_flag) {
                         // the thread is wanted to stop, return even if the queue is not empty yet
+                        tl_worker_pool  = nullptr;
+                        tl_worker_index = -1;
                         return;
                     } else {
-                        isPop = this->q.pop(_f);
+                        isPop = this->next_task(i, _f);
                     }
                 }
-                // the queue is empty here, wait for the next command
+                // nothing to run anywhere, wait for the next command
                 std::unique_lock<std::mutex> lock(this->mutex);
                 ++this->nWaiting;
-                this->cv.wait(lock, [this, &_f, &isPop, &_flag]() {
-                    isPop = this->q.pop(_f);
+                this->cv.wait(lock, [this, i, &_f, &isPop, &_flag]() {
+                    isPop = this->next_task(i, _f);
                     return isPop || this->isDone || _flag;
                 });
                 --this->nWaiting;
                 if (!isPop)
-                    break;  // if the queue is empty and this->isDone == true or *flag then return
+                    break;  // if there is no work and this->isDone == true or *flag then return
             }
+            tl_worker_pool  = nullptr;
+            tl_worker_index = -1;
             deregister_worker(std::this_thread::get_id());
         };
         this->threads[i].reset(
             new std::thread(f));  // compiler may not support std::make_unique()
     }
 
+    // Get the next task to run on behalf of worker number i (or -1 for a
+    // non-pool thread lending a hand): first the worker's own deque, then
+    // the central submission queue, then try to steal from the other
+    // workers' deques.
+    bool next_task(int i, std::function<void(int id)>*& f)
+    {
+        DequeList* dl = m_deques.load(std::memory_order_acquire);
+        if (i >= 0 && size_t(i) < dl->deques.size()) {
+            if (dl->inboxes[i]->pop(f))  // tasks aimed at us specifically
+                return true;
+            if (dl->deques[i]->pop(f))  // our own backlog
+                return true;
+        }
+        if (this->q.pop(f))
+            return true;
+        size_t n = dl->deques.size();
+        if (!n)
+            return false;
+        // Steal, starting each thread's sweep at its own pseudorandom
+        // position so the thieves don't all converge on the same victim.
+        // Inbox tasks only prefer their worker; they are fair game too,
+        // which keeps targeted pushes from ever starving.
+        static thread_local unsigned steal_seed = unsigned(
+            std::hash<std::thread::id>()(std::this_thread::get_id()));
+        steal_seed   = steal_seed * 1103515245u + 12345u;
+        size_t start = steal_seed % n;
+        for (size_t k = 0; k < n; ++k) {
+            size_t victim = start + k;
+            if (victim >= n)
+                victim -= n;
+            if (int(victim) == i)
+                continue;
+            if (dl->deques[victim]->steal(f)
+                || dl->inboxes[victim]->pop(f))
+                return true;
+        }
+        return false;
+    }
+
+    // Make sure at least n per-worker deques exist, publishing a new
+    // snapshot of the deque list for the lock-free readers. Only called
+    // from resize() and init(), which are documented to be
+    // single-threaded. Old snapshots are retired rather than freed,
+    // because workers may still be sweeping them, and deques themselves
+    // live until the pool is destroyed, so any tasks left in the deque of
+    // a terminated worker remain stealable.
+    void ensure_deques(int n)
+    {
+        if (int(m_all_deques.size()) >= n)
+            return;
+        while (int(m_all_deques.size()) < n) {
+            m_all_deques.emplace_back(new TaskDeque);
+            m_all_inboxes.emplace_back(new TaskInbox(0));
+        }
+        std::unique_ptr<DequeList> next(new DequeList);
+        next->deques.reserve(m_all_deques.size());
+        for (auto& d : m_all_deques)
+            next->deques.push_back(d.get());
+        next->inboxes.reserve(m_all_inboxes.size());
+        for (auto& b : m_all_inboxes)
+            next->inboxes.push_back(b.get());
+        m_deques.store(next.get(), std::memory_order_release);
+        m_deque_lists.push_back(std::move(next));
+    }
+
     void init()
     {
         this->nWaiting = 0;
         this->isStop   = false;
         this->isDone   = false;
+        m_deque_lists.emplace_back(new DequeList);
+        m_deques.store(m_deque_lists.back().get(),
+                       std::memory_order_release);
     }
 
+    using TaskDeque = pvt::WorkStealingDeque<std::function<void(int id)>*>;
+    using TaskInbox = pvt::ThreadsafeQueue<std::function<void(int id)>*>;
+    struct DequeList {
+        std::vector<TaskDeque*> deques;
+        std::vector<TaskInbox*> inboxes;  // targeted tasks, same indexing
+    };
+
     std::vector<std::unique_ptr<std::thread>> threads;
     std::vector<std::shared_ptr<std::atomic<bool>>> flags;
+    std::vector<std::unique_ptr<TaskDeque>> m_all_deques;   // owns the deques
+    std::vector<std::unique_ptr<TaskInbox>> m_all_inboxes;  // owns the inboxes
+    std::vector<std::unique_ptr<DequeList>> m_deque_lists;  // owns snapshots
+    std::atomic<DequeList*> m_deques { nullptr };  // current snapshot
     mutable pvt::ThreadsafeQueue<std::function<void(int id)>*> q;
     std::atomic<bool> isDone;
     std::atomic<bool> isStop;
     std::atomic<int> nWaiting;  // how many threads are waiting
     int m_size { 0 };           // Number of threads in the queue
+    std::atomic<int> m_spawned { 0 };  // Worker slots with OS threads started
     std::mutex mutex;
     std::condition_variable cv;
     mutable tsl::robin_map<std::thread::id, int> m_worker_threadids;
@@ -421,6 +757,14 @@ thread_pool::push_queue_and_notify(std::function<void(int id)>* f)
 
 
 
+void
+thread_pool::push_queue_and_notify(std::function<void(int id)>* f, int worker)
+{
+    m_impl->push_queue_and_notify(f, worker);
+}
+
+
+
 /// DEPRECATED(2.1) -- use is_worker() instead.
 bool
 thread_pool::this_thread_is_in_pool() const
@@ -584,6 +928,155 @@ task_set::wait(bool block)
 
 
 
+class TaskGraph::Impl {
+public:
+    Impl(thread_pool* pool)
+        : m_pool(pool ? pool : default_thread_pool())
+    {
+    }
+
+    TaskId submit(std::function<void()> func, cspan<TaskId> dependencies)
+    {
+        TaskId id;
+        bool ready = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            id = TaskId(m_tasks.size());
+            m_tasks.emplace_back();
+            Task& t = m_tasks.back();
+            t.func  = std::move(func);
+            for (TaskId d : dependencies) {
+                OIIO_DASSERT(d >= 0 && d < id
+                             && "dependencies must be earlier tasks of this graph");
+                Task& dep = m_tasks[size_t(d)];
+                if (!dep.done) {
+                    dep.successors.push_back(id);
+                    t.waiting_on += 1;
+                }
+            }
+            m_outstanding += 1;
+            ready = (t.waiting_on == 0);
+        }
+        if (ready)
+            dispatch(id);
+        return id;
+    }
+
+    void wait()
+    {
+        std::thread::id myid = std::this_thread::get_id();
+        if (m_pool->is_worker(myid)) {
+            // A pool worker waiting on the graph must not steal arbitrary
+            // pool tasks (recursive work stealing); just block until the
+            // completions wake us.
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [&] { return m_outstanding == 0; });
+            return;
+        }
+        // Ordinary thread: help the pool along while we wait.
+        while (1) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_outstanding == 0)
+                    return;
+            }
+            if (!m_pool->run_one_task(myid))
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    struct Task {
+        std::function<void()> func;
+        int waiting_on = 0;     // Incomplete dependencies remaining
+        bool done      = false;
+        std::vector<TaskId> successors;  // Tasks waiting on us
+    };
+
+    // Hand the (already eligible) task to the pool. If the pool has no
+    // workers, push() runs it immediately on the calling thread.
+    void dispatch(TaskId id)
+    {
+        m_pool->push([this, id](int /*threadid*/) { run_task(id); });
+    }
+
+    void run_task(TaskId id)
+    {
+        std::function<void()> f;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            f = std::move(m_tasks[size_t(id)].func);
+        }
+        if (f)
+            f();
+        // Mark us done and collect any successors that just became
+        // eligible. They are dispatched outside the lock, both to keep the
+        // critical section short and because with an empty pool dispatch()
+        // runs the task inline, which would recurse into this lock.
+        TaskId* ready = OIIO_ALLOCA(TaskId, 16);
+        size_t nready = 0, maxready = 16;
+        std::vector<TaskId> ready_overflow;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Task& t = m_tasks[size_t(id)];
+            t.done  = true;
+            for (TaskId s : t.successors) {
+                if (--m_tasks[size_t(s)].waiting_on == 0) {
+                    if (nready < maxready)
+                        ready[nready++] = s;
+                    else
+                        ready_overflow.push_back(s);
+                }
+            }
+            m_outstanding -= 1;
+            if (m_outstanding == 0)
+                m_cv.notify_all();
+        }
+        for (size_t i = 0; i < nready; ++i)
+            dispatch(ready[i]);
+        for (TaskId s : ready_overflow)
+            dispatch(s);
+    }
+
+    thread_pool* m_pool;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Task> m_tasks;      // Stable addresses; grows only
+    int64_t m_outstanding = 0;     // Submitted but not yet completed
+};
+
+
+
+TaskGraph::TaskGraph(thread_pool* pool)
+    : m_impl(new Impl(pool))
+{
+}
+
+
+
+TaskGraph::~TaskGraph()
+{
+    m_impl->wait();
+}
+
+
+
+TaskGraph::TaskId
+TaskGraph::submit(std::function<void()> func, cspan<TaskId> dependencies)
+{
+    return m_impl->submit(std::move(func), dependencies);
+}
+
+
+
+void
+TaskGraph::wait()
+{
+    m_impl->wait();
+}
+
+
+
 // Helper function to keep track of the recursve depth of our use of the
 // thread pool. Call with the adjustment (i.e., parallel_recursive_depth(1)
 // to enter, parallel_recursive_depth(-1) to exit), and it will return the
@@ -630,9 +1123,15 @@ parallel_for_chunked_id(int64_t begin, int64_t end, int64_t chunksize,
     }
     // N.B. If chunksize was specified, honor it, even for the single
     // threaded case.
+    //
+    // A range with fewer than minitems total items can't amortize queue
+    // round-trips no matter how it was chunked: keep the requested chunk
+    // boundaries, but run every chunk inline on the caller.
+    bool inline_all = (end - begin) <= int64_t(opt.minitems());
     for (task_set ts(opt.pool()); begin < end; begin += chunksize) {
         int64_t e = std::min(end, begin + chunksize);
-        if (e == end || opt.singlethread() || opt.pool()->very_busy()) {
+        if (e == end || inline_all || opt.singlethread()
+            || opt.pool()->very_busy()) {
             // For the last (or only) subtask, or if we are using just one
             // thread, or if the pool is already oversubscribed, do it
             // ourselves and avoid messing with the queue or handing off
@@ -834,6 +1333,7 @@ parallel_for_chunked_2D_id(
     opt.resolve();
     if (opt.singlethread()
         || (xchunksize >= (xend - xbegin) && ychunksize >= (yend - ybegin))
+        || (xend - xbegin) * (yend - ybegin) <= int64_t(opt.minitems())
         || opt.pool()->very_busy()) {
         task(-1, xbegin, xend, ybegin, yend);
         parallel_recursive_depth(-1);
@@ -848,11 +1348,22 @@ parallel_for_chunked_2D_id(
         xchunksize = std::max(int64_t(1), (xend - xbegin) / nx);
     }
     task_set ts(opt.pool());
+    // With affinity on, aim each chunk at a worker chosen purely from the
+    // chunk's position, so repeated passes over the same region reuse the
+    // same threads (and, with NUMA-pinned workers, the same node's
+    // memory). Without it, let the pool schedule freely.
+    int nworkers       = opt.affinity() ? opt.pool()->size() : 0;
+    int64_t chunkindex = 0;
     for (auto y = ybegin; y < yend; y += ychunksize) {
         int64_t ychunkend = std::min(yend, y + ychunksize);
         for (auto x = xbegin; x < xend; x += xchunksize) {
             int64_t xchunkend = std::min(xend, x + xchunksize);
-            ts.push(opt.pool()->push(task, x, xchunkend, y, ychunkend));
+            if (nworkers > 0)
+                ts.push(opt.pool()->push_to(int(chunkindex++ % nworkers),
+                                            task, x, xchunkend, y,
+                                            ychunkend));
+            else
+                ts.push(opt.pool()->push(task, x, xchunkend, y, ychunkend));
         }
     }
     parallel_recursive_depth(-1);
@@ -135,6 +135,48 @@ time_thread_pool()
 
 
 
+void
+test_task_graph()
+{
+    std::cout << "\nTesting TaskGraph\n";
+    // Build a diamond: a feeds b and c, which both feed d. Each task
+    // appends its name under a lock; afterwards, check that the recorded
+    // order respects every edge.
+    std::string order;
+    spin_mutex order_mutex;
+    auto record = [&](char name) {
+        spin_lock lock(order_mutex);
+        order += name;
+    };
+    TaskGraph graph;
+    auto a = graph.submit([&] { record('a'); });
+    auto b = graph.submit([&] { record('b'); }, { a });
+    auto c = graph.submit([&] { record('c'); }, { a });
+    auto d = graph.submit([&] { record('d'); }, { b, c });
+    graph.wait();
+    OIIO_CHECK_EQUAL(order.size(), 4);
+    OIIO_CHECK_ASSERT(order.find('a') == 0);
+    OIIO_CHECK_ASSERT(order.find('d') == 3);
+    OIIO_CHECK_ASSERT(order.find('b') != std::string::npos
+                      && order.find('c') != std::string::npos);
+
+    // A long chain must execute strictly in order, even with many workers.
+    const int chainlen = 100;
+    std::vector<int> sequence;
+    TaskGraph chain;
+    TaskGraph::TaskId prev = chain.submit([&] { sequence.push_back(0); });
+    for (int i = 1; i < chainlen; ++i)
+        prev = chain.submit([&, i] { sequence.push_back(i); }, { prev });
+    chain.wait();
+    OIIO_CHECK_EQUAL(sequence.size(), size_t(chainlen));
+    bool in_order = true;
+    for (int i = 0; i < int(sequence.size()); ++i)
+        in_order &= (sequence[i] == i);
+    OIIO_CHECK_ASSERT(in_order);
+}
+
+
+
 int
 main(int argc, char** argv)
 {
@@ -152,6 +194,7 @@ main(int argc, char** argv)
 
     time_thread_group();
     time_thread_pool();
+    test_task_graph();
 
     return unit_test_failures;
 }
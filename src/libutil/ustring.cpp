@@ -2,11 +2,13 @@
 // SPDX-License-Identifier: Apache-2.0
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/export.h>
+#include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/thread.h>
 #include <OpenImageIO/unordered_map_concurrent.h>
@@ -69,28 +71,32 @@ template<unsigned BASE_CAPACITY, unsigned POOL_SIZE> struct TableRepMap {
     }
 #endif
 
+    // Call f(string_view) for each string in this (sub)table. The views
+    // point at the reps themselves, which are never freed, so they stay
+    // valid after the lock is dropped.
+    template<typename F> void foreach_string(F&& f)
+    {
+        ustring_read_lock_t lock(mutex);
+        for (size_t i = 0; i <= mask; ++i)
+            if (entries[i])
+                f(string_view(entries[i]->c_str(), entries[i]->length));
+    }
+
     const char* lookup(string_view str, uint64_t hash)
     {
         ustring_read_lock_t lock(mutex);
-#ifdef USTRING_TRACK_NUM_LOOKUPS
-        // NOTE: this simple increment adds a substantial amount of overhead
-        // so keep it off by default, unless the user really wants it
-        // NOTE2: note that in debug, asserts like the one in ustring::from_unique
-        // can skew the number of lookups compared to release builds
-        ++num_lookups;
-#endif
-        size_t pos = hash & mask, dist = 0;
-        for (;;) {
-            if (entries[pos] == 0)
-                return 0;
-            if (entries[pos]->hashed == hash
-                && entries[pos]->length == str.length()
-                && strncmp(entries[pos]->c_str(), str.data(), str.length())
-                       == 0)
-                return entries[pos]->c_str();
-            ++dist;
-            pos = (pos + dist) & mask;  // quadratic probing
-        }
+        return lookup_unlocked(str, hash);
+    }
+
+    // Batch flavor of lookup: resolve n (string, hash) pairs, writing the
+    // canonical character pointers (or nullptr for absent strings) into
+    // results, acquiring the read lock just once for the whole batch.
+    void lookup_batch(const string_view* strs, const uint64_t* hashes,
+                      const char** results, size_t n)
+    {
+        ustring_read_lock_t lock(mutex);
+        for (size_t i = 0; i < n; ++i)
+            results[i] = lookup_unlocked(strs[i], hashes[i]);
     }
 
     // Look up based on hash only. Return nullptr if not found. Note that if
@@ -144,6 +150,29 @@ template<unsigned BASE_CAPACITY, unsigned POOL_SIZE> struct TableRepMap {
     }
 
 private:
+    const char* lookup_unlocked(string_view str, uint64_t hash)
+    {
+#ifdef USTRING_TRACK_NUM_LOOKUPS
+        // NOTE: this simple increment adds a substantial amount of overhead
+        // so keep it off by default, unless the user really wants it
+        // NOTE2: note that in debug, asserts like the one in ustring::from_unique
+        // can skew the number of lookups compared to release builds
+        ++num_lookups;
+#endif
+        size_t pos = hash & mask, dist = 0;
+        for (;;) {
+            if (entries[pos] == 0)
+                return 0;
+            if (entries[pos]->hashed == hash
+                && entries[pos]->length == str.length()
+                && strncmp(entries[pos]->c_str(), str.data(), str.length())
+                       == 0)
+                return entries[pos]->c_str();
+            ++dist;
+            pos = (pos + dist) & mask;  // quadratic probing
+        }
+    }
+
     void grow()
     {
         size_t new_mask = mask * 2 + 1;
@@ -233,6 +262,18 @@ struct UstringTable {
         return whichbin(hash).insert(str, hash);
     }
 
+    // Which bin number does the given hash land in? Lets callers group
+    // batches of strings so that each bin is visited (and locked) once.
+    size_t bin_of(hash_t hash) const { return (hash >> TOP_SHIFT) % NUM_BINS; }
+
+    // Batch lookup of n (string, hash) pairs, all of which must map to the
+    // same bin (group by bin_of()). The bin's lock is taken only once.
+    void lookup_batch(const string_view* strs, const hash_t* hashes,
+                      const char** results, size_t n)
+    {
+        whichbin(hashes[0]).lookup_batch(strs, hashes, results, n);
+    }
+
     size_t get_memory_usage()
     {
         size_t mem = 0;
@@ -249,6 +290,12 @@ struct UstringTable {
         return num;
     }
 
+    template<typename F> void foreach_string(F&& f)
+    {
+        for (auto& bin : bins)
+            bin.foreach_string(f);
+    }
+
 #    ifdef USTRING_TRACK_NUM_LOOKUPS
     size_t get_num_lookups()
     {
@@ -311,6 +358,35 @@ reverse_map()
 static std::vector<std::pair<const char*, uint64_t>> all_hash_collisions;
 OIIO_CACHE_ALIGN static std::mutex collision_mutex;
 
+
+// Small per-thread direct-mapped cache of recently interned strings,
+// consulted before taking any table lock. It's safe for entries to go
+// stale or be evicted -- the character memory is immortal, and a miss
+// just falls through to the real table. A false hit is impossible because
+// we verify the full string contents.
+struct RecentlyInterned {
+    enum { SIZE = 1024 };  // must be a power of 2; 16KB per thread
+    uint64_t hashes[SIZE]   = {};
+    const char* chars[SIZE] = {};
+
+    const char* find(string_view str, uint64_t hash) const
+    {
+        size_t pos    = hash & (SIZE - 1);
+        const char* c = chars[pos];
+        if (c && hashes[pos] == hash
+            && !strncmp(c, str.data(), str.length()) && c[str.length()] == 0)
+            return c;
+        return nullptr;
+    }
+    void store(uint64_t hash, const char* c)
+    {
+        size_t pos  = hash & (SIZE - 1);
+        hashes[pos] = hash;
+        chars[pos]  = c;
+    }
+};
+static thread_local RecentlyInterned recently_interned;
+
 }  // end anonymous namespace
 
 
@@ -451,15 +527,14 @@ ustring::TableRep::~TableRep()
 
 
 
-const char*
-ustring::make_unique(string_view strref)
+// The full interning procedure: consult the real table, adding the string
+// if it wasn't already present. `hash` must be strhash64(strref). Factored
+// out of make_unique so the public entry points can try the per-thread
+// cache first.
+static const char*
+intern_slow(UstringTable& table, string_view strref, ustring::hash_t hash)
 {
-    UstringTable& table(ustring_table());
-    // Eliminate nullptr-referred string views
-    if (!strref.data())
-        strref = string_view("", 0);
-
-    hash_t hash = Strutil::strhash64(strref);
+    using hash_t = ustring::hash_t;
     // This line, if uncommented, lets you force lots of hash collisions:
     // hash &= ~hash_t(0xffffff);
 
@@ -570,6 +645,102 @@ ustring::make_unique(string_view strref)
 
 
 
+const char*
+ustring::make_unique(string_view strref)
+{
+    UstringTable& table(ustring_table());
+    // Eliminate nullptr-referred string views
+    if (!strref.data())
+        strref = string_view("", 0);
+
+    hash_t hash = Strutil::strhash64(strref);
+
+    // Satisfy repeat requests from the per-thread cache without touching
+    // any shared lock.
+    auto& cache(recently_interned);
+    if (const char* result = cache.find(strref, hash))
+        return result;
+
+    const char* result = intern_slow(table, strref, hash);
+    cache.store(hash, result);
+    return result;
+}
+
+
+
+void
+ustring::make_unique(cspan<string_view> strs, span<ustring> out)
+{
+    OIIO_DASSERT(strs.size() == out.size());
+    size_t n = std::min(size_t(strs.size()), size_t(out.size()));
+    if (!n)
+        return;
+    UstringTable& table(ustring_table());
+    auto& cache(recently_interned);
+
+    // Pass 1: hash everything and satisfy what we can from the per-thread
+    // cache, remembering the indices that missed.
+    std::vector<hash_t> hashes(n);
+    std::vector<uint32_t> misses;
+    misses.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        string_view s = strs[i];
+        if (!s.data()) {
+            // Match the ustring(string_view) constructor: a null-data view
+            // yields a default (null) ustring.
+            out[i] = ustring();
+            continue;
+        }
+        hashes[i] = Strutil::strhash64(s);
+        if (const char* c = cache.find(s, hashes[i]))
+            out[i] = from_unique(c);
+        else
+            misses.push_back(uint32_t(i));
+    }
+    if (misses.empty())
+        return;
+
+    // Pass 2: group the misses by table bin, then resolve each group with
+    // a single batched lookup, so every bin's lock is acquired at most
+    // once per call instead of once per string.
+    std::sort(misses.begin(), misses.end(), [&](uint32_t a, uint32_t b) {
+        return table.bin_of(hashes[a]) < table.bin_of(hashes[b]);
+    });
+    std::vector<string_view> bstrs;
+    std::vector<hash_t> bhashes;
+    std::vector<const char*> bresults;
+    for (size_t i = 0, m = misses.size(); i < m;) {
+        size_t binno = table.bin_of(hashes[misses[i]]);
+        size_t j     = i + 1;
+        while (j < m && table.bin_of(hashes[misses[j]]) == binno)
+            ++j;
+        bstrs.clear();
+        bhashes.clear();
+        for (size_t k = i; k < j; ++k) {
+            uint32_t idx = misses[k];
+            bstrs.push_back(strs[idx]);  // null-data views never miss
+            bhashes.push_back(hashes[idx]);
+        }
+        bresults.assign(j - i, nullptr);
+        table.lookup_batch(bstrs.data(), bhashes.data(), bresults.data(),
+                           j - i);
+        for (size_t k = i; k < j; ++k) {
+            const char* c = bresults[k - i];
+            if (c) {
+                cache.store(bhashes[k - i], c);
+            } else {
+                // Truly new string: take the one-at-a-time path, which
+                // also copes with hash collisions and embedded NULs.
+                c = make_unique(bstrs[k - i]);
+            }
+            out[misses[k]] = from_unique(c);
+        }
+        i = j;
+    }
+}
+
+
+
 ustring
 ustring::from_hash(hash_t hash)
 {
@@ -662,4 +833,86 @@ ustring::memory()
     return table.get_memory_usage();
 }
 
+
+
+// Snapshot file layout: 16 byte magic, uint32 version, uint64 string
+// count, then per string a uint32 length followed by that many bytes.
+// Only the characters are stored: ustring identity is a per-process
+// pointer, so the table must be re-interned on load and there is nothing
+// meaningful to mmap back in place.
+static const char ustring_snapshot_magic[16] = "OpenImageIOustr";
+static const uint32_t ustring_snapshot_version = 1;
+
+
+bool
+ustring::save_table(string_view filename)
+{
+    // Collect the views first so no table lock is held during file I/O.
+    // The views point into the reps, which are never freed.
+    std::vector<string_view> all;
+    all.reserve(total_ustrings());
+    ustring_table().foreach_string([&](string_view s) { all.push_back(s); });
+
+    OIIO::ofstream out;
+    Filesystem::open(out, filename,
+                     std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+    uint64_t count = all.size();
+    out.write(ustring_snapshot_magic, sizeof(ustring_snapshot_magic));
+    out.write((const char*)&ustring_snapshot_version,
+              sizeof(ustring_snapshot_version));
+    out.write((const char*)&count, sizeof(count));
+    for (string_view s : all) {
+        uint32_t len = uint32_t(s.size());
+        out.write((const char*)&len, sizeof(len));
+        out.write(s.data(), len);
+    }
+    return out.good();
+}
+
+
+
+size_t
+ustring::load_table(string_view filename)
+{
+    std::string contents;
+    if (!Filesystem::read_text_file(filename, contents))
+        return 0;
+    const char* p    = contents.data();
+    size_t remaining = contents.size();
+    if (remaining < sizeof(ustring_snapshot_magic) + sizeof(uint32_t)
+                        + sizeof(uint64_t)
+        || memcmp(p, ustring_snapshot_magic, sizeof(ustring_snapshot_magic)))
+        return 0;
+    p += sizeof(ustring_snapshot_magic);
+    remaining -= sizeof(ustring_snapshot_magic);
+    uint32_t version;
+    memcpy(&version, p, sizeof(version));
+    p += sizeof(version);
+    remaining -= sizeof(version);
+    if (version != ustring_snapshot_version)
+        return 0;
+    uint64_t count;
+    memcpy(&count, p, sizeof(count));
+    p += sizeof(count);
+    remaining -= sizeof(count);
+    size_t n = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint32_t len;
+        if (remaining < sizeof(len))
+            break;
+        memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+        remaining -= sizeof(len);
+        if (len > remaining)
+            break;  // Truncated or corrupt entry: keep what we have so far
+        ustring(string_view(p, len));
+        p += len;
+        remaining -= len;
+        ++n;
+    }
+    return n;
+}
+
 OIIO_NAMESPACE_END
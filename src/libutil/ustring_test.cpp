@@ -9,6 +9,7 @@
 
 #include <OpenImageIO/argparse.h>
 #include <OpenImageIO/benchmark.h>
+#include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
@@ -260,6 +261,29 @@ test_ustringhash()
 
 
 
+static void
+test_bulk_make_unique()
+{
+    Strutil::print("Testing bulk make_unique\n");
+    // A mix of novel strings, repeats, empties, and a null-data view.
+    std::vector<std::string> storage;
+    for (int i = 0; i < 1000; ++i)
+        storage.push_back(Strutil::fmt::format("bulk_{}", i % 250));
+    std::vector<string_view> views(storage.begin(), storage.end());
+    views.push_back(string_view());
+    views.push_back(string_view("", 0));
+    std::vector<ustring> results(views.size());
+    ustring::make_unique(views, results);
+    for (size_t i = 0; i < views.size(); ++i) {
+        OIIO_CHECK_EQUAL(results[i], ustring(views[i]));
+        if (views[i].data())  // make_unique maps null data to ""
+            OIIO_CHECK_ASSERT(results[i].c_str()
+                              == ustring::make_unique(views[i]));
+    }
+}
+
+
+
 static void
 create_lotso_ustrings(int iterations)
 {
@@ -300,6 +324,26 @@ benchmark_threaded_ustring_creation()
 
 
 
+void
+test_table_snapshot()
+{
+    // Round-trip the table through a snapshot file and verify that
+    // loading re-interns everything (these strings already exist, so the
+    // count must come back equal to the table size).
+    ustring("snapshot test string one");
+    ustring("snapshot test string two");
+    std::string filename = Filesystem::temp_directory_path()
+                           + "/ustring_snapshot_test.bin";
+    OIIO_CHECK_ASSERT(ustring::save_table(filename));
+    size_t n = ustring::load_table(filename);
+    OIIO_CHECK_ASSERT(n >= 2 && n <= ustring::total_ustrings());
+    Filesystem::remove(filename);
+    // A bogus file should load nothing
+    OIIO_CHECK_EQUAL(ustring::load_table("no/such/file.bin"), size_t(0));
+}
+
+
+
 void
 verify_no_collisions()
 {
@@ -326,6 +370,8 @@ main(int argc, char* argv[])
 
     test_ustring();
     test_ustringhash();
+    test_bulk_make_unique();
+    test_table_snapshot();
     verify_no_collisions();
     benchmark_threaded_ustring_creation();
     verify_no_collisions();
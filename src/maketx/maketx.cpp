@@ -2,13 +2,17 @@
 // SPDX-License-Identifier: Apache-2.0
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include <OpenImageIO/Imath.h>
 #include <OpenImageIO/argparse.h>
@@ -37,6 +41,11 @@ using namespace OIIO;
 static std::string full_command_line;
 static std::vector<std::string> filenames;
 static std::string outputfilename;
+static std::string batchmanifest;
+static int batchjobs    = 4;
+static int batchshards  = 0;
+static std::string journalfile;
+static std::string mergedjournal;
 static bool verbose  = false;
 static bool runstats = false;
 static int nthreads  = 0;  // default: use #cores threads if available
@@ -182,6 +191,8 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
     bool sansattrib            = false;
     float sharpen              = 0.0f;
     float uvslopes_scale       = 0.0f;
+    bool incremental           = false;
+    bool sidecar               = false;
     bool cdf                   = false;
     float cdfsigma             = 1.0f / 6;
     int cdfbits                = 8;
@@ -218,6 +229,22 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
       .help("Output filename");
     ap.arg("--threads %d:NUMTHREADS", &nthreads)
       .help("Number of threads (default: #cores)");
+    ap.arg("--gpu")
+      .help("[EXPERIMENTAL] Use GPU if available; image buffers used for MIP generation are allocated in device-visible unified memory")
+      .action([&](cspan<const char*>){
+                  OIIO::attribute("gpu:device", "CUDA");
+                  OIIO::attribute("imagebuf:device_memory", 1);
+              });
+    ap.arg("--batch %s:MANIFEST", &batchmanifest)
+      .help("Batch mode: convert every \"source;target\" pair listed one per line in MANIFEST, scheduling them concurrently over one shared thread pool and image cache ('#' lines are comments)");
+    ap.arg("--jobs %d:NUMJOBS", &batchjobs)
+      .help("Maximum number of concurrent batch conversions (default: 4)");
+    ap.arg("--shards %d:NUMSHARDS", &batchshards)
+      .help("With --batch: instead of converting, partition the manifest entries that still need work into NUMSHARDS per-node manifests named MANIFEST.shard<n>");
+    ap.arg("--journal %s:FILENAME", &journalfile)
+      .help("Batch mode: append a completion record for each finished conversion to FILENAME; with --shards, skip entries whose journaled fingerprint still matches the published target");
+    ap.arg("--merge-journals %s:OUTFILE", &mergedjournal)
+      .help("Merge the completion journal files given as arguments into OUTFILE, keeping the newest record for each conversion");
     ap.arg("-u", &updatemode)
       .help("Update mode");
     ap.arg("--format %s:FILEFORMAT", &fileformatname)
@@ -300,6 +327,10 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
       .help("Don't compute and store average color");
     ap.arg("--ignore-unassoc", &ignore_unassoc)
       .help("Ignore unassociated alpha tags in input (don't autoconvert)");
+    ap.arg("--incremental", &incremental)
+      .help("If the output file already exists, only refilter and rewrite the regions whose source pixels have changed since it was built");
+    ap.arg("--sidecar", &sidecar)
+      .help("Also write a sidecar index file that speeds up opening the texture");
     ap.arg("--runstats", &runstats)
       .help("Print runtime statistics");
     ap.arg("--stats", &runstats)
@@ -349,7 +380,7 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
 
     // clang-format on
     ap.parse(argc, (const char**)argv);
-    if (filenames.empty()) {
+    if (filenames.empty() && batchmanifest.empty()) {
         ap.briefusage();
         std::cout << "\nFor detailed help: maketx --help\n";
         exit(EXIT_SUCCESS);
@@ -376,10 +407,27 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
         exit(EXIT_FAILURE);
     }
 
-    if (filenames.size() != 1) {
+    if (mergedjournal.size()) {
+        if (filenames.empty() || batchmanifest.size() || outputfilename.size()) {
+            std::cerr
+                << "maketx ERROR: --merge-journals takes only the journal files to merge as arguments\n";
+            exit(EXIT_FAILURE);
+        }
+    } else if (batchmanifest.size()) {
+        if (filenames.size() || outputfilename.size()) {
+            std::cerr
+                << "maketx ERROR: --batch takes its conversions from the manifest; do not also give filenames or -o\n";
+            exit(EXIT_FAILURE);
+        }
+    } else if (filenames.size() != 1) {
         std::cerr << "maketx ERROR: requires exactly one input filename\n";
         exit(EXIT_FAILURE);
     }
+    if (batchshards < 0 || (batchshards && batchmanifest.empty())) {
+        std::cerr
+            << "maketx ERROR: --shards requires --batch and a positive shard count\n";
+        exit(EXIT_FAILURE);
+    }
 
 
     //    std::cout << "Converting " << filenames[0] << " to " << outputfilename << "\n";
@@ -458,6 +506,8 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
         configspec.attribute("maketx:bumpformat", bumpformat);
     if (handed.size())
         configspec.attribute("handed", handed);
+    configspec.attribute("maketx:incremental", incremental);
+    configspec.attribute("maketx:sidecar", sidecar);
     configspec.attribute("maketx:cdf", cdf);
     configspec.attribute("maketx:cdfsigma", cdfsigma);
     configspec.attribute("maketx:cdfbits", cdfbits);
@@ -512,6 +562,66 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
 
 
 
+// Read back the content fingerprint that make_texture embeds in a finished
+// texture: the "oiio:SHA-1" attribute, or the copy appended to the
+// ImageDescription for formats that can't hold arbitrary metadata. Returns
+// the empty string if the file can't be opened or has no fingerprint.
+static std::string
+texture_fingerprint(const std::string& filename)
+{
+    auto in = ImageInput::open(filename);
+    if (!in)
+        return std::string();
+    const ImageSpec& spec(in->spec());
+    std::string hash = spec.get_string_attribute("oiio:SHA-1");
+    if (hash.empty()) {
+        std::string desc = spec.get_string_attribute("ImageDescription");
+        string_view head("oiio:SHA-1=");
+        size_t pos = desc.find(head);
+        if (pos != std::string::npos) {
+            string_view rest(desc);
+            rest.remove_prefix(pos + head.size());
+            hash = Strutil::parse_until(rest, " \t\r\n");
+        }
+    }
+    return hash;
+}
+
+
+
+// Parse a completion journal into records mapping "source;target" to the
+// fingerprint of the published result ('#' lines are comments). Later
+// records supersede earlier ones, so re-running a shard simply updates its
+// entries.
+static bool
+read_journal(const std::string& filename,
+             std::map<std::string, std::string>& records)
+{
+    std::string contents;
+    if (!Filesystem::read_text_file(filename, contents)) {
+        std::cerr << "maketx ERROR: could not read journal \"" << filename
+                  << "\"\n";
+        return false;
+    }
+    for (string_view line : Strutil::splitsv(contents, "\n")) {
+        line = Strutil::strip(line);
+        if (line.empty() || line.front() == '#')
+            continue;
+        auto fields = Strutil::splitsv(line, ";");
+        if (fields.size() != 3) {
+            std::cerr << "maketx ERROR: malformed journal line \"" << line
+                      << "\" (expected \"source;target;hash\")\n";
+            return false;
+        }
+        records[Strutil::fmt::format("{};{}", Strutil::strip(fields[0]),
+                                     Strutil::strip(fields[1]))]
+            = Strutil::strip(fields[2]);
+    }
+    return true;
+}
+
+
+
 int
 main(int argc, char* argv[])
 {
@@ -529,6 +639,30 @@ main(int argc, char* argv[])
     Filesystem::convert_native_arguments(argc, (const char**)argv);
     getargs(argc, argv, configspec);
 
+    if (mergedjournal.size()) {
+        // Journal merge mode: combine the per-node completion journals into
+        // one, keeping the newest record for each conversion, so the next
+        // coordinator pass sees everything the whole farm has published.
+        std::map<std::string, std::string> records;
+        bool mok = true;
+        for (auto& f : filenames)
+            mok &= read_journal(f, records);
+        std::string merged;
+        for (auto& rec : records)
+            merged += Strutil::fmt::format("{};{}\n", rec.first, rec.second);
+        if (mok && !Filesystem::write_text_file(mergedjournal, merged)) {
+            std::cerr << "maketx ERROR: could not write merged journal \""
+                      << mergedjournal << "\"\n";
+            mok = false;
+        }
+        if (mok && verbose)
+            std::cout << "maketx: merged " << filenames.size()
+                      << " journals (" << records.size() << " records) into "
+                      << mergedjournal << "\n";
+        shutdown();
+        return mok ? 0 : EXIT_FAILURE;
+    }
+
     OIIO::attribute("threads", nthreads);
 
     // N.B. This will apply to the default IC that any ImageBuf's get.
@@ -546,10 +680,151 @@ main(int argc, char* argv[])
     if (bumpslopesmode)
         mode = ImageBufAlgo::MakeTxBumpWithSlopes;
 
-    bool ok = ImageBufAlgo::make_texture(mode, filenames[0], outputfilename,
-                                         configspec, &std::cout);
-    if (!ok)
-        std::cout << "make_texture ERROR: " << OIIO::geterror() << "\n";
+    bool ok = true;
+    if (batchmanifest.size()) {
+        // Batch mode: the manifest lists one "source;target" conversion
+        // per line. The jobs run concurrently, but share the thread pool
+        // and the shared ImageCache set up above, so the filtering and
+        // I/O of many files overlap instead of serializing per file.
+        std::string manifest;
+        if (!Filesystem::read_text_file(batchmanifest, manifest)) {
+            std::cerr << "maketx ERROR: could not read manifest \""
+                      << batchmanifest << "\"\n";
+            shutdown();
+            return EXIT_FAILURE;
+        }
+        std::vector<std::pair<std::string, std::string>> joblist;
+        for (string_view line : Strutil::splitsv(manifest, "\n")) {
+            line = Strutil::strip(line);
+            if (line.empty() || line.front() == '#')
+                continue;
+            auto fields = Strutil::splitsv(line, ";");
+            if (fields.size() != 2) {
+                std::cerr << "maketx ERROR: malformed manifest line \"" << line
+                          << "\" (expected \"source;target\")\n";
+                shutdown();
+                return EXIT_FAILURE;
+            }
+            joblist.emplace_back(Strutil::strip(fields[0]),
+                                 Strutil::strip(fields[1]));
+        }
+        if (batchshards > 0) {
+            // Coordinator mode: don't convert anything here. Decide which
+            // entries still need work, then deal them into one manifest per
+            // node for the farm scheduler to hand out.
+            std::map<std::string, std::string> journal;
+            if (journalfile.size() && Filesystem::exists(journalfile)
+                && !read_journal(journalfile, journal)) {
+                shutdown();
+                return EXIT_FAILURE;
+            }
+            std::vector<std::string> shards(batchshards);
+            size_t nskipped = 0;
+            for (auto&& job : joblist) {
+                auto rec = journal.find(
+                    Strutil::fmt::format("{};{}", job.first, job.second));
+                bool done = false;
+                if (rec != journal.end()) {
+                    // A journaled hash of "-" means the conversion finished
+                    // but the output format carries no readable fingerprint;
+                    // for those, mere existence of the target has to do.
+                    if (rec->second != "-")
+                        done = (rec->second == texture_fingerprint(job.second));
+                    else
+                        done = Filesystem::exists(job.second);
+                }
+                if (done) {
+                    ++nskipped;
+                    continue;
+                }
+                // Deal by source-path hash so a given source always lands in
+                // the same shard, however the master manifest is reordered.
+                size_t s = Strutil::strhash(job.first) % size_t(batchshards);
+                shards[s] += Strutil::fmt::format("{};{}\n", job.first,
+                                                  job.second);
+            }
+            for (int s = 0; s < batchshards; ++s) {
+                std::string shardname
+                    = Strutil::fmt::format("{}.shard{}", batchmanifest, s);
+                if (!Filesystem::write_text_file(shardname, shards[s])) {
+                    std::cerr
+                        << "maketx ERROR: could not write shard manifest \""
+                        << shardname << "\"\n";
+                    shutdown();
+                    return EXIT_FAILURE;
+                }
+            }
+            if (verbose)
+                std::cout << "maketx: sharded " << (joblist.size() - nskipped)
+                          << " conversions into " << batchshards
+                          << " manifests (" << nskipped
+                          << " already published)\n";
+            shutdown();
+            return 0;
+        }
+        OIIO::ofstream journalout;
+        if (journalfile.size()) {
+            // Append-only completion journal: one record per finished
+            // conversion. Appending (rather than rewriting) means a node
+            // that dies mid-shard loses nothing it already finished.
+            Filesystem::open(journalout, journalfile,
+                             std::ios_base::out | std::ios_base::app);
+            if (!journalout) {
+                std::cerr << "maketx ERROR: could not open journal \""
+                          << journalfile << "\"\n";
+                shutdown();
+                return EXIT_FAILURE;
+            }
+        }
+        int jobs = std::max(1, std::min(batchjobs, (int)joblist.size()));
+        std::atomic<int> next(0), nfail(0);
+        std::mutex outmutex;
+        auto worker = [&]() {
+            for (int i = next++; i < (int)joblist.size(); i = next++) {
+                std::ostringstream msg;
+                msg.imbue(std::locale::classic());
+                bool jok = ImageBufAlgo::make_texture(mode, joblist[i].first,
+                                                      joblist[i].second,
+                                                      configspec, &msg);
+                std::string errmsg = jok ? std::string() : OIIO::geterror();
+                std::string journalrec;
+                if (jok && journalfile.size()) {
+                    std::string fp = texture_fingerprint(joblist[i].second);
+                    journalrec = Strutil::fmt::format("{};{};{}\n",
+                                                      joblist[i].first,
+                                                      joblist[i].second,
+                                                      fp.size() ? fp : "-");
+                }
+                std::lock_guard<std::mutex> lock(outmutex);
+                if (journalrec.size())
+                    journalout << journalrec << std::flush;
+                if (verbose)
+                    std::cout << "maketx: " << joblist[i].first << " -> "
+                              << joblist[i].second << "\n";
+                if (msg.str().size())
+                    std::cout << msg.str();
+                if (!jok) {
+                    std::cout << "make_texture ERROR (" << joblist[i].first
+                              << "): " << errmsg << "\n";
+                    ++nfail;
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int i = 0; i < jobs; ++i)
+            workers.emplace_back(worker);
+        for (auto& t : workers)
+            t.join();
+        ok = (nfail == 0);
+        if (verbose)
+            std::cout << "maketx: converted " << (joblist.size() - nfail)
+                      << " of " << joblist.size() << " files\n";
+    } else {
+        ok = ImageBufAlgo::make_texture(mode, filenames[0], outputfilename,
+                                        configspec, &std::cout);
+        if (!ok)
+            std::cout << "make_texture ERROR: " << OIIO::geterror() << "\n";
+    }
     if (runstats)
         std::cout << "\n" << ic->getstats();
 
@@ -0,0 +1,740 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+
+// oiio-bench -- a suite of named microbenchmarks covering OIIO's hot
+// paths, with machine-readable JSON output and a compare mode that diffs
+// two result files with noise-aware significance testing. The intent is
+// that qualifying a new OIIO build is:
+//
+//     oiio-bench -o baseline.json          (on the old build)
+//     oiio-bench -o candidate.json         (on the new build)
+//     oiio-bench --compare baseline.json candidate.json
+//
+// Each benchmark is a named entry; --filter selects a subset by substring
+// and --list prints the available names. Statistics come from the same
+// Benchmarker used by the unit test timing sections, so numbers are
+// directly comparable with the ad hoc harnesses this tool replaces.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <OpenImageIO/argparse.h>
+#include <OpenImageIO/benchmark.h>
+#include <OpenImageIO/filesystem.h>
+#include <OpenImageIO/imagebuf.h>
+#include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/imagecache.h>
+#include <OpenImageIO/imageio.h>
+#include <OpenImageIO/strutil.h>
+#include <OpenImageIO/sysutil.h>
+#include <OpenImageIO/timer.h>
+#include <OpenImageIO/ustring.h>
+
+using namespace OIIO;
+
+
+static bool verbose      = false;
+static int nthreads      = 0;
+static int trials        = 10;
+static int iterations    = 0;  // 0 = let Benchmarker decide
+static std::string filterpattern;
+static bool listonly     = false;
+static std::string outputfilename;
+static std::string corpusdir;
+static std::vector<std::string> comparefiles;
+static float sig_threshold = 5.0f;  // percent change considered meaningful
+static float noise_sigmas  = 3.0f;  // stddevs required for significance
+
+
+
+// Statistics we record for one named benchmark, in seconds per iteration.
+struct BenchResult {
+    std::string name;
+    double avg    = 0;
+    double median = 0;
+    double stddev = 0;
+    size_t iterations = 0;
+    size_t trials     = 0;
+    double mem_mb     = 0;  // peak RSS growth, corpus mode only
+};
+
+
+
+// The registry of named benchmarks. Each entry runs its measurement with
+// the supplied pre-configured Benchmarker and relies on function-local
+// statics for any expensive setup, so skipped benchmarks cost nothing.
+struct BenchEntry {
+    const char* name;
+    std::function<bool(Benchmarker&)> run;  // false = setup failed, skip
+};
+
+static std::vector<BenchEntry>&
+bench_registry()
+{
+    static std::vector<BenchEntry> registry;
+    return registry;
+}
+
+
+
+// Shared source imagery for the IBA and convert benchmarks: 1024x1024
+// RGBA float, filled with something nonconstant so no fast path can
+// trivialize the work.
+static const ImageBuf&
+test_image_a()
+{
+    static ImageBuf img = ImageBufAlgo::noise(
+        "uniform", 0.0f, 1.0f, false, 1,
+        ROI(0, 1024, 0, 1024, 0, 1, 0, 4));
+    return img;
+}
+
+static const ImageBuf&
+test_image_b()
+{
+    static ImageBuf img = ImageBufAlgo::noise(
+        "uniform", 0.0f, 1.0f, false, 2,
+        ROI(0, 1024, 0, 1024, 0, 1, 0, 4));
+    return img;
+}
+
+
+
+static bool
+bench_iba_add(Benchmarker& bench)
+{
+    const ImageBuf &A = test_image_a(), &B = test_image_b();
+    ImageBuf R(A.spec());
+    bench("IBA:add", [&]() {
+        ImageBufAlgo::add(R, A, B, {}, nthreads);
+        clobber(R.localpixels());
+    });
+    return true;
+}
+
+
+static bool
+bench_iba_mul(Benchmarker& bench)
+{
+    const ImageBuf &A = test_image_a(), &B = test_image_b();
+    ImageBuf R(A.spec());
+    bench("IBA:mul", [&]() {
+        ImageBufAlgo::mul(R, A, B, {}, nthreads);
+        clobber(R.localpixels());
+    });
+    return true;
+}
+
+
+static bool
+bench_iba_resize(Benchmarker& bench)
+{
+    const ImageBuf& A = test_image_a();
+    ImageSpec halfspec(512, 512, 4, TypeFloat);
+    ImageBuf R(halfspec);
+    bench("IBA:resize_half", [&]() {
+        ImageBufAlgo::resize(R, A, {}, ROI(0, 512, 0, 512, 0, 1, 0, 4),
+                             nthreads);
+        clobber(R.localpixels());
+    });
+    return true;
+}
+
+
+static bool
+bench_iba_unsharp(Benchmarker& bench)
+{
+    const ImageBuf& A = test_image_a();
+    ImageBuf R(A.spec());
+    bench("IBA:unsharp_mask", [&]() {
+        ImageBufAlgo::unsharp_mask(R, A, "gaussian", 3.0f, 1.0f, 0.0f, {},
+                                   nthreads);
+        clobber(R.localpixels());
+    });
+    return true;
+}
+
+
+// Pure iterator stepping and per-channel get/set, the pattern underlying
+// most IBA kernels. This is the gate for the UNCHECKED_HOT_PATHS build
+// option: compare a checked and an unchecked build on this entry to
+// verify the uplift.
+static bool
+bench_iterator_readwrite(Benchmarker& bench)
+{
+    const ImageBuf& A = test_image_a();
+    ImageBuf R(A.spec());
+    int nch = A.nchannels();
+    bench.work(A.spec().image_pixels());
+    bench("iterator:readwrite", [&]() {
+        ImageBuf::ConstIterator<float> s(A);
+        for (ImageBuf::Iterator<float> d(R); !d.done(); ++d, ++s)
+            for (int c = 0; c < nch; ++c)
+                d[c] = s[c] + 1.0f;
+        clobber(R.localpixels());
+    });
+    return true;
+}
+
+
+static bool
+bench_convert_float_to_uint8(Benchmarker& bench)
+{
+    const size_t nvals = 1024 * 1024 * 4;
+    static std::vector<float> src(nvals, 0.5f);
+    static std::vector<unsigned char> dst(nvals);
+    bench.work(nvals);
+    bench("convert_image:float->uint8", [&]() {
+        convert_image(4, 1024, 1024, 1, src.data(), TypeFloat, AutoStride,
+                      AutoStride, AutoStride, dst.data(), TypeUInt8,
+                      AutoStride, AutoStride, AutoStride);
+        clobber(dst.data());
+    });
+    return true;
+}
+
+
+static bool
+bench_convert_uint16_to_float(Benchmarker& bench)
+{
+    const size_t nvals = 1024 * 1024 * 4;
+    static std::vector<unsigned short> src(nvals, 32768);
+    static std::vector<float> dst(nvals);
+    bench.work(nvals);
+    bench("convert_image:uint16->float", [&]() {
+        convert_image(4, 1024, 1024, 1, src.data(), TypeUInt16, AutoStride,
+                      AutoStride, AutoStride, dst.data(), TypeFloat,
+                      AutoStride, AutoStride, AutoStride);
+        clobber(dst.data());
+    });
+    return true;
+}
+
+
+static bool
+bench_ustring_lookup(Benchmarker& bench)
+{
+    // Creating a ustring from chars that already exist in the table is the
+    // common case in texture-heavy workloads; prime the table first.
+    static std::vector<std::string> words;
+    if (words.empty())
+        for (int i = 0; i < 256; ++i)
+            words.push_back(Strutil::fmt::format("oiio-bench-word-{}", i));
+    for (auto& w : words)
+        ustring u(w);  // prime
+    int i = 0;
+    bench.work(1);
+    bench("ustring:create_existing", [&]() {
+        ustring u(words[i++ & 255]);
+        DoNotOptimize(u);
+    });
+    return true;
+}
+
+
+static bool
+bench_ustring_compare(Benchmarker& bench)
+{
+    static ustring a("oiio-bench-word-17"), b("oiio-bench-word-18");
+    bench("ustring:compare", [&]() {
+        bool eq = (a == b);
+        DoNotOptimize(eq);
+    });
+    return true;
+}
+
+
+
+// A null-plugin-backed tiled "file" exercises the ImageCache bookkeeping
+// with negligible decode cost, so hit/miss numbers isolate the cache
+// itself.
+static const char* nulltexture
+    = "oiio-bench.null&RES=2048x2048&TILE=64x64&CHANNELS=4&TYPE=half";
+
+static bool
+bench_tilecache_hit(Benchmarker& bench)
+{
+    ImageCache* ic = ImageCache::create(false /*not shared*/);
+    ustring file(nulltexture);
+    float pixels[64 * 64 * 4];
+    // Warm the one tile we will hit forever.
+    if (!ic->get_pixels(file, 0, 0, 0, 64, 0, 64, 0, 1, TypeFloat, pixels)) {
+        ImageCache::destroy(ic);
+        return false;
+    }
+    bench("tilecache:hit", [&]() {
+        ic->get_pixels(file, 0, 0, 0, 64, 0, 64, 0, 1, TypeFloat, pixels);
+        clobber(pixels);
+    });
+    ImageCache::destroy(ic);
+    return true;
+}
+
+
+static bool
+bench_tilecache_miss(Benchmarker& bench)
+{
+    ImageCache* ic = ImageCache::create(false /*not shared*/);
+    // A cache far smaller than the 1024 tiles of the test image, walked
+    // sequentially, makes nearly every access an eviction + refill.
+    ic->attribute("max_memory_MB", 1.0f);
+    ustring file(nulltexture);
+    float pixels[64 * 64 * 4];
+    if (!ic->get_pixels(file, 0, 0, 0, 64, 0, 64, 0, 1, TypeFloat, pixels)) {
+        ImageCache::destroy(ic);
+        return false;
+    }
+    int tile = 0;
+    bench("tilecache:miss", [&]() {
+        int tx = (tile & 31) * 64, ty = ((tile >> 5) & 31) * 64;
+        ++tile;
+        ic->get_pixels(file, 0, 0, tx, tx + 64, ty, ty + 64, 0, 1, TypeFloat,
+                       pixels);
+        clobber(pixels);
+    });
+    ImageCache::destroy(ic);
+    return true;
+}
+
+
+
+// Format decode benchmarks read back a file we write during setup; if the
+// format is disabled in this build, the benchmark quietly skips.
+static bool
+bench_decode(Benchmarker& bench, const char* benchname, const char* ext,
+             TypeDesc datatype)
+{
+    static std::map<std::string, std::string> written;
+    std::string& path = written[ext];
+    if (path.empty()) {
+        std::string candidate = Filesystem::temp_directory_path()
+                                + "/oiio-bench-decode." + ext;
+        ImageBuf src = test_image_a();
+        src.set_write_format(datatype);
+        if (!src.write(candidate))
+            return false;
+        path = candidate;
+    }
+    std::vector<float> pixels(1024 * 1024 * 4);
+    bench(benchname, [&]() {
+        auto in = ImageInput::open(path);
+        if (in) {
+            in->read_image(0, 0, 0, 4, TypeFloat, pixels.data());
+            in->close();
+        }
+        clobber(pixels.data());
+    });
+    return true;
+}
+
+
+static bool
+bench_decode_tiff(Benchmarker& bench)
+{
+    return bench_decode(bench, "decode:tiff_uint8", "tif", TypeUInt8);
+}
+
+
+static bool
+bench_decode_exr(Benchmarker& bench)
+{
+    return bench_decode(bench, "decode:exr_half", "exr", TypeHalf);
+}
+
+
+
+static void
+register_benchmarks()
+{
+    auto& reg = bench_registry();
+    reg.push_back({ "IBA:add", bench_iba_add });
+    reg.push_back({ "IBA:mul", bench_iba_mul });
+    reg.push_back({ "IBA:resize_half", bench_iba_resize });
+    reg.push_back({ "IBA:unsharp_mask", bench_iba_unsharp });
+    reg.push_back({ "iterator:readwrite", bench_iterator_readwrite });
+    reg.push_back({ "convert_image:float->uint8", bench_convert_float_to_uint8 });
+    reg.push_back({ "convert_image:uint16->float", bench_convert_uint16_to_float });
+    reg.push_back({ "ustring:create_existing", bench_ustring_lookup });
+    reg.push_back({ "ustring:compare", bench_ustring_compare });
+    reg.push_back({ "tilecache:hit", bench_tilecache_hit });
+    reg.push_back({ "tilecache:miss", bench_tilecache_miss });
+    reg.push_back({ "decode:tiff_uint8", bench_decode_tiff });
+    reg.push_back({ "decode:exr_half", bench_decode_exr });
+}
+
+
+
+static void
+write_results(const std::vector<BenchResult>& results)
+{
+    std::string json;
+    json += "{\n";
+    json += Strutil::fmt::format("  \"oiio_version\": \"{}\",\n",
+                                 OIIO_VERSION_STRING);
+    json += Strutil::fmt::format("  \"hw_concurrency\": {},\n",
+                                 Sysutil::hardware_concurrency());
+    json += Strutil::fmt::format("  \"threads\": {},\n", nthreads);
+    json += "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        json += Strutil::fmt::format(
+            "    {{ \"name\": \"{}\", \"median_ns\": {:.2f}, "
+            "\"avg_ns\": {:.2f}, \"stddev_ns\": {:.2f}, "
+            "\"iterations\": {}, \"trials\": {}, "
+            "\"mem_peak_mb\": {:.2f} }}{}\n",
+            r.name, r.median * 1e9, r.avg * 1e9, r.stddev * 1e9,
+            r.iterations, r.trials, r.mem_mb,
+            i + 1 < results.size() ? "," : "");
+    }
+    json += "  ]\n}\n";
+    if (outputfilename.empty() || outputfilename == "-")
+        std::cout << json;
+    else if (!Filesystem::write_text_file(outputfilename, json))
+        Strutil::print(stderr, "oiio-bench: could not write \"{}\"\n",
+                       outputfilename);
+}
+
+
+
+// Read back a results file that this tool wrote. This is deliberately a
+// minimal extractor for our own output, not a general JSON parser.
+static bool
+read_results(const std::string& filename,
+             std::map<std::string, BenchResult>& results)
+{
+    std::string contents;
+    if (!Filesystem::read_text_file(filename, contents))
+        return false;
+    string_view rest(contents);
+    while (true) {
+        size_t pos = rest.find("\"name\"");
+        if (pos == string_view::npos)
+            break;
+        rest.remove_prefix(pos + 6);
+        BenchResult r;
+        Strutil::parse_char(rest, ':');
+        string_view name;
+        Strutil::parse_string(rest, name);
+        r.name = name;
+        auto field = [&](const char* key, double& val) {
+            Strutil::parse_until(rest, "\"");
+            if (Strutil::parse_prefix(rest, Strutil::fmt::format("\"{}\"", key))) {
+                Strutil::parse_char(rest, ':');
+                float f = 0;
+                Strutil::parse_float(rest, f);
+                val = f;
+            }
+        };
+        double iters = 0, ntrials = 0;
+        field("median_ns", r.median);
+        field("avg_ns", r.avg);
+        field("stddev_ns", r.stddev);
+        field("iterations", iters);
+        field("trials", ntrials);
+        field("mem_peak_mb", r.mem_mb);  // optional, older files lack it
+        r.median *= 1e-9;
+        r.avg *= 1e-9;
+        r.stddev *= 1e-9;
+        r.iterations = size_t(iters);
+        r.trials     = size_t(ntrials);
+        results[r.name] = r;
+    }
+    return !results.empty();
+}
+
+
+
+// Compare two result files. A change is reported as significant only if
+// the relative delta exceeds the percentage threshold AND the absolute
+// difference of medians exceeds noise_sigmas standard deviations of the
+// noisier run -- so a jittery benchmark can't cry wolf.
+static int
+compare_results(const std::string& basefile, const std::string& newfile)
+{
+    std::map<std::string, BenchResult> base, cur;
+    if (!read_results(basefile, base)) {
+        Strutil::print(stderr, "oiio-bench: could not parse \"{}\"\n",
+                       basefile);
+        return 1;
+    }
+    if (!read_results(newfile, cur)) {
+        Strutil::print(stderr, "oiio-bench: could not parse \"{}\"\n",
+                       newfile);
+        return 1;
+    }
+    int nregress = 0;
+    Strutil::print("{:<28} {:>12} {:>12} {:>9}  verdict\n", "benchmark",
+                   "baseline", "current", "delta");
+    for (auto& item : cur) {
+        auto b = base.find(item.first);
+        if (b == base.end()) {
+            Strutil::print("{:<28} {:>12} {:>12.2f} {:>9}  new\n", item.first,
+                           "-", item.second.median * 1e9, "-");
+            continue;
+        }
+        double oldm = b->second.median, newm = item.second.median;
+        double deltapct = oldm > 0 ? 100.0 * (newm - oldm) / oldm : 0.0;
+        double noise = noise_sigmas
+                       * std::max(b->second.stddev, item.second.stddev);
+        const char* verdict = "~";
+        if (fabs(deltapct) > sig_threshold && fabs(newm - oldm) > noise) {
+            verdict = deltapct > 0 ? "SLOWER" : "faster";
+            if (deltapct > 0)
+                ++nregress;
+        }
+        Strutil::print("{:<28} {:>10.2f}ns {:>10.2f}ns {:>+8.1f}%  {}\n",
+                       item.first, oldm * 1e9, newm * 1e9, deltapct, verdict);
+    }
+    for (auto& item : base)
+        if (cur.find(item.first) == cur.end())
+            Strutil::print("{:<28} {:>10.2f}ns {:>12} {:>9}  removed\n",
+                           item.first, item.second.median * 1e9, "-", "-");
+    if (nregress)
+        Strutil::print("\n{} significant regression{}\n", nregress,
+                       nregress == 1 ? "" : "s");
+    return nregress ? 2 : 0;
+}
+
+
+
+// Compute median/avg/sample-stddev of a set of per-trial samples, the same
+// statistics Benchmarker reports, so corpus results diff with --compare
+// exactly like the microbenchmarks.
+static void
+compute_stats(std::vector<double> samples, BenchResult& r)
+{
+    if (samples.empty())
+        return;
+    std::sort(samples.begin(), samples.end());
+    r.median = samples[samples.size() / 2];
+    double sum = 0;
+    for (double s : samples)
+        sum += s;
+    r.avg      = sum / samples.size();
+    double var = 0;
+    for (double s : samples)
+        var += (s - r.avg) * (s - r.avg);
+    r.stddev = samples.size() > 1 ? sqrt(var / (samples.size() - 1)) : 0.0;
+    r.trials = samples.size();
+}
+
+
+
+// End-to-end format benchmark over a user-supplied corpus directory.
+// Files are grouped by "format:compression" (e.g. "openexr:zip",
+// "tiff:lzw"); per group we report open latency (ns per open), decode and
+// encode throughput (ns per MB of uncompressed pixels, so differently
+// sized corpus files contribute comparable samples), and the peak
+// resident-memory growth observed while decoding. Read-only formats (DDS,
+// PSD, raw, ...) simply have no encode entry.
+static void
+run_corpus(std::vector<BenchResult>& results)
+{
+    std::vector<std::string> files;
+    if (!Filesystem::get_directory_entries(corpusdir, files,
+                                           true /*recursive*/)) {
+        Strutil::print(stderr, "oiio-bench: could not read corpus \"{}\"\n",
+                       corpusdir);
+        return;
+    }
+    std::sort(files.begin(), files.end());
+
+    struct GroupData {
+        std::vector<double> open, decode, encode;
+        double mem_mb = 0;
+        int nfiles    = 0;
+    };
+    std::map<std::string, GroupData> groups;
+    double base_mem = Sysutil::memory_used(true) / (1024.0 * 1024.0);
+
+    for (const std::string& file : files) {
+        if (Filesystem::is_directory(file))
+            continue;
+        auto probe = ImageInput::open(file);
+        if (!probe)
+            continue;  // not an image, or format disabled
+        ImageSpec spec  = probe->spec();
+        std::string fmt = probe->format_name();
+        probe->close();
+        if (spec.deep)
+            continue;
+        std::string codec = spec.get_string_attribute("compression");
+        std::string group = codec.size() ? fmt + ":" + codec : fmt;
+        if (filterpattern.size() && !Strutil::icontains(group, filterpattern))
+            continue;
+        double mb = spec.image_bytes(true) / (1024.0 * 1024.0);
+        if (mb <= 0)
+            continue;
+        GroupData& g = groups[group];
+        ++g.nfiles;
+        if (verbose)
+            Strutil::print("  {} ({}, {:.1f} MB)\n", file, group, mb);
+
+        std::unique_ptr<char[]> pixels(new char[spec.image_bytes(true)]);
+        for (int t = 0; t < trials; ++t) {
+            Timer timer;
+            auto in = ImageInput::open(file);
+            g.open.push_back(timer());
+            if (!in)
+                break;
+            timer.reset();
+            timer.start();
+            bool ok = in->read_image(0, 0, 0, spec.nchannels,
+                                     TypeDesc::UNKNOWN, pixels.get());
+            double t_decode = timer();
+            in->close();
+            if (!ok)
+                break;
+            g.decode.push_back(t_decode / mb);
+            g.mem_mb = std::max(g.mem_mb,
+                                Sysutil::memory_used(true) / (1024.0 * 1024.0)
+                                    - base_mem);
+        }
+
+        // Re-encode the native pixels to a temp file of the same format,
+        // if this plugin can write at all.
+        std::string tmpname = Filesystem::temp_directory_path()
+                              + "/oiio-bench-encode."
+                              + Filesystem::extension(file, false);
+        auto out = ImageOutput::create(tmpname);
+        if (out) {
+            for (int t = 0; t < trials; ++t) {
+                Timer timer;
+                auto o = ImageOutput::create(tmpname);
+                if (!o || !o->open(tmpname, spec))
+                    break;
+                bool ok = o->write_image(TypeDesc::UNKNOWN, pixels.get());
+                ok &= o->close();
+                if (!ok)
+                    break;
+                g.encode.push_back(timer() / mb);
+            }
+            Filesystem::remove(tmpname);
+        }
+    }
+
+    for (auto& item : groups) {
+        auto metric = [&](const char* what, const std::vector<double>& samples,
+                          double mem_mb) {
+            if (samples.empty())
+                return;
+            BenchResult r;
+            r.name = Strutil::fmt::format("corpus:{}:{}", item.first, what);
+            compute_stats(samples, r);
+            r.iterations = item.second.nfiles;
+            r.mem_mb     = mem_mb;
+            results.push_back(r);
+        };
+        metric("open", item.second.open, 0);
+        metric("decode", item.second.decode, item.second.mem_mb);
+        metric("encode", item.second.encode, 0);
+    }
+}
+
+
+
+static void
+getargs(int argc, char* argv[])
+{
+    // clang-format off
+    ArgParse ap;
+    ap.usage ("oiio-bench [options]");
+    ap.arg("-v", &verbose)
+      .help("Verbose output (print each benchmark as it runs)");
+    ap.arg("--threads %d:N", &nthreads)
+      .help("Number of threads for threaded benchmarks (default 0 = #cores)");
+    ap.arg("--trials %d:N", &trials)
+      .help("Number of trials per benchmark (default: 10)");
+    ap.arg("--iters %d:N", &iterations)
+      .help("Iterations per trial (default 0 = automatic)");
+    ap.arg("--filter %s:PATTERN", &filterpattern)
+      .help("Only run benchmarks whose name contains PATTERN");
+    ap.arg("--list", &listonly)
+      .help("List benchmark names and exit");
+    ap.arg("-o %s:FILENAME", &outputfilename)
+      .help("Write JSON results to FILENAME (\"-\" or absent: stdout)");
+    ap.arg("--corpus %s:DIR", &corpusdir)
+      .help("Benchmark format open/decode/encode over the images in DIR "
+            "(recursively) instead of running the microbenchmarks");
+    ap.arg("--compare %s:BASELINE %s:CURRENT")
+      .help("Diff two result files; exit 2 if significant regressions")
+      .action([&](cspan<const char*> argv){
+          comparefiles.assign(argv.begin() + 1, argv.end());
+      });
+    ap.arg("--threshold %f:PCT", &sig_threshold)
+      .help("Percent change considered meaningful in compare mode (default: 5)");
+    ap.arg("--sigmas %f:N", &noise_sigmas)
+      .help("Stddevs a change must exceed to be significant (default: 3)");
+    // clang-format on
+    if (ap.parse(argc, (const char**)argv) < 0) {
+        std::cerr << ap.geterror() << std::endl;
+        ap.print_help();
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+
+int
+main(int argc, char* argv[])
+{
+    Filesystem::convert_native_arguments(argc, (const char**)argv);
+    getargs(argc, argv);
+
+    if (comparefiles.size() == 2)
+        return compare_results(comparefiles[0], comparefiles[1]);
+
+    if (corpusdir.size()) {
+        attribute("threads", nthreads);
+        std::vector<BenchResult> results;
+        run_corpus(results);
+        write_results(results);
+        return 0;
+    }
+
+    register_benchmarks();
+
+    if (listonly) {
+        for (auto& b : bench_registry())
+            Strutil::print("{}\n", b.name);
+        return 0;
+    }
+
+    attribute("threads", nthreads);
+
+    std::vector<BenchResult> results;
+    for (auto& b : bench_registry()) {
+        if (filterpattern.size()
+            && !Strutil::icontains(b.name, filterpattern))
+            continue;
+        Benchmarker bench;
+        bench.trials(trials).verbose(verbose ? 1 : 0);
+        if (iterations)
+            bench.iterations(iterations);
+        if (!b.run(bench)) {
+            if (verbose)
+                Strutil::print("skipped {} (setup failed)\n", b.name);
+            continue;
+        }
+        BenchResult r;
+        r.name       = b.name;
+        r.avg        = bench.avg();
+        r.median     = bench.median();
+        r.stddev     = bench.stddev();
+        r.iterations = bench.iterations();
+        r.trials     = bench.trials();
+        results.push_back(r);
+    }
+
+    write_results(results);
+    return 0;
+}
@@ -4,6 +4,7 @@
 
 
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <sstream>
 #include <string>
@@ -11,7 +12,9 @@
 #include "oiiotool.h"
 
 #include <OpenImageIO/filesystem.h>
+#include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/imagebufalgo_util.h>
 
 
 using namespace OIIO;
@@ -545,3 +548,279 @@ Oiiotool::express(string_view str)
         print("Expanding expression \"{}\" -> \"{}\"\n", str, result);
     return result;
 }
+
+
+
+int
+PixelExprProgram::channel_index(string_view name, const ImageSpec& spec) const
+{
+    for (int c = 0; c < spec.nchannels; ++c)
+        if (spec.channel_name(c) == name)
+            return c;
+    // Conventional aliases for the usual color channels
+    if (name == "r" || name == "R")
+        return spec.nchannels > 0 ? 0 : -1;
+    if (name == "g" || name == "G")
+        return spec.nchannels > 1 ? 1 : -1;
+    if (name == "b" || name == "B")
+        return spec.nchannels > 2 ? 2 : -1;
+    if (name == "a" || name == "A")
+        return spec.alpha_channel >= 0 ? spec.alpha_channel
+                                       : (spec.nchannels > 3 ? 3 : -1);
+    return -1;
+}
+
+
+
+bool
+PixelExprProgram::parse_factor(string_view& s, const ImageSpec& spec,
+                               std::string& error)
+{
+    Strutil::skip_whitespace(s);
+    if (Strutil::parse_char(s, '-')) {
+        if (!parse_factor(s, spec, error))
+            return false;
+        m_code.push_back({ NEG });
+        return true;
+    }
+    float val;
+    if (Strutil::parse_float(s, val)) {
+        m_code.push_back({ CONST, 0, val });
+        return true;
+    }
+    if (Strutil::parse_char(s, '(')) {
+        if (!parse_expr(s, spec, error))
+            return false;
+        if (!Strutil::parse_char(s, ')')) {
+            error = "expected ')' in expression";
+            return false;
+        }
+        return true;
+    }
+    string_view id = Strutil::parse_identifier(s);
+    if (id.empty()) {
+        error = Strutil::fmt::format("could not parse expression at \"{}\"",
+                                     s);
+        return false;
+    }
+    if (Strutil::parse_char(s, '(')) {
+        // Function call
+        struct Func {
+            const char* name;
+            Opcode op;
+            int arity;
+        };
+        static const Func functab[] = { { "abs", ABS, 1 },
+                                        { "sqrt", SQRT, 1 },
+                                        { "min", MIN2, 2 },
+                                        { "max", MAX2, 2 },
+                                        { "clamp", CLAMP3, 3 } };
+        const Func* func = nullptr;
+        for (const Func& f : functab)
+            if (id == f.name)
+                func = &f;
+        if (!func) {
+            error = Strutil::fmt::format("unknown function \"{}\"", id);
+            return false;
+        }
+        for (int a = 0; a < func->arity; ++a) {
+            if (a && !Strutil::parse_char(s, ',')) {
+                error = Strutil::fmt::format(
+                    "{}() takes {} arguments", func->name, func->arity);
+                return false;
+            }
+            if (!parse_expr(s, spec, error))
+                return false;
+        }
+        if (!Strutil::parse_char(s, ')')) {
+            error = "expected ')' in expression";
+            return false;
+        }
+        m_code.push_back({ func->op });
+        return true;
+    }
+    int chan = channel_index(id, spec);
+    if (chan < 0) {
+        error = Strutil::fmt::format("unknown channel \"{}\" in expression",
+                                     id);
+        return false;
+    }
+    m_code.push_back({ CHAN, chan });
+    return true;
+}
+
+
+
+bool
+PixelExprProgram::parse_term(string_view& s, const ImageSpec& spec,
+                             std::string& error)
+{
+    if (!parse_factor(s, spec, error))
+        return false;
+    while (1) {
+        if (Strutil::parse_char(s, '*')) {
+            if (!parse_factor(s, spec, error))
+                return false;
+            m_code.push_back({ MUL });
+        } else if (Strutil::parse_char(s, '/')) {
+            if (!parse_factor(s, spec, error))
+                return false;
+            m_code.push_back({ DIV });
+        } else {
+            return true;
+        }
+    }
+}
+
+
+
+bool
+PixelExprProgram::parse_expr(string_view& s, const ImageSpec& spec,
+                             std::string& error)
+{
+    if (!parse_term(s, spec, error))
+        return false;
+    while (1) {
+        if (Strutil::parse_char(s, '+')) {
+            if (!parse_term(s, spec, error))
+                return false;
+            m_code.push_back({ ADD });
+        } else if (Strutil::parse_char(s, '-')) {
+            if (!parse_term(s, spec, error))
+                return false;
+            m_code.push_back({ SUB });
+        } else {
+            return true;
+        }
+    }
+}
+
+
+
+bool
+PixelExprProgram::compile(string_view expression, const ImageSpec& spec,
+                          std::string& error)
+{
+    m_code.clear();
+    string_view s(expression);
+    do {
+        Strutil::skip_whitespace(s);
+        if (s.empty())
+            break;  // tolerate a trailing ';'
+        string_view chname = Strutil::parse_identifier(s);
+        int dest = chname.size() ? channel_index(chname, spec) : -1;
+        if (dest < 0) {
+            error = Strutil::fmt::format(
+                "unknown channel \"{}\" in expression", chname);
+            return false;
+        }
+        if (!Strutil::parse_char(s, '=')) {
+            error = Strutil::fmt::format("expected '=' after \"{}\"", chname);
+            return false;
+        }
+        if (!parse_expr(s, spec, error))
+            return false;
+        m_code.push_back({ STORE, dest });
+    } while (Strutil::parse_char(s, ';'));
+    Strutil::skip_whitespace(s);
+    if (s.size()) {
+        error = Strutil::fmt::format("could not parse expression at \"{}\"",
+                                     s);
+        return false;
+    }
+    if (!m_code.size()) {
+        error = "empty expression";
+        return false;
+    }
+    // Make sure the evaluation stack stays within its fixed bounds.
+    int depth = 0, maxdepth = 0;
+    for (const Inst& inst : m_code) {
+        switch (inst.op) {
+        case CONST:
+        case CHAN: depth += 1; break;
+        case NEG:
+        case ABS:
+        case SQRT: break;
+        case ADD:
+        case SUB:
+        case MUL:
+        case DIV:
+        case MIN2:
+        case MAX2:
+        case STORE: depth -= 1; break;
+        case CLAMP3: depth -= 2; break;
+        }
+        maxdepth = std::max(maxdepth, depth);
+    }
+    if (maxdepth > eval_stack_size) {
+        error = "expression too deeply nested";
+        return false;
+    }
+    return true;
+}
+
+
+
+bool
+PixelExprProgram::run(ImageBuf& img, ROI roi, int nthreads) const
+{
+    if (!roi.defined())
+        roi = img.roi();
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        int nch         = img.nchannels();
+        float* chanvals = OIIO_ALLOCA(float, nch);
+        float stack[eval_stack_size];
+        for (ImageBuf::Iterator<float> p(img, roi); !p.done(); ++p) {
+            for (int c = 0; c < nch; ++c)
+                chanvals[c] = p[c];
+            int sp = 0;
+            for (const Inst& inst : m_code) {
+                switch (inst.op) {
+                case CONST: stack[sp++] = inst.value; break;
+                case CHAN: stack[sp++] = chanvals[inst.chan]; break;
+                case STORE: chanvals[inst.chan] = stack[--sp]; break;
+                case ADD:
+                    --sp;
+                    stack[sp - 1] += stack[sp];
+                    break;
+                case SUB:
+                    --sp;
+                    stack[sp - 1] -= stack[sp];
+                    break;
+                case MUL:
+                    --sp;
+                    stack[sp - 1] *= stack[sp];
+                    break;
+                case DIV:
+                    --sp;
+                    stack[sp - 1] = stack[sp] ? stack[sp - 1] / stack[sp]
+                                              : 0.0f;
+                    break;
+                case NEG: stack[sp - 1] = -stack[sp - 1]; break;
+                case ABS: stack[sp - 1] = fabsf(stack[sp - 1]); break;
+                case SQRT:
+                    stack[sp - 1] = stack[sp - 1] > 0.0f
+                                        ? sqrtf(stack[sp - 1])
+                                        : 0.0f;
+                    break;
+                case MIN2:
+                    --sp;
+                    stack[sp - 1] = std::min(stack[sp - 1], stack[sp]);
+                    break;
+                case MAX2:
+                    --sp;
+                    stack[sp - 1] = std::max(stack[sp - 1], stack[sp]);
+                    break;
+                case CLAMP3:
+                    sp -= 2;
+                    stack[sp - 1] = OIIO::clamp(stack[sp - 1], stack[sp],
+                                                stack[sp + 1]);
+                    break;
+                }
+            }
+            for (int c = 0; c < nch; ++c)
+                p[c] = chanvals[c];
+        }
+    });
+    return true;
+}
@@ -378,6 +378,75 @@ ImageRec::read(ReadPolicy readpolicy, string_view channel_set)
 }
 
 
+
+size_t
+ImageRec::local_pixel_bytes() const
+{
+    size_t bytes = 0;
+    for (int s = 0; s < subimages(); ++s) {
+        for (int m = 0; m < miplevels(s); ++m) {
+            const ImageBuf* ib = m_subimages[s][m];
+            if (ib && ib->localpixels())
+                bytes += ib->spec().image_bytes();
+        }
+    }
+    return bytes;
+}
+
+
+
+bool
+ImageRec::spill(ImageCache* imagecache, std::string& tmpfile)
+{
+    if (!m_elaborated || !imagecache)
+        return false;
+
+    // If the image is unmodified since it was read -- same pixels, same
+    // data format, no metadata edits -- we can just drop the local
+    // copies and re-open the original file through the cache.
+    bool clean = !m_pixels_modified && !m_metadata_modified;
+    for (int s = 0; clean && s < subimages(); ++s)
+        clean &= m_subimages[s].was_direct_read();
+    if (clean && Filesystem::exists(name())
+        && Filesystem::last_write_time(name()) == m_time) {
+        for (int s = 0; s < subimages(); ++s)
+            for (int m = 0; m < miplevels(s); ++m) {
+                ImageBuf& ib(*m_subimages[s][m]);
+                if (ib.localpixels())
+                    ib.reset(name(), s, m, imagecache, configspec());
+            }
+        return true;
+    }
+
+    // Computed or modified pixels have no file to fall back on, so save
+    // them to a temporary file and re-point the ImageBuf at that. Only
+    // handle the overwhelmingly common shape for computed results: one
+    // subimage, one MIP level, not deep.
+    if (subimages() != 1 || miplevels(0) != 1)
+        return false;
+    ImageBuf& ib(*m_subimages[0][0]);
+    if (!ib.localpixels() || ib.deep())
+        return false;
+    // Keep float and half data as is; spill other types as float, which
+    // holds every uint8/uint16 value exactly.
+    TypeDesc format = ib.spec().format;
+    if (format != TypeFloat && format != TypeHalf)
+        format = TypeFloat;
+    std::string filename
+        = Filesystem::temp_directory_path() + "/"
+          + Filesystem::unique_path("oiiotool-spill-%%%%%%%%.exr");
+    if (!ib.write(filename, format)) {
+        errorfmt("{}", ib.geterror());
+        std::string err;
+        Filesystem::remove(filename, err);
+        return false;
+    }
+    ib.reset(filename, 0, 0, imagecache);
+    tmpfile = filename;
+    return true;
+}
+
+
 namespace {
 static spin_mutex err_mutex;
 }
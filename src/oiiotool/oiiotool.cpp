@@ -13,6 +13,7 @@
 #include <map>
 #include <numeric>
 #include <regex>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -72,38 +73,105 @@ using pvt::print_info_options;
         op();                                                        \
     }
 
+// Like OIIOTOOL_OP, but for strictly element-wise single-input ops, which
+// are safe to run with the output aliased to the input. When the input
+// isn't referenced anywhere else, this avoids materializing an
+// intermediate image for every step of a long correction chain.
+#define OIIOTOOL_INPLACE_OP(name, ninputs, ...)                      \
+    static void action_##name(Oiiotool& ot, cspan<const char*> argv) \
+    {                                                                \
+        if (ot.postpone_callback(ninputs, action_##name, argv))      \
+            return;                                                  \
+        OiiotoolOp op(ot, "-" #name, argv, ninputs, __VA_ARGS__);    \
+        op.inplace_elementwise(true);                                \
+        op();                                                        \
+    }
+
+// Like OIIOTOOL_OP, but additionally marks the op's impl as safe to run
+// concurrently on different subimages (see OiiotoolOp::parallel_subimages).
+// Only use this for impls that work purely through the `img` span handed
+// to them.
+#define OIIOTOOL_PARALLEL_OP(name, ninputs, ...)                     \
+    static void action_##name(Oiiotool& ot, cspan<const char*> argv) \
+    {                                                                \
+        if (ot.postpone_callback(ninputs, action_##name, argv))      \
+            return;                                                  \
+        OiiotoolOp op(ot, "-" #name, argv, ninputs, __VA_ARGS__);    \
+        op.parallel_subimages(true);                                 \
+        op();                                                        \
+    }
+
+// Ditto, for element-wise ops that may also run in place.
+#define OIIOTOOL_PARALLEL_INPLACE_OP(name, ninputs, ...)             \
+    static void action_##name(Oiiotool& ot, cspan<const char*> argv) \
+    {                                                                \
+        if (ot.postpone_callback(ninputs, action_##name, argv))      \
+            return;                                                  \
+        OiiotoolOp op(ot, "-" #name, argv, ninputs, __VA_ARGS__);    \
+        op.inplace_elementwise(true);                                \
+        op.parallel_subimages(true);                                 \
+        op();                                                        \
+    }
+
 // Canned setup for an op that uses one image on the stack.
-#define UNARY_IMAGE_OP(name, impl)                                 \
-    OIIOTOOL_OP(name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) { \
-        return impl(*img[0], *img[1]);                             \
+#define UNARY_IMAGE_OP(name, impl)                                          \
+    OIIOTOOL_PARALLEL_OP(name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) { \
+        return impl(*img[0], *img[1]);                                      \
     })
 
 // Canned setup for an op that uses two images on the stack.
-#define BINARY_IMAGE_OP(name, impl)                                \
-    OIIOTOOL_OP(name, 2, [](OiiotoolOp& op, span<ImageBuf*> img) { \
-        return impl(*img[0], *img[1], *img[2]);                    \
+#define BINARY_IMAGE_OP(name, impl)                                         \
+    OIIOTOOL_PARALLEL_OP(name, 2, [](OiiotoolOp& op, span<ImageBuf*> img) { \
+        return impl(*img[0], *img[1], *img[2]);                             \
     })
 
+// Like UNARY_IMAGE_OP, for element-wise ops that may run in place.
+#define UNARY_IMAGE_INPLACE_OP(name, impl)                 \
+    OIIOTOOL_PARALLEL_INPLACE_OP(                          \
+        name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) { \
+            return impl(*img[0], *img[1]);                 \
+        })
+
 // Canned setup for an op that uses one image on the stack and one float
 // on the command line.
-#define BINARY_IMAGE_FLOAT_OP(name, impl)                          \
-    OIIOTOOL_OP(name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) { \
-        float val = Strutil::stof(op.args(1));                     \
-        return impl(*img[0], *img[1], val);                        \
+#define BINARY_IMAGE_FLOAT_OP(name, impl)                                   \
+    OIIOTOOL_PARALLEL_OP(name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) { \
+        float val = Strutil::stof(op.args(1));                              \
+        return impl(*img[0], *img[1], val);                                 \
     })
 
+// Like BINARY_IMAGE_FLOAT_OP, for element-wise ops that may run in place.
+#define BINARY_IMAGE_FLOAT_INPLACE_OP(name, impl)          \
+    OIIOTOOL_PARALLEL_INPLACE_OP(                          \
+        name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) { \
+            float val = Strutil::stof(op.args(1));         \
+            return impl(*img[0], *img[1], val);            \
+        })
+
 // Canned setup for an op that uses one image on the stack and one color
 // on the command line.
-#define BINARY_IMAGE_COLOR_OP(name, impl, defaultval)                   \
-    OIIOTOOL_OP(name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) {      \
-        int nchans = img[1]->spec().nchannels;                          \
-        std::vector<float> val(nchans, defaultval);                     \
-        int nvals = Strutil::extract_from_list_string(val, op.args(1)); \
-        val.resize(nvals);                                              \
-        val.resize(nchans, val.size() == 1 ? val.back() : defaultval);  \
-        return impl(*img[0], *img[1], val, ROI(), 0);                   \
+#define BINARY_IMAGE_COLOR_OP(name, impl, defaultval)                       \
+    OIIOTOOL_PARALLEL_OP(name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) { \
+        int nchans = img[1]->spec().nchannels;                              \
+        std::vector<float> val(nchans, defaultval);                         \
+        int nvals = Strutil::extract_from_list_string(val, op.args(1));     \
+        val.resize(nvals);                                                  \
+        val.resize(nchans, val.size() == 1 ? val.back() : defaultval);      \
+        return impl(*img[0], *img[1], val, ROI(), 0);                       \
     })
 
+// Like BINARY_IMAGE_COLOR_OP, for element-wise ops that may run in place.
+#define BINARY_IMAGE_COLOR_INPLACE_OP(name, impl, defaultval)               \
+    OIIOTOOL_PARALLEL_INPLACE_OP(                                           \
+        name, 1, [](OiiotoolOp& op, span<ImageBuf*> img) {                  \
+            int nchans = img[1]->spec().nchannels;                          \
+            std::vector<float> val(nchans, defaultval);                     \
+            int nvals = Strutil::extract_from_list_string(val, op.args(1)); \
+            val.resize(nvals);                                              \
+            val.resize(nchans, val.size() == 1 ? val.back() : defaultval);  \
+            return impl(*img[0], *img[1], val, ROI(), 0);                   \
+        })
+
 // Macro to fully set up the "action" function that straightforwardly
 // calls a custom OiiotoolOp class.
 #define OP_CUSTOMCLASS(name, opclass, ninputs)                       \
@@ -145,6 +213,7 @@ Oiiotool::clear_options()
     nativeread         = false;
     metamerge          = false;
     cachesize          = 4096;
+    memlimit           = 0;
     autotile           = 0;  // was: 4096
     // FIXME: Turned off autotile by default Jan 2018 after thinking that
     // it was possible to deadlock when doing certain parallel IBA functions
@@ -2220,6 +2289,7 @@ public:
     {
         fromspace = args(1);
         tospace   = args(2);
+        inplace_elementwise(true);  // colorconvert supports dst == src
     }
     bool setup() override
     {
@@ -2255,7 +2325,7 @@ public:
             // source.
             ot.warning(opname(), img[0]->geterror());
             // ok = ImageBufAlgo::copy (*img[0], *img[1], TypeDesc);
-            ok = img[0]->copy(*img[1]);
+            ok = (img[0] == img[1]) || img[0]->copy(*img[1]);
         }
         return ok;
     }
@@ -2566,13 +2636,48 @@ action_channels(Oiiotool& ot, cspan<const char*> argv)
     bool allsubimages    = options.get_int("allsubimages", ot.allsubimages);
 
     ImageRecRef A(ot.top());
-    ot.read(A);
 
     if (chanlist == "RGB")  // Fix common synonyms/mistakes
         chanlist = "R,G,B";
     else if (chanlist == "RGBA")
         chanlist = "R,G,B,A";
 
+    // If the image is still an unread file reference, sink the channel
+    // selection into the read itself rather than reading all the channels
+    // and then shuffling a copy. ImageRec::read() can apply a channel set
+    // as it reads (the same mechanism behind the -i:ch= option), and for a
+    // consecutive channel subset it reads only those channels, never
+    // holding the ones we're about to discard. That keeps memory flat for
+    // "read --ch ... -o" transcodes of very large images.
+    if (!A->elaborated() && ot.read_nativespec(A)
+        && (allsubimages || A->subimages() == 1)) {
+        std::vector<std::string> newchannelnames;
+        std::vector<int> channels;
+        std::vector<float> values;
+        const ImageSpec* nspec = A->nativespec(0, 0);
+        bool simple_subset = decode_channel_set(*nspec, chanlist,
+                                                newchannelnames, channels,
+                                                values, ot.eh);
+        // Only a plain ordered subset of existing channels, with no
+        // renaming or value fill-in, can be fully expressed as a read.
+        for (size_t c = 0, e = channels.size(); simple_subset && c < e; ++c)
+            simple_subset = (channels[c] == channels[0] + int(c)
+                             && channels[c] >= 0
+                             && newchannelnames[c]
+                                    == nspec->channel_name(channels[c]));
+        // An identity selection (all channels, original order) is a no-op
+        // and should not force a read at all.
+        bool identity = simple_subset && channels.size()
+                        && channels[0] == 0
+                        && int(channels.size()) == nspec->nchannels;
+        if (simple_subset && !identity && ot.read(A, ReadDefault, chanlist))
+            return;
+        // If anything went wrong, fall through to the usual route, which
+        // has the full error handling.
+    }
+
+    ot.read(A);
+
     // Decode the channel set, make the full list of ImageSpec's we'll
     // need to describe the new ImageRec with the altered channels.
     std::vector<int> allmiplevels;
@@ -3014,21 +3119,22 @@ BINARY_IMAGE_OP(mul, ImageBufAlgo::mul);          // --mul
 BINARY_IMAGE_OP(div, ImageBufAlgo::div);          // --div
 BINARY_IMAGE_OP(absdiff, ImageBufAlgo::absdiff);  // --absdiff
 
-BINARY_IMAGE_COLOR_OP(addc, ImageBufAlgo::add, 0);          // --addc
-BINARY_IMAGE_COLOR_OP(subc, ImageBufAlgo::sub, 0);          // --subc
-BINARY_IMAGE_COLOR_OP(mulc, ImageBufAlgo::mul, 1);          // --mulc
-BINARY_IMAGE_COLOR_OP(divc, ImageBufAlgo::div, 1);          // --divc
-BINARY_IMAGE_COLOR_OP(absdiffc, ImageBufAlgo::absdiff, 0);  // --absdiffc
-BINARY_IMAGE_COLOR_OP(powc, ImageBufAlgo::pow, 1.0f);       // --powc
-BINARY_IMAGE_FLOAT_OP(saturate, ImageBufAlgo::saturate);    // --saturate
+BINARY_IMAGE_COLOR_INPLACE_OP(addc, ImageBufAlgo::add, 0);          // --addc
+BINARY_IMAGE_COLOR_INPLACE_OP(subc, ImageBufAlgo::sub, 0);          // --subc
+BINARY_IMAGE_COLOR_INPLACE_OP(mulc, ImageBufAlgo::mul, 1);          // --mulc
+BINARY_IMAGE_COLOR_INPLACE_OP(divc, ImageBufAlgo::div, 1);          // --divc
+BINARY_IMAGE_COLOR_INPLACE_OP(absdiffc, ImageBufAlgo::absdiff, 0);  // --absdiffc
+BINARY_IMAGE_COLOR_INPLACE_OP(powc, ImageBufAlgo::pow, 1.0f);       // --powc
+BINARY_IMAGE_FLOAT_INPLACE_OP(saturate, ImageBufAlgo::saturate);  // --saturate
 
-UNARY_IMAGE_OP(abs, ImageBufAlgo::abs);  // --abs
+UNARY_IMAGE_INPLACE_OP(abs, ImageBufAlgo::abs);  // --abs
 
-UNARY_IMAGE_OP(premult, ImageBufAlgo::premult);      // --premult
-UNARY_IMAGE_OP(repremult, ImageBufAlgo::repremult);  // --repremult
+UNARY_IMAGE_INPLACE_OP(premult, ImageBufAlgo::premult);      // --premult
+UNARY_IMAGE_INPLACE_OP(repremult, ImageBufAlgo::repremult);  // --repremult
 
 // --unpremult
-OIIOTOOL_OP(unpremult, 1, [&](OiiotoolOp& op, span<ImageBuf*> img) {
+OIIOTOOL_INPLACE_OP(unpremult, 1,
+                    [&](OiiotoolOp& op, span<ImageBuf*> img) {
     if (img[1]->spec().get_int_attribute("oiio:UnassociatedAlpha")
         && img[1]->spec().alpha_channel >= 0) {
         ot.warning(
@@ -3045,6 +3151,23 @@ OIIOTOOL_OP(mad, 3, [&](OiiotoolOp& op, span<ImageBuf*> img) {
 });
 
 
+// --expr
+OIIOTOOL_INPLACE_OP(expr, 1, [&](OiiotoolOp& op, span<ImageBuf*> img) {
+    // Compile the statements once per image, then run them over all the
+    // pixels as one fused pass. The alternative -- a chain of --mulc,
+    // --addc, etc. -- materializes an intermediate image per step.
+    if (img[0] != img[1] && !img[0]->copy(*img[1]))
+        return false;
+    PixelExprProgram program;
+    std::string error;
+    if (!program.compile(op.args(1), img[0]->spec(), error)) {
+        ot.errorfmt(op.opname(), "{}", error);
+        return false;
+    }
+    return program.run(*img[0]);
+});
+
+
 // --invert
 OIIOTOOL_OP(invert, 1, [&](OiiotoolOp& op, span<ImageBuf*> img) {
     ROI roi = img[1]->roi();
@@ -3492,6 +3615,28 @@ action_create(Oiiotool& ot, cspan<const char*> argv)
 
 
 
+// --thumbnail
+static void
+action_thumbnail(Oiiotool& ot, cspan<const char*> argv)
+{
+    OIIO_DASSERT(argv.size() == 2);
+    string_view command = ot.express(argv[0]);
+    OTScopedTimer timer(ot, command);
+    auto options         = ot.extract_options(command);
+    std::string filename = ot.express(argv[1]);
+    int goalsize         = options.get_int("size", 256);
+    ImageBuf proxy       = ImageBufAlgo::fast_proxy(filename, goalsize);
+    if (proxy.has_error()) {
+        ot.error(command, proxy.geterror());
+        return;
+    }
+    ImageRecRef img(new ImageRec(std::make_shared<ImageBuf>(std::move(proxy)),
+                                 false /*copy_pixels*/));
+    ot.push(img);
+}
+
+
+
 // --pattern
 static void
 action_pattern(Oiiotool& ot, cspan<const char*> argv)
@@ -4695,10 +4840,10 @@ action_fill(Oiiotool& ot, cspan<const char*> argv)
 
 
 BINARY_IMAGE_OP(max, ImageBufAlgo::max);            // --max
-BINARY_IMAGE_COLOR_OP(maxc, ImageBufAlgo::max, 0);  // --maxc
+BINARY_IMAGE_COLOR_INPLACE_OP(maxc, ImageBufAlgo::max, 0);  // --maxc
 UNARY_IMAGE_OP(maxchan, ImageBufAlgo::maxchan);     // --maxchan
 BINARY_IMAGE_OP(min, ImageBufAlgo::min);            // --min
-BINARY_IMAGE_COLOR_OP(minc, ImageBufAlgo::min, 0);  // --minc
+BINARY_IMAGE_COLOR_INPLACE_OP(minc, ImageBufAlgo::min, 0);  // --minc
 UNARY_IMAGE_OP(minchan, ImageBufAlgo::minchan);     // --minchan
 
 
@@ -4746,13 +4891,15 @@ action_clamp(Oiiotool& ot, cspan<const char*> argv)
 
 
 // --rangecompress
-OIIOTOOL_OP(rangecompress, 1, [&](OiiotoolOp& op, span<ImageBuf*> img) {
+OIIOTOOL_INPLACE_OP(rangecompress, 1,
+                    [&](OiiotoolOp& op, span<ImageBuf*> img) {
     bool useluma = op.options().get_int("luma");
     return ImageBufAlgo::rangecompress(*img[0], *img[1], useluma);
 });
 
 // --rangeexpand
-OIIOTOOL_OP(rangeexpand, 1, [&](OiiotoolOp& op, span<ImageBuf*> img) {
+OIIOTOOL_INPLACE_OP(rangeexpand, 1,
+                    [&](OiiotoolOp& op, span<ImageBuf*> img) {
     bool useluma = op.options().get_int("luma");
     return ImageBufAlgo::rangeexpand(*img[0], *img[1], useluma);
 });
@@ -6128,6 +6275,8 @@ Oiiotool::getargs(int argc, char* argv[])
       .help("Debug mode");
     ap.arg("--runstats", &ot.runstats)
       .help("Print runtime statistics");
+    ap.arg("--traceops %s:FILENAME", &ot.traceops_file)
+      .help("Write per-op wall time, I/O time, ImageCache bytes read, and memory use to FILENAME in Chrome trace-event JSON format");
     ap.arg("--buildinfo")
       .help("Print OIIO build information")
       .action([&](cspan<const char*>){
@@ -6183,9 +6332,16 @@ Oiiotool::getargs(int argc, char* argv[])
     ap.arg("--native")
       .help("Keep native pixel data type (bypass cache if necessary)")
       .OTACTION(set_native);
+    ap.arg("--readonce")
+      .help("Treat inputs as read-once streams: advise the OS to drop their pages from its cache as they are consumed (for one-pass transcodes of large sequences)")
+      .action([&](cspan<const char*>){
+                  OIIO::attribute("read:drop_cache", 1);
+              });
     ap.arg("--cache %d:MB")
       .help("ImageCache size (in MB: default=4096)")
       .OTACTION(set_cachesize);
+    ap.arg("--memlimit %d:MB", &ot.memlimit)
+      .help("Spill least-recently-used stack images to cache-backed storage when they exceed this memory budget (in MB: default=0, meaning no limit)");
     ap.arg("--autotile %d:TILESIZE")
       .help("Autotile enable for cached images (the argument is the tile size, default 0 means no autotile)")
       .OTACTION(set_autotile);
@@ -6241,6 +6397,8 @@ Oiiotool::getargs(int argc, char* argv[])
       .help("Skip to next frame in range if there's an error, rather than exiting");
     ap.arg("--parallel-frames")
       .help("Parallelize evaluation of frame range");
+    ap.arg("--batch %s:FILE")
+      .help("Run each line of FILE as a separate oiiotool command within this one process (\"-\" reads commands from stdin)");
     ap.arg("--wildcardoff")
       .help("Disable numeric wildcard expansion for subsequent command line arguments");
     ap.arg("--wildcardon")
@@ -6408,6 +6566,9 @@ Oiiotool::getargs(int argc, char* argv[])
     ap.arg("--create %s:GEOM %d:NCHANS")
       .help("Create a blank image")
       .OTACTION( action_create);
+    ap.arg("--thumbnail %s:FILENAME")
+      .help("Load the cheapest available preview of an image file (options: size=%d)")
+      .OTACTION(action_thumbnail);
     ap.arg("--pattern %s:NAME %s:GEOM %d:NCHANS")
       .help("Create a patterned image. Pattern name choices: black, constant, fill, checker, noise")
       .OTACTION( action_pattern);
@@ -6471,6 +6632,9 @@ Oiiotool::getargs(int argc, char* argv[])
     ap.arg("--absdiffc %s:VAL")
       .help("Absolute difference versus a scalar or per-channel constant (e.g.: 0.5 or 1,1.25,0.5)")
       .OTACTION(action_absdiffc);
+    ap.arg("--expr %s:STATEMENTS")
+      .help("Evaluate per-pixel channel assignments in one fused pass (e.g.: \"R=R*0.5+0.1; A=1\"; channels by name or r,g,b,a; functions abs, sqrt, min, max, clamp)")
+      .OTACTION(action_expr);
     ap.arg("--powc %s:VAL")
       .help("Raise the image values to a scalar or per-channel power (e.g.: 2.2 or 2.2,2.2,2.2,1.0)")
       .OTACTION(action_powc);
@@ -6798,10 +6962,65 @@ Oiiotool::merge_stats(const Oiiotool& ot)
         function_times[t.first] += t.second;
     }
     peak_memory = std::max(peak_memory, ot.peak_memory);
+    op_traces.insert(op_traces.end(), ot.op_traces.begin(),
+                     ot.op_traces.end());
     if (ot.return_value != EXIT_SUCCESS)
         return_value = ot.return_value;
     num_outputs += ot.num_outputs;
     printed_info |= ot.printed_info;
+    spill_files.insert(spill_files.end(), ot.spill_files.begin(),
+                       ot.spill_files.end());
+}
+
+
+
+void
+Oiiotool::enforce_memlimit()
+{
+    size_t budget = size_t(memlimit) * 1024 * 1024;
+    if (!budget)
+        return;
+
+    // Tally the distinct images reachable from the stack and the labels.
+    // Labels often alias stack entries, so count each ImageRec only once.
+    std::set<ImageRec*> seen;
+    size_t resident = 0;
+    auto tally      = [&](const ImageRecRef& img) {
+        if (img && seen.insert(img.get()).second)
+            resident += img->local_pixel_bytes();
+    };
+    tally(curimg);
+    for (auto& img : image_stack)
+        tally(img);
+    for (auto& l : image_labels)
+        tally(l.second);
+    if (resident <= budget)
+        return;
+
+    // Over budget: spill from the bottom of the stack upward -- those are
+    // the least recently used images -- then labeled images, leaving the
+    // current image alone since it's the most likely next operand.
+    auto spill_one = [&](const ImageRecRef& img) {
+        if (resident <= budget || !img || img == curimg)
+            return;
+        size_t bytes = img->local_pixel_bytes();
+        if (!bytes)
+            return;
+        std::string tmpfile;
+        if (img->spill(imagecache, tmpfile)) {
+            resident -= bytes;
+            if (tmpfile.size())
+                spill_files.push_back(tmpfile);
+            if (debug)
+                print("  memlimit: spilled \"{}\" ({}, {})\n", img->name(),
+                      Strutil::memformat(bytes),
+                      tmpfile.size() ? "to temp file" : "re-read from source");
+        }
+    };
+    for (auto& img : image_stack)
+        spill_one(img);
+    for (auto& l : image_labels)
+        spill_one(l.second);
 }
 
 
@@ -6863,6 +7082,8 @@ one_sequence_iteration(Oiiotool& otmain, size_t i, int frame_number,
         otmain.debug = true;
     if (otit.noerrexit)
         otmain.noerrexit = true;
+    if (otit.traceops_file.size())
+        otmain.traceops_file = otit.traceops_file;
     if (otit.runstats) {
         std::lock_guard<std::mutex> lock(otmain.m_stat_mutex);
         otmain.runstats = true;
@@ -7035,9 +7256,36 @@ handle_sequence(Oiiotool& ot, int argc, const char** argv)
     // every time.
     // Note: nfilenames really means, number of frame number iterations.
     if (ot.parallel_frames) {
-        // If --parframes was used, run the iterations in parallel.
+        // If --parallel-frames was used, run the iterations concurrently
+        // as top-level tasks on the default thread pool. Cap the number of
+        // frames in flight so that the expected aggregate footprint of the
+        // concurrent iterations stays within a memory budget (half of
+        // physical memory), rather than letting every pool thread hold a
+        // frame's worth of input and intermediates at once. We estimate a
+        // frame's footprint from the specs of the first frame of each
+        // input sequence, times a rough allowance for the intermediate
+        // images the command chain will make along the way.
+        int maxthreads = 0;  // 0 means one frame per pool thread
+        imagesize_t framebytes = 0;
+        for (size_t i = 0; i < sequence_args.size(); ++i) {
+            if (sequence_is_output[i])
+                continue;
+            ImageSpec spec;
+            if (ot.imagecache->get_imagespec(
+                    ustring(filenames[sequence_args[i]][0]), spec))
+                framebytes += spec.image_bytes();
+        }
+        if (framebytes) {
+            imagesize_t estimate = 4 * framebytes;
+            imagesize_t budget   = Sysutil::physical_memory() / 2;
+            maxthreads = int(OIIO::clamp(budget / estimate, imagesize_t(1),
+                                         imagesize_t(
+                                             Sysutil::hardware_concurrency())));
+        }
         if (ot.debug)
-            print("Running {} frames in parallel\n", nfilenames);
+            print("Running {} frames in parallel ({} at a time)\n", nfilenames,
+                  maxthreads ? maxthreads
+                             : int(Sysutil::hardware_concurrency()));
         parallel_for(
             uint64_t(0), uint64_t(nfilenames),
             [&](uint64_t i) {
@@ -7045,7 +7293,7 @@ handle_sequence(Oiiotool& ot, int argc, const char** argv)
                                        sequence_args, filenames,
                                        { argv, argv + argc });
             },
-            paropt().minitems(1));
+            paropt().minitems(1).maxthreads(maxthreads));
     } else {
         // Fully serialized over the frame range, multithreaded for each frame
         // individually.
@@ -7059,6 +7307,122 @@ handle_sequence(Oiiotool& ot, int argc, const char** argv)
 
 
 
+// Check if the command line is exactly "oiiotool --batch FILE" (FILE may
+// be "-" for stdin). If not, just return 'false'. If so, run each
+// non-blank, non-comment line of the file as its own oiiotool command,
+// all within this one process, and return 'true'. Compared to invoking
+// oiiotool once per command, this pays the process startup costs -- the
+// format plugin catalog, color config parse, font enumeration -- only
+// once, and lets every command share the already-warmed ImageCache.
+static bool
+handle_batch(Oiiotool& otmain, int argc, const char** argv)
+{
+    if (argc != 3
+        || (strcmp(argv[1], "--batch") != 0 && strcmp(argv[1], "-batch") != 0))
+        return false;
+
+    std::string batchfilename = argv[2];
+    OIIO::ifstream file;
+    std::istream* in = &std::cin;
+    if (batchfilename != "-") {
+        Filesystem::open(file, batchfilename);
+        if (!file) {
+            otmain.errorfmt("--batch", "Could not open \"{}\"", batchfilename);
+            return true;
+        }
+        in = &file;
+    }
+
+    std::string line;
+    for (int linenum = 1; std::getline(*in, line); ++linenum) {
+        string_view rest(line);
+        Strutil::skip_whitespace(rest);
+        if (rest.empty() || rest.front() == '#')
+            continue;
+
+        // Tokenize the line into arguments, honoring quoting.
+        std::vector<std::string> args;
+        args.emplace_back(argv[0]);
+        string_view tok;
+        while (Strutil::parse_string(rest, tok))
+            args.emplace_back(tok);
+        std::vector<const char*> cargs;
+        for (auto& a : args)
+            cargs.push_back(a.c_str());
+
+        // Run the command with its own Oiiotool (fresh image stack and
+        // per-command state), sharing the main instance's ImageCache,
+        // just like the frame-sequence iterations do.
+        Oiiotool otit;
+        otit.imagecache = otmain.imagecache;
+        if (!handle_sequence(otit, (int)cargs.size(), &cargs[0])) {
+            otit.getargs((int)cargs.size(), (char**)&cargs[0]);
+            if (!otit.ap.aborted()) {
+                otit.process_pending();
+                if (otit.pending_callback())
+                    otit.warning(otit.pending_callback_name(),
+                                 "pending command never executed");
+                if (!otit.control_stack.empty())
+                    otit.warningfmt(otit.control_stack.top().command,
+                                    "unterminated {}",
+                                    otit.control_stack.top().command);
+            }
+        }
+        if (otit.ap.aborted() || otit.return_value != EXIT_SUCCESS) {
+            // A failed command makes the whole batch exit with failure,
+            // but doesn't stop the remaining commands from running.
+            otmain.return_value = EXIT_FAILURE;
+            Strutil::print(stderr,
+                           "oiiotool: batch command failed ({} line {})\n",
+                           batchfilename, linenum);
+        }
+        otmain.merge_stats(otit);
+        if (otit.traceops_file.size())
+            otmain.traceops_file = otit.traceops_file;
+    }
+    return true;
+}
+
+
+
+// Write the events accumulated under --traceops as a Chrome trace-event
+// format JSON file (viewable with chrome://tracing or Perfetto). Each op
+// becomes one complete event, with its I/O time, ImageCache bytes read,
+// thread limit, and end-of-op memory use attached as args. Frame numbers
+// become trace thread lanes, so a --parallel-frames run displays one row
+// per frame in flight.
+static void
+write_traceops(Oiiotool& ot)
+{
+    std::sort(ot.op_traces.begin(), ot.op_traces.end(),
+              [](const Oiiotool::OpTraceEvent& a,
+                 const Oiiotool::OpTraceEvent& b) {
+                  return a.start < b.start;
+              });
+    std::string json = "{\"traceEvents\":[\n";
+    for (size_t i = 0, e = ot.op_traces.size(); i < e; ++i) {
+        const Oiiotool::OpTraceEvent& ev(ot.op_traces[i]);
+        json += Strutil::fmt::format(
+            "{}{{\"name\":\"{}\",\"cat\":\"op\",\"ph\":\"X\","
+            "\"ts\":{:.1f},\"dur\":{:.1f},\"pid\":1,\"tid\":{},"
+            "\"args\":{{\"io_s\":{:.6f},\"ic_bytes_read\":{},"
+            "\"mem_bytes\":{},\"threads\":{}}}}}\n",
+            i ? "," : "", Strutil::escape_chars(ev.name), ev.start * 1.0e6,
+            ev.duration * 1.0e6, ev.frame, ev.io_time, ev.ic_bytes, ev.memory,
+            ev.threads);
+    }
+    json += "]}\n";
+    OIIO::ofstream out;
+    Filesystem::open(out, ot.traceops_file);
+    if (!out) {
+        ot.errorfmt("--traceops", "Could not open \"{}\"", ot.traceops_file);
+        return;
+    }
+    out << json;
+}
+
+
+
 int
 main(int argc, char* argv[])
 {
@@ -7107,9 +7471,16 @@ main(int argc, char* argv[])
     ot.imagecache->attribute("max_memory_MB", float(ot.cachesize));
     ot.imagecache->attribute("autotile", ot.autotile);
     ot.imagecache->attribute("autoscanline", int(ot.autotile ? 1 : 0));
+    // Recycle freed pixel buffers between ops: each op result is a fresh
+    // ImageBuf, and without the pool, allocating and first-touching big
+    // buffers over and over is a surprising fraction of recipe time.
+    OIIO::attribute("imagebuf:scratch_pool", 1024);
 
     Filesystem::convert_native_arguments(argc, (const char**)argv);
-    if (handle_sequence(ot, argc, (const char**)argv)) {
+    if (handle_batch(ot, argc, (const char**)argv)) {
+        // Batch file of commands, already handled
+
+    } else if (handle_sequence(ot, argc, (const char**)argv)) {
         // Deal with sequence
 
     } else {
@@ -7174,6 +7545,9 @@ main(int argc, char* argv[])
         print("\n{}\n", ot.imagecache->getstats(2));
     }
 
+    if (ot.traceops_file.size())
+        write_traceops(ot);
+
     // Release references of images that might hold onto a shared
     // image cache. Otherwise they would get released at static destruction
     // time, at which point due to undefined destruction order the shared
@@ -7181,6 +7555,11 @@ main(int argc, char* argv[])
     ot.curimg = nullptr;
     ot.image_stack.clear();
     ot.image_labels.clear();
+    // Delete any temp files that --memlimit spilled computed images into.
+    for (auto& f : ot.spill_files) {
+        std::string err;
+        Filesystem::remove(f, err);
+    }
     shutdown();
     return ot.return_value;
 }
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <stack>
@@ -18,6 +19,7 @@
 #include <OpenImageIO/errorhandler.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagecache.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/sysutil.h>
 #include <OpenImageIO/timer.h>
 
@@ -75,6 +77,7 @@ public:
     bool printinfo_verbose;
     bool metamerge;  // Merge source input metadata into output
     int cachesize;
+    int memlimit;  // Stack memory budget (MB), 0 means no limit
     int autotile;
     int frame_padding;
     bool eval_enable;              // Enable evaluation of expressions
@@ -88,6 +91,7 @@ public:
     std::string printinfo_nometamatch;
     std::string printinfo_format;
     std::string missingfile_policy;
+    std::string traceops_file;  // If set, write per-op trace JSON here
     ImageSpec input_config;  // configuration options for reading
     ImageSpec first_input_dimensions;
     std::string input_channel_set;  // Optional input channel set
@@ -140,6 +144,7 @@ public:
     ImageRecRef curimg;                    // current image
     std::vector<ImageRecRef> image_stack;  // stack of previous images
     std::map<std::string, ImageRecRef> image_labels;  // labeled images
+    std::vector<std::string> spill_files;  // temp files from enforce_memlimit
     ImageCache* imagecache = nullptr;                 // back ptr to ImageCache
     ColorConfig colorconfig;                          // OCIO color config
     Timer total_runtime;
@@ -150,6 +155,18 @@ public:
     double total_imagecache_readtime = 0.0;
     typedef std::map<std::string, double> TimingMap;
     TimingMap function_times;
+    // One record per executed op, accumulated when --traceops is active.
+    struct OpTraceEvent {
+        std::string name;   // op name
+        double start;       // seconds since trace epoch (see trace_clock)
+        double duration;    // wall time of the op, in seconds
+        double io_time;     // portion spent on file reads / ImageCache
+        int64_t ic_bytes;   // bytes read through the ImageCache by the op
+        size_t memory;      // process memory use when the op finished
+        int threads;        // thread limit in effect for the op
+        int frame;          // frame number (varies with --parallel-frames)
+    };
+    std::vector<OpTraceEvent> op_traces;
     size_t peak_memory          = 0;
     int return_value            = EXIT_SUCCESS;  // oiiotool command return code
     int num_outputs             = 0;             // Count of outputs written
@@ -326,6 +343,11 @@ public:
         return mem;
     }
 
+    // If --memlimit is set and the images held on the stack collectively
+    // exceed the budget, spill the least recently used ones to
+    // cache-backed storage (see ImageRec::spill).
+    void enforce_memlimit();
+
     static std::string format_read_error(string_view filename, std::string err)
     {
         if (!err.size())
@@ -510,6 +532,20 @@ public:
     bool read(ReadPolicy readpolicy   = ReadDefault,
               string_view channel_set = "");
 
+    // Total bytes of locally-allocated pixel memory held by the
+    // ImageBufs of this image (0 if unelaborated or cache-backed).
+    size_t local_pixel_bytes() const;
+
+    // Release the local pixel memory held by this image by re-pointing
+    // its ImageBufs at cache-backed storage, from which the pixels will
+    // be lazily re-read if the image is used again. An image that is
+    // unmodified since being read from disk is simply re-opened through
+    // the cache from its original file; a computed image is first saved
+    // to a temporary file (whose name is returned in `tmpfile` so the
+    // caller can delete it at exit). Return true if memory was released,
+    // false if this image isn't spillable.
+    bool spill(ImageCache* imagecache, std::string& tmpfile);
+
     // ir(subimg,mip) references a specific MIP level of a subimage
     // ir(subimg) references the first MIP level of a subimage
     // ir() references the first MIP level of the first subimage
@@ -691,6 +727,75 @@ apply_spec_mod(Oiiotool& ot, ImageRecRef img, Action act, const Type& t,
 
 
 
+// A small compiled program for the --expr per-pixel expression op.
+// Semicolon-separated statements like "R = R*0.5 + 0.1; A = 1" are
+// compiled once into stack-machine bytecode, then run over the image as
+// one fused tile-parallel pass, instead of chaining a single-purpose IBA
+// call (and materializing an intermediate image) per arithmetic step.
+class PixelExprProgram {
+public:
+    // Compile semicolon-separated "channel = expression" statements
+    // against the given spec's channel names (with r/g/b/a aliases for
+    // the usual color channels). Expressions may use channel names,
+    // numeric constants, + - * / and parentheses, and the functions
+    // abs(), sqrt(), min(), max(), and clamp(). On failure, return false
+    // and place a message in `error`.
+    bool compile(string_view expression, const ImageSpec& spec,
+                 std::string& error);
+
+    // Run the compiled program on every pixel of img within roi,
+    // modifying the image in place.
+    bool run(ImageBuf& img, ROI roi = {}, int nthreads = 0) const;
+
+private:
+    enum Opcode {
+        CONST,  // push a constant value
+        CHAN,   // push the value of channel `chan`
+        STORE,  // pop the result into channel `chan`, ending a statement
+        ADD,    // the arithmetic/function ops pop their operands and
+        SUB,    //   push their result
+        MUL,
+        DIV,  // division by 0 yields 0, like ImageBufAlgo::div
+        NEG,
+        ABS,
+        SQRT,  // sqrt of a negative value yields 0
+        MIN2,
+        MAX2,
+        CLAMP3
+    };
+    struct Inst {
+        Opcode op;
+        int chan    = 0;
+        float value = 0.0f;
+    };
+    static const int eval_stack_size = 16;
+    std::vector<Inst> m_code;
+
+    // Recursive descent parsing, emitting postfix code into m_code.
+    bool parse_expr(string_view& s, const ImageSpec& spec, std::string& error);
+    bool parse_term(string_view& s, const ImageSpec& spec, std::string& error);
+    bool parse_factor(string_view& s, const ImageSpec& spec,
+                      std::string& error);
+    int channel_index(string_view name, const ImageSpec& spec) const;
+};
+
+
+
+// Seconds elapsed since the first call to this function in the process.
+// This is the time base for --traceops events: unlike per-Oiiotool timers,
+// it is shared by all the Oiiotool instances made for frame sequence
+// iterations, so events from --parallel-frames land on a common timeline.
+inline double
+trace_clock()
+{
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                         - epoch)
+        .count();
+}
+
+
+
 // Helper class that starts and stops a timer when the ScopedTimer goes in and
 // out of scope. This has special magic to make sure that any I/O time during
 // this period is credited to "-i" and not to the named op.
@@ -713,6 +818,13 @@ public:
         stop();
         m_ot.function_times[m_name] += m_timer() - m_io_time;
         m_ot.function_times["-i"] += m_io_time;
+        if (m_ot.traceops_file.size()) {
+            m_ot.op_traces.push_back({ m_name, m_start_time, m_timer(),
+                                       m_io_time, m_ic_bytes,
+                                       Sysutil::memory_used(),
+                                       OIIO::get_int_attribute("threads"),
+                                       m_ot.frame_number });
+        }
     }
 
     // Explicit start of the timer.
@@ -720,11 +832,16 @@ public:
     {
         if (m_timer.ticking())
             return;
+        if (m_start_time < 0)
+            m_start_time = trace_clock();
         m_timer.start();
         // Record how much time we've spent so far on reads and IC.
         // We will use that to correctly credit each account.
         m_pre_input_time = m_ot.total_readtime();
         m_ot.imagecache->getattribute("stat:fileio_time", m_pre_ic_time);
+        if (m_ot.traceops_file.size())
+            m_ot.imagecache->getattribute("stat:bytes_read", TypeInt64,
+                                          &m_pre_ic_bytes);
     }
 
     // Explicit stop of the timer.
@@ -734,6 +851,12 @@ public:
         m_ot.imagecache->getattribute("stat:fileio_time", ic_time);
         m_io_time += (ic_time - m_pre_ic_time + m_ot.total_readtime()
                       - m_pre_input_time);
+        if (m_ot.traceops_file.size()) {
+            int64_t icbytes = 0;
+            m_ot.imagecache->getattribute("stat:bytes_read", TypeInt64,
+                                          &icbytes);
+            m_ic_bytes += icbytes - m_pre_ic_bytes;
+        }
         m_timer.stop();
     }
 
@@ -747,6 +870,9 @@ private:
     double m_pre_input_time = 0.0f;
     double m_pre_ic_time    = 0.0f;
     double m_io_time        = 0.0f;
+    double m_start_time     = -1.0;  // trace_clock time of the first start()
+    int64_t m_pre_ic_bytes  = 0;
+    int64_t m_ic_bytes      = 0;
 };
 
 
@@ -831,6 +957,19 @@ public:
                 // If instructed to operate in place, just make the output
                 // another reference to the first input image.
                 m_ir[0] = m_ir[1];
+            } else if (inplace_elementwise() && nimages() == 2
+                       && m_ir[1].use_count() == 1 && m_ir[1]->elaborated()) {
+                // Element-wise op whose only remaining reference to its
+                // input is our own (nothing else on the stack or in a
+                // label can see it): run with the output aliased to the
+                // input, eliding the allocation and fill of an
+                // intermediate image. Unlike the inplace() case, the
+                // pixels really are rewritten, so clear the bookkeeping
+                // that says they still match the file on disk.
+                m_ir[0] = m_ir[1];
+                for (int s = 0; s < m_ir[0]->subimages(); ++s)
+                    (*m_ir[0])[s].was_direct_read(false);
+                m_ir[0]->pixels_modified(true);
             } else {
                 // Not in-place, so make a new output image.
                 m_ir[0] = new_output_imagerec();
@@ -855,6 +994,8 @@ public:
 
         if (ot.debug || ot.runstats)
             ot.check_peak_memory();
+        if (ot.memlimit)
+            ot.enforce_memlimit();
 
         // Optional cleanup after processing all the subimages
         cleanup();
@@ -870,6 +1011,48 @@ public:
 
     virtual void traverse_subimages(int subimages)
     {
+        // If the op declared its impl safe to run concurrently and there
+        // are several subimages, process them as sibling tasks sharing
+        // the thread pool. (Metadata merging mutates the output spec from
+        // each input in order, so that mode keeps the serial route.)
+        if (parallel_subimages() && subimages > 1 && !ot.metamerge) {
+            struct SubimageTask {
+                int s, m;
+                std::vector<ImageBuf*> img;
+                bool active;
+                bool ok = true;
+            };
+            std::vector<SubimageTask> tasks;
+            for (int s = 0; s < subimages; ++s) {
+                for (int m = 0, nmip = ir(0)->miplevels(); m < nmip; ++m) {
+                    SubimageTask task { s, m, {}, subimage_is_active(s) };
+                    for (int i = 0; i < nimages(); ++i)
+                        task.img.push_back(
+                            &((*ir(i))(std::min(s, ir(i)->subimages() - 1),
+                                       std::min(m, ir(i)->miplevels(s)))));
+                    tasks.push_back(std::move(task));
+                }
+            }
+            parallel_for(int64_t(0), int64_t(tasks.size()), [&](int64_t i) {
+                SubimageTask& task(tasks[i]);
+                if (task.active)
+                    task.ok = impl(task.img);
+                else if (nimages() >= 2 && task.img[0] != task.img[1])
+                    task.ok = task.img[0]->copy(*task.img[1]);
+            });
+            // Error forwarding and spec bookkeeping happen back on this
+            // thread, in subimage order.
+            for (auto& task : tasks) {
+                if (!task.ok)
+                    ot.errorfmt(opname(), "{}", task.img[0]->geterror());
+                m_ir[0]->update_spec_from_imagebuf(task.s, task.m);
+                for (auto& im : task.img)
+                    if (im->has_error())
+                        ot.errorfmt(opname(), "{}", im->geterror());
+            }
+            return;
+        }
+
         // For each subimage, find the ImageBuf's for input and output
         // images, and call impl().
         for (int s = 0; s < subimages; ++s) {
@@ -894,8 +1077,10 @@ public:
                             m_img[0]->specmod().extra_attribs.merge(
                                 m_img[i]->spec().extra_attribs);
                 } else {
-                    // Inactive subimage, just copy.
-                    if (nimages() >= 2)
+                    // Inactive subimage, just copy (unless the output is
+                    // aliased to the input, in which case it's already
+                    // there).
+                    if (nimages() >= 2 && m_img[0] != m_img[1])
                         m_img[0]->copy(*m_img[1]);
                 }
                 m_ir[0]->update_spec_from_imagebuf(s, m);
@@ -1076,6 +1261,29 @@ public:
     void inplace(bool val) { m_inplace = val; }
     bool inplace() const { return m_inplace; }
 
+    // Call inplace_elementwise(true) for an op that is strictly
+    // element-wise -- each output pixel depends only on the same pixel of
+    // the single input -- and therefore safe to execute with the output
+    // aliased to the input (all the IBA element-wise ops support
+    // `dst == src`). When set, the op will run in place *if* its input
+    // image turns out not to be referenced anywhere else, skipping the
+    // intermediate image that would otherwise be allocated and written.
+    // This makes long chains of element-wise corrections (--mulc, --addc,
+    // --clamp and friends) churn one buffer instead of one per op.
+    void inplace_elementwise(bool val) { m_inplace_elementwise = val; }
+    bool inplace_elementwise() const { return m_inplace_elementwise; }
+
+    // Call parallel_subimages(true) for an op whose impl may safely run
+    // concurrently on different subimages -- i.e., it works only through
+    // the `img` span passed to it (plus read-only state like options()),
+    // and doesn't consult current_subimage()/current_miplevel(). When
+    // set, a multi-subimage traversal runs the subimages as sibling
+    // tasks on the thread pool, which uses the machine much better than
+    // per-image threading when each subimage is small (such as the many
+    // AOV parts of a multi-part EXR).
+    void parallel_subimages(bool val) { m_parallel_subimages = val; }
+    bool parallel_subimages() const { return m_parallel_subimages; }
+
     int current_subimage() const { return m_current_subimage; }
     int current_miplevel() const { return m_current_miplevel; }
 
@@ -1084,9 +1292,11 @@ protected:
     std::string m_opname;
     int m_nargs;
     int m_nimages;
-    bool m_preserve_miplevels = false;
-    bool m_skip_impl          = false;
-    bool m_inplace            = false;
+    bool m_preserve_miplevels  = false;
+    bool m_skip_impl           = false;
+    bool m_inplace             = false;
+    bool m_inplace_elementwise = false;
+    bool m_parallel_subimages  = false;
     std::vector<ImageRecRef> m_ir;
     std::vector<ImageBuf*> m_img;
     std::vector<string_view> m_args;
@@ -275,8 +275,10 @@ OpenEXRInput::open(const std::string& name, ImageSpec& newspec,
     m_subimage = -1;
     m_miplevel = -1;
 
-    // Set up for the first subimage ("part"). This will trigger reading
-    // information about all the parts.
+    // Set up for the first subimage ("part"). Only part 0's header is
+    // parsed here; the other parts' attributes are deferred until a part
+    // is actually sought or its spec is requested, so opening a many-part
+    // file costs no more than a single-part one.
     bool ok = seek_subimage(0, 0);
     if (ok)
         newspec = m_spec;
@@ -1043,13 +1045,19 @@ OpenEXRInput::spec(int subimage, int miplevel)
     ImageSpec ret;
     if (subimage < 0 || subimage >= m_nsubimages)
         return ret;  // invalid
-    const PartInfo& part(m_parts[subimage]);
+    PartInfo& part(m_parts[subimage]);
     if (!part.initialized) {
-        // Only if this subimage hasn't yet been inventoried do we need
-        // to lock and seek.
+        // Only if this subimage hasn't yet been inventoried do we need to
+        // lock and parse its header. Note that we deliberately parse the
+        // header directly rather than going through seek_subimage, so that
+        // merely inventorying another part doesn't tear down and rebuild
+        // the reader for the part actively being read.
         lock_guard lock(*this);
         if (!part.initialized) {
-            if (!seek_subimage(subimage, miplevel))
+            const Imf::Header* header = NULL;
+            if (m_input_multipart)
+                header = &(m_input_multipart->header(subimage));
+            if (!part.parse_header(this, header))
                 return ret;
         }
     }
@@ -1068,13 +1076,19 @@ OpenEXRInput::spec_dimensions(int subimage, int miplevel)
     ImageSpec ret;
     if (subimage < 0 || subimage >= m_nsubimages)
         return ret;  // invalid
-    const PartInfo& part(m_parts[subimage]);
+    PartInfo& part(m_parts[subimage]);
     if (!part.initialized) {
-        // Only if this subimage hasn't yet been inventoried do we need
-        // to lock and seek.
+        // Only if this subimage hasn't yet been inventoried do we need to
+        // lock and parse its header (directly, not via seek_subimage --
+        // see the comment in spec() above).
         lock_guard lock(*this);
-        if (!seek_subimage(subimage, miplevel))
-            return ret;
+        if (!part.initialized) {
+            const Imf::Header* header = NULL;
+            if (m_input_multipart)
+                header = &(m_input_multipart->header(subimage));
+            if (!part.parse_header(this, header))
+                return ret;
+        }
     }
     if (miplevel < 0 || miplevel >= part.nmiplevels)
         return ret;  // invalid
@@ -3,12 +3,16 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 #include <cerrno>
+#include <chrono>
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 
 #include <OpenImageIO/Imath.h>
@@ -128,6 +132,7 @@ public:
     bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
                                int z, int chbegin, int chend,
                                void* data) override;
+    int native_chunk_rows(int subimage, int miplevel) override;
     bool read_native_tile(int subimage, int miplevel, int x, int y, int z,
                           void* data) override;
     bool read_native_tiles(int subimage, int miplevel, int xbegin, int xend,
@@ -216,6 +221,10 @@ private:
         m_userdata.m_io  = nullptr;
         m_local_io.reset();
         m_missingcolor.clear();
+        m_chunkslot[0].reset();
+        m_chunkslot[1].reset();
+        m_last_chunk_subimage = -1;
+        m_last_chunk_y        = INT_MIN;
     }
 
     bool valid_file(const std::string& filename, Filesystem::IOProxy* io) const;
@@ -225,6 +234,54 @@ private:
                             int zbegin, int zend, int chbegin, int chend,
                             void* data, stride_t xstride, stride_t ystride);
 
+    // A decoded (or in-flight) scanline chunk retained by the sequential
+    // read pipeline. The pixel data lives in a shared_ptr so that a decode
+    // task still running on the thread pool only ever touches its own
+    // buffer, even if the slot has moved on.
+    struct ChunkSlot {
+        int subimage = -1;
+        int miplevel = -1;
+        int ystart   = 0;  // first scanline of the chunk
+        int nlines   = 0;  // number of scanlines held
+        int chbegin = 0, chend = 0;
+        size_t scanlinebytes = 0;
+        bool ok              = false;
+        std::shared_ptr<std::vector<uint8_t>> data;
+        std::future<bool> pending;  // valid while a decode is in flight
+
+        bool matches(int si, int mip, int y, int cb, int ce) const
+        {
+            return subimage == si && miplevel == mip && ystart == y
+                   && chbegin == cb && chend == ce;
+        }
+        void reset()
+        {
+            subimage = -1;
+            ok       = false;
+            data.reset();
+            pending = std::future<bool>();
+        }
+    };
+
+    // Decode one whole scanline chunk (all its scanlines, channel range
+    // [chbegin,chend)) into cdata. Returns true if it decoded cleanly.
+    bool decode_scanline_chunk(int subimage, int ystart, int chbegin,
+                               int chend, size_t pixelbytes,
+                               size_t scanlinebytes, uint8_t* cdata);
+
+    // Serve a request that lies within a single scanline chunk from the
+    // chunk pipeline, decoding (and possibly prefetching) as needed.
+    bool read_scanlines_pipelined(const ImageSpec& spec, int subimage,
+                                  int miplevel, int ybegin, int yend,
+                                  int chbegin, int chend, size_t pixelbytes,
+                                  size_t scanlinebytes, int scansperchunk,
+                                  void* data);
+
+    std::mutex m_chunk_mutex;      ///< Guards the chunk slots below
+    ChunkSlot m_chunkslot[2];      ///< [0] = current, [1] = read-ahead
+    int m_last_chunk_subimage = -1;  ///< For detecting sequential access
+    int m_last_chunk_y = INT_MIN;  ///< Chunk start y of the last request
+
     // Helper struct to destroy decoder upon scope exit
     class DecoderDestroyer {
     public:
@@ -432,8 +489,9 @@ OpenEXRCoreInput::open(const std::string& name, ImageSpec& newspec,
     m_subimage = -1;
     m_miplevel = -1;
 
-    // Set up for the first subimage ("part"). This will trigger reading
-    // information about all the parts.
+    // Set up for the first subimage ("part"). Only part 0's header is
+    // inventoried here; other parts' attribute parsing is deferred until
+    // a part is actually sought or its spec is requested.
     bool ok = seek_subimage(0, 0);
     if (ok)
         newspec = m_spec;
@@ -1067,13 +1125,15 @@ OpenEXRCoreInput::spec(int subimage, int miplevel)
     ImageSpec ret;
     if (subimage < 0 || subimage >= m_nsubimages)
         return ret;  // invalid
-    const PartInfo& part(m_parts[subimage]);
+    PartInfo& part(m_parts[subimage]);
     if (!part.initialized) {
-        // Only if this subimage hasn't yet been inventoried do we need
-        // to lock and seek.
+        // Only if this subimage hasn't yet been inventoried do we need to
+        // lock and parse its header. We parse directly rather than going
+        // through seek_subimage so that inventorying another part doesn't
+        // disturb the current seek state.
         lock_guard lock(*this);
         if (!part.initialized) {
-            if (!seek_subimage(subimage, miplevel))
+            if (!part.parse_header(this, m_exr_context, subimage, miplevel))
                 return ret;
         }
     }
@@ -1092,13 +1152,16 @@ OpenEXRCoreInput::spec_dimensions(int subimage, int miplevel)
     ImageSpec ret;
     if (subimage < 0 || subimage >= m_nsubimages)
         return ret;  // invalid
-    const PartInfo& part(m_parts[subimage]);
+    PartInfo& part(m_parts[subimage]);
     if (!part.initialized) {
-        // Only if this subimage hasn't yet been inventoried do we need
-        // to lock and seek.
+        // Only if this subimage hasn't yet been inventoried do we need to
+        // lock and parse its header (directly, not via seek_subimage --
+        // see the comment in spec() above).
         lock_guard lock(*this);
-        if (!seek_subimage(subimage, miplevel))
-            return ret;
+        if (!part.initialized) {
+            if (!part.parse_header(this, m_exr_context, subimage, miplevel))
+                return ret;
+        }
     }
     if (miplevel < 0 || miplevel >= part.nmiplevels)
         return ret;  // invalid
@@ -1112,6 +1175,11 @@ OpenEXRCoreInput::spec_dimensions(int subimage, int miplevel)
 bool
 OpenEXRCoreInput::close()
 {
+    // Wait out any in-flight read-ahead decode before tearing down the
+    // context it is using.
+    for (auto& slot : m_chunkslot)
+        if (slot.pending.valid())
+            slot.pending.wait();
     exr_finish(&m_exr_context);
     init();  // Reset to initial state
     return true;
@@ -1155,6 +1223,32 @@ OpenEXRCoreInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
 
 
 
+int
+OpenEXRCoreInput::native_chunk_rows(int subimage, int miplevel)
+{
+    // Scanline parts of an EXR file are compressed in chunks that decode
+    // independently, and our read_native_scanlines is safe -- and
+    // profitable -- to call concurrently for disjoint chunk-aligned
+    // ranges, since each chunk gets its own decoder pipeline. Advertise
+    // the chunk height so the generic read_image orchestration can hand
+    // bands of chunks to the thread pool. Tiled parts are read through
+    // read_native_tiles and deep parts through the deep API, so report 0
+    // for those.
+    if (!m_exr_context || miplevel != 0)
+        return 0;
+    exr_storage_t storage;
+    if (EXR_ERR_SUCCESS != exr_get_storage(m_exr_context, subimage, &storage)
+        || storage != EXR_STORAGE_SCANLINE)
+        return 0;
+    int32_t scansperchunk = 0;
+    if (EXR_ERR_SUCCESS
+        != exr_get_scanlines_per_chunk(m_exr_context, subimage, &scansperchunk))
+        return 0;
+    return scansperchunk;
+}
+
+
+
 bool
 OpenEXRCoreInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
                                         int yend, int /*z*/, int chbegin,
@@ -1190,6 +1284,18 @@ OpenEXRCoreInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
     yend            = std::min(endy, yend);
     int ychunkstart = spec.y
                       + round_down_to_multiple(ybegin - spec.y, scansperchunk);
+
+    // Requests that lie within a single compressed chunk -- the single
+    // scanline and scanline-at-a-time access patterns -- go through a small
+    // pipeline of retained chunks: each chunk is decompressed once rather
+    // than once per scanline requested from it, and sequential access kicks
+    // off a decode of the following chunk on the thread pool so it's
+    // already done by the time it is requested.
+    if (scansperchunk > 1 && yend <= ychunkstart + scansperchunk && !spec.deep)
+        return read_scanlines_pipelined(spec, subimage, miplevel, ybegin, yend,
+                                        chbegin, chend, pixelbytes,
+                                        scanlinebytes, scansperchunk, data);
+
     std::atomic<bool> ok(true);
     parallel_for_chunked(
         ychunkstart, yend, scansperchunk,
@@ -1305,6 +1411,144 @@ OpenEXRCoreInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
 
 
 
+bool
+OpenEXRCoreInput::decode_scanline_chunk(int subimage, int ystart, int chbegin,
+                                        int chend, size_t pixelbytes,
+                                        size_t scanlinebytes, uint8_t* cdata)
+{
+    const ImageSpec& spec(m_parts[subimage].spec);
+    exr_chunk_info_t cinfo;
+    exr_decode_pipeline_t decoder = EXR_DECODE_PIPELINE_INITIALIZER;
+    DecoderDestroyer dd(m_exr_context, &decoder);
+    // Note: the decoder will be destroyed by dd exiting scope
+    exr_result_t rv = exr_read_scanline_chunk_info(m_exr_context, subimage,
+                                                   ystart, &cinfo);
+    if (rv == EXR_ERR_SUCCESS)
+        rv = exr_decoding_initialize(m_exr_context, subimage, &cinfo, &decoder);
+    if (rv == EXR_ERR_SUCCESS) {
+        size_t chanoffset = 0;
+        for (int c = chbegin; c < chend; ++c) {
+            size_t chanbytes  = spec.channelformat(c).size();
+            string_view cname = spec.channel_name(c);
+            for (int dc = 0; dc < decoder.channel_count; ++dc) {
+                exr_coding_channel_info_t& curchan = decoder.channels[dc];
+                if (cname == curchan.channel_name) {
+                    curchan.decode_to_ptr     = cdata + chanoffset;
+                    curchan.user_pixel_stride = pixelbytes;
+                    curchan.user_line_stride  = scanlinebytes;
+                    chanoffset += chanbytes;
+                    break;
+                }
+            }
+        }
+        rv = exr_decoding_choose_default_routines(m_exr_context, subimage,
+                                                  &decoder);
+    }
+    if (rv == EXR_ERR_SUCCESS)
+        rv = exr_decoding_run(m_exr_context, subimage, &decoder);
+    return rv == EXR_ERR_SUCCESS;
+}
+
+
+
+bool
+OpenEXRCoreInput::read_scanlines_pipelined(const ImageSpec& spec, int subimage,
+                                           int miplevel, int ybegin, int yend,
+                                           int chbegin, int chend,
+                                           size_t pixelbytes,
+                                           size_t scanlinebytes,
+                                           int scansperchunk, void* data)
+{
+    int endy        = spec.y + spec.height;
+    int ychunkstart = spec.y
+                      + round_down_to_multiple(ybegin - spec.y, scansperchunk);
+    int nlines = std::min(scansperchunk, endy - ychunkstart);
+
+    std::lock_guard<std::mutex> lock(m_chunk_mutex);
+    ChunkSlot& cur   = m_chunkslot[0];
+    ChunkSlot& ahead = m_chunkslot[1];
+
+    // If the read-ahead slot holds the chunk we need and its decode has
+    // finished, promote it to the current slot.
+    if (!cur.matches(subimage, miplevel, ychunkstart, chbegin, chend)
+        && ahead.matches(subimage, miplevel, ychunkstart, chbegin, chend)
+        && ahead.pending.valid()
+        && ahead.pending.wait_for(std::chrono::seconds(0))
+               == std::future_status::ready) {
+        ahead.ok = ahead.pending.get();
+        std::swap(cur, ahead);
+        ahead.reset();
+    }
+
+    if (!cur.matches(subimage, miplevel, ychunkstart, chbegin, chend)) {
+        // Cache miss: decode the whole chunk into the current slot on the
+        // calling thread. (If a matching read-ahead hasn't finished yet, we
+        // decode redundantly rather than risk blocking on the pool -- rare,
+        // and at worst no slower than having no pipeline at all.)
+        cur.subimage      = subimage;
+        cur.miplevel      = miplevel;
+        cur.ystart        = ychunkstart;
+        cur.nlines        = nlines;
+        cur.chbegin       = chbegin;
+        cur.chend         = chend;
+        cur.scanlinebytes = scanlinebytes;
+        if (!cur.data)
+            cur.data = std::make_shared<std::vector<uint8_t>>();
+        cur.data->resize(scanlinebytes * nlines);
+        cur.ok = decode_scanline_chunk(subimage, ychunkstart, chbegin, chend,
+                                       pixelbytes, scanlinebytes,
+                                       cur.data->data());
+    }
+
+    // If the caller is walking the file sequentially (this chunk is the
+    // same as, or immediately follows, the last one served), queue a decode
+    // of the next chunk. Only one read-ahead is in flight at a time, and
+    // its slot is never reused until the task has completed, so close()
+    // has at most one future to wait out.
+    bool sequential = (subimage == m_last_chunk_subimage
+                       && (ychunkstart == m_last_chunk_y
+                           || ychunkstart == m_last_chunk_y + scansperchunk));
+    int nexty       = ychunkstart + scansperchunk;
+    bool ahead_idle = !ahead.pending.valid()
+                      || ahead.pending.wait_for(std::chrono::seconds(0))
+                             == std::future_status::ready;
+    if (sequential && nexty < endy && ahead_idle
+        && !ahead.matches(subimage, miplevel, nexty, chbegin, chend)) {
+        int nextlines       = std::min(scansperchunk, endy - nexty);
+        ahead.subimage      = subimage;
+        ahead.miplevel      = miplevel;
+        ahead.ystart        = nexty;
+        ahead.nlines        = nextlines;
+        ahead.chbegin       = chbegin;
+        ahead.chend         = chend;
+        ahead.scanlinebytes = scanlinebytes;
+        ahead.ok            = false;
+        ahead.data = std::make_shared<std::vector<uint8_t>>(scanlinebytes
+                                                            * nextlines);
+        auto buf   = ahead.data;
+        ahead.pending = default_thread_pool()->push([=](int /*threadid*/) {
+            return decode_scanline_chunk(subimage, nexty, chbegin, chend,
+                                         pixelbytes, scanlinebytes,
+                                         buf->data());
+        });
+    }
+    m_last_chunk_subimage = subimage;
+    m_last_chunk_y        = ychunkstart;
+
+    if (!cur.ok) {
+        // FIXME: Please see the long comment at the end of
+        // read_native_scanlines.
+        geterror(true);  // clear the error, issue our own
+        errorfmt("Some scanline chunks were missing or corrupted");
+        return false;
+    }
+    memcpy(data, cur.data->data() + (ybegin - ychunkstart) * scanlinebytes,
+           size_t(yend - ybegin) * scanlinebytes);
+    return true;
+}
+
+
+
 bool
 OpenEXRCoreInput::read_native_tile(int subimage, int miplevel, int x, int y,
                                    int z, void* data)
@@ -1607,13 +1851,16 @@ realloc_deepdata(exr_decode_pipeline_t* decode)
                         (y + ud->cury) * fullwidth + xoff + x,
                         decode->sample_count_table[y * w + x]);
         }
-        for (int y = 0; y < h; ++y)
-            for (int x = 0; x < w; ++x)
-                for (int c = 0; c < chans; ++c)
-                    ud->linepointers[(y * w + x) * chans + c]
-                        = ud->deepdata->data_ptr((y + ud->cury) * fullwidth
-                                                     + xoff + x,
-                                                 c, 0);
+        // Each row of the chunk is a contiguous run of pixels, so fill in
+        // the sample pointers a whole row at a time rather than doing a
+        // data_ptr lookup per pixel per channel.
+        for (int y = 0; y < h; ++y) {
+            int64_t pixbegin = (y + ud->cury) * fullwidth + xoff;
+            ud->deepdata->get_pointers(
+                pixbegin, pixbegin + w,
+                span<void*>(&ud->linepointers[size_t(y) * w * chans],
+                            size_t(w) * chans));
+        }
     }
 
     const ImageSpec& spec = *(ud->spec);
@@ -4,13 +4,16 @@
 
 #include <cerrno>
 #include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <numeric>
+#include <thread>
 
 #include <OpenImageIO/Imath.h>
 #include <OpenImageIO/platform.h>
@@ -181,6 +184,11 @@ private:
         m_headers.shrink_to_fit();
         m_io = nullptr;
         m_local_io.reset();
+        // N.B. the writer thread is joined before init() is ever called
+        m_writebehind_limit = 0;
+        m_write_queued_bytes = 0;
+        m_writer_quit        = false;
+        m_writer_busy        = false;
     }
 
     // Set up the header based on the given spec.  Also may doctor the
@@ -205,6 +213,49 @@ private:
     // app from shooting itself in the foot.
     void sanity_check_channelnames();
 
+    // Write-behind pipeline for scanline files, enabled by the
+    // "openexr:writebehind" hint (megabytes of buffering, 0 = off). The
+    // caller's pixels are converted and copied into an owned buffer, and a
+    // dedicated writer thread performs the compress+write (writePixels
+    // itself spreads compression over the Imf thread pool), so
+    // write_scanlines() returns at memcpy speed and compression overlaps
+    // the production of the next batch. A single FIFO and a single writer
+    // preserve file order.
+    struct PendingWrite {
+        int ybegin, yend, z;
+        std::vector<unsigned char> data;  ///< native, contiguous pixels
+    };
+    std::deque<PendingWrite> m_write_queue;
+    size_t m_write_queued_bytes     = 0;  ///< Bytes currently queued
+    imagesize_t m_writebehind_limit = 0;  ///< Max queued bytes, 0 = sync
+    std::mutex m_write_mutex;             ///< Guards the queue & flags
+    std::condition_variable m_write_cond;     ///< Signals work available
+    std::condition_variable m_write_drained;  ///< Signals queue shrinkage
+    std::thread m_writer;                 ///< The dedicated writer thread
+    bool m_writer_quit  = false;          ///< Ask the writer to finish up
+    bool m_writer_busy  = false;          ///< Writer is mid-writePixels
+    std::string m_writer_error;  ///< First deferred failure, "" if none
+
+    // The guts of write_scanlines, minus the pipeline dispatch. Reports
+    // failure through errmsg rather than errorfmt() so it may safely run
+    // on the writer thread (error state is per caller thread).
+    bool write_scanlines_sync(int ybegin, int yend, int z, TypeDesc format,
+                              const void* data, stride_t xstride,
+                              stride_t ystride, std::string& errmsg);
+
+    // Try to enqueue the scanlines on the write-behind pipeline. Returns
+    // false (without error) if they should be written synchronously
+    // instead (request bigger than the buffer budget).
+    bool queue_scanlines(int ybegin, int yend, int z, TypeDesc format,
+                         const void* data, stride_t xstride, stride_t ystride);
+
+    // Body of the writer thread: drain the queue in order.
+    void writer_main();
+
+    // Wait for all queued writes and stop the writer thread. Returns false
+    // if any deferred write failed (m_writer_error says why).
+    bool finish_write_behind();
+
     bool copy_and_check_spec(const ImageSpec& srcspec, ImageSpec& dstspec)
     {
         // Arbitrarily limit res to 1M x 1M and 4k channels, assuming anything
@@ -427,6 +478,14 @@ OpenEXROutput::open(const std::string& name, const ImageSpec& userspec,
             return false;
         }
 
+        // Optional write-behind pipeline (scanline, non-deep files only).
+        // The hint value is the buffering budget in megabytes.
+        if (m_output_scanline)
+            m_writebehind_limit
+                = imagesize_t(
+                      m_spec.get_int_attribute("openexr:writebehind", 0))
+                  * 1024 * 1024;
+
         return true;
     }
 
@@ -437,6 +496,13 @@ OpenEXROutput::open(const std::string& name, const ImageSpec& userspec,
             errorfmt("{} not opened properly for subimages", format_name());
             return false;
         }
+        // Flush any write-behind scanlines still queued for the part we
+        // are leaving before switching the spec and output part.
+        if (!finish_write_behind()) {
+            errorfmt("{}", m_writer_error);
+            m_writer_error.clear();
+            return false;
+        }
         // Move on to next subimage
         ++m_subimage;
         if (m_subimage >= m_nsubimages) {
@@ -482,6 +548,12 @@ OpenEXROutput::open(const std::string& name, const ImageSpec& userspec,
         m_spec = m_subimagespecs[m_subimage];
         sanity_check_channelnames();
         compute_pixeltypes(m_spec);
+        m_writebehind_limit
+            = m_scanline_output_part
+                  ? imagesize_t(
+                        m_spec.get_int_attribute("openexr:writebehind", 0))
+                        * 1024 * 1024
+                  : 0;
         return true;
     }
 
@@ -633,6 +705,11 @@ OpenEXROutput::open(const std::string& name, int subimages,
         return false;
     }
 
+    if (m_scanline_output_part)
+        m_writebehind_limit
+            = imagesize_t(m_spec.get_int_attribute("openexr:writebehind", 0))
+              * 1024 * 1024;
+
     return true;
 }
 
@@ -893,7 +970,7 @@ static ExrMeta exr_meta_translation[] = {
     // user or from a file we read.
     ExrMeta("YResolution"), ExrMeta("planarconfig"), ExrMeta("type"),
     ExrMeta("tiles"), ExrMeta("chunkCount"), ExrMeta("maxSamplesPerPixel"),
-    ExrMeta("openexr:roundingmode")
+    ExrMeta("openexr:roundingmode"), ExrMeta("openexr:writebehind")
 };
 
 
@@ -1322,10 +1399,18 @@ OpenEXROutput::close()
     // trickery.  That's only necessary if it's open(), close(),
     // open(append), close(), ...
 
+    // Flush the write-behind pipeline. A deferred write failure is
+    // reported here, on the caller's thread, at the latest.
+    bool ok = finish_write_behind();
+    if (!ok) {
+        errorfmt("{}", m_writer_error);
+        m_writer_error.clear();
+    }
+
     if (m_levelmode != Imf::ONE_LEVEL) {
         // Leave MIP-map files open, since appending cannot be done via
         // a re-open like it can with TIFF files.
-        return true;
+        return ok;
     }
 
     m_output_scanline.reset();
@@ -1335,8 +1420,8 @@ OpenEXROutput::close()
     m_output_multipart.reset();
     m_output_stream.reset();
 
-    init();       // re-initialize
-    return true;  // How can we fail?
+    init();  // re-initialize
+    return ok;
 }
 
 
@@ -1468,6 +1553,44 @@ OpenEXROutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
         return false;
     }
 
+    if (m_writebehind_limit) {
+        {
+            std::lock_guard<std::mutex> lock(m_write_mutex);
+            if (!m_writer_error.empty()) {
+                // A previously queued write failed; report it now.
+                errorfmt("{}", m_writer_error);
+                m_writer_error.clear();
+                return false;
+            }
+        }
+        if (queue_scanlines(ybegin, yend, z, format, data, xstride, ystride))
+            return true;
+        // Request too large to buffer: flush the pipeline so the writes
+        // stay in file order, then fall through to the synchronous path.
+        if (!finish_write_behind()) {
+            errorfmt("{}", m_writer_error);
+            m_writer_error.clear();
+            return false;
+        }
+    }
+
+    std::string errmsg;
+    if (!write_scanlines_sync(ybegin, yend, z, format, data, xstride, ystride,
+                              errmsg)) {
+        errorfmt("{}", errmsg);
+        return false;
+    }
+    return true;
+}
+
+
+
+bool
+OpenEXROutput::write_scanlines_sync(int ybegin, int yend, int z,
+                                    TypeDesc format, const void* data,
+                                    stride_t xstride, stride_t ystride,
+                                    std::string& errmsg)
+{
     yend                      = std::min(yend, spec().y + spec().height);
     bool native               = (format == TypeDesc::UNKNOWN);
     imagesize_t scanlinebytes = spec().scanline_bytes(true);
@@ -1526,14 +1649,14 @@ OpenEXROutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
                 m_scanline_output_part->setFrameBuffer(frameBuffer);
                 m_scanline_output_part->writePixels(nscanlines);
             } else {
-                errorfmt("Attempt to write scanlines to a non-scanline file.");
+                errmsg = "Attempt to write scanlines to a non-scanline file.";
                 return false;
             }
         } catch (const std::exception& e) {
-            errorfmt("Failed OpenEXR write: {}", e.what());
+            errmsg = Strutil::fmt::format("Failed OpenEXR write: {}", e.what());
             return false;
         } catch (...) {  // catch-all for edge cases or compiler bugs
-            errorfmt("Failed OpenEXR write: unknown exception");
+            errmsg = "Failed OpenEXR write: unknown exception";
             return false;
         }
     }
@@ -1550,6 +1673,107 @@ OpenEXROutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
 
 
 
+bool
+OpenEXROutput::queue_scanlines(int ybegin, int yend, int z, TypeDesc format,
+                               const void* data, stride_t xstride,
+                               stride_t ystride)
+{
+    yend                    = std::min(yend, m_spec.y + m_spec.height);
+    imagesize_t nativebytes = m_spec.scanline_bytes(true)
+                              * imagesize_t(yend - ybegin);
+    if (nativebytes == 0 || nativebytes > m_writebehind_limit)
+        return false;  // too big to buffer; caller writes synchronously
+
+    bool native        = (format == TypeDesc::UNKNOWN);
+    size_t pixel_bytes = m_spec.pixel_bytes(true);
+    if (native && xstride == AutoStride)
+        xstride = (stride_t)pixel_bytes;
+    stride_t zstride = AutoStride;
+    m_spec.auto_stride(xstride, ystride, zstride, format, m_spec.nchannels,
+                       m_spec.width, m_spec.height);
+
+    // Convert and copy on the calling thread (the caller is free to reuse
+    // its buffer as soon as we return), using a local scratch buffer so we
+    // never share m_scratch with the writer thread.
+    PendingWrite pw;
+    pw.ybegin = ybegin;
+    pw.yend   = yend;
+    pw.z      = z;
+    pw.data.resize(nativebytes);
+    std::vector<unsigned char> scratch;
+    const void* d = to_native_rectangle(m_spec.x, m_spec.x + m_spec.width,
+                                        ybegin, yend, z, z + 1, format, data,
+                                        xstride, ystride, zstride, scratch);
+    memcpy(pw.data.data(), d, nativebytes);
+
+    std::unique_lock<std::mutex> lock(m_write_mutex);
+    if (!m_writer.joinable()) {
+        m_writer_quit = false;
+        m_writer      = std::thread(&OpenEXROutput::writer_main, this);
+    }
+    // Backpressure: don't let more than the budget accumulate in flight.
+    m_write_drained.wait(lock, [&] {
+        return m_write_queued_bytes + nativebytes <= m_writebehind_limit
+               || m_write_queue.empty();
+    });
+    m_write_queued_bytes += nativebytes;
+    m_write_queue.push_back(std::move(pw));
+    m_write_cond.notify_one();
+    return true;
+}
+
+
+
+void
+OpenEXROutput::writer_main()
+{
+    std::unique_lock<std::mutex> lock(m_write_mutex);
+    while (true) {
+        m_write_cond.wait(lock, [&] {
+            return m_writer_quit || !m_write_queue.empty();
+        });
+        if (m_write_queue.empty()) {
+            if (m_writer_quit)
+                break;
+            continue;
+        }
+        PendingWrite pw = std::move(m_write_queue.front());
+        m_write_queue.pop_front();
+        m_writer_busy = true;
+        bool skip     = !m_writer_error.empty();  // after a failure, drain
+        lock.unlock();
+        std::string errmsg;
+        bool ok = skip
+                  || write_scanlines_sync(pw.ybegin, pw.yend, pw.z,
+                                          TypeDesc::UNKNOWN, pw.data.data(),
+                                          AutoStride, AutoStride, errmsg);
+        lock.lock();
+        if (!ok && m_writer_error.empty())
+            m_writer_error = errmsg;
+        m_writer_busy = false;
+        m_write_queued_bytes -= pw.data.size();
+        m_write_drained.notify_all();
+    }
+}
+
+
+
+bool
+OpenEXROutput::finish_write_behind()
+{
+    if (m_writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_write_mutex);
+            m_writer_quit = true;
+        }
+        m_write_cond.notify_all();
+        m_writer.join();
+    }
+    return m_writer_error.empty();
+}
+
+
+
 bool
 OpenEXROutput::write_tile(int x, int y, int z, TypeDesc format,
                           const void* data, stride_t xstride, stride_t ystride,
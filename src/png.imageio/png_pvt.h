@@ -391,6 +391,31 @@ read_into_buffer(png_structp& sp, png_infop& ip, ImageSpec& spec,
 
 
 
+/// Reads the next `nrows` scanlines from an open PNG file into the
+/// indicated buffer (rows separated by `ystride` bytes).
+/// \return empty string on success, error message on failure.
+///
+inline const std::string
+read_next_scanlines(png_structp& sp, void* buffer, int nrows, stride_t ystride)
+{
+    // Temp space for the row pointers. Must be declared before the setjmp
+    // to ensure it's destroyed if the jump is taken.
+    std::vector<unsigned char*> row_pointers(nrows);
+    for (int i = 0; i < nrows; ++i)
+        row_pointers[i] = (unsigned char*)buffer + i * ystride;
+
+    // Must call this setjmp in every function that does PNG reads
+    if (setjmp(png_jmpbuf(sp)))  // NOLINT(cert-err52-cpp)
+        return "PNG library error";
+
+    png_read_rows(sp, row_pointers.data(), NULL, png_uint_32(nrows));
+
+    // success
+    return "";
+}
+
+
+
 /// Reads the next scanline from an open PNG file into the indicated buffer.
 /// \return empty string on success, error message on failure.
 ///
@@ -6,6 +6,8 @@
 #include <cstdio>
 #include <cstdlib>
 
+#include <OpenImageIO/parallel.h>
+
 #include "png_pvt.h"
 
 OIIO_PLUGIN_NAMESPACE_BEGIN
@@ -32,6 +34,8 @@ public:
     }
     bool read_native_scanline(int subimage, int miplevel, int y, int z,
                               void* data) override;
+    bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
+                               int z, void* data) override;
 
 private:
     std::string m_filename;            ///< Stash the filename
@@ -332,4 +336,63 @@ PNGInput::read_native_scanline(int subimage, int miplevel, int y, int /*z*/,
     return true;
 }
 
+
+
+bool
+PNGInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
+                                int yend, int z, void* data)
+{
+    {
+        lock_guard lock(*this);
+        if (!seek_subimage(subimage, miplevel))
+            return false;
+        int nrows = yend - ybegin;
+        // Favorable case for a batched read: not interlaced, more than one
+        // row requested, and the request picks up exactly where the decoder
+        // left off. Decode the whole batch with a single libpng call,
+        // straight into the caller's buffer, then do the alpha association
+        // (the expensive per-pixel part) with row parallelism.
+        if (m_interlace_type == 0 && nrows > 1
+            && ybegin - m_spec.y == m_next_scanline
+            && yend <= m_spec.y + m_spec.height) {
+            size_t ystride = m_spec.scanline_bytes();
+            std::string s  = PNG_pvt::read_next_scanlines(m_png, data, nrows,
+                                                          stride_t(ystride));
+            if (s.length()) {
+                errorfmt("{}", s);
+                return false;
+            }
+            if (m_err)
+                return false;  // error is already registered
+            m_next_scanline += nrows;
+
+            if (m_spec.alpha_channel != -1 && !m_keep_unassociated_alpha) {
+                paropt opt(threads(), paropt::SplitDir::Y, 16);
+                parallel_for_chunked(
+                    0, nrows, 0,
+                    [&](int64_t rbegin, int64_t rend) {
+                        char* rowdata = (char*)data + rbegin * ystride;
+                        int npixels   = int(rend - rbegin) * m_spec.width;
+                        if (m_spec.format == TypeDesc::UINT16)
+                            associateAlpha((unsigned short*)rowdata, npixels,
+                                           m_spec.nchannels,
+                                           m_spec.alpha_channel, m_srgb,
+                                           m_gamma);
+                        else
+                            associateAlpha((unsigned char*)rowdata, npixels,
+                                           m_spec.nchannels,
+                                           m_spec.alpha_channel, m_srgb,
+                                           m_gamma);
+                    },
+                    opt);
+            }
+            return true;
+        }
+    }
+    // Anything else (interlaced, out of order, single row): fall back on
+    // the default implementation, which loops over read_native_scanline.
+    return ImageInput::read_native_scanlines(subimage, miplevel, ybegin, yend,
+                                             z, data);
+}
+
 OIIO_PLUGIN_NAMESPACE_END
@@ -8,6 +8,8 @@
 #include <ctime>
 #include <iostream>
 
+#include <OpenImageIO/parallel.h>
+
 #include "png_pvt.h"
 
 
@@ -402,14 +404,26 @@ PNGOutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
     if (m_convert_alpha) {
         unassoc_scratch.reset(new float[nvals]);
         float* floatvals = unassoc_scratch.get();
-        // Contiguize and convert to float
-        OIIO::convert_image(m_spec.nchannels, m_spec.width, yend - ybegin, 1,
-                            data, format, xstride, ystride, AutoStride,
-                            floatvals, TypeFloat, AutoStride, AutoStride,
-                            AutoStride);
-        // Deassociate alpha
-        deassociateAlpha(floatvals, npixels, m_spec.nchannels,
-                         m_spec.alpha_channel, m_srgb, m_gamma);
+        // Contiguize and convert to float (threaded for big requests)
+        OIIO::parallel_convert_image(m_spec.nchannels, m_spec.width,
+                                     yend - ybegin, 1, data, format, xstride,
+                                     ystride, AutoStride, floatvals, TypeFloat,
+                                     AutoStride, AutoStride, AutoStride,
+                                     threads());
+        // Deassociate alpha, parallelizing over row chunks -- with the
+        // sRGB or gamma conversion in the mix, this is the most expensive
+        // per-pixel work of PNG output.
+        paropt opt(threads(), paropt::SplitDir::Y, 16);
+        parallel_for_chunked(
+            0, yend - ybegin, 0,
+            [&](int64_t rbegin, int64_t rend) {
+                deassociateAlpha(floatvals
+                                     + rbegin * m_spec.width * m_spec.nchannels,
+                                 size_t(rend - rbegin) * m_spec.width,
+                                 m_spec.nchannels, m_spec.alpha_channel, m_srgb,
+                                 m_gamma);
+            },
+            opt);
         data    = floatvals;
         format  = TypeFloat;
         xstride = size_t(m_spec.nchannels) * sizeof(float);
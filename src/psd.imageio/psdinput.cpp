@@ -19,6 +19,7 @@
 #include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/span_util.h>
 #include <OpenImageIO/tiffutils.h>
 
@@ -281,6 +282,12 @@ private:
     bool load_layer_channel(Layer& layer, ChannelInfo& channel_info);
     bool read_rle_lengths(uint32_t height, std::vector<uint32_t>& rle_lengths);
 
+    //Read and decompress an entire channel into decompressed_data, if that
+    //hasn't happened yet. This is deferred until the channel is actually
+    //read so that opening a file with many layers doesn't pay to decode
+    //them all. RLE rows are unpacked in parallel over the thread pool.
+    bool ensure_channel_decompressed(ChannelInfo& channel_info);
+
     //Global Mask Info
     bool load_global_mask_info();
 
@@ -1664,42 +1671,18 @@ PSDInput::load_layer_channel(Layer& layer, ChannelInfo& channel_info)
         if (!ioseek(channel_info.data_length, SEEK_CUR))
             return false;
         break;
-    case Compression_ZIP: {
-        // We subtract the compression marker from the data length
-        channel_info.data_length -= 2;
-
-        // Unlike with raw and rle compression we cannot access each scanline
-        // randomly so we parse the data up-front and store it
-        std::vector<char> compressed_data(channel_info.data_length);
-        channel_info.decompressed_data = std::vector<char>(
-            width * height * (m_header.depth / 8));
-
-        if (!ioseek(channel_info.data_pos))
-            return false;
-        if (!ioread(compressed_data.data(), channel_info.data_length))
-            return false;
-
-        decompress_zip(compressed_data, channel_info.decompressed_data);
-    } break;
-    case Compression_ZIP_Predict: {
+    case Compression_ZIP:
+    case Compression_ZIP_Predict:
         // We subtract the compression marker from the data length
         channel_info.data_length -= 2;
 
         // Unlike with raw and rle compression we cannot access each scanline
-        // randomly so we parse the data up-front and store it
-        std::vector<char> compressed_data(channel_info.data_length);
-        channel_info.decompressed_data = std::vector<char>(
-            width * height * (m_header.depth / 8));
-
-        if (!ioseek(channel_info.data_pos))
+        // randomly, so the whole channel has to be inflated at once. Defer
+        // that until the channel is actually read (see
+        // ensure_channel_decompressed) and just skip past the data here.
+        if (!ioseek(channel_info.data_pos + channel_info.data_length))
             return false;
-        if (!ioread(compressed_data.data(), channel_info.data_length))
-            return false;
-
-        decompress_zip_prediction(compressed_data,
-                                  channel_info.decompressed_data, width,
-                                  height);
-    } break;
+        break;
     default:
         errorfmt("[Layer Channel] unsupported compression {}",
                  channel_info.compression);
@@ -1726,6 +1709,77 @@ PSDInput::read_rle_lengths(uint32_t height, std::vector<uint32_t>& rle_lengths)
 
 
 
+bool
+PSDInput::ensure_channel_decompressed(ChannelInfo& channel_info)
+{
+    if (channel_info.decompressed_data.size() || !channel_info.height)
+        return true;
+
+    uint64_t uncompressed_size = static_cast<uint64_t>(channel_info.width)
+                                 * channel_info.height * (m_header.depth / 8);
+    switch (channel_info.compression) {
+    case Compression_RLE: {
+        // Slurp the channel's whole compressed stream with one read, then
+        // unpack the rows in parallel across the thread pool -- each RLE
+        // row is independent and its offset is known from the lengths
+        // table read when the file was opened.
+        uint64_t compressed_size = channel_info.row_pos.back()
+                                   + channel_info.rle_lengths.back()
+                                   - channel_info.data_pos;
+        std::vector<char> compressed_data(compressed_size);
+        if (!ioseek(channel_info.data_pos)
+            || !ioread(compressed_data.data(), compressed_size))
+            return false;
+        channel_info.decompressed_data.resize(uncompressed_size);
+        // N.B. errors raised on pool threads land in their thread-local
+        // error storage, so just note the failure and report it below.
+        bool ok = true;
+        parallel_for_chunked(
+            0, channel_info.height, 0,
+            [&](int64_t ybegin, int64_t yend) {
+                for (int64_t y = ybegin; y < yend; ++y) {
+                    const char* src = compressed_data.data()
+                                      + (channel_info.row_pos[y]
+                                         - channel_info.data_pos);
+                    char* dst = channel_info.decompressed_data.data()
+                                + uint64_t(y) * channel_info.row_length;
+                    if (!decompress_packbits(src, dst,
+                                             channel_info.rle_lengths[y],
+                                             channel_info.row_length))
+                        ok = false;
+                }
+            },
+            paropt(threads(), paropt::SplitDir::Y, 16));
+        if (!ok) {
+            errorfmt("unable to decode RLE compressed channel data");
+            std::vector<char>().swap(channel_info.decompressed_data);
+            return false;
+        }
+    } break;
+    case Compression_ZIP: {
+        std::vector<char> compressed_data(channel_info.data_length);
+        channel_info.decompressed_data = std::vector<char>(uncompressed_size);
+        if (!ioseek(channel_info.data_pos)
+            || !ioread(compressed_data.data(), channel_info.data_length))
+            return false;
+        decompress_zip(compressed_data, channel_info.decompressed_data);
+    } break;
+    case Compression_ZIP_Predict: {
+        std::vector<char> compressed_data(channel_info.data_length);
+        channel_info.decompressed_data = std::vector<char>(uncompressed_size);
+        if (!ioseek(channel_info.data_pos)
+            || !ioread(compressed_data.data(), channel_info.data_length))
+            return false;
+        decompress_zip_prediction(compressed_data,
+                                  channel_info.decompressed_data,
+                                  channel_info.width, channel_info.height);
+    } break;
+    }
+    return true;
+}
+
+
+
 bool
 PSDInput::load_global_mask_info()
 {
@@ -2050,17 +2104,18 @@ PSDInput::read_channel_row(ChannelInfo& channel_info, uint32_t row, char* data)
         }
         break;
     case Compression_RLE: {
-        if (!ioseek(channel_info.row_pos[row]))
-            return false;
-        uint32_t rle_length = channel_info.rle_lengths[row];
-        char* rle_buffer;
-        OIIO_ALLOCATE_STACK_OR_HEAP(rle_buffer, char, rle_length);
-        if (!ioread(rle_buffer, rle_length)
-            || !decompress_packbits(rle_buffer, data, rle_length,
-                                    channel_info.row_length))
+        // The first read of an RLE channel unpacks the whole channel (in
+        // parallel), after which rows are served from memory.
+        if (!ensure_channel_decompressed(channel_info))
             return false;
+        uint64_t row_index = static_cast<uint64_t>(row)
+                             * channel_info.row_length;
+        std::memcpy(data, channel_info.decompressed_data.data() + row_index,
+                    channel_info.row_length);
     } break;
     case Compression_ZIP: {
+        if (!ensure_channel_decompressed(channel_info))
+            return false;
         OIIO_ASSERT(channel_info.decompressed_data.size()
                     == static_cast<uint64_t>(channel_info.width)
                            * channel_info.height * (m_header.depth / 8));
@@ -2071,6 +2126,8 @@ PSDInput::read_channel_row(ChannelInfo& channel_info, uint32_t row, char* data)
                     channel_info.row_length);
     } break;
     case Compression_ZIP_Predict: {
+        if (!ensure_channel_decompressed(channel_info))
+            return false;
         OIIO_ASSERT(channel_info.decompressed_data.size()
                     == static_cast<uint64_t>(channel_info.width)
                            * channel_info.height * (m_header.depth / 8));
@@ -2229,6 +2286,7 @@ PSDInput::decompress_packbits(const char* src, char* dst,
 {
     int32_t src_remaining = packed_length;
     int32_t dst_remaining = unpacked_length;
+    char* dst_start       = dst;
     int16_t header;
     int length;
 
@@ -2272,10 +2330,17 @@ PSDInput::decompress_packbits(const char* src, char* dst,
         }
     }
 
+    // N.B. swap the row we just unpacked (not m_spec.width, which may not
+    // match this channel for a layer subimage, and would also race when
+    // rows are unpacked concurrently).
     if (!bigendian()) {
         switch (m_header.depth) {
-        case 16: swap_endian((uint16_t*)dst, m_spec.width); break;
-        case 32: swap_endian((uint32_t*)dst, m_spec.width); break;
+        case 16:
+            swap_endian((uint16_t*)dst_start, unpacked_length / 2);
+            break;
+        case 32:
+            swap_endian((uint32_t*)dst_start, unpacked_length / 4);
+            break;
         }
     }
 
@@ -11,6 +11,30 @@
 OIIO_PLUGIN_NAMESPACE_BEGIN
 
 
+namespace {
+
+// One shared, budgeted PtexCache for all PtexInputs in the process,
+// rather than a standalone PtexTexture per open. Reopening the same
+// file (as an ImageCache will do constantly) then shares the reader and
+// its resident data, and total Ptex memory is bounded by the global
+// "ptex:max_memory_MB" attribute instead of growing per instance. The
+// budget is read when the cache is first needed.
+PtexCache*
+ptex_cache()
+{
+    static PtexCache* cache = []() {
+        size_t maxmem = size_t(
+                            OIIO::get_int_attribute("ptex:max_memory_MB", 1024))
+                        << 20;
+        return PtexCache::create(0 /*default maxFiles*/, maxmem,
+                                 true /*premultiply*/);
+    }();
+    return cache;
+}
+
+}  // namespace
+
+
 class PtexInput final : public ImageInput {
 public:
     PtexInput()
@@ -99,13 +123,16 @@ bool
 PtexInput::open(const std::string& name, ImageSpec& newspec)
 {
     Ptex::String perr;
-    m_ptex = PtexTexture::open(name.c_str(), perr, true /*premultiply*/);
-    if (!perr.empty()) {
+    m_ptex = ptex_cache()->get(name.c_str(), perr);
+    if (!perr.empty() || !m_ptex) {
         if (m_ptex) {
             m_ptex->release();
             m_ptex = NULL;
         }
-        errorfmt("{}", perr.c_str());
+        if (perr.empty())
+            errorfmt("Could not open \"{}\"", name);
+        else
+            errorfmt("{}", perr.c_str());
         return false;
     }
 
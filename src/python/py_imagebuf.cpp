@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/platform.h>
 
 
@@ -33,6 +34,9 @@ ImageBuf_from_buffer(const py::buffer& buffer)
         return ib;
     }
 
+    // The buffer_info keeps the source memory alive, so the bulk pixel
+    // copy below can run without the GIL.
+    py::gil_scoped_release gil;
     if (info.ndim == 3) {
         // Assume [y][x][c]
         ImageSpec spec(info.shape[1], info.shape[0], info.shape[2], format);
@@ -62,6 +66,54 @@ ImageBuf_from_buffer(const py::buffer& buffer)
 
 
 
+// Like ImageBuf_from_buffer, but "wrap" the python buffer memory as
+// app-owned ImageBuf storage rather than copying it, using the C++
+// pointer-wrapping ImageBuf constructor. The caller must keep the source
+// buffer alive as long as the ImageBuf (the binding below ties the two
+// lifetimes together with py::keep_alive).
+static ImageBuf
+ImageBuf_wrap_buffer(const py::buffer& buffer)
+{
+    ImageBuf ib;
+    const py::buffer_info info = buffer.request();
+    if (info.readonly) {
+        ib.errorfmt("ImageBuf.wrap cannot wrap a read-only buffer");
+        return ib;
+    }
+    TypeDesc format;
+    if (info.format.size())
+        format = typedesc_from_python_array_code(info.format);
+    if (format == TypeUnknown)
+        return ib;
+    if (size_t(info.strides[info.ndim - 1]) != format.size()) {
+        ib.errorfmt(
+            "ImageBuf.wrap requires contiguous stride within pixels");
+        return ib;
+    }
+
+    if (info.ndim == 3) {
+        // Assume [y][x][c]
+        ImageSpec spec(info.shape[1], info.shape[0], info.shape[2], format);
+        ib = ImageBuf(spec, info.ptr, info.strides[1], info.strides[0]);
+    } else if (info.ndim == 2) {
+        // Assume [y][x], single channel
+        ImageSpec spec(info.shape[1], info.shape[0], 1, format);
+        ib = ImageBuf(spec, info.ptr, info.strides[1], info.strides[0]);
+    } else if (info.ndim == 4) {
+        // Assume volume [z][y][x][c]
+        ImageSpec spec(info.shape[2], info.shape[1], info.shape[3], format);
+        spec.depth      = info.shape[0];
+        spec.full_depth = spec.depth;
+        ib = ImageBuf(spec, info.ptr, info.strides[2], info.strides[1],
+                      info.strides[0]);
+    } else {
+        ib.errorfmt("ImageBuf.wrap must have 2, 3, or 4 dimensions");
+    }
+    return ib;
+}
+
+
+
 py::tuple
 ImageBuf_getpixel(const ImageBuf& buf, int x, int y, int z = 0,
                   const std::string& wrapname = "black")
@@ -165,7 +217,12 @@ ImageBuf_get_pixels(const ImageBuf& buf, TypeDesc format, ROI roi = ROI::All())
 
     size_t size = (size_t)roi.npixels() * roi.nchannels() * format.size();
     std::unique_ptr<char[]> data(new char[size]);
-    if (buf.get_pixels(roi, format, &data[0]))
+    bool ok;
+    {
+        py::gil_scoped_release gil;
+        ok = buf.get_pixels(roi, format, &data[0]);
+    }
+    if (ok)
         return make_numpy_array(format, data.release(),
                                 buf.spec().depth > 1 ? 4 : 3, roi.nchannels(),
                                 roi.width(), roi.height(), roi.depth());
@@ -175,6 +232,69 @@ ImageBuf_get_pixels(const ImageBuf& buf, TypeDesc format, ROI roi = ROI::All())
 
 
 
+// Return a writable NumPy array that aliases the ImageBuf's own local
+// pixel memory, with no copy. The array holds a reference to the ImageBuf
+// python object, so the underlying memory cannot be freed while any view
+// (or a tensor wrapping it) is still alive. Cache-backed or unread buffers
+// are first brought into writable local memory (that one-time read is the
+// only copy). Deep images have no contiguous pixel memory to alias, so
+// they return None with an error set on the buffer.
+py::object
+ImageBuf_pixels_view(const py::object& self_object)
+{
+    ImageBuf& self = self_object.cast<ImageBuf&>();
+    if (self.deep()) {
+        self.errorfmt("pixels_view() cannot view a deep ImageBuf");
+        return py::none();
+    }
+    {
+        // Force the pixels into writable local memory. This is a no-op if
+        // they are already there.
+        py::gil_scoped_release gil;
+        if (!self.initialized() || !self.make_writable())
+            return py::none();
+    }
+    void* data = self.localpixels();
+    if (!data)
+        return py::none();
+    const ImageSpec& spec(self.spec());
+    std::string dtype_code;
+    switch (spec.format.basetype) {
+    case TypeDesc::UINT8: dtype_code = "uint8"; break;
+    case TypeDesc::INT8: dtype_code = "int8"; break;
+    case TypeDesc::UINT16: dtype_code = "uint16"; break;
+    case TypeDesc::INT16: dtype_code = "int16"; break;
+    case TypeDesc::UINT32: dtype_code = "uint32"; break;
+    case TypeDesc::INT32: dtype_code = "int32"; break;
+    case TypeDesc::HALF: dtype_code = "float16"; break;
+    case TypeDesc::FLOAT: dtype_code = "float32"; break;
+    case TypeDesc::DOUBLE: dtype_code = "float64"; break;
+    default:
+        self.errorfmt("pixels_view() does not support pixel format {}",
+                      spec.format);
+        return py::none();
+    }
+    std::vector<py::ssize_t> shape, strides;
+    if (spec.depth > 1) {
+        shape.assign({ spec.depth, spec.height, spec.width, spec.nchannels });
+        strides.assign({ py::ssize_t(self.z_stride()),
+                         py::ssize_t(self.scanline_stride()),
+                         py::ssize_t(self.pixel_stride()),
+                         py::ssize_t(spec.channel_bytes()) });
+    } else {
+        shape.assign({ spec.height, spec.width, spec.nchannels });
+        strides.assign({ py::ssize_t(self.scanline_stride()),
+                         py::ssize_t(self.pixel_stride()),
+                         py::ssize_t(spec.channel_bytes()) });
+    }
+    // Passing self_object as the "base" makes the array a non-owning view
+    // whose lifetime keeps the ImageBuf alive; the non-const data pointer
+    // makes it writable.
+    return py::array(py::dtype(dtype_code), shape, strides, data, self_object);
+}
+
+
+
 void
 ImageBuf_set_deep_value(ImageBuf& buf, int x, int y, int z, int c, int s,
                         float value)
@@ -223,6 +343,30 @@ ImageBuf_set_pixels_buffer(ImageBuf& self, ROI roi, py::buffer& buffer)
 
 
 
+// Batch read: decode many files concurrently across the native thread
+// pool, with the GIL released for the duration, and return a list of
+// ImageBufs in the same order as the filenames. Per-file failures are
+// reported on the individual ImageBuf (has_error / geterror), so one bad
+// file doesn't invalidate the rest of the batch.
+std::vector<ImageBuf>
+ImageBuf_read_images(const std::vector<std::string>& filenames,
+                     TypeDesc convert, int nthreads)
+{
+    std::vector<ImageBuf> bufs(filenames.size());
+    py::gil_scoped_release gil;
+    parallel_for(
+        int64_t(0), int64_t(filenames.size()),
+        [&](int64_t i) {
+            bufs[i].reset(filenames[i]);
+            bufs[i].read(0, 0, true, convert);
+        },
+        // minitems=1: each file is its own task, however small the batch.
+        paropt(nthreads, paropt::SplitDir::Y, 1));
+    return bufs;
+}
+
+
+
 void
 ImageBuf_set_write_format(ImageBuf& self, const py::object& py_channelformats)
 {
@@ -240,8 +384,14 @@ declare_imagebuf(py::module& m)
 
     py::class_<ImageBuf>(m, "ImageBuf")
         .def(py::init<>())
-        .def(py::init<const std::string&>())
-        .def(py::init<const std::string&, int, int>())
+        .def(py::init([](const std::string& name) {
+            py::gil_scoped_release gil;
+            return ImageBuf(name);
+        }))
+        .def(py::init([](const std::string& name, int subimage, int miplevel) {
+            py::gil_scoped_release gil;
+            return ImageBuf(name, subimage, miplevel);
+        }))
         .def(py::init<const ImageSpec&>())
         .def(py::init([](const ImageSpec& spec, bool zero) {
             auto z = zero ? InitializePixels::Yes : InitializePixels::No;
@@ -249,6 +399,7 @@ declare_imagebuf(py::module& m)
         }))
         .def(py::init([](const std::string& name, int subimage, int miplevel,
                          const ImageSpec& config) {
+                 py::gil_scoped_release gil;
                  return ImageBuf(name, subimage, miplevel, nullptr, &config);
              }),
              "name"_a, "subimage"_a, "miplevel"_a, "config"_a)
@@ -256,16 +407,29 @@ declare_imagebuf(py::module& m)
                  return ImageBuf_from_buffer(buffer);
              }),
              "buffer"_a)
+        // The keep_alive ties the lifetime of the wrapped python buffer
+        // (patient, arg 1) to the returned ImageBuf (nurse, 0), so the
+        // memory we alias can't be freed out from under us.
+        .def_static(
+            "wrap",
+            [](const py::buffer& buffer) {
+                return ImageBuf_wrap_buffer(buffer);
+            },
+            "buffer"_a, py::keep_alive<0, 1>())
         .def("clear", &ImageBuf::clear)
         .def(
             "reset",
             [](ImageBuf& self, const std::string& name, int subimage,
-               int miplevel) { self.reset(name, subimage, miplevel); },
+               int miplevel) {
+                py::gil_scoped_release gil;
+                self.reset(name, subimage, miplevel);
+            },
             "name"_a, "subimage"_a = 0, "miplevel"_a = 0)
         .def(
             "reset",
             [](ImageBuf& self, const std::string& name, int subimage,
                int miplevel, const ImageSpec& config) {
+                py::gil_scoped_release gil;
                 self.reset(name, subimage, miplevel, nullptr, &config);
             },
             "name"_a, "subimage"_a = 0, "miplevel"_a = 0,
@@ -418,7 +582,11 @@ declare_imagebuf(py::module& m)
         .def("pixelindex", &ImageBuf::pixelindex, "x"_a, "y"_a, "z"_a,
              "check_range"_a = false)
         .def("copy_metadata", &ImageBuf::copy_metadata)
-        .def("copy_pixels", &ImageBuf::copy_pixels)
+        .def("copy_pixels",
+             [](ImageBuf& self, const ImageBuf& src) {
+                 py::gil_scoped_release gil;
+                 return self.copy_pixels(src);
+             })
         .def(
             "copy",
             [](ImageBuf& self, const ImageBuf& src, TypeDesc format) {
@@ -455,6 +623,9 @@ declare_imagebuf(py::module& m)
         .def("get_pixels", &ImageBuf_get_pixels, "format"_a = TypeFloat,
              "roi"_a = ROI::All())
         .def("set_pixels", &ImageBuf_set_pixels_buffer, "roi"_a, "pixels"_a)
+        .def("pixels_view", [](const py::object& self) {
+            return ImageBuf_pixels_view(self);
+        })
 
         .def_property_readonly("deep", &ImageBuf::deep)
         .def("deep_samples", &ImageBuf::deep_samples, "x"_a, "y"_a, "z"_a = 0)
@@ -478,6 +649,9 @@ declare_imagebuf(py::module& m)
 
         // FIXME -- do we want to provide pixel iterators?
         ;
+
+    m.def("read_images", &ImageBuf_read_images, "filenames"_a,
+          "convert"_a = TypeUnknown, "nthreads"_a = 0);
 }
 
 }  // namespace PyOpenImageIO
@@ -1319,6 +1319,18 @@ IBA_computePixelHashSHA1(const ImageBuf& src, const std::string& extrainfo,
 
 
 
+std::string
+IBA_computePixelHash(const ImageBuf& src, const std::string& extrainfo,
+                     const std::string& algorithm = "sha1",
+                     ROI roi = ROI::All(), int blocksize = 0, int nthreads = 0)
+{
+    py::gil_scoped_release gil;
+    return ImageBufAlgo::computePixelHash(src, extrainfo, algorithm, roi,
+                                          blocksize, nthreads);
+}
+
+
+
 bool
 IBA_warp(ImageBuf& dst, const ImageBuf& src, py::object values_M,
          const std::string& filtername = "", float filterwidth = 0.0f,
@@ -2847,6 +2859,9 @@ declare_imagebufalgo(py::module& m)
         .def_static("computePixelHashSHA1", &IBA_computePixelHashSHA1, "src"_a,
                     "extrainfo"_a = "", "roi"_a = ROI::All(), "blocksize"_a = 0,
                     "nthreads"_a = 0)
+        .def_static("computePixelHash", &IBA_computePixelHash, "src"_a,
+                    "extrainfo"_a = "", "algorithm"_a = "sha1",
+                    "roi"_a = ROI::All(), "blocksize"_a = 0, "nthreads"_a = 0)
 
         .def_static("warp", &IBA_warp, "dst"_a, "src"_a, "M"_a,
                     "filtername"_a = "", "filterwidth"_a = 0.0f,
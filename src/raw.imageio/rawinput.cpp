@@ -11,6 +11,7 @@
 
 #include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/platform.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
@@ -70,6 +71,8 @@ public:
     bool close() override;
     bool read_native_scanline(int subimage, int miplevel, int y, int z,
                               void* data) override;
+    bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
+                               int z, void* data) override;
 
 private:
     bool process();
@@ -438,9 +441,14 @@ RawInput::open_raw(bool unpack, const std::string& name,
     }
     m_processor->adjust_sizes_info_only();
 
+    // "raw:fast" requests a quick decode suitable for browsing or proxy
+    // generation: decode at half size with the cheap bilinear demosaic.
+    // Either choice may still be overridden by its own specific hint.
+    bool fast = config.get_int_attribute("raw:fast", 0) != 0;
+
     // Process image at half size if "raw:half_size" is not 0
     m_processor->imgdata.params.half_size
-        = config.get_int_attribute("raw:half_size", 0);
+        = config.get_int_attribute("raw:half_size", fast ? 1 : 0);
     int div = m_processor->imgdata.params.half_size == 0 ? 1 : 2;
 
     // Set file information
@@ -667,6 +675,10 @@ RawInput::open_raw(bool unpack, const std::string& name,
         }
         // Set the attribute in the output spec
         m_spec.attribute("raw:Demosaic", demosaic);
+    } else if (fast) {
+        // Fast browsing mode: cheapest (bilinear) interpolation.
+        m_processor->imgdata.params.user_qual = 0;
+        m_spec.attribute("raw:Demosaic", "linear");
     } else {
         m_processor->imgdata.params.user_qual = 3;
         m_spec.attribute("raw:Demosaic", "AHD");
@@ -1492,4 +1504,72 @@ RawInput::read_native_scanline(int subimage, int miplevel, int y, int /*z*/,
     return true;
 }
 
+
+
+bool
+RawInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
+                                int yend, int z, void* data)
+{
+    {
+        lock_guard lock(*this);
+        if (!seek_subimage(subimage, miplevel))
+            return false;
+        // For an ordinary multi-row request of the debayered image, the
+        // whole result is already sitting in m_image -- convert the batch
+        // in one (threaded) shot rather than a locked per-row copy.
+        if (m_process && ybegin >= 0 && yend <= m_spec.height
+            && yend - ybegin > 1) {
+            if (!m_unpacked)
+                do_unpack();
+            if (!m_image && !process())
+                return false;
+            int nrows           = yend - ybegin;
+            int length          = m_spec.width * m_image->colors;
+            unsigned short* src = &(
+                ((unsigned short*)m_image->data)[size_t(length) * ybegin]);
+            parallel_convert_image(m_image->colors, m_spec.width, nrows, 1, src,
+                                   TypeDesc::UINT16, AutoStride, AutoStride,
+                                   AutoStride, data, m_spec.format, AutoStride,
+                                   AutoStride, AutoStride, threads());
+            size_t nvals = size_t(length) * nrows;
+            paropt opt(threads(), paropt::SplitDir::Y, 1 << 16);
+
+            // Check if we need to balance any clamped values (implies HALF)
+            if (m_do_balance_clamped) {
+                half* dst = static_cast<half*>(data);
+                parallel_for_chunked(
+                    0, int64_t(nvals), 0,
+                    [&](int64_t vbegin, int64_t vend) {
+                        for (int64_t i = vbegin; i < vend; ++i)
+                            dst[i] = std::min((float)dst[i], m_balanced_max);
+                    },
+                    opt);
+            }
+
+            // Perform any scene linear scaling (implies HALF output)
+            if (m_do_scene_linear_scale) {
+                float scale_value = m_camera_to_scene_linear_scale;
+                // See read_native_scanline for an explanation of this
+                // adjustment for non-Clip highlight modes.
+                if (m_processor->imgdata.params.highlight != 0 /*Clip*/)
+                    scale_value *= 2.5f;
+                half* dst = static_cast<half*>(data);
+                parallel_for_chunked(
+                    0, int64_t(nvals), 0,
+                    [&](int64_t vbegin, int64_t vend) {
+                        for (int64_t i = vbegin; i < vend; ++i)
+                            dst[i] = (float)dst[i] * scale_value;
+                    },
+                    opt);
+            }
+            return true;
+        }
+    }
+    // Anything else (single row, or the un-debayered single channel):
+    // fall back on the default implementation, which loops over
+    // read_native_scanline.
+    return ImageInput::read_native_scanlines(subimage, miplevel, ybegin, yend,
+                                             z, data);
+}
+
 OIIO_PLUGIN_NAMESPACE_END
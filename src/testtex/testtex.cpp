@@ -3,6 +3,7 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -10,6 +11,9 @@
 #include <ctime>
 #include <iostream>
 #include <iterator>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <OpenImageIO/Imath.h>
 #include <OpenImageIO/argparse.h>
@@ -36,6 +40,12 @@ static bool verbose                = false;
 static int nthreads                = 0;
 static int minthreads              = 1;
 static int threadtimes             = 0;
+static bool latencystats           = false;
+static std::string replay_tracefile;
+static bool simulate            = false;
+static std::string simsizes     = "64,128,256,512,1024";
+static std::string simpolicy    = "lru";
+static float simreadtime_us     = 500.0f;
 static int output_xres = 512, output_yres = 512;
 static int nchannels_override     = 0;
 static std::string dataformatname = "half";
@@ -236,6 +246,24 @@ getargs(int argc, const char* argv[])
       .help("Test the tile hashing function");
     ap.arg("--threadtimes %d:MODE", &threadtimes)
       .help("Do thread timings (arg = workload profile)");
+    ap.arg("--latencystats", &latencystats)
+      .help("With --threadtimes or --replay, also report per-lookup latency "
+            "histograms, cold/warm phase stats, and per-thread throughput "
+            "over time");
+    ap.arg("--replay %s:TRACEFILE", &replay_tracefile)
+      .help("Replay a texture access trace captured by setting the "
+            "TextureSystem attribute \"trace:filename\" during a render");
+    ap.arg("--simulate", &simulate)
+      .help("With --replay, simulate tile cache behavior offline (no tile "
+            "I/O) instead of replaying lookups for real");
+    ap.arg("--simsizes %s:MBLIST", &simsizes)
+      .help("Comma-separated cache sizes in MB to sweep in simulation "
+            "(default: 64,128,256,512,1024)");
+    ap.arg("--simpolicy %s:POLICY", &simpolicy)
+      .help("Simulated eviction policy: lru or clock (default: lru)");
+    ap.arg("--simreadtime %f:USEC", &simreadtime_us)
+      .help("Assumed cost of one tile miss in microseconds, for projected "
+            "stall time (default: 500)");
     ap.arg("--trials %d:N", &ntrials)
       .help("Number of trials for timings");
     ap.arg("--lowtrials %d:N", &lowtrials)
@@ -1406,6 +1434,505 @@ static const char* workload_names[] = {
 
 
 
+// HDR-style latency histogram for individual texture lookups. The buckets
+// are powers of two of nanoseconds, covering everything from sub-100ns
+// cache hits to multi-second stalls with a bounded (factor of 2) error on
+// the percentile estimates, in a small fixed footprint.
+struct LatencyHistogram {
+    static const int nbuckets = 36;  // 2^35 ns is ~34s, plenty
+    uint64_t buckets[nbuckets];
+    uint64_t count;
+    double sum;     // total ns
+    double maxval;  // max ns
+
+    LatencyHistogram() { reset(); }
+    void reset()
+    {
+        memset(buckets, 0, sizeof(buckets));
+        count  = 0;
+        sum    = 0;
+        maxval = 0;
+    }
+    void add(double ns)
+    {
+        uint64_t v = (uint64_t)std::max(ns, 0.0);
+        int b      = 0;
+        while (v >>= 1)
+            ++b;
+        buckets[std::min(b, nbuckets - 1)] += 1;
+        count += 1;
+        sum += ns;
+        maxval = std::max(maxval, ns);
+    }
+    void merge(const LatencyHistogram& other)
+    {
+        for (int b = 0; b < nbuckets; ++b)
+            buckets[b] += other.buckets[b];
+        count += other.count;
+        sum += other.sum;
+        maxval = std::max(maxval, other.maxval);
+    }
+    // Upper edge (in ns) of the bucket containing the p'th quantile (0-1).
+    double percentile(double p) const
+    {
+        uint64_t target = (uint64_t)(p * count);
+        uint64_t c      = 0;
+        for (int b = 0; b < nbuckets; ++b) {
+            c += buckets[b];
+            if (c > target)
+                return double(uint64_t(1) << (b + 1));
+        }
+        return maxval;
+    }
+};
+
+
+// Latency bookkeeping for one worker thread of a --threadtimes workout.
+// Each thread fills in its own slot with no synchronization; results are
+// merged and printed after the trials complete. The "cold" histogram
+// gathers the first lookups of each trial, while the cache is still
+// filling; "warm" gathers the steady state. Histograms accumulate over
+// all trials, but the throughput series is from the last trial only.
+struct PerThreadLatency {
+    LatencyHistogram cold, warm;
+    std::vector<uint64_t> throughput;  // lookups finished per interval
+};
+
+static std::vector<PerThreadLatency> thread_latency;
+static const double latency_interval_ms = 100.0;
+
+
+
+// One texture lookup from a captured access trace. The binary layout must
+// match what TextureSystemImpl writes when the "trace:filename" attribute
+// is set (see the format notes in texturesys.cpp).
+struct TraceRecord {
+    uint32_t fileid;
+    uint32_t thread;
+    float s, t, dsdx, dtdx, dsdy, dtdy;
+};
+
+static std::vector<ustring> trace_filenames;  // trace fileid -> file name
+static std::vector<TextureSystem::TextureHandle*> trace_handles;
+static std::vector<std::vector<TraceRecord>> trace_by_thread;
+
+
+
+// Read a texture access trace captured via the TextureSystem
+// "trace:filename" attribute, sorting the records by original thread (they
+// stay in capture order within each thread).
+static bool
+read_trace(const std::string& tracefile)
+{
+    FILE* f = Filesystem::fopen(tracefile, "rb");
+    if (!f) {
+        Strutil::print(std::cerr, "testtex: could not open trace {}\n",
+                       tracefile);
+        return false;
+    }
+    char magic[8];
+    if (fread(magic, 1, sizeof(magic), f) != sizeof(magic)
+        || memcmp(magic, "OIIOtrc1", sizeof(magic))) {
+        Strutil::print(std::cerr, "testtex: {} is not a texture trace file\n",
+                       tracefile);
+        fclose(f);
+        return false;
+    }
+    uint32_t head[2];
+    while (fread(head, sizeof(head), 1, f) == 1) {
+        if (head[0] == 0xffffffff) {
+            // Record introducing the name of a new file id
+            uint32_t namelen;
+            if (fread(&namelen, sizeof(namelen), 1, f) != 1)
+                break;
+            std::string name(namelen, '\0');
+            if (namelen && fread(&name[0], 1, namelen, f) != namelen)
+                break;
+            if (head[1] >= trace_filenames.size())
+                trace_filenames.resize(head[1] + 1);
+            trace_filenames[head[1]] = ustring(name);
+        } else {
+            TraceRecord rec;
+            rec.fileid = head[0];
+            rec.thread = head[1];
+            if (fread(&rec.s, sizeof(float), 6, f) != 6)
+                break;
+            if (rec.thread >= trace_by_thread.size())
+                trace_by_thread.resize(rec.thread + 1);
+            trace_by_thread[rec.thread].push_back(rec);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+
+
+// Reproduce one original thread's share of the captured request stream.
+static void
+replay_thread_workout(int mythread)
+{
+    const std::vector<TraceRecord>& records(trace_by_thread[mythread]);
+    int nchannels = nchannels_override ? nchannels_override : 3;
+    float* result = OIIO_ALLOCA(float, nchannels);
+    float* dresultds = test_derivs ? OIIO_ALLOCA(float, nchannels) : NULL;
+    float* dresultdt = test_derivs ? OIIO_ALLOCA(float, nchannels) : NULL;
+    TextureOpt opt;
+    initialize_opt(opt);
+    TextureSystem::Perthread* perthread_info = texsys->get_perthread_info();
+
+    using Clock           = std::chrono::steady_clock;
+    PerThreadLatency* lat = nullptr;
+    if (latencystats && mythread < (int)thread_latency.size()) {
+        lat = &thread_latency[mythread];
+        lat->throughput.clear();
+    }
+    const size_t cold_iters = std::max(size_t(1000), records.size() / 20);
+    Clock::time_point t0, workout_start = Clock::now();
+
+    for (size_t i = 0, e = records.size(); i < e; ++i) {
+        const TraceRecord& r(records[i]);
+        if (lat)
+            t0 = Clock::now();
+        bool ok = texsys->texture(trace_handles[r.fileid], perthread_info,
+                                  opt, r.s, r.t, r.dsdx, r.dtdx, r.dsdy,
+                                  r.dtdy, nchannels, result, dresultds,
+                                  dresultdt);
+        if (lat) {
+            Clock::time_point t1 = Clock::now();
+            double ns = std::chrono::duration<double, std::nano>(t1 - t0)
+                            .count();
+            if (i < cold_iters)
+                lat->cold.add(ns);
+            else
+                lat->warm.add(ns);
+            size_t interval
+                = (size_t)(std::chrono::duration<double, std::milli>(
+                               t1 - workout_start)
+                               .count()
+                           / latency_interval_ms);
+            const size_t max_intervals = 10000;
+            if (interval >= lat->throughput.size()
+                && interval < max_intervals)
+                lat->throughput.resize(interval + 1, 0);
+            if (interval < lat->throughput.size())
+                lat->throughput[interval] += 1;
+        }
+        if (!ok) {
+            Strutil::print(std::cerr, "Unexpected error: {}\n",
+                           texsys->geterror());
+            return;
+        }
+    }
+}
+
+
+
+// Launch one thread per original trace thread, each replaying its share of
+// the captured request stream in order.
+static void
+launch_trace_replay()
+{
+    if (invalidate_before_iter)
+        texsys->invalidate_all(true);
+    OIIO::thread_group threads;
+    for (size_t i = 0; i < trace_by_thread.size(); ++i)
+        threads.create_thread(std::bind(replay_thread_workout, (int)i));
+    threads.join_all();
+}
+
+
+
+// ------------- Offline cache capacity simulation (--simulate) -----------
+//
+// Replays a captured trace through a model of the ImageCache's tile
+// residency logic with no tile I/O at all: only file headers are read, to
+// learn each texture's resolution, MIP levels, and tile geometry. Each
+// lookup is mapped to the tile its (s,t) center falls in at the MIP level
+// its derivatives select (the bilinear/aniso footprint can touch
+// neighboring tiles too, so absolute miss counts are slightly
+// optimistic, but the *shape* of the hit-rate curve across cache sizes is
+// what capacity planning needs). Untiled sources use the --autotile size,
+// matching what the real cache would do.
+
+struct SimLevel {
+    int w, h, tw, th;
+};
+
+struct SimFile {
+    std::vector<SimLevel> levels;
+    size_t tilebytes;  // bytes of one tile at native data type
+};
+
+
+static bool
+build_sim_files(std::vector<SimFile>& simfiles)
+{
+    for (const ustring& name : trace_filenames) {
+        auto in = ImageInput::open(name.string());
+        if (!in) {
+            Strutil::print(std::cerr, "testtex: could not open {}: {}\n",
+                           name, geterror());
+            return false;
+        }
+        SimFile sf;
+        sf.tilebytes = 0;
+        for (int level = 0; level < 32; ++level) {
+            ImageSpec spec = in->spec_dimensions(0, level);
+            if (spec.undefined())
+                break;
+            SimLevel L;
+            L.w  = spec.width;
+            L.h  = spec.height;
+            L.tw = spec.tile_width ? spec.tile_width
+                                   : (autotile ? autotile : 64);
+            L.th = spec.tile_height ? spec.tile_height
+                                    : (autotile ? autotile : 64);
+            if (level == 0)
+                sf.tilebytes = size_t(L.tw) * L.th * spec.nchannels
+                               * spec.format.size();
+            sf.levels.push_back(L);
+        }
+        if (sf.levels.empty()) {
+            Strutil::print(std::cerr, "testtex: no image in {}\n", name);
+            return false;
+        }
+        simfiles.push_back(std::move(sf));
+    }
+    return true;
+}
+
+
+// Which tile does this lookup land in? Returns a packed key unique across
+// (file, level, tile x, tile y).
+static uint64_t
+sim_tile_key(const TraceRecord& r, const std::vector<SimFile>& simfiles)
+{
+    const SimFile& sf = simfiles[r.fileid];
+    int nlevels       = (int)sf.levels.size();
+    // Same spirit as the real level selection: filter width in texels of
+    // the base level picks the MIP level.
+    float wx = std::max(fabsf(r.dsdx), fabsf(r.dsdy)) * sf.levels[0].w;
+    float wy = std::max(fabsf(r.dtdx), fabsf(r.dtdy)) * sf.levels[0].h;
+    float wfilt = std::max(std::max(wx, wy), 1.0e-6f);
+    int level   = (int)floorf(log2f(wfilt));
+    level       = std::min(std::max(level, 0), nlevels - 1);
+    const SimLevel& L = sf.levels[level];
+    float s = r.s - floorf(r.s);  // periodic wrap
+    float t = r.t - floorf(r.t);
+    int x   = std::min(int(s * L.w), L.w - 1) / L.tw;
+    int y   = std::min(int(t * L.h), L.h - 1) / L.th;
+    return (uint64_t(r.fileid) << 48) | (uint64_t(level) << 42)
+           | (uint64_t(y) << 21) | uint64_t(x);
+}
+
+
+// A byte-capacity tile cache model. "lru" is exact LRU; "clock" is the
+// second-chance approximation, closer to what a sweep-based evictor
+// actually achieves.
+struct SimCache {
+    size_t capacity;
+    bool clockpolicy;
+    uint64_t hits = 0, misses = 0;
+    size_t used   = 0;
+
+    // exact LRU
+    std::list<std::pair<uint64_t, size_t>> lrulist;
+    std::unordered_map<uint64_t,
+                       std::list<std::pair<uint64_t, size_t>>::iterator>
+        lrumap;
+
+    // clock / second chance
+    struct ClockEnt {
+        uint64_t key;
+        size_t bytes;
+        bool ref;
+    };
+    std::vector<ClockEnt> ring;
+    std::vector<size_t> freeslots;
+    std::unordered_map<uint64_t, size_t> clockmap;
+    size_t hand = 0;
+
+    SimCache(size_t capacity, bool clockpolicy)
+        : capacity(capacity)
+        , clockpolicy(clockpolicy)
+    {
+    }
+
+    void access(uint64_t key, size_t bytes)
+    {
+        if (clockpolicy)
+            access_clock(key, bytes);
+        else
+            access_lru(key, bytes);
+    }
+
+    void access_lru(uint64_t key, size_t bytes)
+    {
+        auto it = lrumap.find(key);
+        if (it != lrumap.end()) {
+            ++hits;
+            lrulist.splice(lrulist.begin(), lrulist, it->second);
+            return;
+        }
+        ++misses;
+        used += bytes;
+        lrulist.emplace_front(key, bytes);
+        lrumap[key] = lrulist.begin();
+        while (used > capacity && lrulist.size() > 1) {
+            used -= lrulist.back().second;
+            lrumap.erase(lrulist.back().first);
+            lrulist.pop_back();
+        }
+    }
+
+    void access_clock(uint64_t key, size_t bytes)
+    {
+        auto it = clockmap.find(key);
+        if (it != clockmap.end()) {
+            ++hits;
+            ring[it->second].ref = true;
+            return;
+        }
+        ++misses;
+        used += bytes;
+        size_t slot;
+        if (freeslots.size()) {
+            slot = freeslots.back();
+            freeslots.pop_back();
+        } else {
+            slot = ring.size();
+            ring.push_back({});
+        }
+        ring[slot]    = { key, bytes, true };
+        clockmap[key] = slot;
+        while (used > capacity && clockmap.size() > 1 && ring.size()) {
+            ClockEnt& e = ring[hand];
+            if (e.bytes && e.ref) {
+                e.ref = false;
+            } else if (e.bytes && hand != slot) {
+                used -= e.bytes;
+                clockmap.erase(e.key);
+                e.bytes = 0;
+                freeslots.push_back(hand);
+            }
+            hand = (hand + 1) % ring.size();
+        }
+    }
+};
+
+
+// Sweep the requested cache sizes over the trace and report the hit-rate
+// curve. The trace is replayed round-robin across the captured threads, a
+// fair stand-in for the original interleaving (the capture buckets
+// records per thread).
+static void
+simulate_cache()
+{
+    std::vector<SimFile> simfiles;
+    if (!build_sim_files(simfiles))
+        return;
+
+    bool clockpolicy = (simpolicy == "clock");
+    if (!clockpolicy && simpolicy != "lru") {
+        Strutil::print(std::cerr,
+                       "testtex: unknown --simpolicy \"{}\" (lru, clock)\n",
+                       simpolicy);
+        return;
+    }
+
+    // Precompute the tile key stream, interleaved round-robin across the
+    // original threads, and measure the working set as we go.
+    std::vector<uint64_t> stream;
+    std::unordered_set<uint64_t> workingset;
+    size_t workingbytes = 0;
+    std::vector<size_t> cursor(trace_by_thread.size(), 0);
+    for (bool more = true; more;) {
+        more = false;
+        for (size_t th = 0; th < trace_by_thread.size(); ++th) {
+            if (cursor[th] >= trace_by_thread[th].size())
+                continue;
+            more                 = true;
+            const TraceRecord& r = trace_by_thread[th][cursor[th]++];
+            uint64_t key         = sim_tile_key(r, simfiles);
+            stream.push_back(key);
+            if (workingset.insert(key).second)
+                workingbytes += simfiles[r.fileid].tilebytes;
+        }
+    }
+
+    Strutil::print("Cache simulation: {} lookups, {} files, {} policy\n",
+                   stream.size(), simfiles.size(),
+                   clockpolicy ? "clock" : "lru");
+    Strutil::print("Working set: {} unique tiles, {:.1f} MB\n",
+                   workingset.size(), workingbytes / (1024.0 * 1024.0));
+    Strutil::print("Projected stall assumes {:.0f} us per tile miss\n\n",
+                   simreadtime_us);
+    Strutil::print("cache MB   hit rate      misses   stall (s)\n");
+    Strutil::print("-------- ---------- ----------- -----------\n");
+
+    for (string_view szstr : Strutil::splitsv(simsizes, ",")) {
+        float mb = Strutil::from_string<float>(szstr);
+        if (mb <= 0)
+            continue;
+        SimCache cache((size_t)(mb * 1024 * 1024), clockpolicy);
+        // The key stream doesn't keep per-record file ids, so rebuild
+        // sizes from the key's file field.
+        for (uint64_t key : stream)
+            cache.access(key, simfiles[key >> 48].tilebytes);
+        double total = double(cache.hits + cache.misses);
+        Strutil::print("{:8.0f} {:9.2f}% {:11} {:11.2f}\n", mb,
+                       total ? 100.0 * cache.hits / total : 0.0, cache.misses,
+                       cache.misses * simreadtime_us * 1.0e-6);
+    }
+}
+
+
+
+static void
+print_latency_stats(int numthreads)
+{
+    LatencyHistogram cold, warm;
+    for (auto& t : thread_latency) {
+        cold.merge(t.cold);
+        warm.merge(t.warm);
+    }
+    auto print_phase = [](const char* phase, const LatencyHistogram& h) {
+        if (!h.count)
+            return;
+        Strutil::print(
+            "    {} {:10} lookups  avg {:9.0f}ns  p50 <{:.0f}ns  p90 <{:.0f}ns  p99 <{:.0f}ns  p99.9 <{:.0f}ns  max {:.0f}ns\n",
+            phase, h.count, h.sum / h.count, h.percentile(0.5),
+            h.percentile(0.9), h.percentile(0.99), h.percentile(0.999),
+            h.maxval);
+    };
+    Strutil::print(
+        "  lookup latency with {} threads (cold = while the cache fills):\n",
+        numthreads);
+    print_phase("cold", cold);
+    print_phase("warm", warm);
+    Strutil::print("    histogram (>= ns : cold / warm):\n");
+    for (int b = 0; b < LatencyHistogram::nbuckets; ++b) {
+        if (!cold.buckets[b] && !warm.buckets[b])
+            continue;
+        Strutil::print("      {:12} : {} / {}\n", uint64_t(1) << b,
+                       cold.buckets[b], warm.buckets[b]);
+    }
+    for (int t = 0; t < (int)thread_latency.size(); ++t) {
+        auto& tp = thread_latency[t].throughput;
+        if (tp.empty())
+            continue;
+        Strutil::print("    thread {:3} klookups per {:.0f}ms:", t,
+                       latency_interval_ms);
+        const size_t maxprint = 64;
+        for (size_t j = 0; j < tp.size() && j < maxprint; ++j)
+            Strutil::print(" {}", tp[j] / 1000);
+        Strutil::print("{}\n", tp.size() > maxprint ? " ..." : "");
+    }
+}
+
+
+
 void
 do_tex_thread_workout(int iterations, int mythread)
 {
@@ -1421,6 +1948,18 @@ do_tex_thread_workout(int iterations, int mythread)
     TextureSystem::Perthread* perthread_info = texsys->get_perthread_info();
     int pixel, whichfile = 0;
 
+    using Clock           = std::chrono::steady_clock;
+    PerThreadLatency* lat = nullptr;
+    if (latencystats && mythread < (int)thread_latency.size()) {
+        lat = &thread_latency[mythread];
+        lat->throughput.clear();
+    }
+    // Call everything before the cache has seen this many lookups from us
+    // the "cold" phase -- with the default per-trial invalidation, that's
+    // when tiles are faulted in and cache contention is at its worst.
+    const int cold_iters      = std::max(1000, iterations / 20);
+    Clock::time_point t0, workout_start = Clock::now();
+
     ImageSpec spec0;
     if (texsys->is_udim(filenames[0])) {
         auto th = texsys->resolve_udim(filenames[0], 0.5f, 0.5f);
@@ -1452,6 +1991,8 @@ do_tex_thread_workout(int iterations, int mythread)
     for (int i = 0; i < iterations; ++i) {
         pixel   = i;
         bool ok = false;
+        if (lat)
+            t0 = Clock::now();
         // Several different texture access patterns
         switch (threadtimes) {
         case 1:
@@ -1526,6 +2067,26 @@ do_tex_thread_workout(int iterations, int mythread)
                                      dtdx, dsdy, dtdy, nchannels, result,
                                      dresultds, dresultdt);
         }
+        if (lat) {
+            Clock::time_point t1 = Clock::now();
+            double ns = std::chrono::duration<double, std::nano>(t1 - t0)
+                            .count();
+            if (i < cold_iters)
+                lat->cold.add(ns);
+            else
+                lat->warm.add(ns);
+            size_t interval
+                = (size_t)(std::chrono::duration<double, std::milli>(
+                               t1 - workout_start)
+                               .count()
+                           / latency_interval_ms);
+            const size_t max_intervals = 10000;
+            if (interval >= lat->throughput.size()
+                && interval < max_intervals)
+                lat->throughput.resize(interval + 1, 0);
+            if (interval < lat->throughput.size())
+                lat->throughput[interval] += 1;
+        }
         if (!ok) {
             Strutil::print(std::cerr, "Unexpected error: {}\n",
                            texsys->geterror());
@@ -1894,7 +2455,40 @@ main(int argc, const char* argv[])
         // Strutil::print("tex {} -> {:p}\n", f, (void*)texture_handles.back());
     }
 
-    if (threadtimes) {
+    if (replay_tracefile.size()) {
+        // Replay a captured texture access trace: the exact (file, s, t,
+        // derivative) request stream, partitioned across threads the way
+        // the original run partitioned it.
+        if (!read_trace(replay_tracefile))
+            return EXIT_FAILURE;
+        if (simulate) {
+            // Offline capacity sweep: header I/O only, no tile reads.
+            simulate_cache();
+        } else {
+            size_t nlookups = 0;
+            for (auto&& t : trace_by_thread)
+                nlookups += t.size();
+            for (auto&& f : trace_filenames)
+                trace_handles.push_back(texsys->get_texture_handle(f));
+            Strutil::print(
+                "Replaying {} lookups of {} files on {} threads ({})\n",
+                nlookups, trace_filenames.size(), trace_by_thread.size(),
+                replay_tracefile);
+            Strutil::print("texture cache size = {} MB\n", cachesize);
+            Strutil::print("times are best of {} trials\n", ntrials);
+            if (latencystats) {
+                thread_latency.clear();
+                thread_latency.resize(trace_by_thread.size());
+            }
+            double range;
+            float t = (float)time_trial(launch_trace_replay, ntrials, &range);
+            Strutil::print(
+                "Replay time: {:.2f}s    range {:.2f}    ({:.2f} Mlookups/s)\n",
+                t, range, nlookups / t / 1.0e6);
+            if (latencystats)
+                print_latency_stats((int)trace_by_thread.size());
+        }
+    } else if (threadtimes) {
         // If the --iters flag was used, do that number of iterations total
         // (divided among the threads). If not supplied (iters will be 1),
         // then use a large constant *per thread*.
@@ -1917,6 +2511,10 @@ main(int argc, const char* argv[])
             int nt    = wedge ? threadcounts[i] : nthreads;
             int its   = iters > 1 ? (std::max(1, iters / nt)) : iterations;
             int tries = nt <= 2 ? std::min(lowtrials, ntrials) : ntrials;
+            if (latencystats) {
+                thread_latency.clear();
+                thread_latency.resize(nt);
+            }
             double range;
             float t = (float)time_trial(std::bind(launch_tex_threads, nt, its),
                                         tries, &range);
@@ -1927,6 +2525,8 @@ main(int argc, const char* argv[])
             Strutil::print(
                 "{:3}     {:8.2f}   {:6.1f}x  {:6.1f}%    range {:.2f}\t({} iters/thread)\n",
                 nt, t, speedup, efficiency * 100.0f, range, its);
+            if (latencystats)
+                print_latency_stats(nt);
             fflush(stdout);
             if (!wedge)
                 break;  // don't loop if we're not wedging
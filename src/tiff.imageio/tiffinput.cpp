@@ -146,6 +146,9 @@ public:
                     int ybegin, int yend, int zbegin, int zend, int chbegin,
                     int chend, TypeDesc format, void* data, stride_t xstride,
                     stride_t ystride, stride_t zstride) override;
+    // Raw compressed copy of the current subimage into outtif -- see
+    // oiio_tiff_raw_copy at the bottom of this file.
+    bool raw_copy(TIFF* outtif, std::string& err);
 
 private:
     TIFF* m_tif;                            ///< libtiff handle
@@ -171,6 +174,8 @@ private:
     unsigned short m_photometric;    ///< Of the *file*, not the client's view
     unsigned short m_compression;    ///< TIFF compression tag
     unsigned short m_predictor;      ///< TIFF compression predictor tag
+    int m_lzw_check;                 ///< LZW stream style: -1 unknown,
+                                     ///<   0 old-style, 1 standard
     unsigned short m_inputchannels;  ///< Channels in the file (careful with CMYK)
     std::vector<unsigned short> m_colormap;   ///< Color map for palette images
     std::vector<uint32_t> m_rgbadata;         ///< Sometimes we punt
@@ -413,11 +418,108 @@ private:
             }
     }
 
+    // Return true if the file's LZW streams are the standard variety
+    // (MSB-first codes beginning with a Clear code, per TIFF 5.0) that
+    // lzw_decompress understands, as opposed to the long-obsolete
+    // LSB-first flavor that only libtiff still handles. Checked once per
+    // directory by sniffing the first raw strip/tile, then cached.
+    bool lzw_new_style()
+    {
+        if (m_lzw_check < 0) {
+            unsigned char head[2] = { 0, 0 };
+            tsize_t n             = TIFFIsTiled(m_tif)
+                                        ? TIFFReadRawTile(m_tif, 0, head, 2)
+                                        : TIFFReadRawStrip(m_tif, 0, head, 2);
+            // Standard LZW data begins with a 9-bit Clear code (256), so
+            // the first byte is always 0x80.
+            m_lzw_check = (n == 2 && head[0] == 0x80) ? 1 : 0;
+        }
+        return m_lzw_check == 1;
+    }
+
+    // Decode the TIFF flavor of LZW: 9-12 bit codes packed MSB-first,
+    // code 256 clears the table, code 257 ends the stream, and the code
+    // width bumps one entry earlier than vanilla LZW (the "early change"
+    // that TIFF 5.0 baked in). All decoder state is local to this call,
+    // so any number of strips/tiles can decode concurrently. Returns
+    // true if exactly usize bytes were decoded without error.
+    static bool lzw_decompress(const unsigned char* cdata, size_t csize,
+                               unsigned char* udata, size_t usize)
+    {
+        const int CLEAR = 256, EOI = 257, FIRST = 258, MAXCODE = 4096;
+        std::unique_ptr<uint16_t[]> prefix(new uint16_t[MAXCODE]);
+        std::unique_ptr<unsigned char[]> suffix(
+            new unsigned char[2 * MAXCODE + 1]);
+        unsigned char* stack = suffix.get() + MAXCODE;  // expansion scratch
+        int nextfree = FIRST, codebits = 9;
+        uint32_t bitbuf = 0;
+        int nbits       = 0;
+        size_t cpos = 0, upos = 0;
+        int prevcode            = -1;
+        unsigned char firstchar = 0;
+        while (upos < usize) {
+            // Accumulate bits and peel off the next code.
+            while (nbits < codebits && cpos < csize) {
+                bitbuf = (bitbuf << 8) | cdata[cpos++];
+                nbits += 8;
+            }
+            if (nbits < codebits)
+                break;  // ran off the end of the input
+            nbits -= codebits;
+            int code = int((bitbuf >> nbits) & ((1u << codebits) - 1));
+            if (code == EOI)
+                break;
+            if (code == CLEAR) {
+                nextfree = FIRST;
+                codebits = 9;
+                prevcode = -1;
+                continue;
+            }
+            if (prevcode < 0 && code > 255)
+                return false;  // first code after a clear must be literal
+            // Expand the code's string onto the stack (strings are stored
+            // as suffix bytes chained through prefix links, so they come
+            // out back to front).
+            int nstack = 0;
+            int c      = code;
+            if (c == nextfree) {
+                // Not in the table yet: the KwKwK case. Expand the
+                // previous code plus its own first character.
+                stack[nstack++] = firstchar;
+                c               = prevcode;
+            } else if (c > nextfree) {
+                return false;  // corrupt stream
+            }
+            while (c >= FIRST) {
+                stack[nstack++] = suffix[c];
+                c               = prefix[c];
+            }
+            stack[nstack++] = (unsigned char)c;
+            firstchar       = (unsigned char)c;
+            if (upos + nstack > usize)
+                return false;  // would overrun the output
+            for (int i = nstack - 1; i >= 0; --i)
+                udata[upos++] = stack[i];
+            // Add the new table entry
+            if (prevcode >= 0 && nextfree < MAXCODE) {
+                prefix[nextfree] = (uint16_t)prevcode;
+                suffix[nextfree] = firstchar;
+                ++nextfree;
+                // TIFF's early change: bump the width one entry early
+                if (nextfree == (1 << codebits) - 1 && codebits < 12)
+                    ++codebits;
+            }
+            prevcode = code;
+        }
+        return upos == usize;
+    }
+
     void uncompress_one_strip(const void* compressed_buf, unsigned long csize,
                               void* uncompressed_buf, size_t strip_bytes,
                               int channels, int width, int height, bool* ok)
     {
-        OIIO_DASSERT (m_compression == COMPRESSION_ADOBE_DEFLATE /*||
+        OIIO_DASSERT (m_compression == COMPRESSION_ADOBE_DEFLATE
+                      || m_compression == COMPRESSION_LZW /*||
                       m_compression == COMPRESSION_NONE*/);
         size_t nvals = size_t(width) * size_t(height) * size_t(channels);
         if (m_compression == COMPRESSION_NONE) {
@@ -427,12 +529,21 @@ private:
                 TIFFSwabArrayOfShort((unsigned short*)uncompressed_buf, nvals);
             return;
         }
-        uLong uncompressed_size = (uLong)strip_bytes;
-        auto zok = uncompress((Bytef*)uncompressed_buf, &uncompressed_size,
-                              (const Bytef*)compressed_buf, csize);
-        if (zok != Z_OK || uncompressed_size != strip_bytes) {
-            *ok = false;
-            return;
+        if (m_compression == COMPRESSION_LZW) {
+            if (!lzw_decompress((const unsigned char*)compressed_buf, csize,
+                                (unsigned char*)uncompressed_buf,
+                                strip_bytes)) {
+                *ok = false;
+                return;
+            }
+        } else {
+            uLong uncompressed_size = (uLong)strip_bytes;
+            auto zok = uncompress((Bytef*)uncompressed_buf, &uncompressed_size,
+                                  (const Bytef*)compressed_buf, csize);
+            if (zok != Z_OK || uncompressed_size != strip_bytes) {
+                *ok = false;
+                return;
+            }
         }
         if (m_is_byte_swapped && m_spec.format == TypeUInt16)
             TIFFSwabArrayOfShort((unsigned short*)uncompressed_buf, nvals);
@@ -1082,6 +1193,7 @@ TIFFInput::readspec(bool read_meta)
     m_compression = 0;
     TIFFGetFieldDefaulted(m_tif, TIFFTAG_COMPRESSION, &m_compression);
     m_spec.attribute("tiff:Compression", (int)m_compression);
+    m_lzw_check = -1;  // don't know the LZW stream style yet
 
     m_photometric = (m_spec.nchannels == 1 ? PHOTOMETRIC_MINISBLACK
                                            : PHOTOMETRIC_RGB);
@@ -1860,11 +1972,14 @@ TIFFInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
 {
     // If the stars all align properly, try to read strips, and use the
     // thread pool to parallelize the decompression. This can give a large
-    // speedup (5x or more!) because the zip decompression dwarfs the
-    // actual raw I/O. But libtiff is totally serialized, so we can only
-    // parallelize by reading raw (compressed) strips then making calls to
-    // zlib ourselves to decompress. Don't bother trying to handle any of
-    // the uncommon cases with strips. This covers most real-world cases.
+    // speedup (5x or more!) because the zip or LZW decompression dwarfs
+    // the actual raw I/O. But libtiff is totally serialized, so we can
+    // only parallelize by reading raw (compressed) strips then doing the
+    // decompression ourselves (zlib for deflate, our own decoder for
+    // LZW). For uncompressed files, the raw strips are simply read
+    // directly into the caller's buffer, skipping libtiff's buffering
+    // entirely. Don't bother trying to handle any of the uncommon cases
+    // with strips. This covers most real-world cases.
     lock_guard lock(*this);
     if (!seek_subimage(subimage, miplevel))
         return false;
@@ -1898,9 +2013,10 @@ TIFFInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
     // Are we reading raw (compressed) strips and doing the decompression
     // ourselves?
     bool read_raw_strips =
-        // only deflate/zip compression
-        (m_compression
-         == COMPRESSION_ADOBE_DEFLATE /*|| m_compression == COMPRESSION_NONE*/)
+        // only deflate/zip or standard LZW compression, or none at all
+        (m_compression == COMPRESSION_ADOBE_DEFLATE
+         || (m_compression == COMPRESSION_LZW && lzw_new_style())
+         || m_compression == COMPRESSION_NONE)
         // only horizontal predictor (or none)
         && (m_predictor == PREDICTOR_HORIZONTAL
             || m_predictor == PREDICTOR_NONE)
@@ -1908,6 +2024,10 @@ TIFFInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
         && !m_separate
         // only uint8, uint16
         && (m_spec.format == TypeUInt8 || m_spec.format == TypeUInt16);
+    // For uncompressed files, there is nothing to decode, so the raw
+    // strips can be read directly into the caller's buffer, bypassing
+    // both libtiff's internal strip buffering and our own scratch space.
+    bool read_direct = read_raw_strips && m_compression == COMPRESSION_NONE;
 
     // We know we wish to read as strips. But additionally, there are some
     // circumstances in which we want to read RAW strips, and do the
@@ -1940,6 +2060,11 @@ TIFFInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
                     * m_rowsperstrip;  // values in a strip
     imagesize_t strip_bytes = stripvals * m_spec.format.size();
     size_t cbound           = compressBound((uLong)strip_bytes);
+    if (m_compression == COMPRESSION_LZW) {
+        // LZW worst case expansion (up to 12 bits per input byte) is
+        // worse than zlib's compressBound estimate.
+        cbound = strip_bytes + strip_bytes / 2 + 16;
+    }
     std::unique_ptr<char[]> compressed_scratch;
     std::unique_ptr<char[]> separate_tmp(
         m_separate ? new char[strip_bytes * nstrips * planes] : nullptr);
@@ -1947,31 +2072,47 @@ TIFFInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
     if (read_raw_strips) {
         // Make room for, and read the raw (still compressed) strips. As each
         // one is read, kick off the decompress and any other extras, to execute
-        // in parallel.
-        compressed_scratch.reset(new char[cbound * nstrips * planes]);
+        // in parallel. If the strips are uncompressed, read them straight
+        // into their final resting place in the caller's buffer instead.
+        if (!read_direct)
+            compressed_scratch.reset(new char[cbound * nstrips * planes]);
         for (size_t stripidx = 0; y + m_rowsperstrip <= yend;
              y += m_rowsperstrip, ++stripidx) {
-            char* cbuf        = compressed_scratch.get() + stripidx * cbound;
+            char* cbuf        = read_direct
+                                    ? (char*)data
+                                    : compressed_scratch.get() + stripidx * cbound;
             tstrip_t stripnum = (y - m_spec.y) / m_rowsperstrip;
             tsize_t csize     = TIFFReadRawStrip(m_tif, stripnum, cbuf,
-                                                 tmsize_t(cbound));
-            if (csize < 0) {
+                                                 tmsize_t(read_direct ? strip_bytes
+                                                                      : cbound));
+            if (csize < 0 || (read_direct && csize != tsize_t(strip_bytes))) {
                 std::string err = oiio_tiff_last_error();
-                errorfmt("TIFFRead{}Strip failed reading line y={},z={}: {}",
-                         read_raw_strips ? "Raw" : "Encoded", y, z,
-                         err.size() ? err.c_str() : "unknown error");
+                errorfmt("TIFFReadRawStrip failed reading line y={},z={}: {}",
+                         y, z, err.size() ? err.c_str() : "unknown error");
                 ok = false;
             }
             auto out            = this;
             auto uncompress_etc = [=, &ok](int /*id*/) {
-                out->uncompress_one_strip(cbuf, (unsigned long)csize, data,
-                                          strip_bytes, out->m_spec.nchannels,
-                                          out->m_spec.width,
-                                          out->m_rowsperstrip, &ok);
+                if (read_direct) {
+                    // The pixels are already in place; all that might be
+                    // left is byte swapping.
+                    if (out->m_is_byte_swapped
+                        && out->m_spec.format == TypeUInt16)
+                        TIFFSwabArrayOfShort((unsigned short*)data, stripvals);
+                } else {
+                    out->uncompress_one_strip(cbuf, (unsigned long)csize, data,
+                                              strip_bytes,
+                                              out->m_spec.nchannels,
+                                              out->m_spec.width,
+                                              out->m_rowsperstrip, &ok);
+                }
                 if (out->m_photometric == PHOTOMETRIC_MINISWHITE)
                     out->invert_photometric(stripvals * stripchans, data);
             };
-            if (parallelize) {
+            if (read_direct && !m_is_byte_swapped
+                && m_photometric != PHOTOMETRIC_MINISWHITE) {
+                // Nothing at all left to do to this strip.
+            } else if (parallelize) {
                 // Push the rest of the work onto the thread pool queue
                 tasks.push(pool->push(uncompress_etc));
             } else {
@@ -2171,9 +2312,9 @@ TIFFInput::read_native_tiles(int subimage, int miplevel, int xbegin, int xend,
 
     // If the stars all align properly, use the thread pool to parallelize
     // the decompression. This can give a large speedup (5x or more!)
-    // because the zip decompression dwarfs the actual raw I/O. But libtiff
-    // is totally serialized, so we can only parallelize by making calls to
-    // zlib ourselves and then writing "raw" (compressed) strips. Don't
+    // because the zip or LZW decompression dwarfs the actual raw I/O. But
+    // libtiff is totally serialized, so we can only parallelize by reading
+    // "raw" (compressed) tiles and decompressing them ourselves. Don't
     // bother trying to handle any of the uncommon cases with strips. This
     // covers most real-world cases.
     thread_pool* pool = default_thread_pool();
@@ -2192,9 +2333,12 @@ TIFFInput::read_native_tiles(int subimage, int miplevel, int xbegin, int xend,
         && (spec().format.size() * 8 == m_bitspersample)
         // contig planarconfig only (for now?)
         && !m_separate
-        // only deflate/zip compression with horizontal predictor
-        && m_compression == COMPRESSION_ADOBE_DEFLATE
-        && m_predictor == PREDICTOR_HORIZONTAL
+        // only deflate/zip or standard LZW compression with horizontal
+        // predictor, or no compression at all
+        && (((m_compression == COMPRESSION_ADOBE_DEFLATE
+              || (m_compression == COMPRESSION_LZW && lzw_new_style()))
+             && m_predictor == PREDICTOR_HORIZONTAL)
+            || m_compression == COMPRESSION_NONE)
         // only uint8, uint16
         && (m_spec.format == TypeUInt8 || m_spec.format == TypeUInt16)
         // No other unusual cases
@@ -2227,7 +2371,17 @@ TIFFInput::read_native_tiles(int subimage, int miplevel, int xbegin, int xend,
     imagesize_t tile_bytes = m_spec.tile_bytes(true);
     int tilevals           = m_spec.tile_pixels() * m_spec.nchannels;
     size_t cbound          = compressBound((uLong)tile_bytes);
-    std::unique_ptr<char[]> compressed_scratch(new char[cbound * ntiles]);
+    if (m_compression == COMPRESSION_LZW) {
+        // LZW worst case expansion (up to 12 bits per input byte) is
+        // worse than zlib's compressBound estimate.
+        cbound = tile_bytes + tile_bytes / 2 + 16;
+    }
+    // For uncompressed files, read each raw tile directly into its tile
+    // scratch buffer -- there's nothing to decode, so no second buffer or
+    // libtiff strip buffering is needed, only the strided copy into place.
+    bool read_direct = (m_compression == COMPRESSION_NONE);
+    std::unique_ptr<char[]> compressed_scratch(
+        read_direct ? nullptr : new char[cbound * ntiles]);
     std::unique_ptr<char[]> scratch(new char[tile_bytes * ntiles]);
     task_set tasks(pool);
     bool ok = true;  // failed compression will stash a false here
@@ -2239,11 +2393,16 @@ TIFFInput::read_native_tiles(int subimage, int miplevel, int xbegin, int xend,
         for (int y = ybegin; ok && y < yend; y += m_spec.tile_height) {
             for (int x = xbegin; ok && x < xend;
                  x += m_spec.tile_width, ++tileidx) {
-                char* cbuf = compressed_scratch.get() + tileidx * cbound;
+                char* cbuf = read_direct
+                                 ? nullptr
+                                 : compressed_scratch.get() + tileidx * cbound;
                 char* ubuf = scratch.get() + tileidx * tile_bytes;
-                auto csize = TIFFReadRawTile(m_tif, tile_index(x, y, z), cbuf,
-                                             tmsize_t(cbound));
-                if (csize < 0) {
+                auto csize = TIFFReadRawTile(m_tif, tile_index(x, y, z),
+                                             read_direct ? ubuf : cbuf,
+                                             tmsize_t(read_direct ? tile_bytes
+                                                                  : cbound));
+                if (csize < 0
+                    || (read_direct && csize != tmsize_t(tile_bytes))) {
                     std::string err = oiio_tiff_last_error();
                     errorfmt(
                         "TIFFReadRawTile failed reading tile x={},y={},z={}: {}",
@@ -2254,12 +2413,20 @@ TIFFInput::read_native_tiles(int subimage, int miplevel, int xbegin, int xend,
                 // Push the rest of the work onto the thread pool queue
                 auto out = this;
                 tasks.push(pool->push([=, &ok](int /*id*/) {
-                    out->uncompress_one_strip(cbuf, (unsigned long)csize, ubuf,
-                                              tile_bytes, out->m_spec.nchannels,
-                                              out->m_spec.tile_width,
-                                              out->m_spec.tile_height
-                                                  * out->m_spec.tile_depth,
-                                              &ok);
+                    if (read_direct) {
+                        // Nothing to decode; just byte swap in place.
+                        if (out->m_is_byte_swapped
+                            && out->m_spec.format == TypeUInt16)
+                            TIFFSwabArrayOfShort((unsigned short*)ubuf,
+                                                 tilevals);
+                    } else
+                        out->uncompress_one_strip(cbuf, (unsigned long)csize,
+                                                  ubuf, tile_bytes,
+                                                  out->m_spec.nchannels,
+                                                  out->m_spec.tile_width,
+                                                  out->m_spec.tile_height
+                                                      * out->m_spec.tile_depth,
+                                                  &ok);
                     if (out->m_photometric == PHOTOMETRIC_MINISWHITE)
                         out->invert_photometric(tilevals, ubuf);
                     copy_image(out->m_spec.nchannels, out->m_spec.tile_width,
@@ -2417,4 +2584,126 @@ TIFFInput::read_tiles(int subimage, int miplevel, int xbegin, int xend,
     return ok;
 }
 
+
+
+bool
+TIFFInput::raw_copy(TIFF* outtif, std::string& err)
+{
+    lock_guard lock(*this);
+    if (!m_tif || m_use_rgba_interface)
+        return false;
+    // The raw compressed chunks are only meaningful to the destination if
+    // every setting that affects how they are encoded matches exactly.
+    // Check them all; any mismatch just means "no passthrough possible" and
+    // the caller falls back to the ordinary decompress/recompress copy.
+    auto matches = [&](int tag) {
+        uint16_t a = 0, b = 0;
+        TIFFGetFieldDefaulted(m_tif, tag, &a);
+        TIFFGetFieldDefaulted(outtif, tag, &b);
+        return a == b;
+    };
+    uint16_t compression = COMPRESSION_NONE;
+    TIFFGetFieldDefaulted(m_tif, TIFFTAG_COMPRESSION, &compression);
+    if (compression == COMPRESSION_JPEG || compression == COMPRESSION_OJPEG)
+        return false;  // JPEG tables are per-file; raw chunks don't transfer
+    if (!matches(TIFFTAG_COMPRESSION) || !matches(TIFFTAG_PREDICTOR)
+        || !matches(TIFFTAG_BITSPERSAMPLE) || !matches(TIFFTAG_SAMPLESPERPIXEL)
+        || !matches(TIFFTAG_SAMPLEFORMAT) || !matches(TIFFTAG_PHOTOMETRIC)
+        || !matches(TIFFTAG_PLANARCONFIG) || !matches(TIFFTAG_FILLORDER))
+        return false;
+    uint16_t photometric = PHOTOMETRIC_RGB;
+    TIFFGetFieldDefaulted(m_tif, TIFFTAG_PHOTOMETRIC, &photometric);
+    if (photometric == PHOTOMETRIC_PALETTE)
+        return false;  // would also need an identical colormap; punt
+    // Raw chunks of a byte-swapped file would be misinterpreted by a
+    // native-order destination.
+    if (TIFFIsByteSwapped(m_tif) != TIFFIsByteSwapped(outtif))
+        return false;
+    uint32_t w_in = 0, h_in = 0, w_out = 0, h_out = 0;
+    TIFFGetField(m_tif, TIFFTAG_IMAGEWIDTH, &w_in);
+    TIFFGetField(m_tif, TIFFTAG_IMAGELENGTH, &h_in);
+    TIFFGetField(outtif, TIFFTAG_IMAGEWIDTH, &w_out);
+    TIFFGetField(outtif, TIFFTAG_IMAGELENGTH, &h_out);
+    if (w_in != w_out || h_in != h_out)
+        return false;
+    bool tiled = TIFFIsTiled(m_tif);
+    if (tiled != bool(TIFFIsTiled(outtif)))
+        return false;
+    uint32_t nchunks;
+    if (tiled) {
+        uint32_t tw_in = 0, th_in = 0, tw_out = 0, th_out = 0;
+        TIFFGetField(m_tif, TIFFTAG_TILEWIDTH, &tw_in);
+        TIFFGetField(m_tif, TIFFTAG_TILELENGTH, &th_in);
+        TIFFGetField(outtif, TIFFTAG_TILEWIDTH, &tw_out);
+        TIFFGetField(outtif, TIFFTAG_TILELENGTH, &th_out);
+        if (tw_in != tw_out || th_in != th_out)
+            return false;
+        nchunks = TIFFNumberOfTiles(m_tif);
+    } else {
+        uint32_t rps_in = 0, rps_out = 0;
+        TIFFGetFieldDefaulted(m_tif, TIFFTAG_ROWSPERSTRIP, &rps_in);
+        TIFFGetFieldDefaulted(outtif, TIFFTAG_ROWSPERSTRIP, &rps_out);
+        if (rps_in != rps_out)
+            return false;
+        nchunks = TIFFNumberOfStrips(m_tif);
+    }
+    uint64_t* bytecounts = nullptr;
+    if (!TIFFGetField(m_tif,
+                      tiled ? TIFFTAG_TILEBYTECOUNTS : TIFFTAG_STRIPBYTECOUNTS,
+                      &bytecounts)
+        || !bytecounts)
+        return false;
+
+    // Everything matches. Shovel the compressed chunks straight across,
+    // the same way tiffcp does, never touching a codec.
+    std::unique_ptr<char[]> buf;
+    tmsize_t bufsize = 0;
+    for (uint32_t i = 0; i < nchunks; ++i) {
+        tmsize_t csize = tmsize_t(bytecounts[i]);
+        if (csize > bufsize) {
+            buf.reset(new char[csize]);
+            bufsize = csize;
+        }
+        tmsize_t rsize = tiled ? TIFFReadRawTile(m_tif, i, buf.get(), csize)
+                               : TIFFReadRawStrip(m_tif, i, buf.get(), csize);
+        if (rsize != csize) {
+            std::string e = oiio_tiff_last_error();
+            err = Strutil::fmt::format("raw read of chunk {} failed{}{}", i,
+                                       e.size() ? ": " : "", e);
+            return false;
+        }
+        tmsize_t wsize = tiled
+                             ? TIFFWriteRawTile(outtif, i, buf.get(), rsize)
+                             : TIFFWriteRawStrip(outtif, i, buf.get(), rsize);
+        if (wsize != rsize) {
+            std::string e = oiio_tiff_last_error();
+            err = Strutil::fmt::format("raw write of chunk {} failed{}{}", i,
+                                       e.size() ? ": " : "", e);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+// Called by TIFFOutput::copy_image (tiffoutput.cpp): if `in` is a TIFFInput
+// whose current subimage's codec-relevant settings exactly match those of
+// the destination, copy the compressed strips or tiles verbatim and return
+// 1. Return 0 if the files aren't compatible (caller should fall back to
+// the usual decompress/recompress copy), or -1 with `err` set if the copy
+// was attempted but failed partway (at which point the destination may
+// hold partial raw data, so no fallback is possible).
+int
+oiio_tiff_raw_copy(ImageInput* in, TIFF* outtif, std::string& err)
+{
+    TIFFInput* tiff_in = dynamic_cast<TIFFInput*>(in);
+    if (!tiff_in || !outtif)
+        return 0;
+    err.clear();
+    if (tiff_in->raw_copy(outtif, err))
+        return 1;
+    return err.size() ? -1 : 0;
+}
+
 OIIO_PLUGIN_NAMESPACE_END
@@ -88,6 +88,7 @@ public:
                      stride_t xstride = AutoStride,
                      stride_t ystride = AutoStride,
                      stride_t zstride = AutoStride) override;
+    bool copy_image(ImageInput* in) override;
 
 private:
     TIFF* m_tif = nullptr;
@@ -108,6 +109,19 @@ private:
     bool m_convert_rgb_to_cmyk;
     bool m_bigtiff;  // force bigtiff
 
+    // Write-behind accumulation for scanline files, enabled by the
+    // "tiff:writebehind" hint (megabytes of buffering, 0 = off). Rather
+    // than letting individual write_scanline(s) calls dribble rows into
+    // libtiff one at a time (which serializes the compression on the
+    // caller's thread), we accumulate the rows in native format and flush
+    // them in large batches through the parallel strip path of
+    // write_scanlines, which compresses the strips on pool workers and
+    // appends them to the file in order.
+    std::vector<unsigned char> m_writebehind_buf;  ///< Accumulated rows
+    imagesize_t m_writebehind_limit;  ///< Bytes to accumulate, 0 = off
+    int m_writebehind_ybegin;         ///< First buffered scanline
+    int m_writebehind_yend;           ///< One past last buffered scanline
+
     // Initialize private members to pre-opened state
     void init(void)
     {
@@ -121,6 +135,11 @@ private:
         m_outputchans         = 0;
         m_convert_rgb_to_cmyk = false;
         m_bigtiff             = false;
+        m_writebehind_buf.clear();
+        m_writebehind_buf.shrink_to_fit();
+        m_writebehind_limit  = 0;
+        m_writebehind_ybegin = 0;
+        m_writebehind_yend   = 0;
         ioproxy_clear();
     }
 
@@ -190,6 +209,35 @@ private:
                             int channels, int width, int height,
                             unsigned long* compressed_size, bool* ok);
 
+    static size_t lzw_compress(const unsigned char* udata, size_t usize,
+                               unsigned char* cdata, size_t cbound);
+
+    // The real guts of write_scanlines, once any write-behind accumulation
+    // has been dealt with.
+    bool write_scanlines_direct(int ybegin, int yend, int z, TypeDesc format,
+                                const void* data, stride_t xstride,
+                                stride_t ystride);
+
+    // Is the file we're writing a candidate for write-behind accumulation
+    // of scanlines? These are the static preconditions of the parallel
+    // strip path in write_scanlines_direct; the dynamic ones (thread pool
+    // availability, etc.) are re-checked there on every flush.
+    bool writebehind_eligible()
+    {
+        return m_spec.tile_width == 0 && m_spec.depth <= 1
+               && (m_photometric != PHOTOMETRIC_SEPARATED
+                   && m_photometric != PHOTOMETRIC_PALETTE)
+               && (spec().format.size() * 8 == m_bitspersample)
+               && m_planarconfig == PLANARCONFIG_CONTIG
+               && (m_compression == COMPRESSION_ADOBE_DEFLATE
+                   || m_compression == COMPRESSION_LZW)
+               && m_predictor == PREDICTOR_HORIZONTAL
+               && (m_spec.format == TypeUInt8 || m_spec.format == TypeUInt16);
+    }
+
+    // Compress and write any scanlines sitting in the write-behind buffer.
+    bool flush_writebehind();
+
     int tile_index(int x, int y, int z)
     {
         int xtile   = (x - m_spec.x) / m_spec.tile_width;
@@ -281,6 +329,13 @@ extern void
 oiio_tiff_set_error_handler();
 #endif
 
+// Defined in tiffinput.cpp: verbatim copy of compressed strips/tiles when
+// the source is a TIFFInput with codec settings identical to the
+// destination. Returns 1 if the raw copy was done, 0 if the files aren't
+// compatible, -1 (with err set) if the copy failed partway.
+extern int
+oiio_tiff_raw_copy(ImageInput* in, TIFF* outtif, std::string& err);
+
 
 
 // We comment out a lot of these because we only support a subset for
@@ -457,6 +512,10 @@ bool
 TIFFOutput::open(const std::string& name, const ImageSpec& userspec,
                  OpenMode mode)
 {
+    // If a previous subimage is still accumulating write-behind
+    // scanlines, get them into the file before we close its directory.
+    if (m_tif && !flush_writebehind())
+        return false;
     closetif();
 
     if (!check_open(mode, userspec,
@@ -938,6 +997,15 @@ TIFFOutput::open(const std::string& name, const ImageSpec& userspec,
                    ? m_spec.get_int_attribute("oiio:dither", 0)
                    : 0;
 
+    // Respond to the "tiff:writebehind" hint. The value is a buffering
+    // budget in megabytes of scanlines to accumulate before compressing
+    // and writing them as a batch of strips. Only honor it for files
+    // that qualify for the parallel strip path in write_scanlines.
+    m_writebehind_limit = 0;
+    if (int mb = m_spec.get_int_attribute("tiff:writebehind", 0))
+        if (writebehind_eligible())
+            m_writebehind_limit = imagesize_t(mb) * 1024 * 1024;
+
     return true;
 }
 
@@ -1170,9 +1238,12 @@ TIFFOutput::write_exif_data()
 bool
 TIFFOutput::close()
 {
+    bool ok = true;
+    if (m_tif)
+        ok = flush_writebehind();
     closetif();
-    init();       // re-initialize
-    return true;  // How can we fail?
+    init();  // re-initialize
+    return ok;
 }
 
 
@@ -1241,6 +1312,12 @@ bool
 TIFFOutput::write_scanline(int y, int z, TypeDesc format, const void* data,
                            stride_t xstride)
 {
+    if (m_writebehind_limit) {
+        // Write-behind is on: route through write_scanlines, which will
+        // accumulate this row rather than handing it to libtiff now.
+        return write_scanlines(y, y + 1, z, format, data, xstride, AutoStride);
+    }
+
     m_spec.auto_stride(xstride, format, spec().nchannels);
     data = to_native_scanline(format, data, xstride, m_scratch, m_dither, y, z);
 
@@ -1306,6 +1383,98 @@ TIFFOutput::write_scanline(int y, int z, TypeDesc format, const void* data,
 
 
 
+// Compress a buffer with standard TIFF LZW (MSB-first codes with "early
+// change" code width switching, per TIFF 5.0), matching what libtiff
+// itself would produce. All encoder state is local to this call, so any
+// number of strips/tiles can compress concurrently. Returns the number of
+// compressed bytes, or 0 if cbound bytes were not enough to hold them.
+size_t
+TIFFOutput::lzw_compress(const unsigned char* udata, size_t usize,
+                         unsigned char* cdata, size_t cbound)
+{
+    const int CLEAR = 256, EOI = 257, FIRST = 258, MAXCODE = 4096;
+    // Hash table mapping (prefix code, suffix byte) to its table code.
+    // 9001 slots (libtiff's choice) keeps occupancy below ~43% even when
+    // the code table is completely full.
+    const int HSIZE = 9001;
+    struct HashEnt {
+        int32_t code;      // code for this string, or -1 if slot empty
+        uint32_t prefsuf;  // (prefix code << 8) | suffix byte
+    };
+    std::unique_ptr<HashEnt[]> hash(new HashEnt[HSIZE]);
+    auto clear_hash = [&]() {
+        for (int i = 0; i < HSIZE; ++i)
+            hash[i].code = -1;
+    };
+
+    size_t cpos     = 0;  // bytes of cdata written so far
+    uint32_t bits   = 0;  // accumulated output bits
+    int nbits       = 0;  // how many bits are accumulated
+    int codebits    = 9;  // current code width
+    int nextfree    = FIRST;
+    bool overflowed = false;
+    auto putcode    = [&](int code) {
+        bits = (bits << codebits) | uint32_t(code);
+        nbits += codebits;
+        for (; nbits >= 8; nbits -= 8) {
+            if (cpos >= cbound) {
+                overflowed = true;
+                return;
+            }
+            cdata[cpos++] = (unsigned char)(bits >> (nbits - 8));
+        }
+    };
+
+    clear_hash();
+    putcode(CLEAR);
+    int prevcode = -1;
+    for (size_t i = 0; i < usize && !overflowed; ++i) {
+        int c = udata[i];
+        if (prevcode < 0) {  // very first byte, or first after a clear
+            prevcode = c;
+            continue;
+        }
+        // Is the string (prevcode + c) already in the table?
+        uint32_t prefsuf = (uint32_t(prevcode) << 8) | uint32_t(c);
+        int h            = int(prefsuf % uint32_t(HSIZE));
+        while (hash[h].code >= 0 && hash[h].prefsuf != prefsuf)
+            h = (h + 1 < HSIZE) ? h + 1 : 0;
+        if (hash[h].code >= 0) {
+            prevcode = hash[h].code;  // yes: grow the string
+            continue;
+        }
+        // No: emit the code for the prefix string and add the new string.
+        putcode(prevcode);
+        hash[h].prefsuf = prefsuf;
+        hash[h].code    = nextfree++;
+        // Bump the code width when our table reaches the size boundary.
+        // The decoder's table lags ours by one entry, so from its point
+        // of view this is the "early change" that TIFF 5.0 baked in.
+        if (nextfree == (1 << codebits) && codebits < 12)
+            ++codebits;
+        if (nextfree >= MAXCODE - 2) {
+            // Table full: start over with a fresh table.
+            putcode(CLEAR);
+            clear_hash();
+            nextfree = FIRST;
+            codebits = 9;
+        }
+        prevcode = c;
+    }
+    if (prevcode >= 0 && !overflowed)
+        putcode(prevcode);
+    putcode(EOI);
+    if (nbits && !overflowed) {  // flush any residual bits, zero padded
+        if (cpos >= cbound)
+            overflowed = true;
+        else
+            cdata[cpos++] = (unsigned char)(bits << (8 - nbits));
+    }
+    return overflowed ? 0 : cpos;
+}
+
+
+
 void
 TIFFOutput::compress_one_strip(void* uncompressed_buf, size_t strip_bytes,
                                void* compressed_buf, unsigned long cbound,
@@ -1320,6 +1489,16 @@ TIFFOutput::compress_one_strip(void* uncompressed_buf, size_t strip_bytes,
         horizontal_predictor((unsigned short*)uncompressed_buf,
                              (unsigned short*)uncompressed_buf, channels, width,
                              height);
+    if (m_compression == COMPRESSION_LZW) {
+        size_t csize = lzw_compress((const unsigned char*)uncompressed_buf,
+                                    strip_bytes,
+                                    (unsigned char*)compressed_buf, cbound);
+        if (csize)
+            *compressed_size = (unsigned long)csize;
+        else
+            *ok = false;
+        return;
+    }
     *compressed_size = cbound;
     auto zok         = compress2((Bytef*)compressed_buf, compressed_size,
                                  (const Bytef*)uncompressed_buf,
@@ -1334,10 +1513,81 @@ bool
 TIFFOutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
                             const void* data, stride_t xstride,
                             stride_t ystride)
+{
+    if (!m_writebehind_limit)
+        return write_scanlines_direct(ybegin, yend, z, format, data, xstride,
+                                      ystride);
+
+    // Write-behind mode: accumulate the rows in native format and flush
+    // them in large batches through the parallel strip path of
+    // write_scanlines_direct, so that even callers who dribble out one
+    // scanline at a time get multi-strip parallel compression.
+    if (m_writebehind_buf.size() && ybegin != m_writebehind_yend) {
+        // Not contiguous with what's already buffered -- flush that first.
+        if (!flush_writebehind())
+            return false;
+    }
+    imagesize_t rowbytes = m_spec.scanline_bytes(true);
+    if (m_writebehind_buf.empty()
+        && imagesize_t(yend - ybegin) * rowbytes >= m_writebehind_limit
+        && is_strip_boundary(ybegin) && is_strip_boundary(yend)) {
+        // We were handed a full batch of whole strips all at once -- no
+        // point copying it into the accumulation buffer first.
+        return write_scanlines_direct(ybegin, yend, z, format, data, xstride,
+                                      ystride);
+    }
+    // Convert to native layout and append to the accumulation buffer.
+    std::vector<unsigned char> nativebuf;
+    const void* native = to_native_rectangle(m_spec.x, m_spec.x + m_spec.width,
+                                             ybegin, yend, z, z + 1, format,
+                                             data, xstride, ystride, AutoStride,
+                                             nativebuf, m_dither, m_spec.x,
+                                             m_spec.y, m_spec.z);
+    if (m_writebehind_buf.empty())
+        m_writebehind_ybegin = ybegin;
+    m_writebehind_buf.insert(m_writebehind_buf.end(),
+                             (const unsigned char*)native,
+                             (const unsigned char*)native
+                                 + imagesize_t(yend - ybegin) * rowbytes);
+    m_writebehind_yend = yend;
+    // Flush once we're over budget, but hold out for a strip boundary so
+    // the flush consists of whole strips.
+    if (m_writebehind_buf.size() >= m_writebehind_limit
+        && is_strip_boundary(m_writebehind_yend))
+        return flush_writebehind();
+    return true;
+}
+
+
+
+bool
+TIFFOutput::flush_writebehind()
+{
+    if (m_writebehind_buf.empty())
+        return true;
+    // Temporarily turn off accumulation so that this call takes the
+    // direct path, and so that any per-scanline fallback within it
+    // doesn't re-enter the buffering logic.
+    imagesize_t limit   = m_writebehind_limit;
+    m_writebehind_limit = 0;
+    bool ok = write_scanlines(m_writebehind_ybegin, m_writebehind_yend,
+                              m_spec.z, TypeDesc::UNKNOWN,
+                              m_writebehind_buf.data(), AutoStride, AutoStride);
+    m_writebehind_limit = limit;
+    m_writebehind_buf.clear();
+    return ok;
+}
+
+
+
+bool
+TIFFOutput::write_scanlines_direct(int ybegin, int yend, int z,
+                                   TypeDesc format, const void* data,
+                                   stride_t xstride, stride_t ystride)
 {
     // If the stars all align properly, try to write strips, and use the
     // thread pool to parallelize the compression. This can give a large
-    // speedup (5x or more!) because the zip compression dwarfs the
+    // speedup (5x or more!) because the zip or LZW compression dwarfs the
     // actual raw I/O. But libtiff is totally serialized, so we can only
     // parallelize by making calls to zlib ourselves and then writing
     // "raw" (compressed) strips. Don't bother trying to handle any of
@@ -1357,8 +1607,9 @@ TIFFOutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
         && (spec().format.size() * 8 == m_bitspersample)
         // contig planarconfig only
         && m_planarconfig == PLANARCONFIG_CONTIG
-        // only deflate/zip compression with horizontal predictor
-        && m_compression == COMPRESSION_ADOBE_DEFLATE
+        // only deflate/zip or LZW compression with horizontal predictor
+        && (m_compression == COMPRESSION_ADOBE_DEFLATE
+            || m_compression == COMPRESSION_LZW)
         && m_predictor == PREDICTOR_HORIZONTAL
         // only uint8, uint16
         && (m_spec.format == TypeUInt8 || m_spec.format == TypeUInt16)
@@ -1401,6 +1652,11 @@ TIFFOutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
     data                    = scratch.get();
     imagesize_t strip_bytes = m_spec.scanline_bytes(true) * m_rowsperstrip;
     size_t cbound           = compressBound((uLong)strip_bytes);
+    if (m_compression == COMPRESSION_LZW) {
+        // LZW's worst case expansion (12 bit codes for single bytes) is
+        // worse than zlib's compressBound.
+        cbound = strip_bytes + strip_bytes / 2 + 16;
+    }
     std::unique_ptr<char[]> compressed_scratch(new char[cbound * nstrips]);
     unsigned long* compressed_len;
     OIIO_ALLOCATE_STACK_OR_HEAP(compressed_len, unsigned long, nstrips);
@@ -1566,8 +1822,8 @@ TIFFOutput::write_tiles(int xbegin, int xend, int ybegin, int yend, int zbegin,
 
     // If the stars all align properly, try to use the thread pool to
     // parallelize the compression of the tiles. This can give a large
-    // speedup (5x or more!) because the zip compression dwarfs the actual
-    // raw I/O. But libtiff is totally serialized, so we can only
+    // speedup (5x or more!) because the zip or LZW compression dwarfs the
+    // actual raw I/O. But libtiff is totally serialized, so we can only
     // parallelize by making calls to zlib ourselves and then writing "raw"
     // (compressed) strips. Don't bother trying to handle any of the
     // uncommon cases with strips. This covers most real-world cases.
@@ -1587,8 +1843,9 @@ TIFFOutput::write_tiles(int xbegin, int xend, int ybegin, int yend, int zbegin,
         && (spec().format.size() * 8 == m_bitspersample)
         // contig planarconfig only
         && m_planarconfig == PLANARCONFIG_CONTIG
-        // only deflate/zip compression with horizontal predictor
-        && m_compression == COMPRESSION_ADOBE_DEFLATE
+        // only deflate/zip or LZW compression with horizontal predictor
+        && (m_compression == COMPRESSION_ADOBE_DEFLATE
+            || m_compression == COMPRESSION_LZW)
         && m_predictor == PREDICTOR_HORIZONTAL
         // only uint8, uint16
         && (m_spec.format == TypeUInt8 || m_spec.format == TypeUInt16)
@@ -1614,6 +1871,11 @@ TIFFOutput::write_tiles(int xbegin, int xend, int ybegin, int yend, int zbegin,
     stride_t tile_bytes = (stride_t)m_spec.tile_bytes(true);
     std::vector<std::vector<unsigned char>> tilebuf(ntiles);
     size_t cbound = compressBound((uLong)tile_bytes);
+    if (m_compression == COMPRESSION_LZW) {
+        // LZW's worst case expansion (12 bit codes for single bytes) is
+        // worse than zlib's compressBound.
+        cbound = size_t(tile_bytes) + size_t(tile_bytes) / 2 + 16;
+    }
     std::unique_ptr<char[]> compressed_scratch(new char[ntiles * cbound]);
     unsigned long* compressed_len = OIIO_ALLOCA(unsigned long, ntiles);
 
@@ -1810,4 +2072,31 @@ TIFFOutput::fix_bitdepth(void* data, int nvals)
 }
 
 
+
+bool
+TIFFOutput::copy_image(ImageInput* in)
+{
+    // If the source is also a TIFF file whose codec-relevant settings
+    // exactly match what we're writing, move the compressed strips or
+    // tiles across verbatim, skipping both codecs entirely. This makes
+    // metadata-only rewraps of TIFF files (including .tx textures) nearly
+    // free. Anything that doesn't match up just takes the normal
+    // decompress/recompress path below.
+    if (in && m_tif && !strcmp(in->format_name(), "tiff")
+        && !m_convert_rgb_to_cmyk) {
+        std::string err;
+        int r = oiio_tiff_raw_copy(in, m_tif, err);
+        if (r > 0)
+            return true;
+        if (r < 0) {
+            // The copy failed after raw chunks were already written, so
+            // falling back would leave a corrupt mix. Report the failure.
+            errorfmt("TIFF raw copy failed: {}", err);
+            return false;
+        }
+    }
+    return ImageOutput::copy_image(in);
+}
+
+
 OIIO_PLUGIN_NAMESPACE_END
@@ -31,6 +31,8 @@ public:
     bool seek_subimage(int subimage, int miplevel) override;
     bool read_native_scanline(int subimage, int miplevel, int y, int z,
                               void* data) override;
+    bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
+                               int z, void* data) override;
     bool close() override;
     int current_subimage(void) const override { return m_subimage; }
 
@@ -75,6 +77,11 @@ private:
     // hard logic about how to get to the right spot if it's not the next
     // sequential frame.
     bool read_subimage(int subimage, bool read);
+
+    // Decode only rows [ybegin,yend) of the current (single) frame into
+    // `data`, using libwebp's cropping support, without paying for (or
+    // caching) a full-frame decode. Return true for success.
+    bool decode_region(int ybegin, int yend, void* data);
 };
 
 
@@ -341,6 +348,89 @@ WebpInput::read_current_subimage()
 
 
 
+bool
+WebpInput::decode_region(int ybegin, int yend, void* data)
+{
+    // libwebp snaps the top of the crop window down to an even row, so
+    // widen the band if necessary and copy out just the requested rows
+    // afterwards.
+    int ytop      = ybegin & ~1;
+    int nrows     = yend - ytop;
+    uint8_t* dest = (uint8_t*)data;
+    std::unique_ptr<uint8_t[]> scratch;
+    if (ytop != ybegin) {
+        scratch.reset(new uint8_t[size_t(nrows) * m_scanline_size]);
+        dest = scratch.get();
+    }
+
+    WebPDecoderConfig config;
+    if (!WebPInitDecoderConfig(&config)) {
+        errorfmt("Couldn't initialize WebP decoder config");
+        return false;
+    }
+    config.options.use_cropping      = 1;
+    config.options.crop_left         = 0;
+    config.options.crop_top          = ytop;
+    config.options.crop_width        = m_spec.width;
+    config.options.crop_height       = nrows;
+    config.output.colorspace = m_spec.nchannels == 4 ? MODE_RGBA : MODE_RGB;
+    config.output.is_external_memory = 1;
+    config.output.u.RGBA.rgba        = dest;
+    config.output.u.RGBA.stride      = int(m_scanline_size);
+    config.output.u.RGBA.size        = size_t(nrows) * m_scanline_size;
+    VP8StatusCode status = WebPDecode(m_iter.fragment.bytes,
+                                      m_iter.fragment.size, &config);
+    WebPFreeDecBuffer(&config.output);
+    if (status != VP8_STATUS_OK) {
+        errorfmt("Couldn't decode rows {}-{}", ybegin, yend);
+        return false;
+    }
+
+    if (scratch)
+        memcpy(data, scratch.get() + size_t(ybegin - ytop) * m_scanline_size,
+               size_t(yend - ybegin) * m_scanline_size);
+
+    if (m_spec.nchannels == 4) {
+        // WebP requires unassociated alpha, and it's sRGB.
+        // Handle this all by wrapping an IB around the band.
+        ImageSpec bandspec(m_spec.width, yend - ybegin, 4, TypeUInt8);
+        ImageBuf bandbuf(bandspec, data);
+        ImageBufAlgo::premult(bandbuf, bandbuf);
+    }
+    return true;
+}
+
+
+
+bool
+WebpInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
+                                 int yend, int z, void* data)
+{
+    {
+        lock_guard lock(*this);
+        // For a single-frame file whose pixels we haven't already decoded,
+        // a request that doesn't start at the top is the signature of a
+        // random-access consumer (such as ImageCache fetching autotiles).
+        // Decode just the requested row band rather than paying for a
+        // full-frame decode per fetch. Requests beginning at row 0 --
+        // including whole-image and in-order band reads -- still take the
+        // usual decode-once-and-cache path below.
+        if (m_frame_count == 1 && subimage == 0 && miplevel == 0
+            && m_subimage_read != 0 && ybegin > 0 && ybegin < yend
+            && yend <= m_spec.height) {
+            if (!read_subimage(subimage, false))
+                return false;
+            return decode_region(ybegin, yend, data);
+        }
+    }
+    // Fall back on the default implementation, which loops over
+    // read_native_scanline (decoding and caching the whole frame).
+    return ImageInput::read_native_scanlines(subimage, miplevel, ybegin, yend,
+                                             z, data);
+}
+
+
+
 bool
 WebpInput::read_native_scanline(int subimage, int miplevel, int y, int /*z*/,
                                 void* data)
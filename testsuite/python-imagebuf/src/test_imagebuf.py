@@ -254,6 +254,39 @@ try:
                                    19660,32767,52428, 26214,32767,39321], dtype='H'))
     write (b, "outarrayH.tif", oiio.UINT16)
 
+    # test zero-copy pixels_view
+    print ("Testing pixels_view...")
+    b = oiio.ImageBuf (oiio.ImageSpec(2,2,3,oiio.FLOAT))
+    b.set_pixels (oiio.ROI(0, 2, 0, 2, 0, 1, 0, 3),
+                  numpy.array([[[0.1,0.0,0.9], [0.2,0.0,0.7]],
+                               [[0.3,0.0,0.8], [0.4,0.0,0.6]]], dtype="f"))
+    view = b.pixels_view ()
+    print ("  view shape:", view.shape, "dtype:", view.dtype)
+    view[0][1] = (0.5, 0.5, 0.5)
+    print ("  after writing view, pixel 1,0 is", ftupstr(b.getpixel(1,0)))
+    print ("")
+
+    # test zero-copy wrapping of numpy memory
+    print ("Testing ImageBuf.wrap...")
+    arr = numpy.array([[[0.1,0.0,0.9], [0.2,0.0,0.7]],
+                       [[0.3,0.0,0.8], [0.4,0.0,0.6]]], dtype="f")
+    b = oiio.ImageBuf.wrap (arr)
+    print ("  wrapped spec is", b.spec().format, b.roi)
+    print ("  pixel 1,0 is", ftupstr(b.getpixel(1,0)))
+    arr[0][1] = (0.5, 0.5, 0.5)
+    print ("  after writing array, pixel 1,0 is", ftupstr(b.getpixel(1,0)))
+    print ("")
+
+    # test batched multi-file read
+    print ("Testing read_images...")
+    bufs = oiio.read_images (["../common/textures/grid.tx",
+                              "../common/textures/grid.tx"],
+                             convert = oiio.FLOAT)
+    for buf in bufs :
+        print ("  read", buf.name, ":", buf.spec().format,
+               buf.nchannels, "channels", buf.spec().width, "x", buf.spec().height)
+    print ("")
+
     test_perchannel_formats ()
     test_deep ()
     test_multiimage ()